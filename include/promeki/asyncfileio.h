@@ -0,0 +1,255 @@
+/**
+ * @file      asyncfileio.h
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#pragma once
+
+#include <promeki/config.h>
+#if PROMEKI_ENABLE_CORE
+#include <cstddef>
+#include <cstdint>
+#include <promeki/buffer.h>
+#include <promeki/error.h>
+#include <promeki/file.h>
+#include <promeki/function.h>
+#include <promeki/future.h>
+#include <promeki/list.h>
+#include <promeki/namespace.h>
+#include <promeki/uniqueptr.h>
+
+PROMEKI_NAMESPACE_BEGIN
+
+/**
+ * @brief Asynchronous positional file I/O engine.
+ * @ingroup io
+ *
+ * Issues positional reads and writes against open @ref File handles
+ * without blocking the calling thread.  Each request carries its own
+ * offset (like @c pread / @c pwrite), so requests never touch the
+ * file's current position and any number may be in flight on the same
+ * handle at once.  Completion is reported through a @ref Future or a
+ * callback; the result is the byte count transferred (short at end of
+ * file, exactly as @c pread reports it) or an error.
+ *
+ * @par Engines
+ * - @ref Engine::IoUring — Linux @c io_uring.  Requests are written
+ *   straight into the submission ring and a whole @ref submit batch
+ *   goes to the kernel in one system call; a single completion thread
+ *   reaps the completion ring and runs the callbacks.  Files and
+ *   buffers can be registered with the kernel (@ref registerFile,
+ *   @ref registerBuffers) so their per-request lookup and page
+ *   pinning is paid once up front.
+ * - @ref Engine::ThreadPool — emulation on a private @ref ThreadPool
+ *   with @ref queueDepth workers, each running a blocking positional
+ *   read or write.  Used where @c io_uring is not available (other
+ *   platforms, older kernels, or a sandbox that blocks the system
+ *   call).  Registration calls succeed and change nothing.
+ *
+ * @ref Engine::Auto, the default, picks @c io_uring when the kernel
+ * accepts a ring and falls back to the thread pool otherwise.
+ *
+ * @par Queue depth
+ * At most @ref queueDepth requests are in flight at once.  Submitting
+ * more blocks the caller until earlier requests complete, which gives
+ * producers natural back-pressure.
+ *
+ * @par Direct I/O and buffers
+ * A @ref File opened with @ref File::setDirectIO "direct I/O" works
+ * unchanged, provided each request's buffer address, offset and size
+ * are multiples of @ref File::directIOAlignment — a @ref BufferPool
+ * built with that alignment hands out suitable buffers.  The
+ * @ref Buffer overloads hold a reference to the buffer until the
+ * request completes, so a pooled buffer cannot be recycled under an
+ * in-flight read.
+ *
+ * @par Example
+ * @code
+ * File file("clip.raw");
+ * file.open(IODevice::ReadOnly);
+ * file.setDirectIO(true);
+ *
+ * AsyncFileIO aio(32);
+ * BufferPool  pool(chunkBytes, 4096);
+ * List<Future<int64_t>> pending;
+ * for(int64_t off = 0; off < fileBytes; off += chunkBytes) {
+ *     Buffer buf = pool.acquire();
+ *     pending.pushToBack(aio.read(file, off, buf, chunkBytes));
+ * }
+ * for(auto &f : pending) {
+ *     auto [bytes, err] = f.result();
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @par Thread Safety
+ * Fully thread-safe.  Requests may be submitted from any number of
+ * threads.  Callbacks run on an engine thread — the completion thread
+ * for @c io_uring, a pool worker otherwise — and must not block for
+ * long or submit and then wait on further requests themselves.
+ * Destroying the engine waits for every in-flight request.
+ */
+class AsyncFileIO {
+        public:
+                /** @brief The mechanism requests are carried out with. */
+                enum class Engine {
+                        Auto,      ///< @brief @c io_uring when available, else the thread pool.
+                        IoUring,   ///< @brief Linux @c io_uring.
+                        ThreadPool ///< @brief Blocking I/O on a private thread pool.
+                };
+
+                /** @brief Direction of a request. */
+                enum class Op {
+                        Read, ///< @brief Read from the file into the buffer.
+                        Write ///< @brief Write the buffer to the file.
+                };
+
+                /**
+                 * @brief Completion callback.
+                 *
+                 * Receives the number of bytes transferred and
+                 * @c Error::Ok, or -1 and the failure.
+                 */
+                using Callback = Function<void(int64_t, Error)>;
+
+                /** @brief One request in a @ref submit batch. */
+                struct Request {
+                                /** @brief Read or write. */
+                                Op op = Op::Read;
+                                /** @brief Open file handle. */
+                                File::FileHandle handle = File::FileHandleClosedValue;
+                                /** @brief Byte offset in the file. */
+                                int64_t offset = 0;
+                                /** @brief Source or destination memory. */
+                                void *data = nullptr;
+                                /** @brief Bytes to transfer. */
+                                size_t size = 0;
+                                /** @brief Optional buffer kept alive until completion. */
+                                Buffer keep;
+                                /** @brief Invoked once on completion. */
+                                Callback callback;
+                };
+
+                /** @brief Default number of requests in flight. */
+                static constexpr unsigned int DefaultQueueDepth = 64;
+
+                /** @brief Returns true if this kernel accepts an @c io_uring instance. */
+                static bool ioUringAvailable();
+
+                /**
+                 * @brief Constructs an engine.
+                 *
+                 * If @p engine is @ref Engine::IoUring and the ring
+                 * cannot be created, the engine is invalid (see
+                 * @ref isValid); @ref Engine::Auto falls back to the
+                 * thread pool instead.
+                 *
+                 * @param queueDepth Maximum requests in flight (clamped to 1..4096).
+                 * @param engine     Mechanism to use.
+                 */
+                explicit AsyncFileIO(unsigned int queueDepth = DefaultQueueDepth, Engine engine = Engine::Auto);
+
+                /** @brief Waits for every in-flight request, then releases the engine. */
+                ~AsyncFileIO();
+
+                AsyncFileIO(const AsyncFileIO &) = delete;
+                AsyncFileIO &operator=(const AsyncFileIO &) = delete;
+
+                /** @brief Returns true if the engine can accept requests. */
+                bool isValid() const;
+
+                /** @brief Returns the engine actually in use (never @ref Engine::Auto). */
+                Engine engine() const { return _engine; }
+
+                /** @brief Returns the maximum number of requests in flight. */
+                unsigned int queueDepth() const { return _queueDepth; }
+
+                /** @brief Returns the number of requests currently in flight. */
+                unsigned int inFlight() const;
+
+                /**
+                 * @brief Reads @p size bytes at @p offset into @p data.
+                 * @return A future holding the byte count read.
+                 */
+                Future<int64_t> read(const File &file, int64_t offset, void *data, size_t size);
+
+                /**
+                 * @brief Reads @p size bytes at @p offset into @p buf.
+                 *
+                 * @p buf must have at least @p size bytes allocated and
+                 * is kept alive until the read completes.  Its
+                 * @c size() is left for the caller to set from the
+                 * result.
+                 */
+                Future<int64_t> read(const File &file, int64_t offset, const Buffer &buf, size_t size);
+
+                /**
+                 * @brief Writes @p size bytes from @p data at @p offset.
+                 * @return A future holding the byte count written.
+                 */
+                Future<int64_t> write(const File &file, int64_t offset, const void *data, size_t size);
+
+                /** @brief Writes the first @p size bytes of @p buf at @p offset, keeping @p buf alive. */
+                Future<int64_t> write(const File &file, int64_t offset, const Buffer &buf, size_t size);
+
+                /**
+                 * @brief Submits a batch of requests.
+                 *
+                 * With @c io_uring the batch is handed to the kernel in
+                 * as few system calls as the queue depth allows.  Each
+                 * request's callback runs exactly once, including for
+                 * requests rejected here (with the reason).
+                 *
+                 * @return @c Error::Ok, or the first rejection.
+                 */
+                Error submit(List<Request> batch);
+
+                /** @brief Blocks until no request is in flight. */
+                void waitForIdle();
+
+                /**
+                 * @brief Registers @p file so requests on it skip the per-request file lookup.
+                 *
+                 * @c io_uring only; requests on a registered handle use
+                 * its fixed-file slot.  Call @ref unregisterFile before
+                 * closing the file.
+                 *
+                 * @return @c Error::Ok, @c Error::NoSpace when every slot is
+                 *         taken, or the kernel's error.
+                 */
+                Error registerFile(const File &file);
+
+                /** @brief Releases the slot registered for @p file. */
+                void unregisterFile(const File &file);
+
+                /**
+                 * @brief Registers buffers with the kernel for fixed-buffer I/O.
+                 *
+                 * @c io_uring pins the buffers' pages once; a later
+                 * request whose memory lies wholly inside one of them
+                 * skips the per-request page mapping.  The engine holds
+                 * a reference to each buffer until
+                 * @ref unregisterBuffers.  Replaces any earlier
+                 * registration.
+                 */
+                Error registerBuffers(const List<Buffer> &buffers);
+
+                /** @brief Drops the buffer registration, waiting for in-flight requests first. */
+                void unregisterBuffers();
+
+        private:
+                class Impl;
+                using ImplPtr = UniquePtr<Impl>;
+
+                Future<int64_t> submitOne(Request &&req);
+
+                ImplPtr      _d;
+                Engine       _engine = Engine::ThreadPool;
+                unsigned int _queueDepth = DefaultQueueDepth;
+};
+
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -11,6 +11,7 @@
 #include <promeki/config.h>
 #if PROMEKI_ENABLE_PROAV
 #include <promeki/namespace.h>
+#include <promeki/atomic.h>
 #include <promeki/audiodesc.h>
 #include <promeki/audiometer.h>
 #include <promeki/buffer.h>
@@ -145,11 +146,46 @@ PROMEKI_NAMESPACE_BEGIN
  *
  * @par Thread Safety
  *
- * Fully thread-safe.  All push, pop, and query methods are
- * internally synchronized via a Mutex.  Push methods wake any
- * thread blocked in @c popWait() after writing.  This allows a
- * producer thread and a consumer thread to operate on the same
- * AudioBuffer without external locking.
+ * Fully thread-safe in the default @ref Mode::Locked mode.  All
+ * push, pop, and query methods are internally synchronized via a
+ * Mutex.  Push methods wake any thread blocked in @c popWait() after
+ * writing.  This allows a producer thread and a consumer thread to
+ * operate on the same AudioBuffer without external locking.
+ *
+ * @par Lock-free SPSC mode
+ *
+ * A consumer running on a realtime thread (an audio device
+ * callback) must never wait on a lock the producer may be holding
+ * while it converts or resamples.  @ref setMode(Mode::Spsc) switches
+ * the buffer to a single-producer / single-consumer ring:
+ *
+ * - The write and read positions are atomics on separate cache
+ *   lines.  The producer publishes samples with a release store of
+ *   the write position; the consumer frees space with a release
+ *   store of the read position.
+ * - @ref pop, @ref peek, @ref drop, @ref nextSamplePts,
+ *   @ref available, @ref free, @ref isEmpty, @ref isFull and
+ *   @ref capacity never lock and never allocate.
+ * - PTS anchors travel through a fixed-size anchor ring
+ *   (@ref SpscAnchorSlots entries) filled by the producer and
+ *   pruned by the consumer.  When it is full — the consumer has
+ *   fallen far behind — new anchors are dropped and their samples
+ *   extend the previous timeline.
+ * - Format conversion, remap, gain, metering, resampling, drift
+ *   correction and anchor placement all stay on the producer side,
+ *   still serialized by the mutex, so any number of configuration
+ *   calls may race the producer as before.
+ *
+ * In this mode exactly one thread may call the consumer-side
+ * methods (@ref pop, @ref popWait, @ref peek, @ref drop,
+ * @ref popPayload, @ref popWaitPayload, @ref nextSamplePts).
+ * @ref popWait and the payload variants still block or allocate;
+ * realtime code should use @ref pop.  Calls that reset or resize
+ * the ring — @ref setFormat, @ref reserve, @ref clear and
+ * @ref setMode — must not run while the consumer is active.
+ * @ref setInputFormat is producer-side: instead of discarding the
+ * anchor queue it ends the current timeline at the next produced
+ * sample, so already-buffered samples keep their PTS.
  *
  * @par Capacity and ownership
  *
@@ -192,6 +228,15 @@ class AudioBuffer {
                 /** @brief Result type for pop operations: {sampleCount, Error}. */
                 using PopResult = Result<size_t>;
 
+                /** @brief Synchronization mode; see @ref setMode. */
+                enum class Mode {
+                        Locked, ///< Every method serialized by the internal mutex (default).
+                        Spsc    ///< Lock-free single-producer / single-consumer ring.
+                };
+
+                /** @brief Anchor-ring depth used by @ref Mode::Spsc. */
+                static constexpr size_t SpscAnchorSlots = 256;
+
                 /** @brief Default-constructs an invalid AudioBuffer with no format. */
                 AudioBuffer() = default;
 
@@ -216,6 +261,23 @@ class AudioBuffer {
                 /** @brief Returns true if a valid storage format is set. */
                 bool isValid() const { return _format.isValid(); }
 
+                /**
+                 * @brief Selects the synchronization mode.
+                 *
+                 * Switching modes discards any buffered samples and
+                 * starts a fresh timeline, exactly like @ref clear;
+                 * the storage format and capacity are kept.  Must not
+                 * be called while a consumer is active.
+                 *
+                 * @param mode The new mode.
+                 * @return Error::Ok, or Error::InvalidArgument for an
+                 *         unknown mode.
+                 */
+                Error setMode(Mode mode);
+
+                /** @brief Returns the synchronization mode. */
+                Mode mode() const { return _mode; }
+
                 /**
                  * @brief Returns a snapshot of the storage (output) format.
                  *
@@ -349,30 +411,35 @@ class AudioBuffer {
 
                 /** @brief Returns the current capacity in samples. */
                 size_t capacity() const {
+                        if (_mode == Mode::Spsc) return _capacity;
                         Mutex::Locker lock(_mutex);
                         return _capacity;
                 }
 
                 /** @brief Returns the number of samples currently buffered. */
                 size_t available() const {
+                        if (_mode == Mode::Spsc) return spscAvailable();
                         Mutex::Locker lock(_mutex);
                         return _count;
                 }
 
                 /** @brief Returns the free capacity in samples. */
                 size_t free() const {
+                        if (_mode == Mode::Spsc) return _capacity - spscAvailable();
                         Mutex::Locker lock(_mutex);
                         return _capacity - _count;
                 }
 
                 /** @brief Returns true if no samples are buffered. */
                 bool isEmpty() const {
+                        if (_mode == Mode::Spsc) return spscAvailable() == 0;
                         Mutex::Locker lock(_mutex);
                         return _count == 0;
                 }
 
                 /** @brief Returns true if the buffer is full. */
                 bool isFull() const {
+                        if (_mode == Mode::Spsc) return spscAvailable() >= _capacity;
                         Mutex::Locker lock(_mutex);
                         return _count >= _capacity;
                 }
@@ -655,12 +722,49 @@ class AudioBuffer {
                 Error  pushSilenceLocked(size_t samples);
                 size_t popLocked(void *dst, size_t samples);
 
+                /** @brief Buffered sample count as seen by the producer.  Called with @c _mutex held. */
+                size_t fillLocked() const;
+
+                /** @brief Free sample slots as seen by the producer.  Called with @c _mutex held. */
+                size_t freeLocked() const { return _capacity - fillLocked(); }
+
+                /**
+                 * @brief Advances the producer's write slot after
+                 *        @p samples samples were written at @c _tail.
+                 *
+                 * In @ref Mode::Spsc the samples stay invisible to the
+                 * consumer until @ref publishLocked runs.
+                 */
+                void advanceTail(size_t samples);
+
+                /** @brief Publishes everything produced so far to an SPSC consumer. */
+                void publishLocked();
+
+                /** @brief Resets ring positions, counters and anchors.  Called with @c _mutex held. */
+                void resetRingLocked();
+
                 /** @brief One PTS anchor: output-sample index plus its wall-clock PTS. */
                 struct Anchor {
                                 uint64_t       outputIndex = 0;
                                 MediaTimeStamp pts;
                 };
 
+                /**
+                 * @brief Appends @p anchor to the mode's anchor queue.
+                 *
+                 * In @ref Mode::Spsc the anchor is dropped when the
+                 * anchor ring is full.  Called with @c _mutex held.
+                 */
+                void appendAnchorLocked(const Anchor &anchor);
+
+                // SPSC consumer side — lock-free, allocation-free.
+                size_t         spscAvailable() const;
+                void           spscCopyOut(uint8_t *dst, uint64_t position, size_t samples) const;
+                MediaTimeStamp spscPtsAt(uint64_t outputIndex) const;
+                void           spscConsume(uint64_t position, size_t samples);
+                PopResult      spscPop(void *dst, size_t samples, MediaTimeStamp *firstSamplePts);
+                Result<PcmAudioPayload::Ptr> spscPopPayload(size_t maxSamples);
+
                 /**
                  * @brief Lays a PTS anchor at the given output-sample
                  *        absolute index, subtracting the resampler's
@@ -735,6 +839,24 @@ class AudioBuffer {
                 /** @brief Computes the effective ratio (nominal + drift adjustment). */
                 double computeRatio(const AudioDesc &srcFormat);
 #endif
+
+                // SPSC state.  In Mode::Spsc the producer owns _tail and
+                // _outputProducedTotal (under _mutex) and the consumer
+                // owns the read position; _head and _count are unused.
+                // The frame geometry is cached so the consumer never
+                // touches _format, whose channel map the producer
+                // rewrites on push.
+                Mode         _mode = Mode::Locked;
+                size_t       _frameBytes = 0;    ///< Bytes per stored frame (consumer copy).
+                float        _frameRate = 0.0f;  ///< Storage sample rate (consumer copy).
+                List<Anchor> _spscAnchors;       ///< Anchor ring, SpscAnchorSlots entries.
+
+                // Producer-written positions.
+                alignas(64) Atomic<uint64_t> _spscWritePos{0};    ///< Output samples published.
+                Atomic<uint64_t>             _spscAnchorWrite{0}; ///< Anchors published.
+                // Consumer-written positions, on their own cache line.
+                alignas(64) Atomic<uint64_t> _spscReadPos{0};    ///< Output samples consumed.
+                Atomic<uint64_t>             _spscAnchorRead{0}; ///< Oldest live anchor.
 };
 
 PROMEKI_NAMESPACE_END
@@ -237,6 +237,18 @@ class AudioFormat {
                          * @param samples Number of samples (not sample frames) to convert.
                          */
                                 void (*floatToSamples)(uint8_t *out, const float *in, size_t samples) = nullptr;
+                                /**
+                         * @brief Optional SIMD variant of @c samplesToFloat.
+                         *
+                         * Must produce output bit-identical to
+                         * @c samplesToFloat.  Used in its place while
+                         * @ref isSimdEnabled is true; leave @c nullptr
+                         * (or clear it when replacing @c samplesToFloat)
+                         * to always run the scalar function.
+                         */
+                                void (*samplesToFloatSimd)(float *out, const uint8_t *in, size_t samples) = nullptr;
+                                /** @brief Optional SIMD variant of @c floatToSamples (see @c samplesToFloatSimd). */
+                                void (*floatToSamplesSimd)(uint8_t *out, const float *in, size_t samples) = nullptr;
                 };
 
                 /**
@@ -355,9 +367,7 @@ class AudioFormat {
                  * @param samples Number of samples to convert (total samples,
                  *                not sample frames).
                  */
-                void samplesToFloat(float *out, const uint8_t *in, size_t samples) const {
-                        if (d->samplesToFloat != nullptr) d->samplesToFloat(out, in, samples);
-                }
+                void samplesToFloat(float *out, const uint8_t *in, size_t samples) const;
 
                 /**
                  * @brief Converts normalized floats to samples in this format.
@@ -365,9 +375,37 @@ class AudioFormat {
                  * @param in      Source float buffer.
                  * @param samples Number of samples to convert.
                  */
-                void floatToSamples(uint8_t *out, const float *in, size_t samples) const {
-                        if (d->floatToSamples != nullptr) d->floatToSamples(out, in, samples);
-                }
+                void floatToSamples(uint8_t *out, const float *in, size_t samples) const;
+
+                /**
+                 * @brief Enables or disables the SIMD sample kernels process-wide.
+                 *
+                 * When the library is built with SIMD support (Highway,
+                 * via @c PROMEKI_ENABLE_CSC) on a little-endian host, the
+                 * built-in PCM formats carry vectorized variants of their
+                 * float conversions and direct converters.  Every SIMD
+                 * kernel is bit-identical to its scalar reference, so
+                 * this switch only changes speed; it exists so tests
+                 * and benchmarks can compare the two paths.  Enabled by
+                 * default.
+                 *
+                 * @param enabled False to force the scalar reference kernels.
+                 */
+                static void setSimdEnabled(bool enabled);
+
+                /**
+                 * @brief Returns true if SIMD kernels are used where available.
+                 * @see setSimdEnabled()
+                 */
+                static bool isSimdEnabled();
+
+                /**
+                 * @brief Returns true if this build registers any SIMD kernels.
+                 *
+                 * False when built without SIMD support or on a big-endian
+                 * host; @ref setSimdEnabled is then a no-op.
+                 */
+                static bool hasSimdKernels();
 
                 // -- Direct (no-float) format-to-format conversion --------
                 //
@@ -392,6 +430,9 @@ class AudioFormat {
                 /**
                  * @brief Returns the registered direct converter from @p src to @p dst.
                  *
+                 * Returns the SIMD variant of a built-in converter while
+                 * @ref isSimdEnabled is true, otherwise the scalar one.
+                 *
                  * @return The function pointer, or @c nullptr when no
                  *         direct converter is registered.
                  */
@@ -419,6 +460,7 @@ class AudioFormat {
                  * Used at static-init time by the library's built-in PCM
                  * paths and at run time by applications adding custom
                  * direct converters between user-registered formats.
+                 * Replacing a built-in pair also drops its SIMD variant.
                  *
                  * @param src         Source format ID.
                  * @param dst         Destination format ID.
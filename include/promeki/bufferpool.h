@@ -13,61 +13,102 @@
 #include <cstddef>
 #include <promeki/namespace.h>
 #include <promeki/buffer.h>
-#include <promeki/list.h>
+#include <promeki/sharedptr.h>
 #include <promeki/memspace.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
 /**
- * @brief Simple fixed-geometry buffer pool for hot-path allocations.
+ * @brief Thread-safe, self-recycling buffer pool for hot-path allocations.
  * @ingroup util
  *
- * Maintains a small list of pre-allocated @c Buffer objects of a fixed
- * size + alignment, handing them out via @c acquire() and receiving
- * them back via @c release(). Designed for realtime read/write loops
- * that repeatedly need a scratch buffer of the same shape — e.g. a
- * video reader pulling one uncompressed frame per vsync.
+ * Hands out host @ref Buffer objects whose backing memory returns to
+ * the pool on its own when the last @ref Buffer handle referencing it
+ * is dropped — no explicit release step.  Designed for realtime
+ * pipelines that allocate the same few shapes over and over (one
+ * uncompressed frame's planes per vsync, one audio chunk per period):
+ * once warmed, @c acquire() is a lock-free pop and the steady state
+ * never reaches @c malloc for the payload memory.
  *
- * @par Thread Safety
- * Conditionally thread-safe.  Distinct instances may be used
- * concurrently.  A single BufferPool is single-threaded — callers
- * must ensure @c acquire / @c release happen from the same thread
- * (or be externally synchronized).
+ * @par Size classes
+ * Requests are rounded up to a multiple of the pool's alignment and
+ * served from a per-size-class bucket.  Classes are claimed on first
+ * use, up to @ref MaxSizeClasses per pool; a request for a new size
+ * once every class is taken is served by a plain, unpooled allocation.
+ * A pool constructed with a fixed @c bufferSize claims that class up
+ * front and serves it through the no-argument @ref acquire().  The
+ * vended @c Buffer always reports the requested byte count as its
+ * @c allocSize(), not the rounded class size.
+ *
+ * @par Recycling and watermarks
+ * Each pooled @c Buffer is backed by a private @ref BufferImpl whose
+ * destructor is the release hook: it pushes the memory block back onto
+ * its class's lock-free free list, whichever thread drops the last
+ * reference.  The block is kept only while the class holds fewer than
+ * @c Config::highWatermark idle blocks; past that it is freed.
+ * @ref trim() frees idle blocks down to @c Config::lowWatermark.  A
+ * class tracks at most @c Config::maxBuffersPerClass blocks (idle plus
+ * in flight); requests beyond that are served unpooled.
  *
- * @par Design notes
+ * @par Statistics
+ * Every acquire is counted against the pool's @ref MemSpace::Stats —
+ * @c poolHitCount when an idle block was reused, @c poolMissCount
+ * when fresh memory had to be allocated.  Block allocations and frees
+ * land in the ordinary alloc / release counters, so @c liveBytes
+ * includes memory parked in the pool.
  *
- * This is a simple explicit-release pool, not a smart-pointer-backed
- * one.  That's deliberate: @c Buffer is a value-type handle wrapping
- * an internally shared @ref BufferImpl, with no user-defined deleter
- * hook to recycle the impl on last-handle drop.  Wrapping a pool-
- * backed buffer in a smart-pointer release path would require a
- * separate layer.  For the expected hot-path use case (read one
- * sample, use it, pop the next), explicit release is clearer.
+ * @par Copy semantics
+ * BufferPool is a shared handle: copies refer to the same pool.  The
+ * pool's state stays alive until the last handle @em and the last
+ * vended @c Buffer are gone, so buffers may safely outlive the
+ * BufferPool object that produced them.
  *
- * @par Growth
+ * @par Thread Safety
+ * Fully thread-safe.  @ref acquire, @ref reserve, @ref trim,
+ * @ref clear and buffer recycling may run concurrently from any
+ * thread; the free lists are lock-free tagged stacks.
  *
- * When @c acquire() is called and the pool is empty, a new buffer is
- * allocated. The pool never shrinks — returned buffers stay in the
- * free list until the pool is destroyed. If you're worried about
- * memory footprint, call @c clear() periodically.
+ * @par Limitations
+ * Only host-accessible @ref MemSpace values are pooled; for any other
+ * space every acquire falls through to a plain @c Buffer allocation.
+ * @c Buffer::ensureExclusive on a pooled buffer detaches into an
+ * ordinary heap @c Buffer — the copy is not drawn from the pool.
  *
  * @par Example
  * @code
- * BufferPool pool(imageBytes, 4096);  // page-aligned, 4K tall stack
+ * BufferPool pool(imageBytes, 4096);  // page-aligned, fixed geometry
  * pool.reserve(4);
  *
  * for(uint64_t i = 0; i < frameCount; ++i) {
- *     Buffer buf = pool.acquire();       // O(1), no malloc if warmed
+ *     Buffer buf = pool.acquire();    // lock-free, no malloc if warmed
  *     file.readBulk(buf, imageBytes);
- *     // ... use buf ...
- *     pool.release(std::move(buf));
- * }
+ *     sink.push(buf);                 // returns to the pool once the
+ * }                                   // sink drops its last copy
  * @endcode
  */
 class BufferPool {
         public:
-                /** @brief Default-constructs an invalid pool with no geometry. */
-                BufferPool() = default;
+                /** @brief Maximum number of size classes a single pool tracks. */
+                static constexpr size_t MaxSizeClasses = 16;
+
+                /** @brief Construction parameters for a pool. */
+                struct Config {
+                                /** @brief Fixed buffer size served by @ref acquire() (0 = variable-size only). */
+                                size_t bufferSize = 0;
+                                /** @brief Block alignment in bytes (0 = @c Buffer::DefaultAlign). */
+                                size_t alignment = 0;
+                                /** @brief Idle blocks kept per size class before returns are freed. */
+                                size_t highWatermark = 16;
+                                /** @brief Idle blocks per size class left behind by @ref trim(). */
+                                size_t lowWatermark = 2;
+                                /** @brief Blocks (idle + in flight) tracked per size class. */
+                                size_t maxBuffersPerClass = 64;
+                                /** @brief Memory space block memory is allocated from. */
+                                MemSpace memSpace;
+                };
+
+                /** @brief Constructs a variable-size pool with default watermarks. */
+                BufferPool();
 
                 /**
                  * @brief Constructs a pool that hands out @p bufferSize-byte buffers.
@@ -77,63 +118,113 @@ class BufferPool {
                  */
                 BufferPool(size_t bufferSize, size_t alignment = 0, const MemSpace &ms = MemSpace::Default);
 
-                /** @brief Destructor — releases all pooled buffers. */
-                ~BufferPool() = default;
+                /** @brief Constructs a pool from an explicit @ref Config. */
+                explicit BufferPool(const Config &config);
+
+                /** @brief Drops this handle; the pool lives on while vended buffers remain. */
+                ~BufferPool();
+
+                /** @brief Copies the handle — both refer to the same pool. */
+                BufferPool(const BufferPool &other);
+
+                /** @brief Moves the handle, leaving @p other without a pool. */
+                BufferPool(BufferPool &&other) noexcept;
 
-                BufferPool(const BufferPool &) = delete;
-                BufferPool &operator=(const BufferPool &) = delete;
-                BufferPool(BufferPool &&) noexcept = default;
-                BufferPool &operator=(BufferPool &&) noexcept = default;
+                /** @brief Copy-assigns the handle. */
+                BufferPool &operator=(const BufferPool &other);
 
-                /** @brief Returns the size of each buffer in bytes. */
-                size_t bufferSize() const { return _bufferSize; }
+                /** @brief Move-assigns the handle. */
+                BufferPool &operator=(BufferPool &&other) noexcept;
 
-                /** @brief Returns the alignment of each buffer in bytes. */
-                size_t alignment() const { return _alignment; }
+                /** @brief Returns the fixed buffer size in bytes (0 for a variable-size pool). */
+                size_t bufferSize() const;
 
-                /** @brief Returns the number of buffers currently in the free list. */
-                size_t available() const { return _free.size(); }
+                /** @brief Returns the block alignment in bytes. */
+                size_t alignment() const;
+
+                /** @brief Returns the memory space blocks are allocated from. */
+                MemSpace memSpace() const;
+
+                /** @brief Returns the configuration the pool was built with. */
+                const Config &config() const;
+
+                /** @brief Returns the number of idle buffers across every size class. */
+                size_t available() const;
+
+                /** @brief Returns the number of idle buffers in the class serving @p bytes. */
+                size_t available(size_t bytes) const;
+
+                /** @brief Returns the number of size classes claimed so far. */
+                size_t sizeClassCount() const;
 
                 /**
-                 * @brief Pre-allocates @p count buffers into the free list.
+                 * @brief Pre-allocates idle buffers of the fixed size.
                  *
-                 * Does nothing if the free list already has at least
-                 * @p count buffers.
+                 * Tops the fixed-size class up to @p count idle
+                 * buffers (clamped to the high watermark).  Does
+                 * nothing on a variable-size pool.
                  */
                 void reserve(size_t count);
 
                 /**
-                 * @brief Acquires a buffer from the pool.
+                 * @brief Pre-allocates @p count idle buffers of @p bytes.
                  *
-                 * Returns a free buffer if one is available, otherwise
-                 * allocates a fresh one. The returned @c Buffer is
-                 * owned by the caller until @c release() is called.
+                 * Claims the size class if needed, then tops it up to
+                 * @p count idle buffers (clamped to the high watermark).
+                 */
+                void reserve(size_t count, size_t bytes);
+
+                /**
+                 * @brief Acquires a buffer of the pool's fixed size.
                  *
-                 * @return A valid @c Buffer, or an invalid Buffer if
-                 *         allocation fails.
+                 * @return A valid @c Buffer, or an invalid Buffer when
+                 *         the pool has no fixed size or allocation fails.
                  */
                 Buffer acquire();
 
                 /**
-                 * @brief Returns a previously-acquired buffer to the pool.
+                 * @brief Acquires a buffer of at least @p bytes.
                  *
-                 * The buffer must have been originally returned by
-                 * @c acquire() on the same pool. Its @c allocSize() and
-                 * @c align() are checked; a mismatch drops the buffer
-                 * instead of returning it to the free list.
+                 * Pops an idle block of the matching size class when
+                 * one is available, otherwise allocates a fresh block.
+                 * The returned buffer's view starts at the allocation
+                 * base with a logical size of 0.
+                 *
+                 * @param bytes Requested size in bytes.
+                 * @param align Required alignment (0 = the pool's).  An
+                 *              alignment stricter than the pool's is
+                 *              served unpooled.
+                 * @return A valid @c Buffer, or an invalid Buffer if
+                 *         @p bytes is zero or allocation fails.
+                 */
+                Buffer acquire(size_t bytes, size_t align = 0);
+
+                /**
+                 * @brief Drops a buffer handle.
+                 *
+                 * Kept for callers of the old explicit-release API.
+                 * Pooled buffers recycle themselves when their last
+                 * handle goes away, so this is just an early drop of
+                 * @p buf; buffers from anywhere else are released
+                 * normally.
                  *
                  * @param buf The buffer to release (moved in).
                  */
                 void release(Buffer &&buf);
 
-                /** @brief Drops all pooled buffers. */
+                /** @brief Frees idle buffers down to the low watermark in every class. */
+                void trim();
+
+                /** @brief Frees every idle buffer.  Buffers in flight are unaffected. */
                 void clear();
 
         private:
-                size_t       _bufferSize = 0;
-                size_t       _alignment = 0;
-                MemSpace     _memSpace;
-                List<Buffer> _free;
+                struct Pool;
+                // Proxy storage spelled out so the native-object trait is
+                // never evaluated against the incomplete Pool.
+                using PoolPtr = SharedPtr<Pool, false, SharedPtrProxy<Pool>>;
+
+                PoolPtr _pool;
 };
 
 PROMEKI_NAMESPACE_END
@@ -14,9 +14,22 @@
 #include <cstdint>
 #include <type_traits>
 #include <promeki/namespace.h>
+#include <promeki/error.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
+/**
+ * @brief Selects the inner loop @ref CRC::update runs.
+ * @ingroup core
+ */
+enum class CrcEngine {
+        Auto,     ///< Fastest engine available for the parameters and the running CPU.
+        Bytewise, ///< One 256-entry table lookup per input byte.
+        Slice8,   ///< Slice-by-8: eight table lookups per 8 input bytes.
+        Slice16,  ///< Slice-by-16: sixteen table lookups per 16 input bytes.
+        Clmul     ///< Carry-less multiply folding (PCLMULQDQ / PMULL); reflected CRC-32 only.
+};
+
 /**
  * @brief Table-driven cyclic redundancy check (CRC) computation.
  * @ingroup core
@@ -31,11 +44,24 @@ PROMEKI_NAMESPACE_BEGIN
  * that controls *both* input and output bit reflection (the asymmetric
  * @c refIn != @c refOut combinations are exotic and not supported here).
  *
- * Each @c CRC instance owns a 256-entry lookup table that is computed
- * once in the constructor.  After that, @ref update is a tight
- * byte-at-a-time loop with one table read, one XOR, and one shift per
- * input byte — fast enough for video-rate use without any further
- * vectorisation.
+ * Lookup tables are built the first time a given polynomial /
+ * reflection pair is seen and then shared, read-only, by every @c CRC
+ * instance (and every @ref compute call) that uses the same pair, so
+ * constructing a @c CRC is cheap after the first one.  @ref update
+ * runs one of several engines (see @ref CrcEngine):
+ *
+ * - @c Slice8 / @c Slice16 — slice-by-N table lookups that consume 8
+ *   or 16 input bytes per step.  Available for every width.
+ * - @c Clmul — carry-less multiply folding (x86 PCLMULQDQ, ARMv8
+ *   PMULL) for reflected 32-bit CRCs such as CRC-32/ISO-HDLC and
+ *   CRC-32C.  The folding constants are derived from the polynomial,
+ *   so any reflected CRC-32 qualifies; the short tail that does not
+ *   fill a 16-byte block goes through @c Slice16.
+ * - @c Bytewise — the one-lookup-per-byte reference loop.
+ *
+ * The default, @c CrcEngine::Auto, picks @c Clmul when the CPU and
+ * the parameters allow it and a slice-by-N engine otherwise.  Every
+ * engine produces bit-identical results.
  *
  * @par Example
  * @code
@@ -58,6 +84,11 @@ PROMEKI_NAMESPACE_BEGIN
  * this class use those check values to validate the @ref CrcParams
  * presets.
  *
+ * @par Thread Safety
+ * Conditionally thread-safe.  Distinct instances may be used
+ * concurrently (the shared tables are immutable once built); a single
+ * instance must not be updated from several threads at once.
+ *
  * @see CrcParams, crc8_smbus, crc8_autosar, crc16_ccitt_false, crc32_iso_hdlc
  */
 template <typename T> class CRC {
@@ -134,12 +165,44 @@ template <typename T> class CRC {
                 /** @brief Returns the parameters this CRC was constructed with. */
                 const Params &params() const { return _params; }
 
+                /**
+                 * @brief Selects the engine used by subsequent @ref update calls.
+                 *
+                 * @c CrcEngine::Auto re-resolves to the fastest supported
+                 * engine.  Switching engines mid-message is allowed; the
+                 * running register carries over unchanged.
+                 *
+                 * @param engine The engine to use.
+                 * @return @ref Error::Ok, or @ref Error::NotSupported when
+                 *         @p engine cannot run these parameters on this
+                 *         CPU (the current engine is left in place).
+                 */
+                Error setEngine(CrcEngine engine);
+
+                /**
+                 * @brief Returns the engine @ref update runs.
+                 * @return The resolved engine; never @c CrcEngine::Auto.
+                 */
+                CrcEngine engine() const { return _engine; }
+
+                /**
+                 * @brief Returns true if @p engine can run @p params on this CPU.
+                 * @param params Algorithm parameters.
+                 * @param engine The engine to test.
+                 * @return True when @ref setEngine would accept @p engine.
+                 */
+                static bool isEngineSupported(const Params &params, CrcEngine engine);
+
         private:
-                void buildTable();
+                struct Tables;
 
-                Params _params{};
-                T      _table[256]{};
-                T      _crc{};
+                static const Tables *tablesFor(const Params &params);
+                static CrcEngine     resolveEngine(const Params &params, CrcEngine engine);
+
+                Params        _params{};
+                const Tables *_tables = nullptr;
+                CrcEngine     _engine = CrcEngine::Bytewise;
+                T             _crc{};
 };
 
 extern template class CRC<uint8_t>;
@@ -187,6 +250,12 @@ namespace CrcParams {
         inline constexpr Crc32::Params Crc32IsoHdlc{0x04C11DB7u, 0xFFFFFFFFu, 0xFFFFFFFFu, true, "CRC-32/ISO-HDLC"};
         /// CRC-32/BZIP2 — same poly as ISO-HDLC but unreflected.
         inline constexpr Crc32::Params Crc32Bzip2{0x04C11DB7u, 0xFFFFFFFFu, 0xFFFFFFFFu, false, "CRC-32/BZIP2"};
+        /// CRC-32C (Castagnoli, CRC-32/ISCSI) — poly 0x1EDC6F41, init 0xFFFFFFFF,
+        /// reflected, xor 0xFFFFFFFF.  Used by iSCSI, SCTP, ext4 and Btrfs.
+        inline constexpr Crc32::Params Crc32c{0x1EDC6F41u, 0xFFFFFFFFu, 0xFFFFFFFFu, true, "CRC-32C"};
+
+        /// CRC-64/XZ — poly 0x42F0E1EBA9EA3693, init all-ones, reflected, xor all-ones.
+        inline constexpr Crc64::Params Crc64Xz{0x42F0E1EBA9EA3693ull, ~0ull, ~0ull, true, "CRC-64/XZ"};
 
 } // namespace CrcParams
 
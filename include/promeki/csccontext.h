@@ -12,7 +12,9 @@
 #if PROMEKI_ENABLE_CSC
 #include <promeki/namespace.h>
 #include <promeki/sharedptr.h>
+#include <promeki/uniqueptr.h>
 #include <promeki/buffer.h>
+#include <cstdint>
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -29,11 +31,23 @@ PROMEKI_NAMESPACE_BEGIN
  * have its own @c CSCContext instance; concurrent access to a single
  * instance is unsupported.
  *
+ * @par Per-thread cache
+ * Constructing a context allocates @ref BufferCount aligned line
+ * buffers, which is too expensive to do once per frame.  @ref acquire
+ * hands out a @ref Lease on a context cached in thread-local storage,
+ * growing it only when a wider line than it has seen before comes
+ * along, so a steady-state conversion loop allocates nothing.  A
+ * nested @ref acquire on a thread whose cached context is already
+ * leased falls back to a private context for the duration of that
+ * lease.  Process-wide hit / miss counters are available from
+ * @ref cacheStats.
+ *
  * @par Example
  * @code
- * CSCContext ctx(1920);
+ * CSCContext::Lease lease = CSCContext::acquire(1920);
+ * if(!lease.isValid()) return Error::NoMem;
  * pipeline.processLine(srcPlanes, srcStrides, dstPlanes, dstStrides,
- *                      1920, y, ctx);
+ *                      1920, y, lease.context());
  * @endcode
  *
  * @see CSCPipeline
@@ -50,6 +64,73 @@ class CSCContext {
                 /** @brief Alignment for internal buffers (matches Highway max lane width). */
                 static constexpr size_t BufferAlign = 128;
 
+                /** @brief Plain-value snapshot of the per-thread cache counters. */
+                struct CacheStats {
+                                uint64_t hits = 0;   ///< Acquires served by the cached context as-is.
+                                uint64_t misses = 0; ///< Acquires that had to allocate (first use, growth, nesting).
+                };
+
+                /**
+                 * @brief Scoped claim on a cached (or fallback) context.
+                 *
+                 * Returned by @ref acquire.  Move-only; releasing the
+                 * lease returns the thread's cached context for reuse
+                 * by the next @ref acquire on the same thread.
+                 */
+                class Lease {
+                        public:
+                                /** @brief Constructs an empty lease. */
+                                Lease() = default;
+
+                                /** @brief Releases the lease. */
+                                ~Lease();
+
+                                Lease(const Lease &) = delete;
+                                Lease &operator=(const Lease &) = delete;
+
+                                /** @brief Transfers the lease from @p other. */
+                                Lease(Lease &&other) noexcept;
+
+                                /** @brief Releases this lease, then takes over @p other. */
+                                Lease &operator=(Lease &&other) noexcept;
+
+                                /**
+                                 * @brief Returns true if the leased context is allocated.
+                                 * @return false when the lease is empty or allocation failed.
+                                 */
+                                bool isValid() const { return _ctx != nullptr && _ctx->isValid(); }
+
+                                /**
+                                 * @brief Returns the leased context.
+                                 * @return The context; only meaningful when isValid() is true.
+                                 */
+                                CSCContext &context() { return *_ctx; }
+
+                        private:
+                                friend class CSCContext;
+                                CSCContext            *_ctx = nullptr;
+                                bool                  *_busy = nullptr;
+                                UniquePtr<CSCContext> _fallback;
+
+                                void release();
+                };
+
+                /**
+                 * @brief Leases this thread's cached context, sized for at least @p maxWidth.
+                 * @param maxWidth Maximum number of pixels per scanline the caller needs.
+                 * @return A lease; check @ref Lease::isValid for allocation failure.
+                 */
+                static Lease acquire(size_t maxWidth);
+
+                /**
+                 * @brief Returns the process-wide cache hit / miss counters.
+                 * @return A snapshot of the counters.
+                 */
+                static CacheStats cacheStats();
+
+                /** @brief Zeroes the process-wide cache counters. */
+                static void resetCacheStats();
+
                 /** @brief Constructs an invalid context. */
                 CSCContext() = default;
 
@@ -52,6 +52,7 @@ PROMEKI_NAMESPACE_BEGIN
  * |-----|------|---------|-------------|
  * | @ref MediaConfig::OutputPixelFormat | PixelFormat | Invalid (pass-through) | Target video pixel description. |
  * | @ref MediaConfig::Capacity        | int       | 4                      | Maximum output FIFO depth. |
+ * | @ref MediaConfig::CscThreads      | int       | 1                      | Row bands converted in parallel per frame (0 = one per CPU). |
  *
  * @par Stats keys
  *
@@ -109,6 +110,7 @@ class CscMediaIO : public SharedThreadMediaIO {
                 PixelFormat _outputPixelFormat;
                 bool        _outputPixelFormatSet = false;
                 int         _capacity = 4;
+                int         _cscThreads = 1;
 
                 Frame::List _outputQueue;
                 FrameCount       _frameCount{0};
@@ -23,6 +23,7 @@ PROMEKI_NAMESPACE_BEGIN
 
 class Image;
 class UncompressedVideoPayload;
+class ThreadPool;
 
 /**
  * @brief Pre-compiled color space conversion pipeline.
@@ -65,6 +66,19 @@ class UncompressedVideoPayload;
  * 3. **Scalar generic** — same pipeline, SIMD disabled.  Selected by
  *    setting @ref MediaConfig::CscPath to @c CscPath::Scalar in the config.
  *
+ * @par Slice-parallel execution
+ * Every tier is a pure per-scanline function, so @c execute() can split
+ * the frame into horizontal row bands and convert them concurrently.
+ * Setting @ref MediaConfig::CscThreads above 1 (or to 0 for
+ * @ref BasicThread::idealThreadCount) enables this mode: the calling
+ * thread converts the first band itself and hands the rest to the
+ * shared @ref threadPool, each band running with its worker thread's
+ * cached @ref CSCContext.  Band boundaries are aligned to the least common
+ * multiple of every plane's vertical subsampling and the wire-row step
+ * (@c vSubsampling of destination plane 0), so 4:2:0 chroma rows and
+ * ST 2110-20 two-line pgroups never straddle two bands.  Output is
+ * byte-identical to the single-threaded path.
+ *
  * @par Accuracy
  * The scalar pipeline matches Color::convert() within ±2 LSB for 8-bit.
  * Fast paths use integer BT.709/601/2020 arithmetic and differ from the
@@ -97,6 +111,15 @@ class CSCPipeline {
                 /** @brief Maximum LUT size for transfer function tables. */
                 static constexpr size_t MaxLUTSize = 4096;
 
+                /**
+                 * @brief Smallest band height (in image rows) handed to a worker.
+                 *
+                 * Frames too short to give every worker at least this
+                 * many rows use fewer bands, so small images never pay
+                 * dispatch overhead that outweighs the conversion itself.
+                 */
+                static constexpr size_t MinRowsPerBand = 32;
+
                 /**
                  * @brief Identifies a single processing stage in the pipeline.
                  */
@@ -320,7 +343,7 @@ class CSCPipeline {
                  * @brief Returns a shared, compiled pipeline from a global cache.
                  *
                  * Since a compiled @c CSCPipeline is a pure function of
-                 * @c (srcDesc, dstDesc, useSimd) — it stores no
+                 * @c (srcDesc, dstDesc, useSimd, threadCount) — it stores no
                  * image-specific state and @c execute() is documented
                  * as thread-safe to call concurrently — the library
                  * keeps a process-wide cache of compiled pipelines.
@@ -336,8 +359,9 @@ class CSCPipeline {
                  * @par Thread safety
                  * The cache itself is mutex-protected.  The returned
                  * pipeline is safe to execute from any thread; each
-                 * call to @c execute() allocates its own scratch
-                 * @c CSCContext.
+                 * call to @c execute() leases the calling thread's
+                 * cached scratch @c CSCContext (see
+                 * @ref CSCContext::acquire).
                  *
                  * @par Example
                  * @code
@@ -350,8 +374,9 @@ class CSCPipeline {
                  * @param src    Source pixel description.
                  * @param dst    Target pixel description.
                  * @param config Optional configuration hints.  Only
-                 *               @ref MediaConfig::CscPath currently
-                 *               affects the cache key; other keys are
+                 *               @ref MediaConfig::CscPath and
+                 *               @ref MediaConfig::CscThreads currently
+                 *               affect the cache key; other keys are
                  *               ignored for the purposes of lookup.
                  * @return A shared pipeline, or a null @c Ptr on
                  *         allocation failure.  The pipeline may still
@@ -361,6 +386,20 @@ class CSCPipeline {
                 static Ptr cached(const PixelFormat &src, const PixelFormat &dst,
                                   const MediaConfig &config = MediaConfig());
 
+                /**
+                 * @brief Returns the worker pool used for slice-parallel execution.
+                 *
+                 * A dedicated process-wide pool (threads named
+                 * @c "csc<N>") sized to @ref BasicThread::idealThreadCount.
+                 * It is deliberately separate from
+                 * @ref SharedThreadMediaIO::pool: a @ref CscMediaIO strand
+                 * blocks on its bands, and running those bands on the
+                 * same pool could starve it of workers.
+                 *
+                 * @return A reference to the static ThreadPool instance.
+                 */
+                static ThreadPool &threadPool();
+
                 /**
                  * @brief Returns true if the pipeline was compiled successfully.
                  * @return true if the pipeline is ready to execute.
@@ -408,6 +447,16 @@ class CSCPipeline {
                  */
                 const Stage &stage(int i) const { return _stages[i]; }
 
+                /**
+                 * @brief Returns the number of row bands @c execute() may run concurrently.
+                 *
+                 * Resolved at construction from
+                 * @ref MediaConfig::CscThreads: 1 means the classic
+                 * single-threaded walk, 0 in the config resolves to
+                 * @ref BasicThread::idealThreadCount.
+                 */
+                int threadCount() const { return _threadCount; }
+
                 /**
                  * @brief Converts an entire payload.
                  *
@@ -416,6 +465,14 @@ class CSCPipeline {
                  * matching dimensions.  @p dst must already have
                  * allocated plane buffers (see
                  * @ref UncompressedVideoPayload::allocate).
+                 *
+                 * When @ref threadCount is greater than one the frame is
+                 * converted as parallel row bands (see the class notes);
+                 * the call still returns only once every band is done.
+                 *
+                 * @return @c Error::Ok on success, @c Error::Invalid on a
+                 *         bad pipeline / payload / size mismatch, or
+                 *         @c Error::NoMem if scratch allocation failed.
                  */
                 Error execute(const UncompressedVideoPayload &src, UncompressedVideoPayload &dst) const;
 
@@ -442,10 +499,14 @@ class CSCPipeline {
                 bool                     _valid = false;
                 bool                     _identity = false;
                 bool                     _useSimd = true;
+                int                      _threadCount = 1;
                 CSCRegistry::LineFuncPtr _fastPathFunc = nullptr;
                 List<Stage>              _stages;
 
                 void compile();
+                size_t bandRowAlign() const;
+                Error executeRows(const UncompressedVideoPayload &src, UncompressedVideoPayload &dst, size_t yBegin,
+                                  size_t yEnd) const;
                 void buildUnpackStage(const PixelFormat &pd, Stage &stage);
                 void buildPackStage(const PixelFormat &pd, Stage &stage);
                 void buildRangeStage(const PixelFormat &pd, Stage &stage, bool isInput);
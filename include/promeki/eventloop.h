@@ -35,11 +35,12 @@ class ObjectBase;
 // interrupt poll() when new work is posted.
 class EventLoopWakeFd;
 
-// Defined in eventloop.cpp; caches the poll() descriptor set so a
-// loop servicing many I/O sources doesn't rebuild an N-entry array
-// on every wake.  Holds POSIX pollfd state we don't want to leak
-// into this header; rebuilt only when a source is added or removed.
-class EventLoopPollCache;
+// Defined in eventloop.cpp; the I/O readiness backend behind
+// waitOnSources.  epoll on Linux (O(1) registration, wait cost
+// proportional to the ready set), a cached poll() set elsewhere or
+// when epoll is unavailable.  Holds platform state we don't want to
+// leak into this header.
+class EventLoopPoller;
 
 /**
  * @brief Per-thread event loop providing event dispatch, timers, and posted callables.
@@ -331,7 +332,7 @@ class EventLoop {
                  */
                 static constexpr uint32_t IoRead = 0x01;  ///< fd is readable
                 static constexpr uint32_t IoWrite = 0x02; ///< fd is writable
-                static constexpr uint32_t IoError = 0x04; ///< error / hangup (always reported; mask is informational)
+                static constexpr uint32_t IoError = 0x04; ///< error / hangup (always reported; may be used alone)
                 /** @} */
 
                 /**
@@ -377,11 +378,20 @@ class EventLoop {
                  * @param fd     The file descriptor to monitor.
                  * @param events Bitmask of @c IoEvent values requesting
                  *               read / write readiness notifications.
+                 *               @ref IoError alone registers for error
+                 *               and hangup wakes only (e.g. a socket
+                 *               error queue).
                  * @param cb     Callback invoked with (fd, readyEvents)
                  *               on each readiness event.
+                 * Descriptors that are always ready (regular files,
+                 * @c /dev/null — e.g. a redirected stdin) are reported
+                 * readable and writable on every wake, as @c poll()
+                 * does, even though epoll cannot watch them.
+                 *
                  * @return A handle @c >= 0 on success, or @c -1 on
                  *         failure (invalid @p fd, empty @p cb, empty
-                 *         @p events, or unsupported on this platform).
+                 *         @p events, an fd the backend refuses, or
+                 *         unsupported on this platform).
                  *
                  * @note On non-POSIX platforms (Windows, Emscripten)
                  *       this call currently returns @c -1 and records
@@ -432,9 +442,10 @@ class EventLoop {
                  * @ref sleep and @ref queueWait are mutually
                  * exclusive — one is always zero depending on
                  * whether the loop is using POSIX wake fds (the
-                 * @c poll() path) or the queue-based fallback
-                 * (@c Queue::pop).  Inspecting which sibling is
-                 * non-zero identifies the wait strategy.
+                 * @c epoll_wait() / @c poll() path) or the
+                 * queue-based fallback (@c Queue::pop).  Inspecting
+                 * which sibling is non-zero identifies the wait
+                 * strategy; @ref ioBackend names it outright.
                  *
                  * @par Practical implication
                  * In a fully-labeled workload @ref callablesCount
@@ -462,7 +473,7 @@ class EventLoop {
 
                         String   loopName;          ///< From @ref setName; empty if never set.
                         Duration wallElapsed;       ///< Wall time covered by this snapshot.  Invalid when no monitor.
-                        Duration sleep;             ///< Time blocked in poll() / wake fd (POSIX wait path).
+                        Duration sleep;             ///< Time blocked in epoll_wait() / poll() (POSIX wait path).
                         Duration queueWait;         ///< Time blocked in @c Queue::pop (non-POSIX fallback).  0 on POSIX.
                         Duration timers;            ///< Time inside timer callbacks.
                         Duration events;            ///< Time inside @c event() dispatch.
@@ -475,6 +486,18 @@ class EventLoop {
                         int64_t  callablesCount = 0; ///< Number of posted callables dispatched.
                         int64_t  ioCount        = 0; ///< Number of IO callback fires.
 
+                        /// @name Gauges
+                        /// Point-in-time values sampled when the
+                        /// snapshot is taken, not accumulated over
+                        /// the interval.  Filled even when no monitor
+                        /// is installed.
+                        /// @{
+                        String   ioBackend;          ///< I/O wait backend: @c "epoll", @c "poll" or @c "queue".
+                        int64_t  ioSources      = 0; ///< Registered I/O sources.
+                        int64_t  timersArmed    = 0; ///< Armed timers (single-shot and repeating).
+                        int64_t  timerHeapSize  = 0; ///< Deadline heap entries, incl. cancelled ones not yet pruned.
+                        /// @}
+
                         /// Per-Event::type() breakdown of the @ref events bucket.
                         HashMap<int, EventStat> eventsByType;
 
@@ -648,13 +671,24 @@ class EventLoop {
                                 TimeStamp             nextFire;
                 };
 
+                // One pending deadline in the timer heap.  Only
+                // processTimers rearms a timer, and it pops the old
+                // entry first, so an entry is live exactly when its
+                // id is still in _timers — stopTimer just erases the
+                // map entry and leaves the heap entry to be pruned
+                // when it surfaces.
+                struct TimerHeapEntry {
+                                TimeStamp nextFire;
+                                int       id;
+                };
+
                 static thread_local EventLoop *_current;
 
                 Queue<Item>  _queue;
                 Atomic<bool> _running;
                 Atomic<int>  _exitCode;
 
-                // Timer list access is guarded by _timersMutex.  Any
+                // Timer state is guarded by _timersMutex.  Any
                 // thread may install or stop timers via startTimer /
                 // stopTimer, so the mutex is acquired on every touch.
                 // processTimers() takes a snapshot of the ready-to-fire
@@ -662,44 +696,49 @@ class EventLoop {
                 // invokes callbacks — this avoids deadlocks if a timer
                 // callback calls startTimer() or stopTimer() on the
                 // same event loop, and keeps the lock hold time bounded.
-                mutable Mutex   _timersMutex;
-                List<TimerInfo> _timers;
-                Atomic<int>     _nextTimerId{1};
+                //
+                // _timers is keyed by id; _timerHeap is a binary
+                // min-heap of deadlines over it, so start / stop /
+                // rearm are O(log n) and the next-deadline lookup is
+                // O(1) instead of a scan of every armed timer.
+                mutable Mutex                 _timersMutex;
+                HashMap<int, TimerInfo>       _timers;
+                mutable List<TimerHeapEntry>  _timerHeap;
+                Atomic<int>                   _nextTimerId{1};
 
                 // Platform wake fd (eventfd on Linux, self-pipe
                 // elsewhere).  Owned by the EventLoop; opened in the
                 // constructor, closed in the destructor.  Written by
                 // postCallable / postEvent / quit / startTimer /
-                // stopTimer to unblock poll() in waitOnSources, and
-                // included in every poll set as index 0.
+                // stopTimer to unblock the wait in waitOnSources, and
+                // registered with the poller alongside the I/O sources.
                 using WakeFdUPtr = UniquePtr<EventLoopWakeFd>;
                 WakeFdUPtr _wake;
 
-                // I/O source registration.  Mutation under _ioMutex,
-                // poll set built under _ioMutex into a short-lived
-                // stack copy, callbacks fired after the lock is
+                // I/O source registration, keyed by handle.  Mutation
+                // under _ioMutex, callbacks fired after the lock is
                 // released so a callback may call addIoSource /
                 // removeIoSource on the same EventLoop without
-                // deadlocking.
+                // deadlocking.  Ready handles reported by the poller
+                // are looked up here again under the lock, so a
+                // source removed while the loop was waiting simply
+                // misses and never fires.
                 struct IoSource {
                                 int        handle;
                                 int        fd;
                                 uint32_t   events;
                                 IoCallback cb;
-                                bool       pendingRemove = false;
                 };
-                mutable Mutex  _ioMutex;
-                List<IoSource> _ioSources;
-                Atomic<int>    _nextIoHandle{1};
-
-                // Cached poll() descriptor set + dirty flag (see
-                // EventLoopPollCache in eventloop.cpp).  Rebuilt under
-                // _ioMutex only when an IoSource is added or removed,
-                // then reused across waitOnSources iterations so the
-                // steady-state wake path costs a lock + flag check
-                // rather than an O(number-of-sources) array rebuild.
-                using PollCacheUPtr = UniquePtr<EventLoopPollCache>;
-                PollCacheUPtr _pollCache;
+                mutable Mutex          _ioMutex;
+                HashMap<int, IoSource> _ioSources;
+                Atomic<int>            _nextIoHandle{1};
+
+                // Readiness backend (see EventLoopPoller in
+                // eventloop.cpp).  Registration calls are made under
+                // _ioMutex; the wait itself runs on the loop thread
+                // without the lock.
+                using PollerUPtr = UniquePtr<EventLoopPoller>;
+                PollerUPtr _poller;
 
                 /**
                  * @brief Writes to the internal wake fd unconditionally.
@@ -715,8 +754,23 @@ class EventLoop {
                 bool dispatchItem(Item &item);
                 void processTimers();
 
+                // Heap ordering for _timerHeap: std::push_heap /
+                // pop_heap build a max-heap, so "less" means "fires
+                // later".  Ties break on id so timers sharing a
+                // deadline fire in the order they were started.
+                static bool timerFiresLater(const TimerHeapEntry &a, const TimerHeapEntry &b);
+
+                // Pops cancelled entries off the top of _timerHeap.
+                // Caller holds _timersMutex.
+                void pruneTimerHeap() const;
+
+                // Fills the Report gauges (backend, source / timer
+                // counts).  Takes _ioMutex and _timersMutex in turn,
+                // never together and never under _statsMutex.
+                void fillGauges(Report &out) const;
+
                 // Waits on the wake fd + registered I/O sources via
-                // poll(), for up to @p waitMs milliseconds (0 = wait
+                // the poller, for up to @p waitMs milliseconds (0 = wait
                 // indefinitely — callers clamp by timers before
                 // calling).  On return, drains the wake fd and fires
                 // any ready I/O source callbacks.  On non-POSIX
@@ -0,0 +1,400 @@
+/**
+ * @file      flatmap.h
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#pragma once
+
+
+#include <promeki/config.h>
+#if PROMEKI_ENABLE_CORE
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <promeki/namespace.h>
+#include <promeki/list.h>
+
+PROMEKI_NAMESPACE_BEGIN
+
+/**
+ * @brief Ordered associative container stored as a sorted contiguous array.
+ * @ingroup containers
+ *
+ * FlatMap keeps its entries in a single array sorted by key, with room
+ * for @p InlineCapacity entries inside the object itself.  Small maps
+ * therefore need no heap allocation at all, lookups are a binary search
+ * over cache-resident data, and copying a map is one pass over a
+ * contiguous block instead of a node-by-node tree rebuild.  Once the
+ * map grows past the inline capacity the entries move to a single heap
+ * block that grows geometrically.
+ *
+ * The API mirrors @ref Map (Qt-style @c insert overwrites, @c remove,
+ * @c contains, @c find, iteration yields @c first / @c second pairs in
+ * ascending key order), so it can stand in for @ref Map wherever the
+ * entry count is small and lookups dominate.  Inserting or removing in
+ * the middle shifts the tail, so it is the wrong choice for maps with
+ * thousands of entries that churn constantly.
+ *
+ * @par Iterator invalidation
+ * Unlike @ref Map, any insertion or removal invalidates every iterator,
+ * pointer, and reference into the map.
+ *
+ * @par Thread Safety
+ * Conditionally thread-safe.  Distinct instances may be used
+ * concurrently; concurrent access to a single instance must be
+ * externally synchronized.
+ *
+ * @tparam K              Key type.  Must be less-than comparable.
+ * @tparam V              Value type.
+ * @tparam InlineCapacity Entries stored without a heap allocation.
+ *
+ * @par Example
+ * @code
+ * FlatMap<uint64_t, String, 8> names;
+ * names.insert(42, "answer");
+ * names.insert(7, "seven");
+ * auto it = names.find(42);          // binary search
+ * for (const auto &[k, v] : names) { ... }  // 7, then 42
+ * @endcode
+ */
+template <typename K, typename V, size_t InlineCapacity = 16> class FlatMap {
+                static_assert(InlineCapacity > 0, "FlatMap needs at least one inline entry");
+
+        public:
+                /** @brief Stored entry type; @c first is the key, @c second the value. */
+                using Entry = std::pair<K, V>;
+
+                /** @brief Mutable iterator.  The key must not be modified through it. */
+                using Iterator = Entry *;
+
+                /** @brief Const iterator. */
+                using ConstIterator = const Entry *;
+
+                /** @brief Number of entries held without a heap allocation. */
+                static constexpr size_t InlineEntries = InlineCapacity;
+
+                /** @brief Default constructor.  Creates an empty map. */
+                FlatMap() = default;
+
+                /** @brief Copy constructor. */
+                FlatMap(const FlatMap &other) {
+                        reserve(other._size);
+                        std::uninitialized_copy(other.cbegin(), other.cend(), _data);
+                        _size = other._size;
+                }
+
+                /** @brief Move constructor.  Steals the heap block when there is one. */
+                FlatMap(FlatMap &&other) noexcept { takeFrom(other); }
+
+                /**
+                 * @brief Constructs a map from an initializer list of key-value pairs.
+                 *
+                 * Later duplicates overwrite earlier ones, as with @ref insert.
+                 *
+                 * @param initList Brace-enclosed list of {key, value} pairs.
+                 */
+                FlatMap(std::initializer_list<Entry> initList) {
+                        reserve(initList.size());
+                        for (const Entry &e : initList) insert(e.first, e.second);
+                }
+
+                /** @brief Destructor. */
+                ~FlatMap() { release(); }
+
+                /** @brief Copy assignment operator. */
+                FlatMap &operator=(const FlatMap &other) {
+                        if (this == &other) return *this;
+                        clear();
+                        reserve(other._size);
+                        std::uninitialized_copy(other.cbegin(), other.cend(), _data);
+                        _size = other._size;
+                        return *this;
+                }
+
+                /** @brief Move assignment operator. */
+                FlatMap &operator=(FlatMap &&other) noexcept {
+                        if (this == &other) return *this;
+                        release();
+                        takeFrom(other);
+                        return *this;
+                }
+
+                // -- Iterators --
+
+                /** @brief Returns a mutable iterator to the first entry. */
+                Iterator begin() noexcept { return _data; }
+
+                /** @brief Returns a const iterator to the first entry. */
+                ConstIterator begin() const noexcept { return _data; }
+
+                /** @brief Returns a const iterator to the first entry. */
+                ConstIterator cbegin() const noexcept { return _data; }
+
+                /// @copydoc cbegin()
+                ConstIterator constBegin() const noexcept { return _data; }
+
+                /** @brief Returns a mutable iterator to one past the last entry. */
+                Iterator end() noexcept { return _data + _size; }
+
+                /** @brief Returns a const iterator to one past the last entry. */
+                ConstIterator end() const noexcept { return _data + _size; }
+
+                /** @brief Returns a const iterator to one past the last entry. */
+                ConstIterator cend() const noexcept { return _data + _size; }
+
+                /// @copydoc cend()
+                ConstIterator constEnd() const noexcept { return _data + _size; }
+
+                // -- Capacity --
+
+                /** @brief Returns true if the map has no entries. */
+                bool isEmpty() const noexcept { return _size == 0; }
+
+                /** @brief Returns the number of key-value pairs. */
+                size_t size() const noexcept { return _size; }
+
+                /** @brief Returns the number of entries the current storage can hold. */
+                size_t capacity() const noexcept { return _capacity; }
+
+                /** @brief Returns true while the entries live in the inline storage. */
+                bool isInline() const noexcept { return _data == inlineData(); }
+
+                /**
+                 * @brief Ensures room for at least @p count entries.
+                 * @param count Desired capacity.
+                 */
+                void reserve(size_t count) {
+                        if (count > _capacity) regrow(count);
+                        return;
+                }
+
+                // -- Lookup --
+
+                /**
+                 * @brief Returns the value for @p key, or @p defaultValue if
+                 *        the key is not present.
+                 * @param key The key to look up.
+                 * @param defaultValue Fallback value.
+                 * @return The mapped value or the default.
+                 */
+                V value(const K &key, const V &defaultValue = V{}) const {
+                        ConstIterator it = find(key);
+                        return it != cend() ? it->second : defaultValue;
+                }
+
+                /** @brief Returns true if @p key exists in the map. */
+                bool contains(const K &key) const { return find(key) != cend(); }
+
+                /**
+                 * @brief Finds the entry for @p key.
+                 * @param key The key to search for.
+                 * @return Iterator to the entry, or end() if not found.
+                 */
+                Iterator find(const K &key) {
+                        Iterator it = lowerBound(key);
+                        return (it != end() && !(key < it->first)) ? it : end();
+                }
+
+                /** @brief Const overload of find(). */
+                ConstIterator find(const K &key) const { return const_cast<FlatMap *>(this)->find(key); }
+
+                // -- Modifiers --
+
+                /**
+                 * @brief Inserts or assigns a key-value pair.
+                 *
+                 * Same overwrite semantics as @ref Map::insert.
+                 *
+                 * @param key The key.
+                 * @param val The value.
+                 */
+                void insert(const K &key, const V &val) {
+                        Iterator it = lowerBound(key);
+                        if (it != end() && !(key < it->first)) {
+                                it->second = val;
+                                return;
+                        }
+                        emplaceAt(static_cast<size_t>(it - _data), key, val);
+                        return;
+                }
+
+                /**
+                 * @brief Inserts or assigns a key-value pair (move overload).
+                 * @param key The key.
+                 * @param val The value (moved).
+                 */
+                void insert(const K &key, V &&val) {
+                        Iterator it = lowerBound(key);
+                        if (it != end() && !(key < it->first)) {
+                                it->second = std::move(val);
+                                return;
+                        }
+                        emplaceAt(static_cast<size_t>(it - _data), key, std::move(val));
+                        return;
+                }
+
+                /**
+                 * @brief Inserts a key-value pair only if @p key is absent.
+                 * @param key The key.
+                 * @param val The value.
+                 * @return True if inserted, false if @p key already existed.
+                 */
+                bool insertNew(const K &key, const V &val) {
+                        Iterator it = lowerBound(key);
+                        if (it != end() && !(key < it->first)) return false;
+                        emplaceAt(static_cast<size_t>(it - _data), key, val);
+                        return true;
+                }
+
+                /**
+                 * @brief Removes the entry for @p key.
+                 * @param key The key to remove.
+                 * @return True if an entry was removed, false if the key was not found.
+                 */
+                bool remove(const K &key) {
+                        Iterator it = find(key);
+                        if (it == end()) return false;
+                        remove(it);
+                        return true;
+                }
+
+                /**
+                 * @brief Removes the entry at @p pos.
+                 * @param pos Iterator to the entry to remove.
+                 * @return Iterator to the entry that followed @p pos.
+                 */
+                Iterator remove(Iterator pos) {
+                        std::move(pos + 1, end(), pos);
+                        --_size;
+                        std::destroy_at(_data + _size);
+                        return pos;
+                }
+
+                /** @brief Removes all entries.  Heap storage, if any, is kept. */
+                void clear() noexcept {
+                        std::destroy(_data, _data + _size);
+                        _size = 0;
+                        return;
+                }
+
+                // -- Convenience --
+
+                /** @brief Returns a list of all keys in ascending order. */
+                List<K> keys() const {
+                        List<K> ret;
+                        ret.reserve(_size);
+                        for (const Entry &e : *this) ret.pushToBack(e.first);
+                        return ret;
+                }
+
+                /** @brief Returns a list of all values in key order. */
+                List<V> values() const {
+                        List<V> ret;
+                        ret.reserve(_size);
+                        for (const Entry &e : *this) ret.pushToBack(e.second);
+                        return ret;
+                }
+
+                /**
+                 * @brief Calls @p func for every key-value pair in key order.
+                 * @tparam Func Callable with signature void(const K &, const V &).
+                 * @param func The function to invoke.
+                 */
+                template <typename Func> void forEach(Func &&func) const {
+                        for (const Entry &e : *this) func(e.first, e.second);
+                        return;
+                }
+
+                // -- Comparison --
+
+                /** @brief Returns true if both maps have identical contents. */
+                friend bool operator==(const FlatMap &lhs, const FlatMap &rhs) {
+                        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+                }
+
+                /** @brief Returns true if the maps differ. */
+                friend bool operator!=(const FlatMap &lhs, const FlatMap &rhs) { return !(lhs == rhs); }
+
+        private:
+                alignas(Entry) unsigned char _inline[InlineCapacity * sizeof(Entry)];
+                Entry                       *_data = inlineData();
+                size_t                       _size = 0;
+                size_t                       _capacity = InlineCapacity;
+
+                Entry *inlineData() noexcept { return reinterpret_cast<Entry *>(_inline); }
+                const Entry *inlineData() const noexcept { return reinterpret_cast<const Entry *>(_inline); }
+
+                Iterator lowerBound(const K &key) {
+                        return std::lower_bound(begin(), end(), key,
+                                                [](const Entry &e, const K &k) { return e.first < k; });
+                }
+
+                // Moves the live entries into a block of at least @p count
+                // slots.  Only ever grows.
+                void regrow(size_t count) {
+                        size_t newCap = std::max(count, _capacity * 2);
+                        Entry *fresh = std::allocator<Entry>().allocate(newCap);
+                        std::uninitialized_move(_data, _data + _size, fresh);
+                        std::destroy(_data, _data + _size);
+                        if (!isInline()) std::allocator<Entry>().deallocate(_data, _capacity);
+                        _data = fresh;
+                        _capacity = newCap;
+                        return;
+                }
+
+                template <typename ValT> void emplaceAt(size_t idx, const K &key, ValT &&val) {
+                        if (_size == _capacity) regrow(_size + 1);
+                        Entry *pos = _data + idx;
+                        if (idx == _size) {
+                                std::construct_at(pos, key, std::forward<ValT>(val));
+                        } else {
+                                // Open a hole at idx: move-construct the last
+                                // entry one slot up, shift the rest, then
+                                // assign the new entry into the hole.
+                                Entry *last = _data + _size;
+                                std::construct_at(last, std::move(last[-1]));
+                                std::move_backward(pos, last - 1, last);
+                                pos->first = key;
+                                pos->second = std::forward<ValT>(val);
+                        }
+                        ++_size;
+                        return;
+                }
+
+                void release() noexcept {
+                        std::destroy(_data, _data + _size);
+                        if (!isInline()) std::allocator<Entry>().deallocate(_data, _capacity);
+                        _data = inlineData();
+                        _size = 0;
+                        _capacity = InlineCapacity;
+                        return;
+                }
+
+                // Leaves @p other empty and inline.  Assumes this map is
+                // already empty and inline.
+                void takeFrom(FlatMap &other) noexcept {
+                        if (other.isInline()) {
+                                std::uninitialized_move(other._data, other._data + other._size, _data);
+                                _size = other._size;
+                                other.clear();
+                                return;
+                        }
+                        _data = other._data;
+                        _size = other._size;
+                        _capacity = other._capacity;
+                        other._data = other.inlineData();
+                        other._size = 0;
+                        other._capacity = InlineCapacity;
+                        return;
+                }
+};
+
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -22,6 +22,7 @@
 #include <promeki/audiodesc.h>
 #include <promeki/frame.h>
 #include <promeki/timestamp.h>
+#include <promeki/mediaioallocator.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -76,11 +77,37 @@ PROMEKI_NAMESPACE_BEGIN
  * version; major mismatches are rejected at handshake time, minor
  * mismatches are accepted with a log entry.
  *
- * @par MVP scope
- * The MVP supports one image plane group (one @c ImageDesc in the
- * @c MediaDesc) and one audio track.  Multi-image and multi-audio
- * frames are planned work.  Writes are always-copy — a future
- * extension will add zero-copy via a dedicated @c MemSpace.
+ * @par Zero-copy publishing
+ * With @c FrameBridge::Config::zeroCopy set, @ref allocator returns a
+ * @ref MediaIOAllocator whose @c allocateVideoPayload carves the image
+ * planes directly out of a free ring slot.  Upstream stages render
+ * into shared memory, and @ref writeFrame recognizes a frame built
+ * that way and publishes it in place — only the metadata and audio
+ * block are copied, the image planes never are.  Frames whose planes
+ * live anywhere else take the ordinary copy path, so the mode is
+ * always safe to enable.
+ *
+ * Each slot is reference counted: one count per live producer
+ * Buffer carved from it, and one per sync input that was sent its
+ * TICK and has not acknowledged it yet.  A slot is reused only when
+ * both drop to zero.  In zero-copy mode a sync input's ACK is
+ * collected before the @em next TICK rather than before
+ * @ref writeFrame returns, so the producer fills frame N+1 while the
+ * consumer is still reading frame N; sync inputs still never miss a
+ * frame.  When no slot is free the allocator falls back to ordinary
+ * heap planes, which @ref writeFrame then copies.
+ *
+ * @par Multiple essences
+ * One bridge carries every essence of a frame.  The @c MediaDesc may
+ * list any number of image plane groups, audio tracks and ANC streams
+ * (subtitles ride as ANC, e.g. OP-47 / RDD 8); each gets its own
+ * cache-line-aligned sub-region in every slot, and one TICK publishes
+ * all of them atomically, so consumers never have to re-sync
+ * separately-bridged essences.  Payloads are matched to streams by
+ * position: the frame's N-th video payload fills the N-th image
+ * region, the N-th audio payload the N-th audio track, and the N-th
+ * ANC payload the N-th ANC stream.  Missing payloads publish as
+ * empty.
  *
  * @par Cross-user access
  * Pass a non-default @c Config::accessMode (for example @c 0660)
@@ -100,7 +127,7 @@ class FrameBridge : public ObjectBase {
                 using UPtr = UniquePtr<FrameBridge>;
 
                 /** @brief Wire-protocol major version. Mismatches are rejected. */
-                static constexpr uint32_t WireMajor = 1;
+                static constexpr uint32_t WireMajor = 2;
 
                 /** @brief Wire-protocol minor version. Mismatches are accepted with a log. */
                 static constexpr uint32_t WireMinor = 0;
@@ -108,6 +135,9 @@ class FrameBridge : public ObjectBase {
                 /** @brief Default metadata reserve per slot (64 KiB). */
                 static constexpr size_t DefaultMetadataReserveBytes = 64u * 1024u;
 
+                /** @brief Default serialized ANC reserve per stream per slot (16 KiB). */
+                static constexpr size_t DefaultAncReserveBytes = 16u * 1024u;
+
                 /** @brief Default extra audio capacity as a fraction of nominal. */
                 static constexpr double DefaultAudioHeadroomFraction = 0.20;
 
@@ -125,10 +155,10 @@ class FrameBridge : public ObjectBase {
                  * and the @c ACPT handshake.
                  */
                 struct Config {
-                                /** @brief Video description: frame rate, images, metadata. */
+                                /** @brief Frame description: frame rate, images, audio tracks, ANC streams. */
                                 MediaDesc mediaDesc;
 
-                                /** @brief Audio track description. */
+                                /** @brief Single audio track, used only when @c mediaDesc lists no audio. */
                                 AudioDesc audioDesc;
 
                                 /** @brief Ring depth — number of slots in the shm buffer. */
@@ -137,6 +167,9 @@ class FrameBridge : public ObjectBase {
                                 /** @brief Reserved metadata bytes per slot. */
                                 size_t metadataReserveBytes = DefaultMetadataReserveBytes;
 
+                                /** @brief Reserved serialized ANC bytes per stream per slot. */
+                                size_t ancReserveBytes = DefaultAncReserveBytes;
+
                                 /** @brief Extra audio capacity fraction above worst-case per-frame. */
                                 double audioHeadroomFraction = DefaultAudioHeadroomFraction;
 
@@ -169,6 +202,32 @@ class FrameBridge : public ObjectBase {
                          * no-op when no consumers are attached.
                          */
                                 bool waitForConsumer = true;
+
+                                /**
+                                 * @brief Lets upstream stages allocate image planes inside ring slots.
+                                 *
+                                 * When @c true, @ref allocator vends slot-backed
+                                 * planes and @ref writeFrame publishes frames built
+                                 * from them without copying the image.  See the
+                                 * class-level "Zero-copy publishing" section.
+                                 */
+                                bool zeroCopy = false;
+                };
+
+                /**
+                 * @brief Output-side publishing counters.
+                 *
+                 * Reset by @ref openOutput.  All zero on the input side.
+                 */
+                struct Stats {
+                                /** @brief Frames published with their image planes already in a slot. */
+                                uint64_t framesZeroCopy = 0;
+
+                                /** @brief Frames whose image planes were copied into a slot. */
+                                uint64_t framesCopied = 0;
+
+                                /** @brief Allocator requests that fell back to heap planes (no free slot). */
+                                uint64_t allocatorFallbacks = 0;
                 };
 
                 /**
@@ -269,10 +328,16 @@ class FrameBridge : public ObjectBase {
                 /** @brief Returns the logical name used at @c openOutput / @c openInput. */
                 const String &name() const;
 
-                /** @brief Returns the effective video description. */
+                /**
+                 * @brief Returns the effective frame description.
+                 *
+                 * Its audio list holds every audio track the bridge
+                 * carries, including a track supplied through
+                 * @c FrameBridge::Config::audioDesc.
+                 */
                 const MediaDesc &mediaDesc() const;
 
-                /** @brief Returns the effective audio description. */
+                /** @brief Returns the first audio track's description (invalid when there is none). */
                 const AudioDesc &audioDesc() const;
 
                 /** @brief Returns the number of ring slots. */
@@ -298,24 +363,58 @@ class FrameBridge : public ObjectBase {
                 /**
                  * @brief Publishes a frame to all connected inputs.
                  *
-                 * Serializes the frame's images, audio, and metadata
+                 * Serializes the frame's images, audio, ANC and metadata
                  * into the next ring slot, increments the slot sequence
                  * counter twice (seqlock), and sends a @c TICK to every
                  * connected input.  A no-op (other than processing
                  * accepts and drops) when zero inputs are connected.
                  *
                  * @param frame The frame to publish (must be compatible
-                 *              with the configured @ref mediaDesc and
-                 *              @ref audioDesc).
+                 *              with the configured @ref mediaDesc).
+                 *              Video, audio and ANC payloads are matched
+                 *              to the bridge's streams by position.
+                 * A frame whose image planes came from @ref allocator is
+                 * published in place; any other frame is copied into the
+                 * next free slot.
+                 *
                  * @return @c Error::Ok on success, @c Error::OutOfRange
-                 *         when audio or metadata exceeds slot capacity,
-                 *         or another error.
+                 *         when audio, ANC or metadata exceeds slot capacity,
+                 *         @c Error::Timeout when no slot became free
+                 *         within the sync ACK budget, or another error.
                  */
                 Error writeFrame(const Frame &frame);
 
                 /** @brief Returns the number of currently-connected inputs. */
                 size_t connectionCount() const;
 
+                /**
+                 * @brief Returns the allocator upstream stages should build frames with.
+                 *
+                 * On an output opened with @c FrameBridge::Config::zeroCopy
+                 * this is a slot-backed allocator: @c allocateVideoPayload
+                 * for one of the bridge's image shapes returns planes
+                 * living in the first matching image region of a free ring
+                 * slot, so @ref writeFrame can publish the frame without
+                 * copying it.  Each call leases its own slot; when a frame's
+                 * images end up in different slots, @ref writeFrame
+                 * publishes from the first and copies the others into it.
+                 * Slot-backed Buffers cannot be
+                 * detached (@c Buffer::ensureExclusive reports
+                 * @c Error::NotSupported); treat a published frame as
+                 * read-only.  Other shapes, audio, and requests made while
+                 * every slot is busy fall through to the default
+                 * allocator.
+                 *
+                 * The allocator is thread-safe and may outlive the bridge;
+                 * once the bridge is closed it only hands out heap
+                 * memory.  Returns @ref MediaIOAllocator::defaultAllocator
+                 * when the bridge is not a zero-copy output.
+                 */
+                MediaIOAllocator::Ptr allocator() const;
+
+                /** @brief Returns the output-side publishing counters. */
+                Stats stats() const;
+
                 /**
                  * @brief Accepts pending inputs and prunes disconnected ones.
                  *
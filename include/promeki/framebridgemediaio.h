@@ -33,11 +33,13 @@ PROMEKI_NAMESPACE_BEGIN
  * | @ref MediaConfig::FrameBridgeName                    | String  | —      | Logical bridge name (required). |
  * | @ref MediaConfig::FrameBridgeRingDepth               | int32   | 2      | Ring-buffer depth. |
  * | @ref MediaConfig::FrameBridgeMetadataReserveBytes    | int32   | 65536  | Reserved metadata bytes per slot. |
+ * | @ref MediaConfig::FrameBridgeAncReserveBytes         | int32   | 16384  | Reserved ANC bytes per stream per slot. |
  * | @ref MediaConfig::FrameBridgeAudioHeadroomFraction   | double  | 0.20   | Audio capacity headroom. |
  * | @ref MediaConfig::FrameBridgeAccessMode              | int32   | 0600   | POSIX file mode for shm + socket. |
  * | @ref MediaConfig::FrameBridgeGroupName               | String  | ""     | Group for cross-user access. |
  * | @ref MediaConfig::FrameBridgeSyncMode                | bool    | true   | Input-side sync (ACK every TICK). |
  * | @ref MediaConfig::FrameBridgeWaitForConsumer         | bool    | true   | Output blocks writeFrame until a consumer attaches. |
+ * | @ref MediaConfig::FrameBridgeZeroCopy                | bool    | false  | Output vends image planes inside ring slots. |
  *
  * @par Stats
  * Publishes the output-side instance name as the @c SourceName string
@@ -53,10 +53,22 @@ class EventLoop;
  * closes by default.  Either side's @c Connection: close header forces
  * close after the in-flight response is sent.
  *
+ * Request bodies: body bytes are collected as a list of segments
+ * (sized from @c Content-Length when the client sends one) and joined
+ * at most once when the request completes, so large uploads cost a
+ * linear number of copies.  When the headers handler (see
+ * @ref setHeadersHandler) installs an @ref HttpRequest::BodySink on
+ * the request, body bytes go straight from the socket read buffer to
+ * the sink instead and the request reaches the dispatcher with an
+ * empty body.
+ *
  * Streamed bodies: when the response carries an
  * @ref HttpResponse::bodyStream, the connection drains the device
  * incrementally as the socket becomes writable, falling back to
  * chunked transfer-encoding when the device's length is unknown.
+ * Each chunk is read straight into the buffer that is written to the
+ * socket, and a large in-memory response body is written from the
+ * response's own @ref Buffer rather than copied behind the headers.
  *
  * @note @c HttpConnection is internal infrastructure.  Application
  *       code should use @ref HttpServer; the connection is exposed
@@ -92,6 +104,17 @@ class HttpConnection : public ObjectBase {
                  */
                 using RequestHandler = Function<void(HttpRequest &request, HttpResponse &response)>;
 
+                /**
+                 * @brief Caller-supplied hook run once a request's headers are parsed.
+                 *
+                 * Invoked on the connection's EventLoop thread after
+                 * the method, URL, headers and peer address are set
+                 * and before any body bytes arrive.  Installing an
+                 * @ref HttpRequest::BodySink on @p request here makes
+                 * the connection stream the body into it.
+                 */
+                using HeadersHandler = Function<void(HttpRequest &request)>;
+
                 /**
                  * @brief Constructs a connection wrapping @p socket.
                  *
@@ -135,6 +158,14 @@ class HttpConnection : public ObjectBase {
                  */
                 void setRequestHandler(RequestHandler handler);
 
+                /**
+                 * @brief Installs the hook run when request headers are complete.
+                 *
+                 * @ref HttpServer uses this to let the matched route's
+                 * @ref HttpHandler::prepare opt into streaming the body.
+                 */
+                void setHeadersHandler(HeadersHandler handler);
+
                 /**
                  * @brief Begins reading from the socket.
                  *
@@ -169,7 +200,11 @@ class HttpConnection : public ObjectBase {
                  * @brief Sets the maximum request body size in bytes.
                  *
                  * Connections that exceed the limit yield a 413 reply
-                 * and close.  Use @c -1 to disable the cap.
+                 * and close.  Use @c -1 to disable the cap.  The cap
+                 * covers buffered bodies and bodies streamed into an
+                 * @ref HttpRequest::BodySink alike; a handler can
+                 * override it per request with
+                 * @ref HttpRequest::setMaxBodyBytes.
                  */
                 void setMaxBodyBytes(int64_t bytes) { _maxBodyBytes = bytes; }
 
@@ -183,9 +218,25 @@ class HttpConnection : public ObjectBase {
                  *
                  * Safe to call exactly once per @c %requestReceived
                  * emission; calling more than once raises an error.
+                 *
+                 * @return @c Error::Ok, @c Error::NotOpen when the
+                 *         connection closed while the reply was being
+                 *         prepared, or @c Error::Invalid when no
+                 *         request is waiting for one.
                  */
                 Error postResponse(HttpResponse response);
 
+                /**
+                 * @brief Tells the connection the current request is answered later.
+                 *
+                 * Call from inside the @ref RequestHandler.  No
+                 * response is sent when the handler returns; the idle
+                 * timer stops until @ref postResponse delivers the
+                 * reply.  Requests pipelined behind the deferred one
+                 * are held unparsed and answered after it, in order.
+                 */
+                void deferResponse();
+
                 /** @brief Emitted on the loop thread when a request finishes parsing. @signal */
                 PROMEKI_SIGNAL(requestReceived, HttpRequest);
 
@@ -222,9 +273,16 @@ class HttpConnection : public ObjectBase {
                 State      _state = State::Reading;
 
                 RequestHandler _handler;
-                Buffer         _readBuf;    ///< Scratch read landing zone.
-                Buffer         _writeQueue; ///< Pending bytes to send.
-                size_t         _writeOffset = 0;
+                HeadersHandler _headersHandler;
+                Buffer         _readBuf;           ///< Scratch read landing zone.
+                Buffer         _parkedInput;       ///< Pipelined bytes waiting on a response.
+                bool           _parsing = false;   ///< Inside llhttp_execute.
+                Buffer::List   _writeQueue;        ///< Pending segments to send, in order.
+                size_t         _writeIndex = 0;    ///< Segment currently being sent.
+                size_t         _writeOffset = 0;   ///< Bytes of that segment already sent.
+                Buffer::List   _bodySegments;      ///< Request body received so far.
+                int64_t        _bodyExpected = -1; ///< Declared Content-Length, or -1.
+                bool           _responseDeferred = false;
 
                 HttpRequest      _pendingRequest;
                 HttpRequest      _lastRequest; ///< Captured for responseSent signal.
@@ -282,8 +340,29 @@ class HttpConnection : public ObjectBase {
                 void detachStreamReadyRead();
                 void onStreamReadyRead();
 
+                // Pipelining: parsing pauses after each request until
+                // its response is written.  Bytes that arrive (or
+                // were already read) meanwhile are parked in arrival
+                // order and fed to the parser once it resumes.
+                void parseInput(const char *data, size_t len);
+                void parkInput(const char *data, size_t len);
+                void resumeParsing();
+
+                // Re-registers the socket with the loop: IoWrite when
+                // @p wantWrite, IoRead unless the parked input is full.
+                void watchSocket(bool wantWrite);
+
                 void flushPendingHeaderPair();
                 void resetForNextRequest();
+                void clearWriteQueue();
+                void restartIdleTimer();
+                void queueBytes(const void *data, size_t len);
+                void appendBody(const char *data, size_t len);
+                void finishBody();
+
+                // Body size cap for the pending request: its own
+                // override, else _maxBodyBytes.
+                int64_t bodyLimit() const;
 
                 // llhttp callbacks (defined in cpp; bridge via parser->data).
                 static int cbMessageBegin(void *parser);
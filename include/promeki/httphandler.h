@@ -38,6 +38,16 @@ using HttpHandlerFunc = Function<void(const HttpRequest &request, HttpResponse &
 /** @brief Convenience list of @ref HttpHandlerFunc values. */
 using HttpHandlerFuncList = ::promeki::List<HttpHandlerFunc>;
 
+/**
+ * @brief Lambda-style hook run when a request's headers have arrived.
+ * @ingroup network
+ *
+ * See @ref HttpHandler::prepare.  Typically installs an
+ * @ref HttpRequest::BodySink so the body streams somewhere instead of
+ * being buffered in memory.
+ */
+using HttpPrepareFunc = Function<void(HttpRequest &request)>;
+
 /**
  * @brief Middleware that wraps the next handler in the chain.
  * @ingroup network
@@ -108,6 +118,25 @@ class HttpHandler {
                  * @param response The response object to populate.
                  */
                 virtual void serve(const HttpRequest &request, HttpResponse &response) = 0;
+
+                /**
+                 * @brief Called once the request headers are parsed, before the body arrives.
+                 *
+                 * @ref HttpServer routes the request as soon as its
+                 * headers are complete and calls this on the matched
+                 * handler, so a handler expecting a large upload can
+                 * install an @ref HttpRequest::BodySink on @p request
+                 * and receive the body as it comes off the socket.
+                 * Middleware has not run yet at this point, so the
+                 * sink sees the body of requests middleware would
+                 * reject; the server's body size cap still applies
+                 * unless raised here with
+                 * @ref HttpRequest::setMaxBodyBytes.  The default does
+                 * nothing and the body is buffered.
+                 *
+                 * @param request The request, with method, URL, headers and path parameters set.
+                 */
+                virtual void prepare(HttpRequest &request) { (void)request; }
 };
 
 /**
@@ -128,11 +157,24 @@ class HttpFunctionHandler : public HttpHandler {
                  */
                 explicit HttpFunctionHandler(HttpHandlerFunc func) : _func(std::move(func)) {}
 
+                /**
+                 * @brief Wraps @p func plus a @p prepare hook run when the headers arrive.
+                 * @param prepare Invoked from @ref HttpHandler::prepare.
+                 * @param func    The function-style handler to invoke.
+                 */
+                HttpFunctionHandler(HttpPrepareFunc prepare, HttpHandlerFunc func)
+                    : _prepare(std::move(prepare)), _func(std::move(func)) {}
+
                 void serve(const HttpRequest &request, HttpResponse &response) override {
                         if (_func) _func(request, response);
                 }
 
+                void prepare(HttpRequest &request) override {
+                        if (_prepare) _prepare(request);
+                }
+
         private:
+                HttpPrepareFunc _prepare;
                 HttpHandlerFunc _func;
 };
 
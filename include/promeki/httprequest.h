@@ -22,6 +22,7 @@
 #include <promeki/httpheaders.h>
 #include <promeki/json.h>
 #include <promeki/function.h>
+#include <promeki/iodevice.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -190,7 +191,14 @@ class HttpRequest {
                  * the request; the failing error code is reported on
                  * the @ref Future returned from @ref HttpClient::send.
                  *
-                 * The sink is not consulted on the server side.
+                 * On the server side the same callback receives the
+                 * @em request body: a handler's @ref HttpHandler::prepare
+                 * installs it once the headers are parsed, and
+                 * @ref HttpConnection then hands each chunk straight from
+                 * its read buffer to the sink, leaving @ref body empty.
+                 * An error there answers the request with 500 and closes
+                 * the connection.  The connection's body size cap still
+                 * applies to a streamed body; see @ref setMaxBodyBytes.
                  */
                 using BodySink = ::promeki::Function<Error(const void *data, size_t len)>;
 
@@ -216,7 +224,7 @@ class HttpRequest {
                 const BodySink &bodySink() const { return _bodySink; }
 
                 /**
-                 * @brief Installs a body sink for client-side streaming.
+                 * @brief Installs a body sink for streaming the body.
                  *
                  * See @ref BodySink for the contract.  Pass an empty
                  * @ref Function to clear (the default buffered path
@@ -224,6 +232,42 @@ class HttpRequest {
                  */
                 void setBodySink(BodySink sink) { _bodySink = std::move(sink); }
 
+                /**
+                 * @brief Returns a body sink that writes every chunk to @p device.
+                 *
+                 * Short writes are retried until the chunk is fully
+                 * written; a write that makes no progress fails the
+                 * sink with @c Error::IOError.  @p device must be open
+                 * for writing and is kept alive by the sink.
+                 */
+                static BodySink deviceSink(IODevice::Shared device);
+
+                /** @brief @ref maxBodyBytes value meaning "use the connection's cap". */
+                static constexpr int64_t ConnectionMaxBodyBytes = -2;
+
+                /**
+                 * @brief Returns the body size cap set for this request.
+                 *
+                 * @ref ConnectionMaxBodyBytes (the default) when the
+                 * connection's cap applies.
+                 */
+                int64_t maxBodyBytes() const { return _maxBodyBytes; }
+
+                /**
+                 * @brief Overrides the connection's body size cap for this request.
+                 *
+                 * Server side only.  Set from @ref HttpHandler::prepare
+                 * by a handler that expects a larger (or wants a
+                 * smaller) upload than the server-wide
+                 * @ref HttpServer::setMaxBodyBytes allows.  Applies to
+                 * buffered and streamed bodies alike; @c -1 lifts the
+                 * cap, so only do that for a sink that bounds the size
+                 * itself.  Middleware has not run when @c prepare is
+                 * called, so the raised cap applies to unauthenticated
+                 * clients too.
+                 */
+                void setMaxBodyBytes(int64_t bytes) { _maxBodyBytes = bytes; }
+
                 /** @brief Returns the installed progress callback, if any. */
                 const ProgressCallback &progressCallback() const { return _progressCallback; }
 
@@ -290,6 +334,7 @@ class HttpRequest {
                 String                  _peerAddress;
                 BodySink                _bodySink;
                 ProgressCallback        _progressCallback;
+                int64_t                 _maxBodyBytes = ConnectionMaxBodyBytes;
 };
 
 PROMEKI_NAMESPACE_END
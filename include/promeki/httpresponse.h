@@ -315,6 +315,34 @@ class HttpResponse {
                 /** @brief Returns the installed upgrade hook (may be empty). */
                 const UpgradeHook &upgradeHook() const { return _upgradeHook; }
 
+                // ============================================================
+                // Worker offload
+                // ============================================================
+
+                /**
+                 * @brief Work that finishes the response away from the I/O thread.
+                 *
+                 * A handler that would block its @ref HttpServer reactor
+                 * (a slow query, a large encode) installs this instead
+                 * of filling in the response.  When the handler returns,
+                 * the server runs the task on its worker pool (see
+                 * @ref HttpServer::setWorkerPool) with a copy of this
+                 * response, and sends whatever the task leaves in it.
+                 * Other connections keep being served meanwhile.
+                 * Without a worker pool the task runs inline.
+                 *
+                 * The task runs on another thread after the handler has
+                 * returned: capture what it needs from the request by
+                 * value.
+                 */
+                using OffloadTask = Function<void(HttpResponse &response)>;
+
+                /** @brief Installs the offload task (see @ref OffloadTask). */
+                void setOffloadTask(OffloadTask task) { _offloadTask = std::move(task); }
+
+                /** @brief Returns the installed offload task (may be empty). */
+                const OffloadTask &offloadTask() const { return _offloadTask; }
+
         private:
                 HttpStatus       _status = HttpStatus::Ok;
                 String           _customReason;
@@ -324,6 +352,7 @@ class HttpResponse {
                 int64_t          _bodyStreamLength = -1;
                 String           _httpVersion = DefaultHttpVersion;
                 UpgradeHook      _upgradeHook;
+                OffloadTask      _offloadTask;
 };
 
 PROMEKI_NAMESPACE_END
@@ -12,6 +12,7 @@
 #if PROMEKI_ENABLE_HTTP
 #include <promeki/namespace.h>
 #include <promeki/string.h>
+#include <promeki/stringlist.h>
 #include <promeki/list.h>
 #include <promeki/hashmap.h>
 #include <promeki/httpmethod.h>
@@ -46,6 +47,12 @@ PROMEKI_NAMESPACE_BEGIN
  * inside @ref dispatch); handlers read them via
  * @ref HttpRequest::pathParam.
  *
+ * @par Streaming request bodies
+ * @ref prepare matches a request whose headers have arrived but whose
+ * body has not and forwards it to the matched handler's
+ * @ref HttpHandler::prepare, which may install a body sink.
+ * @ref HttpServer calls it for every request.
+ *
  * @par Middleware
  * Middleware registered via @ref use runs before the matched handler
  * in registration order.  Each middleware receives a @c next callable
@@ -116,7 +123,9 @@ class HttpRouter {
                  * @brief Adds a middleware to the chain.
                  *
                  * Middleware runs before any matched route handler, in
-                 * the order it was registered.
+                 * the order it was registered, from @ref dispatch.  It
+                 * runs after @ref prepare and so after the handler's
+                 * @ref HttpHandler::prepare hook.
                  */
                 void use(HttpMiddleware middleware);
 
@@ -147,6 +156,16 @@ class HttpRouter {
                  */
                 void dispatch(HttpRequest &request, HttpResponse &response) const;
 
+                /**
+                 * @brief Routes @p request ahead of its body and runs the handler's prepare hook.
+                 *
+                 * Sets the path parameters and calls
+                 * @ref HttpHandler::prepare on the best-matching
+                 * route.  Does nothing when no route matches.
+                 * Middleware is not consulted.
+                 */
+                void prepare(HttpRequest &request) const;
+
                 /** @brief Number of routes registered. */
                 int routeCount() const;
 
@@ -188,6 +207,9 @@ class HttpRouter {
                                             HashMap<String, String> &paramsOut);
                 static int     patternScore(const Pattern &pattern);
 
+                const Route *findRoute(const HttpRequest &request, HashMap<String, String> &paramsOut,
+                                       StringList *allowOut, bool *pathMatchedOut) const;
+
                 void runChain(HttpRequest &request, HttpResponse &response, HttpHandlerFunc terminal) const;
 
                 static void defaultNotFound(const HttpRequest &request, HttpResponse &response);
@@ -17,7 +17,8 @@
 #include <promeki/error.h>
 #include <promeki/socketaddress.h>
 #include <promeki/list.h>
-#include <promeki/uniqueptr.h>
+#include <promeki/mutex.h>
+#include <promeki/waitcondition.h>
 #include <promeki/httprouter.h>
 #include <promeki/httprequest.h>
 #include <promeki/httpresponse.h>
@@ -32,8 +33,8 @@
 
 PROMEKI_NAMESPACE_BEGIN
 
-class TcpServer;
 class EventLoop;
+class ThreadPool;
 class WebSocket;
 
 /**
@@ -43,16 +44,38 @@ class WebSocket;
  * @ref HttpServer is the public face of the HTTP stack: it owns a
  * @ref TcpServer that listens for connections, an @ref HttpRouter
  * that maps patterns to handlers, and the live @ref HttpConnection
- * instances that flow through it.  Everything happens on a single
- * @ref EventLoop — the one that's current at construction time, or
- * @ref Application::mainEventLoop when none is current — so handlers
- * run on a known thread without needing their own synchronization.
+ * instances that flow through it.  By default everything happens on a
+ * single @ref EventLoop — the one that's current at construction
+ * time, or @ref Application::mainEventLoop when none is current — so
+ * handlers run on a known thread without needing their own
+ * synchronization.
  *
  * The model intentionally mirrors Go's @c net/http: register routes
  * (or middleware) on the server, then call @ref listen.  Handlers
  * receive a request and write into a response object that the
  * connection serializes to the wire when the handler returns.
  *
+ * @par Reactors
+ * @ref setReactorCount spreads the work over N reactor threads
+ * instead.  Each reactor is a @ref Thread with its own
+ * @ref EventLoop and its own listening socket bound to the same port
+ * with @c SO_REUSEPORT, so the kernel balances new connections across
+ * them; a connection stays on the reactor that accepted it for its
+ * whole life.  Parsing, routing and response writing for different
+ * connections then run in parallel, and a slow handler only holds up
+ * the clients on its own reactor.  Handlers are called concurrently
+ * from every reactor: the route table must be fully configured before
+ * @ref listen, and handlers must be safe to run in parallel.  The
+ * server-level signals are emitted on the reactor thread; slots
+ * connected with an @ref ObjectBase context are delivered on that
+ * object's loop as usual.
+ *
+ * @par Offloading handlers
+ * A handler that would block a reactor can hand the rest of its work
+ * to the worker pool set with @ref setWorkerPool by installing an
+ * @ref HttpResponse::OffloadTask.  The connection waits for the
+ * task's response while its reactor keeps serving everyone else.
+ *
  * @par Thread Safety
  * Inherits @ref ObjectBase &mdash; thread-affine.  Construction captures
  * @ref EventLoop::current as the *owning loop*.  If the server is
@@ -114,7 +137,13 @@ class HttpServer : public ObjectBase {
                  */
                 Error listen(uint16_t port, int backlog = 50);
 
-                /** @brief Stops listening and closes all live connections. */
+                /**
+                 * @brief Stops listening and closes all live connections.
+                 *
+                 * Waits for offloaded work still running on the worker
+                 * pool and stops the reactor threads.  Call from the
+                 * thread that owns the server, never from a handler.
+                 */
                 void close();
 
                 /** @brief True between successful @ref listen and @ref close. */
@@ -142,7 +171,17 @@ class HttpServer : public ObjectBase {
                 /** @brief Convenience forwarding to @ref HttpRouter::any. */
                 void any(const String &pattern, HttpHandlerFunc handler);
 
-                /** @brief Convenience forwarding to @ref HttpRouter::use. */
+                /**
+                 * @brief Convenience forwarding to @ref HttpRouter::use.
+                 *
+                 * Middleware runs once the whole request, body
+                 * included, has arrived.  The matched handler's
+                 * @ref HttpHandler::prepare runs earlier, when the
+                 * headers arrive, so a body sink it installs receives
+                 * the body before any middleware (an auth check, say)
+                 * has seen the request.  The server's body size cap
+                 * still bounds that body.
+                 */
                 void use(HttpMiddleware middleware);
 
                 /**
@@ -238,9 +277,42 @@ class HttpServer : public ObjectBase {
                 /** @brief Sets the per-connection idle timeout. */
                 void setIdleTimeoutMs(unsigned int ms) { _idleTimeoutMs = ms; }
 
-                /** @brief Sets the upper bound on a single request body. */
+                /**
+                 * @brief Sets the upper bound on a single request body.
+                 *
+                 * Applies to streamed bodies as well as buffered ones
+                 * unless the matched handler overrides it from
+                 * @ref HttpHandler::prepare with
+                 * @ref HttpRequest::setMaxBodyBytes.
+                 */
                 void setMaxBodyBytes(int64_t bytes) { _maxBodyBytes = bytes; }
 
+                /**
+                 * @brief Sets the number of reactor threads used by the next @ref listen.
+                 *
+                 * @c 0 (the default) runs the server on its owning
+                 * @ref EventLoop.  Any other value starts that many
+                 * reactor threads, each accepting on its own
+                 * @c SO_REUSEPORT socket (see the class description).
+                 * @ref listen fails with @c Error::NotSupported where
+                 * the platform lacks @c SO_REUSEPORT.
+                 */
+                void setReactorCount(unsigned int count) { _reactorCount = count; }
+
+                /** @brief Returns the configured reactor thread count. */
+                unsigned int reactorCount() const { return _reactorCount; }
+
+                /**
+                 * @brief Sets the pool that runs @ref HttpResponse::OffloadTask work.
+                 *
+                 * Not owned; it must outlive the server.  With no pool,
+                 * offload tasks run inline on the connection's loop.
+                 */
+                void setWorkerPool(ThreadPool *pool) { _workerPool = pool; }
+
+                /** @brief Returns the worker pool, or nullptr. */
+                ThreadPool *workerPool() const { return _workerPool; }
+
                 /**
                  * @brief Returns the number of currently live connections.
                  *
@@ -289,19 +361,34 @@ class HttpServer : public ObjectBase {
                 PROMEKI_SIGNAL(errorOccurred, Error);
 
         private:
-                void onNewConnection();
-                void dispatchRequest(HttpRequest &request, HttpResponse &response);
-                void reapClosedConnection(HttpConnection *conn);
-
-                EventLoop           *_loop = nullptr;
-                UniquePtr<TcpServer> _tcpServer;
-                int                  _acceptHandle = -1;
-                HttpRouter           _router;
-                HttpConnection::List _connections;
-
-                unsigned int    _idleTimeoutMs = HttpConnection::DefaultIdleTimeoutMs;
-                int64_t         _maxBodyBytes = HttpConnection::DefaultMaxBodyBytes;
-                SslContext _sslContext;
+                struct Reactor;
+                using ReactorList = ::promeki::List<Reactor *>;
+
+                Error startReactor(Reactor *reactor, const SocketAddress &address, int backlog);
+                void  stopReactor(Reactor *reactor);
+                Error runOnReactor(Reactor *reactor, Function<Error()> func);
+                void  onNewConnection(Reactor *reactor);
+                void  dispatchRequest(HttpConnection *conn, HttpRequest &request, HttpResponse &response);
+                void  reapClosedConnection(Reactor *reactor, HttpConnection *conn);
+                void  finishOffload();
+
+                EventLoop    *_loop = nullptr;
+                ReactorList   _reactors;
+                bool          _listening = false;
+                SocketAddress _address;
+                HttpRouter    _router;
+
+                unsigned int _idleTimeoutMs = HttpConnection::DefaultIdleTimeoutMs;
+                int64_t      _maxBodyBytes = HttpConnection::DefaultMaxBodyBytes;
+                SslContext   _sslContext;
+                unsigned int _reactorCount = 0;
+                ThreadPool  *_workerPool = nullptr;
+
+                // Offload tasks still running on the worker pool;
+                // close() waits for them to post their results.
+                Mutex         _offloadMutex;
+                WaitCondition _offloadIdle;
+                int           _offloadsInFlight = 0;
 
                 // Helpers for the reflection adapters; non-template
                 // because the per-key plumbing doesn't depend on the
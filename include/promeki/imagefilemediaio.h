@@ -11,13 +11,16 @@
 #include <promeki/config.h>
 #if PROMEKI_ENABLE_PROAV
 #include <promeki/audiodesc.h>
+#include <promeki/atomic.h>
 #include <promeki/audiofile.h>
 #include <promeki/dedicatedthreadmediaio.h>
 #include <promeki/enum.h>
 #include <promeki/filepath.h>
 #include <promeki/framenumber.h>
 #include <promeki/framerate.h>
+#include <promeki/future.h>
 #include <promeki/imagefile.h>
+#include <promeki/list.h>
 #include <promeki/mediaconfig.h>
 #include <promeki/mediadesc.h>
 #include <promeki/mediaiofactory.h>
@@ -25,6 +28,7 @@
 #include <promeki/namespace.h>
 #include <promeki/numname.h>
 #include <promeki/pixelformat.h>
+#include <promeki/sharedptr.h>
 #include <promeki/size2d.h>
 #include <promeki/string.h>
 #include <promeki/stringlist.h>
@@ -78,6 +82,26 @@ class ImageFileIO;
  *   call from the mask, starting at the configured head (default 1).
  * - Step, reverse playback and @c seekToFrame() all work as expected.
  *
+ * @par Parallel sequence I/O
+ *
+ * Sequence readers keep @ref MediaConfig::ImageSeqReadAhead frames
+ * loading at once on a thread pool shared by every instance: file
+ * open, the bulk (direct I/O) read and the format decode all run off
+ * the worker thread.  Loads are issued along the current step
+ * direction and handed out strictly in sequence order, so the
+ * source's read cache sees the same frames it would from a serial
+ * load.  A read that misses the window (after a seek, a rate change
+ * or a direction flip) cancels the loads that have not started yet,
+ * loads the requested frame directly and re-aims the window from
+ * there.  A hold (step 0) re-vends the last frame without reloading.
+ *
+ * Sequence writers likewise keep @ref MediaConfig::ImageSeqWriteBehind
+ * saves in flight.  Filenames are assigned at write time, so the
+ * output is identical to a serial run; a write blocks only when the
+ * window is full, and close waits for every outstanding save.  A
+ * failed save is returned by the next write (or by close).  Sidecar
+ * audio is still read and written in order on the worker thread.
+ *
  * The format of each individual image in the sequence is taken from
  * the mask's suffix extension (e.g. @c ".dpx" maps to
  * @c ImageFile::DPX).
@@ -104,7 +128,9 @@ class ImageFileIO;
  * @par Threading
  * Runs on a per-instance dedicated worker thread inherited from
  * @ref DedicatedThreadMediaIO so blocking image-file load/save
- * syscalls cannot starve the shared pool.
+ * syscalls cannot starve the shared pool.  Sequence read-ahead and
+ * write-behind tasks run on a separate pool and capture only copies
+ * of the state they need, so they never touch the instance.
  */
 class ImageFileMediaIO : public DedicatedThreadMediaIO {
                 PROMEKI_OBJECT(ImageFileMediaIO, DedicatedThreadMediaIO)
@@ -148,6 +174,33 @@ class ImageFileMediaIO : public DedicatedThreadMediaIO {
 
                 Error writeImgSeqSidecar();
 
+                // Outcome of loading one sequence file.
+                struct SeqLoad {
+                                Frame frame;
+                                Error err;
+                };
+
+                // Set to abandon a queued load before it starts.
+                using SeqCancel = SharedPtr<Atomic<bool>, false>;
+
+                // One read-ahead slot: a load of sequence index @c index.
+                struct SeqPrefetch {
+                                int64_t         index = 0;
+                                SeqCancel       cancel;
+                                Future<SeqLoad> result;
+                };
+
+                static SeqLoad loadSeqFile(int imageFileID, const String &filename, const Frame &hint,
+                                           const MediaConfig &config);
+                static Error   saveSeqFile(int imageFileID, const String &filename, const Frame &frame,
+                                           const MediaConfig &config);
+
+                String seqFilename(int64_t index) const;
+                Error  takeSeqFrame(int64_t index, Frame &frame);
+                void   primeReadAhead(int step, int64_t length);
+                void   cancelReadAhead();
+                Error  drainWrites(size_t keep);
+
                 // Common state
                 String      _filename;
                 int         _imageFileID = ImageFile::Invalid;
@@ -177,6 +230,17 @@ class ImageFileMediaIO : public DedicatedThreadMediaIO {
                 Metadata    _seqMetadata;
                 Size2Du32   _seqSize;
                 PixelFormat _seqPixelFormat;
+                Frame       _seqHint;
+
+                // Sequence read-ahead / write-behind state
+                int                 _seqReadAhead = 0;
+                int                 _seqWriteBehind = 0;
+                List<SeqPrefetch>   _seqPrefetch;
+                int64_t             _seqHeldIndex = -1;
+                Frame               _seqHeld;
+                int                 _seqLastStep = 1;
+                List<Future<Error>> _seqSaves;
+                Error               _seqSaveError;
 
                 // Sidecar audio state (sequence mode only)
                 AudioFile _sidecarAudio;
@@ -34,6 +34,17 @@ PROMEKI_NAMESPACE_BEGIN
  *
  * Default subsampling is 4:2:2 for RFC 2435 RTP compatibility.
  *
+ * @par Slice-parallel encode
+ * With @ref MediaConfig::JpegThreads above 1 the frame is cut into
+ * horizontal stripes of whole MCU rows.  The calling thread encodes the
+ * first stripe and a process-wide worker pool encodes the rest, each
+ * with its own libjpeg-turbo compressor.  The stripes are then stitched
+ * into one baseline JFIF: a DRI segment makes every stripe one restart
+ * interval, and RST0..RST7 markers separate the entropy-coded segments.
+ * Restart markers reset the DC predictors, so the image decodes to the
+ * same pixels as a serial encode.  RFC 2435 packetization carries the
+ * restart interval in its restart marker header.
+ *
  * Registered against @ref VideoCodec::JPEG.  Every emitted payload is
  * flagged @ref MediaPayload::Keyframe because every JPEG bitstream is
  * independently decodable.
@@ -46,6 +57,7 @@ PROMEKI_NAMESPACE_BEGIN
  * | @ref MediaConfig::JpegSubsampling   | Enum @ref ChromaSubsampling | YUV422  | Chroma subsampling for RGB encode paths. |
  * | @ref MediaConfig::OutputPixelFormat | PixelFormat                 | Invalid | Optional override of the encoder's reported @c outputPixelFormat. |
  * | @ref MediaConfig::Capacity          | int                         | 8       | Output FIFO depth before a one-shot warning is logged. |
+ * | @ref MediaConfig::JpegThreads       | int                         | 1       | Stripes encoded in parallel per frame (0 = one per CPU). |
  *
  * @par Thread Safety
  * Conditionally thread-safe — same contract as @ref VideoEncoder.
@@ -83,6 +95,9 @@ class JpegVideoEncoder : public VideoEncoder {
                 /** @brief Returns the chroma subsampling mode. */
                 Subsampling subsampling() const { return _subsampling; }
 
+                /** @brief Returns the resolved @ref MediaConfig::JpegThreads stripe count. */
+                int threadCount() const { return _threads; }
+
         private:
                 struct Impl; ///< pImpl shielding consumers from @c \<jpeglib.h\>.
                 using ImplPtr = UniquePtr<Impl>;
@@ -92,6 +107,7 @@ class JpegVideoEncoder : public VideoEncoder {
                 Subsampling   _subsampling = Subsampling422;
                 PixelFormat   _outputPd;
                 int           _capacity = 8;
+                int           _threads = 1;
                 Deque<Frame>  _queue;
                 bool          _capacityWarned = false;
 };
@@ -110,6 +126,21 @@ class JpegVideoEncoder : public VideoEncoder {
  * @ref MediaConfig::OutputPixelFormat; when unset, the first declared
  * decode target for the input JPEG sub-format is used.
  *
+ * @par Slice-parallel decode
+ * With @ref MediaConfig::JpegThreads above 1, a bitstream whose restart
+ * interval spans whole MCU rows (as the striped @ref JpegVideoEncoder
+ * emits) is split at its RSTn markers into stripes that decode
+ * concurrently into one output payload.  Bitstreams without such
+ * restart markers decode serially.
+ *
+ * @par Config keys
+ *
+ * | Key | Type | Default | Description |
+ * |-----|------|---------|-------------|
+ * | @ref MediaConfig::OutputPixelFormat | PixelFormat | Invalid | Uncompressed output format (first decode target when unset). |
+ * | @ref MediaConfig::Capacity          | int         | 8       | Output FIFO depth before a one-shot warning is logged. |
+ * | @ref MediaConfig::JpegThreads       | int         | 1       | Stripes decoded in parallel per frame (0 = one per CPU). |
+ *
  * Registered against @ref VideoCodec::JPEG.
  *
  * @par Thread Safety
@@ -133,6 +164,9 @@ class JpegVideoDecoder : public VideoDecoder {
                 Error flush() override;
                 Error reset() override;
 
+                /** @brief Returns the resolved @ref MediaConfig::JpegThreads stripe count. */
+                int threadCount() const { return _threads; }
+
         private:
                 struct Impl; ///< pImpl shielding consumers from @c \<jpeglib.h\>.
                 using ImplPtr = UniquePtr<Impl>;
@@ -140,6 +174,7 @@ class JpegVideoDecoder : public VideoDecoder {
 
                 PixelFormat  _outputPd;
                 int          _capacity = 8;
+                int          _threads = 1;
                 Deque<Frame> _queue;
                 bool         _capacityWarned = false;
 };
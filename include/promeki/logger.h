@@ -10,6 +10,8 @@
 
 #include <promeki/config.h>
 #if PROMEKI_ENABLE_CORE
+#include <memory>
+#include <type_traits>
 #include <variant>
 #include <functional>
 #include <promeki/basicthread.h>
@@ -54,11 +56,32 @@ static consteval const char *sourceFileName(const char *path) {
                         &_promeki_debug_enabled, PROMEKI_STRINGIFY(name), PROMEKI_SOURCE_FILE, __LINE__);       \
         }
 
+/**
+ * @def PROMEKI_LOG_MIN_LEVEL
+ * @brief Compile-time floor for the logging macros.
+ *
+ * Macro call sites whose level is below this value (other than
+ * @c Force) compile to nothing — the condition folds to a constant
+ * @c false, so neither the arguments nor the runtime level check are
+ * evaluated.  Defaults to 0, which keeps every level available and
+ * leaves filtering to @ref Logger::setLogLevel.
+ */
+#ifndef PROMEKI_LOG_MIN_LEVEL
+#define PROMEKI_LOG_MIN_LEVEL 0
+#endif
+
+// Never called; gives the deferred macro path the same printf
+// argument checking that String::sprintf provides on the eager path.
+PROMEKI_PRINTF_FUNC(1, 2) inline void promekiLogFormatCheck(const char *, ...) {}
+
 #define promekiLogImpl(_plevel, format, ...)                                                                           \
         do {                                                                                                           \
-                if (!(_plevel) || (_plevel) >= Logger::defaultLogger().level())                                        \
-                        Logger::defaultLogger().log(_plevel, PROMEKI_SOURCE_FILE, __LINE__,                            \
-                                                    String::sprintf(format, ##__VA_ARGS__));                           \
+                if ((!(_plevel) || (_plevel) >= PROMEKI_LOG_MIN_LEVEL) &&                                              \
+                    (!(_plevel) || (_plevel) >= Logger::defaultLogger().level())) {                                    \
+                        if (false) promekiLogFormatCheck(format, ##__VA_ARGS__);                                       \
+                        Logger::defaultLogger().logFormatted<Logger::formatInfo("" format)>(                           \
+                                _plevel, PROMEKI_SOURCE_FILE, __LINE__, "" format, ##__VA_ARGS__);                     \
+                }                                                                                                      \
         } while (0)
 #define promekiLog(level, format, ...) promekiLogImpl(level, format, ##__VA_ARGS__)
 #define promekiLogSync() Logger::defaultLogger().sync()
@@ -70,9 +93,10 @@ static consteval const char *sourceFileName(const char *path) {
 
 #ifdef PROMEKI_DEBUG_ENABLE
 #define promekiDebug(format, ...)                                                                                      \
-        if (_promeki_debug_enabled) {                                                                                  \
-                Logger::defaultLogger().log(Logger::LogLevel::Debug, PROMEKI_SOURCE_FILE, __LINE__,                    \
-                                            String::sprintf(format, ##__VA_ARGS__));                                   \
+        if (Logger::LogLevel::Debug >= PROMEKI_LOG_MIN_LEVEL && _promeki_debug_enabled) {                              \
+                if (false) promekiLogFormatCheck(format, ##__VA_ARGS__);                                               \
+                Logger::defaultLogger().logFormatted<Logger::formatInfo("" format)>(                                   \
+                        Logger::LogLevel::Debug, PROMEKI_SOURCE_FILE, __LINE__, "" format, ##__VA_ARGS__);             \
         }
 #else
 #define promekiDebug(format, ...)
@@ -149,6 +173,30 @@ bool promekiRegisterDebug(bool *enabler, const char *name, const char *file, int
  * may all be called concurrently from any thread.  The asynchronous
  * design means log calls do not block on I/O.
  *
+ * @par Deferred formatting
+ * The logging macros do not format on the calling thread.  Each
+ * thread that logs gets its own wait-free single-producer ring; a
+ * call site whose arguments are all scalars, pointers or C strings
+ * writes a small binary record into it — the format pointer, the raw
+ * argument values (C strings are copied), and a steady-clock stamp —
+ * and returns.  The worker thread merges the per-thread rings by
+ * stamp and runs the printf formatting there, so a storm of warnings
+ * from many threads never serializes on the command queue lock.  The
+ * worker is woken through the command queue only when it is idle.
+ *
+ * Calls fall back to formatting on the caller (the pre-existing
+ * path) when an argument cannot be captured by value, when the format
+ * uses a conversion that cannot be replayed later (@c %%n, @c %%m,
+ * positional arguments, or a precision on @c %%s that may cut a
+ * non-terminated buffer), or when the thread's ring is full.  Either
+ * way the message is delivered; per-thread order, and the order
+ * against @ref sync and the configuration commands, are preserved.
+ * @ref setDeferredFormatting turns the staging path off entirely.
+ *
+ * Level filtering happens before any of this: the macros check the
+ * runtime level first and, with @ref PROMEKI_LOG_MIN_LEVEL, can remove
+ * lower levels at compile time.
+ *
  * @par Example
  * @code
  * // Use convenience macros (most common)
@@ -225,6 +273,99 @@ class Logger {
                 /** @brief Default size of the in-memory history ring used for replay. */
                 static constexpr size_t DefaultHistorySize = 1024;
 
+                /** @brief Size in bytes of each thread's deferred-formatting ring. */
+                static constexpr size_t StagingRingBytes = 64 * 1024;
+
+                /**
+                 * @brief Compile-time summary of a printf format string.
+                 *
+                 * Produced by @ref formatInfo and passed to
+                 * @ref logFormatted as a template argument.
+                 */
+                struct FormatInfo {
+                                bool     deferrable = true; ///< Format can be replayed on the worker.
+                                uint64_t stringArgs = 0;    ///< Bit @c n set when argument @c n feeds a @c %%s.
+
+                                /** @brief Returns true when argument @p n feeds a @c %%s. */
+                                constexpr bool isString(size_t n) const {
+                                        return n < 64 && ((stringArgs >> n) & 1) != 0;
+                                }
+                };
+
+                /**
+                 * @brief Classifies a printf format string for deferred formatting.
+                 *
+                 * Walks the conversions in @p fmt, recording which
+                 * arguments are consumed by @c %%s (those are copied as
+                 * strings; every other pointer is captured by value).
+                 * The format is not deferrable when it uses @c %%n,
+                 * @c %%m, positional arguments, a wide string, a
+                 * precision on @c %%s, an unknown conversion, or more
+                 * than 64 arguments.
+                 *
+                 * @param fmt The format string.
+                 * @return The classification.
+                 */
+                static constexpr FormatInfo formatInfo(const char *fmt) {
+                        FormatInfo info;
+                        size_t     arg = 0;
+                        for (const char *p = fmt; *p != '\0'; ++p) {
+                                if (*p != '%') continue;
+                                ++p;
+                                if (*p == '%') continue;
+                                while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'') ++p;
+                                if (*p == '*') {
+                                        arg++;
+                                        ++p;
+                                } else {
+                                        while (*p >= '0' && *p <= '9') ++p;
+                                }
+                                bool precision = false;
+                                if (*p == '.') {
+                                        precision = true;
+                                        ++p;
+                                        if (*p == '*') {
+                                                arg++;
+                                                ++p;
+                                        } else {
+                                                while (*p >= '0' && *p <= '9') ++p;
+                                        }
+                                }
+                                bool wide = false;
+                                while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'q' || *p == 'j' || *p == 'z' ||
+                                       *p == 't') {
+                                        if (*p == 'l') wide = true;
+                                        ++p;
+                                }
+                                switch (*p) {
+                                        case 'd':
+                                        case 'i':
+                                        case 'o':
+                                        case 'u':
+                                        case 'x':
+                                        case 'X':
+                                        case 'c':
+                                        case 'e':
+                                        case 'E':
+                                        case 'f':
+                                        case 'F':
+                                        case 'g':
+                                        case 'G':
+                                        case 'a':
+                                        case 'A':
+                                        case 'p': break;
+                                        case 's':
+                                                if (precision || wide) return FormatInfo{false, 0};
+                                                if (arg < 64) info.stringArgs |= uint64_t(1) << arg;
+                                                break;
+                                        default: return FormatInfo{false, 0};
+                                }
+                                arg++;
+                                if (arg > 64) return FormatInfo{false, 0};
+                        }
+                        return info;
+                }
+
                 /**
                  * @brief Returns the singleton default Logger instance.
                  * @return A reference to the default Logger.
@@ -348,13 +489,81 @@ class Logger {
                  */
                 void log(LogLevel loglevel, const char *file, int line, const StringList &lines);
 
+                /**
+                 * @brief Logs a printf-style message, formatting it on the worker when possible.
+                 *
+                 * This is the entry point behind the logging macros,
+                 * which supply @p Info from @ref formatInfo.  When the
+                 * format is deferrable, every argument is an integer,
+                 * enum, @c double, or pointer, and deferred formatting
+                 * is enabled, the call copies the arguments into the
+                 * calling thread's ring and returns without taking a
+                 * lock.  Otherwise the message is formatted here and
+                 * handed to @ref log.
+                 *
+                 * @p file and @p fmt are stored by pointer and must
+                 * have static storage duration — string literals, as
+                 * the macros guarantee.
+                 *
+                 * @tparam Info     Classification of @p fmt.
+                 * @param loglevel  The severity level of the message.
+                 * @param file      The source file name.
+                 * @param line      The source line number.
+                 * @param fmt       The printf format string.
+                 * @param args      The format arguments.
+                 */
+                template <FormatInfo Info, typename... Args>
+                void logFormatted(LogLevel loglevel, const char *file, int line, const char *fmt,
+                                  const Args &...args) {
+                        if (_terminating.value()) return;
+                        if constexpr (Info.deferrable && (isStageable<std::decay_t<Args>>() && ...)) {
+                                if (_deferredFormatting.value()) {
+                                        LogArg                  packed[sizeof...(Args) + 1];
+                                        [[maybe_unused]] size_t n = 0;
+                                        ((packed[n] = makeLogArg<std::decay_t<const Args>>(args, Info.isString(n)),
+                                          n++),
+                                         ...);
+                                        if (stage(loglevel, file, line, fmt, packed, sizeof...(Args))) return;
+                                        log(loglevel, file, line, formatArgs(fmt, packed, sizeof...(Args)));
+                                        return;
+                                }
+                        }
+                        if constexpr (sizeof...(Args) == 0) {
+                                log(loglevel, file, line, formatArgs(fmt, nullptr, 0));
+                        } else {
+                                log(loglevel, file, line, String::sprintf(fmt, args...));
+                        }
+                        return;
+                }
+
+                /**
+                 * @brief Returns whether the macros may defer formatting to the worker.
+                 * @return true (the default) when per-thread staging is in use.
+                 */
+                bool deferredFormatting() const { return _deferredFormatting.value(); }
+
+                /**
+                 * @brief Enables or disables deferred formatting.
+                 *
+                 * When disabled, @ref logFormatted formats on the
+                 * calling thread and enqueues the finished message,
+                 * exactly as @ref log does.  Records already staged are
+                 * still delivered.
+                 *
+                 * @param val true to stage and defer, false to format eagerly.
+                 */
+                void setDeferredFormatting(bool val) {
+                        _deferredFormatting.setValue(val);
+                        return;
+                }
+
                 /**
                  * @brief Sets the log output file.
                  * @param filename Path to the log file. The file is opened by the worker thread.
                  */
                 void setLogFile(const String &filename) {
                         if (_terminating.value()) return;
-                        _queue.emplace(CmdSetFile{filename});
+                        enqueue(CmdSetFile{filename});
                 }
 
                 /**
@@ -431,7 +640,7 @@ class Logger {
                                 _fileFormatter = formatter ? formatter : defaultFileFormatter();
                         }
                         if (_terminating.value()) return;
-                        _queue.emplace(CmdSetFormatter{std::move(formatter), false});
+                        enqueue(CmdSetFormatter{std::move(formatter), false});
                 }
 
                 /**
@@ -445,7 +654,7 @@ class Logger {
                                 _consoleFormatter = formatter ? formatter : defaultConsoleFormatter();
                         }
                         if (_terminating.value()) return;
-                        _queue.emplace(CmdSetFormatter{std::move(formatter), true});
+                        enqueue(CmdSetFormatter{std::move(formatter), true});
                 }
 
                 /**
@@ -512,7 +721,7 @@ class Logger {
                         if (_terminating.value()) return Error::Ok;
                         auto         p = std::make_shared<Promise<void>>();
                         Future<void> f = p->future();
-                        _queue.emplace(CmdSync{std::move(p)});
+                        enqueue(CmdSync{std::move(p)});
                         if (timeoutMs == 0) {
                                 f.waitForFinished();
                                 return Error::Ok;
@@ -552,8 +761,73 @@ class Logger {
 
                 struct CmdTerminate {};
 
+                // Wakes the worker to drain the staging rings.
+                struct CmdDrain {};
+
                 using Command = std::variant<LogEntry, CmdSetThreadName, CmdSetFile, CmdSetFormatter, CmdSync,
-                                             CmdInstallListener, CmdRemoveListener, CmdTerminate>;
+                                             CmdInstallListener, CmdRemoveListener, CmdTerminate, CmdDrain>;
+
+                // Every queued command carries the steady-clock stamp it
+                // was enqueued at; the worker drains staged records
+                // older than the stamp first so the two paths interleave
+                // in the order the calling threads issued them.
+                struct QueuedCommand {
+                                int64_t stamp;
+                                Command cmd;
+                };
+
+                // One captured format argument.  Also the on-ring slot
+                // layout; @c length is filled in for C strings by stage().
+                struct LogArg {
+                                enum Kind : uint8_t { Signed, Unsigned, Double, Pointer, CString };
+                                Kind     kind = Signed;
+                                uint32_t length = 0;
+                                union {
+                                                int64_t     i = 0;
+                                                uint64_t    u;
+                                                double      d;
+                                                const void *p;
+                                                const char *s;
+                                };
+                };
+
+                struct StagingRing;
+                friend struct LoggerThreadStaging;
+
+                template <typename T> static constexpr bool isStageable() {
+                        return std::is_integral_v<T> || std::is_enum_v<T> || std::is_same_v<T, float> ||
+                               std::is_same_v<T, double> || std::is_pointer_v<T>;
+                }
+
+                template <typename T> static LogArg makeLogArg(const T &val, bool isString) {
+                        LogArg a;
+                        if constexpr (std::is_enum_v<T>) {
+                                return makeLogArg<std::underlying_type_t<T>>(
+                                        static_cast<std::underlying_type_t<T>>(val), false);
+                        } else if constexpr (std::is_pointer_v<T>) {
+                                using C = std::remove_cv_t<std::remove_pointer_t<T>>;
+                                if constexpr (std::is_same_v<C, char> || std::is_same_v<C, signed char> ||
+                                              std::is_same_v<C, unsigned char>) {
+                                        if (isString) {
+                                                a.kind = LogArg::CString;
+                                                a.s = reinterpret_cast<const char *>(val);
+                                                return a;
+                                        }
+                                }
+                                a.kind = LogArg::Pointer;
+                                a.p = reinterpret_cast<const void *>(val);
+                        } else if constexpr (std::is_floating_point_v<T>) {
+                                a.kind = LogArg::Double;
+                                a.d = val;
+                        } else if constexpr (std::is_signed_v<T>) {
+                                a.kind = LogArg::Signed;
+                                a.i = val;
+                        } else {
+                                a.kind = LogArg::Unsigned;
+                                a.u = val;
+                        }
+                        return a;
+                }
 
                 struct ListenerEntry {
                                 ListenerHandle handle;
@@ -565,21 +839,42 @@ class Logger {
                                 String   threadName;
                 };
 
+                using StagingRingList = List<std::shared_ptr<StagingRing>>;
+
                 BasicThread           _thread;
+                uint64_t              _id;
                 Atomic<int>           _level;
                 Atomic<bool>          _consoleLogging;
                 Atomic<bool>          _consoleUseStderr;
                 Atomic<bool>          _terminating{false};
+                Atomic<bool>          _deferredFormatting{true};
                 Atomic<size_t>        _historySize{DefaultHistorySize};
                 Atomic<uint64_t>      _nextListenerHandle{0};
-                Queue<Command>        _queue;
+                Queue<QueuedCommand>  _queue;
                 mutable Mutex         _formatterMutex;
                 LogFormatter          _fileFormatter;
                 LogFormatter          _consoleFormatter;
                 Map<uint64_t, String> _threadNames;
                 List<ListenerEntry>   _listeners; ///< Worker-thread only.
                 Deque<HistoryEntry>   _history;   ///< Worker-thread only.
-
+                DateTime              _wallBase;   ///< Wall time at @c _steadyBase, maps staged stamps.
+                int64_t               _steadyBase; ///< Steady-clock ns at construction.
+                Mutex                 _stagingMutex;
+                StagingRingList       _stagingRings; ///< Guarded by @c _stagingMutex.
+                Atomic<uint64_t>      _stagingGeneration{0};
+                StagingRingList       _drainRings; ///< Worker-thread copy of @c _stagingRings.
+                uint64_t              _drainGeneration = 0;
+                alignas(64) Atomic<bool> _wakePending{false};
+
+                void                enqueue(Command &&cmd);
+                bool                stage(LogLevel loglevel, const char *file, int line, const char *fmt,
+                                          const LogArg *args, size_t count);
+                StagingRing        *threadRing();
+                static String       formatArgs(const char *fmt, const LogArg *args, size_t count);
+                void                refreshStagingRings();
+                void                drainStaged(int64_t limit, class FileIODevice *logFile);
+                bool                stagingPending();
+                void                processEntry(const LogEntry &entry, class FileIODevice *logFile);
                 void                worker();
                 void                writeLog(const LogEntry &cmd, class FileIODevice *logFile);
                 class FileIODevice *openLogFile(const String &filename, class FileIODevice *existing);
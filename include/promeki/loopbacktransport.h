@@ -96,6 +96,9 @@ class LoopbackTransport : public PacketTransport {
                 /** @copydoc PacketTransport::receivePacket() */
                 ssize_t receivePacket(void *data, size_t maxSize, SocketAddress *sender = nullptr) override;
 
+                /** @copydoc PacketTransport::receivePackets() */
+                int receivePackets(RecvDatagramList &packets, bool wantSender = false) override;
+
                 /** @copydoc PacketTransport::setPacingRate() */
                 Error setPacingRate(uint64_t bytesPerSec) override;
 
@@ -118,6 +121,9 @@ class LoopbackTransport : public PacketTransport {
                 /** @brief Called by the sending peer to enqueue a packet. */
                 void deliver(const void *data, size_t size, const SocketAddress &sender);
 
+                /** @brief Enqueues a batch-send datagram, gathering any scatter segments. */
+                void deliver(const Datagram &d);
+
                 LoopbackTransport *_peer = nullptr;
                 mutable Mutex      _queueMutex;
                 List<QueueEntry>   _recvQueue;
@@ -1207,6 +1207,15 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                            .setMin(int32_t(512))
                                            .setDescription("FrameBridge metadata reserve per slot, bytes."));
 
+                /// @brief int — per-slot serialized ANC reserve per ANC stream
+                /// (default 16 KiB).
+                PROMEKI_DECLARE_ID(FrameBridgeAncReserveBytes,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(16 * 1024))
+                                           .setMin(int32_t(512))
+                                           .setDescription("FrameBridge ANC reserve per stream per slot, bytes."));
+
                 /// @brief double — extra audio capacity fraction above worst-case
                 /// samples-per-frame (default 0.20).
                 PROMEKI_DECLARE_ID(FrameBridgeAudioHeadroomFraction,
@@ -1260,6 +1269,20 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                 .setDefault(true)
                                 .setDescription("FrameBridge output: block writeFrame until consumer connects."));
 
+                /// @brief bool — publisher vends slot-backed image planes
+                /// (default false).
+                ///
+                /// When @c true the producer-side MediaIO installs the
+                /// bridge's zero-copy allocator, so upstream stages
+                /// render straight into the shared-memory ring and
+                /// publishing skips the image copy.  Only consulted
+                /// when the MediaIO task is opened on the producer side.
+                PROMEKI_DECLARE_ID(FrameBridgeZeroCopy,
+                                   VariantSpec()
+                                           .setType(DataTypeBool)
+                                           .setDefault(false)
+                                           .setDescription("FrameBridge output: allocate image planes in ring slots."));
+
                 // ============================================================
                 // JPEG codec
                 // ============================================================
@@ -1279,6 +1302,22 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                                             .setEnumType(ChromaSubsampling::Type)
                                                             .setDescription("JPEG chroma subsampling."));
 
+                /// @brief int — number of horizontal stripes a JPEG frame is
+                /// encoded / decoded in concurrently.  @c 1 (default) runs on
+                /// the calling thread only; @c 0 picks
+                /// @ref BasicThread::idealThreadCount.  Striped encodes emit
+                /// one restart interval per stripe (DRI + RSTn), so the output
+                /// stays a single baseline JFIF.  Honored by
+                /// @ref JpegVideoEncoder and @ref JpegVideoDecoder.
+                PROMEKI_DECLARE_ID(JpegThreads,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(1))
+                                           .setMin(int32_t(0))
+                                           .setMax(int32_t(256))
+                                           .setDescription("JPEG slice-parallel worker count "
+                                                           "(1 = serial, 0 = one per CPU)."));
+
                 // ============================================================
                 // JPEG XS codec
                 // ============================================================
@@ -1800,6 +1839,20 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                                     .setEnumType(promeki::CscPath::Type)
                                                     .setDescription("CSC processing path (Optimized or Scalar)."));
 
+                /// @brief int — number of row bands a CSC conversion runs
+                /// concurrently on @ref CSCPipeline::threadPool.  @c 1
+                /// (default) converts on the calling thread only; @c 0
+                /// picks @ref BasicThread::idealThreadCount.  Honored by
+                /// @ref CSCPipeline and forwarded by @ref CscMediaIO.
+                PROMEKI_DECLARE_ID(CscThreads,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(1))
+                                           .setMin(int32_t(0))
+                                           .setMax(int32_t(256))
+                                           .setDescription("CSC slice-parallel worker count "
+                                                           "(1 = serial, 0 = one per CPU)."));
+
                 /// @brief Enum @ref CscToneMapping — when to apply HDR
                 /// tone-mapping (@c Auto enables it automatically on
                 /// HDR → SDR boundaries, @c Enabled forces it on,
@@ -1868,6 +1921,33 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                                          .setMin(int32_t(0))
                                                          .setDescription("First frame index for a sequence writer."));
 
+                /// @brief int — sequence frames a reader keeps loading ahead
+                /// of the play position on the shared image-sequence pool.
+                /// Loads follow the current step direction and are delivered
+                /// strictly in sequence order; @c 0 loads each frame on the
+                /// read itself.
+                PROMEKI_DECLARE_ID(ImageSeqReadAhead,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(4))
+                                           .setMin(int32_t(0))
+                                           .setMax(int32_t(256))
+                                           .setDescription("Sequence frames loaded ahead in parallel "
+                                                           "(0 = load on read)."));
+
+                /// @brief int — sequence frame saves a writer keeps in flight
+                /// on the shared image-sequence pool.  A failed save is
+                /// reported by the next write or by close; @c 0 saves each
+                /// frame before the write returns.
+                PROMEKI_DECLARE_ID(ImageSeqWriteBehind,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(4))
+                                           .setMin(int32_t(0))
+                                           .setMax(int32_t(256))
+                                           .setDescription("Sequence frame saves kept in flight "
+                                                           "(0 = save on write)."));
+
                 /// @brief bool — enable automatic @c .imgseq sidecar for image
                 /// sequences.  When true (the default), the ImageFile backend
                 /// writes a @c .imgseq sidecar alongside the image files when
@@ -1997,6 +2077,30 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                            .setEnumType(promeki::QuickTimeCaptionReadPolicy::Type)
                                            .setDescription("How a c608 caption track feeds the ANC model on read."));
 
+                /// @brief int — video frames the QuickTime reader prefetches
+                /// ahead of the play position.  Every track's samples for
+                /// those frames are read in a few large asynchronous reads
+                /// and served from memory; @c 0 reads each sample on demand.
+                PROMEKI_DECLARE_ID(QuickTimeReadaheadFrames,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(8))
+                                           .setMin(int32_t(0))
+                                           .setMax(int32_t(256))
+                                           .setDescription("Frames of samples prefetched ahead of playback "
+                                                           "(0 = read on demand)."));
+
+                /// @brief int — memory budget of the QuickTime reader's
+                /// read-ahead cache, in MiB.  The window is cut short
+                /// when a run of large frames would exceed it.
+                PROMEKI_DECLARE_ID(QuickTimeReadaheadMiB,
+                                   VariantSpec()
+                                           .setType(DataTypeInt32)
+                                           .setDefault(int32_t(256))
+                                           .setMin(int32_t(1))
+                                           .setMax(int32_t(65536))
+                                           .setDescription("Read-ahead cache budget in MiB."));
+
                 // ============================================================
                 // FFmpeg container backend (FfmpegMediaIO)
                 // ============================================================
@@ -2563,6 +2667,23 @@ class MediaConfig : public VariantDatabase<"MediaConfig"> {
                                            .setDefault(true)
                                            .setDescription("Set IP DF (don't fragment) on RTP egress sockets."));
 
+                /// @brief bool — send uncompressed video with @c MSG_ZEROCOPY.
+                ///
+                /// Raw video packets are always built scatter-gather —
+                /// headers in a small per-frame buffer, sample data
+                /// referenced in place in the frame.  With this enabled
+                /// the egress sockets also set @c SO_ZEROCOPY, so the
+                /// kernel pins the frame pages instead of copying them
+                /// and the frame stays referenced until the NIC is done.
+                /// Only worthwhile for high-bitrate streams on a NIC
+                /// with scatter-gather DMA; kernels or platforms without
+                /// UDP zero-copy fall back to the copying path.
+                PROMEKI_DECLARE_ID(RtpZeroCopy,
+                                   VariantSpec()
+                                           .setType(DataTypeBool)
+                                           .setDefault(false)
+                                           .setDescription("Send RTP video with MSG_ZEROCOPY (Linux)."));
+
                 /// @brief String — sender source IP for SDP @c source-filter
                 ///        (RFC 4570).
                 ///
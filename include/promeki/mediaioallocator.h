@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <promeki/namespace.h>
 #include <promeki/bufferallocator.h>
+#include <promeki/bufferpool.h>
 #include <promeki/uncompressedvideopayload.h>
 #include <promeki/pcmaudiopayload.h>
 
@@ -52,6 +53,14 @@ PROMEKI_NAMESPACE_BEGIN
  * @c BufferAllocator::defaultAllocator() — same behaviour as
  * before the allocator framework existed.
  *
+ * @par Pooled allocation
+ * @ref pooledAllocator returns an allocator whose per-plane and
+ * per-chunk primitives draw from a @ref BufferPool.  Install it on a
+ * MediaIO with @c MediaIO::setAllocator and every frame plane / audio
+ * chunk allocated on its behalf recycles itself into the pool when the
+ * frame is dropped, so a steady-state pipeline stops calling @c malloc
+ * for payload memory.
+ *
  * @par Threading and lifetime
  * Same contract as @ref BufferAllocator — implementations must be
  * thread-safe; pooled backends anchor their pool's lifetime through
@@ -107,6 +116,21 @@ class MediaIOAllocator : public BufferAllocator {
                  * returns the same instance (Meyers' singleton).
                  */
                 static Ptr defaultAllocator();
+
+                /**
+                 * @brief Returns an allocator backed by @p pool.
+                 *
+                 * @ref allocateVideoPlane and @ref allocateAudioChunk
+                 * acquire from @p pool (one size class per plane /
+                 * chunk shape), so their Buffers recycle themselves
+                 * when the last reference drops.  @ref allocateBytes
+                 * is left on the default heap path — its sizes are too
+                 * varied to pool usefully.  The allocator holds a
+                 * handle to @p pool; pass a pool shared with other
+                 * allocators to pool across MediaIOs, or the default
+                 * to get a private variable-size pool.
+                 */
+                static Ptr pooledAllocator(const BufferPool &pool = BufferPool());
 };
 
 PROMEKI_NAMESPACE_END
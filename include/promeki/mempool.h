@@ -29,9 +29,65 @@ PROMEKI_NAMESPACE_BEGIN
  * manage memory that this class cannot directly access — for example,
  * memory on a remote device, hardware device, or video memory.
  * Free blocks are automatically coalesced on deallocation.
+ *
+ * @par Allocator modes
+ * The pool runs one of two allocators behind the same API, picked at
+ * construction by @ref Mode:
+ *
+ * - @ref Mode::FirstFit (default) — an address-ordered free set walked
+ *   first-fit, with an ordered map of live allocations.  Allocations
+ *   are exactly the requested size plus alignment padding.  Cost grows
+ *   with the number of free blocks and every operation touches the
+ *   heap.
+ * - @ref Mode::Tlsf — a two-level segregated-fit allocator.  Free
+ *   blocks sit in 64 × 32 size-binned lists indexed by a pair of
+ *   bitmaps, so finding a fit, splitting and coalescing are all
+ *   bounded O(1).  Block metadata lives in a fixed descriptor table
+ *   and live allocations are found through a preallocated open-address
+ *   hash, both sized by @c Config::maxBlocks at construction — the
+ *   allocate / free path never touches the heap.  Sizes are rounded up
+ *   to @ref TlsfGranule bytes.
+ *
+ * @par Front caches
+ * In TLSF mode, setting @c Config::frontCacheMaxSize gives every thread
+ * a small private cache of recently freed blocks per size class up to
+ * that size.  A cache hit allocates or frees without taking the pool
+ * mutex.  Cached blocks stay allocated from the pool's point of view;
+ * @ref stats reports them separately and @ref flushThreadCache hands the
+ * calling thread's blocks back.  A thread's cache is drained when the
+ * thread exits.
+ *
+ * @par Thread Safety
+ * Fully thread-safe in both modes.  The pool must outlive every thread
+ * call into it; a pool destroyed while other threads still allocate
+ * from it is undefined behavior.
  */
 class MemPool {
         public:
+                /** @brief Allocator strategy used by the pool. */
+                enum class Mode {
+                        FirstFit, ///< Address-ordered first-fit (the original allocator).
+                        Tlsf      ///< Two-level segregated fit with O(1) operations.
+                };
+
+                /** @brief Size granularity of TLSF allocations in bytes. */
+                static constexpr size_t TlsfGranule = 16;
+
+                /** @brief Largest request size a front cache will hold. */
+                static constexpr size_t MaxFrontCacheSize = 1024;
+
+                /** @brief Construction parameters for a pool. */
+                struct Config {
+                                /** @brief Allocator strategy. */
+                                Mode mode = Mode::FirstFit;
+                                /** @brief TLSF descriptor capacity (regions + free + allocated blocks). */
+                                size_t maxBlocks = 4096;
+                                /** @brief Largest request served by per-thread caches (0 = disabled, TLSF only). */
+                                size_t frontCacheMaxSize = 0;
+                                /** @brief Blocks each thread caches per size class. */
+                                size_t frontCacheDepth = 16;
+                };
+
                 /**
                  * @brief Statistics about the current state of the memory pool.
                  */
@@ -41,6 +97,8 @@ class MemPool {
                                 size_t numFreeBlocks;      ///< Number of free block regions.
                                 size_t numAllocatedBlocks; ///< Number of allocated block regions.
                                 size_t largestFreeBlock;   ///< Size in bytes of the largest free block.
+                                size_t cachedBlocks;       ///< Blocks parked in per-thread front caches.
+                                size_t cachedBytes;        ///< Bytes parked in per-thread front caches.
                 };
 
                 /**
@@ -108,11 +166,40 @@ class MemPool {
                 using BlockSet = ::promeki::Set<Block>;            ///< Sorted set of blocks ordered by address.
                 using BlockMap = ::promeki::Map<uintptr_t, Block>; ///< Map from aligned address to allocated block.
 
-                /** @brief Constructs an empty memory pool with a default hex name. */
+                /** @brief Constructs an empty first-fit memory pool with a default hex name. */
                 MemPool();
 
+                /**
+                 * @brief Constructs an empty memory pool using @p mode.
+                 * @param mode The allocator strategy.
+                 */
+                explicit MemPool(Mode mode);
+
+                /**
+                 * @brief Constructs an empty memory pool from an explicit @ref Config.
+                 * @param config The pool configuration.
+                 */
+                explicit MemPool(const Config &config);
+
+                /** @brief Destroys the pool.  Outstanding allocations are simply forgotten. */
+                ~MemPool();
+
+                MemPool(const MemPool &) = delete;
+                MemPool &operator=(const MemPool &) = delete;
+
+                /** @brief Returns the allocator strategy. */
+                Mode mode() const { return _config.mode; }
+
+                /** @brief Returns the configuration the pool was built with. */
+                const Config &config() const { return _config; }
+
                 /**
                  * @brief Adds a contiguous memory region to the pool.
+                 *
+                 * In TLSF mode each region takes one descriptor; the
+                 * region is dropped with an error logged if the
+                 * descriptor table is full.
+                 *
                  * @param startingAddress The starting address of the region.
                  * @param size            The size of the region in bytes.
                  */
@@ -167,16 +254,30 @@ class MemPool {
                  * @brief Frees a previously allocated block back to the pool.
                  *
                  * Adjacent free blocks are automatically coalesced.
+                 * With front caches enabled a small block may instead be
+                 * parked in the calling thread's cache.
                  *
                  * @param ptr The pointer returned by allocate(). Passing nullptr is a no-op.
                  */
                 void free(void *ptr);
 
+                /**
+                 * @brief Returns every block in the calling thread's front cache to the pool.
+                 *
+                 * A no-op when front caches are disabled or the thread
+                 * has no cache for this pool.
+                 */
+                void flushThreadCache();
+
         private:
+                struct Tlsf;
+
                 String        _name;
+                Config        _config;
                 mutable Mutex _mutex;
                 BlockSet      _freeBlocks;
                 BlockMap      _allocatedBlocks;
+                Tlsf         *_tlsf = nullptr;
 };
 
 PROMEKI_NAMESPACE_END
@@ -229,6 +229,10 @@ class MemSpace {
                                                  * for a precise on-demand readout.
                                                  */
                                                 uint64_t peakResidentBytes = 0;
+                                                uint64_t poolHitCount =
+                                                        0; ///< BufferPool acquires served by a recycled block.
+                                                uint64_t poolMissCount =
+                                                        0; ///< BufferPool acquires that needed fresh memory.
                                 };
 
                                 Atomic<uint64_t> allocCount{0};     ///< @see Snapshot::allocCount
@@ -247,6 +251,8 @@ class MemSpace {
                                 Atomic<uint64_t> peakCount{0};      ///< @see Snapshot::peakCount
                                 Atomic<uint64_t> peakBytes{0};      ///< @see Snapshot::peakBytes
                                 Atomic<uint64_t> peakResidentBytes{0}; ///< @see Snapshot::peakResidentBytes
+                                Atomic<uint64_t> poolHitCount{0};      ///< @see Snapshot::poolHitCount
+                                Atomic<uint64_t> poolMissCount{0};     ///< @see Snapshot::poolMissCount
 
                                 Stats() = default;
                                 Stats(const Stats &) = delete;
@@ -12,7 +12,9 @@
 #if PROMEKI_ENABLE_NETWORK
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <promeki/namespace.h>
+#include <promeki/buffer.h>
 #include <promeki/error.h>
 #include <promeki/list.h>
 #include <promeki/socketaddress.h>
@@ -39,7 +41,10 @@ PROMEKI_NAMESPACE_BEGIN
  *    to one or many destinations.  The batch form is the primary API
  *    because DPDK and @c sendmmsg() both prefer to see many packets at
  *    once; the single-packet form exists for convenience.
- *  - @ref receivePacket() reads one inbound datagram.
+ *  - @ref receivePacket() reads one inbound datagram;
+ *    @ref receivePackets() reads as many as are ready in one call
+ *    (@c recvmmsg() on Linux sockets) and is what the RTP receive
+ *    path uses.
  *  - @ref setPacingRate() and @ref setTxTime() expose optional
  *    transmit-rate and per-packet deadline controls.  Backends that
  *    cannot implement them return @ref Error::NotSupported.
@@ -63,7 +68,11 @@ PROMEKI_NAMESPACE_BEGIN
  * data pointers must remain valid until the call returns.  Socket
  * backends copy into kernel buffers synchronously, so this contract
  * is free for the caller; DPDK backends must copy or refcount before
- * returning, not defer the copy.
+ * returning, not defer the copy.  Zero-copy mode (@ref setZeroCopy())
+ * is the exception: there the transport keeps the datagrams'
+ * @c dataOwner / @c segmentOwner / @c Segment::owner Buffers alive
+ * until the kernel is done with them.  Every iov needs an owner; a
+ * batch with an unowned one is sent by copying.
  */
 class PacketTransport {
         public:
@@ -77,9 +86,26 @@ class PacketTransport {
                  * that the UDP-backed transport can pass the list
                  * through unchanged.  Other backends build their own
                  * mbuf / ring-buffer entries from these fields.
+                 *
+                 * The on-wire bytes are @c data followed by the first
+                 * @c segmentCount @c segments.  Backends that cannot
+                 * scatter-gather use @ref copyTo() to flatten them.
                  */
                 struct Datagram {
-                                /** @brief Pointer to the packet bytes (caller-owned, contiguous). */
+                                /** @brief One extra gather segment appended after @c data. */
+                                struct Segment {
+                                                /** @brief Segment bytes (caller-owned). */
+                                                const void *data = nullptr;
+                                                /** @brief Segment length in bytes. */
+                                                size_t size = 0;
+                                                /** @brief Owner of @c data, held until zero-copy completion. */
+                                                Buffer owner;
+                                };
+
+                                /** @brief Maximum number of extra gather segments per datagram. */
+                                static constexpr size_t MaxSegments = 4;
+
+                                /** @brief Pointer to the first (or only) run of packet bytes (caller-owned). */
                                 const void *data = nullptr;
                                 /** @brief Number of bytes to send. */
                                 size_t size = 0;
@@ -94,11 +120,63 @@ class PacketTransport {
                          * holds the packet until the target time.
                          */
                                 uint64_t txTimeNs = 0;
+                                /** @brief Extra payload segments sent after @c data. */
+                                Segment segments[MaxSegments];
+                                /** @brief Number of valid entries in @c segments. */
+                                size_t segmentCount = 0;
+                                /** @brief Owner of @c data, held until zero-copy completion. */
+                                Buffer dataOwner;
+                                /** @brief Owner of every segment without its own @c Segment::owner. */
+                                Buffer segmentOwner;
+
+                                /** @brief Returns the total on-wire payload size, @c size plus every segment. */
+                                size_t totalSize() const {
+                                        size_t total = size;
+                                        for (size_t i = 0; i < segmentCount; ++i) total += segments[i].size;
+                                        return total;
+                                }
+
+                                /**
+                                 * @brief Gathers the datagram into contiguous memory.
+                                 * @param dst Destination of at least @ref totalSize() bytes.
+                                 * @return The number of bytes written.
+                                 */
+                                size_t copyTo(void *dst) const {
+                                        uint8_t *out = static_cast<uint8_t *>(dst);
+                                        std::memcpy(out, data, size);
+                                        size_t off = size;
+                                        for (size_t i = 0; i < segmentCount; ++i) {
+                                                std::memcpy(out + off, segments[i].data, segments[i].size);
+                                                off += segments[i].size;
+                                        }
+                                        return off;
+                                }
                 };
 
                 /** @brief List of datagrams for batch send. */
                 using DatagramList = ::promeki::List<Datagram>;
 
+                /**
+                 * @brief Describes one receive slot for @ref receivePackets().
+                 *
+                 * Identical in shape to @ref UdpSocket::RecvDatagram.
+                 * The caller owns @c data; the transport fills in
+                 * @c size and, when requested, @c sender.
+                 */
+                struct RecvDatagram {
+                                /** @brief Receive buffer (caller-owned). */
+                                void *data = nullptr;
+                                /** @brief Capacity of @c data in bytes. */
+                                size_t maxSize = 0;
+                                /** @brief [out] Bytes received into @c data. */
+                                size_t size = 0;
+                                /** @brief [out] Sender address, if requested. */
+                                SocketAddress sender;
+                };
+
+                /** @brief List of receive slots for batch receive. */
+                using RecvDatagramList = ::promeki::List<RecvDatagram>;
+
                 /** @brief Virtual destructor. */
                 virtual ~PacketTransport() = default;
 
@@ -150,6 +228,28 @@ class PacketTransport {
                  */
                 virtual ssize_t receivePacket(void *data, size_t maxSize, SocketAddress *sender = nullptr) = 0;
 
+                /**
+                 * @brief Receives a batch of inbound packets.
+                 *
+                 * Waits for the first packet with the same blocking /
+                 * timeout semantics as @ref receivePacket(), then
+                 * fills as many further slots as the backend has
+                 * packets ready for without waiting again.  Socket
+                 * backends implement this as one @c recvmmsg().  The
+                 * default implementation calls @ref receivePacket()
+                 * once and returns at most one packet.
+                 *
+                 * @param packets    Receive slots; @c size and
+                 *                   (optionally) @c sender are written
+                 *                   for each filled slot.
+                 * @param wantSender When true, report each packet's
+                 *                   source address in @c sender.
+                 * @return The number of slots filled (a prefix of
+                 *         @p packets), 0 if @p packets is empty, or
+                 *         -1 on timeout / failure.
+                 */
+                virtual int receivePackets(RecvDatagramList &packets, bool wantSender = false);
+
                 /**
                  * @brief Sets a transmit-rate limit on this transport.
                  *
@@ -179,6 +279,33 @@ class PacketTransport {
                  */
                 virtual Error setTxTime(bool enable);
 
+                /**
+                 * @brief Enables zero-copy transmit.
+                 *
+                 * When enabled, backends that support it (the kernel
+                 * @c MSG_ZEROCOPY path on Linux UDP sockets) send
+                 * datagrams that carry an owner for every iov without
+                 * copying them, and keep the owners alive until the
+                 * kernel
+                 * reports completion.  The default implementation
+                 * returns @ref Error::NotSupported.
+                 *
+                 * @param enable True to enable, false to disable.
+                 * @return Error::Ok on success, Error::NotSupported
+                 *         if the backend does not implement it.
+                 */
+                virtual Error setZeroCopy(bool enable);
+
+                /**
+                 * @brief Returns true if zero-copy transmit is active.
+                 *
+                 * Senders check this before filling in the
+                 * @c dataOwner / @c segmentOwner / @c Segment::owner
+                 * fields, so the reference-count traffic is only paid
+                 * when it buys something.
+                 */
+                virtual bool isZeroCopy() const { return false; }
+
         protected:
                 /** @brief Protected constructor — instantiate a concrete subclass. */
                 PacketTransport() = default;
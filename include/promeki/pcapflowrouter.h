@@ -19,6 +19,7 @@
 #include <promeki/duration.h>
 #include <promeki/error.h>
 #include <promeki/function.h>
+#include <promeki/hashmap.h>
 #include <promeki/list.h>
 #include <promeki/packetdemux.h>
 #include <promeki/pcapsdpmap.h>
@@ -58,6 +59,26 @@ class SdpSession;
  * Audio and video flows are recognised and tallied but not yet decoded
  * here — that is a later phase.  The dispatch seam exists so those
  * decoders slot in without re-plumbing the reader/demux front end.
+ *
+ * @par Parallel analysis
+ * With @ref setThreads above one, the calling thread only reads and
+ * demultiplexes; each datagram is handed, in batches, to one of N
+ * worker threads chosen by its destination.  Every piece of per-flow
+ * state (flow rows, RTP health, ANC reassembly) is keyed by
+ * destination, so it lives on exactly one worker and needs no locking.
+ * Sharding is by destination rather than by @c (dst, ssrc) because
+ * SSRC-change detection compares SSRCs seen on the same destination.
+ * Destinations are dealt to workers round-robin in first-seen order,
+ * so a capture with as many flows as workers keeps them all busy.
+ *
+ * Results are identical to a single-threaded run.  Each datagram
+ * carries its capture-order ordinal; workers buffer the callbacks they
+ * would have made, and once the capture is drained the buffers are
+ * merged by ordinal and delivered on the calling thread before
+ * @ref processFile returns.  @ref flowStats rows keep first-seen
+ * order.  The difference callers see is timing: callbacks arrive in
+ * one burst at the end of the run rather than interleaved with
+ * reading.
  */
 class PcapFlowRouter {
         public:
@@ -176,6 +197,22 @@ class PcapFlowRouter {
                  */
                 void setJitterWarnThreshold(const Duration &threshold) { _jitterWarn = threshold; }
 
+                /**
+                 * @brief Sets the number of analysis worker threads.
+                 *
+                 * @c 1 (the default) analyses on the calling thread and
+                 * delivers callbacks as packets are read.  Larger values
+                 * enable the sharded mode described under "Parallel
+                 * analysis"; @c 0 uses @ref BasicThread::idealThreadCount.
+                 * Takes effect at the next @ref processFile /
+                 * @ref processBuffer; accumulated per-flow state carries
+                 * over across a change.
+                 */
+                void setThreads(unsigned int n) { _threads = n; }
+
+                /** @brief The configured worker-thread count (see @ref setThreads). */
+                unsigned int threads() const { return _threads; }
+
                 /**
                  * @brief Process an entire capture file.
                  * @param path Path to a @c .pcap / @c .pcapng file.
@@ -200,8 +237,21 @@ class PcapFlowRouter {
                 void reset();
 
         private:
+                /// @brief Datagrams handed to a worker per queue push.
+                static constexpr size_t ShardBatchSize = 256;
+
+                /// @brief Batches a worker may have queued before the
+                ///        reader blocks, bounding in-flight datagrams.
+                static constexpr size_t ShardQueueDepth = 16;
+
+                /// @brief Ordinal given to events raised by the
+                ///        end-of-capture ANC flush, so they sort after
+                ///        every packet-driven event.
+                static constexpr uint64_t FlushSeq = UINT64_MAX;
+
                 /// @brief Per-ANC-flow reassembly state.
                 struct AncReasm {
+                                uint64_t firstSeq = 0; ///< Ordinal of the datagram that created it.
                                 SocketAddress dst;
                                 SocketAddress src;
                                 uint32_t ssrc = 0;
@@ -239,27 +289,80 @@ class PcapFlowRouter {
                                 RtpSeqTracker tracker;
                 };
 
-                void handleDatagram(const UdpDatagram &dg, const DateTime &captureTime);
-                void routeAnc(const UdpDatagram &dg, const PcapFlow &flow, const RtpPacket &pkt, const DateTime &captureTime);
-                void flushAnc(AncReasm &r);
-                FlowStat &statFor(const SocketAddress &dst, uint32_t ssrc, uint8_t pt, PcapFlowKind kind);
-                AncReasm &ancReasmFor(const UdpDatagram &dg, const PcapFlow &flow);
-                FlowHealth &healthFor(const SocketAddress &dst);
-                void trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind, const RtpPacket &pkt, FlowStat &st,
-                                    const DateTime &captureTime);
-                void emitAnomaly(RtpAnomaly::Kind kind, PcapFlowKind flowKind, const SocketAddress &dst, uint32_t ssrc,
-                                 uint32_t previous, uint32_t count, const DateTime &captureTime,
+                /// @brief A flow row plus the ordinal that created it.
+                struct StatRow {
+                                uint64_t firstSeq = 0;
+                                FlowStat stat;
+                };
+
+                /// @brief A callback held back by a worker until the merge.
+                struct PendingEvent {
+                                uint64_t     seq = 0;   ///< Datagram ordinal (or @ref FlushSeq).
+                                uint64_t     order = 0; ///< Tie-break for flush events: the reassembly's firstSeq.
+                                bool         isAnc = false;
+                                RoutedAncFrame anc;
+                                RtpAnomaly   anomaly;
+                };
+
+                /// @brief The per-flow state for one set of destinations,
+                ///        owned by a single thread for the length of a run.
+                struct Shard {
+                                List<StatRow>               stats;
+                                List<AncReasm>              ancFlows;
+                                List<UniquePtr<FlowHealth>> health;
+                                List<PendingEvent>          events;
+                                bool                        deferEvents = false; ///< Buffer callbacks into @ref events.
+                                uint64_t                    seq = 0;   ///< Ordinal of the datagram being handled.
+                                uint64_t                    order = 0; ///< See @ref PendingEvent::order.
+                };
+
+                using ShardList = List<UniquePtr<Shard>>;
+
+                /// @brief Deals destinations to shards round-robin in
+                ///        first-seen order.
+                class ShardAssigner {
+                        public:
+                                explicit ShardAssigner(size_t count) : _count(count) {}
+                                size_t operator()(const SocketAddress &dst);
+
+                        private:
+                                HashMap<uint64_t, size_t> _map;
+                                size_t                    _count = 1;
+                                size_t                    _next = 0;
+                };
+
+                void handleDatagram(Shard &sh, const UdpDatagram &dg, const DateTime &captureTime);
+                void routeAnc(Shard &sh, const UdpDatagram &dg, const PcapFlow &flow, const RtpPacket &pkt,
+                              const DateTime &captureTime);
+                void flushAnc(Shard &sh, AncReasm &r);
+                void flushShard(Shard &sh);
+                FlowStat &statFor(Shard &sh, const SocketAddress &dst, uint32_t ssrc, uint8_t pt, PcapFlowKind kind);
+                AncReasm &ancReasmFor(Shard &sh, const UdpDatagram &dg, const PcapFlow &flow);
+                FlowHealth &healthFor(Shard &sh, const SocketAddress &dst);
+                void trackRtpHealth(Shard &sh, const SocketAddress &dst, PcapFlowKind kind, const RtpPacket &pkt,
+                                    FlowStat &st, const DateTime &captureTime);
+                void emitAnomaly(Shard &sh, RtpAnomaly::Kind kind, PcapFlowKind flowKind, const SocketAddress &dst,
+                                 uint32_t ssrc, uint32_t previous, uint32_t count, const DateTime &captureTime,
                                  const Duration &jitter = Duration::zero());
+                void emitAncFrame(Shard &sh, RoutedAncFrame &&f);
 
                 Error runReader(class PcapReader &reader);
+                void runSerial(class PcapReader &reader, Shard &sh);
+                bool runSharded(class PcapReader &reader, ShardList &shards, ShardAssigner &assign);
+                ShardList splitShards(ShardAssigner &assign, size_t count);
+                void joinShards(ShardList &shards);
+                void deliverEvents(ShardList &shards);
 
                 PcapSdpMap _map;
                 PacketDemux _demux;
                 AncFrameCallback _ancCb;
                 RtpAnomalyCallback _anomalyCb;
                 Duration _jitterWarn = Duration::zero(); ///< Jitter warn threshold; zero/invalid = disabled.
+                unsigned int _threads = 1;       ///< Analysis workers; see @ref setThreads.
+                uint64_t _seq = 0;               ///< Next datagram ordinal (capture order, across runs).
                 List<FlowStat> _stats;
-                List<AncReasm> _ancFlows;
+                List<uint64_t> _statSeq;         ///< firstSeq for each @ref _stats row.
+                List<AncReasm> _ancFlows;        ///< Kept in firstSeq order between runs.
                 List<UniquePtr<FlowHealth>> _health;
 };
 
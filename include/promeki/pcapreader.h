@@ -32,9 +32,9 @@ class IODevice;
  * A record is the container's view of a single captured frame: the
  * arrival timestamp, the link-layer type needed to demux it, and a
  * zero-copy @ref BufferView of the captured bytes.  The view aliases
- * the reader's single backing @ref Buffer — it stays valid as long as
- * the reader (or any copy of the view) is alive; no per-record
- * allocation occurs.
+ * the reader's single backing @ref Buffer (a heap image or a read-only
+ * file mapping) and holds a reference to it, so it stays valid even
+ * after the reader is closed; no per-record allocation occurs.
  *
  * @par Two notions of "truncated"
  * @ref snapTruncated marks a frame whose capture was limited by the
@@ -91,10 +91,33 @@ struct PcapRecord {
  *    forward-compatible skipping of unrecognised block types.
  *
  * @par Zero-copy
- * The whole capture is read once into a single backing @ref Buffer and
- * every @ref PcapRecord::frame is a @ref BufferView into it.  No
- * allocation happens per record, which matters because ST 2110
- * captures grow large quickly.
+ * Every @ref PcapRecord::frame is a @ref BufferView into a single
+ * backing @ref Buffer.  No allocation happens per record, which
+ * matters because ST 2110 captures grow large quickly.
+ *
+ * @par Mapped files
+ * @ref openFile maps the capture read-only (@ref openMapped) instead
+ * of reading it into memory, so a multi-gigabyte capture opens
+ * instantly and the first record is available without touching the
+ * rest of the file.  The mapping is advised for sequential access so
+ * the kernel reads ahead, and pages more than @ref ReleaseWindow bytes
+ * behind the parse cursor are dropped from the process as iteration
+ * advances, keeping the resident set bounded for captures far larger
+ * than RAM.  A dropped page is simply faulted back in from the file if
+ * a caller still holding an older frame touches it.  The mapping is
+ * owned by the backing buffer and is unmapped when the last frame
+ * referencing it is released.  Paths that cannot be mapped (compiled-in
+ * resources, non-POSIX platforms) fall back to reading the whole file.
+ *
+ * @par Random access
+ * The reader records a checkpoint (file offset plus the byte order and
+ * interface table in force) every @ref IndexStride records as it
+ * parses.  @ref seekRecord jumps to the nearest checkpoint at or
+ * before the target and parses forward from there, so revisiting any
+ * part of an already-read capture costs at most @ref IndexStride
+ * record headers.  Seeking past the parsed frontier extends the index
+ * on the way.  The index holds 16 bytes per checkpoint — about 16 MB
+ * for a billion-record capture.
  *
  * @par Source requirements
  * The input must be a sized, seekable device (a @ref File or an
@@ -118,6 +141,11 @@ struct PcapRecord {
  *         if(err.isError()) break; // truncated or corrupt
  *         // rec.linkType / rec.frame ready to hand to the demux
  * }
+ *
+ * // Later: revisit the 1000th record without re-reading the file.
+ * if(reader.seekRecord(999).isOk()) {
+ *         auto [again, err] = reader.next();
+ * }
  * @endcode
  */
 class PcapReader {
@@ -143,6 +171,13 @@ class PcapReader {
                 static constexpr uint32_t PngBlockSpb = 0x00000003u; ///< Simple Packet Block.
                 static constexpr uint32_t PngBlockEpb = 0x00000006u; ///< Enhanced Packet Block.
 
+                /// @brief Records between seek-index checkpoints.
+                static constexpr size_t IndexStride = 64;
+
+                /// @brief Bytes of a mapped capture kept resident behind
+                ///        the parse cursor before older pages are dropped.
+                static constexpr size_t ReleaseWindow = 64u * 1024u * 1024u;
+
                 /** @brief Constructs an unopened reader. */
                 PcapReader() = default;
 
@@ -164,6 +199,10 @@ class PcapReader {
 
                 /**
                  * @brief Convenience: open a capture file by path.
+                 *
+                 * Maps the file with @ref openMapped when possible and
+                 * otherwise reads it whole via @ref open.
+                 *
                  * @param path Filesystem (or resource) path to a
                  *             @c .pcap / @c .pcapng file.
                  * @return As @ref open, plus @c Error::OpenFailed if the
@@ -171,6 +210,24 @@ class PcapReader {
                  */
                 Error openFile(const String &path);
 
+                /**
+                 * @brief Open a capture file by mapping it read-only.
+                 *
+                 * The file is not read up front; pages are faulted in
+                 * as records are parsed.  Every yielded
+                 * @ref PcapRecord::frame aliases the mapping.  The file
+                 * descriptor is closed before returning — the mapping
+                 * outlives it.
+                 *
+                 * @param path Filesystem path to a @c .pcap / @c .pcapng file.
+                 * @return @c Error::Ok; @c Error::OpenFailed if the file
+                 *         cannot be opened; @c Error::NotSupported for a
+                 *         resource path, an empty file, or a platform
+                 *         without @c mmap; a system error if the mapping
+                 *         fails; or a header error as for @ref open.
+                 */
+                Error openMapped(const String &path);
+
                 /**
                  * @brief Parse a capture already resident in memory.
                  *
@@ -185,6 +242,9 @@ class PcapReader {
                 /** @brief True once a container header has been parsed. */
                 bool isOpen() const { return _format != PcapFileFormat::Unknown; }
 
+                /** @brief True when the capture is a file mapping rather than an in-memory image. */
+                bool isMapped() const { return _mapped; }
+
                 /** @brief The detected container format. */
                 PcapFileFormat format() const { return _format; }
 
@@ -224,6 +284,33 @@ class PcapReader {
                  */
                 Result<PcapRecord> next();
 
+                /**
+                 * @brief Zero-based index of the record the next call to
+                 *        @ref next will yield.
+                 */
+                uint64_t recordIndex() const { return _record; }
+
+                /**
+                 * @brief Position the reader so @ref next yields record
+                 *        @p index.
+                 *
+                 * Backward seeks, and forward seeks over already-parsed
+                 * records, restart from the nearest index checkpoint;
+                 * seeks past the parsed frontier parse forward,
+                 * extending the index.
+                 *
+                 * @param index Zero-based record number.
+                 * @return @c Error::Ok; @c Error::NotOpen if no capture is
+                 *         open; or the error @ref next hit on the way —
+                 *         @c Error::EndOfFile when the capture holds
+                 *         fewer than @p index records (seeking to exactly
+                 *         the record count is valid; @ref next then
+                 *         reports @c Error::EndOfFile).  On error the reader
+                 *         is left wherever parsing stopped and
+                 *         @ref recordIndex reports how far it got.
+                 */
+                Error seekRecord(uint64_t index);
+
                 /** @brief Resets the reader to the unopened state. */
                 void close();
 
@@ -239,14 +326,32 @@ class PcapReader {
                                 uint8_t tsResolCode = 6;
                 };
 
+                /// @brief Seek-index entry: where record
+                ///        @c n*IndexStride starts and which section's
+                ///        state applies there.
+                struct Checkpoint {
+                                uint64_t offset = 0;         ///< Byte offset of the record / packet block.
+                                uint32_t section = 0;        ///< pcapng section ordinal.
+                                uint32_t interfaceCount = 0; ///< Interfaces defined before the record.
+                };
+
+                /// @brief pcapng section state captured for checkpoints.
+                struct Section {
+                                bool bigEndian = false;
+                                List<Interface> interfaces; ///< Longest table seen at a checkpoint.
+                };
+
                 Error parseHeader();
                 Error parseClassicHeader();
                 Error parsePcapngFirstSection();
                 Result<PcapRecord> nextClassic();
                 Result<PcapRecord> nextPcapng();
                 Error consumePcapngIdb(size_t bodyOff, size_t bodyLen);
+                void noteRecord(size_t offset);
+                void restoreCheckpoint(size_t cp);
+                void releaseBehind();
 
-                Buffer _backing;                  ///< Whole-file image; frames view into this.
+                Buffer _backing;                  ///< Whole-file image or mapping; frames view into this.
                 size_t _pos = 0;                  ///< Parse cursor into @ref _backing.
                 size_t _size = 0;                 ///< Logical size of @ref _backing.
                 PcapFileFormat _format = PcapFileFormat::Unknown;
@@ -256,6 +361,12 @@ class PcapReader {
                 uint32_t _snaplen = 0;            ///< Classic global snaplen.
                 PcapLinkType _classicLink = PcapLinkType::Ethernet;
                 List<Interface> _interfaces;      ///< pcapng interface table for the current section.
+                bool _mapped = false;             ///< @ref _backing is a file mapping.
+                size_t _released = 0;             ///< Mapped bytes below this offset have been dropped.
+                uint64_t _record = 0;             ///< Index of the next record @ref next yields.
+                uint32_t _section = 0;            ///< Ordinal of the pcapng section being parsed.
+                List<Checkpoint> _index;          ///< One entry per @ref IndexStride records parsed.
+                List<Section> _sections;          ///< Section state referenced by @ref _index.
 };
 
 PROMEKI_NAMESPACE_END
@@ -279,6 +279,23 @@ class QuickTime {
                                 Buffer data;             ///< Raw encoded payload bytes.
                 };
 
+                /**
+                 * @brief Counters for a reader's sample read-ahead cache.
+                 *
+                 * See @ref Impl::setReadahead.  A hit is a sample read
+                 * served entirely from prefetched bytes; a miss went to
+                 * the device.  Counters restart whenever read-ahead is
+                 * configured.
+                 */
+                struct ReadaheadStats {
+                                uint64_t hits = 0;          ///< Sample reads served from the cache.
+                                uint64_t misses = 0;        ///< Sample reads that went to the device.
+                                uint64_t reads = 0;         ///< Prefetch reads issued.
+                                uint64_t bytesRead = 0;     ///< Bytes requested by prefetch reads.
+                                uint64_t invalidations = 0; ///< Times pending read-ahead was dropped.
+                                uint64_t cachedBytes = 0;   ///< Bytes currently held by the cache.
+                };
+
                 /**
                  * @brief Abstract backend for a QuickTime instance.
                  *
@@ -357,6 +374,43 @@ class QuickTime {
                                 virtual Error readSampleRange(size_t trackIndex, uint64_t startSampleIndex,
                                                               uint64_t count, Sample &out);
 
+                                /**
+                                 * @brief Configures sample read-ahead for a reader.
+                                 *
+                                 * Reads of the first video track act as the
+                                 * playhead.  The reader uses the sample tables
+                                 * to find every track's samples (video, audio,
+                                 * timecode, ancillary) within the next
+                                 * @p frames frames in the direction of play,
+                                 * merges them into large reads along their
+                                 * on-disk chunks, and issues those
+                                 * asynchronously.  Later @c readSample /
+                                 * @c readSampleRange calls that land inside
+                                 * prefetched bytes are served from memory.
+                                 * Reverse play is detected from the playhead
+                                 * and prefetches backwards; a jump out of the
+                                 * window drops pending reads.
+                                 *
+                                 * @param frames   Frames to read ahead; 0 disables.
+                                 * @param maxBytes Cache budget; the window is
+                                 *                 shortened to fit.
+                                 * @return Error::Ok, @c NotOpen before open, or
+                                 *         @c NotSupported for writers and for
+                                 *         files without a video track.
+                                 */
+                                virtual Error setReadahead(uint32_t frames, uint64_t maxBytes);
+
+                                /**
+                                 * @brief Drops all read-ahead state.
+                                 *
+                                 * Call after a seek so the next read starts a
+                                 * fresh window at the new position.
+                                 */
+                                virtual void invalidateReadahead();
+
+                                /** @brief Returns the read-ahead counters. */
+                                virtual ReadaheadStats readaheadStats() const;
+
                                 /**
                                  * @brief Adds a video track to a writer.
                                  *
@@ -607,6 +661,17 @@ class QuickTime {
                         return d.modify()->readSampleRange(trackIndex, startSampleIndex, count, out);
                 }
 
+                /** @brief Configures sample read-ahead (readers only). */
+                Error setReadahead(uint32_t frames, uint64_t maxBytes) {
+                        return d.modify()->setReadahead(frames, maxBytes);
+                }
+
+                /** @brief Drops all read-ahead state, e.g. after a seek. */
+                void invalidateReadahead() { d.modify()->invalidateReadahead(); }
+
+                /** @brief Returns the read-ahead counters. */
+                ReadaheadStats readaheadStats() const { return d->readaheadStats(); }
+
                 /** @brief Adds a video track to the writer. */
                 Error addVideoTrack(const PixelFormat &codec, const Size2Du32 &size, const FrameRate &frameRate,
                                     uint32_t *outTrackId = nullptr) {
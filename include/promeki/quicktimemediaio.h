@@ -61,6 +61,16 @@ PROMEKI_NAMESPACE_BEGIN
  * | @ref MediaConfig::QuickTimeLayout         | Enum (QuickTimeLayout) | Classic | Writer on-disk layout. |
  * | @ref MediaConfig::QuickTimeFragmentFrames | int                    | 30 | Video frames per fragment (Fragmented layout only). |
  * | @ref MediaConfig::QuickTimeFlushSync      | bool                   | false | fdatasync after every flush. |
+ * | @ref MediaConfig::QuickTimeReadaheadFrames | int                   | 8 | Frames prefetched ahead (0 = off). |
+ * | @ref MediaConfig::QuickTimeReadaheadMiB   | int                    | 256 | Read-ahead cache budget in MiB. |
+ *
+ * @par Read-ahead
+ * On read, the engine reader prefetches the samples of every track for
+ * the next @ref MediaConfig::QuickTimeReadaheadFrames video frames in
+ * the current play direction, as a few large asynchronous reads, and
+ * serves the per-frame sample reads from memory.  A seek drops pending
+ * prefetches.  The cache's effectiveness is reported through the
+ * @c StatsReadahead* keys of @ref MediaIOStats.
  *
  * @par Threading
  * Runs on a per-instance dedicated worker thread inherited from
@@ -73,6 +83,30 @@ class QuickTimeMediaIO : public DedicatedThreadMediaIO {
                 /** @brief Default number of video frames per fragment. */
                 static inline constexpr int DefaultFragmentFrames = 30;
 
+                /** @brief Default number of frames prefetched ahead of playback. */
+                static inline constexpr int DefaultReadaheadFrames = 8;
+
+                /** @brief Default read-ahead cache budget in MiB. */
+                static inline constexpr int DefaultReadaheadMiB = 256;
+
+                /** @brief int64_t — sample reads served from the read-ahead cache. */
+                static inline const MediaIOStats::ID StatsReadaheadHits{"ReadaheadHits"};
+
+                /** @brief int64_t — sample reads that missed the cache and went to the file. */
+                static inline const MediaIOStats::ID StatsReadaheadMisses{"ReadaheadMisses"};
+
+                /** @brief int64_t — prefetch reads issued. */
+                static inline const MediaIOStats::ID StatsReadaheadReads{"ReadaheadReads"};
+
+                /** @brief int64_t — bytes requested by prefetch reads. */
+                static inline const MediaIOStats::ID StatsReadaheadBytes{"ReadaheadBytes"};
+
+                /** @brief int64_t — bytes currently held by the read-ahead cache. */
+                static inline const MediaIOStats::ID StatsReadaheadCachedBytes{"ReadaheadCachedBytes"};
+
+                /** @brief int64_t — times pending read-ahead was dropped by a seek. */
+                static inline const MediaIOStats::ID StatsReadaheadInvalidations{"ReadaheadInvalidations"};
+
                 /** @brief Constructs a QuickTimeMediaIO. */
                 QuickTimeMediaIO(ObjectBase *parent = nullptr);
 
@@ -87,6 +121,7 @@ class QuickTimeMediaIO : public DedicatedThreadMediaIO {
                 Error executeCmd(MediaIOCommandRead &cmd) override;
                 Error executeCmd(MediaIOCommandWrite &cmd) override;
                 Error executeCmd(MediaIOCommandSeek &cmd) override;
+                Error executeCmd(MediaIOCommandStats &cmd) override;
 
         private:
                 // True when @p pd is a PixelFormat this writer knows how
@@ -517,6 +517,14 @@ class RtpMediaIO : public DedicatedThreadMediaIO {
                  *         rather than emit a now-stale bundle).  Summed across
                  *         reader streams. */
                 static inline const MediaIOStats::ID StatsRxFramesDroppedSsrcReset{"RxFramesDroppedSsrcReset"};
+                /** @brief int64_t — raw (RFC 4175) video frames emitted with at least
+                 *         one line not fully received.  The missing bytes are
+                 *         zero-filled.  Summed across reader streams. */
+                static inline const MediaIOStats::ID StatsRxFramesIncomplete{"RxFramesIncomplete"};
+                /** @brief int64_t — cumulative count of raw video lines that were not
+                 *         fully received when their frame was emitted.  Summed across
+                 *         reader streams. */
+                static inline const MediaIOStats::ID StatsRxLinesMissing{"RxLinesMissing"};
 
                 /** @brief int64_t — cumulative count of SRs the receive thread has
                  *         parsed across every active reader-side RtpSession.  Zero
@@ -1037,7 +1045,9 @@ class RtpMediaIO : public DedicatedThreadMediaIO {
                                       framesReassembled(o.framesReassembled.value()),
                                       framesDroppedValidate(o.framesDroppedValidate.value()),
                                       framesWaitingParamSets(o.framesWaitingParamSets.value()),
-                                      framesDroppedSsrcReset(o.framesDroppedSsrcReset.value()) {}
+                                      framesDroppedSsrcReset(o.framesDroppedSsrcReset.value()),
+                                      framesIncomplete(o.framesIncomplete.value()),
+                                      linesMissing(o.linesMissing.value()) {}
                                 ReaderStream(const ReaderStream &) = delete;
                                 ReaderStream &operator=(const ReaderStream &) = delete;
                                 ReaderStream &operator=(ReaderStream &&) = delete;
@@ -1213,6 +1223,19 @@ class RtpMediaIO : public DedicatedThreadMediaIO {
                                 ///        stale bundle.  Surfaced through
                                 ///        @ref StatsRxFramesDroppedSsrcReset.
                                 Atomic<int64_t> framesDroppedSsrcReset{0};
+
+                                /// @brief Cumulative count of raw video
+                                ///        frames emitted with one or
+                                ///        more lines not fully
+                                ///        received.  Surfaced through
+                                ///        @ref StatsRxFramesIncomplete.
+                                Atomic<int64_t> framesIncomplete{0};
+
+                                /// @brief Cumulative count of raw video
+                                ///        lines not fully received.
+                                ///        Surfaced through
+                                ///        @ref StatsRxLinesMissing.
+                                Atomic<int64_t> linesMissing{0};
                 };
 
                 /**
@@ -1753,6 +1776,7 @@ class RtpMediaIO : public DedicatedThreadMediaIO {
                 // ST 2110-10 / RFC 4570 / RFC 5888 session-level state.
                 String        _rtpSourceAddress; ///< @brief Source IP for SDP @c source-filter (RFC 4570).
                 bool          _rtpDontFragment = true; ///< @brief Assert IP DF on egress sockets (ST 2110-10 §6.3).
+                bool          _rtpZeroCopy = false;    ///< @brief Send with @c MSG_ZEROCOPY on egress sockets.
 
                 // Runtime
                 FrameRate  _frameRate;
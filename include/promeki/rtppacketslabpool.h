@@ -0,0 +1,174 @@
+/**
+ * @file      rtppacketslabpool.h
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#pragma once
+
+
+#include <promeki/config.h>
+#if PROMEKI_ENABLE_NETWORK
+#include <cstddef>
+#include <cstdint>
+#include <promeki/namespace.h>
+#include <promeki/buffer.h>
+#include <promeki/list.h>
+
+PROMEKI_NAMESPACE_BEGIN
+
+/**
+ * @brief Recycling pool of receive slabs for batched RTP ingest.
+ * @ingroup network
+ *
+ * A slab is one @ref Buffer sized for @ref packetsPerSlab datagrams of
+ * up to @ref packetStride bytes each.  The receive loop hands a slab's
+ * packet slots to @ref PacketTransport::receivePackets, then wraps each
+ * received datagram in an @ref RtpPacket view of the slab at
+ * @c index @c * @c packetStride.  Those views share the slab's
+ * @ref BufferImpl, so the slab stays alive for as long as any packet
+ * carved from it is still queued in a reorder buffer or depacketizer.
+ *
+ * @ref acquire returns a slab nobody else references any more — i.e.
+ * every packet view handed out from it has been dropped — so a
+ * steady-state receive loop cycles through a fixed set of slabs and
+ * makes no heap allocations.  Slabs are only allocated when every
+ * pooled slab is still pinned by downstream consumers, up to
+ * @ref maxSlabs; past that, acquire() hands out an untracked one-off
+ * slab so a stalled consumer degrades into the old per-packet
+ * allocation behavior instead of growing the pool without bound.
+ *
+ * A receive loop whose batches come back short should use
+ * @ref fillSlab / @ref commitSlots instead of @ref acquire: the same
+ * slab keeps taking datagrams until every slot is used, so a slab
+ * pins a run of consecutive packets rather than one short batch and
+ * the packets held downstream need only about
+ * @ref slabsForPackets of them.  Size @ref maxSlabs from the number
+ * of packets the consumers can hold at once — packets per frame
+ * times frames in flight — or a high-rate stream outgrows the pool
+ * and lives on overflow slabs.
+ *
+ * @par Thread Safety
+ * Conditionally thread-safe.  A pool is owned by a single receive
+ * thread; @ref acquire / @ref stats must not be called concurrently.
+ * Downstream threads may drop packet views at any time — the
+ * "is this slab free" test is the @ref Buffer reference count, which
+ * is atomic.
+ *
+ * @par Example
+ * @code
+ * RtpPacketSlabPool pool(32, 2048);
+ * Buffer slab = pool.acquire();
+ * uint8_t *base = static_cast<uint8_t *>(slab.data());
+ * // ... receive into base + i * pool.packetStride() ...
+ * RtpPacket pkt(slab, i * pool.packetStride(), n);
+ * @endcode
+ */
+class RtpPacketSlabPool {
+        public:
+                /** @brief Default cap on pooled slabs (16 MiB at the default geometry). */
+                static constexpr size_t DefaultMaxSlabs = 256;
+
+                /**
+                 * @brief Returns the slab cap that keeps @p packets retained packets pooled.
+                 *
+                 * With slabs filled back to back, a run of retained
+                 * packets covers whole slabs plus a partly released
+                 * one at the old end and the slab still being filled
+                 * at the new end.
+                 *
+                 * @param packets        Packets consumers may hold at once.
+                 * @param packetsPerSlab Datagram slots per slab.
+                 * @return The number of slabs to pass as @c maxSlabs.
+                 */
+                static size_t slabsForPackets(size_t packets, size_t packetsPerSlab) {
+                        if (packetsPerSlab == 0) return DefaultMaxSlabs;
+                        return (packets + packetsPerSlab - 1) / packetsPerSlab + 2;
+                }
+
+                /** @brief Plain-value snapshot of the pool counters. */
+                struct Stats {
+                                uint64_t reused = 0;    ///< Acquires served by a recycled slab.
+                                uint64_t allocated = 0; ///< Slabs allocated into the pool.
+                                uint64_t overflow = 0;  ///< One-off slabs handed out past @ref maxSlabs.
+                };
+
+                /**
+                 * @brief Constructs a pool of @p packetsPerSlab × @p packetStride byte slabs.
+                 * @param packetsPerSlab Datagram slots per slab.
+                 * @param packetStride   Bytes reserved per datagram slot.
+                 * @param maxSlabs       Upper bound on pooled slabs.
+                 */
+                RtpPacketSlabPool(size_t packetsPerSlab, size_t packetStride, size_t maxSlabs = DefaultMaxSlabs);
+
+                RtpPacketSlabPool(const RtpPacketSlabPool &) = delete;
+                RtpPacketSlabPool &operator=(const RtpPacketSlabPool &) = delete;
+
+                /** @brief Returns the number of datagram slots per slab. */
+                size_t packetsPerSlab() const { return _packetsPerSlab; }
+
+                /** @brief Returns the bytes reserved per datagram slot. */
+                size_t packetStride() const { return _packetStride; }
+
+                /** @brief Returns the size of one slab in bytes. */
+                size_t slabBytes() const { return _packetsPerSlab * _packetStride; }
+
+                /** @brief Returns the cap on pooled slabs. */
+                size_t maxSlabs() const { return _maxSlabs; }
+
+                /** @brief Returns the number of slabs currently owned by the pool. */
+                size_t slabCount() const { return _slabs.size(); }
+
+                /**
+                 * @brief Returns a slab with no outstanding packet views.
+                 * @return A slab of @ref slabBytes, or an invalid Buffer if
+                 *         allocation failed.
+                 */
+                Buffer acquire();
+
+                /**
+                 * @brief Returns the slab the next datagrams should land in.
+                 *
+                 * Hands back the same slab until @ref commitSlots has
+                 * used all of its slots, then moves on to a slab from
+                 * @ref acquire.
+                 *
+                 * @param[out] firstSlot Index of the first unused slot.
+                 * @return The fill slab, or an invalid Buffer if
+                 *         allocation failed.
+                 */
+                Buffer fillSlab(size_t &firstSlot);
+
+                /**
+                 * @brief Marks @p count slots of the fill slab as used.
+                 * @param count Datagrams received into the slab from
+                 *              the slot @ref fillSlab reported.
+                 */
+                void commitSlots(size_t count);
+
+                /**
+                 * @brief Returns the pool counters.
+                 * @return A snapshot of the counters.
+                 */
+                Stats stats() const { return _stats; }
+
+                /** @brief Drops every pooled slab (outstanding views keep theirs alive). */
+                void clear();
+
+        private:
+                size_t       _packetsPerSlab = 0;
+                size_t       _packetStride = 0;
+                size_t       _maxSlabs = 0;
+                size_t       _cursor = 0;
+                size_t       _fillUsed = 0;
+                Buffer       _fill;
+                List<Buffer> _slabs;
+                Stats        _stats;
+
+                Buffer allocateSlab() const;
+};
+
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_NETWORK
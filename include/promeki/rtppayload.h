@@ -61,6 +61,31 @@ class RtpPayload {
                  */
                 virtual RtpPacket::List pack(const void *mediaData, size_t size) = 0;
 
+                /**
+                 * @brief Fragments a range of a Buffer into RTP payload packets.
+                 *
+                 * Same wire result as @ref pack, but payloads that can
+                 * avoid copying the media bytes override this to emit
+                 * multi-slice packets: slice 0 holds the RTP and
+                 * payload headers, the following slices reference
+                 * @p buf directly.  Such packets keep @p buf alive for
+                 * as long as they exist, and are meant to be handed
+                 * straight to a transport as scatter-gather datagrams —
+                 * @ref RtpPacket::payload only sees the first slice.
+                 *
+                 * The default implementation calls @ref pack on the
+                 * host pointer, producing ordinary contiguous packets.
+                 *
+                 * @param buf    The buffer holding the media data.
+                 * @param offset Byte offset of the media data within @p buf.
+                 * @param size   Size of the media data in bytes.
+                 * @return List of RtpPackets.
+                 */
+                virtual RtpPacket::List packBuffer(const Buffer &buf, size_t offset, size_t size) {
+                        const uint8_t *base = static_cast<const uint8_t *>(buf.data());
+                        return pack(base != nullptr ? base + offset : nullptr, size);
+                }
+
                 /**
                  * @brief Reassembles RTP payload packets into media data.
                  * @param packets The list of packets to reassemble.
@@ -365,6 +390,15 @@ class RtpPayloadJson : public RtpPayload {
  * +---------+---------+---------+---------+
  * @endcode
  *
+ * @par Restart markers
+ * A JPEG with a DRI segment (e.g. a @ref JpegVideoEncoder frame
+ * encoded with @ref MediaConfig::JpegThreads above 1) is sent as
+ * type 64 / 65.  Each packet then carries the 4-byte Restart Marker
+ * Header after the main header, with F = L = 1 and a count of 0x3FFF
+ * because fragments are cut by size rather than on restart
+ * boundaries.  @ref unpack rebuilds the DRI segment so the RSTn
+ * markers in the scan stay valid.
+ *
  * @par Example
  * @code
  * RtpPayloadJpeg payload(1920, 1080);
@@ -15,6 +15,7 @@
 #include <promeki/buffer.h>
 #include <promeki/enums_st2110.h>
 #include <promeki/enums_video.h>
+#include <promeki/list.h>
 #include <promeki/namespace.h>
 #include <promeki/rtppacket.h>
 #include <promeki/rtppayload.h>
@@ -247,9 +248,165 @@ class RtpPayloadRawVideo : public RtpPayload {
                 uint32_t clockRate() const override { return ClockRate; }
                 /** @copydoc RtpPayload::pack() */
                 RtpPacket::List pack(const void *mediaData, size_t size) override;
+
+                /**
+                 * @brief Packs a frame without copying its sample data.
+                 *
+                 * Emits the same packets as @ref pack, byte for byte,
+                 * but each packet is scattered: slice 0 is the RTP
+                 * header, Extended Sequence Number and SRD Headers in
+                 * a small per-frame header Buffer, and the remaining
+                 * slices point at the SRD sample data inside @p buf
+                 * (plus a shared zero run for BPM padding).  A packet
+                 * never has more than
+                 * @c 1 + MaxSrdsPerPacket + 1 slices; contiguous SRD
+                 * data runs are merged into one slice.
+                 *
+                 * Falls back to @ref pack when @p buf is not host
+                 * accessible.
+                 *
+                 * @param buf    The buffer holding the frame (typically plane 0).
+                 * @param offset Byte offset of the frame within @p buf.
+                 * @param size   Size of the frame in bytes.
+                 * @return List of multi-slice RtpPackets.
+                 */
+                RtpPacket::List packBuffer(const Buffer &buf, size_t offset, size_t size) override;
                 /** @copydoc RtpPayload::unpack() */
                 Buffer unpack(const RtpPacket::List &packets) override;
 
+                /**
+                 * @brief In-place reassembly state for one raw video frame.
+                 *
+                 * Lets a receiver write each packet's SRD sample data
+                 * straight into the frame's final plane as packets
+                 * arrive (see @ref unpackInto), instead of collecting
+                 * the packet list and copying it out in @ref unpack.
+                 *
+                 * Alongside the plane it keeps a per-line coverage
+                 * bitmap: a line's bit is set once every byte of the
+                 * line has been received.  @ref finish zero-fills
+                 * whatever was not received — whole missing lines,
+                 * holes left by lost fragments, the tail of a
+                 * truncated line — so the emitted plane matches what
+                 * @ref unpack would have produced from the same
+                 * packets without first clearing the whole frame.
+                 *
+                 * Senders emit a line's fragments in offset order, so
+                 * holes are detected as they appear: a fragment that
+                 * starts past the line's contiguous fill point zeroes
+                 * the gap before writing.
+                 */
+                class FrameAssembly {
+                        public:
+                                FrameAssembly() = default;
+
+                                /**
+                                 * @brief Starts a new frame.
+                                 * @param plane        Destination plane; at least
+                                 *                     @p lineCount × @p bytesPerLine
+                                 *                     bytes of host memory.
+                                 * @param lineCount    Wire rows in the frame.
+                                 * @param bytesPerLine Bytes per wire row.
+                                 */
+                                void begin(Buffer plane, size_t lineCount, size_t bytesPerLine);
+
+                                /** @brief Returns true between @ref begin and @ref finish / @ref clear. */
+                                bool isActive() const { return _plane.isValid(); }
+
+                                /**
+                                 * @brief Copies @p size bytes into @p line at byte @p offset.
+                                 *
+                                 * A write that runs past the end of @p line
+                                 * continues at the start of the next line, the
+                                 * way a flat frame buffer would; bytes past the
+                                 * last line are dropped.  Duplicate fragments
+                                 * count toward coverage twice, so a line that
+                                 * received a retransmit may report complete
+                                 * with a hole — the hole is still zero-filled.
+                                 */
+                                void write(size_t line, size_t offset, const uint8_t *src, size_t size);
+
+                                /**
+                                 * @brief Zero-fills unreceived bytes and hands off the plane.
+                                 * @return The plane passed to @ref begin, or an invalid
+                                 *         Buffer when no frame is active.  Coverage
+                                 *         queries remain valid until the next
+                                 *         @ref begin.
+                                 */
+                                Buffer finish();
+
+                                /** @brief Abandons the frame in progress. */
+                                void clear();
+
+                                /** @brief Returns the number of wire rows in the frame. */
+                                size_t lineCount() const { return _lines.size(); }
+
+                                /** @brief Returns the bytes per wire row. */
+                                size_t bytesPerLine() const { return _bytesPerLine; }
+
+                                /** @brief Returns true if every byte of @p line was received. */
+                                bool isLineComplete(size_t line) const {
+                                        return line < _lines.size() && (_complete[line / 64] >> (line % 64)) & 1u;
+                                }
+
+                                /** @brief Returns the per-line coverage bitmap, 64 lines per word. */
+                                const List<uint64_t> &coverage() const { return _complete; }
+
+                                /** @brief Returns the number of fully received lines. */
+                                size_t completeLines() const { return _completeLines; }
+
+                                /** @brief Returns the number of lines with at least one missing byte. */
+                                size_t missingLines() const { return _lines.size() - _completeLines; }
+
+                                /** @brief Returns true if every line was fully received. */
+                                bool isComplete() const { return _completeLines == _lines.size(); }
+
+                        private:
+                                /** @brief Per-line reception state. */
+                                struct Line {
+                                                uint32_t filled = 0;   ///< Contiguous fill point from offset 0.
+                                                uint32_t received = 0; ///< Bytes written (for completeness).
+                                };
+
+                                Buffer         _plane;
+                                uint8_t       *_data = nullptr;
+                                size_t         _bytesPerLine = 0;
+                                size_t         _completeLines = 0;
+                                List<Line>     _lines;
+                                List<uint64_t> _complete;
+                };
+
+                /**
+                 * @brief Returns the size of one reassembled frame in bytes.
+                 *
+                 * Wire rows (@c height / @ref rowsPerSrd) times bytes
+                 * per wire row — the size of the Buffer @ref unpack
+                 * returns and of the plane @ref unpackInto expects.
+                 */
+                size_t frameSize() const { return wireBytesPerLine() * wireLineCount(); }
+
+                /** @brief Returns the number of bytes in one wire row. */
+                size_t wireBytesPerLine() const {
+                        return static_cast<size_t>(_width) * static_cast<size_t>(_bitsPerPixel) / 8;
+                }
+
+                /** @brief Returns the number of wire rows per frame. */
+                size_t wireLineCount() const { return static_cast<size_t>(_height / _rowsPerSrd); }
+
+                /**
+                 * @brief Writes one packet's SRD sample data into an active assembly.
+                 *
+                 * Applies the same SRD walk and field / segment row
+                 * mapping as @ref unpack.  @p frame must have been
+                 * started with @ref wireLineCount lines of
+                 * @ref wireBytesPerLine bytes.
+                 *
+                 * @param pkt   The received packet.
+                 * @param frame The frame being assembled.
+                 * @return The number of sample bytes written.
+                 */
+                size_t unpackInto(const RtpPacket &pkt, FrameAssembly &frame) const;
+
                 /** @brief Sets the RTP payload type number. */
                 void setPayloadType(uint8_t pt) { _payloadType = pt; }
 
@@ -408,6 +565,8 @@ class RtpPayloadRawVideo : public RtpPayload {
                 bool              _fieldBit = false;
                 St2110PackingMode _packingMode = St2110PackingMode::Gpm;
                 VideoScanMode     _scanMode = VideoScanMode::Progressive;
+
+                RtpPacket::List packImpl(const uint8_t *src, size_t size, const Buffer *srcBuf, size_t srcBase);
 };
 
 PROMEKI_NAMESPACE_END
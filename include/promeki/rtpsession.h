@@ -391,6 +391,27 @@ class RtpSession : public ObjectBase {
                 /** @brief Returns the receive-loop poll interval. */
                 unsigned int receivePollIntervalMs() const { return _receivePollMs; }
 
+                /**
+                 * @brief Sets how many received packets consumers may hold at once.
+                 *
+                 * Received packets are views of the receive thread's
+                 * slabs, so a slab stays pinned while any of its
+                 * packets sits in a reorder buffer, a depacketizer
+                 * queue or a frame being reassembled.  The slab pool
+                 * cap is derived from this budget — size it as the
+                 * stream's packets per frame times the frames in
+                 * flight.  Zero keeps
+                 * @ref RtpPacketSlabPool::DefaultMaxSlabs, which is
+                 * far too few for raw UHD video.  Must be set before
+                 * @ref startReceiving.
+                 *
+                 * @param packets Packets held downstream at most.
+                 */
+                void setReceivePacketBudget(size_t packets) { _receivePacketBudget = packets; }
+
+                /** @brief Returns the receive packet budget (0 = pool default). */
+                size_t receivePacketBudget() const { return _receivePacketBudget; }
+
                 /**
                  * @brief Applies a transmit-rate cap to the bound scheduler.
                  *
@@ -925,6 +946,7 @@ class RtpSession : public ObjectBase {
                 List<StreamReceiver> _streamReceivers;
                 Atomic<bool>         _receiving;
                 unsigned int         _receivePollMs = 200;
+                size_t               _receivePacketBudget = 0;
 
                 // Per-stream-receiver SSRC pin state.  Sized to
                 // match @c _streamReceivers.size() at
@@ -25,6 +25,7 @@
 #include <promeki/rtpdepacketizerthread.h>
 #include <promeki/rtppacket.h>
 #include <promeki/rtppayload.h>
+#include <promeki/rtppayloadrawvideo.h>
 #include <promeki/rtpstreamclock.h>
 #include <promeki/rxpayloadbundle.h>
 #include <promeki/string.h>
@@ -113,6 +114,8 @@ struct RtpVideoDepacketizerContext {
                 Atomic<int64_t> *framesDroppedValidate = nullptr;
                 Atomic<int64_t> *framesWaitingParamSets = nullptr;
                 Atomic<int64_t> *framesDroppedSsrcReset = nullptr;
+                Atomic<int64_t> *framesIncomplete = nullptr;
+                Atomic<int64_t> *linesMissing = nullptr;
 
                 /// @brief Diagnostic histograms — non-owning
                 ///        pointers.  May be @c nullptr in tests.
@@ -120,6 +123,16 @@ struct RtpVideoDepacketizerContext {
                 Histogram *rxFrameInterval = nullptr;
                 Histogram *rxFrameAssembleTime = nullptr;
 
+                /// @brief Allocates the destination plane for a raw
+                ///        (RFC 4175) frame.  Called with the frame's
+                ///        wire size on the first packet of each
+                ///        frame; SRD sample data is written straight
+                ///        into the returned Buffer and that Buffer
+                ///        becomes the emitted payload's plane.  May
+                ///        be @c nullptr, in which case a plain heap
+                ///        Buffer is used.
+                Function<Buffer(size_t)> allocatePlane;
+
                 /// @brief Bumps the @c FrameCount on the owning
                 ///        ReaderStream.  May be @c nullptr.
                 Function<void()> noteFrameReceived;
@@ -148,6 +161,13 @@ struct RtpVideoDepacketizerContext {
  * an @ref RxVideoFrame onto the per-stream payload queue the
  * @ref RtpAggregatorThread drains.
  *
+ * Raw RFC 4175 streams skip the packet list entirely: each packet's
+ * sample data is written into the frame's final plane as it arrives
+ * (see @ref RtpPayloadRawVideo::FrameAssembly), and the plane is
+ * handed to the payload on the marker bit without a reassembly copy.
+ * Lines that never fully arrived are zero-filled and counted in
+ * @c framesIncomplete / @c linesMissing.
+ *
  * @par Threading
  * Runs on its own worker thread.  Reassembly state — including
  * the @ref JpegGeometryProbe cache and per-frame index — lives on
@@ -194,20 +214,27 @@ class RtpVideoDepacketizerThread : public RtpDepacketizerThread {
 
         private:
                 void emitFrame();
-
-                RtpVideoDepacketizerContext _ctx;
-                RtpPacket::List             _reasmPackets;
-                uint32_t                    _reasmTimestamp = 0;
-                bool                        _reasmHasTimestamp = false;
-                TimeStamp                   _frameStartTime;
-                bool                        _hasFrameStart = false;
-                TimeStamp                   _lastPacketTime;
-                bool                        _hasLastPacket = false;
-                TimeStamp                   _lastFrameTime;
-                bool                        _hasLastFrame = false;
-                FrameNumber                 _streamFrameIndex{0};
-                JpegGeometryProbe           _jpegProbe;
-                uint32_t                    _lastEpoch = 0;
+                void handleRawPacket(const RtpPacket &pkt);
+                void resetReassembly();
+                bool hasPendingFrame() const;
+
+                RtpVideoDepacketizerContext       _ctx;
+                RtpPayloadRawVideo               *_raw = nullptr;
+                RtpPayloadRawVideo::FrameAssembly _rawFrame;
+                int32_t                           _rawPacketCount = 0;
+                TimeStamp                         _rawFirstArrival;
+                RtpPacket::List                   _reasmPackets;
+                uint32_t                          _reasmTimestamp = 0;
+                bool                              _reasmHasTimestamp = false;
+                TimeStamp                         _frameStartTime;
+                bool                              _hasFrameStart = false;
+                TimeStamp                         _lastPacketTime;
+                bool                              _hasLastPacket = false;
+                TimeStamp                         _lastFrameTime;
+                bool                              _hasLastFrame = false;
+                FrameNumber                       _streamFrameIndex{0};
+                JpegGeometryProbe                 _jpegProbe;
+                uint32_t                          _lastEpoch = 0;
 };
 
 PROMEKI_NAMESPACE_END
@@ -169,6 +169,20 @@ class SharedMemory {
                  */
                 void close();
 
+                /**
+                 * @brief Removes the region's name now while keeping this mapping.
+                 *
+                 * For owners that must keep the region mapped after the
+                 * name may already be recycled by a new @ref create — a
+                 * late unlink from @ref close would otherwise remove the
+                 * newcomer's name.  After the call @ref isOwner is
+                 * @c false and @ref close only unmaps.  No-op (returning
+                 * @c Error::Ok) when this instance is not the owner.
+                 *
+                 * @return @c Error::Ok on success, or the unlink error.
+                 */
+                Error unlinkName();
+
                 /** @brief Returns true if the region is mapped. */
                 bool isValid() const { return _data != nullptr; }
 
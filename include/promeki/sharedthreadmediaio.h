@@ -116,7 +116,10 @@ class SharedThreadMediaIO : public CommandMediaIO {
                  *
                  * Each instance has its own @ref Strand on top of this
                  * pool, so different MediaIOs run concurrently while
-                 * each instance's own commands stay serialized.
+                 * each instance's own commands stay serialized.  The
+                 * pool uses @ref ThreadPool::Scheduler::WorkStealing,
+                 * so a strand handing itself its next command does not
+                 * take a pool-wide lock.
                  *
                  * @par Sizing
                  *
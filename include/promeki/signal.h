@@ -24,6 +24,60 @@ class ObjectBase;
 class Variant;
 class VariantList;
 
+namespace Detail {
+
+/**
+ * @brief Grace-period gate guarding a @ref Signal's published slot snapshot.
+ * @ingroup events
+ *
+ * Readers bracket the few instructions between loading the
+ * snapshot pointer and taking their reference on it with
+ * @ref enter / @ref leave; a writer that has just unpublished a
+ * snapshot calls @ref synchronize before dropping the
+ * publication reference, which returns once every reader that
+ * could still be holding the bare pointer has left.
+ *
+ * Readers are split across two counters selected by the parity
+ * of an epoch.  @ref synchronize flips the epoch before
+ * draining each counter in turn, so new readers pile onto the
+ * other counter and a steady stream of emitters cannot starve
+ * a writer.  The read side never blocks and never calls into
+ * a slot while inside the gate, so @ref synchronize cannot
+ * deadlock against a slot that connects or disconnects.
+ */
+class SignalReadGate {
+        public:
+                SignalReadGate() = default;
+                SignalReadGate(const SignalReadGate &) = delete;
+                SignalReadGate &operator=(const SignalReadGate &) = delete;
+
+                /** @brief Enters the read side; returns the token to hand to @ref leave. */
+                unsigned int enter() {
+                        unsigned int parity = _epoch.load(MemoryOrder::Acquire) & 1u;
+                        _readers[parity].fetchAndAdd(1, MemoryOrder::SeqCst);
+                        return parity;
+                }
+
+                /** @brief Leaves the read side entered with token @p parity. */
+                void leave(unsigned int parity) {
+                        _readers[parity].fetchAndSub(1, MemoryOrder::Release);
+                        return;
+                }
+
+                /**
+                 * @brief Waits until no reader can still observe a pointer unpublished before this call.
+                 *
+                 * Writers must be serialized by the caller.
+                 */
+                void synchronize();
+
+        private:
+                Atomic<unsigned int> _epoch;
+                Atomic<int>          _readers[2];
+};
+
+} // namespace Detail
+
 /**
  * @brief Type-safe signal/slot mechanism for decoupled event notification.
  * @ingroup events
@@ -34,17 +88,20 @@ class VariantList;
  *
  * @par Thread Safety
  * Thread-safe.  @c connect, @c disconnect, @c disconnectFromObject
- * and @c emit may be invoked concurrently from any thread; an
- * internal @ref Mutex serializes mutations of the slot list, and
- * @c emit takes a snapshot of the slot list under that lock then
- * iterates the snapshot outside the lock.  This means slots fired
- * from a given @c emit reflect the connections that existed when
- * the snapshot was taken — a slot connected from another thread
- * mid-emit is not invoked by that emit, and a slot disconnected
- * mid-emit is invoked exactly once if it was present in the
- * snapshot.  Reentrant @c connect / @c disconnect from inside a
- * slot is safe because the iteration runs against the local
- * snapshot, not the live list.
+ * and @c emit may be invoked concurrently from any thread.  The slot
+ * list is copy-on-write: every mutation builds a new immutable,
+ * refcounted snapshot under an internal @ref Mutex and publishes it
+ * with a single atomic store, while @c emit takes a reference on the
+ * current snapshot without locking and iterates it.  Emitting from
+ * many threads at once therefore never contends on a lock or copies
+ * the slot list; connecting and disconnecting cost one list copy.
+ * Slots fired from a given @c emit reflect the connections that
+ * existed when it took its reference — a slot connected from another
+ * thread mid-emit is not invoked by that emit, and a slot
+ * disconnected mid-emit is invoked exactly once if it was present in
+ * the snapshot.  Reentrant @c connect / @c disconnect from inside a
+ * slot is safe because the iteration runs against the referenced
+ * snapshot, not the one being replaced.
  * Cross-thread delivery is supported by the @c connect(Function,
  * ObjectBase *) overload, which routes invocations through the
  * receiving ObjectBase's EventLoop via @c postCallable; that
@@ -92,6 +149,12 @@ template <typename... Args> class Signal {
                  */
                 Signal(void *owner = nullptr, const char *prototype = nullptr) : _owner(owner), _prototype(prototype) {}
 
+                /** @brief Destructor.  Drops the published slot snapshot. */
+                ~Signal() { Snapshot::release(_snapshot.load(MemoryOrder::Acquire)); }
+
+                Signal(const Signal &) = delete;
+                Signal &operator=(const Signal &) = delete;
+
                 /**
                  * @brief Returns the owner of this signal, or nullptr if not defined
                  */
@@ -118,7 +181,9 @@ template <typename... Args> class Signal {
                 size_t connect(Function slot, void *ptr = nullptr) {
                         size_t slotID = nextSlotId();
                         Mutex::Locker lock(_slotsMutex);
-                        _slots += Info(slotID, slot, ptr);
+                        Snapshot     *next = copySlots();
+                        next->slots += Info(slotID, std::move(slot), ptr);
+                        publish(next);
                         return slotID;
                 }
 
@@ -200,8 +265,11 @@ template <typename... Args> class Signal {
                 template <typename T> size_t connect(T *obj, void (T::*memberFunction)(Args...)) {
                         size_t slotID = nextSlotId();
                         Mutex::Locker lock(_slotsMutex);
-                        _slots += Info(slotID,
-                                       ([obj, memberFunction](Args... args) { (obj->*memberFunction)(args...); }), obj);
+                        Snapshot     *next = copySlots();
+                        next->slots += Info(slotID,
+                                            ([obj, memberFunction](Args... args) { (obj->*memberFunction)(args...); }),
+                                            obj);
+                        publish(next);
                         return slotID;
                 }
 
@@ -217,7 +285,7 @@ template <typename... Args> class Signal {
                  */
                 void disconnect(size_t slotID) {
                         Mutex::Locker lock(_slotsMutex);
-                        _slots.removeIf([slotID](const Info &info) { return info.id == slotID; });
+                        removeSlotsIf([slotID](const Info &info) { return info.id == slotID; });
                         return;
                 }
 
@@ -235,7 +303,7 @@ template <typename... Args> class Signal {
                  */
                 template <typename T> void disconnect(const T *object, void (T::*memberFunction)(Args...)) {
                         Mutex::Locker lock(_slotsMutex);
-                        _slots.removeIf([object, memberFunction](const Info &info) {
+                        removeSlotsIf([object, memberFunction](const Info &info) {
                                 return static_cast<const T *>(info.object) == object && info.func == memberFunction;
                         });
                         return;
@@ -249,11 +317,22 @@ template <typename... Args> class Signal {
                  */
                 template <typename T> void disconnectFromObject(const T *object) {
                         Mutex::Locker lock(_slotsMutex);
-                        _slots.removeIf(
+                        removeSlotsIf(
                                 [object](const Info &info) { return static_cast<const T *>(info.object) == object; });
                         return;
                 }
 
+                /**
+                 * @brief Returns true if at least one slot is connected.
+                 *
+                 * Lets hot-path emitters skip building expensive
+                 * arguments when nobody is listening.  The answer can
+                 * go stale immediately if another thread connects or
+                 * disconnects concurrently.  Lock-free: an empty slot
+                 * list is published as a null snapshot.
+                 */
+                bool isConnected() const { return _snapshot.load(MemoryOrder::Acquire) != nullptr; }
+
                 /**
                  * @brief Emits this signal.
                  *
@@ -263,19 +342,21 @@ template <typename... Args> class Signal {
                  * @param args The arguments to forward to each slot.
                  */
                 void emit(Args... args) const {
-                        // Snapshot under the lock so iteration runs
-                        // against a stable copy.  Concurrent
-                        // connect / disconnect calls only mutate the
-                        // live @c _slots — the snapshot is unaffected,
-                        // which keeps reentrant connect / disconnect
-                        // from a slot safe and matches Boost.Signals2
-                        // semantics.
-                        List<Info> snapshot;
-                        {
-                                Mutex::Locker lock(_slotsMutex);
-                                snapshot = _slots;
-                        }
-                        for (const auto &slot : snapshot) slot.func(args...);
+                        // Nobody listening: one load, no counter
+                        // traffic.  A connect racing with this check
+                        // is indistinguishable from one that landed
+                        // just after the emit.
+                        if (_snapshot.load(MemoryOrder::Relaxed) == nullptr) return;
+                        // Take a reference on the published snapshot
+                        // and iterate it.  Concurrent connect /
+                        // disconnect calls publish a replacement and
+                        // leave this one untouched, which keeps
+                        // reentrant connect / disconnect from a slot
+                        // safe and matches Boost.Signals2 semantics.
+                        Snapshot *snap = acquireSnapshot();
+                        if (snap == nullptr) return;
+                        for (const auto &slot : snap->slots) slot.func(args...);
+                        Snapshot::release(snap);
                         return;
                 }
 
@@ -286,13 +367,85 @@ template <typename... Args> class Signal {
                                 Function    func;
                                 const void *object = nullptr;
 
-                                Info(size_t id, Function f, const void *obj = nullptr) : id(id), func(f), object(obj) {}
+                                Info(size_t id, Function f, const void *obj = nullptr)
+                                    : id(id), func(std::move(f)), object(obj) {}
                 };
 
-                void         *_owner = nullptr;
-                const char   *_prototype = nullptr;
-                List<Info>    _slots;
-                mutable Mutex _slotsMutex;
+                // Immutable once published.  One reference belongs to
+                // _snapshot while it is the published list; each emit
+                // in flight holds another.
+                struct Snapshot {
+                                Atomic<int> refs{1};
+                                List<Info>  slots;
+
+                                static void release(Snapshot *snap) {
+                                        if (snap != nullptr && snap->refs.fetchAndSub(1, MemoryOrder::AcqRel) == 1) {
+                                                delete snap;
+                                        }
+                                        return;
+                                }
+                };
+
+                void                          *_owner = nullptr;
+                const char                    *_prototype = nullptr;
+                Atomic<Snapshot *>             _snapshot;
+                mutable Detail::SignalReadGate _readGate;
+                mutable Mutex                  _slotsMutex;
+
+                // The gate only has to cover the load-then-ref window:
+                // once the reference is taken the snapshot outlives any
+                // replacement, so slots run outside the gate.
+                Snapshot *acquireSnapshot() const {
+                        unsigned int token = _readGate.enter();
+                        Snapshot    *snap = _snapshot.load(MemoryOrder::SeqCst);
+                        if (snap != nullptr) snap->refs.fetchAndAdd(1, MemoryOrder::Relaxed);
+                        _readGate.leave(token);
+                        return snap;
+                }
+
+                // Returns a private copy of the published list.  Caller
+                // holds _slotsMutex.
+                Snapshot *copySlots() const {
+                        Snapshot       *next = new Snapshot;
+                        const Snapshot *cur = _snapshot.load(MemoryOrder::Relaxed);
+                        if (cur != nullptr) next->slots = cur->slots;
+                        return next;
+                }
+
+                // Swaps @p next in (an empty list is published as null)
+                // and drops the old snapshot once no emit can still be
+                // about to reference it.  Caller holds _slotsMutex.
+                void publish(Snapshot *next) {
+                        if (next != nullptr && next->slots.isEmpty()) {
+                                delete next;
+                                next = nullptr;
+                        }
+                        Snapshot *old = _snapshot.exchange(next, MemoryOrder::SeqCst);
+                        if (old == nullptr) return;
+                        _readGate.synchronize();
+                        Snapshot::release(old);
+                        return;
+                }
+
+                // Publishes the current list minus entries matching
+                // @p pred; a no-op when nothing matches.  Caller holds
+                // _slotsMutex.
+                template <typename Pred> void removeSlotsIf(Pred pred) {
+                        const Snapshot *cur = _snapshot.load(MemoryOrder::Relaxed);
+                        if (cur == nullptr) return;
+                        bool any = false;
+                        for (const Info &info : cur->slots) {
+                                if (pred(info)) {
+                                        any = true;
+                                        break;
+                                }
+                        }
+                        if (!any) return;
+                        Snapshot *next = copySlots();
+                        next->slots.removeIf(pred);
+                        publish(next);
+                        return;
+                }
 
                 // Process-wide monotonic ID source.  Kept as a function-local
                 // static (rather than a member) so that adding it does not
@@ -290,7 +290,7 @@ class Strand {
                                 spawnTag = _workTag;
                         }
                         if (needSpawn) {
-                                _pool.submit(spawnTag, [this] { runNext(); });
+                                _pool.post(spawnTag, [this] { runNext(); });
                         }
                         return future;
                 }
@@ -333,7 +333,7 @@ class Strand {
                                         Mutex::Locker lock(_mutex);
                                         tag = _workTag;
                                 }
-                                _pool.submit(tag, [this] { runNext(); });
+                                _pool.post(tag, [this] { runNext(); });
                         }
                 }
 
@@ -60,6 +60,23 @@ class TcpServer : public ObjectBase {
                 /** @brief Stops listening and closes the server socket. */
                 void close();
 
+                /**
+                 * @brief Requests @c SO_REUSEPORT on the next @ref listen.
+                 *
+                 * Lets several servers (typically one per thread) bind
+                 * the same address and port; the kernel spreads
+                 * incoming connections across them.  Every socket
+                 * sharing the port must set the option.  @ref listen
+                 * fails with @c Error::NotSupported on platforms
+                 * without it.
+                 *
+                 * @param enable True to share the port.
+                 */
+                void setReusePort(bool enable) { _reusePort = enable; }
+
+                /** @brief Returns true if @ref setReusePort was enabled. */
+                bool reusePort() const { return _reusePort; }
+
                 /** @brief Returns true if the server is listening. */
                 bool isListening() const { return _listening; }
 
@@ -143,6 +160,7 @@ class TcpServer : public ObjectBase {
                 bool          _listening = false;
                 SocketAddress _address;
                 int           _maxPending = 50;
+                bool          _reusePort = false;
 };
 
 PROMEKI_NAMESPACE_END
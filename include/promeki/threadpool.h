@@ -55,6 +55,24 @@ PROMEKI_NAMESPACE_BEGIN
  * queue.  When the thread count is set to 0, tasks run inline on the
  * calling thread (useful for WASM graceful degradation).
  *
+ * @par Scheduling
+ * The default @ref Scheduler::SharedQueue keeps every pending task
+ * in one FIFO under the pool mutex, so every submission and every
+ * dispatch serializes on that lock.  @ref Scheduler::WorkStealing
+ * gives each worker its own lock-free queue: tasks submitted from
+ * a worker (a @ref Strand re-arming itself, a task fanning out
+ * sub-tasks) land on that worker's queue without touching a lock,
+ * tasks from any other thread go through a global injection queue,
+ * and idle workers steal from busy ones.  The pool mutex is only
+ * taken to park or wake an idle worker.
+ *
+ * @ref post is the fire-and-forget counterpart to @ref submit: it
+ * skips the @c std::packaged_task and shared future state, so
+ * posting a small callable (one whose captures fit
+ * @c std::function's inline buffer, such as a lambda capturing a
+ * single pointer) onto a work-stealing pool makes no heap
+ * allocation at all in steady state.
+ *
  * Non-copyable and non-movable.
  *
  * @par Thread Safety
@@ -91,6 +109,12 @@ class ThreadPool {
                  */
                 using WorkTag = StringRegistry<"ThreadPoolWorkTag">::Item;
 
+                /** @brief How pending tasks are handed to worker threads. */
+                enum class Scheduler {
+                        SharedQueue, ///< One FIFO queue guarded by the pool mutex.
+                        WorkStealing ///< Per-worker lock-free queues, a global injection queue, and stealing.
+                };
+
                 /**
                  * @brief One row of @ref snapshotWorkStats output.
                  *
@@ -117,8 +141,10 @@ class ThreadPool {
                  * @param lazy When @c true (default), threads are spawned on
                  *        demand as tasks arrive.  When @c false, all threads
                  *        are pre-spawned immediately.
+                 * @param scheduler Task dispatch strategy.  Fixed for the
+                 *        lifetime of the pool.
                  */
-                ThreadPool(int maxThreadCount = -1, bool lazy = true);
+                ThreadPool(int maxThreadCount = -1, bool lazy = true, Scheduler scheduler = Scheduler::SharedQueue);
 
                 /**
                  * @brief Destructor.  Signals shutdown and joins all worker threads.
@@ -173,29 +199,59 @@ class ThreadPool {
                  */
                 template <typename F> auto submit(WorkTag tag, F &&callable) -> Future<std::invoke_result_t<F>> {
                         using R = std::invoke_result_t<F>;
-                        auto      task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(callable));
-                        Future<R> fut(task->get_future());
-                        bool      runInline = false;
+                        auto       task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(callable));
+                        Future<R>  fut(task->get_future());
                         TaggedTask entry;
                         entry.tag = tag;
                         entry.enqueuedAt = TimeStamp::now();
                         entry.callable = [task]() { (*task)(); };
-                        {
-                                Mutex::Locker locker(_mutex);
-                                if (_maxThreadCount == 0) {
-                                        runInline = true;
-                                } else {
-                                        _tasks.pushToBack(std::move(entry));
-                                        maybeSpawnOne();
-                                        _cv.wakeOne();
-                                }
-                        }
-                        if (runInline) {
-                                runTaskWithStats(entry);
-                        }
+                        enqueue(std::move(entry));
                         return fut;
                 }
 
+                /**
+                 * @brief Queues an untagged callable without a result Future.
+                 *
+                 * Equivalent to @ref post(WorkTag, F&&) with an
+                 * invalid (untagged) @ref WorkTag.
+                 *
+                 * @tparam F A callable type returning @c void.
+                 * @param callable The callable to execute.
+                 */
+                template <typename F> void post(F &&callable) { post(WorkTag(), std::forward<F>(callable)); }
+
+                /**
+                 * @brief Queues a tagged callable without a result Future.
+                 *
+                 * Fire-and-forget form of @ref submit(WorkTag, F&&):
+                 * the callable is stored directly in the task queue,
+                 * so no @c std::packaged_task or shared future state
+                 * is allocated.  Per-tag @ref WorkStats accounting is
+                 * identical to @ref submit.  Use this whenever the
+                 * caller would discard the returned Future anyway.
+                 *
+                 * If the pool has zero threads the callable runs
+                 * inline on the calling thread.
+                 *
+                 * @tparam F A callable type returning @c void.
+                 * @param tag      Identifier for this category of work.
+                 * @param callable The callable to execute.
+                 */
+                template <typename F> void post(WorkTag tag, F &&callable) {
+                        TaggedTask entry;
+                        entry.tag = tag;
+                        entry.enqueuedAt = TimeStamp::now();
+                        entry.callable = Task(std::forward<F>(callable));
+                        enqueue(std::move(entry));
+                        return;
+                }
+
+                /**
+                 * @brief Returns the dispatch strategy chosen at construction.
+                 * @return The pool's @ref Scheduler.
+                 */
+                Scheduler scheduler() const { return _scheduler; }
+
                 /**
                  * @brief Sets the name prefix for worker threads.
                  *
@@ -340,10 +396,22 @@ class ThreadPool {
                                 WorkTag         tag;
                 };
 
+                /// Work-stealing queues, task-node pool and idle
+                /// bookkeeping.  Only allocated for
+                /// @ref Scheduler::WorkStealing pools; defined in
+                /// threadpool.cpp.
+                struct WorkStealing;
+
                 void workerFunc(int index);
+                void workStealingWorkerFunc(int index);
                 void spawnThreads(int count);
                 void maybeSpawnOne();
 
+                /// Hands @p entry to the scheduler, or runs it inline
+                /// on a zero-thread pool.
+                void enqueue(TaggedTask &&entry);
+                void enqueueWorkStealing(TaggedTask &&entry);
+
                 /// Runs @p t and accumulates per-tag stats around
                 /// the dispatch.  Called from worker threads (and
                 /// from the inline-no-thread path).  The wall + CPU
@@ -375,6 +443,8 @@ class ThreadPool {
                 int                                            _activeCount = 0;
                 int                                            _waitingCount = 0;
                 bool                                           _shutdown = false;
+                Scheduler                                      _scheduler = Scheduler::SharedQueue;
+                UniquePtr<WorkStealing>                        _ws;
 
                 mutable ReadWriteLock                          _statsLock;
                 HashMap<uint64_t, UniquePtr<WorkRecord>> _stats;
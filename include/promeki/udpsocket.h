@@ -12,6 +12,7 @@
 #if PROMEKI_ENABLE_NETWORK
 #include <promeki/buffer.h>
 #include <promeki/list.h>
+#include <promeki/mutex.h>
 #include <promeki/abstractsocket.h>
 #include <promeki/uniqueptr.h>
 
@@ -65,18 +66,84 @@ class UdpSocket : public AbstractSocket {
                  * and the socket has transmit-time enabled, the kernel
                  * (via the ETF qdisc) will hold the packet until the
                  * requested send time.
+                 *
+                 * A datagram may be scattered: the bytes on the wire are
+                 * @c data followed by each of the first @c segmentCount
+                 * entries of @c segments, in order.  This lets a sender
+                 * keep a small header in its own scratch memory and
+                 * point the payload straight at the source buffer
+                 * instead of assembling a contiguous copy.
+                 *
+                 * The owner Buffers keep the memory behind each iov
+                 * alive.  They are only consulted in zero-copy mode (see
+                 * @ref setZeroCopy()), where the kernel reads the bytes
+                 * after the send call has returned, so every iov must be
+                 * pinned: @c dataOwner must own @c data, and each
+                 * non-empty segment must be owned by its own
+                 * @c Segment::owner or by the shared @c segmentOwner.
+                 * A batch holding any datagram with an unowned iov is
+                 * sent the ordinary, copying way.
                  */
                 struct Datagram {
+                                /** @brief One extra gather segment appended after @c data. */
+                                struct Segment {
+                                                const void *data = nullptr; ///< @brief Segment bytes (caller-owned).
+                                                size_t      size = 0;       ///< @brief Segment length in bytes.
+                                                Buffer      owner;          ///< @brief Zero-copy keep-alive.
+                                };
+
+                                /** @brief Maximum number of extra gather segments per datagram. */
+                                static constexpr size_t MaxSegments = 4;
+
                                 const void   *data = nullptr; ///< @brief Pointer to the packet bytes (caller-owned).
                                 size_t        size = 0;       ///< @brief Number of bytes to send.
                                 SocketAddress dest;           ///< @brief Destination address and port.
                                 uint64_t      txTimeNs =
                                         0; ///< @brief Optional SCM_TXTIME nanoseconds since epoch (0 = immediate).
+                                Segment segments[MaxSegments]; ///< @brief Extra payload segments sent after @c data.
+                                size_t  segmentCount = 0;      ///< @brief Number of valid entries in @c segments.
+                                Buffer  dataOwner;             ///< @brief Zero-copy keep-alive for @c data.
+                                Buffer  segmentOwner;          ///< @brief Keep-alive for unowned segments.
+
+                                /** @brief Returns the total on-wire payload size, @c size plus every segment. */
+                                size_t totalSize() const {
+                                        size_t total = size;
+                                        for (size_t i = 0; i < segmentCount; ++i) total += segments[i].size;
+                                        return total;
+                                }
                 };
 
                 /** @brief List of datagrams for batch send. */
                 using DatagramList = ::promeki::List<Datagram>;
 
+                /**
+                 * @brief Describes a single receive slot for @ref readDatagrams().
+                 *
+                 * The caller points @c data at @c maxSize bytes of its
+                 * own storage; the call fills in @c size and, when
+                 * requested, @c sender for every slot it populates.
+                 */
+                struct RecvDatagram {
+                                void         *data = nullptr; ///< @brief Receive buffer (caller-owned).
+                                size_t        maxSize = 0;    ///< @brief Capacity of @c data in bytes.
+                                size_t        size = 0;       ///< @brief [out] Bytes received into @c data.
+                                SocketAddress sender;         ///< @brief [out] Sender address, if requested.
+                };
+
+                /** @brief List of receive slots for batch receive. */
+                using RecvDatagramList = ::promeki::List<RecvDatagram>;
+
+                /** @brief Maximum number of datagrams @ref readDatagrams() fills per call. */
+                static constexpr size_t MaxReadBatch = 64;
+
+                /** @brief Plain-value snapshot of the zero-copy transmit counters. */
+                struct ZeroCopyStats {
+                                uint64_t sent = 0;      ///< Datagrams submitted with @c MSG_ZEROCOPY.
+                                uint64_t completed = 0; ///< Datagrams whose completion has been reaped.
+                                uint64_t copied = 0;    ///< Completed datagrams the kernel copied anyway.
+                                uint64_t fallbacks = 0; ///< Send calls retried without @c MSG_ZEROCOPY.
+                };
+
                 /** @brief Value returned by @ref setPacingRate() to disable pacing. */
                 static constexpr uint64_t PacingRateUnlimited = ~static_cast<uint64_t>(0);
 
@@ -178,7 +245,16 @@ class UdpSocket : public AbstractSocket {
                  * Each datagram's @c data pointer must remain valid
                  * until this call returns.  The kernel copies into its
                  * own buffers before this function returns; callers do
-                 * not need to keep the data alive afterwards.
+                 * not need to keep the data alive afterwards.  The one
+                 * exception is zero-copy mode (@ref setZeroCopy()): a
+                 * batch in which every datagram has an owner for each
+                 * of its iovs (see @ref Datagram) is sent with
+                 * @c MSG_ZEROCOPY, and the socket holds those owners
+                 * until the kernel reports completion.
+                 *
+                 * Scattered datagrams (@ref Datagram::segmentCount
+                 * non-zero) are sent as a multi-element @c msg_iov, so
+                 * the kernel gathers header and payload itself.
                  *
                  * If @c txTimeNs is non-zero and transmit-time is
                  * enabled (see @ref setTxTime()), the datagram carries
@@ -246,6 +322,61 @@ class UdpSocket : public AbstractSocket {
                  */
                 Error setTxTime(bool enable, int clockId = 11 /* CLOCK_TAI */);
 
+                /**
+                 * @brief Enables @c MSG_ZEROCOPY transmit.
+                 *
+                 * Sets @c SO_ZEROCOPY on Linux.  Once enabled,
+                 * @ref writeDatagrams() sends any batch whose datagrams
+                 * have an owner for every iov with
+                 * @c MSG_ZEROCOPY: the kernel pins the user pages
+                 * instead of copying them, and reports completion later
+                 * on the socket error queue.  The socket keeps a
+                 * reference to each owner until that completion is
+                 * reaped, so the source buffers cannot be recycled
+                 * while the NIC may still be reading them.
+                 *
+                 * Completions are reaped from the socket's
+                 * @ref EventLoop, which watches the socket for
+                 * @c POLLERR from the first enable until @ref close(),
+                 * so an idle sender does not keep its last frames
+                 * pinned.  They are also reaped before every
+                 * @ref writeDatagrams() call and by
+                 * @ref reapZeroCopyCompletions().  A socket with no
+                 * event loop only gets the latter two.  The
+                 * bookkeeping is locked, so the sending thread need not
+                 * be the loop thread, but the loop must outlive the
+                 * socket's open period.  Zero-copy only pays
+                 * off for large payloads on a real NIC; on loopback, or
+                 * when the device cannot scatter-gather, the kernel
+                 * falls back to copying and reports it in
+                 * @ref ZeroCopyStats::copied.
+                 *
+                 * @param enable True to enable, false to disable.
+                 * @return Error::Ok on success, Error::NotSupported if
+                 *         the platform or kernel does not implement it,
+                 *         or another error on failure.
+                 */
+                Error setZeroCopy(bool enable);
+
+                /** @brief Returns true if @c MSG_ZEROCOPY transmit is enabled. */
+                bool isZeroCopy() const { return _zeroCopy; }
+
+                /**
+                 * @brief Drains zero-copy completions from the socket error queue.
+                 *
+                 * Releases the buffer owners held for every datagram the
+                 * kernel has finished with.  Never blocks.
+                 *
+                 * @return The number of datagrams completed by this call.
+                 */
+                size_t reapZeroCopyCompletions();
+
+                /** @brief Returns the number of zero-copy datagrams still awaiting completion. */
+                size_t pendingZeroCopy() const;
+
+                /** @brief Returns the zero-copy transmit counters. */
+                ZeroCopyStats zeroCopyStats() const;
+
                 /**
                  * @brief Receives a datagram.
                  * @param data Buffer to receive into.
@@ -255,6 +386,36 @@ class UdpSocket : public AbstractSocket {
                  */
                 int64_t readDatagram(void *data, size_t maxSize, SocketAddress *sender = nullptr);
 
+                /**
+                 * @brief Receives a batch of datagrams in one syscall.
+                 *
+                 * On Linux this uses @c recvmmsg() with
+                 * @c MSG_WAITFORONE: the call blocks (subject to
+                 * @ref setReceiveTimeout) until the first datagram
+                 * arrives, then drains whatever else is already
+                 * queued on the socket without blocking again.  On
+                 * platforms without @c recvmmsg() the implementation
+                 * falls back to a single @ref readDatagram() and
+                 * returns at most one datagram.
+                 *
+                 * At most @c min(datagrams.size(), MaxReadBatch)
+                 * slots are filled; slots past the returned count are
+                 * left untouched.  Datagrams larger than a slot's
+                 * @c maxSize are truncated, exactly as with
+                 * @ref readDatagram().
+                 *
+                 * @param datagrams  Receive slots; @c size and
+                 *                   (optionally) @c sender are written.
+                 * @param wantSender When true, decode each datagram's
+                 *                   source address into @c sender.
+                 *                   Leave false on hot paths that do
+                 *                   not need it.
+                 * @return The number of slots filled, 0 if
+                 *         @p datagrams is empty, or -1 on timeout /
+                 *         error.
+                 */
+                int readDatagrams(RecvDatagramList &datagrams, bool wantSender = false);
+
                 /**
                  * @brief Enables per-packet ingress interface reporting.
                  *
@@ -468,7 +629,38 @@ class UdpSocket : public AbstractSocket {
                 Error setSendBufferSize(int bytes);
 
         private:
-                int _domain = 0; ///< Address family (AF_INET or AF_INET6).
+                /** @brief Run of consecutive zero-copy sends that share the same owners. */
+                struct ZeroCopyPending {
+                                /** @brief Most distinct owners one run holds: data, shared and per-segment. */
+                                static constexpr size_t MaxOwners = 2 + Datagram::MaxSegments;
+
+                                uint32_t firstId = 0;       ///< First kernel completion id in the run.
+                                uint32_t count = 0;         ///< Datagrams in the run.
+                                uint32_t remaining = 0;     ///< Datagrams not yet completed.
+                                Buffer   owners[MaxOwners]; ///< Keep-alives for every iov in the run.
+                                size_t   ownerCount = 0;    ///< Number of valid entries in @c owners.
+                };
+
+                int                   _domain = 0; ///< Address family (AF_INET or AF_INET6).
+                bool                  _zeroCopy = false;
+                mutable Mutex         _zcMutex; ///< Guards the @c _zc* bookkeeping against the loop-side reaper.
+                uint32_t              _zcNextId = 0;
+                List<ZeroCopyPending> _zcPending;
+                ZeroCopyStats         _zcStats;
+                EventLoop            *_zcLoop = nullptr; ///< Loop watching the error queue, if any.
+                int                   _zcIoHandle = -1;  ///< Error-queue I/O source on @c _zcLoop.
+
+                // The helpers below expect @c _zcMutex to be held,
+                // except watchErrorQueue / unwatchErrorQueue /
+                // onErrorQueueReady, which manage it themselves.
+                void        trackZeroCopy(const DatagramList &datagrams, size_t sent);
+                static bool mergeOwners(ZeroCopyPending &run, const Buffer *const *owners, size_t count);
+                void        completeZeroCopy(uint32_t lo, uint32_t hi, bool copied);
+                size_t      drainErrorQueue();
+                size_t      pendingCount() const;
+                void        watchErrorQueue();
+                void        unwatchErrorQueue();
+                void        onErrorQueueReady();
 };
 
 PROMEKI_NAMESPACE_END
@@ -232,12 +232,33 @@ class UdpSocketTransport : public PacketTransport {
                 /** @copydoc PacketTransport::receivePacket() */
                 ssize_t receivePacket(void *data, size_t maxSize, SocketAddress *sender = nullptr) override;
 
+                /** @copydoc PacketTransport::receivePackets() */
+                int receivePackets(RecvDatagramList &packets, bool wantSender = false) override;
+
                 /** @copydoc PacketTransport::setPacingRate() */
                 Error setPacingRate(uint64_t bytesPerSec) override;
 
                 /** @copydoc PacketTransport::setTxTime() */
                 Error setTxTime(bool enable) override;
 
+                /**
+                 * @brief Enables @c MSG_ZEROCOPY transmit.
+                 *
+                 * May be called before or after @ref open(); the
+                 * setting is remembered and applied to the socket at
+                 * open time via @ref UdpSocket::setZeroCopy().  A
+                 * kernel that refuses @c SO_ZEROCOPY leaves the
+                 * transport on the ordinary copying path.
+                 *
+                 * @param enable True to enable, false to disable.
+                 * @return Error::Ok, or the socket's error when applied
+                 *         to an open transport.
+                 */
+                Error setZeroCopy(bool enable) override;
+
+                /** @brief Returns true if the open socket is sending with @c MSG_ZEROCOPY. */
+                bool isZeroCopy() const override;
+
         private:
                 UdpSocket::UPtr _socket;
                 SocketAddress   _localAddress;
@@ -251,6 +272,11 @@ class UdpSocketTransport : public PacketTransport {
                 bool            _reuseAddress = false;
                 bool            _multicastLoopback = false;
                 bool            _dontFragment = false;
+                bool            _zeroCopy = false;
+
+                // Reused translation scratch for receivePackets() so the
+                // batch receive path makes no per-call allocation.
+                UdpSocket::RecvDatagramList _recvScratch;
 };
 
 PROMEKI_NAMESPACE_END
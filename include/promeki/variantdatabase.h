@@ -20,6 +20,7 @@
 #include <promeki/variantspec.h>
 #include <promeki/error.h>
 #include <promeki/map.h>
+#include <promeki/flatmap.h>
 #include <promeki/list.h>
 #include <promeki/json.h>
 #include <promeki/stringlist.h>
@@ -127,6 +128,14 @@ template <CompiledString Name> class VariantDatabase {
                 /** @brief Map of ID to VariantSpec for batch spec operations. */
                 using SpecMap = ::promeki::Map<ID, VariantSpec>;
 
+                /**
+                 * @brief Entries stored inline before the entry table spills to the heap.
+                 *
+                 * Sized for the typical frame Metadata / MediaConfig, which
+                 * carry somewhere between a handful and a few dozen keys.
+                 */
+                static constexpr size_t InlineEntries = 16;
+
                 // ============================================================
                 // Static spec registry
                 // ============================================================
@@ -977,11 +986,17 @@ template <CompiledString Name> class VariantDatabase {
                  * MediaIOParams, LibraryOptions) is O(1) and the entry
                  * map is only deep-copied when one of the aliased
                  * handles is mutated.
+                 *
+                 * The entries are a @ref FlatMap sorted by ID with
+                 * @ref InlineEntries slots inside the Data block, so
+                 * the detach on first write to a shared frame's
+                 * metadata is one allocation plus a linear copy, and
+                 * lookups are a binary search over contiguous memory.
                  */
                 struct Data {
                                 PROMEKI_SHARED_FINAL(Data)
-                                Map<uint64_t, Variant> data;
-                                SpecValidation         validation = SpecValidation::Strict;
+                                FlatMap<uint64_t, Variant, InlineEntries> data;
+                                SpecValidation                            validation = SpecValidation::Strict;
                 };
                 SharedPtr<Data> _d = SharedPtr<Data>::create();
 
@@ -0,0 +1,810 @@
+/**
+ * @file      asyncfileio.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include <promeki/asyncfileio.h>
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/logger.h>
+#include <promeki/mutex.h>
+#include <promeki/promise.h>
+#include <promeki/threadpool.h>
+#include <promeki/waitcondition.h>
+
+#if defined(PROMEKI_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(PROMEKI_PLATFORM_LINUX)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define PROMEKI_ASYNCFILEIO_URING 1
+#endif
+#endif
+
+PROMEKI_NAMESPACE_BEGIN
+
+namespace {
+
+        // Largest single transfer; Linux caps read/write at this many
+        // bytes and io_uring reports the count in a 32-bit result.
+        constexpr size_t MaxRequestSize = 0x7ffff000;
+
+        constexpr unsigned int MaxQueueDepth = 4096;
+
+        // Blocking positional transfer used by the thread-pool engine.
+        // Loops over short transfers so only end of file ends a read
+        // early.
+        int64_t positionalIO(const AsyncFileIO::Request &req, Error &err) {
+                uint8_t *p = static_cast<uint8_t *>(req.data);
+                size_t   done = 0;
+                while (done < req.size) {
+#if defined(PROMEKI_PLATFORM_WINDOWS)
+                        const uint64_t off = static_cast<uint64_t>(req.offset) + done;
+                        OVERLAPPED     ov = {};
+                        ov.Offset = static_cast<DWORD>(off);
+                        ov.OffsetHigh = static_cast<DWORD>(off >> 32);
+                        DWORD       n = 0;
+                        const DWORD want = static_cast<DWORD>(req.size - done);
+                        const BOOL  ok = req.op == AsyncFileIO::Op::Read
+                                                 ? ReadFile(req.handle, p + done, want, &n, &ov)
+                                                 : WriteFile(req.handle, p + done, want, &n, &ov);
+                        if (!ok) {
+                                const DWORD e = GetLastError();
+                                if (e == ERROR_HANDLE_EOF) break;
+                                err = Error::syserr(static_cast<int>(e));
+                                return -1;
+                        }
+#else
+                        const off_t   off = static_cast<off_t>(req.offset + static_cast<int64_t>(done));
+                        const ssize_t n = req.op == AsyncFileIO::Op::Read
+                                                  ? ::pread(req.handle, p + done, req.size - done, off)
+                                                  : ::pwrite(req.handle, p + done, req.size - done, off);
+                        if (n < 0) {
+                                if (errno == EINTR) continue;
+                                err = Error::syserr(errno);
+                                return -1;
+                        }
+#endif
+                        if (n == 0) break;
+                        done += static_cast<size_t>(n);
+                }
+                err = Error::Ok;
+                return static_cast<int64_t>(done);
+        }
+
+        // Runs a request's callback (if any) and releases everything the
+        // request holds.
+        void finish(AsyncFileIO::Request &req, int64_t result, Error err) {
+                if (req.callback) req.callback(result, err);
+                req.callback = AsyncFileIO::Callback();
+                req.keep = Buffer();
+                return;
+        }
+
+} // namespace
+
+// ============================================================================
+// Engine interface
+// ============================================================================
+
+class AsyncFileIO::Impl {
+        public:
+                virtual ~Impl() = default;
+
+                virtual bool isValid() const = 0;
+                virtual unsigned int inFlight() const = 0;
+
+                // Takes every request in @p batch; each one's callback
+                // runs exactly once.  Requests are already validated.
+                virtual void submit(List<Request> &batch) = 0;
+
+                virtual void waitForIdle() = 0;
+
+                virtual Error registerFile(File::FileHandle) { return Error::Ok; }
+                virtual void  unregisterFile(File::FileHandle) {}
+                virtual Error registerBuffers(const List<Buffer> &) { return Error::Ok; }
+                virtual void  unregisterBuffers() {}
+
+                class Pool;
+                class Uring;
+};
+
+// ============================================================================
+// Thread-pool engine
+// ============================================================================
+
+class AsyncFileIO::Impl::Pool : public AsyncFileIO::Impl {
+        public:
+                explicit Pool(unsigned int depth) : _pool(static_cast<int>(depth)), _depth(depth) {
+                        _pool.setNamePrefix("aio");
+                        _pool.setName("aio");
+                }
+
+                ~Pool() override {
+                        waitForIdle();
+                        _pool.waitForDone();
+                }
+
+                bool isValid() const override { return true; }
+
+                unsigned int inFlight() const override {
+                        Mutex::Locker lock(_mutex);
+                        return _inFlight;
+                }
+
+                void submit(List<AsyncFileIO::Request> &batch) override {
+                        for (AsyncFileIO::Request &req : batch) {
+                                {
+                                        Mutex::Locker lock(_mutex);
+                                        _cond.wait(_mutex, [this] { return _inFlight < _depth; });
+                                        _inFlight++;
+                                }
+                                _pool.post([this, r = std::move(req)]() mutable {
+                                        Error         err;
+                                        const int64_t n = positionalIO(r, err);
+                                        finish(r, n, err);
+                                        Mutex::Locker lock(_mutex);
+                                        _inFlight--;
+                                        _cond.wakeAll();
+                                });
+                        }
+                        return;
+                }
+
+                void waitForIdle() override {
+                        Mutex::Locker lock(_mutex);
+                        _cond.wait(_mutex, [this] { return _inFlight == 0; });
+                        return;
+                }
+
+        private:
+                ThreadPool     _pool;
+                mutable Mutex  _mutex;
+                WaitCondition  _cond;
+                unsigned int   _depth;
+                unsigned int   _inFlight = 0;
+};
+
+#if defined(PROMEKI_ASYNCFILEIO_URING)
+
+namespace {
+
+        // ====================================================================
+        // io_uring engine
+        //
+        // liburing is not a dependency, so the ring is driven through the
+        // raw system calls and the mmap'd ring layout from
+        // <linux/io_uring.h>.  Only vectored and fixed-buffer read/write
+        // and NOP are used, which every io_uring kernel (5.1+) supports.
+        // ====================================================================
+
+        int uringSetup(unsigned int entries, io_uring_params *p) {
+                return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+        }
+
+        int uringEnter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags) {
+                return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+        }
+
+        int uringRegister(int fd, unsigned int opcode, const void *arg, unsigned int nrArgs) {
+                return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+        }
+
+        // Fixed-file table size.  Registered once, sparse, on the first
+        // registerFile() and updated slot by slot after that.
+        constexpr unsigned int FixedFileSlots = 64;
+
+} // namespace
+
+class AsyncFileIO::Impl::Uring : public AsyncFileIO::Impl {
+        public:
+                explicit Uring(unsigned int depth) : _depth(depth), _reaper("aio-uring") {
+                        io_uring_params p;
+                        std::memset(&p, 0, sizeof(p));
+                        _fd = uringSetup(depth, &p);
+                        if (_fd < 0) return;
+                        if (!mapRings(p)) {
+                                unmapRings();
+                                ::close(_fd);
+                                _fd = -1;
+                                return;
+                        }
+                        _slots.resize(depth);
+                        for (unsigned int i = depth; i > 0; i--) _free.pushToBack(i - 1);
+                        _reaper.start([this] { reap(); });
+                }
+
+                ~Uring() override {
+                        if (_fd < 0) return;
+                        waitForIdle();
+                        {
+                                // A NOP tagged 0 tells the reaper to exit.
+                                Mutex::Locker      lock(_mutex);
+                                io_uring_sqe *sqe = nextSqe();
+                                sqe->opcode = IORING_OP_NOP;
+                                sqe->user_data = 0;
+                                flush();
+                        }
+                        _reaper.join();
+                        unmapRings();
+                        ::close(_fd);
+                }
+
+                bool isValid() const override { return _fd >= 0; }
+
+                unsigned int inFlight() const override {
+                        Mutex::Locker lock(_mutex);
+                        return _inFlight;
+                }
+
+                void submit(List<AsyncFileIO::Request> &batch) override {
+                        Mutex::Locker lock(_mutex);
+                        for (AsyncFileIO::Request &req : batch) {
+                                if (_inFlight == _depth) {
+                                        // Hand what is queued to the kernel
+                                        // before sleeping on it.
+                                        flush();
+                                        _cond.wait(_mutex, [this] { return _inFlight < _depth; });
+                                }
+                                const unsigned int idx = _free.back();
+                                _free.popFromBack();
+                                _inFlight++;
+                                prepare(idx, std::move(req));
+                        }
+                        flush();
+                        return;
+                }
+
+                void waitForIdle() override {
+                        Mutex::Locker lock(_mutex);
+                        _cond.wait(_mutex, [this] { return _inFlight == 0; });
+                        return;
+                }
+
+                Error registerFile(File::FileHandle handle) override {
+                        Mutex::Locker lock(_mutex);
+                        if (fixedSlot(handle) >= 0) return Error::Ok;
+                        if (!_fixedRegistered) {
+                                int table[FixedFileSlots];
+                                for (unsigned int i = 0; i < FixedFileSlots; i++) table[i] = -1;
+                                if (uringRegister(_fd, IORING_REGISTER_FILES, table, FixedFileSlots) < 0) {
+                                        return Error::syserr(errno);
+                                }
+                                _fixedFds.resize(FixedFileSlots, -1);
+                                _fixedRegistered = true;
+                        }
+                        int slot = fixedSlot(-1);
+                        if (slot < 0) return Error::NoSpace;
+                        Error err = updateFixed(slot, handle);
+                        if (err.isOk()) {
+                                _fixedFds[slot] = handle;
+                                _fixedCount++;
+                        }
+                        return err;
+                }
+
+                void unregisterFile(File::FileHandle handle) override {
+                        Mutex::Locker lock(_mutex);
+                        if (handle < 0) return;
+                        int slot = fixedSlot(handle);
+                        if (slot < 0) return;
+                        updateFixed(slot, -1);
+                        _fixedFds[slot] = -1;
+                        _fixedCount--;
+                        return;
+                }
+
+                Error registerBuffers(const List<Buffer> &buffers) override {
+                        // The kernel refuses to swap the table under
+                        // in-flight I/O; holding the lock while idle
+                        // keeps new requests out until it is done.
+                        Mutex::Locker lock(_mutex);
+                        _cond.wait(_mutex, [this] { return _inFlight == 0; });
+                        dropBuffersLocked();
+                        if (buffers.isEmpty()) return Error::Ok;
+                        List<iovec> iov;
+                        for (const Buffer &b : buffers) {
+                                if (!b.isValid() || !b.isHostAccessible()) return Error::Invalid;
+                                iovec v;
+                                v.iov_base = const_cast<void *>(b.data());
+                                v.iov_len = b.allocSize();
+                                iov.pushToBack(v);
+                        }
+                        if (uringRegister(_fd, IORING_REGISTER_BUFFERS, iov.data(),
+                                          static_cast<unsigned int>(iov.size())) < 0) {
+                                return Error::syserr(errno);
+                        }
+                        _bufs = buffers;
+                        _bufRanges = iov;
+                        return Error::Ok;
+                }
+
+                void unregisterBuffers() override {
+                        Mutex::Locker lock(_mutex);
+                        _cond.wait(_mutex, [this] { return _inFlight == 0; });
+                        dropBuffersLocked();
+                        return;
+                }
+
+        private:
+                // Per-request state, owned by the request while it
+                // is in flight.  user_data is the slot index + 1.
+                struct Slot {
+                                iovec                 iov;
+                                Buffer                keep;
+                                AsyncFileIO::Callback callback;
+                };
+
+                // A finished request, moved out of its slot.
+                struct Done {
+                                unsigned int          idx = 0;
+                                int                   res = 0;
+                                Buffer                keep;
+                                AsyncFileIO::Callback callback;
+                };
+
+                bool mapRings(const io_uring_params &p) {
+                        _sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+                        _cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+                        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                        if (single && _cqRingSize > _sqRingSize) _sqRingSize = _cqRingSize;
+                        _sqRing = ::mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                         _fd, IORING_OFF_SQ_RING);
+                        if (_sqRing == MAP_FAILED) {
+                                _sqRing = nullptr;
+                                return false;
+                        }
+                        if (single) {
+                                _cqRing = _sqRing;
+                        } else {
+                                _cqRing = ::mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+                                if (_cqRing == MAP_FAILED) {
+                                        _cqRing = nullptr;
+                                        return false;
+                                }
+                        }
+                        _sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+                        void *sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                            _fd, IORING_OFF_SQES);
+                        if (sqes == MAP_FAILED) return false;
+                        _sqes = static_cast<io_uring_sqe *>(sqes);
+
+                        uint8_t *sq = static_cast<uint8_t *>(_sqRing);
+                        uint8_t *cq = static_cast<uint8_t *>(_cqRing);
+                        _sqHead = reinterpret_cast<unsigned int *>(sq + p.sq_off.head);
+                        _sqTail = reinterpret_cast<unsigned int *>(sq + p.sq_off.tail);
+                        _sqMask = *reinterpret_cast<unsigned int *>(sq + p.sq_off.ring_mask);
+                        _sqArray = reinterpret_cast<unsigned int *>(sq + p.sq_off.array);
+                        _cqHead = reinterpret_cast<unsigned int *>(cq + p.cq_off.head);
+                        _cqTail = reinterpret_cast<unsigned int *>(cq + p.cq_off.tail);
+                        _cqMask = *reinterpret_cast<unsigned int *>(cq + p.cq_off.ring_mask);
+                        _cqes = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+                        _sqLocalTail = *_sqTail;
+                        return true;
+                }
+
+                void unmapRings() {
+                        if (_sqes != nullptr) ::munmap(_sqes, _sqesSize);
+                        if (_cqRing != nullptr && _cqRing != _sqRing) ::munmap(_cqRing, _cqRingSize);
+                        if (_sqRing != nullptr) ::munmap(_sqRing, _sqRingSize);
+                        _sqes = nullptr;
+                        _cqRing = nullptr;
+                        _sqRing = nullptr;
+                        return;
+                }
+
+                // Claims the next submission entry.  Never runs
+                // out: at most _depth requests (plus the final
+                // NOP, sent only when idle) are ever queued and
+                // the ring holds at least that many.
+                io_uring_sqe *nextSqe() {
+                        const unsigned int index = _sqLocalTail & _sqMask;
+                        io_uring_sqe      *sqe = &_sqes[index];
+                        std::memset(sqe, 0, sizeof(*sqe));
+                        _sqArray[index] = index;
+                        _sqLocalTail++;
+                        _sqPending++;
+                        return sqe;
+                }
+
+                void prepare(unsigned int idx, AsyncFileIO::Request &&req) {
+                        Slot &slot = _slots[idx];
+                        slot.iov.iov_base = req.data;
+                        slot.iov.iov_len = req.size;
+                        slot.keep = std::move(req.keep);
+                        slot.callback = std::move(req.callback);
+
+                        const bool    read = req.op == AsyncFileIO::Op::Read;
+                        io_uring_sqe *sqe = nextSqe();
+                        const int     bufIndex = fixedBuffer(req.data, req.size);
+                        if (bufIndex >= 0) {
+                                sqe->opcode = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                                sqe->addr = reinterpret_cast<uint64_t>(req.data);
+                                sqe->len = static_cast<uint32_t>(req.size);
+                                sqe->buf_index = static_cast<uint16_t>(bufIndex);
+                        } else {
+                                sqe->opcode = read ? IORING_OP_READV : IORING_OP_WRITEV;
+                                sqe->addr = reinterpret_cast<uint64_t>(&slot.iov);
+                                sqe->len = 1;
+                        }
+                        const int fixed = _fixedCount > 0 ? fixedSlot(req.handle) : -1;
+                        if (fixed >= 0) {
+                                sqe->fd = fixed;
+                                sqe->flags |= IOSQE_FIXED_FILE;
+                        } else {
+                                sqe->fd = req.handle;
+                        }
+                        sqe->off = static_cast<uint64_t>(req.offset);
+                        sqe->user_data = idx + 1;
+                        return;
+                }
+
+                // Publishes queued entries and submits them.  The
+                // completion ring is twice the submission ring, so
+                // the kernel never pushes back with EBUSY here.
+                void flush() {
+                        if (_sqPending == 0) return;
+                        AtomicRef<unsigned int>(*_sqTail).store(_sqLocalTail, MemoryOrder::Release);
+                        while (_sqPending > 0) {
+                                int n = uringEnter(_fd, _sqPending, 0, 0);
+                                if (n < 0) {
+                                        if (errno == EINTR || errno == EAGAIN) continue;
+                                        promekiErr("AsyncFileIO: io_uring_enter failed: %s", std::strerror(errno));
+                                        failUnsubmitted();
+                                        return;
+                                }
+                                _sqPending -= static_cast<unsigned int>(n);
+                        }
+                        return;
+                }
+
+                // Fails every entry the kernel would not take.  The
+                // ring is rewound so those entries are never seen.
+                // Only reached when io_uring_enter itself breaks, so
+                // the callbacks running under _mutex here is acceptable.
+                void failUnsubmitted() {
+                        const unsigned int head = AtomicRef<unsigned int>(*_sqHead).load(MemoryOrder::Acquire);
+                        for (unsigned int t = head; t != _sqLocalTail; t++) {
+                                const uint64_t tag = _sqes[t & _sqMask].user_data;
+                                if (tag == 0) continue;
+                                const unsigned int idx = static_cast<unsigned int>(tag - 1);
+                                Done               d = takeSlot(idx, -EIO);
+                                runDone(d);
+                                _free.pushToBack(idx);
+                                _inFlight--;
+                        }
+                        _sqLocalTail = head;
+                        AtomicRef<unsigned int>(*_sqTail).store(head, MemoryOrder::Release);
+                        _sqPending = 0;
+                        _cond.wakeAll();
+                        return;
+                }
+
+                // Completion thread: waits on the completion ring and
+                // finishes each request.  Slots are handed over under
+                // _mutex once per batch of completions — the kernel
+                // orders the ring itself, but the lock is what makes the
+                // submitter's writes to a slot visible here.
+                void reap() {
+                        List<Done> ready;
+                        ready.reserve(_depth);
+                        bool stop = false;
+                        while (!stop) {
+                                const unsigned int head = *_cqHead;
+                                const unsigned int tail =
+                                        AtomicRef<unsigned int>(*_cqTail).load(MemoryOrder::Acquire);
+                                if (head == tail) {
+                                        uringEnter(_fd, 0, 1, IORING_ENTER_GETEVENTS);
+                                        continue;
+                                }
+                                {
+                                        Mutex::Locker lock(_mutex);
+                                        for (unsigned int h = head; h != tail; h++) {
+                                                const io_uring_cqe &cqe = _cqes[h & _cqMask];
+                                                if (cqe.user_data == 0) {
+                                                        stop = true;
+                                                        continue;
+                                                }
+                                                ready.pushToBack(takeSlot(static_cast<unsigned int>(cqe.user_data - 1),
+                                                                          cqe.res));
+                                        }
+                                }
+                                // Release the entries before the callbacks
+                                // run so a slow callback never stalls the
+                                // ring.
+                                AtomicRef<unsigned int>(*_cqHead).store(tail, MemoryOrder::Release);
+                                for (Done &d : ready) runDone(d);
+                                Mutex::Locker lock(_mutex);
+                                for (const Done &d : ready) _free.pushToBack(d.idx);
+                                _inFlight -= static_cast<unsigned int>(ready.size());
+                                _cond.wakeAll();
+                                ready.clear();
+                        }
+                        return;
+                }
+
+                // Moves slot @p idx's request state out.  Caller holds
+                // _mutex.
+                Done takeSlot(unsigned int idx, int res) {
+                        Slot &slot = _slots[idx];
+                        Done  d;
+                        d.idx = idx;
+                        d.res = res;
+                        d.callback = std::move(slot.callback);
+                        d.keep = std::move(slot.keep);
+                        slot.callback = AsyncFileIO::Callback();
+                        slot.keep = Buffer();
+                        return d;
+                }
+
+                static void runDone(Done &d) {
+                        if (d.callback) {
+                                if (d.res < 0) d.callback(-1, Error::syserr(-d.res));
+                                else d.callback(d.res, Error::Ok);
+                        }
+                        d.callback = AsyncFileIO::Callback();
+                        d.keep = Buffer();
+                        return;
+                }
+
+                int fixedSlot(int fd) const {
+                        for (size_t i = 0; i < _fixedFds.size(); i++) {
+                                if (_fixedFds[i] == fd) return static_cast<int>(i);
+                        }
+                        return -1;
+                }
+
+                Error updateFixed(int slot, int fd) {
+                        io_uring_files_update up;
+                        std::memset(&up, 0, sizeof(up));
+                        up.offset = static_cast<uint32_t>(slot);
+                        up.fds = reinterpret_cast<uint64_t>(&fd);
+                        if (uringRegister(_fd, IORING_REGISTER_FILES_UPDATE, &up, 1) < 0) {
+                                return Error::syserr(errno);
+                        }
+                        return Error::Ok;
+                }
+
+                int fixedBuffer(const void *data, size_t size) const {
+                        const uint8_t *p = static_cast<const uint8_t *>(data);
+                        for (size_t i = 0; i < _bufRanges.size(); i++) {
+                                const uint8_t *base = static_cast<const uint8_t *>(_bufRanges[i].iov_base);
+                                if (p >= base && p + size <= base + _bufRanges[i].iov_len) {
+                                        return static_cast<int>(i);
+                                }
+                        }
+                        return -1;
+                }
+
+                void dropBuffersLocked() {
+                        if (_bufRanges.isEmpty()) return;
+                        uringRegister(_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+                        _bufRanges.clear();
+                        _bufs.clear();
+                        return;
+                }
+
+                int           _fd = -1;
+                unsigned int  _depth;
+                void         *_sqRing = nullptr;
+                void         *_cqRing = nullptr;
+                size_t        _sqRingSize = 0;
+                size_t        _cqRingSize = 0;
+                size_t        _sqesSize = 0;
+                io_uring_sqe *_sqes = nullptr;
+                io_uring_cqe *_cqes = nullptr;
+                unsigned int *_sqHead = nullptr;
+                unsigned int *_sqTail = nullptr;
+                unsigned int *_sqArray = nullptr;
+                unsigned int *_cqHead = nullptr;
+                unsigned int *_cqTail = nullptr;
+                unsigned int  _sqMask = 0;
+                unsigned int  _cqMask = 0;
+                unsigned int  _sqLocalTail = 0;
+                unsigned int  _sqPending = 0;
+
+                mutable Mutex      _mutex;
+                WaitCondition      _cond;
+                List<Slot>         _slots;
+                List<unsigned int> _free;
+                unsigned int       _inFlight = 0;
+                List<int>          _fixedFds;
+                int                _fixedCount = 0;
+                bool               _fixedRegistered = false;
+                List<Buffer>       _bufs;
+                List<iovec>        _bufRanges;
+                BasicThread        _reaper;
+};
+
+#endif // PROMEKI_ASYNCFILEIO_URING
+
+namespace {
+
+        // Future plumbing: the promise is shared with the callback, which
+        // may be copied into whichever engine runs it.
+        AsyncFileIO::Callback promiseCallback(const std::shared_ptr<Promise<int64_t>> &promise) {
+                return [promise](int64_t result, Error err) {
+                        if (err.isError()) promise->setError(err);
+                        else promise->setValue(result);
+                };
+        }
+
+} // namespace
+
+// ============================================================================
+// AsyncFileIO
+// ============================================================================
+
+bool AsyncFileIO::ioUringAvailable() {
+#if defined(PROMEKI_ASYNCFILEIO_URING)
+        static const bool available = [] {
+                io_uring_params p;
+                std::memset(&p, 0, sizeof(p));
+                int fd = uringSetup(2, &p);
+                if (fd < 0) return false;
+                ::close(fd);
+                return true;
+        }();
+        return available;
+#else
+        return false;
+#endif
+}
+
+AsyncFileIO::AsyncFileIO(unsigned int queueDepth, Engine engine) {
+        if (queueDepth < 1) queueDepth = 1;
+        if (queueDepth > MaxQueueDepth) queueDepth = MaxQueueDepth;
+        _queueDepth = queueDepth;
+#if defined(PROMEKI_ASYNCFILEIO_URING)
+        if (engine == Engine::IoUring || engine == Engine::Auto) {
+                auto uring = ImplPtr::takeOwnership(new Impl::Uring(queueDepth));
+                if (uring->isValid()) {
+                        _d = std::move(uring);
+                        _engine = Engine::IoUring;
+                        return;
+                }
+                if (engine == Engine::IoUring) {
+                        promekiWarn("AsyncFileIO: io_uring unavailable");
+                        _engine = Engine::IoUring;
+                        return;
+                }
+        }
+#else
+        if (engine == Engine::IoUring) {
+                _engine = Engine::IoUring;
+                return;
+        }
+#endif
+        _d = ImplPtr::takeOwnership(new Impl::Pool(queueDepth));
+        _engine = Engine::ThreadPool;
+}
+
+AsyncFileIO::~AsyncFileIO() = default;
+
+bool AsyncFileIO::isValid() const {
+        return _d.isValid() && _d->isValid();
+}
+
+unsigned int AsyncFileIO::inFlight() const {
+        return _d.isValid() ? _d->inFlight() : 0;
+}
+
+Future<int64_t> AsyncFileIO::submitOne(Request &&req) {
+        auto promise = std::make_shared<Promise<int64_t>>();
+        Future<int64_t> future = promise->future();
+        req.callback = promiseCallback(promise);
+        List<Request> batch;
+        batch.pushToBack(std::move(req));
+        submit(std::move(batch));
+        return future;
+}
+
+Future<int64_t> AsyncFileIO::read(const File &file, int64_t offset, void *data, size_t size) {
+        Request req;
+        req.op = Op::Read;
+        req.handle = file.handle();
+        req.offset = offset;
+        req.data = data;
+        req.size = size;
+        return submitOne(std::move(req));
+}
+
+Future<int64_t> AsyncFileIO::read(const File &file, int64_t offset, const Buffer &buf, size_t size) {
+        Request req;
+        req.op = Op::Read;
+        req.handle = file.handle();
+        req.offset = offset;
+        req.keep = buf;
+        req.data = req.keep.isValid() && size <= req.keep.allocSize() ? req.keep.data() : nullptr;
+        req.size = size;
+        return submitOne(std::move(req));
+}
+
+Future<int64_t> AsyncFileIO::write(const File &file, int64_t offset, const void *data, size_t size) {
+        Request req;
+        req.op = Op::Write;
+        req.handle = file.handle();
+        req.offset = offset;
+        req.data = const_cast<void *>(data);
+        req.size = size;
+        return submitOne(std::move(req));
+}
+
+Future<int64_t> AsyncFileIO::write(const File &file, int64_t offset, const Buffer &buf, size_t size) {
+        Request req;
+        req.op = Op::Write;
+        req.handle = file.handle();
+        req.offset = offset;
+        req.keep = buf;
+        req.data = req.keep.isValid() && size <= req.keep.allocSize() ? req.keep.data() : nullptr;
+        req.size = size;
+        return submitOne(std::move(req));
+}
+
+Error AsyncFileIO::submit(List<Request> batch) {
+        Error         first;
+        List<Request> accepted;
+        for (Request &req : batch) {
+                Error err;
+                if (!isValid()) err = Error::NotSupported;
+                else if (req.handle == File::FileHandleClosedValue) err = Error::NotOpen;
+                else if (req.offset < 0 || req.size > MaxRequestSize) err = Error::Invalid;
+                else if (req.data == nullptr && req.size > 0) err = Error::Invalid;
+                if (err.isError()) {
+                        if (first.isOk()) first = err;
+                        finish(req, -1, err);
+                        continue;
+                }
+                if (req.size == 0) {
+                        finish(req, 0, Error::Ok);
+                        continue;
+                }
+                accepted.pushToBack(std::move(req));
+        }
+        if (!accepted.isEmpty()) _d->submit(accepted);
+        return first;
+}
+
+void AsyncFileIO::waitForIdle() {
+        if (_d.isValid()) _d->waitForIdle();
+        return;
+}
+
+Error AsyncFileIO::registerFile(const File &file) {
+        if (!isValid()) return Error::NotSupported;
+        if (!file.isOpen() || file.handle() == File::FileHandleClosedValue) return Error::NotOpen;
+        return _d->registerFile(file.handle());
+}
+
+void AsyncFileIO::unregisterFile(const File &file) {
+        if (!isValid()) return;
+        _d->unregisterFile(file.handle());
+        return;
+}
+
+Error AsyncFileIO::registerBuffers(const List<Buffer> &buffers) {
+        if (!isValid()) return Error::NotSupported;
+        return _d->registerBuffers(buffers);
+}
+
+void AsyncFileIO::unregisterBuffers() {
+        if (!isValid()) return;
+        _d->unregisterBuffers();
+        return;
+}
+
+PROMEKI_NAMESPACE_END
@@ -5,47 +5,384 @@
  * See LICENSE file in the project root folder for license information.
  */
 
+#include <cstring>
+#include <thread>
 #include <promeki/bufferpool.h>
+#include <promeki/atomic.h>
+#include <promeki/hostbufferimpl.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
-BufferPool::BufferPool(size_t bufferSize, size_t alignment, const MemSpace &ms)
-    : _bufferSize(bufferSize), _alignment(alignment == 0 ? Buffer::DefaultAlign : alignment), _memSpace(ms) {}
+// ============================================================================
+// BufferPool::Pool — the shared state behind every BufferPool handle and
+// every pooled Buffer.
+//
+// Each size class owns a fixed array of block nodes, created when the class
+// is claimed.  A node is on exactly one of two lock-free stacks while it is
+// not in flight:
+//
+//   - idle:  the node holds a block of memory ready to hand out.
+//   - spare: the node holds no memory; a miss allocates into it.
+//
+// Stack heads pack a 32-bit node index with a 32-bit tag that is bumped on
+// every successful CAS, which keeps a pop that raced a pop + push of the
+// same node (ABA) from installing a stale next link.  Nodes are never freed
+// while the pool is alive, so reading a node's next link after losing the
+// race is always safe.
+// ============================================================================
 
-void BufferPool::reserve(size_t count) {
-        while (_free.size() < count) {
-                Buffer buf(_bufferSize, _alignment, _memSpace);
-                if (!buf.isValid()) return;
-                _free.pushToBack(std::move(buf));
+struct BufferPool::Pool {
+                static constexpr uint32_t Nil = 0xFFFFFFFFu;
+                static constexpr size_t   Unclaimed = 0;
+                static constexpr size_t   Claiming = static_cast<size_t>(-1);
+
+                struct Node {
+                                Atomic<uint32_t> next{Nil};
+                                MemAllocation    alloc;
+                };
+
+                struct SizeClass {
+                                Atomic<size_t>   bytes{Unclaimed};
+                                Atomic<uint64_t> idleHead{Nil};
+                                Atomic<uint64_t> spareHead{Nil};
+                                Atomic<size_t>   idleCount{0};
+                                Node            *nodes = nullptr;
+                };
+
+                // Backing for pooled Buffers.  Destruction is the release
+                // hook: the block goes back to its class rather than being
+                // freed.  Holding the PoolPtr anchors the pool until every
+                // block it vended is home.
+                class BlockImpl : public HostMappedBufferImpl {
+                        public:
+                                BlockImpl(const PoolPtr &pool, SizeClass *cls, uint32_t node, size_t bytes)
+                                    : HostMappedBufferImpl(pool->config.memSpace, cls->nodes[node].alloc.ptr, bytes,
+                                                           pool->config.alignment),
+                                      _pool(pool), _cls(cls), _node(node) {}
+
+                                ~BlockImpl() override { _pool->recycle(*_cls, _node); }
+
+                                // A private copy comes from the heap, not the pool —
+                                // the pool only vends through acquire().
+                                HostMappedBufferImpl *_promeki_clone() const override {
+                                        auto *clone = new HostBufferImpl(_memSpace, _allocSize, _align);
+                                        void *dst = clone->mappedHostData();
+                                        if (dst != nullptr && _hostPtr != nullptr && _allocSize > 0) {
+                                                std::memcpy(dst, _hostPtr, _allocSize);
+                                        }
+                                        clone->setShift(_shift);
+                                        clone->setLogicalSize(_logicalSize);
+                                        return clone;
+                                }
+
+                        private:
+                                PoolPtr    _pool;
+                                SizeClass *_cls;
+                                uint32_t   _node;
+                };
+
+                Config                  config;
+                mutable SizeClass       classes[MaxSizeClasses];
+                mutable Atomic<bool>    hostAccessible{true};
+
+                explicit Pool(const Config &cfg) : config(cfg) {
+                        if (config.alignment == 0) config.alignment = Buffer::DefaultAlign;
+                        if (config.lowWatermark > config.highWatermark) config.lowWatermark = config.highWatermark;
+                        if (config.maxBuffersPerClass >= Nil) config.maxBuffersPerClass = Nil - 1;
+                }
+
+                ~Pool() {
+                        for (SizeClass &c : classes) {
+                                if (c.nodes == nullptr) continue;
+                                drain(c, 0);
+                                delete[] c.nodes;
+                        }
+                }
+
+                Pool(const Pool &) = delete;
+                Pool &operator=(const Pool &) = delete;
+
+                size_t classBytesFor(size_t bytes) const {
+                        const size_t a = config.alignment;
+                        return (bytes + a - 1) / a * a;
+                }
+
+                MemSpace::Stats &stats() const { return config.memSpace.stats(); }
+
+                // True once a class's node array is published.  The
+                // acquire load on bytes orders the read of nodes after it.
+                static bool isClaimed(const SizeClass &c) {
+                        const size_t b = c.bytes.value();
+                        return b != Unclaimed && b != Claiming;
+                }
+
+                // ---- Tagged lock-free stacks ----
+
+                static uint64_t pack(uint64_t oldHead, uint32_t index) {
+                        return (((oldHead >> 32) + 1) << 32) | index;
+                }
+
+                static void push(Atomic<uint64_t> &head, Node *nodes, uint32_t index) {
+                        uint64_t old = head.load(MemoryOrder::Relaxed);
+                        do {
+                                nodes[index].next.store(static_cast<uint32_t>(old), MemoryOrder::Relaxed);
+                        } while (!head.compareExchangeWeak(old, pack(old, index), MemoryOrder::Release,
+                                                           MemoryOrder::Relaxed));
+                        return;
+                }
+
+                static uint32_t pop(Atomic<uint64_t> &head, Node *nodes) {
+                        uint64_t old = head.load(MemoryOrder::Acquire);
+                        for (;;) {
+                                const uint32_t index = static_cast<uint32_t>(old);
+                                if (index == Nil) return Nil;
+                                const uint32_t next = nodes[index].next.load(MemoryOrder::Relaxed);
+                                if (head.compareExchangeWeak(old, pack(old, next), MemoryOrder::Acquire,
+                                                             MemoryOrder::Acquire)) {
+                                        return index;
+                                }
+                        }
+                }
+
+                // ---- Size classes ----
+
+                // Classes are claimed front to back, so the first unclaimed
+                // slot ends the search.  A slot mid-claim is only briefly
+                // in that state (one node-array allocation); spin past it
+                // so two threads asking for the same new size agree on one
+                // class.
+                SizeClass *findClass(size_t classBytes, bool claim) const {
+                        for (size_t i = 0; i < MaxSizeClasses; ++i) {
+                                SizeClass &c = classes[i];
+                                for (;;) {
+                                        size_t b = c.bytes.value();
+                                        if (b == Claiming) {
+                                                std::this_thread::yield();
+                                                continue;
+                                        }
+                                        if (b == classBytes) return &c;
+                                        if (b != Unclaimed) break;
+                                        if (!claim) return nullptr;
+                                        if (!c.bytes.compareAndSwap(b, Claiming)) continue;
+                                        setupClass(c);
+                                        c.bytes.setValue(classBytes);
+                                        return &c;
+                                }
+                        }
+                        return nullptr;
+                }
+
+                void setupClass(SizeClass &c) const {
+                        const size_t count = config.maxBuffersPerClass;
+                        if (count == 0) return;
+                        c.nodes = new Node[count];
+                        for (size_t i = 0; i + 1 < count; ++i) {
+                                c.nodes[i].next.store(static_cast<uint32_t>(i + 1), MemoryOrder::Relaxed);
+                        }
+                        c.spareHead.store(0, MemoryOrder::Release);
+                        return;
+                }
+
+                // ---- Blocks ----
+
+                bool allocBlock(SizeClass &c, uint32_t node) const {
+                        MemAllocation a = config.memSpace.alloc(c.bytes.value(), config.alignment);
+                        if (!a.isValid()) return false;
+                        if (!config.memSpace.isHostAccessible(a)) {
+                                // Pooled blocks are host-mapped; a device
+                                // space falls back to plain Buffers for good.
+                                config.memSpace.release(a);
+                                hostAccessible.setValue(false);
+                                return false;
+                        }
+                        c.nodes[node].alloc = a;
+                        return true;
+                }
+
+                void freeBlock(SizeClass &c, uint32_t node) const {
+                        config.memSpace.release(c.nodes[node].alloc);
+                        push(c.spareHead, c.nodes, node);
+                        return;
+                }
+
+                void recycle(SizeClass &c, uint32_t node) const {
+                        if (c.idleCount.fetchAndAdd(1) >= config.highWatermark) {
+                                c.idleCount.fetchAndSub(1);
+                                freeBlock(c, node);
+                                return;
+                        }
+                        push(c.idleHead, c.nodes, node);
+                        return;
+                }
+
+                void drain(SizeClass &c, size_t keep) const {
+                        while (c.idleCount.value() > keep) {
+                                const uint32_t node = pop(c.idleHead, c.nodes);
+                                if (node == Nil) break;
+                                c.idleCount.fetchAndSub(1);
+                                freeBlock(c, node);
+                        }
+                        return;
+                }
+
+                void fill(SizeClass &c, size_t count) const {
+                        if (count > config.highWatermark) count = config.highWatermark;
+                        while (c.idleCount.value() < count) {
+                                const uint32_t node = pop(c.spareHead, c.nodes);
+                                if (node == Nil) break;
+                                if (!allocBlock(c, node)) {
+                                        push(c.spareHead, c.nodes, node);
+                                        break;
+                                }
+                                recycle(c, node);
+                        }
+                        return;
+                }
+
+                static Buffer acquire(const PoolPtr &self, size_t bytes, size_t align) {
+                        const Pool &p = *self;
+                        if (bytes == 0) return Buffer();
+                        SizeClass *c = nullptr;
+                        if (align <= p.config.alignment && p.hostAccessible.value()) {
+                                c = p.findClass(p.classBytesFor(bytes), true);
+                        }
+                        if (c != nullptr && c->nodes != nullptr) {
+                                uint32_t node = pop(c->idleHead, c->nodes);
+                                if (node != Nil) {
+                                        c->idleCount.fetchAndSub(1);
+                                        p.stats().poolHitCount.fetchAndAdd(1);
+                                        return Buffer::fromImpl(new BlockImpl(self, c, node, bytes));
+                                }
+                                p.stats().poolMissCount.fetchAndAdd(1);
+                                node = pop(c->spareHead, c->nodes);
+                                if (node != Nil) {
+                                        if (p.allocBlock(*c, node)) {
+                                                return Buffer::fromImpl(new BlockImpl(self, c, node, bytes));
+                                        }
+                                        push(c->spareHead, c->nodes, node);
+                                }
+                        } else {
+                                p.stats().poolMissCount.fetchAndAdd(1);
+                        }
+                        // Every tracked block is in flight, the class table
+                        // is full, or the request can't be pooled: plain
+                        // allocation, freed normally when it drops.
+                        return Buffer(bytes, align > p.config.alignment ? align : p.config.alignment,
+                                      p.config.memSpace);
+                }
+};
+
+// ============================================================================
+// BufferPool
+// ============================================================================
+
+BufferPool::BufferPool() : BufferPool(Config()) {}
+
+BufferPool::BufferPool(size_t bufferSize, size_t alignment, const MemSpace &ms) : BufferPool([&] {
+        Config cfg;
+        cfg.bufferSize = bufferSize;
+        cfg.alignment = alignment;
+        cfg.memSpace = ms;
+        return cfg;
+}()) {}
+
+BufferPool::BufferPool(const Config &config) : _pool(PoolPtr::create(config)) {
+        if (_pool->config.bufferSize > 0) {
+                _pool->findClass(_pool->classBytesFor(_pool->config.bufferSize), true);
         }
 }
 
-Buffer BufferPool::acquire() {
-        if (!_free.isEmpty()) {
-                Buffer buf = std::move(_free[_free.size() - 1]);
-                _free.popFromBack();
-                // Reset user-visible state: size() back to 0 and shiftData
-                // back to the base. The caller treats the returned buffer
-                // as freshly allocated.
-                buf.shiftData(0);
-                return buf;
+BufferPool::~BufferPool() = default;
+BufferPool::BufferPool(const BufferPool &other) = default;
+BufferPool::BufferPool(BufferPool &&other) noexcept = default;
+BufferPool &BufferPool::operator=(const BufferPool &other) = default;
+BufferPool &BufferPool::operator=(BufferPool &&other) noexcept = default;
+
+size_t BufferPool::bufferSize() const {
+        return _pool.isValid() ? _pool->config.bufferSize : 0;
+}
+
+size_t BufferPool::alignment() const {
+        return _pool.isValid() ? _pool->config.alignment : 0;
+}
+
+MemSpace BufferPool::memSpace() const {
+        return _pool.isValid() ? _pool->config.memSpace : MemSpace();
+}
+
+const BufferPool::Config &BufferPool::config() const {
+        static const Config empty;
+        return _pool.isValid() ? _pool->config : empty;
+}
+
+size_t BufferPool::available() const {
+        if (!_pool.isValid()) return 0;
+        size_t total = 0;
+        for (const Pool::SizeClass &c : _pool->classes) total += c.idleCount.value();
+        return total;
+}
+
+size_t BufferPool::available(size_t bytes) const {
+        if (!_pool.isValid() || bytes == 0) return 0;
+        const Pool::SizeClass *c = _pool->findClass(_pool->classBytesFor(bytes), false);
+        return c != nullptr ? c->idleCount.value() : 0;
+}
+
+size_t BufferPool::sizeClassCount() const {
+        if (!_pool.isValid()) return 0;
+        size_t count = 0;
+        for (const Pool::SizeClass &c : _pool->classes) {
+                if (Pool::isClaimed(c)) count++;
         }
-        return Buffer(_bufferSize, _alignment, _memSpace);
+        return count;
+}
+
+void BufferPool::reserve(size_t count) {
+        if (!_pool.isValid() || _pool->config.bufferSize == 0) return;
+        reserve(count, _pool->config.bufferSize);
+        return;
+}
+
+void BufferPool::reserve(size_t count, size_t bytes) {
+        if (!_pool.isValid() || bytes == 0 || !_pool->hostAccessible.value()) return;
+        Pool::SizeClass *c = _pool->findClass(_pool->classBytesFor(bytes), true);
+        if (c == nullptr || c->nodes == nullptr) return;
+        _pool->fill(*c, count);
+        return;
+}
+
+Buffer BufferPool::acquire() {
+        if (!_pool.isValid() || _pool->config.bufferSize == 0) return Buffer();
+        return Pool::acquire(_pool, _pool->config.bufferSize, 0);
+}
+
+Buffer BufferPool::acquire(size_t bytes, size_t align) {
+        if (!_pool.isValid()) return Buffer();
+        return Pool::acquire(_pool, bytes, align);
 }
 
 void BufferPool::release(Buffer &&buf) {
-        if (!buf.isValid()) return;
-        // Reject shape mismatches — it's almost certainly a bug to pass
-        // a different-geometry buffer into a fixed-geometry pool.
-        if (buf.allocSize() != _bufferSize || buf.align() != _alignment) return;
-        // Reset user-visible state so next acquire gets a fresh view.
-        buf.shiftData(0);
-        buf.setSize(0);
-        _free.pushToBack(std::move(buf));
+        // Dropping the handle is the release: a pooled block goes home
+        // from its BufferImpl's destructor once no other handle holds it.
+        Buffer dropped = std::move(buf);
+        (void)dropped;
+        return;
+}
+
+void BufferPool::trim() {
+        if (!_pool.isValid()) return;
+        for (Pool::SizeClass &c : _pool->classes) {
+                if (Pool::isClaimed(c) && c.nodes != nullptr) _pool->drain(c, _pool->config.lowWatermark);
+        }
+        return;
 }
 
 void BufferPool::clear() {
-        _free.clear();
+        if (!_pool.isValid()) return;
+        for (Pool::SizeClass &c : _pool->classes) {
+                if (Pool::isClaimed(c) && c.nodes != nullptr) _pool->drain(c, 0);
+        }
+        return;
 }
 
 PROMEKI_NAMESPACE_END
@@ -5,7 +5,26 @@
  * See LICENSE file in the project root folder for license information.
  */
 
+#include <cstring>
 #include <promeki/crc.h>
+#include <promeki/list.h>
+#include <promeki/mutex.h>
+#include <promeki/platform.h>
+#include <promeki/system.h>
+#include <promeki/uniqueptr.h>
+
+// Carry-less multiply folding is compiled in on x86-64 with GCC/Clang
+// (selected at runtime from CPUID) and on AArch64 when the compiler
+// already targets the crypto extension (PMULL is then always present).
+#if PROMEKI_ARCH_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define PROMEKI_CRC_CLMUL_X86 1
+#include <immintrin.h>
+#define PROMEKI_CRC_CLMUL_TARGET __attribute__((target("pclmul,sse2")))
+#elif PROMEKI_ARCH_AARCH64 && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define PROMEKI_CRC_CLMUL_ARM 1
+#include <arm_neon.h>
+#define PROMEKI_CRC_CLMUL_TARGET
+#endif
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -29,24 +48,248 @@ namespace {
                 return static_cast<T>(~T(0));
         }
 
+        inline uint64_t loadLE64(const uint8_t *p) {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                if constexpr (System::isBigEndian()) System::swapEndian(v);
+                return v;
+        }
+
+        inline uint64_t loadBE64(const uint8_t *p) {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                if constexpr (System::isLittleEndian()) System::swapEndian(v);
+                return v;
+        }
+
+        // Number of slice tables kept per parameter set (slice-by-16).
+        constexpr int SliceTables = 16;
+
+        // XOR of eight slice-table lookups for one 64-bit word.  @p t
+        // points at the table for the word's last byte; earlier bytes
+        // use the tables after it.  The LE form takes the first input
+        // byte from the low end of the word, the BE form from the high
+        // end.
+        template <typename T> inline T sliceLE(const T (*t)[256], uint64_t v) {
+                return static_cast<T>(t[7][v & 0xff] ^ t[6][(v >> 8) & 0xff] ^ t[5][(v >> 16) & 0xff] ^
+                                      t[4][(v >> 24) & 0xff] ^ t[3][(v >> 32) & 0xff] ^ t[2][(v >> 40) & 0xff] ^
+                                      t[1][(v >> 48) & 0xff] ^ t[0][v >> 56]);
+        }
+
+        template <typename T> inline T sliceBE(const T (*t)[256], uint64_t v) {
+                return static_cast<T>(t[7][v >> 56] ^ t[6][(v >> 48) & 0xff] ^ t[5][(v >> 40) & 0xff] ^
+                                      t[4][(v >> 32) & 0xff] ^ t[3][(v >> 24) & 0xff] ^ t[2][(v >> 16) & 0xff] ^
+                                      t[1][(v >> 8) & 0xff] ^ t[0][v & 0xff]);
+        }
+
+        // Inputs shorter than this never reach the folding kernel: it
+        // needs four 16-byte lanes to start and the setup only pays off
+        // past a few blocks.
+        constexpr size_t ClmulMinBytes = 64;
+
+        // Folding constants for a reflected 32-bit polynomial, laid out
+        // as the kernel loads them (low lane first).  Derived in
+        // @ref buildClmulConstants; see Gopal et al., "Fast CRC
+        // Computation for Generic Polynomials Using PCLMULQDQ".
+        struct ClmulConstants {
+                        alignas(16) uint64_t k1k2[2];
+                        alignas(16) uint64_t k3k4[2];
+                        alignas(16) uint64_t k5k0[2];
+                        alignas(16) uint64_t poly[2];
+        };
+
+        // x^e mod P for the 33-bit polynomial @p p33, in normal bit order.
+        uint64_t xPowMod(int e, uint64_t p33) {
+                uint64_t r = 1;
+                for (int i = 0; i < e; i++) {
+                        r <<= 1;
+                        if (r & (uint64_t(1) << 32)) r ^= p33;
+                }
+                return r;
+        }
+
+        // floor(x^64 / P) for the 33-bit polynomial @p p33.
+        uint64_t xPow64Div(uint64_t p33) {
+                uint64_t q = 0;
+                uint64_t r = 0;
+                for (int i = 64; i >= 0; i--) {
+                        r = (r << 1) | (i == 64 ? 1u : 0u);
+                        if (r & (uint64_t(1) << 32)) {
+                                r ^= p33;
+                                q |= uint64_t(1) << i;
+                        }
+                }
+                return q;
+        }
+
+        ClmulConstants buildClmulConstants(uint32_t poly) {
+                const uint64_t p33 = (uint64_t(1) << 32) | poly;
+                auto           fold = [p33](int e) {
+                        return uint64_t(reflectBits<uint32_t>(static_cast<uint32_t>(xPowMod(e, p33)), 32)) << 1;
+                };
+                ClmulConstants c{};
+                c.k1k2[0] = fold(4 * 128 + 32);
+                c.k1k2[1] = fold(4 * 128 - 32);
+                c.k3k4[0] = fold(128 + 32);
+                c.k3k4[1] = fold(128 - 32);
+                c.k5k0[0] = fold(64);
+                c.k5k0[1] = 0;
+                c.poly[0] = reflectBits<uint64_t>(p33, 33);
+                c.poly[1] = reflectBits<uint64_t>(xPow64Div(p33), 33);
+                return c;
+        }
+
+#if defined(PROMEKI_CRC_CLMUL_X86) || defined(PROMEKI_CRC_CLMUL_ARM)
+
+#if defined(PROMEKI_CRC_CLMUL_X86)
+        // The handful of 128-bit operations the folding kernel needs,
+        // so the algorithm below is written once for both ISAs.
+        struct ClmulOps {
+                        using V = __m128i;
+                        PROMEKI_CRC_CLMUL_TARGET static V load(const uint8_t *p) {
+                                return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                        }
+                        PROMEKI_CRC_CLMUL_TARGET static V load(const uint64_t *k) {
+                                return _mm_load_si128(reinterpret_cast<const __m128i *>(k));
+                        }
+                        PROMEKI_CRC_CLMUL_TARGET static V fromU32(uint32_t v) {
+                                return _mm_cvtsi32_si128(static_cast<int>(v));
+                        }
+                        PROMEKI_CRC_CLMUL_TARGET static V lowMask32() { return _mm_setr_epi32(~0, 0, ~0, 0); }
+                        PROMEKI_CRC_CLMUL_TARGET static V xor2(V a, V b) { return _mm_xor_si128(a, b); }
+                        PROMEKI_CRC_CLMUL_TARGET static V and2(V a, V b) { return _mm_and_si128(a, b); }
+                        PROMEKI_CRC_CLMUL_TARGET static V shr8(V a) { return _mm_srli_si128(a, 8); }
+                        PROMEKI_CRC_CLMUL_TARGET static V shr4(V a) { return _mm_srli_si128(a, 4); }
+                        PROMEKI_CRC_CLMUL_TARGET static V mulLoLo(V a, V b) { return _mm_clmulepi64_si128(a, b, 0x00); }
+                        PROMEKI_CRC_CLMUL_TARGET static V mulHiHi(V a, V b) { return _mm_clmulepi64_si128(a, b, 0x11); }
+                        PROMEKI_CRC_CLMUL_TARGET static V mulLoHi(V a, V b) { return _mm_clmulepi64_si128(a, b, 0x10); }
+                        PROMEKI_CRC_CLMUL_TARGET static uint32_t lane1(V a) {
+                                return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(a, 4)));
+                        }
+        };
+#else
+        struct ClmulOps {
+                        using V = uint64x2_t;
+                        static V load(const uint8_t *p) { return vreinterpretq_u64_u8(vld1q_u8(p)); }
+                        static V load(const uint64_t *k) { return vld1q_u64(k); }
+                        static V fromU32(uint32_t v) { return vsetq_lane_u64(v, vdupq_n_u64(0), 0); }
+                        static V lowMask32() { return vdupq_n_u64(0xFFFFFFFFull); }
+                        static V xor2(V a, V b) { return veorq_u64(a, b); }
+                        static V and2(V a, V b) { return vandq_u64(a, b); }
+                        static V shr8(V a) {
+                                return vreinterpretq_u64_u8(vextq_u8(vreinterpretq_u8_u64(a), vdupq_n_u8(0), 8));
+                        }
+                        static V shr4(V a) {
+                                return vreinterpretq_u64_u8(vextq_u8(vreinterpretq_u8_u64(a), vdupq_n_u8(0), 4));
+                        }
+                        static V mul(uint64_t a, uint64_t b) { return vreinterpretq_u64_p128(vmull_p64(a, b)); }
+                        static V mulLoLo(V a, V b) { return mul(vgetq_lane_u64(a, 0), vgetq_lane_u64(b, 0)); }
+                        static V mulHiHi(V a, V b) { return mul(vgetq_lane_u64(a, 1), vgetq_lane_u64(b, 1)); }
+                        static V mulLoHi(V a, V b) { return mul(vgetq_lane_u64(a, 0), vgetq_lane_u64(b, 1)); }
+                        static uint32_t lane1(V a) { return vgetq_lane_u32(vreinterpretq_u32_u64(a), 1); }
+        };
+#endif
+
+        // Folds @p len bytes (a multiple of 16, at least 64) into the
+        // reflected CRC-32 register @p crc: four lanes folded 64 bytes
+        // at a time, reduced to one lane, folded 16 bytes at a time,
+        // then 128 -> 64 -> 32 bits with a final Barrett reduction.
+        PROMEKI_CRC_CLMUL_TARGET uint32_t clmulFold(uint32_t crc, const uint8_t *p, size_t len,
+                                                    const ClmulConstants &c) {
+                using O = ClmulOps;
+                using V = O::V;
+                V x1 = O::xor2(O::load(p), O::fromU32(crc));
+                V x2 = O::load(p + 16);
+                V x3 = O::load(p + 32);
+                V x4 = O::load(p + 48);
+                V k = O::load(c.k1k2);
+                p += 64;
+                len -= 64;
+                while (len >= 64) {
+                        x1 = O::xor2(O::xor2(O::mulHiHi(x1, k), O::mulLoLo(x1, k)), O::load(p));
+                        x2 = O::xor2(O::xor2(O::mulHiHi(x2, k), O::mulLoLo(x2, k)), O::load(p + 16));
+                        x3 = O::xor2(O::xor2(O::mulHiHi(x3, k), O::mulLoLo(x3, k)), O::load(p + 32));
+                        x4 = O::xor2(O::xor2(O::mulHiHi(x4, k), O::mulLoLo(x4, k)), O::load(p + 48));
+                        p += 64;
+                        len -= 64;
+                }
+
+                k = O::load(c.k3k4);
+                x1 = O::xor2(O::xor2(O::mulHiHi(x1, k), O::mulLoLo(x1, k)), x2);
+                x1 = O::xor2(O::xor2(O::mulHiHi(x1, k), O::mulLoLo(x1, k)), x3);
+                x1 = O::xor2(O::xor2(O::mulHiHi(x1, k), O::mulLoLo(x1, k)), x4);
+                while (len >= 16) {
+                        x1 = O::xor2(O::xor2(O::mulHiHi(x1, k), O::mulLoLo(x1, k)), O::load(p));
+                        p += 16;
+                        len -= 16;
+                }
+
+                // 128 -> 64 bits.
+                const V mask = O::lowMask32();
+                x1 = O::xor2(O::shr8(x1), O::mulLoHi(x1, k));
+                x1 = O::xor2(O::mulLoLo(O::and2(x1, mask), O::load(c.k5k0)), O::shr4(x1));
+
+                // Barrett reduction to 32 bits.
+                const V pu = O::load(c.poly);
+                V       t = O::and2(O::mulLoHi(O::and2(x1, mask), pu), mask);
+                t = O::mulLoLo(t, pu);
+                return O::lane1(O::xor2(x1, t));
+        }
+
+        bool cpuHasClmul() {
+#if defined(PROMEKI_CRC_CLMUL_X86)
+                static const bool has = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+                return has;
+#else
+                return true;
+#endif
+        }
+
+#else // no folding kernel on this target
+
+        uint32_t clmulFold(uint32_t crc, const uint8_t *, size_t, const ClmulConstants &) { return crc; }
+
+        bool cpuHasClmul() { return false; }
+
+#endif
+
 } // namespace
 
-template <typename T> CRC<T>::CRC(const Params &params) : _params(params), _crc(params.init) {
-        buildTable();
-}
+/**
+ * Immutable per-(poly, reflect) lookup data shared by every CRC<T>
+ * with those parameters.  @c slice[0] is the classic bytewise table;
+ * @c slice[k][b] is the register contribution of byte @c b followed
+ * by @c k zero bytes, which is what the slice-by-N loops combine.
+ */
+template <typename T> struct CRC<T>::Tables {
+                T              poly = 0;
+                bool           reflect = false;
+                ClmulConstants clmulConstants{};
+                T              slice[SliceTables][256]{};
+};
 
-template <typename T> void CRC<T>::reset() {
-        _crc = _params.init;
-}
+template <typename T> const typename CRC<T>::Tables *CRC<T>::tablesFor(const Params &params) {
+        // Table sets live until exit: a program only ever uses a
+        // handful of distinct polynomials, and handing out raw pointers
+        // keeps CRC construction to one short locked scan.
+        static Mutex                    mutex;
+        static List<UniquePtr<Tables>> cache;
+        Mutex::Locker                   lock(mutex);
+        for (const UniquePtr<Tables> &t : cache) {
+                if (t->poly == params.poly && t->reflect == params.reflect) return t.get();
+        }
 
-template <typename T> void CRC<T>::buildTable() {
-        constexpr int W = Width;
-        const T       mask = fullMask<T>();
-        if (_params.reflect) {
+        constexpr int     W = Width;
+        const T           mask = fullMask<T>();
+        UniquePtr<Tables> owned = UniquePtr<Tables>::create();
+        Tables           *t = owned.get();
+        t->poly = params.poly;
+        t->reflect = params.reflect;
+        if (params.reflect) {
                 // Reflected mode: use the bit-reflected polynomial and a
                 // shift-right algorithm.  Each table entry is the CRC of
                 // a single byte fed in starting from a zeroed register.
-                const T polyR = reflectBits<T>(_params.poly, W);
+                const T polyR = reflectBits<T>(params.poly, W);
                 for (int b = 0; b < 256; b++) {
                         T crc = static_cast<T>(b);
                         for (int i = 0; i < 8; i++) {
@@ -56,7 +299,14 @@ template <typename T> void CRC<T>::buildTable() {
                                         crc = static_cast<T>(crc >> 1);
                                 }
                         }
-                        _table[b] = crc;
+                        t->slice[0][b] = crc;
+                }
+                for (int k = 1; k < SliceTables; k++) {
+                        for (int b = 0; b < 256; b++) {
+                                const T prev = t->slice[k - 1][b];
+                                t->slice[k][b] = static_cast<T>((W > 8 ? (prev >> 8) : T(0)) ^
+                                                                t->slice[0][prev & 0xffu]);
+                        }
                 }
         } else {
                 // Unreflected mode: shift-left algorithm with the
@@ -67,45 +317,130 @@ template <typename T> void CRC<T>::buildTable() {
                         T crc = static_cast<T>(static_cast<T>(b) << (W - 8));
                         for (int i = 0; i < 8; i++) {
                                 if (crc & topBit) {
-                                        crc = static_cast<T>(((crc << 1) ^ _params.poly) & mask);
+                                        crc = static_cast<T>(((crc << 1) ^ params.poly) & mask);
                                 } else {
                                         crc = static_cast<T>((crc << 1) & mask);
                                 }
                         }
-                        _table[b] = crc;
+                        t->slice[0][b] = crc;
                 }
+                for (int k = 1; k < SliceTables; k++) {
+                        for (int b = 0; b < 256; b++) {
+                                const T prev = t->slice[k - 1][b];
+                                const T shifted = W > 8 ? static_cast<T>((prev << 8) & mask) : T(0);
+                                t->slice[k][b] = static_cast<T>(shifted ^ t->slice[0][(prev >> (W - 8)) & 0xffu]);
+                        }
+                }
+        }
+        if constexpr (W == 32) {
+                if (params.reflect) t->clmulConstants = buildClmulConstants(params.poly);
         }
+        cache.pushToBack(std::move(owned));
+        return t;
+}
+
+template <typename T> bool CRC<T>::isEngineSupported(const Params &params, CrcEngine engine) {
+        if (engine != CrcEngine::Clmul) return true;
+        return Width == 32 && params.reflect && cpuHasClmul();
+}
+
+template <typename T> CrcEngine CRC<T>::resolveEngine(const Params &params, CrcEngine engine) {
+        if (engine != CrcEngine::Auto) return engine;
+        if (isEngineSupported(params, CrcEngine::Clmul)) return CrcEngine::Clmul;
+        // Sixteen 64-bit tables are 32 KiB, a whole L1D on most cores;
+        // slice-by-8 is the better trade for CRC-64.
+        return Width == 64 ? CrcEngine::Slice8 : CrcEngine::Slice16;
+}
+
+template <typename T>
+CRC<T>::CRC(const Params &params)
+    : _params(params), _tables(tablesFor(params)), _engine(resolveEngine(params, CrcEngine::Auto)),
+      _crc(params.init) {}
+
+template <typename T> void CRC<T>::reset() {
+        _crc = _params.init;
+}
+
+template <typename T> Error CRC<T>::setEngine(CrcEngine engine) {
+        if (!isEngineSupported(_params, engine)) return Error::NotSupported;
+        _engine = resolveEngine(_params, engine);
+        return Error::Ok;
 }
 
 template <typename T> void CRC<T>::update(const void *data, size_t len) {
         const uint8_t *p = static_cast<const uint8_t *>(data);
         constexpr int  W = Width;
         const T        mask = fullMask<T>();
+        const T(*t)[256] = _tables->slice;
+        T crc = _crc;
+
+        if constexpr (W == 32) {
+                if (_engine == CrcEngine::Clmul && len >= ClmulMinBytes) {
+                        const size_t n = len & ~size_t(15);
+                        crc = clmulFold(crc, p, n, _tables->clmulConstants);
+                        p += n;
+                        len -= n;
+                }
+        }
+
+        // Slice-by-N: fold the register into the first 8 bytes of the
+        // block, then look every byte up in the table for its distance
+        // from the end of the block.  Valid for any width up to 64
+        // bits because the register never spans more than 8 bytes.
+        const bool slice16 = _engine == CrcEngine::Slice16 || _engine == CrcEngine::Clmul;
         if (_params.reflect) {
-                T crc = _crc;
+                if (slice16) {
+                        while (len >= 16) {
+                                const uint64_t a = loadLE64(p) ^ static_cast<uint64_t>(crc);
+                                crc = static_cast<T>(sliceLE<T>(t + 8, a) ^ sliceLE<T>(t, loadLE64(p + 8)));
+                                p += 16;
+                                len -= 16;
+                        }
+                }
+                if (slice16 || _engine == CrcEngine::Slice8) {
+                        while (len >= 8) {
+                                crc = sliceLE<T>(t, loadLE64(p) ^ static_cast<uint64_t>(crc));
+                                p += 8;
+                                len -= 8;
+                        }
+                }
                 for (size_t i = 0; i < len; i++) {
                         const uint8_t idx = static_cast<uint8_t>((crc ^ p[i]) & 0xffu);
-                        crc = static_cast<T>(_table[idx] ^ (crc >> 8));
+                        crc = static_cast<T>(t[0][idx] ^ (W > 8 ? (crc >> 8) : T(0)));
                 }
-                _crc = crc;
         } else {
-                T crc = _crc;
+                // Unreflected: the register lines up with the top of a
+                // big-endian 64-bit load.
+                constexpr int Align = 64 - W;
+                if (slice16) {
+                        while (len >= 16) {
+                                const uint64_t a = loadBE64(p) ^ (static_cast<uint64_t>(crc) << Align);
+                                crc = static_cast<T>(sliceBE<T>(t + 8, a) ^ sliceBE<T>(t, loadBE64(p + 8)));
+                                p += 16;
+                                len -= 16;
+                        }
+                }
+                if (slice16 || _engine == CrcEngine::Slice8) {
+                        while (len >= 8) {
+                                crc = sliceBE<T>(t, loadBE64(p) ^ (static_cast<uint64_t>(crc) << Align));
+                                p += 8;
+                                len -= 8;
+                        }
+                }
                 if constexpr (W == 8) {
                         // 8-bit unreflected: register is exactly one byte;
                         // the standard "crc >> (W-8)" lookup degenerates to
                         // just XORing the input byte with the register.
-                        for (size_t i = 0; i < len; i++) {
-                                const uint8_t idx = static_cast<uint8_t>(crc ^ p[i]);
-                                crc = _table[idx];
-                        }
+                        for (size_t i = 0; i < len; i++) crc = t[0][static_cast<uint8_t>(crc ^ p[i])];
                 } else {
                         for (size_t i = 0; i < len; i++) {
                                 const uint8_t idx = static_cast<uint8_t>((crc >> (W - 8)) ^ p[i]);
-                                crc = static_cast<T>(((crc << 8) ^ _table[idx]) & mask);
+                                crc = static_cast<T>(((crc << 8) ^ t[0][idx]) & mask);
                         }
                 }
-                _crc = crc;
         }
+        _crc = crc;
+        return;
 }
 
 template <typename T> T CRC<T>::value() const {
@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <poll.h>
 #if defined(PROMEKI_PLATFORM_LINUX)
+#include <sys/epoll.h>
 #include <sys/eventfd.h>
 #endif
 #endif
@@ -137,29 +138,345 @@ void EventLoopWakeFd::drain() {}
 #endif
 
 // ============================================================================
-// EventLoopPollCache
+// EventLoopPoller
 // ============================================================================
 //
-// Caches the pollfd array passed to poll() in waitOnSources.  The
-// array changes only when an IoSource is added or removed, yet
-// waitOnSources runs on every wake — rebuilding an N-entry array
-// (plus the wake fd at index 0) each time makes a loop servicing
-// many descriptors do O(N) work per wake even when nothing changed.
-// The cache holds the last-built array and a dirty flag; the loop
-// thread rebuilds only when the flag is set.  Index 0 is always the
-// wake fd; index i+1 mirrors _ioSources[i] — the alignment
-// waitOnSources relies on when mapping ready revents back to sources.
+// The readiness backend waitOnSources blocks in.  Two strategies:
 //
-// pollfd is POSIX-only.  On other platforms the struct is empty so
-// the UniquePtr member still has a complete type to construct and
-// destroy; waitOnSources never touches it there.
+//  - epoll (Linux).  Each fd is registered with the kernel once, in
+//    addIoSource, so registration is O(1) and a wait returns only
+//    the descriptors that are actually ready — the loop's per-wake
+//    cost tracks the ready set, not the number of registered
+//    sources.  Level-triggered, so the dispatch semantics match
+//    poll() exactly.  epoll rejects a second registration of the
+//    same fd, but two handles on one fd are legal through the
+//    EventLoop API, so registrations are grouped per fd and the
+//    kernel interest mask is the union of the group.  epoll also
+//    refuses (EPERM) descriptors that are always ready — regular
+//    files, /dev/null — which poll() simply reports as readable and
+//    writable.  Those go on an always-ready list instead: a wait
+//    with any of them registered does not block, and every wake
+//    reports them ready, just as poll() would.
+//
+//  - poll() (other POSIX platforms, or Linux when epoll_create1
+//    fails).  The pollfd array is cached and rebuilt only when a
+//    source is added or removed; index 0 is the wake fd and index
+//    i+1 belongs to the handle in _pfdHandles[i].
+//
+// add / remove / prepare / collect are called with the owning
+// EventLoop's _ioMutex held.  wait runs on the loop thread without
+// the lock; the state it touches (the pollfd array, the epoll event
+// buffer) is only ever written by the loop thread.  epoll_ctl and
+// epoll_wait are safe to call concurrently, so an add from another
+// thread takes effect in a wait that is already blocked.
 #if defined(PROMEKI_PLATFORM_POSIX)
-struct EventLoopPollCache {
-        List<pollfd> pfds;
-        bool         dirty = true;
+class EventLoopPoller {
+        public:
+                /// A handle the last wait found ready, with the @c Io* bits it is ready for.
+                struct Ready {
+                                int      handle;
+                                uint32_t events;
+                };
+
+                explicit EventLoopPoller(int wakeFd);
+                ~EventLoopPoller();
+
+                EventLoopPoller(const EventLoopPoller &) = delete;
+                EventLoopPoller &operator=(const EventLoopPoller &) = delete;
+
+                /// Returns the backend name reported in EventLoop::Report::ioBackend.
+                const char *name() const;
+
+                /// Registers @p handle for @p events (Io* bits) on @p fd.
+                /// Returns false, with errno set, if the backend refused the fd.
+                bool add(int handle, int fd, uint32_t events);
+
+                /// Drops the registration added under @p handle.
+                void remove(int handle, int fd);
+
+                /// Brings the wait set up to date before a wait.
+                void prepare();
+
+                /// Blocks for up to @p timeoutMs (-1 = forever).  Returns the
+                /// ready count (always-ready sources included), 0 on timeout,
+                /// or -1 with errno set.
+                int wait(int timeoutMs);
+
+                /// True when the last wait reported the wake fd readable.
+                bool wakeFired() const { return _wakeFired; }
+
+                /// Appends every ready registration from the last wait to @p out.
+                void collect(List<Ready> &out) const;
+
+        private:
+                struct Registration {
+                                int      handle;
+                                int      fd;
+                                uint32_t events;
+                };
+
+                int  _wakeFd = -1;
+                bool _wakeFired = false;
+
+#if defined(PROMEKI_PLATFORM_LINUX)
+                static constexpr int MaxEpollEvents = 64;
+
+                int                              _epollFd = -1;
+                HashMap<int, List<Registration>> _byFd;
+                epoll_event                      _events[MaxEpollEvents];
+                int                              _eventCount = 0;
+                List<Registration>               _alwaysReady;          ///< fds epoll refused with EPERM.
+                size_t                           _alwaysReadyCount = 0; ///< Snapshot taken by prepare().
+
+                int             epollUpdate(int fd, bool existed);
+                static uint32_t epollMask(const List<Registration> &regs);
+#endif
+
+                // poll() fallback state.
+                List<Registration> _regs;
+                List<pollfd>       _pfds;
+                List<int>          _pfdHandles;
+                bool               _dirty = true;
+
+                static uint32_t readyBits(uint32_t wanted, bool in, bool out, bool err);
 };
+
+EventLoopPoller::EventLoopPoller(int wakeFd) : _wakeFd(wakeFd) {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_wakeFd < 0) return;
+        int efd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (efd < 0) {
+                promekiWarn("EventLoop: epoll_create1() failed (errno %d: %s), using poll()", errno,
+                            std::strerror(errno));
+                return;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = _wakeFd;
+        if (::epoll_ctl(efd, EPOLL_CTL_ADD, _wakeFd, &ev) < 0) {
+                promekiWarn("EventLoop: epoll_ctl(wake fd) failed (errno %d: %s), using poll()", errno,
+                            std::strerror(errno));
+                ::close(efd);
+                return;
+        }
+        _epollFd = efd;
+#endif
+}
+
+EventLoopPoller::~EventLoopPoller() {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) ::close(_epollFd);
+        _epollFd = -1;
+#endif
+}
+
+const char *EventLoopPoller::name() const {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) return "epoll";
+#endif
+        return "poll";
+}
+
+uint32_t EventLoopPoller::readyBits(uint32_t wanted, bool in, bool out, bool err) {
+        uint32_t ready = 0;
+        if (in && (wanted & EventLoop::IoRead)) ready |= EventLoop::IoRead;
+        if (out && (wanted & EventLoop::IoWrite)) ready |= EventLoop::IoWrite;
+        if (err) ready |= EventLoop::IoError;
+        return ready;
+}
+
+#if defined(PROMEKI_PLATFORM_LINUX)
+
+uint32_t EventLoopPoller::epollMask(const List<Registration> &regs) {
+        uint32_t mask = 0;
+        for (const Registration &r : regs) {
+                if (r.events & EventLoop::IoRead) mask |= EPOLLIN;
+                if (r.events & EventLoop::IoWrite) mask |= EPOLLOUT;
+        }
+        return mask;
+}
+
+int EventLoopPoller::epollUpdate(int fd, bool existed) {
+        auto it = _byFd.find(fd);
+        if (it == _byFd.end() || it->second.isEmpty()) {
+                if (it != _byFd.end()) _byFd.remove(it);
+                // Failure here is expected when the caller closed the
+                // fd before removing it — close() already dropped it
+                // from the interest list.
+                if (existed) ::epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                return 0;
+        }
+        epoll_event ev{};
+        ev.events = epollMask(it->second);
+        ev.data.fd = fd;
+        int op = existed ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        int rc = ::epoll_ctl(_epollFd, op, fd, &ev);
+        // A registration left behind for an fd that was closed and
+        // then reused by a new descriptor is gone from the kernel's
+        // interest list, so MOD misses: add it back fresh.
+        if (rc < 0 && op == EPOLL_CTL_MOD && errno == ENOENT) rc = ::epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &ev);
+        return rc < 0 ? errno : 0;
+}
+
+#endif
+
+bool EventLoopPoller::add(int handle, int fd, uint32_t events) {
+        Registration reg{handle, fd, events};
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) {
+                for (const Registration &r : _alwaysReady) {
+                        if (r.fd != fd) continue;
+                        _alwaysReady.pushToBack(reg);
+                        return true;
+                }
+                auto [it, inserted] = _byFd.tryEmplace(fd);
+                const bool existed = !inserted && !it->second.isEmpty();
+                it->second.pushToBack(reg);
+                const int err = epollUpdate(fd, existed);
+                if (err == 0) return true;
+
+                // Roll back; a second handle on a known fd puts the
+                // previous interest mask back.
+                it->second.removeIf([handle](const Registration &r) { return r.handle == handle; });
+                if (existed) {
+                        (void)epollUpdate(fd, true);
+                } else {
+                        _byFd.remove(fd);
+                }
+                if (err == EPERM) {
+                        _alwaysReady.pushToBack(reg);
+                        return true;
+                }
+                errno = err;
+                return false;
+        }
+#endif
+        _regs.pushToBack(reg);
+        _dirty = true;
+        return true;
+}
+
+void EventLoopPoller::remove(int handle, int fd) {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) {
+                _alwaysReady.removeIf([handle](const Registration &r) { return r.handle == handle; });
+                auto it = _byFd.find(fd);
+                if (it == _byFd.end()) return;
+                it->second.removeIf([handle](const Registration &r) { return r.handle == handle; });
+                const int err = epollUpdate(fd, true);
+                if (err != 0) {
+                        promekiWarn("EventLoop: epoll_ctl(fd %d) failed (errno %d: %s)", fd, err,
+                                    std::strerror(err));
+                }
+                return;
+        }
 #else
-struct EventLoopPollCache {};
+        (void)fd;
+#endif
+        _regs.removeIf([handle](const Registration &r) { return r.handle == handle; });
+        _dirty = true;
+        return;
+}
+
+void EventLoopPoller::prepare() {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) {
+                // wait() runs without the lock, so it works from a
+                // count taken here rather than the list itself.
+                _alwaysReadyCount = _alwaysReady.size();
+                return;
+        }
+#endif
+        if (!_dirty) return;
+        _pfds.clear();
+        _pfdHandles.clear();
+        _pfds.reserve(_regs.size() + 1);
+        _pfdHandles.reserve(_regs.size());
+        pollfd wakePfd;
+        wakePfd.fd = _wakeFd;
+        wakePfd.events = POLLIN;
+        wakePfd.revents = 0;
+        _pfds += wakePfd;
+        for (const Registration &r : _regs) {
+                pollfd pfd;
+                pfd.fd = r.fd;
+                pfd.events = 0;
+                if (r.events & EventLoop::IoRead) pfd.events |= POLLIN;
+                if (r.events & EventLoop::IoWrite) pfd.events |= POLLOUT;
+                pfd.revents = 0;
+                _pfds += pfd;
+                _pfdHandles += r.handle;
+        }
+        _dirty = false;
+        return;
+}
+
+int EventLoopPoller::wait(int timeoutMs) {
+        _wakeFired = false;
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) {
+                _eventCount = 0;
+                const int always = static_cast<int>(_alwaysReadyCount);
+                int       rc = ::epoll_wait(_epollFd, _events, MaxEpollEvents, always > 0 ? 0 : timeoutMs);
+                if (rc < 0) return rc;
+                _eventCount = rc;
+                for (int i = 0; i < rc; i++) {
+                        if (_events[i].data.fd == _wakeFd) _wakeFired = true;
+                }
+                return rc + always;
+        }
+#endif
+        int rc = ::poll(_pfds.data(), _pfds.size(), timeoutMs);
+        if (rc > 0 && (_pfds[0].revents & (POLLIN | POLLERR | POLLHUP))) _wakeFired = true;
+        return rc;
+}
+
+void EventLoopPoller::collect(List<Ready> &out) const {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        if (_epollFd >= 0) {
+                for (int i = 0; i < _eventCount; i++) {
+                        const epoll_event &ev = _events[i];
+                        if (ev.data.fd == _wakeFd) continue;
+                        auto it = _byFd.find(ev.data.fd);
+                        if (it == _byFd.end()) continue;
+                        const bool in = (ev.events & EPOLLIN) != 0;
+                        const bool wr = (ev.events & EPOLLOUT) != 0;
+                        const bool err = (ev.events & (EPOLLERR | EPOLLHUP)) != 0;
+                        for (const Registration &r : it->second) {
+                                uint32_t ready = readyBits(r.events, in, wr, err);
+                                if (ready != 0) out += Ready{r.handle, ready};
+                        }
+                }
+                for (const Registration &r : _alwaysReady) {
+                        uint32_t ready = readyBits(r.events, true, true, false);
+                        if (ready != 0) out += Ready{r.handle, ready};
+                }
+                return;
+        }
+#endif
+        for (size_t i = 0; i < _pfdHandles.size() && (i + 1) < _pfds.size(); i++) {
+                const pollfd &pfd = _pfds[i + 1];
+                if (pfd.revents == 0) continue;
+                // poll() only reports the bits requested for this
+                // entry (plus the always-on error bits), so the
+                // wanted mask is "everything".
+                uint32_t ready = readyBits(EventLoop::IoRead | EventLoop::IoWrite, (pfd.revents & POLLIN) != 0,
+                                           (pfd.revents & POLLOUT) != 0,
+                                           (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
+                if (ready != 0) out += Ready{_pfdHandles[i], ready};
+        }
+        return;
+}
+
+#else // !PROMEKI_PLATFORM_POSIX
+
+// waitOnSources never reaches the poller here; the class exists so
+// the UniquePtr member has a complete type to construct and destroy.
+class EventLoopPoller {
+        public:
+                explicit EventLoopPoller(int) {}
+};
+
 #endif
 
 // ============================================================================
@@ -175,7 +492,7 @@ EventLoop *EventLoop::current() {
 EventLoop::EventLoop() {
         _current = this;
         _wake = WakeFdUPtr::create();
-        _pollCache = PollCacheUPtr::create();
+        _poller = PollerUPtr::create(_wake->pollFd());
         // Self-install if Application::startEventLoopMonitors has
         // armed the auto-install hook.  No-op in the common case
         // where no monitoring is configured.  Doing this in the
@@ -345,7 +662,9 @@ int EventLoop::startTimer(ObjectBase *receiver, unsigned int intervalMs, bool si
         info.nextFire = TimeStamp::now() + std::chrono::milliseconds(intervalMs);
         {
                 Mutex::Locker lock(_timersMutex);
-                _timers += info;
+                _timerHeap.pushToBack(TimerHeapEntry{info.nextFire, id});
+                std::push_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
+                _timers.insert(id, std::move(info));
         }
         wakeSelf();
         return id;
@@ -362,7 +681,9 @@ int EventLoop::startTimer(unsigned int intervalMs, Function<void()> func, bool s
         info.nextFire = TimeStamp::now() + std::chrono::milliseconds(intervalMs);
         {
                 Mutex::Locker lock(_timersMutex);
-                _timers += info;
+                _timerHeap.pushToBack(TimerHeapEntry{info.nextFire, id});
+                std::push_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
+                _timers.insert(id, std::move(info));
         }
         wakeSelf();
         return id;
@@ -371,19 +692,41 @@ int EventLoop::startTimer(unsigned int intervalMs, Function<void()> func, bool s
 void EventLoop::stopTimer(int timerId) {
         {
                 Mutex::Locker lock(_timersMutex);
-                _timers.removeIf([timerId](const TimerInfo &t) { return t.id == timerId; });
+                _timers.remove(timerId);
+                // The heap entry stays behind and is dropped when it
+                // reaches the top.  A loop that keeps starting and
+                // stopping long timers would otherwise grow the heap
+                // without bound, so compact once the cancelled
+                // entries clearly outnumber the live ones.
+                if (_timerHeap.size() > 2 * _timers.size() + 64) {
+                        _timerHeap.removeIf([this](const TimerHeapEntry &e) { return !_timers.contains(e.id); });
+                        std::make_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
+                }
         }
         wakeSelf();
         return;
 }
 
+bool EventLoop::timerFiresLater(const TimerHeapEntry &a, const TimerHeapEntry &b) {
+        if (a.nextFire != b.nextFire) return a.nextFire > b.nextFire;
+        return a.id > b.id;
+}
+
+void EventLoop::pruneTimerHeap() const {
+        while (!_timerHeap.isEmpty() && !_timers.contains(_timerHeap.front().id)) {
+                std::pop_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
+                _timerHeap.popFromBack();
+        }
+        return;
+}
+
 void EventLoop::processTimers() {
-        // Two-phase: take the lock, scan for ready-to-fire entries,
-        // snapshot everything needed to invoke them, rearm or drop
-        // each fired entry, release the lock.  Callback invocation
-        // runs outside the lock so that a timer body can safely call
-        // startTimer() or stopTimer() on the same event loop without
-        // deadlocking against _timersMutex.
+        // Two-phase: take the lock, pop every due entry off the
+        // deadline heap, snapshot everything needed to invoke them,
+        // rearm or drop each fired entry, release the lock.  Callback
+        // invocation runs outside the lock so that a timer body can
+        // safely call startTimer() or stopTimer() on the same event
+        // loop without deadlocking against _timersMutex.
         struct ReadyTimer {
                         int                   id;
                         ObjectBase           *receiver;
@@ -393,38 +736,51 @@ void EventLoop::processTimers() {
 
         {
                 Mutex::Locker lock(_timersMutex);
-                if (_timers.isEmpty()) return;
-                TimeStamp now = TimeStamp::now();
-                List<int> expired;
-                for (size_t i = 0; i < _timers.size(); i++) {
-                        auto &timer = _timers[i];
-                        if (now.value() >= timer.nextFire.value()) {
-                                ReadyTimer rt;
-                                rt.id = timer.id;
-                                rt.receiver = timer.receiver;
-                                rt.func = timer.func; // copy callable
-                                toFire += rt;
-                                if (timer.singleShot) {
-                                        expired += timer.id;
-                                } else {
-                                        timer.nextFire = now + std::chrono::milliseconds(timer.intervalMs);
-                                }
+                if (_timers.isEmpty()) {
+                        _timerHeap.clear();
+                        return;
+                }
+                TimeStamp            now = TimeStamp::now();
+                List<TimerHeapEntry> rearmed;
+                for (;;) {
+                        pruneTimerHeap();
+                        if (_timerHeap.isEmpty() || _timerHeap.front().nextFire > now) break;
+                        std::pop_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
+                        const int id = _timerHeap.back().id;
+                        _timerHeap.popFromBack();
+                        auto it = _timers.find(id);
+                        TimerInfo &timer = it->second;
+                        ReadyTimer rt;
+                        rt.id = timer.id;
+                        rt.receiver = timer.receiver;
+                        rt.func = timer.func; // copy callable
+                        toFire += rt;
+                        if (timer.singleShot) {
+                                _timers.remove(it);
+                        } else {
+                                // Pushed back only after the scan so a
+                                // zero-interval timer fires once per
+                                // call rather than spinning here.
+                                timer.nextFire = now + std::chrono::milliseconds(timer.intervalMs);
+                                rearmed += TimerHeapEntry{timer.nextFire, id};
                         }
                 }
-                for (int id : expired) {
-                        _timers.removeIf([id](const TimerInfo &t) { return t.id == id; });
+                for (const TimerHeapEntry &e : rearmed) {
+                        _timerHeap.pushToBack(e);
+                        std::push_heap(_timerHeap.begin(), _timerHeap.end(), &EventLoop::timerFiresLater);
                 }
         }
 
-        // Fire outside the lock.  A callback that calls stopTimer()
-        // on a later timer in the same batch will still see that
-        // later timer fire once — we copied its callable above — but
-        // will succeed in removing the entry from _timers so it does
-        // not fire again.  Matches the behavior of most mainstream
-        // event loops.  Each fire is individually bracketed so a
-        // long-running timer accumulates exactly its share of the
-        // _timersNs bucket; bracketing the outer loop instead would
-        // attribute the cumulative time as a single dispatch.
+        // Fire outside the lock, in deadline order.  A callback that
+        // calls stopTimer() on a later timer in the same batch will
+        // still see that later timer fire once — we copied its
+        // callable above — but will succeed in removing the entry
+        // from _timers so it does not fire again.  Matches the
+        // behavior of most mainstream event loops.  Each fire is
+        // individually bracketed so a long-running timer accumulates
+        // exactly its share of the _timersNs bucket; bracketing the
+        // outer loop instead would attribute the cumulative time as a
+        // single dispatch.
         for (auto it = toFire.begin(); it != toFire.end(); ++it) {
                 StatsBracket bracket(this, &_timersNs, &_timersCount);
                 if (it->receiver != nullptr) {
@@ -439,19 +795,15 @@ void EventLoop::processTimers() {
 
 unsigned int EventLoop::nextTimerTimeout() const {
         Mutex::Locker lock(_timersMutex);
-        if (_timers.isEmpty()) return 0;
-        TimeStamp    now = TimeStamp::now();
-        unsigned int minMs = UINT_MAX;
-        for (const auto &timer : _timers) {
-                if (now >= timer.nextFire) {
-                        return 1; // Fire immediately on next iteration
-                }
-                const int64_t  diffNs = (timer.nextFire - now).nanoseconds();
-                unsigned int ms = static_cast<unsigned int>(diffNs / 1'000'000LL);
-                if (ms == 0) ms = 1; // Sub-millisecond remaining, wake soon
-                if (ms < minMs) minMs = ms;
-        }
-        return minMs == UINT_MAX ? 0 : minMs;
+        pruneTimerHeap();
+        if (_timerHeap.isEmpty()) return 0;
+        TimeStamp        now = TimeStamp::now();
+        const TimeStamp &next = _timerHeap.front().nextFire;
+        if (now >= next) return 1; // Fire immediately on next iteration
+        const int64_t diffNs = (next - now).nanoseconds();
+        unsigned int  ms = static_cast<unsigned int>(diffNs / 1'000'000LL);
+        if (ms == 0) ms = 1; // Sub-millisecond remaining, wake soon
+        return ms;
 }
 
 // ============================================================================
@@ -468,8 +820,8 @@ int EventLoop::addIoSource(int fd, uint32_t events, IoCallback cb) {
                 promekiWarn("EventLoop::addIoSource: empty callback");
                 return -1;
         }
-        if ((events & (IoRead | IoWrite)) == 0) {
-                promekiWarn("EventLoop::addIoSource: no readable/writable event bits set");
+        if ((events & (IoRead | IoWrite | IoError)) == 0) {
+                promekiWarn("EventLoop::addIoSource: no event bits set");
                 return -1;
         }
         int      handle = _nextIoHandle.fetchAndAdd(1);
@@ -478,13 +830,18 @@ int EventLoop::addIoSource(int fd, uint32_t events, IoCallback cb) {
         src.fd = fd;
         src.events = events;
         src.cb = std::move(cb);
-        src.pendingRemove = false;
         {
                 Mutex::Locker lock(_ioMutex);
-                _ioSources += src;
-                _pollCache->dirty = true;
+                if (!_poller->add(handle, fd, events)) {
+                        promekiWarn("EventLoop::addIoSource: %s rejected fd %d (errno %d: %s)", _poller->name(), fd,
+                                    errno, std::strerror(errno));
+                        return -1;
+                }
+                _ioSources.insert(handle, std::move(src));
         }
-        // Wake the loop so the next poll() picks up the new fd.
+        // Wake the loop so a poll() backend rebuilds its set; epoll
+        // already sees the new fd, the wake just costs one spurious
+        // return.
         wakeSelf();
         return handle;
 #else
@@ -501,24 +858,17 @@ void EventLoop::removeIoSource(int handle) {
         if (handle < 0) return;
         {
                 Mutex::Locker lock(_ioMutex);
-                for (size_t i = 0; i < _ioSources.size(); i++) {
-                        if (_ioSources[i].handle == handle) {
-                                // Mark pendingRemove rather than erasing
-                                // in-place.  The loop thread sweeps
-                                // pending entries at the top of
-                                // waitOnSources before building the
-                                // next poll set, which avoids
-                                // invalidating a dispatch snapshot that
-                                // may be mid-iteration.
-                                _ioSources[i].pendingRemove = true;
-                                _pollCache->dirty = true;
-                                break;
-                        }
-                }
+                auto          it = _ioSources.find(handle);
+                if (it == _ioSources.end()) return;
+                // Erasing here is safe even mid-dispatch: waitOnSources
+                // resolves ready handles against _ioSources under this
+                // lock and copies the callbacks it will fire, so a
+                // removed handle simply misses on the next lookup.
+                _poller->remove(handle, it->second.fd);
+                _ioSources.remove(it);
         }
-        // Wake the loop so the pending-remove sweep runs before the
-        // next poll; this guarantees a just-removed fd won't fire
-        // another callback.
+        // Wake the loop so the next wait uses the updated set; this
+        // guarantees a just-removed fd won't fire another callback.
         wakeSelf();
 #else
         (void)handle;
@@ -548,74 +898,40 @@ void EventLoop::waitOnSources(unsigned int waitMs) {
                 return;
         }
 
-        // Phase 1: under the ioMutex, (re)build the cached poll set
-        // only when it is dirty — i.e. a source was added or removed
-        // since the last wake.  In the steady state the cache is
-        // clean and this is just a lock + flag check, not an O(N)
-        // rebuild.  pendingRemove is only ever set together with the
-        // dirty flag (in removeIoSource), so a clean cache has no
-        // entries to sweep and skipping removeIf is safe.  Index 0 is
-        // always the wake fd; index i+1 mirrors _ioSources[i].
-        struct Ready {
-                        int        handle;
-                        int        fd;
-                        uint32_t   readyEvents;
-                        IoCallback cb;
-        };
-        List<Ready>         snapshot;
-        EventLoopPollCache &cache = *_pollCache;
+        // Phase 1: under the ioMutex, let the poller bring its wait
+        // set up to date.  For epoll this is a no-op (registration
+        // already happened in addIoSource); the poll() backend
+        // rebuilds its cached array only if a source was added or
+        // removed since the last wake.
+        EventLoopPoller &poller = *_poller;
         {
                 Mutex::Locker lock(_ioMutex);
-                if (cache.dirty) {
-                        _ioSources.removeIf([](const IoSource &s) { return s.pendingRemove; });
-                        cache.pfds.clear();
-                        cache.pfds.reserve(_ioSources.size() + 1);
-                        pollfd wakePfd;
-                        wakePfd.fd = _wake->pollFd();
-                        wakePfd.events = POLLIN;
-                        wakePfd.revents = 0;
-                        cache.pfds += wakePfd;
-                        for (size_t i = 0; i < _ioSources.size(); i++) {
-                                const IoSource &src = _ioSources[i];
-                                pollfd          pfd;
-                                pfd.fd = src.fd;
-                                pfd.events = 0;
-                                if (src.events & IoRead) pfd.events |= POLLIN;
-                                if (src.events & IoWrite) pfd.events |= POLLOUT;
-                                pfd.revents = 0;
-                                cache.pfds += pfd;
-                        }
-                        cache.dirty = false;
-                }
+                poller.prepare();
         }
 
-        // Phase 2: poll outside the lock.  Bracket the syscall into
+        // Phase 2: wait outside the lock.  Bracket the syscall into
         // _sleepNs so the snapshot reflects how much wallclock the
-        // loop spent waiting for work versus dispatching it.  cache.pfds
-        // is owned exclusively by the loop thread (only Phase 1 rebuilds
-        // it; add/removeIoSource merely flip the dirty flag), so it is
-        // safe to read here without the lock.
+        // loop spent waiting for work versus dispatching it.
         int pollTimeout = (waitMs == 0) ? -1 : static_cast<int>(waitMs);
         int rc;
         {
                 StatsBracket sleepBracket(this, &_sleepNs, nullptr);
-                rc = ::poll(cache.pfds.data(), cache.pfds.size(), pollTimeout);
+                rc = poller.wait(pollTimeout);
         }
         if (rc < 0) {
                 if (errno == EINTR) return;
-                promekiWarn("EventLoop::waitOnSources: poll() failed (errno %d: %s)", errno, std::strerror(errno));
+                promekiWarn("EventLoop::waitOnSources: %s wait failed (errno %d: %s)", poller.name(), errno,
+                            std::strerror(errno));
                 return;
         }
         if (rc == 0) return; // timeout
 
         // Phase 3: drain wake fd, drain queue, snapshot ready
         // callbacks under the lock, fire outside the lock.
-        if (cache.pfds[0].revents & (POLLIN | POLLERR | POLLHUP)) {
-                _wake->drain();
-        }
+        if (poller.wakeFired()) _wake->drain();
 
         // Drain posted items now so any quit/callable queued during
-        // the poll is processed immediately — matches the semantics
+        // the wait is processed immediately — matches the semantics
         // of the previous Queue::pop(waitMs) path.
         for (;;) {
                 auto [item, err] = _queue.tryPop();
@@ -626,39 +942,27 @@ void EventLoop::waitOnSources(unsigned int waitMs) {
                 }
         }
 
-        // Collect ready I/O sources (index 1+ of pfds).  Re-lock
-        // briefly to snapshot the callbacks; a removeIoSource
-        // racing with this sweep has already marked pendingRemove,
-        // so we skip those.
+        // Resolve the ready handles against _ioSources.  A source
+        // removed during the wait (or by a posted callable just
+        // dispatched above) is gone from the map and is skipped.
+        struct Ready {
+                        int        fd;
+                        uint32_t   readyEvents;
+                        IoCallback cb;
+        };
+        List<Ready> snapshot;
         {
-                Mutex::Locker lock(_ioMutex);
-                // cache.pfds was built from _ioSources under this same
-                // lock (Phase 1).  Positions stay aligned across the
-                // poll window because addIoSource only appends (new
-                // entries are beyond cache.pfds.size(), so the bound
-                // skips them) and removeIoSource only flags
-                // pendingRemove without shifting positions (the sweep
-                // is deferred to the next dirty rebuild).  A source
-                // flagged for removal during the poll is skipped below.
-                size_t n = _ioSources.size();
-                for (size_t i = 0; i < n && (i + 1) < cache.pfds.size(); i++) {
-                        const pollfd &pfd = cache.pfds[i + 1];
-                        if (pfd.revents == 0) continue;
-                        const IoSource &src = _ioSources[i];
-                        if (src.pendingRemove) continue;
-                        uint32_t ready = 0;
-                        if (pfd.revents & POLLIN) ready |= IoRead;
-                        if (pfd.revents & POLLOUT) ready |= IoWrite;
-                        if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
-                                ready |= IoError;
-                        }
-                        if (ready == 0) continue;
-                        Ready r;
-                        r.handle = src.handle;
-                        r.fd = src.fd;
-                        r.readyEvents = ready;
-                        r.cb = src.cb; // copy callable
-                        snapshot += r;
+                List<EventLoopPoller::Ready> ready;
+                Mutex::Locker                lock(_ioMutex);
+                poller.collect(ready);
+                for (const EventLoopPoller::Ready &r : ready) {
+                        auto it = _ioSources.find(r.handle);
+                        if (it == _ioSources.end()) continue;
+                        Ready entry;
+                        entry.fd = it->second.fd;
+                        entry.readyEvents = r.events;
+                        entry.cb = it->second.cb; // copy callable
+                        snapshot += entry;
                 }
         }
 
@@ -778,8 +1082,26 @@ void finalizeBuckets(EventLoop::Report &out, const TimeStamp &now, const TimeSta
 
 } // namespace
 
+void EventLoop::fillGauges(Report &out) const {
+        out.ioBackend = "queue";
+#if defined(PROMEKI_PLATFORM_POSIX)
+        if (_wake.isValid() && _wake->pollFd() >= 0) out.ioBackend = _poller->name();
+#endif
+        {
+                Mutex::Locker lock(_ioMutex);
+                out.ioSources = static_cast<int64_t>(_ioSources.size());
+        }
+        {
+                Mutex::Locker lock(_timersMutex);
+                out.timersArmed = static_cast<int64_t>(_timers.size());
+                out.timerHeapSize = static_cast<int64_t>(_timerHeap.size());
+        }
+        return;
+}
+
 EventLoop::Report EventLoop::peekStats() const {
         Report out;
+        fillGauges(out);
         if (!_monitorActive.value()) return out;
         Mutex::Locker lock(_statsMutex);
         TimeStamp     now = TimeStamp::now();
@@ -812,6 +1134,7 @@ EventLoop::Report EventLoop::peekStats() const {
 
 EventLoop::Report EventLoop::consumeStats() {
         Report out;
+        fillGauges(out);
         if (!_monitorActive.value()) return out;
         Mutex::Locker lock(_statsMutex);
         TimeStamp     now = TimeStamp::now();
@@ -961,6 +1284,12 @@ String formatEventLoopReport(const EventLoop::Report &r) {
         appendBucket(out, "callables", pctOf(r.callables), r.callablesCount, true);
         appendBucket(out, "io", pctOf(r.io), r.ioCount, true);
         appendBucket(out, "overhead", pctOf(r.overhead), 0, false);
+        // Gauges: only worth a column once the loop is carrying
+        // sources or timers beyond the monitor's own sampling timer.
+        if (r.ioSources > 0 || r.timersArmed > 1) {
+                out += String("  ") + r.ioBackend + "(fds=" + String::number(r.ioSources) +
+                       ",timers=" + String::number(r.timersArmed) + ")";
+        }
         out += formatStatsTail(r.eventsByType, r.wallElapsed, "evt", 4, [](int type) {
                 return Event::typeName(static_cast<Event::Type>(type));
         });
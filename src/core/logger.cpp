@@ -5,6 +5,12 @@
  * See LICENSE file in the project root folder for license information.
  */
 
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <string_view>
 #include <promeki/logger.h>
 #include <promeki/ansistream.h>
 #include <promeki/list.h>
@@ -123,9 +129,171 @@ static uint64_t cachedThreadId() {
         return id;
 }
 
+// Steady-clock stamp used to order staged records against queued
+// commands.  Strictly increasing per thread, so two operations from
+// the same thread never compare equal.
+static int64_t nextStamp() {
+        static thread_local int64_t last = 0;
+        int64_t                     now = TimeStamp::now().nanoseconds();
+        if (now <= last) now = last + 1;
+        last = now;
+        return now;
+}
+
+static Atomic<uint64_t> nextLoggerId{1};
+
+// ============================================================================
+// Staging ring
+//
+// Single-producer / single-consumer byte ring.  The owning thread
+// appends records at tail and the logger worker consumes them from
+// head; both are free-running byte counts.  Records are 8-byte aligned
+// and never straddle the end of the buffer — when one would, the
+// producer pads the remainder with a skip record and wraps.
+// ============================================================================
+
+namespace {
+
+        struct StagedRecord {
+                        uint32_t    size;  ///< Total bytes, header included.
+                        uint16_t    flags; ///< SkipFlag for wrap padding.
+                        uint16_t    argCount;
+                        int32_t     level;
+                        int32_t     line;
+                        const char *file;
+                        const char *format;
+                        int64_t     stamp;
+        };
+
+        constexpr uint16_t SkipFlag = 0x1;
+        constexpr uint32_t NullString = 0xffffffffu;
+
+        constexpr size_t alignRecord(size_t n) { return (n + 7) & ~size_t(7); }
+
+} // namespace
+
+struct Logger::StagingRing {
+                StagingRing(size_t bytes, uint64_t tid)
+                    : storage(new uint64_t[bytes / sizeof(uint64_t)]), capacity(bytes), threadId(tid) {}
+
+                uint8_t *data() { return reinterpret_cast<uint8_t *>(storage.get()); }
+
+                // Producer: returns space for @p need bytes, or nullptr when full.
+                uint8_t *reserve(size_t need, uint64_t &pos) {
+                        uint64_t t = tail.load(MemoryOrder::Relaxed);
+                        uint64_t h = head.value();
+                        size_t   off = static_cast<size_t>(t & (capacity - 1));
+                        size_t   skip = capacity - off < need ? capacity - off : 0;
+                        if (t + skip + need - h > capacity) return nullptr;
+                        if (skip > 0) {
+                                auto *pad = reinterpret_cast<StagedRecord *>(data() + off);
+                                pad->size = static_cast<uint32_t>(skip);
+                                pad->flags = SkipFlag;
+                                t += skip;
+                                off = 0;
+                        }
+                        pos = t;
+                        return data() + off;
+                }
+
+                // Producer: publishes a record written into reserve()'s
+                // space.  Sequentially consistent so it orders against the
+                // wake-flag check that follows (see Logger::stage).
+                void commit(uint64_t pos, size_t size) {
+                        tail.store(pos + size, MemoryOrder::SeqCst);
+                        return;
+                }
+
+                // Consumer: the oldest record, or nullptr when empty.
+                const StagedRecord *front() {
+                        for (;;) {
+                                uint64_t h = head.load(MemoryOrder::Relaxed);
+                                if (h == tail.load(MemoryOrder::SeqCst)) return nullptr;
+                                auto *rec = reinterpret_cast<const StagedRecord *>(data() + (h & (capacity - 1)));
+                                if ((rec->flags & SkipFlag) == 0) return rec;
+                                head.setValue(h + rec->size);
+                        }
+                }
+
+                // Consumer: releases the record returned by front().
+                void pop(const StagedRecord *rec) {
+                        head.setValue(head.load(MemoryOrder::Relaxed) + rec->size);
+                        return;
+                }
+
+                std::unique_ptr<uint64_t[]>  storage;
+                size_t                       capacity;
+                uint64_t                     threadId;
+                Atomic<bool>                 retired{false}; ///< Owning thread has exited.
+                alignas(64) Atomic<uint64_t> tail{0};        ///< Producer-written.
+                alignas(64) Atomic<uint64_t> head{0};        ///< Consumer-written.
+};
+
+// The rings a thread has registered, one per Logger it has used.
+// Marks them retired at thread exit so the worker can release each
+// one once it has been drained.
+struct LoggerThreadStaging {
+                struct Slot {
+                                uint64_t                             loggerId;
+                                std::shared_ptr<Logger::StagingRing> ring;
+                };
+
+                List<Slot> slots;
+
+                ~LoggerThreadStaging();
+};
+
+namespace {
+
+        // Trivially destructible, so it stays readable after
+        // LoggerThreadStaging has been torn down during thread exit.
+        thread_local bool threadStagingGone = false;
+
+        LoggerThreadStaging &threadStaging() {
+                static thread_local LoggerThreadStaging ts;
+                return ts;
+        }
+
+        // Appends one printf conversion of @p value to @p out.
+        template <typename T> void appendFormatted(std::string &out, const char *spec, T value) {
+                char buf[128];
+                int  n = std::snprintf(buf, sizeof(buf), spec, value);
+                if (n < 0) return;
+                if (static_cast<size_t>(n) < sizeof(buf)) {
+                        out.append(buf, static_cast<size_t>(n));
+                        return;
+                }
+                size_t at = out.size();
+                out.resize(at + static_cast<size_t>(n) + 1);
+                std::snprintf(out.data() + at, static_cast<size_t>(n) + 1, spec, value);
+                out.resize(at + static_cast<size_t>(n));
+                return;
+        }
+
+        // Integer conversion; @p plain (no flags, width or precision)
+        // skips snprintf, which dominates the worker's per-record cost.
+        template <typename T> void appendInteger(std::string &out, const char *spec, bool plain, int base, T value) {
+                if (!plain) {
+                        appendFormatted(out, spec, value);
+                        return;
+                }
+                char buf[24];
+                auto res = std::to_chars(buf, buf + sizeof(buf), value, base);
+                out.append(buf, res.ptr);
+                return;
+        }
+
+} // namespace
+
+LoggerThreadStaging::~LoggerThreadStaging() {
+        threadStagingGone = true;
+        for (auto &slot : slots) slot.ring->retired.setValue(true);
+}
+
 Logger::Logger()
-    : _level(Info), _consoleLogging(true), _consoleUseStderr(true), _fileFormatter(defaultFileFormatter()),
-      _consoleFormatter(defaultConsoleFormatter()) {
+    : _id(nextLoggerId.fetchAndAdd(1)), _level(Info), _consoleLogging(true), _consoleUseStderr(true),
+      _fileFormatter(defaultFileFormatter()), _consoleFormatter(defaultConsoleFormatter()),
+      _wallBase(DateTime::now()), _steadyBase(TimeStamp::now().nanoseconds()) {
         // Force stdio singletons to initialize before this Logger,
         // ensuring they outlive the Logger at static destruction time.
         // Both streams are touched because the console target is
@@ -139,31 +307,267 @@ Logger::Logger()
 void Logger::setThreadName(const String &name) {
         Logger &log = defaultLogger();
         if (log._terminating.value()) return;
-        log._queue.emplace(CmdSetThreadName{cachedThreadId(), name});
+        log.enqueue(CmdSetThreadName{cachedThreadId(), name});
+}
+
+void Logger::enqueue(Command &&cmd) {
+        _queue.emplace(QueuedCommand{nextStamp(), std::move(cmd)});
+        return;
 }
 
 void Logger::log(LogLevel loglevel, const char *file, int line, const String &msg) {
         if (_terminating.value()) return;
-        _queue.emplace(LogEntry{DateTime::now(), loglevel, file, line, cachedThreadId(), msg});
+        enqueue(LogEntry{DateTime::now(), loglevel, file, line, cachedThreadId(), msg});
 }
 
 void Logger::log(LogLevel loglevel, const char *file, int line, const StringList &lines) {
         if (_terminating.value()) return;
-        uint64_t      id = cachedThreadId();
-        DateTime      ts = DateTime::now();
-        List<Command> cmdlist;
+        uint64_t            id = cachedThreadId();
+        DateTime            ts = DateTime::now();
+        int64_t             stamp = nextStamp();
+        List<QueuedCommand> cmdlist;
         for (const auto &item : lines) {
-                cmdlist.pushToBack(LogEntry{ts, loglevel, file, line, id, item});
+                cmdlist.pushToBack(QueuedCommand{stamp, LogEntry{ts, loglevel, file, line, id, item}});
         }
         _queue.push(std::move(cmdlist));
 }
 
+Logger::StagingRing *Logger::threadRing() {
+        if (threadStagingGone) return nullptr;
+        LoggerThreadStaging &ts = threadStaging();
+        for (auto &slot : ts.slots) {
+                if (slot.loggerId == _id) return slot.ring.get();
+        }
+        auto ring = std::make_shared<StagingRing>(StagingRingBytes, cachedThreadId());
+        {
+                Mutex::Locker lock(_stagingMutex);
+                _stagingRings.pushToBack(ring);
+                _stagingGeneration.fetchAndAdd(1);
+        }
+        ts.slots.pushToBack(LoggerThreadStaging::Slot{_id, ring});
+        return ring.get();
+}
+
+bool Logger::stage(LogLevel loglevel, const char *file, int line, const char *fmt, const LogArg *args,
+                   size_t count) {
+        if (count > 64) return false;
+        StagingRing *ring = threadRing();
+        if (ring == nullptr) return false;
+        int64_t stamp = nextStamp();
+
+        size_t lengths[64];
+        size_t strBytes = 0;
+        for (size_t i = 0; i < count; i++) {
+                if (args[i].kind != LogArg::CString || args[i].s == nullptr) continue;
+                lengths[i] = std::strlen(args[i].s);
+                strBytes += lengths[i] + 1;
+        }
+        size_t need = alignRecord(sizeof(StagedRecord) + count * sizeof(LogArg) + strBytes);
+        // A few huge records would starve the ring; format those eagerly.
+        if (need > ring->capacity / 4) return false;
+
+        uint64_t pos = 0;
+        uint8_t *dst = ring->reserve(need, pos);
+        if (dst == nullptr) return false;
+
+        auto *rec = reinterpret_cast<StagedRecord *>(dst);
+        rec->size = static_cast<uint32_t>(need);
+        rec->flags = 0;
+        rec->argCount = static_cast<uint16_t>(count);
+        rec->level = loglevel;
+        rec->line = line;
+        rec->file = file;
+        rec->format = fmt;
+        rec->stamp = stamp;
+        auto *slots = reinterpret_cast<LogArg *>(dst + sizeof(StagedRecord));
+        char *str = reinterpret_cast<char *>(slots + count);
+        for (size_t i = 0; i < count; i++) {
+                slots[i] = args[i];
+                if (args[i].kind != LogArg::CString) continue;
+                if (args[i].s == nullptr) {
+                        slots[i].length = NullString;
+                        continue;
+                }
+                slots[i].length = static_cast<uint32_t>(lengths[i]);
+                std::memcpy(str, args[i].s, lengths[i] + 1);
+                str += lengths[i] + 1;
+        }
+        ring->commit(pos, need);
+
+        // Pairs with the exchange in the worker's CmdDrain handler:
+        // either we see the wake flag cleared and post a drain, or the
+        // worker's pending check after clearing it sees this record.
+        // While the worker is busy the flag stays set and this is the
+        // whole cost of a log call.
+        if (!_wakePending.load(MemoryOrder::SeqCst) && !_wakePending.exchange(true, MemoryOrder::SeqCst)) {
+                enqueue(CmdDrain{});
+        }
+        return true;
+}
+
+String Logger::formatArgs(const char *fmt, const LogArg *args, size_t count) {
+        auto asSigned = [](const LogArg &a) -> int64_t {
+                switch (a.kind) {
+                        case LogArg::Unsigned: return static_cast<int64_t>(a.u);
+                        case LogArg::Double: return static_cast<int64_t>(a.d);
+                        case LogArg::Pointer:
+                        case LogArg::CString: return static_cast<int64_t>(reinterpret_cast<intptr_t>(a.p));
+                        default: return a.i;
+                }
+        };
+        auto asDouble = [](const LogArg &a) -> double {
+                switch (a.kind) {
+                        case LogArg::Signed: return static_cast<double>(a.i);
+                        case LogArg::Unsigned: return static_cast<double>(a.u);
+                        case LogArg::Double: return a.d;
+                        default: return 0.0;
+                }
+        };
+
+        std::string out;
+        size_t      next = 0;
+        const char *p = fmt;
+        while (*p != '\0') {
+                const char *pct = std::strchr(p, '%');
+                if (pct == nullptr) {
+                        out.append(p);
+                        break;
+                }
+                out.append(p, static_cast<size_t>(pct - p));
+                if (pct[1] == '%') {
+                        out += '%';
+                        p = pct + 2;
+                        continue;
+                }
+
+                // Rebuild the conversion spec with any '*' width or
+                // precision resolved, so snprintf takes a single value.
+                char        spec[64];
+                size_t      n = 0;
+                const char *q = pct + 1;
+                bool        missing = false;
+                spec[n++] = '%';
+                while (*q == '-' || *q == '+' || *q == ' ' || *q == '#' || *q == '0' || *q == '\'') spec[n++] = *q++;
+                for (int part = 0; part < 2; part++) {
+                        if (part == 1) {
+                                if (*q != '.') break;
+                                spec[n++] = *q++;
+                        }
+                        if (*q == '*') {
+                                q++;
+                                if (next >= count) {
+                                        missing = true;
+                                        continue;
+                                }
+                                int v = static_cast<int>(asSigned(args[next++]));
+                                if (part == 1 && v < 0) {
+                                        n--; // Negative precision means none.
+                                        continue;
+                                }
+                                int w = std::snprintf(spec + n, 12, "%d", v);
+                                if (w > 0) n += static_cast<size_t>(w);
+                        } else {
+                                while (*q >= '0' && *q <= '9' && n < 24) spec[n++] = *q++;
+                        }
+                }
+                std::string_view lm;
+                const char      *lmStart = q;
+                while (*q == 'h' || *q == 'l' || *q == 'L' || *q == 'q' || *q == 'j' || *q == 'z' || *q == 't') {
+                        if (q - lmStart < 2) spec[n++] = *q;
+                        q++;
+                }
+                lm = std::string_view(lmStart, static_cast<size_t>(q - lmStart));
+                char conv = *q;
+                if (conv == '\0' || missing || next >= count) {
+                        // Malformed or short of arguments: echo the spec.
+                        p = conv == '\0' ? q : q + 1;
+                        out.append(pct, static_cast<size_t>(p - pct));
+                        continue;
+                }
+                spec[n++] = conv;
+                spec[n] = '\0';
+                p = q + 1;
+
+                const LogArg &a = args[next++];
+                const bool    plain = lmStart == pct + 1;
+                switch (conv) {
+                        case 'd':
+                        case 'i': {
+                                int64_t v = asSigned(a);
+                                if (lm == "l") {
+                                        appendInteger(out, spec, plain, 10, static_cast<long>(v));
+                                } else if (lm == "ll" || lm == "q" || lm == "L") {
+                                        appendInteger(out, spec, plain, 10, static_cast<long long>(v));
+                                } else if (lm == "j") {
+                                        appendInteger(out, spec, plain, 10, static_cast<intmax_t>(v));
+                                } else if (lm == "z" || lm == "t") {
+                                        appendInteger(out, spec, plain, 10, static_cast<ptrdiff_t>(v));
+                                } else if (lm == "hh") {
+                                        appendInteger(out, spec, plain, 10, static_cast<signed char>(v));
+                                } else if (lm == "h") {
+                                        appendInteger(out, spec, plain, 10, static_cast<short>(v));
+                                } else {
+                                        appendInteger(out, spec, plain, 10, static_cast<int>(v));
+                                }
+                                break;
+                        }
+                        case 'o':
+                        case 'u':
+                        case 'x':
+                        case 'X': {
+                                uint64_t v = static_cast<uint64_t>(asSigned(a));
+                                int      base = conv == 'o' ? 8 : conv == 'x' ? 16 : conv == 'u' ? 10 : 0;
+                                bool     fast = plain && base != 0;
+                                if (lm == "l") {
+                                        appendInteger(out, spec, fast, base, static_cast<unsigned long>(v));
+                                } else if (lm == "ll" || lm == "q" || lm == "L") {
+                                        appendInteger(out, spec, fast, base, static_cast<unsigned long long>(v));
+                                } else if (lm == "j") {
+                                        appendInteger(out, spec, fast, base, static_cast<uintmax_t>(v));
+                                } else if (lm == "z" || lm == "t") {
+                                        appendInteger(out, spec, fast, base, static_cast<size_t>(v));
+                                } else if (lm == "hh") {
+                                        appendInteger(out, spec, fast, base, static_cast<unsigned char>(v));
+                                } else if (lm == "h") {
+                                        appendInteger(out, spec, fast, base, static_cast<unsigned short>(v));
+                                } else {
+                                        appendInteger(out, spec, fast, base, static_cast<unsigned int>(v));
+                                }
+                                break;
+                        }
+                        case 'c':
+                                if (lm == "l") appendFormatted(out, spec, static_cast<wint_t>(asSigned(a)));
+                                else appendFormatted(out, spec, static_cast<int>(asSigned(a)));
+                                break;
+                        case 'e':
+                        case 'E':
+                        case 'f':
+                        case 'F':
+                        case 'g':
+                        case 'G':
+                        case 'a':
+                        case 'A':
+                                if (lm == "L") appendFormatted(out, spec, static_cast<long double>(asDouble(a)));
+                                else appendFormatted(out, spec, asDouble(a));
+                                break;
+                        case 's':
+                                if (a.kind != LogArg::CString) appendFormatted(out, "%p", a.p);
+                                else if (plain) out.append(a.s != nullptr ? a.s : "(null)");
+                                else appendFormatted(out, spec, a.s);
+                                break;
+                        case 'p': appendFormatted(out, spec, a.p); break;
+                        default: out.append(pct, static_cast<size_t>(p - pct)); break;
+                }
+        }
+        return String(std::move(out));
+}
+
 Logger::ListenerHandle Logger::installListener(LogListener listener, size_t replayCount) {
         if (!listener) return 0;
         if (_terminating.value()) return 0;
         auto                   promise = std::make_shared<Promise<ListenerHandle>>();
         Future<ListenerHandle> future = promise->future();
-        _queue.emplace(CmdInstallListener{std::move(listener), replayCount, promise});
+        enqueue(CmdInstallListener{std::move(listener), replayCount, promise});
         return future.result().first();
 }
 
@@ -172,7 +576,7 @@ void Logger::removeListener(ListenerHandle handle) {
         if (_terminating.value()) return;
         auto         promise = std::make_shared<Promise<void>>();
         Future<void> future = promise->future();
-        _queue.emplace(CmdRemoveListener{handle, promise});
+        enqueue(CmdRemoveListener{handle, promise});
         future.waitForFinished();
 }
 
@@ -182,7 +586,7 @@ Logger::~Logger() {
         // tell the worker to exit and join it.
         sync();
         _terminating.setValue(true);
-        _queue.emplace(CmdTerminate{});
+        enqueue(CmdTerminate{});
         _thread.join();
 }
 
@@ -369,30 +773,24 @@ void Logger::worker() {
         size_t cmdct = 0;
 
         while (running) {
-                auto [cmd, err] = _queue.pop();
+                auto [qc, err] = _queue.pop();
                 cmdct++;
+                // Anything staged before this command was issued goes
+                // out first.
+                drainStaged(qc.stamp, logFile);
                 std::visit(
                         [&](auto &&arg) {
                                 using T = std::decay_t<decltype(arg)>;
                                 if constexpr (std::is_same_v<T, LogEntry>) {
-                                        writeLog(arg, logFile);
-                                        auto   it = _threadNames.find(arg.threadId);
-                                        String tname = it != _threadNames.end() ? it->second : String();
-                                        // Append to the history ring, trimming to the
-                                        // currently configured size.  Trimming is done
-                                        // here (rather than on setHistorySize) so the
-                                        // size knob can be changed from any thread
-                                        // without taking a lock.
-                                        size_t cap = _historySize.value();
-                                        if (cap > 0) {
-                                                _history.pushToBack(HistoryEntry{arg, tname});
-                                                while (_history.size() > cap) _history.popFromFront();
-                                        } else if (_history.size() > 0) {
-                                                _history.clear();
-                                        }
-                                        // Fan out to any registered listeners.
-                                        for (auto &lst : _listeners) {
-                                                lst.fn(arg, tname);
+                                        processEntry(arg, logFile);
+                                } else if constexpr (std::is_same_v<T, CmdDrain>) {
+                                        // Re-arm the producers' wake, then re-post
+                                        // ourselves if records are still waiting
+                                        // (newer than this command, or published
+                                        // while we were clearing the flag).
+                                        _wakePending.exchange(false, MemoryOrder::SeqCst);
+                                        if (stagingPending() && !_wakePending.exchange(true, MemoryOrder::SeqCst)) {
+                                                enqueue(CmdDrain{});
                                         }
                                 } else if constexpr (std::is_same_v<T, CmdSetThreadName>) {
                                         _threadNames[arg.threadId] = arg.name;
@@ -432,6 +830,7 @@ void Logger::worker() {
                                         arg.promise->setValue();
                                 } else if constexpr (std::is_same_v<T, CmdTerminate>) {
                                         running = false;
+                                        drainStaged(INT64_MAX, logFile);
                                         if (_promeki_debug_enabled) {
                                                 LogEntry logentry{DateTime::now(),
                                                                   Debug,
@@ -445,11 +844,117 @@ void Logger::worker() {
                                         }
                                 }
                         },
-                        cmd);
+                        qc.cmd);
         }
         delete logFile;
 }
 
+void Logger::processEntry(const LogEntry &entry, FileIODevice *logFile) {
+        writeLog(entry, logFile);
+        auto   it = _threadNames.find(entry.threadId);
+        String tname = it != _threadNames.end() ? it->second : String();
+        // Append to the history ring, trimming to the currently
+        // configured size.  Trimming is done here (rather than on
+        // setHistorySize) so the size knob can be changed from any
+        // thread without taking a lock.
+        size_t cap = _historySize.value();
+        if (cap > 0) {
+                _history.pushToBack(HistoryEntry{entry, tname});
+                while (_history.size() > cap) _history.popFromFront();
+        } else if (_history.size() > 0) {
+                _history.clear();
+        }
+        // Fan out to any registered listeners.
+        for (auto &lst : _listeners) {
+                lst.fn(entry, tname);
+        }
+        return;
+}
+
+void Logger::refreshStagingRings() {
+        // The lock is only taken when the generation moved, and never
+        // held while formatting, so listeners may log from the worker.
+        if (_stagingGeneration.value() == _drainGeneration) return;
+        Mutex::Locker lock(_stagingMutex);
+        _drainRings = _stagingRings;
+        _drainGeneration = _stagingGeneration.value();
+        return;
+}
+
+bool Logger::stagingPending() {
+        refreshStagingRings();
+        for (auto &ring : _drainRings) {
+                if (ring->front() != nullptr) return true;
+        }
+        return false;
+}
+
+void Logger::drainStaged(int64_t limit, FileIODevice *logFile) {
+        refreshStagingRings();
+
+        // Merge the rings by stamp: each ring is already in order, so
+        // repeatedly emit the oldest head record below the limit.
+        LogArg args[64];
+        for (;;) {
+                StagingRing        *best = nullptr;
+                const StagedRecord *bestRec = nullptr;
+                for (auto &ring : _drainRings) {
+                        const StagedRecord *rec = ring->front();
+                        if (rec == nullptr || rec->stamp >= limit) continue;
+                        if (bestRec == nullptr || rec->stamp < bestRec->stamp) {
+                                best = ring.get();
+                                bestRec = rec;
+                        }
+                }
+                if (best == nullptr) break;
+
+                size_t      count = bestRec->argCount;
+                const auto *slots = reinterpret_cast<const LogArg *>(bestRec + 1);
+                const char *str = reinterpret_cast<const char *>(slots + count);
+                for (size_t i = 0; i < count; i++) {
+                        args[i] = slots[i];
+                        if (args[i].kind != LogArg::CString) continue;
+                        if (args[i].length == NullString) {
+                                args[i].s = nullptr;
+                                continue;
+                        }
+                        args[i].s = str;
+                        str += args[i].length + 1;
+                }
+                LogEntry entry{_wallBase + Duration::fromNanoseconds(bestRec->stamp - _steadyBase),
+                               static_cast<LogLevel>(bestRec->level),
+                               bestRec->file,
+                               bestRec->line,
+                               best->threadId,
+                               formatArgs(bestRec->format, args, count)};
+                best->pop(bestRec);
+                processEntry(entry, logFile);
+        }
+
+        // Release rings whose thread has exited once they are empty.
+        // The retired flag is read first: after it is set the owner
+        // never writes again, so an empty ring stays empty.
+        StagingRingList done;
+        for (auto &ring : _drainRings) {
+                if (ring->retired.value() && ring->front() == nullptr) done.pushToBack(ring);
+        }
+        if (!done.isEmpty()) {
+                Mutex::Locker lock(_stagingMutex);
+                for (auto &ring : done) {
+                        for (auto it = _stagingRings.begin(); it != _stagingRings.end(); ++it) {
+                                if (*it == ring) {
+                                        _stagingRings.remove(it);
+                                        break;
+                                }
+                        }
+                }
+                _stagingGeneration.fetchAndAdd(1);
+                _drainRings = _stagingRings;
+                _drainGeneration = _stagingGeneration.value();
+        }
+        return;
+}
+
 void Logger::writeLog(const LogEntry &entry, FileIODevice *logFile) {
         auto      it = _threadNames.find(entry.threadId);
         LogFormat fmt{&entry, it != _threadNames.end() ? &it->second : nullptr};
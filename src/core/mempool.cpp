@@ -5,17 +5,608 @@
  * See LICENSE file in the project root folder for license information.
  */
 
+#include <bit>
+#include <cstdint>
 #include <promeki/mempool.h>
+#include <promeki/atomic.h>
+#include <promeki/list.h>
 #include <promeki/logger.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace {
+
+        // TLSF geometry.  Sizes below SmallBlock map linearly onto the 32
+        // lists of first-level 0 in TlsfGranule steps; above that every
+        // power of two gets its own first level split into 32 lists.
+        constexpr uint32_t Nil = 0xFFFFFFFFu;
+        constexpr int      SlLog2 = 5;
+        constexpr int      SlCount = 1 << SlLog2;
+        constexpr int      GranuleLog2 = std::countr_zero(MemPool::TlsfGranule);
+        constexpr int      FlShift = SlLog2 + GranuleLog2;
+        constexpr size_t   SmallBlock = size_t(1) << FlShift;
+        constexpr int      FlCount = 64 - FlShift + 1;
+        constexpr size_t   MaxRequest = SIZE_MAX >> 2;
+
+        int fls(uint64_t v) { return 63 - std::countl_zero(v); }
+
+        // List a block of exactly @p size bytes is filed under.
+        void mappingInsert(size_t size, int &fl, int &sl) {
+                if (size < SmallBlock) {
+                        fl = 0;
+                        sl = static_cast<int>(size >> GranuleLog2);
+                } else {
+                        const int f = fls(size);
+                        sl = static_cast<int>((size >> (f - SlLog2)) ^ SlCount);
+                        fl = f - (FlShift - 1);
+                }
+                return;
+        }
+
+        // First list whose every block is guaranteed to hold @p size bytes.
+        void mappingSearch(size_t size, int &fl, int &sl) {
+                if (size >= SmallBlock) size += (size_t(1) << (fls(size) - SlLog2)) - 1;
+                mappingInsert(size, fl, sl);
+                return;
+        }
+
+        uintptr_t alignUp(uintptr_t v, size_t align) {
+                return (v + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        }
+
+        // Guards the pool <-> thread cache links: cache creation, thread
+        // exit and pool destruction.  Never taken on the hot path.
+        Mutex &cacheRegistryMutex() {
+                static Mutex m;
+                return m;
+        }
+
+        Atomic<uint64_t> nextPoolId(1);
+
+} // namespace
+
+struct MemPool::Tlsf {
+                enum State : uint8_t { Spare, Free, Used };
+
+                // Block metadata, kept outside the managed memory.  Spare
+                // descriptors are chained through nextFree.
+                struct Desc {
+                                uintptr_t address = 0;   // Block start.
+                                size_t    size = 0;      // Block bytes, padding included.
+                                uintptr_t user = 0;      // Pointer handed out (Used only).
+                                size_t    alignment = 1; // Alignment the block was allocated with.
+                                uint32_t  prevPhys = Nil;
+                                uint32_t  nextPhys = Nil;
+                                uint32_t  prevFree = Nil;
+                                uint32_t  nextFree = Nil;
+                                uint16_t  cacheClass = 0; // Front cache class, 0 = not cacheable.
+                                State     state = Spare;
+                };
+
+                // One thread's cache for one pool.  Only the owning thread
+                // touches the slots; detached is guarded by the registry.
+                struct ThreadCache {
+                                Tlsf          *tlsf;
+                                uint64_t       poolId;
+                                size_t         depth;
+                                bool           detached = false;
+                                List<uint32_t> counts;
+                                List<uint32_t> slots;
+
+                                ThreadCache(Tlsf *t, size_t classes, size_t d)
+                                    : tlsf(t), poolId(t->id), depth(d), counts(classes + 1, 0),
+                                      slots((classes + 1) * d, Nil) {}
+
+                                bool push(size_t cls, uint32_t idx) {
+                                        uint32_t &n = counts[cls];
+                                        if (n >= depth) return false;
+                                        slots[cls * depth + n++] = idx;
+                                        return true;
+                                }
+
+                                uint32_t pop(size_t cls) {
+                                        uint32_t &n = counts[cls];
+                                        if (n == 0) return Nil;
+                                        return slots[cls * depth + --n];
+                                }
+                };
+
+                // Every cache the current thread holds, across pools.
+                // Returns cached blocks to still-live pools at thread exit.
+                struct ThreadCaches {
+                                List<ThreadCache *> list;
+
+                                ~ThreadCaches() {
+                                        for (ThreadCache *c : list) {
+                                                {
+                                                        Mutex::Locker reg(cacheRegistryMutex());
+                                                        if (!c->detached) {
+                                                                c->tlsf->drainCache(c);
+                                                                c->tlsf->caches.removeFirst(c);
+                                                        }
+                                                }
+                                                delete c;
+                                        }
+                                }
+                };
+
+                Config   config;
+                uint64_t id;
+                size_t   cacheClasses = 0;
+                Mutex    mutex;
+
+                Desc    *descs = nullptr;
+                uint32_t capacity = 0;
+                uint32_t spareHead = Nil;
+
+                uint64_t flBitmap = 0;
+                uint32_t slBitmap[FlCount] = {};
+                uint32_t heads[FlCount][SlCount];
+
+                size_t freeBytes = 0;
+                size_t usedBytes = 0;
+                size_t freeCount = 0;
+                size_t usedCount = 0;
+
+                // Live allocations by user pointer: linear probing with
+                // backward-shift deletion, written under the mutex and
+                // read lock-free by the front cache under a seqlock.
+                Atomic<uintptr_t> *keys = nullptr;
+                Atomic<uint32_t>  *vals = nullptr;
+                size_t             hashMask = 0;
+                int                hashShift = 0;
+                Atomic<uint64_t>   seq{0};
+
+                Atomic<size_t>      cachedBytes{0};
+                Atomic<size_t>      cachedBlocks{0};
+                List<ThreadCache *> caches; // Guarded by cacheRegistryMutex().
+
+                explicit Tlsf(const Config &cfg) : config(cfg), id(nextPoolId.fetchAndAdd(1)) {
+                        if (config.maxBlocks < 2) config.maxBlocks = 2;
+                        if (config.maxBlocks > Nil - 1) config.maxBlocks = Nil - 1;
+                        capacity = static_cast<uint32_t>(config.maxBlocks);
+                        descs = new Desc[capacity];
+                        for (uint32_t i = 0; i < capacity; i++) descs[i].nextFree = i + 1 < capacity ? i + 1 : Nil;
+                        spareHead = 0;
+                        for (int fl = 0; fl < FlCount; fl++) {
+                                for (int sl = 0; sl < SlCount; sl++) heads[fl][sl] = Nil;
+                        }
+
+                        const int bits = std::max(4, fls(capacity) + 2);
+                        const size_t slots = size_t(1) << bits;
+                        hashMask = slots - 1;
+                        hashShift = 64 - bits;
+                        keys = new Atomic<uintptr_t>[slots];
+                        vals = new Atomic<uint32_t>[slots];
+                        for (size_t i = 0; i < slots; i++) vals[i].store(Nil, MemoryOrder::Relaxed);
+
+                        if (config.frontCacheMaxSize > 0 && config.frontCacheDepth > 0) {
+                                const size_t maxSize = std::min(config.frontCacheMaxSize, MaxFrontCacheSize);
+                                cacheClasses = alignUp(maxSize, TlsfGranule) >> GranuleLog2;
+                        }
+                }
+
+                ~Tlsf() {
+                        {
+                                Mutex::Locker reg(cacheRegistryMutex());
+                                for (ThreadCache *c : caches) c->detached = true;
+                        }
+                        delete[] descs;
+                        delete[] keys;
+                        delete[] vals;
+                }
+
+                // ---- descriptor table ----
+
+                uint32_t takeDesc() {
+                        const uint32_t i = spareHead;
+                        if (i == Nil) return Nil;
+                        spareHead = descs[i].nextFree;
+                        descs[i] = Desc();
+                        return i;
+                }
+
+                void releaseDesc(uint32_t i) {
+                        descs[i] = Desc();
+                        descs[i].nextFree = spareHead;
+                        spareHead = i;
+                        return;
+                }
+
+                // ---- segregated free lists ----
+
+                void insertFree(uint32_t i) {
+                        Desc &d = descs[i];
+                        int   fl, sl;
+                        mappingInsert(d.size, fl, sl);
+                        d.state = Free;
+                        d.prevFree = Nil;
+                        d.nextFree = heads[fl][sl];
+                        if (d.nextFree != Nil) descs[d.nextFree].prevFree = i;
+                        heads[fl][sl] = i;
+                        flBitmap |= uint64_t(1) << fl;
+                        slBitmap[fl] |= uint32_t(1) << sl;
+                        freeBytes += d.size;
+                        freeCount++;
+                        return;
+                }
+
+                void removeFree(uint32_t i) {
+                        Desc &d = descs[i];
+                        int   fl, sl;
+                        mappingInsert(d.size, fl, sl);
+                        if (d.prevFree != Nil) descs[d.prevFree].nextFree = d.nextFree;
+                        else heads[fl][sl] = d.nextFree;
+                        if (d.nextFree != Nil) descs[d.nextFree].prevFree = d.prevFree;
+                        if (heads[fl][sl] == Nil) {
+                                slBitmap[fl] &= ~(uint32_t(1) << sl);
+                                if (slBitmap[fl] == 0) flBitmap &= ~(uint64_t(1) << fl);
+                        }
+                        d.prevFree = d.nextFree = Nil;
+                        freeBytes -= d.size;
+                        freeCount--;
+                        return;
+                }
+
+                uint32_t findFree(size_t needed) const {
+                        int fl, sl;
+                        mappingSearch(needed, fl, sl);
+                        uint32_t slMap = slBitmap[fl] & (~uint32_t(0) << sl);
+                        if (slMap == 0) {
+                                const uint64_t flMap = fl + 1 < FlCount ? flBitmap & (~uint64_t(0) << (fl + 1)) : 0;
+                                if (flMap != 0) {
+                                        fl = std::countr_zero(flMap);
+                                        slMap = slBitmap[fl];
+                                }
+                        }
+                        if (slMap != 0) return heads[fl][std::countr_zero(slMap)];
+
+                        // The rounded-up search skips the list the exact
+                        // size maps to, whose blocks may still fit.  Only
+                        // reached when nothing larger is free.
+                        mappingInsert(needed, fl, sl);
+                        for (uint32_t i = heads[fl][sl]; i != Nil; i = descs[i].nextFree) {
+                                if (descs[i].size >= needed) return i;
+                        }
+                        return Nil;
+                }
+
+                size_t largestFree() const {
+                        if (flBitmap == 0) return 0;
+                        const int fl = fls(flBitmap);
+                        const int sl = 31 - std::countl_zero(slBitmap[fl]);
+                        size_t    best = 0;
+                        for (uint32_t i = heads[fl][sl]; i != Nil; i = descs[i].nextFree) {
+                                best = std::max(best, descs[i].size);
+                        }
+                        return best;
+                }
+
+                // ---- allocation hash ----
+
+                size_t hashSlot(uintptr_t key) const {
+                        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> hashShift);
+                }
+
+                void beginWrite() {
+                        seq.store(seq.load(MemoryOrder::Relaxed) + 1, MemoryOrder::Relaxed);
+                        atomicThreadFence(MemoryOrder::Release);
+                        return;
+                }
+
+                void endWrite() {
+                        seq.store(seq.load(MemoryOrder::Relaxed) + 1, MemoryOrder::Release);
+                        return;
+                }
+
+                size_t hashFind(uintptr_t key) const {
+                        for (size_t i = hashSlot(key);; i = (i + 1) & hashMask) {
+                                if (vals[i].load(MemoryOrder::Relaxed) == Nil) return SIZE_MAX;
+                                if (keys[i].load(MemoryOrder::Relaxed) == key) return i;
+                        }
+                }
+
+                void hashInsert(uintptr_t key, uint32_t idx) {
+                        size_t i = hashSlot(key);
+                        while (vals[i].load(MemoryOrder::Relaxed) != Nil) i = (i + 1) & hashMask;
+                        beginWrite();
+                        keys[i].store(key, MemoryOrder::Relaxed);
+                        vals[i].store(idx, MemoryOrder::Relaxed);
+                        endWrite();
+                        return;
+                }
+
+                void hashErase(size_t i) {
+                        beginWrite();
+                        for (size_t j = (i + 1) & hashMask;; j = (j + 1) & hashMask) {
+                                const uint32_t v = vals[j].load(MemoryOrder::Relaxed);
+                                if (v == Nil) break;
+                                const uintptr_t k = keys[j].load(MemoryOrder::Relaxed);
+                                // Shift the entry back unless its home slot
+                                // lies cyclically within (i, j].
+                                const size_t home = hashSlot(k);
+                                const bool   stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                                if (stays) continue;
+                                keys[i].store(k, MemoryOrder::Relaxed);
+                                vals[i].store(v, MemoryOrder::Relaxed);
+                                i = j;
+                        }
+                        vals[i].store(Nil, MemoryOrder::Relaxed);
+                        endWrite();
+                        return;
+                }
+
+                // Lock-free lookup for the front cache.  Returns false when
+                // a concurrent writer may have torn the probe.
+                bool lookup(uintptr_t key, uint32_t &idx) const {
+                        const uint64_t s = seq.load(MemoryOrder::Acquire);
+                        if (s & 1) return false;
+                        idx = Nil;
+                        size_t i = hashSlot(key);
+                        for (size_t n = 0; n <= hashMask; n++, i = (i + 1) & hashMask) {
+                                const uint32_t v = vals[i].load(MemoryOrder::Relaxed);
+                                if (v == Nil) break;
+                                if (keys[i].load(MemoryOrder::Relaxed) == key) {
+                                        idx = v;
+                                        break;
+                                }
+                        }
+                        atomicThreadFence(MemoryOrder::Acquire);
+                        return seq.load(MemoryOrder::Relaxed) == s;
+                }
+
+                // ---- pool operations (mutex held) ----
+
+                bool addRegion(uintptr_t address, size_t size) {
+                        const uint32_t i = takeDesc();
+                        if (i == Nil) return false;
+                        descs[i].address = address;
+                        descs[i].size = size;
+                        insertFree(i);
+                        return true;
+                }
+
+                void *allocateLocked(size_t bytes, size_t align, uint16_t cacheClass) {
+                        const size_t   needed = bytes + (align > 1 ? align - 1 : 0);
+                        const uint32_t i = findFree(needed);
+                        if (i == Nil) return nullptr;
+                        removeFree(i);
+                        Desc     &d = descs[i];
+                        uintptr_t user = alignUp(d.address, align);
+
+                        // Give leading alignment padding back as its own
+                        // free block.  Its physical predecessor is in use
+                        // (free neighbours are always merged), so no
+                        // coalescing is needed.  Short of descriptors, the
+                        // padding simply stays inside the allocation.
+                        size_t pad = user - d.address;
+                        if (pad >= TlsfGranule) {
+                                const uint32_t h = takeDesc();
+                                if (h != Nil) {
+                                        Desc &head = descs[h];
+                                        head.address = d.address;
+                                        head.size = pad;
+                                        head.prevPhys = d.prevPhys;
+                                        head.nextPhys = i;
+                                        if (head.prevPhys != Nil) descs[head.prevPhys].nextPhys = h;
+                                        d.prevPhys = h;
+                                        d.address = user;
+                                        d.size -= pad;
+                                        insertFree(h);
+                                        pad = 0;
+                                }
+                        }
+
+                        const size_t tail = d.size - pad - bytes;
+                        if (tail >= TlsfGranule) {
+                                const uint32_t t = takeDesc();
+                                if (t != Nil) {
+                                        Desc &rest = descs[t];
+                                        rest.address = user + bytes;
+                                        rest.size = tail;
+                                        rest.prevPhys = i;
+                                        rest.nextPhys = d.nextPhys;
+                                        if (rest.nextPhys != Nil) descs[rest.nextPhys].prevPhys = t;
+                                        d.nextPhys = t;
+                                        d.size -= tail;
+                                        insertFree(t);
+                                }
+                        }
+
+                        d.state = Used;
+                        d.user = user;
+                        d.alignment = align;
+                        d.cacheClass = cacheClass;
+                        usedBytes += d.size;
+                        usedCount++;
+                        hashInsert(user, i);
+                        return reinterpret_cast<void *>(user);
+                }
+
+                void freeLocked(uintptr_t key) {
+                        const size_t slot = hashFind(key);
+                        if (slot == SIZE_MAX) return; // Invalid pointer, not found in allocations
+                        uint32_t i = vals[slot].load(MemoryOrder::Relaxed);
+                        hashErase(slot);
+                        usedBytes -= descs[i].size;
+                        usedCount--;
+
+                        const uint32_t prev = descs[i].prevPhys;
+                        if (prev != Nil && descs[prev].state == Free) {
+                                removeFree(prev);
+                                absorbNext(prev);
+                                i = prev;
+                        }
+                        const uint32_t next = descs[i].nextPhys;
+                        if (next != Nil && descs[next].state == Free) {
+                                removeFree(next);
+                                absorbNext(i);
+                        }
+                        descs[i].user = 0;
+                        descs[i].alignment = 1;
+                        descs[i].cacheClass = 0;
+                        insertFree(i);
+                        return;
+                }
+
+                // Folds the physical successor of @p i into @p i.
+                void absorbNext(uint32_t i) {
+                        const uint32_t n = descs[i].nextPhys;
+                        descs[i].size += descs[n].size;
+                        descs[i].nextPhys = descs[n].nextPhys;
+                        if (descs[i].nextPhys != Nil) descs[descs[i].nextPhys].prevPhys = i;
+                        releaseDesc(n);
+                        return;
+                }
+
+                // ---- front caches ----
+
+                static ThreadCaches &threadCaches() {
+                        static thread_local ThreadCaches local;
+                        return local;
+                }
+
+                ThreadCache *threadCache(bool create) {
+                        ThreadCaches &local = threadCaches();
+                        for (ThreadCache *c : local.list) {
+                                if (c->poolId == id) return c;
+                        }
+                        if (!create) return nullptr;
+                        ThreadCache *c = new ThreadCache(this, cacheClasses, config.frontCacheDepth);
+                        Mutex::Locker reg(cacheRegistryMutex());
+                        // Drop caches left behind by pools that have since
+                        // been destroyed.
+                        local.list.removeIf([](ThreadCache *old) {
+                                if (!old->detached) return false;
+                                delete old;
+                                return true;
+                        });
+                        caches.pushToBack(c);
+                        local.list.pushToBack(c);
+                        return c;
+                }
+
+                // Returns every block parked in @p c.  Registry lock held.
+                void drainCache(ThreadCache *c) {
+                        Mutex::Locker lock(mutex);
+                        for (size_t cls = 1; cls <= cacheClasses; cls++) {
+                                for (uint32_t idx = c->pop(cls); idx != Nil; idx = c->pop(cls)) {
+                                        cachedBytes.fetchAndSub(descs[idx].size, MemoryOrder::Relaxed);
+                                        cachedBlocks.fetchAndSub(1, MemoryOrder::Relaxed);
+                                        freeLocked(descs[idx].user);
+                                }
+                        }
+                        return;
+                }
+
+                void *allocate(size_t size, size_t align, const String &name) {
+                        if (size > MaxRequest) {
+                                promekiErr("MemPool '%s': allocate failed, size too large. Size %zu", name.cstr(),
+                                           size);
+                                return nullptr;
+                        }
+                        const size_t bytes = std::max(alignUp(size, TlsfGranule), TlsfGranule);
+                        uint16_t     cls = 0;
+                        if (cacheClasses > 0 && align <= TlsfGranule && (bytes >> GranuleLog2) <= cacheClasses) {
+                                cls = static_cast<uint16_t>(bytes >> GranuleLog2);
+                                ThreadCache   *c = threadCache(true);
+                                const uint32_t idx = c->pop(cls);
+                                if (idx != Nil) {
+                                        cachedBytes.fetchAndSub(descs[idx].size, MemoryOrder::Relaxed);
+                                        cachedBlocks.fetchAndSub(1, MemoryOrder::Relaxed);
+                                        return reinterpret_cast<void *>(descs[idx].user);
+                                }
+                                // Every block of a class must serve every
+                                // request the class admits.
+                                align = TlsfGranule;
+                        }
+                        Mutex::Locker lock(mutex);
+                        void         *ret = allocateLocked(bytes, align, cls);
+                        if (ret == nullptr) {
+                                promekiErr("MemPool '%s': allocate failed, unable to find free block large enough. "
+                                           "Size %d, Align %d",
+                                           name.cstr(), (int)size, (int)align);
+                        }
+                        return ret;
+                }
+
+                void free(void *ptr) {
+                        const uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+                        uint32_t        idx = Nil;
+                        if (cacheClasses > 0 && lookup(key, idx) && idx != Nil && descs[idx].cacheClass != 0) {
+                                // The caller owns the block, so its
+                                // descriptor is stable without the lock.
+                                ThreadCache *c = threadCache(true);
+                                if (c->push(descs[idx].cacheClass, idx)) {
+                                        cachedBytes.fetchAndAdd(descs[idx].size, MemoryOrder::Relaxed);
+                                        cachedBlocks.fetchAndAdd(1, MemoryOrder::Relaxed);
+                                        return;
+                                }
+                        }
+                        Mutex::Locker lock(mutex);
+                        freeLocked(key);
+                        return;
+                }
+
+                Stats stats() {
+                        Mutex::Locker lock(mutex);
+                        Stats         s = {0, 0, 0, 0, 0, 0, 0};
+                        s.cachedBytes = std::min(cachedBytes.load(MemoryOrder::Relaxed), usedBytes);
+                        s.cachedBlocks = std::min(cachedBlocks.load(MemoryOrder::Relaxed), usedCount);
+                        s.totalFree = freeBytes;
+                        s.totalUsed = usedBytes - s.cachedBytes;
+                        s.numFreeBlocks = freeCount;
+                        s.numAllocatedBlocks = usedCount - s.cachedBlocks;
+                        s.largestFreeBlock = largestFree();
+                        return s;
+                }
+
+                BlockSet memoryMap() {
+                        Mutex::Locker lock(mutex);
+                        BlockSet      ret;
+                        for (uint32_t i = 0; i < capacity; i++) {
+                                const Desc &d = descs[i];
+                                if (d.state == Spare) continue;
+                                Block block;
+                                block.allocated = d.state == Used;
+                                block.address = static_cast<intptr_t>(d.address);
+                                block.size = d.size;
+                                block.alignment = d.alignment;
+                                ret.insert(block);
+                        }
+                        return ret;
+                }
+};
+
 MemPool::MemPool() {
         _name = String::hex(reinterpret_cast<uintptr_t>(this));
 }
 
+MemPool::MemPool(Mode mode) : MemPool() {
+        _config.mode = mode;
+        if (mode == Mode::Tlsf) _tlsf = new Tlsf(_config);
+}
+
+MemPool::MemPool(const Config &config) : MemPool() {
+        _config = config;
+        if (config.mode == Mode::Tlsf) _tlsf = new Tlsf(_config);
+}
+
+MemPool::~MemPool() {
+        delete _tlsf;
+}
+
 void MemPool::addRegion(uintptr_t startingAddress, size_t size) {
-        Block block;
+        if (_tlsf) {
+                Mutex::Locker lock(_tlsf->mutex);
+                if (!_tlsf->addRegion(startingAddress, size)) {
+                        promekiErr("MemPool '%s': addRegion failed, out of block descriptors. Address %p, Size %zu",
+                                   _name.cstr(), reinterpret_cast<void *>(startingAddress), size);
+                }
+                return;
+        }
+        Mutex::Locker lock(_mutex);
+        Block         block;
         block.address = startingAddress;
         block.allocated = false;
         block.size = size;
@@ -24,8 +615,9 @@ void MemPool::addRegion(uintptr_t startingAddress, size_t size) {
 }
 
 MemPool::Stats MemPool::stats() const {
+        if (_tlsf) return _tlsf->stats();
         Mutex::Locker lock(_mutex);
-        Stats         stats = {0, 0, 0, 0, 0};
+        Stats         stats = {0, 0, 0, 0, 0, 0, 0};
 
         // Calculate statistics for free blocks
         for (const auto &block : _freeBlocks) {
@@ -45,6 +637,7 @@ MemPool::Stats MemPool::stats() const {
 }
 
 MemPool::BlockSet MemPool::memoryMap() const {
+        if (_tlsf) return _tlsf->memoryMap();
         Mutex::Locker lock(_mutex);
         // Start with all the free blocks then insert all the allocated ones.
         BlockSet ret = _freeBlocks;
@@ -72,6 +665,7 @@ void *MemPool::allocate(size_t size, size_t alignment) {
                            (int)size, (int)alignment);
                 return nullptr;
         }
+        if (_tlsf) return _tlsf->allocate(size, alignment, _name);
         Mutex::Locker lock(_mutex);
 
         // Walk through the blocks until we find one that's big enough
@@ -111,6 +705,10 @@ void *MemPool::allocate(size_t size, size_t alignment) {
 
 void MemPool::free(void *ptr) {
         if (!ptr) return;
+        if (_tlsf) {
+                _tlsf->free(ptr);
+                return;
+        }
         Mutex::Locker lock(_mutex);
         auto          it = _allocatedBlocks.find(reinterpret_cast<uintptr_t>(ptr));
         if (it == _allocatedBlocks.end()) return; // Invalid pointer, not found in allocations
@@ -163,4 +761,13 @@ void MemPool::free(void *ptr) {
         return;
 }
 
+void MemPool::flushThreadCache() {
+        if (!_tlsf || _tlsf->cacheClasses == 0) return;
+        Tlsf::ThreadCache *c = _tlsf->threadCache(false);
+        if (!c) return;
+        Mutex::Locker reg(cacheRegistryMutex());
+        _tlsf->drainCache(c);
+        return;
+}
+
 PROMEKI_NAMESPACE_END
@@ -53,6 +53,8 @@ MemSpace::Stats::Snapshot MemSpace::Stats::snapshot() const {
         s.peakCount = peakCount.value();
         s.peakBytes = peakBytes.value();
         s.peakResidentBytes = peakResidentBytes.value();
+        s.poolHitCount = poolHitCount.value();
+        s.poolMissCount = poolMissCount.value();
         return s;
 }
 
@@ -73,6 +75,8 @@ void MemSpace::Stats::reset() {
         peakCount.setValue(0);
         peakBytes.setValue(0);
         peakResidentBytes.setValue(0);
+        poolHitCount.setValue(0);
+        poolMissCount.setValue(0);
 }
 
 void MemSpace::Stats::recordAlloc(uint64_t bytes) {
@@ -408,6 +412,8 @@ StringList MemSpace::statsReport() const {
                                          (unsigned long long)s.copyFailCount));
         lines.pushToBack(String::sprintf("  fill:    %llu calls, %s", (unsigned long long)s.fillCount,
                                          Units::fromByteCount(s.fillBytes).cstr()));
+        lines.pushToBack(String::sprintf("  pool:    %llu hits, %llu misses", (unsigned long long)s.poolHitCount,
+                                         (unsigned long long)s.poolMissCount));
         return lines;
 }
 
@@ -126,6 +126,13 @@ SharedMemory &SharedMemory::operator=(SharedMemory &&other) noexcept {
         return *this;
 }
 
+Error SharedMemory::unlinkName() {
+        if (!_owner || _name.isEmpty()) return Error::Ok;
+        Error err = unlink(_name);
+        if (err.isOk()) _owner = false;
+        return err;
+}
+
 #if defined(PROMEKI_PLATFORM_POSIX)
 
 Error SharedMemory::create(const String &name, size_t size, uint32_t mode, const String &groupName) {
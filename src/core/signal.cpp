@@ -6,7 +6,32 @@
  */
 
 #include <promeki/signal.h>
+#include <promeki/basicthread.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace Detail {
+
+void SignalReadGate::synchronize() {
+        // Two phases, one per counter.  Flipping the epoch first sends
+        // new readers to the other counter, so the one being drained
+        // only holds readers that entered before the flip and each of
+        // those leaves within a handful of instructions.  A reader
+        // that loaded the epoch just before a flip may still land on
+        // the drained counter afterwards, but it then loads the
+        // snapshot pointer after the caller's exchange and can only
+        // see the replacement.  Draining both counters covers a
+        // reader that picked either parity before the exchange.
+        for (int phase = 0; phase < 2; phase++) {
+                unsigned int parity = _epoch.fetchAndAdd(1, MemoryOrder::SeqCst) & 1u;
+                int          spins = 0;
+                while (_readers[parity].load(MemoryOrder::SeqCst) != 0) {
+                        if (++spins > 64) BasicThread::yield();
+                }
+        }
+        return;
+}
+
+} // namespace Detail
+
 PROMEKI_NAMESPACE_END
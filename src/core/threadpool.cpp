@@ -34,8 +34,249 @@ int64_t threadCpuNs() {
         if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
         return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000LL + static_cast<int64_t>(ts.tv_nsec);
 }
+
+/// Identifies the work-stealing worker running on this thread, so
+/// a task submitted from inside a task can go straight onto the
+/// submitting worker's own queue.
+struct CurrentWorker {
+                const ThreadPool *pool = nullptr;
+                int               index = -1;
+};
+thread_local CurrentWorker tlsWorker;
 }  // namespace
 
+/// One pending task in a work-stealing pool.  Nodes are recycled
+/// through @ref NodePool, so queueing a task moves the caller's
+/// callable into an existing node instead of allocating one.
+struct ThreadPool::WorkStealing {
+                struct Node {
+                                TaggedTask       task;
+                                Atomic<uint32_t> next{0};      ///< Free-list / injection-list link (index + 1).
+                                uint32_t         index = 0;    ///< Position in the pool, or @c Unpooled.
+                };
+
+                /// Index-addressed Treiber stack of free nodes.  The
+                /// head packs a 32-bit generation above the 32-bit
+                /// (index + 1) of the top node, which rules out ABA
+                /// without a double-width CAS.  Nodes are carved out
+                /// of fixed-size chunks that live until the pool is
+                /// destroyed, so a stale index always refers to a
+                /// valid node.
+                class NodePool {
+                        public:
+                                static constexpr uint32_t ChunkShift = 8;
+                                static constexpr uint32_t ChunkSize = 1u << ChunkShift;
+                                static constexpr uint32_t MaxChunks = 4096;
+                                static constexpr uint32_t Unpooled = UINT32_MAX;
+
+                                ~NodePool() {
+                                        for (uint32_t i = 0; i < _chunkCount; i++) delete[] _chunks[i].value();
+                                }
+
+                                Node *acquire() {
+                                        for (;;) {
+                                                uint64_t head = _head.load(MemoryOrder::Acquire);
+                                                uint32_t top = static_cast<uint32_t>(head);
+                                                if (top == 0) {
+                                                        if (!grow()) {
+                                                                // Every chunk is in flight; degrade to
+                                                                // a one-off heap node rather than fail.
+                                                                Node *n = new Node;
+                                                                n->index = Unpooled;
+                                                                return n;
+                                                        }
+                                                        continue;
+                                                }
+                                                Node          *n = at(top - 1);
+                                                const uint64_t next = ((head >> 32) + 1) << 32 |
+                                                                      n->next.load(MemoryOrder::Relaxed);
+                                                if (_head.compareExchangeWeak(head, next, MemoryOrder::Acquire,
+                                                                              MemoryOrder::Relaxed)) {
+                                                        return n;
+                                                }
+                                        }
+                                }
+
+                                void release(Node *n) {
+                                        n->task = TaggedTask();
+                                        if (n->index == Unpooled) {
+                                                delete n;
+                                                return;
+                                        }
+                                        uint64_t head = _head.load(MemoryOrder::Relaxed);
+                                        for (;;) {
+                                                n->next.store(static_cast<uint32_t>(head), MemoryOrder::Relaxed);
+                                                const uint64_t next = ((head >> 32) + 1) << 32 | (n->index + 1);
+                                                if (_head.compareExchangeWeak(head, next, MemoryOrder::Release,
+                                                                              MemoryOrder::Relaxed)) {
+                                                        return;
+                                                }
+                                        }
+                                }
+
+                                Node *at(uint32_t index) const {
+                                        return _chunks[index >> ChunkShift].value() + (index & (ChunkSize - 1));
+                                }
+
+                        private:
+                                bool grow() {
+                                        Mutex::Locker locker(_growMutex);
+                                        // Another thread may have grown the pool
+                                        // while we waited for the lock.
+                                        if (static_cast<uint32_t>(_head.load(MemoryOrder::Acquire)) != 0) return true;
+                                        if (_chunkCount >= MaxChunks) return false;
+                                        Node          *chunk = new Node[ChunkSize];
+                                        const uint32_t base = _chunkCount * ChunkSize;
+                                        for (uint32_t i = 0; i < ChunkSize; i++) chunk[i].index = base + i;
+                                        _chunks[_chunkCount].setValue(chunk);
+                                        _chunkCount++;
+                                        for (uint32_t i = 0; i < ChunkSize; i++) release(&chunk[i]);
+                                        return true;
+                                }
+
+                                Atomic<uint64_t> _head{0};
+                                Mutex            _growMutex;
+                                uint32_t         _chunkCount = 0;
+                                Atomic<Node *>   _chunks[MaxChunks];
+                };
+
+                /// Bounded single-producer / multi-consumer ring owned
+                /// by one worker.  Only the owner pushes; the owner
+                /// and thieves all take from the same (oldest) end
+                /// with a CAS on @c _top, so a task that keeps
+                /// re-queueing itself (a busy @ref Strand) cannot
+                /// starve older work queued on the same worker.
+                /// A full ring spills into the injection queue.
+                class WorkerQueue {
+                        public:
+                                static constexpr int64_t Capacity = 1024;
+
+                                bool push(Node *n) {
+                                        const int64_t b = _bottom.load(MemoryOrder::Relaxed);
+                                        const int64_t t = _top.load(MemoryOrder::Acquire);
+                                        if (b - t >= Capacity) return false;
+                                        _slots[b & (Capacity - 1)].store(n, MemoryOrder::Relaxed);
+                                        _bottom.store(b + 1, MemoryOrder::Release);
+                                        return true;
+                                }
+
+                                Node *take() {
+                                        int64_t t = _top.load(MemoryOrder::Acquire);
+                                        for (;;) {
+                                                const int64_t b = _bottom.load(MemoryOrder::Acquire);
+                                                if (t >= b) return nullptr;
+                                                // The slot may be overwritten once _top
+                                                // moves past it; the CAS below fails in
+                                                // that case and the stale read is dropped.
+                                                Node *n = _slots[t & (Capacity - 1)].load(MemoryOrder::Relaxed);
+                                                if (_top.compareExchangeWeak(t, t + 1, MemoryOrder::SeqCst,
+                                                                             MemoryOrder::Acquire)) {
+                                                        return n;
+                                                }
+                                        }
+                                }
+
+                                bool isEmpty() const {
+                                        return _top.load(MemoryOrder::Acquire) >= _bottom.load(MemoryOrder::Acquire);
+                                }
+
+                        private:
+                                alignas(64) Atomic<int64_t> _top{0};
+                                alignas(64) Atomic<int64_t> _bottom{0};
+                                alignas(64) Atomic<Node *> _slots[Capacity];
+                };
+
+                NodePool                     nodes;
+                UniquePtr<WorkerQueue[]>     queues;
+                int                          queueCount = 0;
+
+                /// Global FIFO for tasks queued from non-worker
+                /// threads (and ring overflow).  An intrusive list
+                /// through Node::next, so pushing never allocates.
+                Mutex                        injectMutex;
+                uint32_t                     injectHead = 0;
+                uint32_t                     injectTail = 0;
+                List<Node *>                 injectUnpooled;
+                Atomic<int64_t>              injectCount{0};
+
+                Atomic<int>                  maxThreads{0};
+                Atomic<int>                  spawned{0};
+                Atomic<int>                  sleepers{0};
+                Atomic<int>                  active{0};
+                Atomic<int64_t>              pending{0};
+
+                ~WorkStealing() {
+                        for (Node *n : injectUnpooled) delete n;
+                }
+
+                void resizeQueues(int count) {
+                        queues = count > 0 ? UniquePtr<WorkerQueue[]>::createArray(static_cast<size_t>(count))
+                                           : UniquePtr<WorkerQueue[]>();
+                        queueCount = count;
+                        return;
+                }
+
+                void inject(Node *n) {
+                        Mutex::Locker locker(injectMutex);
+                        if (n->index == NodePool::Unpooled) {
+                                // Heap fallback nodes have no index to link
+                                // by; they ride in a side list instead.
+                                injectUnpooled.pushToBack(n);
+                        } else {
+                                n->next.store(0, MemoryOrder::Relaxed);
+                                if (injectTail != 0) {
+                                        nodes.at(injectTail - 1)->next.store(n->index + 1, MemoryOrder::Relaxed);
+                                } else {
+                                        injectHead = n->index + 1;
+                                }
+                                injectTail = n->index + 1;
+                        }
+                        injectCount.fetchAndAdd(1);
+                        return;
+                }
+
+                Node *popInjected() {
+                        if (injectCount.load(MemoryOrder::Acquire) == 0) return nullptr;
+                        Mutex::Locker locker(injectMutex);
+                        Node         *n = nullptr;
+                        if (injectHead != 0) {
+                                n = nodes.at(injectHead - 1);
+                                injectHead = n->next.load(MemoryOrder::Relaxed);
+                                if (injectHead == 0) injectTail = 0;
+                        } else if (!injectUnpooled.isEmpty()) {
+                                n = injectUnpooled.front();
+                                injectUnpooled.remove(static_cast<size_t>(0));
+                        }
+                        if (n != nullptr) injectCount.fetchAndSub(1);
+                        return n;
+                }
+
+                /// Own queue first, then the injection queue, then
+                /// every other worker's queue starting just past
+                /// @p self so thieves spread out.  @p self is -1 for
+                /// callers that are not workers.
+                Node *findWork(int self) {
+                        if (self >= 0 && self < queueCount) {
+                                if (Node *n = queues[self].take()) return n;
+                        }
+                        if (Node *n = popInjected()) return n;
+                        for (int i = 1; i <= queueCount; i++) {
+                                const int victim = (self + i + queueCount) % queueCount;
+                                if (victim == self) continue;
+                                if (Node *n = queues[victim].take()) return n;
+                        }
+                        return nullptr;
+                }
+
+                bool hasWork() const {
+                        if (injectCount.load(MemoryOrder::Acquire) != 0) return true;
+                        for (int i = 0; i < queueCount; i++) {
+                                if (!queues[i].isEmpty()) return true;
+                        }
+                        return false;
+                }
+};
+
 Mutex &ThreadPool::registryMutex() {
         static Mutex m;
         return m;
@@ -51,20 +292,25 @@ List<ThreadPool *> ThreadPool::allPools() {
         return registry();
 }
 
-ThreadPool::ThreadPool(int maxThreadCount, bool lazy) {
+ThreadPool::ThreadPool(int maxThreadCount, bool lazy, Scheduler scheduler) : _scheduler(scheduler) {
         int count = maxThreadCount;
         if (count < 0) {
                 count = static_cast<int>(BasicThread::idealThreadCount());
                 if (count <= 0) count = 1;
         }
         _maxThreadCount = count;
+        if (_scheduler == Scheduler::WorkStealing) {
+                _ws = UniquePtr<WorkStealing>::create();
+                _ws->resizeQueues(count);
+                _ws->maxThreads.setValue(count);
+        }
         if (!lazy && count > 0) spawnThreads(count);
         {
                 Mutex::Locker locker(registryMutex());
                 registry().pushToBack(this);
         }
-        promekiDebug("ThreadPool(%p): created, max %d threads, %s", (void *)this, _maxThreadCount,
-                     lazy ? "lazy" : "eager");
+        promekiDebug("ThreadPool(%p): created, max %d threads, %s, %s", (void *)this, _maxThreadCount,
+                     lazy ? "lazy" : "eager", _ws.isValid() ? "work-stealing" : "shared queue");
         return;
 }
 
@@ -134,7 +380,22 @@ void ThreadPool::setThreadCount(int count, bool lazy) {
                 _threadCount = 0;
                 _waitingCount = 0;
                 _shutdown = false;
-                if (!lazy && count > 0) spawnThreads(count);
+                if (_ws.isValid()) {
+                        // Every worker has drained its own queue before
+                        // exiting, so only the injection queue can
+                        // still hold tasks; it survives the resize.
+                        _ws->resizeQueues(count);
+                        _ws->spawned.setValue(0);
+                        _ws->maxThreads.setValue(count);
+                }
+                if (!lazy && count > 0) {
+                        spawnThreads(count);
+                } else if (_ws.isValid() && count > 0 && _ws->hasWork()) {
+                        // Tasks injected while the old workers were
+                        // shutting down need a worker even if nothing
+                        // else is ever submitted.
+                        maybeSpawnOne();
+                }
         }
         return;
 }
@@ -150,6 +411,7 @@ int ThreadPool::threadCount() const {
 }
 
 int ThreadPool::activeThreadCount() const {
+        if (_ws.isValid()) return _ws->active.value();
         Mutex::Locker locker(_mutex);
         return _activeCount;
 }
@@ -157,6 +419,7 @@ int ThreadPool::activeThreadCount() const {
 void ThreadPool::waitForDone() {
         _mutex.lock();
         auto pred = [this] {
+                if (_ws.isValid()) return _ws->pending.value() == 0;
                 return _tasks.isEmpty() && _activeCount == 0;
         };
         _doneCv.wait(_mutex, pred);
@@ -167,6 +430,7 @@ void ThreadPool::waitForDone() {
 Error ThreadPool::waitForDone(unsigned int timeoutMs) {
         _mutex.lock();
         auto pred = [this] {
+                if (_ws.isValid()) return _ws->pending.value() == 0;
                 return _tasks.isEmpty() && _activeCount == 0;
         };
         Error err = _doneCv.wait(_mutex, pred, timeoutMs);
@@ -177,6 +441,65 @@ Error ThreadPool::waitForDone(unsigned int timeoutMs) {
 void ThreadPool::clear() {
         Mutex::Locker locker(_mutex);
         _tasks.clear();
+        if (_ws.isValid()) {
+                // take() is safe from any thread, so the queues can be
+                // drained while workers keep running.  Holding _mutex
+                // keeps setThreadCount from swapping the queues out.
+                int64_t dropped = 0;
+                while (WorkStealing::Node *n = _ws->findWork(-1)) {
+                        _ws->nodes.release(n);
+                        dropped++;
+                }
+                if (dropped > 0 && _ws->pending.fetchAndSub(dropped) == dropped) _doneCv.wakeAll();
+        }
+        return;
+}
+
+void ThreadPool::enqueue(TaggedTask &&entry) {
+        if (_ws.isValid()) {
+                enqueueWorkStealing(std::move(entry));
+                return;
+        }
+        bool runInline = false;
+        {
+                Mutex::Locker locker(_mutex);
+                if (_maxThreadCount == 0) {
+                        runInline = true;
+                } else {
+                        _tasks.pushToBack(std::move(entry));
+                        maybeSpawnOne();
+                        _cv.wakeOne();
+                }
+        }
+        if (runInline) {
+                runTaskWithStats(entry);
+        }
+        return;
+}
+
+void ThreadPool::enqueueWorkStealing(TaggedTask &&entry) {
+        WorkStealing &ws = *_ws;
+        if (ws.maxThreads.load(MemoryOrder::Relaxed) == 0) {
+                runTaskWithStats(entry);
+                return;
+        }
+        WorkStealing::Node *node = ws.nodes.acquire();
+        node->task = std::move(entry);
+        ws.pending.fetchAndAdd(1);
+        const bool onWorker = tlsWorker.pool == this && tlsWorker.index < ws.queueCount;
+        if (!onWorker || !ws.queues[tlsWorker.index].push(node)) ws.inject(node);
+
+        // Pairs with the fence in workStealingWorkerFunc: either this
+        // thread sees the parked worker, or the worker sees the task
+        // on its re-check before it sleeps.
+        atomicThreadFence(MemoryOrder::SeqCst);
+        if (ws.sleepers.load() > 0) {
+                Mutex::Locker locker(_mutex);
+                _cv.wakeOne();
+        } else if (ws.spawned.load(MemoryOrder::Relaxed) < ws.maxThreads.load(MemoryOrder::Relaxed)) {
+                Mutex::Locker locker(_mutex);
+                if (!_shutdown) maybeSpawnOne();
+        }
         return;
 }
 
@@ -258,6 +581,10 @@ void ThreadPool::resetWorkStats() {
 }
 
 void ThreadPool::workerFunc(int index) {
+        if (_ws.isValid()) {
+                workStealingWorkerFunc(index);
+                return;
+        }
         promekiDebug("ThreadPool(%p): thread %d started", (void *)this, index);
         for (;;) {
                 TaggedTask task;
@@ -290,6 +617,42 @@ void ThreadPool::workerFunc(int index) {
         return;
 }
 
+void ThreadPool::workStealingWorkerFunc(int index) {
+        promekiDebug("ThreadPool(%p): work-stealing thread %d started", (void *)this, index);
+        WorkStealing &ws = *_ws;
+        tlsWorker.pool = this;
+        tlsWorker.index = index;
+        for (;;) {
+                WorkStealing::Node *node = ws.findWork(index);
+                if (node == nullptr) {
+                        _mutex.lock();
+                        _waitingCount++;
+                        ws.sleepers.fetchAndAdd(1);
+                        atomicThreadFence(MemoryOrder::SeqCst);
+                        // Re-check after advertising ourselves as a
+                        // sleeper; see enqueueWorkStealing.
+                        while (!ws.hasWork() && !_shutdown) _cv.wait(_mutex);
+                        ws.sleepers.fetchAndSub(1);
+                        _waitingCount--;
+                        const bool exiting = _shutdown && !ws.hasWork();
+                        _mutex.unlock();
+                        if (exiting) break;
+                        continue;
+                }
+                ws.active.fetchAndAdd(1);
+                runTaskWithStats(node->task);
+                ws.nodes.release(node);
+                ws.active.fetchAndSub(1);
+                if (ws.pending.fetchAndSub(1) == 1) {
+                        Mutex::Locker locker(_mutex);
+                        _doneCv.wakeAll();
+                }
+        }
+        tlsWorker = CurrentWorker();
+        promekiDebug("ThreadPool(%p): thread %d exiting", (void *)this, index);
+        return;
+}
+
 void ThreadPool::spawnThreads(int count) {
         // _namePrefix is read here under the caller's _mutex
         // ownership (spawnThreads is only called with _mutex held or
@@ -303,6 +666,7 @@ void ThreadPool::spawnThreads(int count) {
                 _threads.pushToBack(std::move(bt));
                 _threadCount++;
         }
+        if (_ws.isValid()) _ws->spawned.setValue(_threadCount);
         return;
 }
 
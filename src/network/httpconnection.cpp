@@ -16,6 +16,7 @@
 #include <promeki/sslsocket.h>
 #endif
 #include <llhttp.h>
+#include <cstdio>
 #include <cstring>
 #include <algorithm>
 
@@ -23,6 +24,40 @@ PROMEKI_NAMESPACE_BEGIN
 
 PROMEKI_DEBUG(HttpConnection);
 
+namespace {
+
+        // First request-body segment when Content-Length is known but
+        // the body size cap is lifted, so the declared length cannot
+        // be allocated up front; later segments double the total held
+        // so far.  With a cap in force, a body within it gets a single
+        // segment of its declared length instead.
+        constexpr size_t BodySegmentFirst = 1024 * 1024;
+
+        // Segment floor when the body length is unknown (chunked).
+        constexpr size_t BodySegmentMin = 16 * 1024;
+
+        // Inline response bodies up to this size are copied in behind
+        // the headers so they go out in one write; larger ones are
+        // queued as their own segment, sharing the response's Buffer.
+        constexpr size_t InlineBodyMax = 16 * 1024;
+
+        // Payload bytes read from a body stream per chunk.
+        constexpr size_t StreamChunkBytes = 64 * 1024;
+
+        // Pipelined input held while a response is outstanding.  Past
+        // this the connection stops reading and leaves the rest to
+        // TCP flow control.
+        constexpr size_t ParkedInputMax = 1024 * 1024;
+
+        // Chunked transfer-coding frame around each stream chunk: a
+        // fixed-width hex size line (leading zeros are allowed by RFC
+        // 9112 section 7.1) so the payload can be read straight into
+        // place behind it, and the CRLF that closes the chunk.
+        constexpr size_t ChunkHeaderBytes = 10; // "%08llx\r\n"
+        constexpr size_t ChunkTrailerBytes = 2;
+
+} // anonymous namespace
+
 // ============================================================
 // Pimpl: hold the C parser type out of the header so consumers
 // don't pay the llhttp.h include cost.
@@ -44,7 +79,6 @@ HttpConnection::HttpConnection(TcpSocket *socket, ObjectBase *parent)
 
         _loop = EventLoop::current();
         _readBuf = Buffer(8192);
-        _writeQueue = Buffer(0);
 
         // llhttp setup.  The parser lives entirely on the Impl; the
         // C callbacks read/write through parser->data which we point
@@ -79,6 +113,10 @@ void HttpConnection::setRequestHandler(RequestHandler handler) {
         _handler = std::move(handler);
 }
 
+void HttpConnection::setHeadersHandler(HeadersHandler handler) {
+        _headersHandler = std::move(handler);
+}
+
 void HttpConnection::setNeedsServerHandshake() {
 #if PROMEKI_ENABLE_TLS
         _needsServerHandshake = true;
@@ -175,13 +213,7 @@ void HttpConnection::onIoReady(int fd, uint32_t events) {
 
         // Reset the idle timer on every readiness event — both reads
         // and writes count as forward progress.
-        if (_timerId >= 0 && _loop != nullptr) {
-                _loop->stopTimer(_timerId);
-                _timerId = -1;
-        }
-        if (_idleTimeoutMs > 0 && _loop != nullptr) {
-                _timerId = _loop->startTimer(_idleTimeoutMs, [this]() { onIdleTimeout(); }, /*singleShot=*/true);
-        }
+        restartIdleTimer();
 
         if (events & EventLoop::IoError) {
                 close();
@@ -216,6 +248,19 @@ void HttpConnection::onIoReady(int fd, uint32_t events) {
         if (events & EventLoop::IoRead) readSome();
 }
 
+void HttpConnection::restartIdleTimer() {
+        if (_timerId >= 0 && _loop != nullptr) {
+                _loop->stopTimer(_timerId);
+                _timerId = -1;
+        }
+        // A slow worker is not an idle client.
+        if (_responseDeferred) return;
+        if (_idleTimeoutMs > 0 && _loop != nullptr) {
+                _timerId = _loop->startTimer(_idleTimeoutMs, [this]() { onIdleTimeout(); }, /*singleShot=*/true);
+        }
+        return;
+}
+
 void HttpConnection::onIdleTimeout() {
         promekiDebug("HttpConnection: idle timeout, closing");
         close();
@@ -242,8 +287,34 @@ void HttpConnection::readSome() {
                 return;
         }
 
-        const llhttp_errno_t rc = llhttp_execute(&_impl->parser, dst, static_cast<size_t>(n));
-        if (rc != HPE_OK && rc != HPE_PAUSED && rc != HPE_PAUSED_UPGRADE) {
+        // While a response is outstanding, or earlier input is still
+        // waiting for one, new bytes queue up behind it.
+        if (_state != State::Reading || _parkedInput.size() > 0) {
+                parkInput(dst, static_cast<size_t>(n));
+                if (_parkedInput.size() >= ParkedInputMax) {
+                        watchSocket(_state == State::Writing && !_streamParked);
+                }
+                return;
+        }
+        parseInput(dst, static_cast<size_t>(n));
+}
+
+void HttpConnection::parseInput(const char *data, size_t len) {
+        _parsing = true;
+        const llhttp_errno_t rc = llhttp_execute(&_impl->parser, data, len);
+        _parsing = false;
+        if (rc == HPE_PAUSED) {
+                // cbMessageComplete paused on a request whose response
+                // is still outstanding.  Whatever follows it belongs
+                // to later requests.
+                const char *pos = llhttp_get_error_pos(&_impl->parser);
+                llhttp_resume(&_impl->parser);
+                if (_state != State::Closed && pos != nullptr && pos < data + len) {
+                        parkInput(pos, static_cast<size_t>(data + len - pos));
+                }
+                return;
+        }
+        if (rc != HPE_OK && rc != HPE_PAUSED_UPGRADE) {
                 const char *reason = llhttp_get_error_reason(&_impl->parser);
                 promekiWarn("HttpConnection: parse error from %s: %s",
                             _socket != nullptr ? _socket->peerAddress().toString().cstr()
@@ -251,12 +322,53 @@ void HttpConnection::readSome() {
                             reason ? reason : "(unknown)");
                 // Best-effort 400 reply, then close.  Reuse the
                 // pending request as the responseSent context so
-                // observers see the failure surface.
-                HttpResponse res = HttpResponse::badRequest(reason ? reason : "");
-                enqueueResponse(std::move(res));
+                // observers see the failure surface.  A body callback
+                // that aborted the parse (413, failed sink) has
+                // already queued its own reply.
+                if (_state == State::Reading) {
+                        HttpResponse res = HttpResponse::badRequest(reason ? reason : "");
+                        enqueueResponse(std::move(res));
+                }
                 _keepAlive = false;
                 errorOccurredSignal.emit(Error::Invalid);
         }
+        return;
+}
+
+void HttpConnection::parkInput(const char *data, size_t len) {
+        const size_t used = _parkedInput.size();
+        if (_parkedInput.availSize() < used + len) {
+                Buffer grown(std::max(used + len, std::max(used * 2, _readBuf.allocSize())));
+                if (used > 0) std::memcpy(grown.data(), _parkedInput.data(), used);
+                grown.setSize(used);
+                _parkedInput = grown;
+        }
+        std::memcpy(static_cast<char *>(_parkedInput.data()) + used, data, len);
+        _parkedInput.setSize(used + len);
+        return;
+}
+
+void HttpConnection::resumeParsing() {
+        if (_state != State::Reading || _parkedInput.size() == 0) return;
+        // Take the parked bytes first: parsing may pause again and
+        // park a shorter tail of them.
+        Buffer input = _parkedInput;
+        _parkedInput = Buffer();
+        parseInput(static_cast<const char *>(input.data()), input.size());
+        return;
+}
+
+void HttpConnection::watchSocket(bool wantWrite) {
+        if (_loop == nullptr || _socket == nullptr || !_socket->isOpen()) return;
+        uint32_t mask = wantWrite ? EventLoop::IoWrite : 0;
+        if (_parkedInput.size() < ParkedInputMax) mask |= EventLoop::IoRead;
+        if (_ioHandle >= 0) _loop->removeIoSource(_ioHandle);
+        _ioHandle = -1;
+        if (mask != 0) {
+                _ioHandle = _loop->addIoSource(_socket->socketDescriptor(), mask,
+                                               [this](int f, uint32_t e) { onIoReady(f, e); });
+        }
+        return;
 }
 
 // ============================================================
@@ -338,6 +450,12 @@ int HttpConnection::cbHeadersComplete(void *parser) {
         self->_pendingRequest.setUrl(u);
         self->_pendingRequest.setPeerAddress(self->peerAddress());
 
+        // Remember the declared body length so the body segments can
+        // be sized to fit it.
+        if (self->_impl->parser.flags & F_CONTENT_LENGTH) {
+                self->_bodyExpected = static_cast<int64_t>(self->_impl->parser.content_length);
+        }
+
         // Default keep-alive policy: HTTP/1.1 keeps alive unless told
         // otherwise; HTTP/1.0 closes unless told otherwise.  llhttp
         // computes the post-headers verdict for us.
@@ -354,19 +472,27 @@ int HttpConnection::cbHeadersComplete(void *parser) {
                         self->_socket->write(kContinue, std::strlen(kContinue));
                 }
         }
+
+        // Give the owner a chance to route the request and install a
+        // body sink before any body bytes show up.
+        if (self->_headersHandler) self->_headersHandler(self->_pendingRequest);
         return 0;
 }
 
 int HttpConnection::cbBody(void *parser, const char *at, size_t len) {
         auto *self = CONN(parser);
         self->_bodyBytesSoFar += static_cast<int64_t>(len);
-        if (self->_maxBodyBytes >= 0 && self->_bodyBytesSoFar > self->_maxBodyBytes) {
+
+        // The cap applies before the sink sees anything: prepare()
+        // runs ahead of middleware, so a sink may be accepting bytes
+        // from a client that auth would later turn away.
+        const int64_t maxBody = self->bodyLimit();
+        if (maxBody >= 0 && self->_bodyBytesSoFar > maxBody) {
                 promekiWarn("HttpConnection: request body from %s exceeded maxBodyBytes=%lld "
                             "(received=%lld) — replying 413",
                             self->_socket != nullptr ? self->_socket->peerAddress().toString().cstr()
                                                      : "(no socket)",
-                            static_cast<long long>(self->_maxBodyBytes),
-                            static_cast<long long>(self->_bodyBytesSoFar));
+                            static_cast<long long>(maxBody), static_cast<long long>(self->_bodyBytesSoFar));
                 // 413: stop reading, queue the error reply, and ask
                 // llhttp to bail so the next execute() returns the
                 // user error.
@@ -378,23 +504,37 @@ int HttpConnection::cbBody(void *parser, const char *at, size_t len) {
                 return -1;
         }
 
-        // Append the body chunk to the request's body buffer.  The
-        // common case is a single contiguous chunk; for chunked
-        // transfer-encoding we may see many.
-        Buffer       existing = self->_pendingRequest.body();
-        const size_t prev = existing.isValid() ? existing.size() : 0;
-        Buffer       grown(prev + len);
-        if (prev > 0) std::memcpy(grown.data(), existing.data(), prev);
-        std::memcpy(static_cast<char *>(grown.data()) + prev, at, len);
-        grown.setSize(prev + len);
-        self->_pendingRequest.setBody(grown);
+        // Streaming: the bytes go straight from the read buffer to the
+        // sink.
+        const HttpRequest::BodySink &sink = self->_pendingRequest.bodySink();
+        if (sink) {
+                Error err = sink(at, len);
+                if (err.isOk()) return 0;
+                promekiWarn("HttpConnection: request body sink for %s from %s failed after %lld bytes: %s",
+                            self->_pendingRequest.url().briefForLog().cstr(),
+                            self->_socket != nullptr ? self->_socket->peerAddress().toString().cstr()
+                                                     : "(no socket)",
+                            static_cast<long long>(self->_bodyBytesSoFar), err.name().cstr());
+                HttpResponse res;
+                res.setStatus(HttpStatus::InternalServerError);
+                res.setText("Request body sink failed");
+                self->enqueueResponse(std::move(res));
+                self->_keepAlive = false;
+                return -1;
+        }
+
+        self->appendBody(at, len);
         return 0;
 }
 
 int HttpConnection::cbMessageComplete(void *parser) {
         auto *self = CONN(parser);
+        self->finishBody();
         self->deliverRequest();
-        return 0;
+        // Unless the response already went out in full, stop here:
+        // a request pipelined behind this one in the same read must
+        // not be handled (and answered) ahead of it.
+        return self->_state == State::Reading ? 0 : HPE_PAUSED;
 }
 
 #undef CONN
@@ -417,6 +557,75 @@ void HttpConnection::resetForNextRequest() {
         _hdrFieldComplete = false;
         _hdrValueComplete = false;
         _bodyBytesSoFar = 0;
+        _bodySegments.clear();
+        _bodyExpected = -1;
+}
+
+int64_t HttpConnection::bodyLimit() const {
+        const int64_t own = _pendingRequest.maxBodyBytes();
+        return own == HttpRequest::ConnectionMaxBodyBytes ? _maxBodyBytes : own;
+}
+
+void HttpConnection::appendBody(const char *data, size_t len) {
+        // Bytes already held: cbBody counted this call's bytes first.
+        size_t held = static_cast<size_t>(_bodyBytesSoFar) - len;
+        while (len > 0) {
+                if (_bodySegments.isEmpty() || _bodySegments.back().size() == _bodySegments.back().availSize()) {
+                        // Open a segment.  Each byte is copied into
+                        // place exactly once; nothing is ever moved
+                        // to make room.
+                        const int64_t maxBody = bodyLimit();
+                        size_t        seg = 0;
+                        if (held == 0 && _bodyExpected >= 0 && maxBody >= 0 && _bodyExpected <= maxBody) {
+                                // The declared length is within the
+                                // cap: one segment holds the whole
+                                // body and finishBody() never joins.
+                                seg = static_cast<size_t>(_bodyExpected);
+                        } else if (_bodyExpected >= 0 && static_cast<size_t>(_bodyExpected) > held) {
+                                // Uncapped: trust the declared length
+                                // only as far as the bytes that arrive.
+                                const size_t remaining = static_cast<size_t>(_bodyExpected) - held;
+                                seg = std::min(remaining, held == 0 ? BodySegmentFirst : held);
+                        } else {
+                                seg = std::max(BodySegmentMin, held);
+                        }
+                        _bodySegments.pushToBack(Buffer(seg));
+                }
+                Buffer      &tail = _bodySegments.back();
+                const size_t used = tail.size();
+                const size_t n = std::min(len, tail.availSize() - used);
+                std::memcpy(static_cast<char *>(tail.data()) + used, data, n);
+                tail.setSize(used + n);
+                data += n;
+                len -= n;
+                held += n;
+        }
+        return;
+}
+
+void HttpConnection::finishBody() {
+        if (_bodySegments.isEmpty()) return;
+        if (_bodySegments.size() == 1) {
+                // The common case: the segment was sized from
+                // Content-Length and becomes the body as-is.
+                _pendingRequest.setBody(_bodySegments.front());
+        } else {
+                // Several segments (a chunked upload, or one with the
+                // cap lifted): join them for handlers that read body(),
+                // which copies the body a second time.
+                size_t total = 0;
+                for (const Buffer &seg : _bodySegments) total += seg.size();
+                Buffer flat(total);
+                size_t at = 0;
+                for (const Buffer &seg : _bodySegments) {
+                        std::memcpy(static_cast<char *>(flat.data()) + at, seg.data(), seg.size());
+                        at += seg.size();
+                }
+                flat.setSize(total);
+                _pendingRequest.setBody(flat);
+        }
+        _bodySegments.clear();
+        return;
 }
 
 // ============================================================
@@ -432,6 +641,7 @@ void HttpConnection::deliverRequest() {
         requestReceivedSignal.emit(_pendingRequest);
 
         HttpResponse response;
+        _responseDeferred = false;
         if (_handler) {
                 _handler(_pendingRequest, response);
         } else {
@@ -439,13 +649,30 @@ void HttpConnection::deliverRequest() {
                 response.setText("No request handler installed");
         }
 
+        if (_responseDeferred) {
+                // The reply arrives through postResponse().  Keep
+                // reading so a client that goes away is noticed (any
+                // pipelined bytes are parked), but don't let a slow
+                // worker trip the idle timeout.
+                restartIdleTimer();
+                watchSocket(false);
+                return;
+        }
         enqueueResponse(std::move(response));
 }
 
+void HttpConnection::deferResponse() {
+        if (_state == State::AwaitingResponse) _responseDeferred = true;
+        return;
+}
+
 Error HttpConnection::postResponse(HttpResponse response) {
+        if (_state == State::Closed) return Error::NotOpen;
         if (_state != State::AwaitingResponse) {
                 return Error::Invalid;
         }
+        _responseDeferred = false;
+        restartIdleTimer();
         enqueueResponse(std::move(response));
         return Error::Ok;
 }
@@ -454,48 +681,30 @@ Error HttpConnection::postResponse(HttpResponse response) {
 // Response serialization & write pump
 // ============================================================
 
-namespace {
-
-        // Append-friendly write helper that grows a Buffer's logical size.
-        // The Buffer API is sized-but-fixed-capacity; we resize the
-        // underlying allocation when the requested size exceeds availSize().
-        static void appendBytes(Buffer &buf, const char *src, size_t n) {
-                if (n == 0) return;
-                const size_t haveLogical = buf.isValid() ? buf.size() : 0;
-                const size_t haveCap = buf.isValid() ? buf.availSize() : 0;
-                if (haveLogical + n <= haveCap) {
-                        std::memcpy(static_cast<char *>(buf.data()) + haveLogical, src, n);
-                        buf.setSize(haveLogical + n);
-                        return;
-                }
-                size_t newCap = std::max<size_t>(haveCap * 2, haveLogical + n);
-                if (newCap < 256) newCap = 256;
-                Buffer grown(newCap);
-                if (haveLogical > 0) std::memcpy(grown.data(), buf.data(), haveLogical);
-                std::memcpy(static_cast<char *>(grown.data()) + haveLogical, src, n);
-                grown.setSize(haveLogical + n);
-                buf = std::move(grown);
-        }
-
-        static void appendStr(Buffer &buf, const String &s) {
-                appendBytes(buf, s.cstr(), s.byteCount());
-        }
-
-        static void appendCStr(Buffer &buf, const char *s) {
-                appendBytes(buf, s, std::strlen(s));
-        }
+void HttpConnection::clearWriteQueue() {
+        _writeQueue.clear();
+        _writeIndex = 0;
+        _writeOffset = 0;
+        return;
+}
 
-} // anonymous namespace
+void HttpConnection::queueBytes(const void *data, size_t len) {
+        Buffer seg(len);
+        std::memcpy(seg.data(), data, len);
+        seg.setSize(len);
+        _writeQueue.pushToBack(std::move(seg));
+        return;
+}
 
 void HttpConnection::enqueueResponse(HttpResponse response) {
-        // Build status line + headers into _writeQueue.  Body is
-        // either inline (from response.body()) or streamed.
-        appendStr(_writeQueue, response.httpVersion());
-        appendCStr(_writeQueue, " ");
-        appendStr(_writeQueue, String::number(response.status().value()));
-        appendCStr(_writeQueue, " ");
-        appendStr(_writeQueue, response.reasonPhrase());
-        appendCStr(_writeQueue, "\r\n");
+        // Build status line + headers as one segment.  The body
+        // either follows inline (from response.body()) or is streamed.
+        String head = response.httpVersion();
+        head += " ";
+        head += String::number(response.status().value());
+        head += " ";
+        head += response.reasonPhrase();
+        head += "\r\n";
 
         const bool    stream = response.hasBodyStream();
         const int64_t streamLen = stream ? response.bodyStreamLength() : -1;
@@ -528,16 +737,26 @@ void HttpConnection::enqueueResponse(HttpResponse response) {
 
         // Emit headers in their canonical case order.
         response.headers().forEach([&](const String &name, const String &value) {
-                appendStr(_writeQueue, name);
-                appendCStr(_writeQueue, ": ");
-                appendStr(_writeQueue, value);
-                appendCStr(_writeQueue, "\r\n");
+                head += name;
+                head += ": ";
+                head += value;
+                head += "\r\n";
         });
-        appendCStr(_writeQueue, "\r\n");
-
-        if (!stream && response.body().isValid() && response.body().size() > 0) {
-                appendBytes(_writeQueue, static_cast<const char *>(response.body().data()), response.body().size());
-        }
+        head += "\r\n";
+
+        // A small body rides in the header segment; a large one is
+        // queued by reference so it is never copied.
+        const Buffer &body = response.body();
+        const size_t  bodyLen = (!stream && body.isValid()) ? body.size() : 0;
+        const size_t  inlineLen = bodyLen <= InlineBodyMax ? bodyLen : 0;
+        Buffer        headSeg(head.byteCount() + inlineLen);
+        std::memcpy(headSeg.data(), head.cstr(), head.byteCount());
+        if (inlineLen > 0) {
+                std::memcpy(static_cast<char *>(headSeg.data()) + head.byteCount(), body.data(), inlineLen);
+        }
+        headSeg.setSize(head.byteCount() + inlineLen);
+        _writeQueue.pushToBack(std::move(headSeg));
+        if (bodyLen > inlineLen) _writeQueue.pushToBack(body);
 
         if (stream) {
                 _streamSource = response.takeBodyStream();
@@ -554,15 +773,8 @@ void HttpConnection::enqueueResponse(HttpResponse response) {
 
         _state = State::Writing;
 
-        // Tell the loop we want write-readiness now.  A simple
-        // re-register: drop the old handle and add a new one with
-        // the read+write mask.
-        if (_loop != nullptr && _ioHandle >= 0) {
-                _loop->removeIoSource(_ioHandle);
-                const int fd = _socket->socketDescriptor();
-                _ioHandle = _loop->addIoSource(fd, EventLoop::IoRead | EventLoop::IoWrite,
-                                               [this](int f, uint32_t e) { onIoReady(f, e); });
-        }
+        // Tell the loop we want write-readiness now.
+        watchSocket(true);
 
         // One-line per-request server-side breadcrumb: peer + method
         // + path + status + body bytes.  Mirrors the HttpClient
@@ -588,26 +800,30 @@ void HttpConnection::enqueueResponse(HttpResponse response) {
 void HttpConnection::pumpWrite() {
         if (_state != State::Writing || _socket == nullptr) return;
 
-        // Drain the prepared header+inline body buffer.
-        if (_writeQueue.isValid() && _writeOffset < _writeQueue.size()) {
-                const char   *src = static_cast<const char *>(_writeQueue.data()) + _writeOffset;
-                const int64_t want = static_cast<int64_t>(_writeQueue.size() - _writeOffset);
-                const int64_t n = _socket->write(src, want);
-                if (n < 0) {
-                        // Treat as transient (EAGAIN-like); the loop
-                        // wakes us on the next IoWrite.
-                        return;
+        // Drain the queued segments in order.
+        while (_writeIndex < _writeQueue.size()) {
+                const Buffer &seg = _writeQueue[_writeIndex];
+                if (_writeOffset < seg.size()) {
+                        const char   *src = static_cast<const char *>(seg.data()) + _writeOffset;
+                        const int64_t want = static_cast<int64_t>(seg.size() - _writeOffset);
+                        const int64_t n = _socket->write(src, want);
+                        if (n < 0) {
+                                // Treat as transient (EAGAIN-like); the loop
+                                // wakes us on the next IoWrite.
+                                return;
+                        }
+                        _writeOffset += static_cast<size_t>(n);
+                        if (_writeOffset < seg.size()) return; // more to send
                 }
-                _writeOffset += static_cast<size_t>(n);
-                if (_writeOffset < _writeQueue.size()) return; // more to send
+                ++_writeIndex;
+                _writeOffset = 0;
         }
 
-        // Header/inline body fully sent; if we have a stream, pull
-        // the next chunk from it and re-fill the queue.
+        // Queue fully sent; if we have a stream, pull the next chunk
+        // from it and re-fill the queue.
         if (_streamSource.isValid()) {
                 IODevice *dev = const_cast<IODevice *>(_streamSource.ptr());
-                char      chunk[8192];
-                int64_t   cap = sizeof(chunk);
+                int64_t   cap = static_cast<int64_t>(StreamChunkBytes);
                 if (_streamRemaining >= 0 && _streamRemaining < cap) {
                         cap = _streamRemaining;
                 }
@@ -615,20 +831,24 @@ void HttpConnection::pumpWrite() {
                         // Done with a fixed-length stream.
                         detachStreamReadyRead();
                         _streamSource = IODevice::Shared{};
-                        _writeQueue = Buffer(0);
-                        _writeOffset = 0;
+                        clearWriteQueue();
                 } else if (cap == 0 && _streamChunked) {
                         // Final 0-length chunk + trailer terminator.
                         detachStreamReadyRead();
-                        _writeQueue = Buffer(0);
-                        appendCStr(_writeQueue, "0\r\n\r\n");
-                        _writeOffset = 0;
+                        clearWriteQueue();
+                        queueBytes("0\r\n\r\n", 5);
                         _streamSource = IODevice::Shared{};
                         // Recurse to push the terminator out.
                         pumpWrite();
                         return;
                 } else {
-                        const int64_t got = dev->read(chunk, cap);
+                        // Read straight into the segment that goes on
+                        // the wire, leaving room for the chunk framing.
+                        const size_t  lead = _streamChunked ? ChunkHeaderBytes : 0;
+                        const size_t  trail = _streamChunked ? ChunkTrailerBytes : 0;
+                        Buffer        seg(lead + static_cast<size_t>(cap) + trail);
+                        char         *payload = static_cast<char *>(seg.data()) + lead;
+                        const int64_t got = dev->read(payload, cap);
                         if (got < 0) {
                                 // Stream error: bail.
                                 detachStreamReadyRead();
@@ -658,15 +878,8 @@ void HttpConnection::pumpWrite() {
                                 //      their old behaviour.
                                 if (!dev->atEnd()) {
                                         attachStreamReadyRead();
-                                        if (_loop != nullptr && _ioHandle >= 0) {
-                                                _loop->removeIoSource(_ioHandle);
-                                                const int fd = _socket->socketDescriptor();
-                                                _ioHandle = _loop->addIoSource(
-                                                        fd, EventLoop::IoRead,
-                                                        [this](int f, uint32_t e) { onIoReady(f, e); });
-                                        }
-                                        _writeQueue = Buffer(0);
-                                        _writeOffset = 0;
+                                        watchSocket(false);
+                                        clearWriteQueue();
                                         _streamParked = true;
                                         return;
                                 }
@@ -674,24 +887,23 @@ void HttpConnection::pumpWrite() {
                                 // For chunked we still need the
                                 // 0-length terminator.
                                 detachStreamReadyRead();
-                                _writeQueue = Buffer(0);
-                                _writeOffset = 0;
-                                if (_streamChunked) appendCStr(_writeQueue, "0\r\n\r\n");
+                                clearWriteQueue();
+                                if (_streamChunked) queueBytes("0\r\n\r\n", 5);
                                 _streamSource = IODevice::Shared{};
                                 pumpWrite();
                                 return;
                         }
-                        _writeQueue = Buffer(0);
-                        _writeOffset = 0;
+                        clearWriteQueue();
                         if (_streamChunked) {
-                                String hdr = String::sprintf("%llx\r\n", static_cast<unsigned long long>(got));
-                                appendStr(_writeQueue, hdr);
-                                appendBytes(_writeQueue, chunk, static_cast<size_t>(got));
-                                appendCStr(_writeQueue, "\r\n");
+                                char hdr[ChunkHeaderBytes + 1];
+                                std::snprintf(hdr, sizeof(hdr), "%08llx\r\n", static_cast<unsigned long long>(got));
+                                std::memcpy(seg.data(), hdr, ChunkHeaderBytes);
+                                std::memcpy(payload + got, "\r\n", ChunkTrailerBytes);
                         } else {
-                                appendBytes(_writeQueue, chunk, static_cast<size_t>(got));
                                 _streamRemaining -= got;
                         }
+                        seg.setSize(lead + static_cast<size_t>(got) + trail);
+                        _writeQueue.pushToBack(std::move(seg));
                         // Send the new chunk in this same wake.
                         pumpWrite();
                         return;
@@ -706,22 +918,22 @@ void HttpConnection::pumpWrite() {
                 return;
         }
 
-        // No more bytes pending.  Drop the write subscription so we
-        // don't busy-spin on IoWrite, and decide what to do next.
-        if (_loop != nullptr && _ioHandle >= 0) {
-                _loop->removeIoSource(_ioHandle);
-                const int fd = _socket->socketDescriptor();
-                _ioHandle = _loop->addIoSource(fd, EventLoop::IoRead, [this](int f, uint32_t e) { onIoReady(f, e); });
-        }
-        _writeQueue = Buffer(0);
-        _writeOffset = 0;
-
-        if (_keepAlive) {
-                _state = State::Reading;
-                resetForNextRequest();
-        } else {
+        // No more bytes pending; decide what to do next.
+        clearWriteQueue();
+        if (!_keepAlive) {
                 close();
+                return;
         }
+        _state = State::Reading;
+        resetForNextRequest();
+
+        // Requests pipelined behind this response were parked when
+        // parsing paused; parse them now.  From inside a parse (the
+        // handler's response went out in one go) llhttp simply
+        // carries on.  Either way, drop the write subscription so we
+        // don't busy-spin on IoWrite.
+        if (!_parsing) resumeParsing();
+        if (_state == State::Reading) watchSocket(false);
 }
 
 // ============================================================
@@ -756,12 +968,7 @@ void HttpConnection::onStreamReadyRead() {
         // tick can drain whatever new bytes the producer pushed.
         if (_state != State::Writing || !_streamParked) return;
         _streamParked = false;
-        if (_loop != nullptr && _ioHandle >= 0 && _socket != nullptr) {
-                _loop->removeIoSource(_ioHandle);
-                const int fd = _socket->socketDescriptor();
-                _ioHandle = _loop->addIoSource(fd, EventLoop::IoRead | EventLoop::IoWrite,
-                                               [this](int f, uint32_t e) { onIoReady(f, e); });
-        }
+        watchSocket(true);
         // Don't recurse into pumpWrite here — the device's read()
         // may not yet have anything (the wake was advisory) and the
         // IoWrite re-arm above will fire pumpWrite via onIoReady on
@@ -53,6 +53,21 @@ void HttpRequest::setBody(const JsonArray &arr) {
         _headers.set("Content-Type", "application/json");
 }
 
+HttpRequest::BodySink HttpRequest::deviceSink(IODevice::Shared device) {
+        return [device](const void *data, size_t len) -> Error {
+                if (!device.isValid()) return Error::Invalid;
+                IODevice   *dev = const_cast<IODevice *>(device.ptr());
+                const char *src = static_cast<const char *>(data);
+                while (len > 0) {
+                        const int64_t n = dev->write(src, static_cast<int64_t>(len));
+                        if (n <= 0) return Error::IOError;
+                        src += n;
+                        len -= static_cast<size_t>(n);
+                }
+                return Error::Ok;
+        };
+}
+
 bool HttpRequest::operator==(const HttpRequest &other) const {
         if (!(_method == other._method)) return false;
         if (!(_url == other._url)) return false;
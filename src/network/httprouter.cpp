@@ -219,48 +219,65 @@ void HttpRouter::runChain(HttpRequest &request, HttpResponse &response, HttpHand
         step(0);
 }
 
-void HttpRouter::dispatch(HttpRequest &request, HttpResponse &response) const {
-        // Run middleware chain, then route-match at the terminus.
-        runChain(request, response, [&](const HttpRequest &, HttpResponse &res) {
-                // Find best route by score; track method-mismatches
-                // separately so we can report 405 + Allow correctly.
-                int                     bestScore = -1;
-                const Route            *best = nullptr;
-                HashMap<String, String> bestParams;
-
-                StringList allowMethods;
-                bool       pathMatched = false;
-
-                for (size_t i = 0; i < _routes.size(); ++i) {
-                        const Route            &r = _routes[i];
-                        HashMap<String, String> params;
-                        if (!matchPattern(r.pattern, request.path(), params)) {
-                                continue;
-                        }
-                        pathMatched = true;
-
-                        // Track Allow header info regardless of method.
-                        if (r.methodValue >= 0) {
-                                HttpMethod   m{r.methodValue};
-                                const String name = m.wireName();
-                                if (!allowMethods.contains(name)) {
-                                        allowMethods.pushToBack(name);
-                                }
+const HttpRouter::Route *HttpRouter::findRoute(const HttpRequest &request, HashMap<String, String> &paramsOut,
+                                               StringList *allowOut, bool *pathMatchedOut) const {
+        // Find best route by score; track method-mismatches
+        // separately so the caller can report 405 + Allow correctly.
+        int          bestScore = -1;
+        const Route *best = nullptr;
+        bool         pathMatched = false;
+
+        for (size_t i = 0; i < _routes.size(); ++i) {
+                const Route            &r = _routes[i];
+                HashMap<String, String> params;
+                if (!matchPattern(r.pattern, request.path(), params)) {
+                        continue;
+                }
+                pathMatched = true;
+
+                // Track Allow header info regardless of method.
+                if (allowOut != nullptr && r.methodValue >= 0) {
+                        HttpMethod   m{r.methodValue};
+                        const String name = m.wireName();
+                        if (!allowOut->contains(name)) {
+                                allowOut->pushToBack(name);
                         }
+                }
 
-                        // Method filter.  -1 means "any" and matches
-                        // every request method.
-                        if (r.methodValue >= 0 && r.methodValue != request.method().value()) {
-                                continue;
-                        }
+                // Method filter.  -1 means "any" and matches
+                // every request method.
+                if (r.methodValue >= 0 && r.methodValue != request.method().value()) {
+                        continue;
+                }
 
-                        const int score = patternScore(r.pattern);
-                        if (score > bestScore) {
-                                bestScore = score;
-                                best = &r;
-                                bestParams = std::move(params);
-                        }
+                const int score = patternScore(r.pattern);
+                if (score > bestScore) {
+                        bestScore = score;
+                        best = &r;
+                        paramsOut = std::move(params);
                 }
+        }
+        if (pathMatchedOut != nullptr) *pathMatchedOut = pathMatched;
+        return best;
+}
+
+void HttpRouter::prepare(HttpRequest &request) const {
+        HashMap<String, String> params;
+        const Route            *best = findRoute(request, params, nullptr, nullptr);
+        if (best == nullptr || !best->handler.isValid()) return;
+        request.setPathParams(params);
+        // Same const_cast rationale as dispatch() below.
+        const_cast<HttpHandler *>(best->handler.ptr())->prepare(request);
+        return;
+}
+
+void HttpRouter::dispatch(HttpRequest &request, HttpResponse &response) const {
+        // Run middleware chain, then route-match at the terminus.
+        runChain(request, response, [&](const HttpRequest &, HttpResponse &res) {
+                HashMap<String, String> bestParams;
+                StringList              allowMethods;
+                bool                    pathMatched = false;
+                const Route            *best = findRoute(request, bestParams, &allowMethods, &pathMatched);
 
                 if (best != nullptr) {
                         request.setPathParams(bestParams);
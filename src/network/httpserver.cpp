@@ -13,6 +13,12 @@
 #include <promeki/logger.h>
 #include <promeki/objectbase.tpp>
 #include <promeki/websocket.h>
+#include <promeki/thread.h>
+#include <promeki/threadpool.h>
+#include <promeki/promise.h>
+#include <promeki/atomic.h>
+#include <promeki/uniqueptr.h>
+#include <memory>
 #if PROMEKI_ENABLE_TLS
 #include <promeki/sslsocket.h>
 #endif
@@ -26,6 +32,20 @@ PROMEKI_NAMESPACE_BEGIN
 
 PROMEKI_DEBUG(HttpServer);
 
+// ============================================================
+// Reactor: one listening socket, the EventLoop that accepts on
+// it, and the connections it accepted.  Everything but
+// liveCount is only touched on that loop's thread.
+// ============================================================
+struct HttpServer::Reactor {
+                UniquePtr<Thread>    thread; ///< Null when running on the server's own loop.
+                EventLoop           *loop = nullptr;
+                UniquePtr<TcpServer> tcp;
+                int                  acceptHandle = -1;
+                HttpConnection::List connections;
+                Atomic<int>          liveCount{0};
+};
+
 // ============================================================
 // Reflection-adapter helpers (non-template, called from the
 // template definitions in the header).
@@ -86,7 +106,7 @@ String HttpServer::lookupPathToKey(const String &slashPath) {
         return out;
 }
 
-HttpServer::HttpServer(ObjectBase *parent) : ObjectBase(parent), _tcpServer(UniquePtr<TcpServer>::create(this)) {
+HttpServer::HttpServer(ObjectBase *parent) : ObjectBase(parent) {
         // Capture the owning loop at construction time.  When invoked
         // before any EventLoop has been started on this thread, fall
         // back to the application's main loop so listen() succeeds in
@@ -104,20 +124,72 @@ HttpServer::~HttpServer() {
 // ============================================================
 
 Error HttpServer::listen(const SocketAddress &address, int backlog) {
-        if (_tcpServer->isListening()) {
+        if (_listening) {
                 promekiWarn("HttpServer::listen(%s) called while already listening on %s",
-                            address.toString().cstr(), _tcpServer->serverAddress().toString().cstr());
+                            address.toString().cstr(), _address.toString().cstr());
                 return Error::AlreadyOpen;
         }
 
-        if (_loop == nullptr) _loop = EventLoop::current();
-        if (_loop == nullptr) _loop = Application::mainEventLoop();
-        if (_loop == nullptr) {
-                promekiWarn("HttpServer::listen(%s) called with no EventLoop available", address.toString().cstr());
-                return Error::Invalid;
+        if (_reactorCount == 0) {
+                // Single-loop mode: the one reactor runs on the
+                // owning loop.
+                if (_loop == nullptr) _loop = EventLoop::current();
+                if (_loop == nullptr) _loop = Application::mainEventLoop();
+                if (_loop == nullptr) {
+                        promekiWarn("HttpServer::listen(%s) called with no EventLoop available",
+                                    address.toString().cstr());
+                        return Error::Invalid;
+                }
+                Reactor *r = new Reactor;
+                r->loop = _loop;
+                _reactors.pushToBack(r);
+                Error err = startReactor(r, address, backlog);
+                if (err.isError()) {
+                        close();
+                        return err;
+                }
+        } else {
+                // Reactor threads, each with its own SO_REUSEPORT
+                // listener.  The first bind resolves port 0; the
+                // rest join whatever port it got.
+                SocketAddress bindAddress = address;
+                for (unsigned int i = 0; i < _reactorCount; ++i) {
+                        Reactor *r = new Reactor;
+                        _reactors.pushToBack(r);
+                        r->thread = UniquePtr<Thread>::create();
+                        r->thread->setName(String::sprintf("http-reactor%u", i));
+                        Error err = r->thread->start();
+                        if (err.isOk()) {
+                                r->loop = r->thread->threadEventLoop();
+                                err = runOnReactor(r, [this, r, bindAddress, backlog]() {
+                                        return startReactor(r, bindAddress, backlog);
+                                });
+                        }
+                        if (err.isError()) {
+                                promekiWarn("HttpServer::listen(%s): reactor %u of %u failed to start (%s)",
+                                            address.toString().cstr(), i, _reactorCount, err.name().cstr());
+                                close();
+                                return err;
+                        }
+                        if (i == 0) bindAddress = r->tcp->serverAddress();
+                }
         }
 
-        Error err = _tcpServer->listen(address, backlog);
+        _address = _reactors[0]->tcp->serverAddress();
+        _listening = true;
+        return Error::Ok;
+}
+
+Error HttpServer::listen(uint16_t port, int backlog) {
+        return listen(SocketAddress::any(port), backlog);
+}
+
+Error HttpServer::startReactor(Reactor *r, const SocketAddress &address, int backlog) {
+        // Runs on the reactor's own thread so the listening socket
+        // and every connection it accepts belong to that thread.
+        r->tcp = UniquePtr<TcpServer>::create();
+        r->tcp->setReusePort(r->thread.isValid());
+        Error err = r->tcp->listen(address, backlog);
         if (err.isError()) {
                 promekiWarn("HttpServer::listen: TcpServer::listen(%s, backlog=%d) failed (%s)",
                             address.toString().cstr(), backlog, err.name().cstr());
@@ -129,52 +201,86 @@ Error HttpServer::listen(const SocketAddress &address, int backlog) {
         // We drive nextPendingConnection() in a loop inside
         // onNewConnection() so a thundering herd of simultaneous
         // accepts gets fully drained on a single wake.
-        const int fd = _tcpServer->socketDescriptor();
+        const int fd = r->tcp->socketDescriptor();
         if (fd < 0) return Error::Invalid;
 
         // Drive accept from the loop, so the listening socket needs
         // to be non-blocking — otherwise nextPendingConnection()
         // would stall once the kernel queue is drained.
-        _tcpServer->setNonBlocking(true);
+        r->tcp->setNonBlocking(true);
 
-        _acceptHandle = _loop->addIoSource(fd, EventLoop::IoRead, [this](int, uint32_t) { onNewConnection(); });
-        if (_acceptHandle < 0) {
-                _tcpServer->close();
+        r->acceptHandle = r->loop->addIoSource(fd, EventLoop::IoRead, [this, r](int, uint32_t) { onNewConnection(r); });
+        if (r->acceptHandle < 0) {
+                r->tcp->close();
                 return Error::Invalid;
         }
         return Error::Ok;
 }
 
-Error HttpServer::listen(uint16_t port, int backlog) {
-        return listen(SocketAddress::any(port), backlog);
-}
-
-void HttpServer::close() {
-        if (_loop != nullptr && _acceptHandle >= 0) {
-                _loop->removeIoSource(_acceptHandle);
-                _acceptHandle = -1;
+void HttpServer::stopReactor(Reactor *r) {
+        if (r->loop != nullptr && r->acceptHandle >= 0) {
+                r->loop->removeIoSource(r->acceptHandle);
+                r->acceptHandle = -1;
         }
-        if (_tcpServer->isListening()) _tcpServer->close();
+        r->tcp.clear();
 
         // Closing connections triggers their `closed` signal which
         // we use to reap them — but closing while iterating mutates
         // the list.  Snapshot first, then close each.
-        HttpConnection::List snapshot = _connections;
-        _connections.clear();
+        HttpConnection::List snapshot = r->connections;
+        r->connections.clear();
+        r->liveCount.setValue(0);
         for (size_t i = 0; i < snapshot.size(); ++i) {
                 if (snapshot[i] != nullptr) {
                         snapshot[i]->close();
                         delete snapshot[i];
                 }
         }
+        return;
+}
+
+Error HttpServer::runOnReactor(Reactor *r, Function<Error()> func) {
+        if (!r->thread.isValid()) return func();
+        auto          promise = std::make_shared<Promise<Error>>();
+        Future<Error> future = promise->future();
+        r->loop->postCallable([promise, func]() { promise->setValue(func()); });
+        return future.result().first();
+}
+
+void HttpServer::close() {
+        // Stop accepting and drop every connection first, so no new
+        // request can start offloaded work; then let the work still
+        // running post its results before the reactor loops go away.
+        for (size_t i = 0; i < _reactors.size(); ++i) {
+                Reactor *r = _reactors[i];
+                if (r->thread.isValid() && !r->thread->isRunning()) continue;
+                runOnReactor(r, [this, r]() {
+                        stopReactor(r);
+                        return Error::Ok;
+                });
+        }
+        {
+                Mutex::Locker locker(_offloadMutex);
+                _offloadIdle.wait(_offloadMutex, [this]() { return _offloadsInFlight == 0; });
+        }
+        for (size_t i = 0; i < _reactors.size(); ++i) {
+                Reactor *r = _reactors[i];
+                if (r->thread.isValid()) {
+                        r->thread->quit();
+                        r->thread->wait();
+                }
+                delete r;
+        }
+        _reactors.clear();
+        _listening = false;
 }
 
 bool HttpServer::isListening() const {
-        return _tcpServer->isListening();
+        return _listening;
 }
 
 SocketAddress HttpServer::serverAddress() const {
-        return _tcpServer->serverAddress();
+        return _address;
 }
 
 // ============================================================
@@ -250,21 +356,23 @@ void HttpServer::routeWebSocket(const String &pattern, WebSocketHandler handler)
 }
 
 int HttpServer::connectionCount() const {
-        return static_cast<int>(_connections.size());
+        int count = 0;
+        for (size_t i = 0; i < _reactors.size(); ++i) count += _reactors[i]->liveCount.value();
+        return count;
 }
 
 // ============================================================
 // Accept + dispatch
 // ============================================================
 
-void HttpServer::onNewConnection() {
+void HttpServer::onNewConnection(Reactor *r) {
         // Drain whatever the TcpServer has queued.  In the steady
         // state this loop runs once per signal, but if multiple
         // accepts piled up between wakes we want to take all of
         // them in one pass.  The listening socket is non-blocking
         // (set in listen()) so this terminates on EAGAIN.
         for (;;) {
-                const int fd = _tcpServer->nextPendingDescriptor();
+                const int fd = r->tcp->nextPendingDescriptor();
                 if (fd < 0) break;
 
                 // Wrap the descriptor in either a plain TcpSocket
@@ -294,19 +402,29 @@ void HttpServer::onNewConnection() {
 #endif
                 sock->setSocketDescriptor(fd);
 
-                HttpConnection *conn = new HttpConnection(sock, this);
+                // No parent: the connection lives on the reactor's
+                // thread, which need not be the server's.  The
+                // reactor's list owns it.
+                HttpConnection *conn = new HttpConnection(sock);
                 conn->setIdleTimeoutMs(_idleTimeoutMs);
                 conn->setMaxBodyBytes(_maxBodyBytes);
                 if (needsHandshake) conn->setNeedsServerHandshake();
-                conn->setRequestHandler([this](HttpRequest &req, HttpResponse &res) { dispatchRequest(req, res); });
+                conn->setRequestHandler(
+                        [this, conn](HttpRequest &req, HttpResponse &res) { dispatchRequest(conn, req, res); });
+                conn->setHeadersHandler([this](HttpRequest &req) { _router.prepare(req); });
 
                 // Forward per-connection signals up to the server-
                 // level signal, then reap the connection on close.
-                conn->requestReceivedSignal.connect([this](HttpRequest req) { requestReceivedSignal.emit(req); }, this);
+                // Plain (same-thread) connections: they fire on the
+                // reactor thread, and the server's own signals take
+                // care of reaching slots on other threads.  Every
+                // connection is deleted before the server is.
+                void *ctx = static_cast<void *>(this);
+                conn->requestReceivedSignal.connect([this](HttpRequest req) { requestReceivedSignal.emit(req); }, ctx);
                 conn->responseSentSignal.connect(
-                        [this](HttpRequest req, HttpResponse res) { responseSentSignal.emit(req, res); }, this);
-                conn->errorOccurredSignal.connect([this](Error err) { errorOccurredSignal.emit(err); }, this);
-                conn->closedSignal.connect([this, conn]() { reapClosedConnection(conn); }, this);
+                        [this](HttpRequest req, HttpResponse res) { responseSentSignal.emit(req, res); }, ctx);
+                conn->errorOccurredSignal.connect([this](Error err) { errorOccurredSignal.emit(err); }, ctx);
+                conn->closedSignal.connect([this, r, conn]() { reapClosedConnection(r, conn); }, ctx);
 
                 Error err = conn->start();
                 if (err.isError()) {
@@ -324,27 +442,67 @@ void HttpServer::onNewConnection() {
                 promekiDebug("HttpServer: accepted %s tls=%s",
                              sock->peerAddress().toString().cstr(),
                              needsHandshake ? "yes" : "no");
-                _connections.pushToBack(conn);
+                r->connections.pushToBack(conn);
+                r->liveCount.fetchAndAdd(1);
         }
 }
 
-void HttpServer::dispatchRequest(HttpRequest &request, HttpResponse &response) {
+void HttpServer::dispatchRequest(HttpConnection *conn, HttpRequest &request, HttpResponse &response) {
         _router.dispatch(request, response);
+        if (!response.offloadTask()) return;
+
+        HttpResponse::OffloadTask task = response.offloadTask();
+        response.setOffloadTask(HttpResponse::OffloadTask());
+        if (_workerPool == nullptr) {
+                task(response);
+                return;
+        }
+
+        // Hand the rest to the pool and post the finished response
+        // back to this connection's loop.  The connection may close
+        // (client gone, server shutting down) before that happens;
+        // the tracking pointer turns the post-back into a no-op.
+        conn->deferResponse();
+        {
+                Mutex::Locker locker(_offloadMutex);
+                ++_offloadsInFlight;
+        }
+        EventLoop                    *loop = EventLoop::current();
+        ObjectBasePtr<HttpConnection> guard(conn);
+        _workerPool->post([this, task, response, guard, loop]() mutable {
+                task(response);
+                loop->postCallable([guard, response]() mutable {
+                        HttpConnection *c = guard.data();
+                        if (c == nullptr) {
+                                promekiDebug("HttpServer: offloaded response dropped, connection gone");
+                                return;
+                        }
+                        Error err = c->postResponse(response);
+                        if (err == Error::NotOpen) {
+                                promekiDebug("HttpServer: offloaded response dropped, client disconnected");
+                        } else if (err.isError()) {
+                                promekiWarn("HttpServer: offloaded response for %s could not be delivered: %s",
+                                            c->peerAddress().cstr(), err.name().cstr());
+                        }
+                });
+                finishOffload();
+        });
+}
+
+void HttpServer::finishOffload() {
+        Mutex::Locker locker(_offloadMutex);
+        if (--_offloadsInFlight == 0) _offloadIdle.wakeAll();
+        return;
 }
 
-void HttpServer::reapClosedConnection(HttpConnection *conn) {
-        for (size_t i = 0; i < _connections.size(); ++i) {
-                if (_connections[i] == conn) {
+void HttpServer::reapClosedConnection(Reactor *r, HttpConnection *conn) {
+        for (size_t i = 0; i < r->connections.size(); ++i) {
+                if (r->connections[i] == conn) {
                         // Schedule deletion onto the loop rather than
                         // delete inline — the closed signal we're
                         // responding to was emitted from inside the
-                        // connection's own machinery.  @c deleteLater
-                        // also detaches @p conn from its parent so the
-                        // deferred delete cannot race with
-                        // @c ObjectBase::destroyChildren when
-                        // @c ~HttpServer runs before the callable is
-                        // dispatched.
-                        if (_loop != nullptr) {
+                        // connection's own machinery.
+                        if (r->loop != nullptr) {
                                 conn->deleteLater();
                         } else {
                                 delete conn;
@@ -352,10 +510,11 @@ void HttpServer::reapClosedConnection(HttpConnection *conn) {
                         // O(n) erase — fine for small live counts;
                         // typical real-world HTTP servers see hundreds
                         // not millions of concurrent connections.
-                        for (size_t j = i + 1; j < _connections.size(); ++j) {
-                                _connections[j - 1] = _connections[j];
+                        for (size_t j = i + 1; j < r->connections.size(); ++j) {
+                                r->connections[j - 1] = r->connections[j];
                         }
-                        _connections.popFromBack();
+                        r->connections.popFromBack();
+                        r->liveCount.fetchAndAdd(-1);
                         return;
                 }
         }
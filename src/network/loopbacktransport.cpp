@@ -54,7 +54,7 @@ int LoopbackTransport::sendPackets(const DatagramList &datagrams) {
         for (size_t i = 0; i < datagrams.size(); i++) {
                 const Datagram &d = datagrams[i];
                 if (d.data == nullptr || d.size == 0) return sent > 0 ? sent : -1;
-                _peer->deliver(d.data, d.size, d.dest);
+                _peer->deliver(d);
                 sent++;
         }
         return sent;
@@ -70,6 +70,22 @@ void LoopbackTransport::deliver(const void *data, size_t size, const SocketAddre
         _recvQueue.pushToBack(std::move(e));
 }
 
+void LoopbackTransport::deliver(const Datagram &d) {
+        if (d.segmentCount == 0) {
+                deliver(d.data, d.size, d.dest);
+                return;
+        }
+        const size_t total = d.totalSize();
+        QueueEntry   e;
+        e.data = Buffer(total);
+        e.data.setSize(total);
+        d.copyTo(e.data.data());
+        e.sender = d.dest;
+        Mutex::Locker locker(_queueMutex);
+        _recvQueue.pushToBack(std::move(e));
+        return;
+}
+
 ssize_t LoopbackTransport::receivePacket(void *data, size_t maxSize, SocketAddress *sender) {
         if (!_open) return -1;
         QueueEntry e;
@@ -85,6 +101,26 @@ ssize_t LoopbackTransport::receivePacket(void *data, size_t maxSize, SocketAddre
         return static_cast<ssize_t>(copy);
 }
 
+int LoopbackTransport::receivePackets(RecvDatagramList &packets, bool wantSender) {
+        if (!_open) return -1;
+        if (packets.isEmpty()) return 0;
+        // Drain up to packets.size() entries under one lock acquisition.
+        Mutex::Locker locker(_queueMutex);
+        if (_recvQueue.isEmpty()) return -1;
+        size_t got = 0;
+        while (got < packets.size() && !_recvQueue.isEmpty()) {
+                const QueueEntry &e = _recvQueue.front();
+                RecvDatagram     &p = packets[got];
+                size_t            copy = e.data.size() < p.maxSize ? e.data.size() : p.maxSize;
+                if (copy > 0) std::memcpy(p.data, e.data.data(), copy);
+                p.size = copy;
+                if (wantSender) p.sender = e.sender;
+                _recvQueue.remove(static_cast<size_t>(0));
+                got++;
+        }
+        return static_cast<int>(got);
+}
+
 Error LoopbackTransport::setPacingRate(uint64_t /*bytesPerSec*/) {
         // Accept and ignore — tests can call setPacingRate without
         // special-casing the loopback transport.
@@ -9,6 +9,15 @@
 
 PROMEKI_NAMESPACE_BEGIN
 
+int PacketTransport::receivePackets(RecvDatagramList &packets, bool wantSender) {
+        if (packets.isEmpty()) return 0;
+        RecvDatagram &p = packets[0];
+        ssize_t       n = receivePacket(p.data, p.maxSize, wantSender ? &p.sender : nullptr);
+        if (n < 0) return -1;
+        p.size = static_cast<size_t>(n);
+        return 1;
+}
+
 Error PacketTransport::setPacingRate(uint64_t /*bytesPerSec*/) {
         return Error::NotSupported;
 }
@@ -17,4 +26,8 @@ Error PacketTransport::setTxTime(bool /*enable*/) {
         return Error::NotSupported;
 }
 
+Error PacketTransport::setZeroCopy(bool /*enable*/) {
+        return Error::NotSupported;
+}
+
 PROMEKI_NAMESPACE_END
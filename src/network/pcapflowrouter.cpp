@@ -7,22 +7,41 @@
 
 #include <promeki/pcapflowrouter.h>
 #if PROMEKI_ENABLE_NETWORK
+#include <algorithm>
 #include <utility>
+#include <promeki/basicthread.h>
+#include <promeki/fnv1a.h>
 #include <promeki/pcapreader.h>
+#include <promeki/queue.h>
 #include <promeki/rtppayloadanc.h>
 #include <promeki/sdpsession.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace {
+
+// One demultiplexed datagram on its way to a worker.
+struct ShardItem {
+                UdpDatagram dg;
+                DateTime    captureTime;
+                uint64_t    seq = 0;
+};
+
+using ShardBatch = List<ShardItem>;
+
+} // namespace
+
 Error PcapFlowRouter::setSdp(const SdpSession &sdp) {
         return _map.ingest(sdp);
 }
 
 void PcapFlowRouter::reset() {
         _stats.clear();
+        _statSeq.clear();
         _ancFlows.clear();
         _health.clear();
         _demux.reset();
+        _seq = 0;
 }
 
 Error PcapFlowRouter::processFile(const String &path) {
@@ -39,21 +58,209 @@ Error PcapFlowRouter::processBuffer(const Buffer &buf) {
         return runReader(reader);
 }
 
+size_t PcapFlowRouter::ShardAssigner::operator()(const SocketAddress &dst) {
+        // Key on a hash of the destination.  Two destinations that collide
+        // simply share a worker, which is still correct: all that matters
+        // is that one destination never spans two.
+        const uint16_t port = dst.port();
+        uint64_t key = fnv1aData(&port, sizeof(port));
+        const NetworkAddress &addr = dst.address();
+        if(addr.isIPv4()) {
+                const uint32_t v4 = addr.toIpv4().toUint32();
+                key = fnv1aData(&v4, sizeof(v4), key);
+        } else if(addr.isIPv6()) {
+                const Ipv6Address v6 = addr.toIpv6();
+                key = fnv1aData(v6.raw(), 16, key);
+        }
+        auto [it, inserted] = _map.tryEmplace(key, _next);
+        if(inserted) _next = (_next + 1) % _count;
+        return it->second;
+}
+
 Error PcapFlowRouter::runReader(PcapReader &reader) {
+        size_t count = _threads == 0 ? BasicThread::idealThreadCount() : _threads;
+        if(count < 1) count = 1;
+        ShardAssigner assign(count);
+        ShardList shards = splitShards(assign, count);
+        if(count > 1 && !runSharded(reader, shards, assign)) {
+                // No workers could be started; nothing has been read yet,
+                // so fall back to analysing on this thread.
+                joinShards(shards);
+                ShardAssigner single(1);
+                shards = splitShards(single, 1);
+                count = 1;
+        }
+        if(count == 1) runSerial(reader, *shards[0]);
+        joinShards(shards);
+        return Error::Ok;
+}
+
+void PcapFlowRouter::runSerial(PcapReader &reader, Shard &sh) {
         for(;;) {
                 auto [rec, err] = reader.next();
                 if(err == Error::EndOfFile) break;
                 if(err.isError()) break; // truncated / corrupt tail — stop gracefully
                 const DemuxResult dr = _demux.demux(rec.linkType, rec.frame);
-                if(dr.status == DemuxStatus::Ok) handleDatagram(dr.datagram, rec.captureTime);
+                if(dr.status != DemuxStatus::Ok) continue;
+                sh.seq = _seq++;
+                handleDatagram(sh, dr.datagram, rec.captureTime);
         }
         // Flush any frame whose marker packet never arrived (e.g. a capture
         // that stops mid-frame).
-        for(AncReasm &r : _ancFlows) flushAnc(r);
-        return Error::Ok;
+        flushShard(sh);
+        return;
+}
+
+bool PcapFlowRouter::runSharded(PcapReader &reader, ShardList &shards, ShardAssigner &assign) {
+        const size_t count = shards.size();
+        List<UniquePtr<Queue<ShardBatch>>> queues;
+        for(size_t i = 0; i < count; i++) {
+                UniquePtr<Queue<ShardBatch>> q = UniquePtr<Queue<ShardBatch>>::create();
+                q->setMaxSize(ShardQueueDepth);
+                queues.pushToBack(std::move(q));
+                shards[i]->deferEvents = true;
+        }
+
+        // An empty batch tells a worker the capture is done.
+        List<BasicThread> workers;
+        for(size_t i = 0; i < count; i++) {
+                Shard &sh = *shards[i];
+                Queue<ShardBatch> &q = *queues[i];
+                BasicThread bt;
+                const Error err = bt.start([this, &sh, &q]() {
+                        for(;;) {
+                                auto [batch, perr] = q.pop();
+                                if(perr.isError() || batch.isEmpty()) break;
+                                for(const ShardItem &item : batch) {
+                                        sh.seq = item.seq;
+                                        handleDatagram(sh, item.dg, item.captureTime);
+                                }
+                        }
+                        flushShard(sh);
+                });
+                if(err.isError()) {
+                        for(size_t j = 0; j < workers.size(); j++) queues[j]->push(ShardBatch());
+                        for(BasicThread &w : workers) w.join();
+                        for(UniquePtr<Shard> &s : shards) s->deferEvents = false;
+                        return false;
+                }
+                bt.setName(String("pcapflow") + String::number(i));
+                workers.pushToBack(std::move(bt));
+        }
+
+        List<ShardBatch> pending(count);
+        for(;;) {
+                auto [rec, err] = reader.next();
+                if(err == Error::EndOfFile) break;
+                if(err.isError()) break; // truncated / corrupt tail — stop gracefully
+                DemuxResult dr = _demux.demux(rec.linkType, rec.frame);
+                if(dr.status != DemuxStatus::Ok) continue;
+                const size_t idx = assign(dr.datagram.dst);
+                ShardItem item;
+                item.dg = std::move(dr.datagram);
+                item.captureTime = rec.captureTime;
+                item.seq = _seq++;
+                ShardBatch &batch = pending[idx];
+                batch.pushToBack(std::move(item));
+                if(batch.size() >= ShardBatchSize) {
+                        queues[idx]->pushBlocking(std::move(batch));
+                        batch = ShardBatch();
+                }
+        }
+        for(size_t i = 0; i < count; i++) {
+                if(!pending[i].isEmpty()) queues[i]->pushBlocking(std::move(pending[i]));
+                queues[i]->pushBlocking(ShardBatch());
+        }
+        for(BasicThread &w : workers) w.join();
+        deliverEvents(shards);
+        return true;
+}
+
+PcapFlowRouter::ShardList PcapFlowRouter::splitShards(ShardAssigner &assign, size_t count) {
+        ShardList shards;
+        for(size_t i = 0; i < count; i++) shards.pushToBack(UniquePtr<Shard>::create());
+        // Existing flows are assigned in first-seen order, so the deal
+        // matches what a fresh run over the same capture would produce.
+        for(size_t i = 0; i < _stats.size(); i++) {
+                StatRow row;
+                row.firstSeq = _statSeq[i];
+                row.stat = _stats[i];
+                shards[assign(row.stat.dst)]->stats.pushToBack(std::move(row));
+        }
+        for(AncReasm &r : _ancFlows) shards[assign(r.dst)]->ancFlows.pushToBack(std::move(r));
+        for(UniquePtr<FlowHealth> &h : _health) {
+                const size_t idx = assign(h->dst);
+                shards[idx]->health.pushToBack(std::move(h));
+        }
+        _stats.clear();
+        _statSeq.clear();
+        _ancFlows.clear();
+        _health.clear();
+        return shards;
 }
 
-void PcapFlowRouter::handleDatagram(const UdpDatagram &dg, const DateTime &captureTime) {
+void PcapFlowRouter::joinShards(ShardList &shards) {
+        List<StatRow> rows;
+        for(UniquePtr<Shard> &sh : shards) {
+                for(StatRow &row : sh->stats) rows.pushToBack(std::move(row));
+                for(AncReasm &r : sh->ancFlows) _ancFlows.pushToBack(std::move(r));
+                for(UniquePtr<FlowHealth> &h : sh->health) _health.pushToBack(std::move(h));
+        }
+        std::sort(rows.begin(), rows.end(),
+                  [](const StatRow &a, const StatRow &b) { return a.firstSeq < b.firstSeq; });
+        std::sort(_ancFlows.begin(), _ancFlows.end(),
+                  [](const AncReasm &a, const AncReasm &b) { return a.firstSeq < b.firstSeq; });
+        for(StatRow &row : rows) {
+                _statSeq.pushToBack(row.firstSeq);
+                _stats.pushToBack(std::move(row.stat));
+        }
+        shards.clear();
+        return;
+}
+
+void PcapFlowRouter::deliverEvents(ShardList &shards) {
+        // Each shard's events are already in (seq, order) order; a k-way
+        // merge restores the single-threaded interleaving.  Shard counts
+        // are small, so a linear scan for the minimum is fine.
+        List<size_t> at(shards.size(), 0);
+        for(;;) {
+                size_t best = shards.size();
+                for(size_t i = 0; i < shards.size(); i++) {
+                        if(at[i] >= shards[i]->events.size()) continue;
+                        const PendingEvent &e = shards[i]->events[at[i]];
+                        if(best == shards.size()) {
+                                best = i;
+                                continue;
+                        }
+                        const PendingEvent &b = shards[best]->events[at[best]];
+                        if(e.seq < b.seq || (e.seq == b.seq && e.order < b.order)) best = i;
+                }
+                if(best == shards.size()) break;
+                const PendingEvent &e = shards[best]->events[at[best]++];
+                if(e.isAnc) {
+                        if(_ancCb) _ancCb(e.anc);
+                } else if(_anomalyCb) {
+                        _anomalyCb(e.anomaly);
+                }
+        }
+        for(UniquePtr<Shard> &sh : shards) {
+                sh->events.clear();
+                sh->deferEvents = false;
+        }
+        return;
+}
+
+void PcapFlowRouter::flushShard(Shard &sh) {
+        for(AncReasm &r : sh.ancFlows) {
+                sh.seq = FlushSeq;
+                sh.order = r.firstSeq;
+                flushAnc(sh, r);
+        }
+        sh.order = 0;
+        return;
+}
+
+void PcapFlowRouter::handleDatagram(Shard &sh, const UdpDatagram &dg, const DateTime &captureTime) {
         const BufferView &pl = dg.payload;
         if(pl.count() != 1 || pl.size() < RtpPacket::HeaderSize) return;
         const RtpPacket pkt(pl[0].buffer(), pl[0].offset(), pl.size());
@@ -65,30 +272,30 @@ void PcapFlowRouter::handleDatagram(const UdpDatagram &dg, const DateTime &captu
         const PcapFlow *flow = _map.find(dg.dst);
         const PcapFlowKind kind = flow != nullptr ? flow->kind : PcapFlowKind::Unknown;
 
-        FlowStat &st = statFor(dg.dst, ssrc, pt, kind);
+        FlowStat &st = statFor(sh, dg.dst, ssrc, pt, kind);
         st.packets++;
         st.bytes += pl.size();
 
         // RFC 3550 health tracking for every RTP flow, labelled or not — runs
         // before the ANC payload-type gate so the flow table sees loss /
         // duplicate / reorder / jitter / SSRC-change signals on all flows.
-        trackRtpHealth(dg.dst, kind, pkt, st, captureTime);
+        trackRtpHealth(sh, dg.dst, kind, pkt, st, captureTime);
 
         if(flow != nullptr && flow->kind == PcapFlowKind::Anc) {
                 if(flow->hasPayloadType && pt != flow->payloadType) return; // not this flow's PT
-                routeAnc(dg, *flow, pkt, captureTime);
+                routeAnc(sh, dg, *flow, pkt, captureTime);
         }
         // Video / audio decode is a later phase; the seam is here.
 }
 
-void PcapFlowRouter::routeAnc(const UdpDatagram &dg, const PcapFlow &flow, const RtpPacket &pkt,
+void PcapFlowRouter::routeAnc(Shard &sh, const UdpDatagram &dg, const PcapFlow &flow, const RtpPacket &pkt,
                               const DateTime &captureTime) {
-        AncReasm &r = ancReasmFor(dg, flow);
+        AncReasm &r = ancReasmFor(sh, dg, flow);
         const uint32_t ssrc = pkt.ssrc();
         const uint32_t ts = pkt.timestamp();
 
-        if(r.haveSsrc && r.ssrc != ssrc) flushAnc(r);                          // source changed
-        if(r.haveTs && !r.packets.isEmpty() && r.timestamp != ts) flushAnc(r); // new frame (timestamp moved)
+        if(r.haveSsrc && r.ssrc != ssrc) flushAnc(sh, r);                          // source changed
+        if(r.haveTs && !r.packets.isEmpty() && r.timestamp != ts) flushAnc(sh, r); // new frame (timestamp moved)
 
         r.dst = dg.dst;
         r.src = dg.src;
@@ -101,10 +308,10 @@ void PcapFlowRouter::routeAnc(const UdpDatagram &dg, const PcapFlow &flow, const
         r.packets.pushToBack(pkt);
         r.captureTime = captureTime;
 
-        if(pkt.marker()) flushAnc(r);
+        if(pkt.marker()) flushAnc(sh, r);
 }
 
-void PcapFlowRouter::flushAnc(AncReasm &r) {
+void PcapFlowRouter::flushAnc(Shard &sh, AncReasm &r) {
         if(r.packets.isEmpty()) {
                 r.haveTs = false;
                 return;
@@ -125,52 +332,70 @@ void PcapFlowRouter::flushAnc(AncReasm &r) {
         f.anc.rtpTimestamp = r.timestamp;
         f.anc.packetCount = static_cast<int32_t>(r.packets.size());
         f.anc.keepAlive = out.isEmpty();
-        if(_ancCb) _ancCb(f);
+        emitAncFrame(sh, std::move(f));
 
         r.packets.clear();
         r.haveTs = false;
 }
 
-PcapFlowRouter::FlowStat &PcapFlowRouter::statFor(const SocketAddress &dst, uint32_t ssrc, uint8_t pt,
+PcapFlowRouter::FlowStat &PcapFlowRouter::statFor(Shard &sh, const SocketAddress &dst, uint32_t ssrc, uint8_t pt,
                                                   PcapFlowKind kind) {
-        for(FlowStat &s : _stats) {
+        for(StatRow &row : sh.stats) {
+                FlowStat &s = row.stat;
                 if(s.ssrc == ssrc && s.payloadType == pt && s.dst.port() == dst.port() &&
                    s.dst.address() == dst.address()) {
                         return s;
                 }
         }
-        FlowStat ns;
-        ns.dst = dst;
-        ns.ssrc = ssrc;
-        ns.payloadType = pt;
-        ns.kind = kind;
-        _stats.pushToBack(ns);
-        return _stats.back();
+        StatRow row;
+        row.firstSeq = sh.seq;
+        row.stat.dst = dst;
+        row.stat.ssrc = ssrc;
+        row.stat.payloadType = pt;
+        row.stat.kind = kind;
+        sh.stats.pushToBack(row);
+        return sh.stats.back().stat;
 }
 
-PcapFlowRouter::AncReasm &PcapFlowRouter::ancReasmFor(const UdpDatagram &dg, const PcapFlow &flow) {
-        for(AncReasm &r : _ancFlows) {
+PcapFlowRouter::AncReasm &PcapFlowRouter::ancReasmFor(Shard &sh, const UdpDatagram &dg, const PcapFlow &flow) {
+        for(AncReasm &r : sh.ancFlows) {
                 if(r.dst.port() == dg.dst.port() && r.dst.address() == dg.dst.address()) return r;
         }
         AncReasm nr;
+        nr.firstSeq = sh.seq;
         nr.dst = dg.dst;
         nr.payloadType = flow.hasPayloadType ? flow.payloadType : 0;
         nr.desc = flow.anc;
-        _ancFlows.pushToBack(nr);
-        return _ancFlows.back();
+        sh.ancFlows.pushToBack(nr);
+        return sh.ancFlows.back();
 }
 
-PcapFlowRouter::FlowHealth &PcapFlowRouter::healthFor(const SocketAddress &dst) {
-        for(UniquePtr<FlowHealth> &h : _health) {
+PcapFlowRouter::FlowHealth &PcapFlowRouter::healthFor(Shard &sh, const SocketAddress &dst) {
+        for(UniquePtr<FlowHealth> &h : sh.health) {
                 if(h->dst.port() == dst.port() && h->dst.address() == dst.address()) return *h;
         }
         UniquePtr<FlowHealth> nh = UniquePtr<FlowHealth>::create();
         nh->dst = dst;
-        _health.pushToBack(std::move(nh));
-        return *_health.back();
+        sh.health.pushToBack(std::move(nh));
+        return *sh.health.back();
 }
 
-void PcapFlowRouter::emitAnomaly(RtpAnomaly::Kind kind, PcapFlowKind flowKind, const SocketAddress &dst,
+void PcapFlowRouter::emitAncFrame(Shard &sh, RoutedAncFrame &&f) {
+        if(!_ancCb) return;
+        if(!sh.deferEvents) {
+                _ancCb(f);
+                return;
+        }
+        PendingEvent e;
+        e.seq = sh.seq;
+        e.order = sh.order;
+        e.isAnc = true;
+        e.anc = std::move(f);
+        sh.events.pushToBack(std::move(e));
+        return;
+}
+
+void PcapFlowRouter::emitAnomaly(Shard &sh, RtpAnomaly::Kind kind, PcapFlowKind flowKind, const SocketAddress &dst,
                                  uint32_t ssrc, uint32_t previous, uint32_t count, const DateTime &captureTime,
                                  const Duration &jitter) {
         if(!_anomalyCb) return;
@@ -183,12 +408,20 @@ void PcapFlowRouter::emitAnomaly(RtpAnomaly::Kind kind, PcapFlowKind flowKind, c
         a.count       = count;
         a.jitter      = jitter;
         a.captureTime = captureTime;
-        _anomalyCb(a);
+        if(!sh.deferEvents) {
+                _anomalyCb(a);
+                return;
+        }
+        PendingEvent e;
+        e.seq = sh.seq;
+        e.order = sh.order;
+        e.anomaly = a;
+        sh.events.pushToBack(std::move(e));
 }
 
-void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind, const RtpPacket &pkt,
+void PcapFlowRouter::trackRtpHealth(Shard &sh, const SocketAddress &dst, PcapFlowKind kind, const RtpPacket &pkt,
                                     FlowStat &st, const DateTime &captureTime) {
-        FlowHealth    &h    = healthFor(dst);
+        FlowHealth    &h    = healthFor(sh, dst);
         const uint32_t ssrc = pkt.ssrc();
         const uint8_t  pt   = pkt.payloadType();
         const uint16_t seq  = pkt.sequenceNumber();
@@ -199,7 +432,7 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
         // priors.  The seq discontinuity across the boundary is the SSRC
         // change, not loss, so it must not feed the gap detector below.
         if(h.haveSsrc && h.ssrc != ssrc) {
-                emitAnomaly(RtpAnomaly::Kind::SsrcChange, kind, dst, ssrc, h.ssrc, 0, captureTime);
+                emitAnomaly(sh, RtpAnomaly::Kind::SsrcChange, kind, dst, ssrc, h.ssrc, 0, captureTime);
                 h.tracker.reset();
                 h.havePt              = false;
                 h.haveTs              = false;
@@ -215,7 +448,7 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
 
         // Payload-type change on this SSRC.
         if(h.havePt && h.payloadType != pt) {
-                emitAnomaly(RtpAnomaly::Kind::PayloadTypeChange, kind, dst, ssrc, h.payloadType, 0, captureTime);
+                emitAnomaly(sh, RtpAnomaly::Kind::PayloadTypeChange, kind, dst, ssrc, h.payloadType, 0, captureTime);
         }
         h.payloadType = pt;
         h.havePt      = true;
@@ -225,7 +458,7 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
         if(h.haveTs) {
                 const uint32_t fwd = ts - h.lastTimestamp;
                 if(fwd != 0u && fwd > 0x80000000u) {
-                        emitAnomaly(RtpAnomaly::Kind::TimestampRegression, kind, dst, ssrc, h.lastTimestamp, 0,
+                        emitAnomaly(sh, RtpAnomaly::Kind::TimestampRegression, kind, dst, ssrc, h.lastTimestamp, 0,
                                     captureTime);
                         h.timestampRegressions++;
                 }
@@ -241,7 +474,7 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
         const RtpSeqTracker::ObserveResult r =
                 h.tracker.observe(seq, ts, TimeStamp(captureTime.nanoseconds()));
         if(r.duplicate) {
-                emitAnomaly(RtpAnomaly::Kind::Duplicate, kind, dst, ssrc, 0, 0, captureTime);
+                emitAnomaly(sh, RtpAnomaly::Kind::Duplicate, kind, dst, ssrc, 0, 0, captureTime);
         } else if(h.haveSeq) {
                 const uint32_t expected = h.lastExtendedSeq + 1u;
                 if(r.extendedSeq > expected) {
@@ -251,10 +484,10 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
                         // huge loss burst.
                         const uint32_t gap = r.extendedSeq - expected;
                         if(gap < RtpSeqTracker::MaxDropout) {
-                                emitAnomaly(RtpAnomaly::Kind::PacketLoss, kind, dst, ssrc, 0, gap, captureTime);
+                                emitAnomaly(sh, RtpAnomaly::Kind::PacketLoss, kind, dst, ssrc, 0, gap, captureTime);
                         }
                 } else if(r.extendedSeq < expected) {
-                        emitAnomaly(RtpAnomaly::Kind::Reorder, kind, dst, ssrc, 0, 0, captureTime);
+                        emitAnomaly(sh, RtpAnomaly::Kind::Reorder, kind, dst, ssrc, 0, 0, captureTime);
                 }
         }
         if(!r.duplicate && (!h.haveSeq || r.extendedSeq > h.lastExtendedSeq)) {
@@ -286,7 +519,7 @@ void PcapFlowRouter::trackRtpHealth(const SocketAddress &dst, PcapFlowKind kind,
                         if(_jitterWarn.isValid() && _jitterWarn.nanoseconds() > 0) {
                                 if(!h.jitterOver && jitter.nanoseconds() > _jitterWarn.nanoseconds()) {
                                         h.jitterOver = true;
-                                        emitAnomaly(RtpAnomaly::Kind::JitterExceeded, kind, dst, ssrc, 0, 0,
+                                        emitAnomaly(sh, RtpAnomaly::Kind::JitterExceeded, kind, dst, ssrc, 0, 0,
                                                     captureTime, jitter);
                                 } else if(h.jitterOver && jitter.nanoseconds() <= _jitterWarn.nanoseconds()) {
                                         h.jitterOver = false;
@@ -10,7 +10,14 @@
 #include <chrono>
 #include <cmath>
 #include <promeki/file.h>
+#include <promeki/hostbufferimpl.h>
 #include <promeki/iodevice.h>
+#include <promeki/platform.h>
+
+#if defined(PROMEKI_PLATFORM_POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -67,6 +74,52 @@ DateTime unixNanosToDateTime(int64_t ns) {
         return DateTime(SC::time_point(dur));
 }
 
+#if defined(PROMEKI_PLATFORM_POSIX)
+
+size_t systemPageSize() {
+        static const size_t pageSize = [] {
+                const long pg = ::sysconf(_SC_PAGESIZE);
+                return pg > 0 ? static_cast<size_t>(pg) : static_cast<size_t>(4096);
+        }();
+        return pageSize;
+}
+
+// Owns a read-only MAP_SHARED mapping of a whole capture file.  Frames
+// handed out by the reader hold the Buffer that wraps this, so the
+// mapping lives until the last of them (or the reader) lets go.  Not
+// copyable and not cloneable: a copy would unmap twice, and the pages
+// are read-only so there is nothing to detach for.
+class MappedCaptureBufferImpl : public HostMappedBufferImpl {
+        public:
+                PROMEKI_SHARED_DERIVED(MappedCaptureBufferImpl)
+
+                MappedCaptureBufferImpl(void *ptr, size_t bytes)
+                    : HostMappedBufferImpl(MemSpace(MemSpace::Default), ptr, bytes, systemPageSize()) {}
+                MappedCaptureBufferImpl(const MappedCaptureBufferImpl &) = delete;
+                MappedCaptureBufferImpl &operator=(const MappedCaptureBufferImpl &) = delete;
+
+                ~MappedCaptureBufferImpl() override { ::munmap(_hostPtr, _allocSize); }
+
+                bool canClone() const override { return false; }
+
+                // The mapping is PROT_READ; writing through it would fault.
+                Error fill(char value, size_t offset, size_t bytes) override {
+                        (void)value;
+                        (void)offset;
+                        (void)bytes;
+                        return Error::ReadOnly;
+                }
+
+                Error copyFromHost(const void *src, size_t bytes, size_t offset) override {
+                        (void)src;
+                        (void)bytes;
+                        (void)offset;
+                        return Error::ReadOnly;
+                }
+};
+
+#endif // PROMEKI_PLATFORM_POSIX
+
 } // namespace
 
 Error PcapReader::open(IODevice &device) {
@@ -99,6 +152,8 @@ Error PcapReader::open(IODevice &device) {
 }
 
 Error PcapReader::openFile(const String &path) {
+        const Error merr = openMapped(path);
+        if(merr != Error::NotSupported) return merr;
         File file(path);
         const Error err = file.open(IODevice::ReadOnly);
         if(err.isError()) return Error::OpenFailed;
@@ -107,6 +162,38 @@ Error PcapReader::openFile(const String &path) {
         return rerr;
 }
 
+Error PcapReader::openMapped(const String &path) {
+        close();
+#if defined(PROMEKI_PLATFORM_POSIX)
+        File file(path);
+        if(file.open(IODevice::ReadOnly).isError()) return Error::OpenFailed;
+        if(file.isResource()) return Error::NotSupported;
+        auto [total, sizeErr] = file.size();
+        if(sizeErr.isError() || total <= 0) return Error::NotSupported;
+        const size_t bytes = static_cast<size_t>(total);
+        void *p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, file.handle(), 0);
+        const Error mapErr = p == MAP_FAILED ? Error::syserr() : Error(Error::Ok);
+        // The mapping holds its own reference to the file.
+        file.close();
+        if(mapErr.isError()) return mapErr;
+        // Records are consumed front to back: let the kernel read ahead
+        // aggressively and reclaim pages behind the cursor early.
+        ::madvise(p, bytes, MADV_SEQUENTIAL);
+        Buffer buf = Buffer::fromImpl(new MappedCaptureBufferImpl(p, bytes));
+        buf.setSize(bytes);
+        _backing = buf;
+        _size = bytes;
+        _pos = 0;
+        _mapped = true;
+        const Error err = parseHeader();
+        if(err.isError()) close();
+        return err;
+#else
+        (void)path;
+        return Error::NotSupported;
+#endif
+}
+
 Error PcapReader::openBuffer(const Buffer &buf) {
         close();
         _backing = buf;
@@ -126,6 +213,12 @@ void PcapReader::close() {
         _snaplen = 0;
         _classicLink = PcapLinkType::Ethernet;
         _interfaces.clear();
+        _mapped = false;
+        _released = 0;
+        _record = 0;
+        _section = 0;
+        _index.clear();
+        _sections.clear();
 }
 
 Error PcapReader::parseHeader() {
@@ -242,9 +335,88 @@ uint32_t PcapReader::snapLength() const {
 }
 
 Result<PcapRecord> PcapReader::next() {
-        if(_format == PcapFileFormat::ClassicPcap) return nextClassic();
-        if(_format == PcapFileFormat::Pcapng) return nextPcapng();
-        return makeError<PcapRecord>(Error::NotOpen);
+        if(_format == PcapFileFormat::Unknown) return makeError<PcapRecord>(Error::NotOpen);
+        Result<PcapRecord> ret = _format == PcapFileFormat::ClassicPcap ? nextClassic() : nextPcapng();
+        if(_mapped && _pos > _released + 2 * ReleaseWindow) releaseBehind();
+        return ret;
+}
+
+Error PcapReader::seekRecord(uint64_t index) {
+        if(!isOpen()) return Error::NotOpen;
+        if(!_index.isEmpty()) {
+                // Continue from the current position when it already sits
+                // between the best checkpoint and the target; otherwise
+                // restart from that checkpoint.
+                size_t cp = static_cast<size_t>(index / IndexStride);
+                if(cp >= _index.size()) cp = _index.size() - 1;
+                const uint64_t cpRecord = static_cast<uint64_t>(cp) * IndexStride;
+                if(_record > index || _record < cpRecord) restoreCheckpoint(cp);
+        }
+        while(_record < index) {
+                auto [rec, err] = next();
+                if(err.isError()) return err;
+        }
+        return Error::Ok;
+}
+
+void PcapReader::noteRecord(size_t offset) {
+        // Checkpoints are only appended at the parsed frontier; re-reading
+        // an indexed stretch after a seek leaves the index untouched.
+        if(_record % IndexStride == 0 && _record / IndexStride == _index.size()) {
+                Checkpoint cp;
+                cp.offset = offset;
+                cp.section = _section;
+                cp.interfaceCount = static_cast<uint32_t>(_interfaces.size());
+                if(_format == PcapFileFormat::Pcapng) {
+                        while(_sections.size() <= _section) {
+                                Section sec;
+                                sec.bigEndian = _be;
+                                _sections.pushToBack(sec);
+                        }
+                        // Interfaces only accumulate within a section, so
+                        // the longest table seen is a superset of every
+                        // earlier checkpoint's prefix.
+                        Section &sec = _sections[_section];
+                        if(sec.interfaces.size() < _interfaces.size()) sec.interfaces = _interfaces;
+                }
+                _index.pushToBack(cp);
+        }
+        _record++;
+        return;
+}
+
+void PcapReader::restoreCheckpoint(size_t cp) {
+        const Checkpoint &c = _index[cp];
+        _pos = static_cast<size_t>(c.offset);
+        _record = static_cast<uint64_t>(cp) * IndexStride;
+        if(_format == PcapFileFormat::Pcapng) {
+                const Section &sec = _sections[c.section];
+                _section = c.section;
+                _be = sec.bigEndian;
+                _byteOrder = _be ? PcapByteOrder::BigEndian : PcapByteOrder::LittleEndian;
+                _interfaces.clear();
+                for(uint32_t i = 0; i < c.interfaceCount; i++) _interfaces.pushToBack(sec.interfaces[i]);
+        }
+        if(_released > _pos) _released = _pos;
+        return;
+}
+
+void PcapReader::releaseBehind() {
+#if defined(PROMEKI_PLATFORM_POSIX)
+        // Drop the pages between the last release point and one window
+        // behind the cursor.  The mapping is read-only and file-backed,
+        // so MADV_DONTNEED only unmaps them from this process; a later
+        // touch (an old frame, a backward seek) faults them back in.
+        const size_t page = systemPageSize();
+        const size_t from = _released & ~(page - 1);
+        const size_t to = (_pos - ReleaseWindow) & ~(page - 1);
+        if(to > from) {
+                uint8_t *base = static_cast<uint8_t *>(_backing.data());
+                ::madvise(base + from, to - from, MADV_DONTNEED);
+        }
+        _released = to;
+#endif
+        return;
 }
 
 Result<PcapRecord> PcapReader::nextClassic() {
@@ -260,6 +432,7 @@ Result<PcapRecord> PcapReader::nextClassic() {
         const int64_t ns =
                 static_cast<int64_t>(tsSec) * 1000000000LL + (_nanoTs ? static_cast<int64_t>(tsFrac)
                                                                        : static_cast<int64_t>(tsFrac) * 1000LL);
+        noteRecord(_pos);
         PcapRecord rec;
         rec.captureTime = unixNanosToDateTime(ns);
         rec.linkType = _classicLink;
@@ -275,7 +448,24 @@ Result<PcapRecord> PcapReader::nextPcapng() {
         for(;;) {
                 if(_pos >= _size) return makeError<PcapRecord>(Error::EndOfFile);
                 if(_pos + 8 > _size) return makeError<PcapRecord>(Error::TruncatedData);
+                // The SHB type is a byte-order palindrome, so it reads the
+                // same in either order.
                 const uint32_t btype = rd32(base + _pos, _be);
+                if(btype == PngBlockShb) {
+                        // New section: re-establish byte order before reading
+                        // the block length, which is already in the new
+                        // section's order.  (A section may use the opposite
+                        // endianness from the previous one.)
+                        if(_pos + 12 > _size) return makeError<PcapRecord>(Error::TruncatedData);
+                        if(rd32(base + _pos + 8, false) == PngByteOrderMagic) {
+                                _be = false;
+                        } else if(rd32(base + _pos + 8, true) == PngByteOrderMagic) {
+                                _be = true;
+                        } else {
+                                return makeError<PcapRecord>(Error::CorruptData);
+                        }
+                        _byteOrder = _be ? PcapByteOrder::BigEndian : PcapByteOrder::LittleEndian;
+                }
                 const uint32_t blen = rd32(base + _pos + 4, _be);
                 if(blen < 12 || (blen & 3u) != 0) return makeError<PcapRecord>(Error::CorruptData);
                 if(_pos + blen > _size) return makeError<PcapRecord>(Error::TruncatedData);
@@ -283,19 +473,8 @@ Result<PcapRecord> PcapReader::nextPcapng() {
                 const size_t bodyLen = blen - 12; // excludes 8-byte header + 4-byte trailing length
 
                 if(btype == PngBlockShb) {
-                        // New section: re-establish byte order and reset the
-                        // interface table.  (A section may use the opposite
-                        // endianness from the previous one.)
-                        if(bodyLen >= 4) {
-                                if(rd32(base + bodyOff, false) == PngByteOrderMagic) {
-                                        _be = false;
-                                } else if(rd32(base + bodyOff, true) == PngByteOrderMagic) {
-                                        _be = true;
-                                } else {
-                                        return makeError<PcapRecord>(Error::CorruptData);
-                                }
-                                _byteOrder = _be ? PcapByteOrder::BigEndian : PcapByteOrder::LittleEndian;
-                        }
+                        // Reset the interface table for the new section.
+                        if(_pos != 0) _section++;
                         _interfaces.clear();
                 } else if(btype == PngBlockIdb) {
                         const Error e = consumePcapngIdb(bodyOff, bodyLen);
@@ -313,6 +492,7 @@ Result<PcapRecord> PcapReader::nextPcapng() {
                         }
                         if(ifid >= _interfaces.size()) return makeError<PcapRecord>(Error::CorruptData);
                         const Interface &itf = _interfaces[ifid];
+                        noteRecord(_pos);
                         PcapRecord rec;
                         rec.captureTime = unixNanosToDateTime(pcapngTicksToNanos(rd64hl(tsHi, tsLo), itf.tsResolCode));
                         rec.linkType = itf.linkType;
@@ -331,6 +511,7 @@ Result<PcapRecord> PcapReader::nextPcapng() {
                         size_t cap = orig;
                         if(itf.snapLength != 0 && cap > itf.snapLength) cap = itf.snapLength;
                         if(cap > bodyLen - 4) cap = bodyLen - 4;
+                        noteRecord(_pos);
                         PcapRecord rec;
                         rec.captureTime = DateTime(); // SPB carries no timestamp
                         rec.linkType = itf.linkType;
@@ -0,0 +1,86 @@
+/**
+ * @file      rtppacketslabpool.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#include <promeki/rtppacketslabpool.h>
+#include <promeki/logger.h>
+
+PROMEKI_NAMESPACE_BEGIN
+
+RtpPacketSlabPool::RtpPacketSlabPool(size_t packetsPerSlab, size_t packetStride, size_t maxSlabs)
+    : _packetsPerSlab(packetsPerSlab), _packetStride(packetStride), _maxSlabs(maxSlabs) {
+        _slabs.reserve(maxSlabs);
+}
+
+Buffer RtpPacketSlabPool::allocateSlab() const {
+        // Same 16-byte alignment rationale as RtpPacket::createList —
+        // wire-format bytes never need page alignment.
+        Buffer slab(slabBytes(), /*align=*/16);
+        if (slab.isValid()) slab.setSize(slabBytes());
+        return slab;
+}
+
+Buffer RtpPacketSlabPool::acquire() {
+        // Round-robin from where the last acquire left off.  Slabs are
+        // released in roughly the order they were filled, so the slab
+        // after the cursor is the one most likely to be free and the
+        // scan is usually a single step.
+        const size_t n = _slabs.size();
+        for (size_t i = 0; i < n; ++i) {
+                const size_t idx = (_cursor + i) % n;
+                if (_slabs[idx].isExclusive()) {
+                        _cursor = (idx + 1) % n;
+                        _stats.reused++;
+                        return _slabs[idx];
+                }
+        }
+
+        Buffer slab = allocateSlab();
+        if (!slab.isValid()) {
+                promekiWarnThrottled(1000, "RtpPacketSlabPool: failed to allocate %zu byte slab", slabBytes());
+                return slab;
+        }
+        if (n >= _maxSlabs) {
+                promekiWarnThrottled(5000,
+                                     "RtpPacketSlabPool: all %zu slabs still referenced downstream — "
+                                     "handing out an unpooled slab",
+                                     n);
+                _stats.overflow++;
+                return slab;
+        }
+        _slabs.pushToBack(slab);
+        _cursor = 0;
+        _stats.allocated++;
+        return slab;
+}
+
+Buffer RtpPacketSlabPool::fillSlab(size_t &firstSlot) {
+        if (!_fill.isValid() || _fillUsed >= _packetsPerSlab) {
+                // Let go of the full slab before scanning so it is
+                // free again as soon as its packets are.
+                _fill = Buffer();
+                _fill = acquire();
+                _fillUsed = 0;
+        }
+        firstSlot = _fillUsed;
+        return _fill;
+}
+
+void RtpPacketSlabPool::commitSlots(size_t count) {
+        _fillUsed += count;
+        if (_fillUsed > _packetsPerSlab) _fillUsed = _packetsPerSlab;
+        return;
+}
+
+void RtpPacketSlabPool::clear() {
+        _fill = Buffer();
+        _fillUsed = 0;
+        _slabs.clear();
+        _cursor = 0;
+        return;
+}
+
+PROMEKI_NAMESPACE_END
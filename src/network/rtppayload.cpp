@@ -163,6 +163,12 @@ static constexpr size_t Rfc2435HeaderSize = 8;
 //   MBZ (1 byte) + Precision (1 byte) + Length (2 bytes) + table data
 static constexpr size_t Rfc2435QtHeaderSize = 4;
 
+// RFC 2435 Restart Marker Header: 4 bytes, present in every packet of a
+// type 64-127 frame (a type 0-63 JPEG whose scan carries RSTn markers).
+//   Restart Interval (2 bytes) + F (1 bit) + L (1 bit) + Restart Count (14 bits)
+static constexpr size_t  Rfc2435RestartHeaderSize = 4;
+static constexpr uint8_t Rfc2435RestartTypeBase = 64;
+
 // JPEG marker codes
 static constexpr uint8_t JpegMarkerPrefix = 0xFF;
 static constexpr uint8_t JpegSOI = 0xD8;
@@ -171,6 +177,7 @@ static constexpr uint8_t JpegDQT = 0xDB;
 static constexpr uint8_t JpegSOF0 = 0xC0;
 static constexpr uint8_t JpegDHT = 0xC4;
 static constexpr uint8_t JpegSOS = 0xDA;
+static constexpr uint8_t JpegDRI = 0xDD;
 
 // Scan a JPEG byte stream for the next marker, returning its position.
 // Returns size (past end) if no marker found.
@@ -234,6 +241,15 @@ static bool jpegIs420(const uint8_t *data, size_t size) {
         return ySamp == 0x22;
 }
 
+// Restart interval from the DRI segment ahead of the scan, or 0 when the
+// JPEG has none.  Only the header bytes before @p headerEnd (the start of
+// the entropy-coded data) are searched.
+static uint16_t jpegRestartInterval(const uint8_t *data, size_t headerEnd) {
+        size_t pos = findJpegMarker(data, headerEnd, JpegDRI);
+        if (pos + 6 > headerEnd) return 0;
+        return (static_cast<uint16_t>(data[pos + 4]) << 8) | data[pos + 5];
+}
+
 // Find the byte offset of the entropy-coded data (immediately after the SOS
 // marker's header).  This is the data that RFC 2435 transmits.
 static size_t findEntropyCoded(const uint8_t *data, size_t size) {
@@ -299,6 +315,13 @@ RtpPacket::List RtpPayloadJpeg::pack(const void *mediaData, size_t size) {
                 ecsSize -= 2;
         }
 
+        // A scan with restart markers (a striped JpegVideoEncoder frame, or
+        // any encoder that writes DRI) goes out as type 64-127 so the
+        // receiver knows to rebuild the DRI segment.  The RSTn markers
+        // themselves ride in the entropy-coded data unchanged.
+        const uint16_t restartInterval = jpegRestartInterval(jpeg, ecsStart);
+        const size_t   rstHdrSize = restartInterval != 0 ? Rfc2435RestartHeaderSize : 0;
+
         // Extract quantization tables for the Q-table header (Q >= 128).
         // We always use Q=255 with explicit tables so the receiver doesn't
         // need to guess or compute tables — maximum compatibility.
@@ -309,15 +332,16 @@ RtpPacket::List RtpPayloadJpeg::pack(const void *mediaData, size_t size) {
         size_t qtHdrSize = Rfc2435QtHeaderSize + dqtLen;
 
         const size_t maxPayload = maxPayloadSize();
-        if (maxPayload <= Rfc2435HeaderSize + qtHdrSize) {
+        const size_t jpegHdrSize = Rfc2435HeaderSize + rstHdrSize;
+        if (maxPayload <= jpegHdrSize + qtHdrSize) {
                 promekiWarnOnce("RtpPayloadJpeg::pack maxPayload=%zu < RFC2435 header+QT=%zu — MTU too small",
-                                maxPayload, Rfc2435HeaderSize + qtHdrSize);
+                                maxPayload, jpegHdrSize + qtHdrSize);
                 return packets;
         }
 
         // Max JPEG data per packet (first packet has less room due to QT header)
-        const size_t maxJpegFirst = maxPayload - Rfc2435HeaderSize - qtHdrSize;
-        const size_t maxJpegRest = maxPayload - Rfc2435HeaderSize;
+        const size_t maxJpegFirst = maxPayload - jpegHdrSize - qtHdrSize;
+        const size_t maxJpegRest = maxPayload - jpegHdrSize;
 
         // Count packets
         size_t numPackets = 1;
@@ -365,12 +389,24 @@ RtpPacket::List RtpPayloadJpeg::pack(const void *mediaData, size_t size) {
                 // chooses subsampling per-frame from its input pixel
                 // format, which the RTP layer does not see).
                 pkt[hdr + 4] = jpegIs420(jpeg, size) ? 1 : 0;
+                if (rstHdrSize != 0) pkt[hdr + 4] += Rfc2435RestartTypeBase;
                 pkt[hdr + 5] = 255; // Q=255: quantization tables in first packet
                 pkt[hdr + 6] = w8;
                 pkt[hdr + 7] = h8;
 
                 size_t dataOff = hdr + Rfc2435HeaderSize;
 
+                // Restart Marker Header.  Fragments are cut by size, not on
+                // restart boundaries, so F = L = 1 and the count is 0x3FFF
+                // (RFC 2435 §3.1.7: the packet may hold partial intervals).
+                if (rstHdrSize != 0) {
+                        pkt[dataOff + 0] = static_cast<uint8_t>((restartInterval >> 8) & 0xFF);
+                        pkt[dataOff + 1] = static_cast<uint8_t>(restartInterval & 0xFF);
+                        pkt[dataOff + 2] = 0xFF;
+                        pkt[dataOff + 3] = 0xFF;
+                        dataOff += rstHdrSize;
+                }
+
                 // First packet: insert Quantization Table Header
                 if (isFirst) {
                         pkt[dataOff + 0] = 0; // MBZ
@@ -512,6 +548,10 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         }
         const uint8_t *firstPl = firstPkt.payload();
         const uint8_t  rtpType = firstPl[4];
+        // Types 64-127 are types 0-63 with a Restart Marker Header
+        // after the main header in every packet.
+        const bool     hasRestart = rtpType >= Rfc2435RestartTypeBase && rtpType < 128;
+        const size_t   jpegHdrSize = Rfc2435HeaderSize + (hasRestart ? Rfc2435RestartHeaderSize : 0);
         const uint8_t  rtpQ = firstPl[5];
         const uint32_t width = static_cast<uint32_t>(firstPl[6]) * 8;
         const uint32_t height = static_cast<uint32_t>(firstPl[7]) * 8;
@@ -523,6 +563,18 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
                                      width, height);
                 return Buffer();
         }
+        uint16_t restartInterval = 0;
+        if (hasRestart) {
+                if (firstPkt.payloadSize() < jpegHdrSize) {
+                        promekiWarnThrottled(1000,
+                                             "RtpPayloadJpeg::unpack truncated restart header "
+                                             "(payloadSize=%zu min=%zu)",
+                                             firstPkt.payloadSize(), jpegHdrSize);
+                        return Buffer();
+                }
+                restartInterval = (static_cast<uint16_t>(firstPl[Rfc2435HeaderSize]) << 8) |
+                                  firstPl[Rfc2435HeaderSize + 1];
+        }
 
         // -- Extract quantization tables --
         //
@@ -544,13 +596,13 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         if (rtpQ < 128) {
                 makeDefaultQuantTables(rtpQ, quantTables);
         } else {
-                if (firstPkt.payloadSize() < Rfc2435HeaderSize + Rfc2435QtHeaderSize) {
+                if (firstPkt.payloadSize() < jpegHdrSize + Rfc2435QtHeaderSize) {
                         promekiWarnThrottled(1000,
                                              "RtpPayloadJpeg::unpack truncated QT header (payloadSize=%zu min=%zu)",
-                                             firstPkt.payloadSize(), Rfc2435HeaderSize + Rfc2435QtHeaderSize);
+                                             firstPkt.payloadSize(), jpegHdrSize + Rfc2435QtHeaderSize);
                         return Buffer();
                 }
-                const uint8_t *qtHdr = firstPl + Rfc2435HeaderSize;
+                const uint8_t *qtHdr = firstPl + jpegHdrSize;
                 const uint8_t  qtMbz = qtHdr[0];
                 const uint8_t  qtPrecision = qtHdr[1];
                 const uint16_t qtLen = (static_cast<uint16_t>(qtHdr[2]) << 8) | qtHdr[3];
@@ -561,14 +613,14 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
                                              qtPrecision, qtLen);
                         return Buffer();
                 }
-                if (firstPkt.payloadSize() < Rfc2435HeaderSize + Rfc2435QtHeaderSize + static_cast<size_t>(qtLen)) {
+                if (firstPkt.payloadSize() < jpegHdrSize + Rfc2435QtHeaderSize + static_cast<size_t>(qtLen)) {
                         promekiWarnThrottled(1000,
                                              "RtpPayloadJpeg::unpack truncated QT data (payloadSize=%zu need=%zu)",
                                              firstPkt.payloadSize(),
-                                             Rfc2435HeaderSize + Rfc2435QtHeaderSize + static_cast<size_t>(qtLen));
+                                             jpegHdrSize + Rfc2435QtHeaderSize + static_cast<size_t>(qtLen));
                         return Buffer();
                 }
-                std::memcpy(quantTables, firstPl + Rfc2435HeaderSize + Rfc2435QtHeaderSize, qtLen);
+                std::memcpy(quantTables, firstPl + jpegHdrSize + Rfc2435QtHeaderSize, qtLen);
                 if (qtLen == 64) {
                         // Duplicate the luminance table as the
                         // chrominance table — matches what libjpeg
@@ -590,8 +642,8 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         size_t totalEntropy = 0;
         for (size_t i = 0; i < packets.size(); i++) {
                 const RtpPacket &pkt = packets[i];
-                if (pkt.isNull() || pkt.payloadSize() <= Rfc2435HeaderSize) continue;
-                size_t payBytes = pkt.payloadSize() - Rfc2435HeaderSize;
+                if (pkt.isNull() || pkt.payloadSize() <= jpegHdrSize) continue;
+                size_t payBytes = pkt.payloadSize() - jpegHdrSize;
                 if (i == 0 && qtSkipBytes > 0) {
                         if (payBytes <= qtSkipBytes) continue;
                         payBytes -= qtSkipBytes;
@@ -607,12 +659,12 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         // advanced past the QT header.
         for (size_t i = 0; i < packets.size(); i++) {
                 const RtpPacket &pkt = packets[i];
-                if (pkt.isNull() || pkt.payloadSize() <= Rfc2435HeaderSize) continue;
+                if (pkt.isNull() || pkt.payloadSize() <= jpegHdrSize) continue;
                 const uint8_t *pl = pkt.payload();
                 const uint32_t fragOff = (static_cast<uint32_t>(pl[1]) << 16) | (static_cast<uint32_t>(pl[2]) << 8) |
                                          static_cast<uint32_t>(pl[3]);
-                const uint8_t *dataPtr = pl + Rfc2435HeaderSize;
-                size_t         dataLen = pkt.payloadSize() - Rfc2435HeaderSize;
+                const uint8_t *dataPtr = pl + jpegHdrSize;
+                size_t         dataLen = pkt.payloadSize() - jpegHdrSize;
                 if (i == 0 && qtSkipBytes > 0) {
                         if (dataLen <= qtSkipBytes) continue;
                         dataPtr += qtSkipBytes;
@@ -632,7 +684,8 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         //   Type 0  → 4:2:2 (per FFmpeg's rtpenc_jpeg.c mapping)
         //   Type 1  → 4:2:0
         // We follow FFmpeg's convention to interop with its encoder.
-        const bool is422 = (rtpType == 0);
+        // Types 64 / 65 are the same with restart markers.
+        const bool is422 = ((hasRestart ? rtpType - Rfc2435RestartTypeBase : rtpType) == 0);
 
         List<uint8_t> out;
         // Reserve a conservative upper bound to avoid per-append
@@ -687,6 +740,17 @@ Buffer RtpPayloadJpeg::unpack(const RtpPacket::List &packets) {
         appendDhtSegment(out, 0, 1, jpegChromDcCodelens, jpegChromDcSymbols, sizeof(jpegChromDcSymbols));
         appendDhtSegment(out, 1, 1, jpegChromAcCodelens, jpegChromAcSymbols, sizeof(jpegChromAcSymbols));
 
+        // DRI — the scan's RSTn markers are only legal with a restart
+        // interval in effect.
+        if (restartInterval != 0) {
+                out.pushToBack(0xFF);
+                out.pushToBack(JpegDRI);
+                out.pushToBack(0x00);
+                out.pushToBack(0x04);
+                out.pushToBack(static_cast<uint8_t>((restartInterval >> 8) & 0xFF));
+                out.pushToBack(static_cast<uint8_t>(restartInterval & 0xFF));
+        }
+
         // SOS — 14 bytes total: FF DA | 00 0C | 03 | (Cs Td/Ta)*3 | Ss Se Ah/Al
         out.pushToBack(0xFF);
         out.pushToBack(JpegSOS);
@@ -33,6 +33,27 @@ struct FieldRowAssignment {
                 int fieldIndex;      // 0 or 1.
                 int srdRowInField;   // SRD Row Number stamped on the wire.
 };
+
+// One payload slice of a scattered packet built by packBuffer(): a
+// byte range of either the source frame or the shared zero run.
+struct PayloadRun {
+                const Buffer *buf;
+                size_t        offset;
+                size_t        size;
+};
+
+// Shared all-zero source for truncated-row fill and BPM padding in
+// scattered packets.  Sized for the largest possible UDP payload so a
+// single run always suffices.
+const Buffer &zeroRun() {
+        static const Buffer zeros = [] {
+                Buffer b(65536);
+                b.setSize(65536);
+                std::memset(b.data(), 0, b.size());
+                return b;
+        }();
+        return zeros;
+}
 } // namespace
 
 RtpPayloadRawVideo::RtpPayloadRawVideo(int width, int height, int bitsPerPixel, int pgroupBytes, int rowsPerSrd)
@@ -89,10 +110,20 @@ RtpPacket RtpPayloadRawVideo::makeKeepAlive(uint32_t packetCounter, uint16_t srd
 }
 
 RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
+        return packImpl(static_cast<const uint8_t *>(mediaData), size, nullptr, 0);
+}
+
+RtpPacket::List RtpPayloadRawVideo::packBuffer(const Buffer &buf, size_t offset, size_t size) {
+        const uint8_t *base = static_cast<const uint8_t *>(buf.data());
+        if (base == nullptr || !buf.isHostAccessible()) return RtpPayload::packBuffer(buf, offset, size);
+        return packImpl(base + offset, size, &buf, offset);
+}
+
+RtpPacket::List RtpPayloadRawVideo::packImpl(const uint8_t *src, size_t size, const Buffer *srcBuf, size_t srcBase) {
         RtpPacket::List packets;
-        if (size == 0 || mediaData == nullptr) {
+        if (size == 0 || src == nullptr) {
                 promekiWarnThrottled(5000, "RtpPayloadRawVideo::pack invalid input (size=%zu data=%p)", size,
-                                     mediaData);
+                                     static_cast<const void *>(src));
                 return packets;
         }
 
@@ -318,14 +349,19 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
         // placeholder) and trimmed to the actual emitted size for
         // each individual packet via the RtpPacket constructor's
         // size argument.
+        //
+        // Scatter mode (packBuffer) only writes the headers into the
+        // shared Buffer; the sample data and padding are appended to
+        // each packet as extra slices referencing srcBuf / zeroRun().
         // -----------------------------------------------------------
-        const size_t maxPktSize = RtpPacket::HeaderSize + effectivePayload;
+        const bool   scatter = (srcBuf != nullptr);
+        const size_t maxPktSize = scatter ? RtpPacket::HeaderSize + ExtSeqSize + MaxSrdsPerPacket * SrdHeaderSize
+                                          : RtpPacket::HeaderSize + effectivePayload;
         const size_t totalPackets = packetStarts.size();
         auto         buf = Buffer(totalPackets * maxPktSize);
         buf.setSize(totalPackets * maxPktSize);
-        uint8_t       *bufData = static_cast<uint8_t *>(buf.data());
-        const uint8_t *src = static_cast<const uint8_t *>(mediaData);
-        size_t         bufOffset = 0;
+        uint8_t *bufData = static_cast<uint8_t *>(buf.data());
+        size_t   bufOffset = 0;
 
         for (size_t p = 0; p < totalPackets; p++) {
                 const size_t srdStart = packetStarts.at(p);
@@ -348,8 +384,30 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
                 // SRD (carries the assigned field index in
                 // Interlaced/PsF; otherwise the manual @ref _fieldBit
                 // override is used uniformly in Progressive).
-                uint8_t *hdrCursor = payload + ExtSeqSize;
-                size_t   dataCursor = ExtSeqSize + srdCount * SrdHeaderSize;
+                uint8_t     *hdrCursor = payload + ExtSeqSize;
+                size_t       dataCursor = ExtSeqSize + srdCount * SrdHeaderSize;
+                const size_t hdrBytes = RtpPacket::HeaderSize + dataCursor;
+                // Scatter mode: at most one run per SRD plus one for
+                // the BPM padding.  Adjacent runs that continue each
+                // other (consecutive short rows, truncated-row zeros
+                // followed by padding) are merged.
+                PayloadRun runs[MaxSrdsPerPacket + 1];
+                size_t     runCount = 0;
+                auto       addRun = [&](const Buffer *b, size_t off, size_t len) {
+                        if (runCount > 0) {
+                                PayloadRun &last = runs[runCount - 1];
+                                if (last.buf == b && last.offset + last.size == off) {
+                                        last.size += len;
+                                        return;
+                                }
+                        }
+                        runs[runCount++] = {b, off, len};
+                };
+                auto addZeros = [&](size_t len) {
+                        const size_t off =
+                                (runCount > 0 && runs[runCount - 1].buf == &zeroRun()) ? runs[runCount - 1].size : 0;
+                        addRun(&zeroRun(), off, len);
+                };
                 for (size_t k = 0; k < srdCount; k++) {
                         const PendingSrd &s = srds.at(srdStart + k);
                         const bool        isLast = (k + 1 == srdCount);
@@ -373,7 +431,13 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
                         hdrCursor += SrdHeaderSize;
 
                         // Sample data segment for this SRD.
-                        if (s.srcByteOffset + s.dataBytes <= size) {
+                        if (scatter) {
+                                if (s.srcByteOffset + s.dataBytes <= size) {
+                                        addRun(srcBuf, srcBase + s.srcByteOffset, s.dataBytes);
+                                } else {
+                                        addZeros(s.dataBytes);
+                                }
+                        } else if (s.srcByteOffset + s.dataBytes <= size) {
                                 std::memcpy(payload + dataCursor, src + s.srcByteOffset, s.dataBytes);
                         } else {
                                 // Source truncated mid-row — emit
@@ -395,7 +459,11 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
                 // is invisible on the receive side.
                 size_t finalPayloadBytes = dataCursor;
                 if (bpm && dataCursor < bpmTarget) {
-                        std::memset(payload + dataCursor, 0, bpmTarget - dataCursor);
+                        if (scatter) {
+                                addZeros(bpmTarget - dataCursor);
+                        } else {
+                                std::memset(payload + dataCursor, 0, bpmTarget - dataCursor);
+                        }
                         finalPayloadBytes = bpmTarget;
                 }
 
@@ -415,7 +483,8 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
                 const bool    tailOfFieldOrFrame = endOfFrame || (splitFrame && nextStartsNewField);
 
                 const size_t pktSize = RtpPacket::HeaderSize + finalPayloadBytes;
-                RtpPacket    rtpPkt(buf, bufOffset, pktSize);
+                RtpPacket    rtpPkt(buf, bufOffset, scatter ? hdrBytes : pktSize);
+                for (size_t r = 0; r < runCount; r++) rtpPkt.pushToBack(*runs[r].buf, runs[r].offset, runs[r].size);
                 if (splitFrame && (nextStartsNewField || endOfFrame)) rtpPkt.setMarker(true);
 
                 // §6.3.2: GPM packets below GpmShortPacketFloor octets
@@ -433,21 +502,95 @@ RtpPacket::List RtpPayloadRawVideo::pack(const void *mediaData, size_t size) {
                 }
 
                 packets.pushToBack(rtpPkt);
-                bufOffset += pktSize;
+                bufOffset += scatter ? hdrBytes : pktSize;
                 _packetCounter += static_cast<uint32_t>(srdCount > 0 ? 1u : 0u);
         }
 
         return packets;
 }
 
+void RtpPayloadRawVideo::FrameAssembly::begin(Buffer plane, size_t lineCount, size_t bytesPerLine) {
+        _plane = std::move(plane);
+        _data = static_cast<uint8_t *>(_plane.data());
+        _bytesPerLine = bytesPerLine;
+        _completeLines = 0;
+        _lines.clear();
+        _lines.resize(lineCount);
+        _complete.clear();
+        _complete.resize((lineCount + 63) / 64, 0);
+        return;
+}
+
+void RtpPayloadRawVideo::FrameAssembly::write(size_t line, size_t offset, const uint8_t *src, size_t size) {
+        if (_data == nullptr || _bytesPerLine == 0) return;
+        // A segment may legally run on into the next row (the
+        // frame-bounds check in the original unpack allowed it), so
+        // walk it row by row.
+        while (size > 0 && line < _lines.size()) {
+                if (offset >= _bytesPerLine) {
+                        line += offset / _bytesPerLine;
+                        offset %= _bytesPerLine;
+                        continue;
+                }
+                const size_t chunk = (size < _bytesPerLine - offset) ? size : _bytesPerLine - offset;
+                uint8_t     *row = _data + line * _bytesPerLine;
+                Line        &l = _lines[line];
+                // A fragment that starts past the contiguous fill
+                // point means the bytes in between were lost (or are
+                // still in flight).  Clear them now so finish() only
+                // has to look at each row's tail; a late arrival
+                // simply overwrites the zeros.
+                if (offset > l.filled) std::memset(row + l.filled, 0, offset - l.filled);
+                std::memcpy(row + offset, src, chunk);
+                if (offset + chunk > l.filled) l.filled = static_cast<uint32_t>(offset + chunk);
+                const bool wasComplete = l.received >= _bytesPerLine;
+                l.received += static_cast<uint32_t>(chunk);
+                if (!wasComplete && l.received >= _bytesPerLine) {
+                        _complete[line / 64] |= uint64_t(1) << (line % 64);
+                        _completeLines++;
+                }
+                src += chunk;
+                size -= chunk;
+                offset = 0;
+                line++;
+        }
+        return;
+}
+
+Buffer RtpPayloadRawVideo::FrameAssembly::finish() {
+        if (!_plane.isValid()) return Buffer();
+        for (size_t i = 0; i < _lines.size(); i++) {
+                const size_t filled = _lines[i].filled;
+                if (filled < _bytesPerLine) std::memset(_data + i * _bytesPerLine + filled, 0, _bytesPerLine - filled);
+        }
+        Buffer plane = std::move(_plane);
+        _plane = Buffer();
+        _data = nullptr;
+        return plane;
+}
+
+void RtpPayloadRawVideo::FrameAssembly::clear() {
+        _plane = Buffer();
+        _data = nullptr;
+        _completeLines = 0;
+        _lines.clear();
+        _complete.clear();
+        return;
+}
+
 Buffer RtpPayloadRawVideo::unpack(const RtpPacket::List &packets) {
-        const size_t bytesPerLine = static_cast<size_t>(_width) * static_cast<size_t>(_bitsPerPixel) / 8;
-        const int    wireRows = _height / _rowsPerSrd;
-        const size_t frameSize = bytesPerLine * static_cast<size_t>(wireRows);
-        Buffer       result(frameSize);
-        result.setSize(frameSize);
-        std::memset(result.data(), 0, frameSize);
-        uint8_t *dst = static_cast<uint8_t *>(result.data());
+        const size_t size = frameSize();
+        Buffer       result(size);
+        result.setSize(size);
+        FrameAssembly frame;
+        frame.begin(result, wireLineCount(), wireBytesPerLine());
+        for (const auto &pkt : packets) unpackInto(pkt, frame);
+        return frame.finish();
+}
+
+size_t RtpPayloadRawVideo::unpackInto(const RtpPacket &pkt, FrameAssembly &frame) const {
+        if (!frame.isActive() || pkt.isNull() || pkt.payloadSize() <= ExtSeqSize) return 0;
+        const int wireRows = _height / _rowsPerSrd;
 
         // Receiver-side mirror of pack()'s field/segment assignment
         // (see §6.1.5 + §6.2.5 in pack()).  In Interlaced / PsF the
@@ -464,85 +607,81 @@ Buffer RtpPayloadRawVideo::unpack(const RtpPacket::List &packets) {
         // SRDs back to source wire rows.
         const int psfTopCount = (wireRows + 1) / 2;
 
-        for (const auto &pkt : packets) {
-                if (pkt.isNull() || pkt.payloadSize() <= ExtSeqSize) continue;
-                const uint8_t *pl = pkt.payload();
-                const size_t   payloadAvail = pkt.payloadSize();
-
-                // First pass over this packet's payload: walk SRD
-                // headers in order, gathering (row, offset, length,
-                // F-bit) tuples and the total header bytes consumed.
-                // The C bit on each SRD signals whether another
-                // header follows in this packet (§6.1.4); cap at
-                // the §6.2.1 3-SRD limit so a malformed sender can't
-                // induce an unbounded walk.
-                struct SrdRec {
-                                uint16_t length;
-                                uint16_t row;
-                                uint16_t pixelOffset;
-                                uint8_t  fBit;
-                };
-                SrdRec srds[MaxSrdsPerPacket];
-                size_t srdCount = 0;
-                size_t cursor = ExtSeqSize;
-                bool   continueWalk = true;
-                while (continueWalk && srdCount < MaxSrdsPerPacket && cursor + SrdHeaderSize <= payloadAvail) {
-                        const uint8_t *h = pl + cursor;
-                        SrdRec        &s = srds[srdCount];
-                        s.length = static_cast<uint16_t>((static_cast<uint16_t>(h[0]) << 8) | h[1]);
-                        s.fBit = (h[2] & 0x80u) ? 1u : 0u;
-                        s.row = static_cast<uint16_t>(((static_cast<uint16_t>(h[2]) & 0x7Fu) << 8) | h[3]);
-                        const uint8_t cBit = h[4] & 0x80u;
-                        s.pixelOffset = static_cast<uint16_t>(((static_cast<uint16_t>(h[4]) & 0x7Fu) << 8) | h[5]);
-                        srdCount++;
-                        cursor += SrdHeaderSize;
-                        continueWalk = (cBit != 0);
-                }
+        const uint8_t *pl = pkt.payload();
+        const size_t   payloadAvail = pkt.payloadSize();
+
+        // First pass over this packet's payload: walk SRD
+        // headers in order, gathering (row, offset, length,
+        // F-bit) tuples and the total header bytes consumed.
+        // The C bit on each SRD signals whether another
+        // header follows in this packet (§6.1.4); cap at
+        // the §6.2.1 3-SRD limit so a malformed sender can't
+        // induce an unbounded walk.
+        struct SrdRec {
+                        uint16_t length;
+                        uint16_t row;
+                        uint16_t pixelOffset;
+                        uint8_t  fBit;
+        };
+        SrdRec srds[MaxSrdsPerPacket];
+        size_t srdCount = 0;
+        size_t cursor = ExtSeqSize;
+        bool   continueWalk = true;
+        while (continueWalk && srdCount < MaxSrdsPerPacket && cursor + SrdHeaderSize <= payloadAvail) {
+                const uint8_t *h = pl + cursor;
+                SrdRec        &s = srds[srdCount];
+                s.length = static_cast<uint16_t>((static_cast<uint16_t>(h[0]) << 8) | h[1]);
+                s.fBit = (h[2] & 0x80u) ? 1u : 0u;
+                s.row = static_cast<uint16_t>(((static_cast<uint16_t>(h[2]) & 0x7Fu) << 8) | h[3]);
+                const uint8_t cBit = h[4] & 0x80u;
+                s.pixelOffset = static_cast<uint16_t>(((static_cast<uint16_t>(h[4]) & 0x7Fu) << 8) | h[5]);
+                srdCount++;
+                cursor += SrdHeaderSize;
+                continueWalk = (cBit != 0);
+        }
 
-                // Sample data begins immediately after the last SRD
-                // header.  Each SRD's data follows in declaration
-                // order, length given by the header's Length field.
-                //
-                // For 4:2:0 (rowsPerSrd > 1) the SRD Row Number
-                // indexes image rows in pairs (0, 2, 4, ...) and is
-                // always in the field-0 sense (§6.2.5 forbids 4:2:0
-                // interlaced/PsF); the wire-row index in our single-
-                // plane wire buffer is row / rowsPerSrd.  For
-                // Interlaced/PsF the SRD Row Number is field-relative
-                // and the F-bit picks which source wire-row family it
-                // belongs to (§6.1.5).
-                for (size_t k = 0; k < srdCount; k++) {
-                        const SrdRec &s = srds[k];
-                        if (cursor + s.length > payloadAvail) break;
-                        const size_t byteOffset =
-                                static_cast<size_t>(s.pixelOffset) * static_cast<size_t>(_bitsPerPixel) / 8;
-                        size_t wireRow;
-                        if (!splitFrame) {
-                                wireRow = static_cast<size_t>(s.row) / static_cast<size_t>(_rowsPerSrd);
-                        } else if (scanIsInterlaced) {
-                                // Reconstruct sourceRow from
-                                // (fieldIndex, srdRowInField).  Field
-                                // 0 parity is 0 for even-first (default
-                                // / unspecified), 1 for odd-first.
-                                const int parity0 = oddFirst ? 1 : 0;
-                                const int fieldParity =
-                                        (s.fBit == 0) ? parity0 : (1 - parity0);
-                                wireRow = static_cast<size_t>(s.row) * 2u + static_cast<size_t>(fieldParity);
-                        } else { // PsF
-                                wireRow = (s.fBit == 0)
-                                                  ? static_cast<size_t>(s.row)
-                                                  : static_cast<size_t>(psfTopCount) +
-                                                            static_cast<size_t>(s.row);
-                        }
-                        const size_t dstOff = wireRow * bytesPerLine + byteOffset;
-                        const size_t copySize = (dstOff + s.length <= frameSize) ? s.length : 0;
-                        if (copySize > 0) {
-                                std::memcpy(dst + dstOff, pl + cursor, copySize);
-                        }
-                        cursor += s.length;
+        // Sample data begins immediately after the last SRD
+        // header.  Each SRD's data follows in declaration
+        // order, length given by the header's Length field.
+        //
+        // For 4:2:0 (rowsPerSrd > 1) the SRD Row Number
+        // indexes image rows in pairs (0, 2, 4, ...) and is
+        // always in the field-0 sense (§6.2.5 forbids 4:2:0
+        // interlaced/PsF); the wire-row index in our single-
+        // plane wire buffer is row / rowsPerSrd.  For
+        // Interlaced/PsF the SRD Row Number is field-relative
+        // and the F-bit picks which source wire-row family it
+        // belongs to (§6.1.5).
+        const size_t bytesPerLine = frame.bytesPerLine();
+        const size_t frameBytes = bytesPerLine * frame.lineCount();
+        size_t       written = 0;
+        for (size_t k = 0; k < srdCount; k++) {
+                const SrdRec &s = srds[k];
+                if (cursor + s.length > payloadAvail) break;
+                const size_t byteOffset = static_cast<size_t>(s.pixelOffset) * static_cast<size_t>(_bitsPerPixel) / 8;
+                size_t       wireRow;
+                if (!splitFrame) {
+                        wireRow = static_cast<size_t>(s.row) / static_cast<size_t>(_rowsPerSrd);
+                } else if (scanIsInterlaced) {
+                        // Reconstruct sourceRow from
+                        // (fieldIndex, srdRowInField).  Field
+                        // 0 parity is 0 for even-first (default
+                        // / unspecified), 1 for odd-first.
+                        const int parity0 = oddFirst ? 1 : 0;
+                        const int fieldParity = (s.fBit == 0) ? parity0 : (1 - parity0);
+                        wireRow = static_cast<size_t>(s.row) * 2u + static_cast<size_t>(fieldParity);
+                } else { // PsF
+                        wireRow = (s.fBit == 0) ? static_cast<size_t>(s.row)
+                                                : static_cast<size_t>(psfTopCount) + static_cast<size_t>(s.row);
+                }
+                const size_t dstOff = wireRow * bytesPerLine + byteOffset;
+                if (s.length > 0 && dstOff + s.length <= frameBytes) {
+                        frame.write(wireRow, byteOffset, pl + cursor, s.length);
+                        written += s.length;
                 }
+                cursor += s.length;
         }
-        return result;
+        return written;
 }
 
 PROMEKI_NAMESPACE_END
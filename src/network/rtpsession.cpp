@@ -12,6 +12,7 @@
 #include <promeki/packettransport.h>
 #include <promeki/random.h>
 #include <promeki/rtcppacket.h>
+#include <promeki/rtppacketslabpool.h>
 #include <promeki/rtpseqreorderbuffer.h>
 #include <promeki/rtpseqtracker.h>
 #include <promeki/rtpstreamclock.h>
@@ -29,8 +30,10 @@ PROMEKI_NAMESPACE_BEGIN
 // Declared inside the RtpSession class (as a private nested type via
 // a forward-friend) so that the thread can reach into the session's
 // private members without exposing them further.  The thread runs a
-// blocking receivePacket() loop on the session's PacketTransport,
-// wraps each datagram in an RtpPacket view of an owned Buffer,
+// blocking receivePackets() loop on the session's PacketTransport
+// (one recvmmsg() per batch on UDP), receiving each batch into a slab
+// from an RtpPacketSlabPool and wrapping each datagram in an RtpPacket
+// view of that slab,
 // demuxes RTCP via byte[1] in [200..223], and dispatches RTP packets
 // through the per-stream @c StreamReceiver entries: SSRC pin / change
 // detection → @ref RtpSeqTracker observe → @ref RtpSeqReorderBuffer
@@ -42,7 +45,11 @@ PROMEKI_NAMESPACE_BEGIN
 class RtpSession::ReceiveThread : public Thread {
         public:
                 ReceiveThread(RtpSession *session, PacketTransport *transport, const String &name)
-                    : _session(session), _transport(transport) {
+                    : _session(session), _transport(transport),
+                      _slabs(kBatchSize, kMaxPacketSize,
+                             session->_receivePacketBudget > 0
+                                     ? RtpPacketSlabPool::slabsForPackets(session->_receivePacketBudget, kBatchSize)
+                                     : RtpPacketSlabPool::DefaultMaxSlabs) {
                         _stopRequested.setValue(false);
                         Thread::setName(name);
                 }
@@ -66,11 +73,6 @@ class RtpSession::ReceiveThread : public Thread {
 
         protected:
                 void run() override {
-                        // Figure out the largest datagram we care
-                        // about — 2 KiB covers every common RTP wire
-                        // format (MTU-safe payload + RTP header).
-                        constexpr size_t kMaxPacketSize = 2048;
-
                         // If the transport is UDP-backed, set
                         // SO_RCVTIMEO on the underlying socket so we
                         // wake up periodically to check the stop
@@ -83,90 +85,150 @@ class RtpSession::ReceiveThread : public Thread {
                                 }
                         }
 
+                        PacketTransport::RecvDatagramList batch;
+                        batch.reserve(kBatchSize);
+
                         while (!_stopRequested.value()) {
-                                Buffer  buf = Buffer(kMaxPacketSize);
-                                ssize_t n = _transport->receivePacket(buf.data(), kMaxPacketSize);
+                                // Batches land in the free slots of the
+                                // pool's fill slab, so a short batch
+                                // does not leave the rest of a slab
+                                // unused.  Packets handed downstream are
+                                // views of the slab, so it only comes
+                                // back out of the pool once every view
+                                // has been dropped by the reorder
+                                // buffer / depacketizer.
+                                size_t first = 0;
+                                Buffer slab = _slabs.fillSlab(first);
+                                if (!slab.isValid()) {
+                                        BasicThread::sleepMs(1);
+                                        continue;
+                                }
+                                uint8_t *base = static_cast<uint8_t *>(slab.data()) + first * kMaxPacketSize;
+                                batch.resize(kBatchSize - first);
+                                for (size_t i = 0; i < batch.size(); ++i) {
+                                        batch[i].data = base + i * kMaxPacketSize;
+                                        batch[i].maxSize = kMaxPacketSize;
+                                        batch[i].size = 0;
+                                }
+
+                                int got = _transport->receivePackets(batch);
                                 // Stamp the per-packet arrival anchor as
-                                // close to @c receivePacket return as
+                                // close to @c receivePackets return as
                                 // possible, before any further work
                                 // adds scheduling jitter to subsequent
-                                // @c TimeStamp::now() calls.  The
+                                // @c TimeStamp::now() calls.  Every
+                                // packet in a batch was already queued
+                                // on the socket when the call returned,
+                                // so they share the stamp.  The
                                 // post-Phase-2 path uses this for
                                 // RFC 3550 §A.8 interarrival jitter and
                                 // for stream-anchor @c captureTime
                                 // interpolation in the depacketizer
                                 // thread.
                                 const TimeStamp arrivalSteady = TimeStamp::now();
-                                if (n <= 0) {
-                                        // Timeout (EAGAIN on UDP),
-                                        // transient error, or empty
-                                        // datagram — poll again.
-                                        continue;
-                                }
-                                if (n < 4) {
-                                        // Too short to even hold an
-                                        // RTCP common header.  Drop.
-                                        promekiWarnThrottled(5000,
-                                                             "RtpSession: dropping runt datagram (%zd bytes < 4)",
-                                                             n);
-                                        continue;
-                                }
-                                buf.setSize(static_cast<size_t>(n));
-
-                                // RTCP / RTP demux.  We advertise rtcp-
-                                // mux in SDP so the same socket carries
-                                // both protocols.  RTP packet types are
-                                // 0..127 (byte 1 is M | PT, with M
-                                // optionally setting bit 7); RTCP
-                                // packet types are 200..223.  The
-                                // 192..199 / 224..255 ranges are
-                                // reserved.  Distinguishing on the
-                                // 200..223 RTCP range is unambiguous
-                                // and what RFC 5761 §4 prescribes.
-                                const uint8_t pt = static_cast<const uint8_t *>(buf.data())[1];
-                                if (pt >= 200u && pt <= 223u) {
-                                        _session->handleRtcp(static_cast<const uint8_t *>(buf.data()),
-                                                             static_cast<size_t>(n));
+                                if (got <= 0) {
+                                        // Timeout (EAGAIN on UDP) or
+                                        // transient error — poll again.
                                         continue;
                                 }
 
-                                if (static_cast<size_t>(n) < RtpPacket::HeaderSize) {
-                                        // Too short to contain a
-                                        // fixed RTP header; drop.
-                                        promekiWarnThrottled(2000,
-                                                             "RtpSession: dropping short RTP datagram (%zd < %zu)",
-                                                             n, RtpPacket::HeaderSize);
-                                        continue;
-                                }
-                                RtpPacket pkt(buf, 0, static_cast<size_t>(n));
-                                if (!pkt.isValid()) {
-                                        // Not a valid RTP packet
-                                        // (wrong version, truncated
-                                        // extension, etc.) — drop.
-                                        const uint8_t *bd = static_cast<const uint8_t *>(buf.data());
-                                        promekiWarnThrottled(2000,
-                                                             "RtpSession: dropping invalid RTP packet (size=%zd "
-                                                             "bytes=%02x %02x %02x %02x ...)",
-                                                             n, static_cast<unsigned>(bd[0]),
-                                                             static_cast<unsigned>(bd[1]),
-                                                             static_cast<unsigned>(bd[2]),
-                                                             static_cast<unsigned>(bd[3]));
-                                        continue;
+                                // Checked once per batch: when nobody
+                                // listens we skip the per-packet copy
+                                // the signal needs.
+                                const bool emitSignal = _session->packetReceivedSignal.isConnected();
+                                _slabs.commitSlots(static_cast<size_t>(got));
+                                for (int i = 0; i < got; ++i) {
+                                        handleDatagram(slab, (first + static_cast<size_t>(i)) * kMaxPacketSize,
+                                                       batch[i].size, arrivalSteady, emitSignal);
                                 }
-                                pkt.arrivalSteady = arrivalSteady;
-
-                                // Dispatch through the per-stream
-                                // queue-mode receivers.  An empty
-                                // list is rejected at
-                                // @ref startReceiving time so the
-                                // recv loop never runs without one.
-                                dispatchToReceivers(pkt);
+                        }
+                }
+
+        private:
+                // Largest datagram we care about — 2 KiB covers every
+                // common RTP wire format (MTU-safe payload + RTP
+                // header).  Also the slot stride within a slab.
+                static constexpr size_t kMaxPacketSize = 2048;
+
+                // Datagrams per recvmmsg() / slab.  32 × 2 KiB keeps a
+                // slab at 64 KiB; at ~270k pps that is one syscall per
+                // ~120 µs instead of one per ~4 µs.
+                static constexpr size_t kBatchSize = 32;
+
+                /**
+                 * @brief Parses and dispatches one received datagram.
+                 *
+                 * @p offset / @p n locate the datagram inside
+                 * @p slab; RTP packets are forwarded as views of the
+                 * slab rather than copies.
+                 */
+                void handleDatagram(const Buffer &slab, size_t offset, size_t n, const TimeStamp &arrivalSteady,
+                                    bool emitSignal) {
+                        if (n == 0) return;
+                        const uint8_t *bd = static_cast<const uint8_t *>(slab.data()) + offset;
+                        if (n < 4) {
+                                // Too short to even hold an
+                                // RTCP common header.  Drop.
+                                promekiWarnThrottled(5000, "RtpSession: dropping runt datagram (%zu bytes < 4)", n);
+                                return;
+                        }
+
+                        // RTCP / RTP demux.  We advertise rtcp-
+                        // mux in SDP so the same socket carries
+                        // both protocols.  RTP packet types are
+                        // 0..127 (byte 1 is M | PT, with M
+                        // optionally setting bit 7); RTCP
+                        // packet types are 200..223.  The
+                        // 192..199 / 224..255 ranges are
+                        // reserved.  Distinguishing on the
+                        // 200..223 RTCP range is unambiguous
+                        // and what RFC 5761 §4 prescribes.
+                        const uint8_t pt = bd[1];
+                        if (pt >= 200u && pt <= 223u) {
+                                _session->handleRtcp(bd, n);
+                                return;
+                        }
+
+                        if (n < RtpPacket::HeaderSize) {
+                                // Too short to contain a
+                                // fixed RTP header; drop.
+                                promekiWarnThrottled(2000, "RtpSession: dropping short RTP datagram (%zu < %zu)", n,
+                                                     RtpPacket::HeaderSize);
+                                return;
+                        }
+                        RtpPacket pkt(slab, offset, n);
+                        if (!pkt.isValid()) {
+                                // Not a valid RTP packet
+                                // (wrong version, truncated
+                                // extension, etc.) — drop.
+                                promekiWarnThrottled(2000,
+                                                     "RtpSession: dropping invalid RTP packet (size=%zu "
+                                                     "bytes=%02x %02x %02x %02x ...)",
+                                                     n, static_cast<unsigned>(bd[0]), static_cast<unsigned>(bd[1]),
+                                                     static_cast<unsigned>(bd[2]), static_cast<unsigned>(bd[3]));
+                                return;
+                        }
+                        pkt.arrivalSteady = arrivalSteady;
+
+                        // Dispatch through the per-stream
+                        // queue-mode receivers.  An empty
+                        // list is rejected at
+                        // @ref startReceiving time so the
+                        // recv loop never runs without one.
+                        dispatchToReceivers(pkt);
+                        if (emitSignal) {
+                                // Signal consumers get a standalone
+                                // Buffer holding just this datagram,
+                                // as before slabs were introduced.
+                                Buffer buf(n);
+                                std::memcpy(buf.data(), bd, n);
+                                buf.setSize(n);
                                 _session->packetReceivedSignal.emit(buf, pkt.timestamp(), pkt.payloadType(),
                                                                     pkt.marker());
                         }
+                        return;
                 }
 
-        private:
                 /**
                  * @brief Queue-mode dispatch for one parsed packet.
                  *
@@ -301,10 +363,11 @@ class RtpSession::ReceiveThread : public Thread {
                 static constexpr uint32_t kSsrcDebounceCount = 5;
                 static constexpr uint32_t kSsrcDebounceWindowMs = 1000;
 
-                RtpSession      *_session = nullptr;
-                PacketTransport *_transport = nullptr; ///< Per-leg transport (primary or ST 2022-7 secondary).
-                Atomic<bool>     _stopRequested;
-                bool             _warnedMissing = false;
+                RtpSession       *_session = nullptr;
+                PacketTransport  *_transport = nullptr; ///< Per-leg transport (primary or ST 2022-7 secondary).
+                Atomic<bool>      _stopRequested;
+                bool              _warnedMissing = false;
+                RtpPacketSlabPool _slabs;
 };
 
 RtpSession::RtpSession(ObjectBase *parent) : ObjectBase(parent) {
@@ -554,17 +617,41 @@ Error RtpSession::sendPackets(RtpPacketBatch &batch) {
         // gets the same deadline (ST 2110-40 LLTM ANC); when stride
         // is non-zero packets land on the SMPTE Epoch grid at
         // @c TPR_j = T_VD + j × T_RS (ST 2110-21 narrow timing).
+        //
+        // Scattered packets (RtpPayload::packBuffer) carry the headers
+        // in slice 0 and reference the frame for the rest; they go out
+        // as gather datagrams.  When either leg sends with
+        // MSG_ZEROCOPY the slice Buffers ride along as owners so the
+        // transport can pin them until the kernel is done.
+        const bool zeroCopy = _transport->isZeroCopy() ||
+                              (_transportSecondary != nullptr && _transportSecondary->isZeroCopy());
         PacketTransport::DatagramList dgs;
         dgs.reserve(batch.packets.size());
         for (size_t i = 0; i < batch.packets.size(); i++) {
                 auto &pkt = batch.packets[i];
-                if (pkt.isNull() || pkt.size() < RtpPacket::HeaderSize) continue;
+                if (pkt.isNull() || pkt[0].size() < RtpPacket::HeaderSize) continue;
+                if (pkt.count() > 1 + PacketTransport::Datagram::MaxSegments) {
+                        promekiWarnThrottled(1000,
+                                             "RtpSession::sendPackets packet %zu has %zu slices (max %zu) — dropped", i,
+                                             pkt.count(), 1 + PacketTransport::Datagram::MaxSegments);
+                        continue;
+                }
 
                 fillTransportHeader(pkt);
 
                 PacketTransport::Datagram d;
                 d.data = pkt.data();
-                d.size = pkt.size();
+                d.size = pkt[0].size();
+                for (size_t s = 1; s < pkt.count(); s++) {
+                        d.segments[s - 1].data = pkt[s].data();
+                        d.segments[s - 1].size = pkt[s].size();
+                        // Slices usually reference the frame, but any
+                        // of them may point at the shared zero run
+                        // instead, so each one pins its own Buffer.
+                        if (zeroCopy) d.segments[s - 1].owner = pkt[s].buffer();
+                }
+                d.segmentCount = pkt.count() - 1;
+                if (zeroCopy) d.dataOwner = pkt.buffer();
                 d.dest = _remote;
                 if (batch.deadlineTaiNs != 0) {
                         d.txTimeNs = batch.deadlineTaiNs +
@@ -27,7 +27,9 @@ PROMEKI_NAMESPACE_BEGIN
 RtpVideoDepacketizerThread::RtpVideoDepacketizerThread(
         RtpVideoDepacketizerContext ctx, const String &name,
         uint32_t clockRateHz, size_t queueDepth)
-    : RtpDepacketizerThread(name, clockRateHz, queueDepth), _ctx(std::move(ctx)) {}
+    : RtpDepacketizerThread(name, clockRateHz, queueDepth), _ctx(std::move(ctx)) {
+        _raw = dynamic_cast<RtpPayloadRawVideo *>(_ctx.payload);
+}
 
 RtpVideoDepacketizerThread::~RtpVideoDepacketizerThread() {
         requestStop();
@@ -41,12 +43,11 @@ void RtpVideoDepacketizerThread::handlePacket(const RtpPacket &pkt) {
                 const uint32_t epoch = _ctx.resetEpoch->value();
                 if (epoch != _lastEpoch) {
                         _lastEpoch = epoch;
-                        if (!_reasmPackets.isEmpty() &&
+                        if (hasPendingFrame() &&
                             _ctx.framesDroppedSsrcReset != nullptr) {
                                 _ctx.framesDroppedSsrcReset->fetchAndAdd(1);
                         }
-                        _reasmPackets.clear();
-                        _reasmHasTimestamp = false;
+                        resetReassembly();
                         _reasmTimestamp = 0;
                         _hasFrameStart = false;
                         _frameStartTime = TimeStamp();
@@ -91,32 +92,70 @@ void RtpVideoDepacketizerThread::handlePacket(const RtpPacket &pkt) {
         _hasLastPacket = true;
 
         if (_reasmHasTimestamp && _reasmTimestamp != pkt.timestamp() &&
-            !_reasmPackets.isEmpty()) {
+            hasPendingFrame()) {
                 emitFrame();
         }
 
-        if (_reasmPackets.isEmpty()) {
+        if (!hasPendingFrame()) {
                 _frameStartTime = now;
                 _hasFrameStart = true;
         }
 
-        _reasmPackets.pushToBack(pkt);
+        if (_raw != nullptr) {
+                handleRawPacket(pkt);
+        } else {
+                _reasmPackets.pushToBack(pkt);
+        }
         _reasmTimestamp = pkt.timestamp();
         _reasmHasTimestamp = true;
 
         if (pkt.marker()) emitFrame();
 }
 
-void RtpVideoDepacketizerThread::onStop() {
+void RtpVideoDepacketizerThread::handleRawPacket(const RtpPacket &pkt) {
+        if (!_rawFrame.isActive()) {
+                const size_t size = _raw->frameSize();
+                if (size == 0) return;
+                Buffer plane;
+                if (_ctx.allocatePlane) plane = _ctx.allocatePlane(size);
+                if (!plane.isValid() || !plane.isHostAccessible() || plane.availSize() < size) {
+                        plane = Buffer(size);
+                }
+                if (!plane.isValid()) {
+                        promekiWarnThrottled(1000, "RtpVideoDepacketizerThread: failed to allocate %zu byte plane",
+                                             size);
+                        return;
+                }
+                plane.setSize(size);
+                _rawFrame.begin(std::move(plane), _raw->wireLineCount(), _raw->wireBytesPerLine());
+                _rawPacketCount = 0;
+                _rawFirstArrival = pkt.arrivalSteady;
+        }
+        _raw->unpackInto(pkt, _rawFrame);
+        _rawPacketCount++;
+        return;
+}
+
+bool RtpVideoDepacketizerThread::hasPendingFrame() const {
+        return _raw != nullptr ? _rawFrame.isActive() : !_reasmPackets.isEmpty();
+}
+
+void RtpVideoDepacketizerThread::resetReassembly() {
         _reasmPackets.clear();
+        _rawFrame.clear();
+        _rawPacketCount = 0;
         _reasmHasTimestamp = false;
+        return;
+}
+
+void RtpVideoDepacketizerThread::onStop() {
+        resetReassembly();
 }
 
 void RtpVideoDepacketizerThread::emitFrame() {
-        if (_reasmPackets.isEmpty()) return;
+        if (!hasPendingFrame()) return;
         if (_ctx.payload == nullptr) {
-                _reasmPackets.clear();
-                _reasmHasTimestamp = false;
+                resetReassembly();
                 return;
         }
 
@@ -124,20 +163,37 @@ void RtpVideoDepacketizerThread::emitFrame() {
         // 8-byte JPEG payload header.  Captured before unpack()
         // consumes the packet list.
         uint8_t rfc2435Type = 0;
-        if (!_reasmPackets.isEmpty()) {
+        if (_raw == nullptr) {
                 const RtpPacket &first = _reasmPackets[0];
                 if (!first.isNull() && first.payloadSize() >= 8) {
                         rfc2435Type = first.payload()[4];
                 }
         }
 
-        const uint32_t  frameRtpTimestamp = _reasmTimestamp;
-        const int32_t   framePacketCount = static_cast<int32_t>(_reasmPackets.size());
-        const TimeStamp firstPktArrival = _reasmPackets[0].arrivalSteady;
-
-        Buffer reassembled = _ctx.payload->unpack(_reasmPackets);
-        _reasmPackets.clear();
-        _reasmHasTimestamp = false;
+        const uint32_t frameRtpTimestamp = _reasmTimestamp;
+        int32_t        framePacketCount = 0;
+        TimeStamp      firstPktArrival;
+        Buffer         reassembled;
+        if (_raw != nullptr) {
+                // Raw video was written into its final plane packet
+                // by packet; finish() only zero-fills what never
+                // arrived.
+                framePacketCount = _rawPacketCount;
+                firstPktArrival = _rawFirstArrival;
+                reassembled = _rawFrame.finish();
+                const size_t missing = _rawFrame.missingLines();
+                if (missing > 0) {
+                        if (_ctx.framesIncomplete != nullptr) _ctx.framesIncomplete->fetchAndAdd(1);
+                        if (_ctx.linesMissing != nullptr) {
+                                _ctx.linesMissing->fetchAndAdd(static_cast<int64_t>(missing));
+                        }
+                }
+        } else {
+                framePacketCount = static_cast<int32_t>(_reasmPackets.size());
+                firstPktArrival = _reasmPackets[0].arrivalSteady;
+                reassembled = _ctx.payload->unpack(_reasmPackets);
+        }
+        resetReassembly();
         if (reassembled.size() == 0) return;
 
         const RtpPayload::ValidateResult vr = _ctx.payload->validate(reassembled);
@@ -175,9 +231,15 @@ void RtpVideoDepacketizerThread::emitFrame() {
         }
         if (!idesc.isValid()) return;
 
-        Buffer plane = Buffer(reassembled.size());
-        std::memcpy(plane.data(), reassembled.data(), reassembled.size());
-        plane.setSize(reassembled.size());
+        // The raw path's plane is already the frame's own
+        // allocation; other codecs still copy out of the unpack
+        // result.
+        Buffer plane = reassembled;
+        if (_raw == nullptr) {
+                plane = Buffer(reassembled.size());
+                std::memcpy(plane.data(), reassembled.data(), reassembled.size());
+                plane.setSize(reassembled.size());
+        }
         const PixelFormat &pd = idesc.pixelFormat();
 
         if (_ctx.noteFrameReceived) _ctx.noteFrameReceived();
@@ -168,9 +168,19 @@ ssize_t SrtSocketTransport::sendPacket(const void *data, size_t size, const Sock
 
 int SrtSocketTransport::sendPackets(const DatagramList &datagrams) {
         if (!isOpen()) return -1;
-        int sent = 0;
+        int           sent = 0;
+        List<uint8_t> gather;
         for (const Datagram &d : datagrams) {
-                const ssize_t n = _socket->write(d.data, static_cast<int64_t>(d.size));
+                // SRT sends each write as one message, so scattered
+                // datagrams are flattened first.
+                const void *bytes = d.data;
+                size_t      size = d.size;
+                if (d.segmentCount > 0) {
+                        gather.resize(d.totalSize());
+                        size = d.copyTo(gather.data());
+                        bytes = gather.data();
+                }
+                const ssize_t n = _socket->write(bytes, static_cast<int64_t>(size));
                 if (n < 0) break;
                 ++sent;
         }
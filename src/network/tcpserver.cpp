@@ -53,6 +53,29 @@ Error TcpServer::listen(const SocketAddress &address, int backlog) {
         int reuse = 1;
         ::setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
 
+        // Optionally share the port with other listeners.
+        if (_reusePort) {
+#if defined(SO_REUSEPORT)
+                if (::setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+                        Error err = Error::syserr();
+                        promekiWarn("TcpServer::listen SO_REUSEPORT on %s failed (errno=%d %s)",
+                                    address.toString().cstr(), errno, strerror(errno));
+                        ::close(_fd);
+                        _fd = -1;
+                        return err;
+                }
+#else
+                promekiWarn("TcpServer::listen SO_REUSEPORT is not available on this platform");
+#if defined(PROMEKI_PLATFORM_WINDOWS)
+                SOCK_CLOSE(_fd);
+#else
+                ::close(_fd);
+#endif
+                _fd = -1;
+                return Error::NotSupported;
+#endif
+        }
+
         struct sockaddr_storage storage;
         size_t                  addrLen = address.toSockAddr(&storage);
         if (addrLen == 0) {
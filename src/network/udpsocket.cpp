@@ -6,9 +6,11 @@
  */
 
 #include <promeki/udpsocket.h>
+#include <promeki/eventloop.h>
 #include <promeki/platform.h>
 #include <promeki/list.h>
 #include <promeki/logger.h>
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 
@@ -35,10 +37,39 @@
 #ifndef SO_MAX_PACING_RATE
 #define SO_MAX_PACING_RATE 47
 #endif
+#include <linux/errqueue.h>
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
 #endif
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace {
+
+        // True when every iov of @p d has an owner the socket can hold
+        // until the kernel's zero-copy completion.
+        bool hasZeroCopyOwners(const UdpSocket::Datagram &d) {
+                if (!d.dataOwner.isValid()) return false;
+                for (size_t s = 0; s < d.segmentCount; s++) {
+                        const UdpSocket::Datagram::Segment &seg = d.segments[s];
+                        if (seg.size == 0) continue;
+                        if (!seg.owner.isValid() && !d.segmentOwner.isValid()) return false;
+                }
+                return true;
+        }
+
+} // namespace
+
 UdpSocket::UdpSocket(ObjectBase *parent) : AbstractSocket(UdpSocketType, parent) {}
 
 UdpSocket::~UdpSocket() {
@@ -65,8 +96,17 @@ Error UdpSocket::openIpv6(OpenMode mode) {
 }
 
 Error UdpSocket::close() {
+        // The watcher must be gone before the fd number can be reused.
+        unwatchErrorQueue();
+        Mutex::Locker lock(_zcMutex);
         closeSocket();
         _domain = 0;
+        // Closing the socket tears down the kernel's pinned pages along
+        // with the error queue, so nothing is left for the owners to
+        // protect.
+        _zeroCopy = false;
+        _zcNextId = 0;
+        _zcPending.clear();
         return Error::Ok;
 }
 
@@ -160,6 +200,10 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
         List<struct mmsghdr>          msgs;
         List<struct iovec>            iovs;
         List<struct sockaddr_storage> addrs;
+        // Each datagram gets a fixed run of iovecs (header plus the
+        // maximum number of gather segments) so msg_iov pointers stay
+        // valid without a second pass.
+        static constexpr size_t kIovPerDatagram = 1 + Datagram::MaxSegments;
         // Control buffer for an optional SCM_TXTIME cmsg per datagram.
         // Allocated whether or not any datagram actually uses txTime
         // because the per-message pointer into the shared control
@@ -167,13 +211,17 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
         static constexpr size_t kCmsgSpace = CMSG_SPACE(sizeof(uint64_t));
         List<uint8_t>           ctrl;
         msgs.resize(count);
-        iovs.resize(count);
+        iovs.resize(count * kIovPerDatagram);
         addrs.resize(count);
         ctrl.resize(count * kCmsgSpace);
         std::memset(msgs.data(), 0, count * sizeof(struct mmsghdr));
         std::memset(ctrl.data(), 0, count * kCmsgSpace);
 
         bool anyTxTime = false;
+        // MSG_ZEROCOPY applies to the whole sendmmsg call, so it is
+        // only used when every datagram can be kept alive until the
+        // kernel reports completion.
+        bool zeroCopy = _zeroCopy;
         for (size_t i = 0; i < count; i++) {
                 const Datagram &d = datagrams[i];
                 if (d.data == nullptr || d.size == 0) {
@@ -182,6 +230,12 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
                                              d.size);
                         return -1;
                 }
+                if (d.segmentCount > Datagram::MaxSegments) {
+                        promekiWarnThrottled(5000,
+                                             "UdpSocket::writeDatagrams too many segments at index %zu (%zu > %zu)", i,
+                                             d.segmentCount, Datagram::MaxSegments);
+                        return -1;
+                }
 
                 size_t addrLen = d.dest.toSockAddr(&addrs[i]);
                 if (addrLen == 0) {
@@ -191,14 +245,29 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
                         return -1;
                 }
 
-                iovs[i].iov_base = const_cast<void *>(d.data);
-                iovs[i].iov_len = d.size;
+                struct iovec *iov = &iovs[i * kIovPerDatagram];
+                iov[0].iov_base = const_cast<void *>(d.data);
+                iov[0].iov_len = d.size;
+                for (size_t s = 0; s < d.segmentCount; s++) {
+                        const Datagram::Segment &seg = d.segments[s];
+                        if (seg.data == nullptr && seg.size != 0) {
+                                promekiWarnThrottled(5000,
+                                                     "UdpSocket::writeDatagrams null segment %zu at index %zu", s, i);
+                                return -1;
+                        }
+                        iov[1 + s].iov_base = const_cast<void *>(seg.data);
+                        iov[1 + s].iov_len = seg.size;
+                }
+                // Any unowned iov turns zero-copy off for the whole
+                // batch: the kernel could read memory the caller has
+                // already recycled.
+                if (zeroCopy && !hasZeroCopyOwners(d)) zeroCopy = false;
 
                 struct msghdr &mh = msgs[i].msg_hdr;
                 mh.msg_name = &addrs[i];
                 mh.msg_namelen = static_cast<socklen_t>(addrLen);
-                mh.msg_iov = &iovs[i];
-                mh.msg_iovlen = 1;
+                mh.msg_iov = iov;
+                mh.msg_iovlen = 1 + d.segmentCount;
 
                 if (d.txTimeNs != 0) {
                         anyTxTime = true;
@@ -215,7 +284,27 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
         }
         (void)anyTxTime;
 
-        int sent = ::sendmmsg(_fd, msgs.data(), static_cast<unsigned int>(count), 0);
+        // The error-queue watcher reaps on the event loop thread.  Hold
+        // the bookkeeping lock from here through trackZeroCopy() so a
+        // completion is never reaped before its send is tracked.
+        Mutex::Locker zcLock(_zcMutex);
+
+        // Release whatever the kernel has finished with before pinning
+        // more pages, so a steady sender holds at most a few batches.
+        if (_zeroCopy && !_zcPending.isEmpty()) (void)drainErrorQueue();
+
+        int flags = zeroCopy ? MSG_ZEROCOPY : 0;
+        int sent = ::sendmmsg(_fd, msgs.data(), static_cast<unsigned int>(count), flags);
+        if (sent < 0 && flags != 0 && errno == ENOBUFS) {
+                // The per-socket optmem budget for pinned pages is
+                // exhausted.  Send this batch the ordinary way rather
+                // than dropping it.
+                promekiWarnThrottled(5000, "UdpSocket::sendmmsg MSG_ZEROCOPY ENOBUFS (pending=%zu), copying instead",
+                                     pendingCount());
+                _zcStats.fallbacks++;
+                flags = 0;
+                sent = ::sendmmsg(_fd, msgs.data(), static_cast<unsigned int>(count), 0);
+        }
         if (sent < 0) {
                 promekiWarnThrottled(1000, "UdpSocket::sendmmsg failed (count=%zu errno=%d %s)", count, errno,
                                      strerror(errno));
@@ -225,14 +314,31 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
         if (static_cast<size_t>(sent) < count) {
                 promekiWarnThrottled(1000, "UdpSocket::sendmmsg partial: %d of %zu datagrams sent", sent, count);
         }
+        if (flags != 0) trackZeroCopy(datagrams, static_cast<size_t>(sent));
         return sent;
 #else
         // Portable fallback: loop on writeDatagram().  Returns the
         // count of datagrams accepted before the first failure.
-        int sent = 0;
+        // Scattered datagrams are gathered into a scratch buffer first.
+        int           sent = 0;
+        List<uint8_t> gather;
         for (size_t i = 0; i < datagrams.size(); i++) {
                 const Datagram &d = datagrams[i];
-                int64_t         n = writeDatagram(d.data, d.size, d.dest);
+                const void     *bytes = d.data;
+                size_t          size = d.size;
+                if (d.segmentCount > 0) {
+                        if (d.segmentCount > Datagram::MaxSegments) return sent > 0 ? sent : -1;
+                        size = d.totalSize();
+                        gather.resize(size);
+                        std::memcpy(gather.data(), d.data, d.size);
+                        size_t off = d.size;
+                        for (size_t s = 0; s < d.segmentCount; s++) {
+                                std::memcpy(gather.data() + off, d.segments[s].data, d.segments[s].size);
+                                off += d.segments[s].size;
+                        }
+                        bytes = gather.data();
+                }
+                int64_t n = writeDatagram(bytes, size, d.dest);
                 if (n < 0) {
                         return sent > 0 ? sent : -1;
                 }
@@ -242,6 +348,212 @@ int UdpSocket::writeDatagrams(const DatagramList &datagrams) {
 #endif
 }
 
+Error UdpSocket::setZeroCopy(bool enable) {
+        if (_fd < 0) return Error::NotOpen;
+#if defined(PROMEKI_PLATFORM_LINUX)
+        int val = enable ? 1 : 0;
+        if (::setsockopt(_fd, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val)) < 0) {
+                // Pre-5.0 kernels accept SO_ZEROCOPY only on TCP and
+                // report EOPNOTSUPP / ENOPROTOOPT for UDP.
+                promekiWarnOnce("UdpSocket::setZeroCopy setsockopt SO_ZEROCOPY failed (errno=%d %s)", errno,
+                                strerror(errno));
+                if (errno == EOPNOTSUPP || errno == ENOPROTOOPT) return Error::NotSupported;
+                return Error::syserr();
+        }
+        _zeroCopy = enable;
+        // Sends already in flight still need their owners; they are
+        // released as completions are reaped (or on close), so the
+        // watcher stays until close() even if zero-copy is turned off.
+        if (enable) watchErrorQueue();
+        return Error::Ok;
+#else
+        (void)enable;
+        promekiWarnOnce("UdpSocket::setZeroCopy not supported on this platform");
+        return Error::NotSupported;
+#endif
+}
+
+size_t UdpSocket::pendingZeroCopy() const {
+        Mutex::Locker lock(_zcMutex);
+        return pendingCount();
+}
+
+UdpSocket::ZeroCopyStats UdpSocket::zeroCopyStats() const {
+        Mutex::Locker lock(_zcMutex);
+        return _zcStats;
+}
+
+void UdpSocket::watchErrorQueue() {
+        if (_zcIoHandle >= 0) return;
+        EventLoop *loop = eventLoop();
+        if (loop == nullptr) {
+                promekiWarnOnce("UdpSocket::setZeroCopy: no event loop; completions are only reaped on send");
+                return;
+        }
+        // Completions raise POLLERR on the socket, so an error-only
+        // source wakes the loop without touching normal reads.
+        _zcIoHandle = loop->addIoSource(_fd, EventLoop::IoError, [this](int, uint32_t) { onErrorQueueReady(); });
+        if (_zcIoHandle >= 0) _zcLoop = loop;
+        return;
+}
+
+void UdpSocket::unwatchErrorQueue() {
+        if (_zcIoHandle >= 0 && _zcLoop != nullptr) _zcLoop->removeIoSource(_zcIoHandle);
+        _zcIoHandle = -1;
+        _zcLoop = nullptr;
+        return;
+}
+
+void UdpSocket::onErrorQueueReady() {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        Mutex::Locker lock(_zcMutex);
+        if (_fd < 0) return;
+        if (drainErrorQueue() == 0) {
+                // POLLERR with an empty error queue is a pending socket
+                // error (an ICMP unreachable, say).  Reading SO_ERROR
+                // clears it; otherwise the level-triggered wake would
+                // spin the loop.
+                int       soErr = 0;
+                socklen_t len = sizeof(soErr);
+                (void)::getsockopt(_fd, SOL_SOCKET, SO_ERROR, &soErr, &len);
+        }
+#endif
+        return;
+}
+
+size_t UdpSocket::pendingCount() const {
+        size_t total = 0;
+        for (const ZeroCopyPending &p : _zcPending) total += p.remaining;
+        return total;
+}
+
+void UdpSocket::trackZeroCopy(const DatagramList &datagrams, size_t sent) {
+        // The kernel numbers every MSG_ZEROCOPY send with a 32-bit
+        // counter that starts at 0 when SO_ZEROCOPY is enabled.  Runs
+        // of datagrams whose owners fit in one entry (typically every
+        // packet of one video frame: headers, frame and padding)
+        // collapse into a single entry holding each owner once.
+        for (size_t i = 0; i < sent; i++) {
+                const Datagram &d = datagrams[i];
+                const uint32_t  id = _zcNextId++;
+
+                const Buffer *owners[ZeroCopyPending::MaxOwners];
+                size_t        ownerCount = 0;
+                auto          addOwner = [&](const Buffer &b) {
+                        if (!b.isValid()) return;
+                        for (size_t k = 0; k < ownerCount; k++) {
+                                if (owners[k]->impl() == b.impl()) return;
+                        }
+                        owners[ownerCount++] = &b;
+                };
+                addOwner(d.dataOwner);
+                addOwner(d.segmentOwner);
+                for (size_t s = 0; s < d.segmentCount; s++) addOwner(d.segments[s].owner);
+
+                if (!_zcPending.isEmpty()) {
+                        ZeroCopyPending &back = _zcPending.back();
+                        if (back.firstId + back.count == id && mergeOwners(back, owners, ownerCount)) {
+                                back.count++;
+                                back.remaining++;
+                                continue;
+                        }
+                }
+                ZeroCopyPending p;
+                p.firstId = id;
+                p.count = 1;
+                p.remaining = 1;
+                for (size_t k = 0; k < ownerCount; k++) p.owners[k] = *owners[k];
+                p.ownerCount = ownerCount;
+                _zcPending.pushToBack(std::move(p));
+        }
+        _zcStats.sent += sent;
+        return;
+}
+
+bool UdpSocket::mergeOwners(ZeroCopyPending &run, const Buffer *const *owners, size_t count) {
+        // Owners the run does not hold yet; the run only grows if all
+        // of them fit.
+        const Buffer *missing[ZeroCopyPending::MaxOwners];
+        size_t        missingCount = 0;
+        for (size_t k = 0; k < count; k++) {
+                bool held = false;
+                for (size_t r = 0; r < run.ownerCount && !held; r++) {
+                        held = run.owners[r].impl() == owners[k]->impl();
+                }
+                if (!held) missing[missingCount++] = owners[k];
+        }
+        if (run.ownerCount + missingCount > ZeroCopyPending::MaxOwners) return false;
+        for (size_t k = 0; k < missingCount; k++) run.owners[run.ownerCount++] = *missing[k];
+        return true;
+}
+
+void UdpSocket::completeZeroCopy(uint32_t lo, uint32_t hi, bool copied) {
+        // [lo, hi] is an inclusive range of completion ids.  All
+        // arithmetic is modulo 2^32 so the ranges survive wrap.
+        const uint32_t span = hi - lo + 1;
+        size_t         done = 0;
+        for (ZeroCopyPending &p : _zcPending) {
+                uint32_t overlap = 0;
+                uint32_t s = lo - p.firstId;
+                if (s < p.count) {
+                        overlap = std::min(p.count - s, span);
+                } else {
+                        uint32_t t = p.firstId - lo;
+                        if (t < span) overlap = std::min(span - t, p.count);
+                }
+                if (overlap == 0) continue;
+                overlap = std::min(overlap, p.remaining);
+                p.remaining -= overlap;
+                done += overlap;
+        }
+        _zcPending.removeIf([](const ZeroCopyPending &p) { return p.remaining == 0; });
+        _zcStats.completed += done;
+        if (copied) _zcStats.copied += done;
+        return;
+}
+
+size_t UdpSocket::reapZeroCopyCompletions() {
+        Mutex::Locker lock(_zcMutex);
+        if (_fd < 0 || _zcPending.isEmpty()) return 0;
+        const uint64_t before = _zcStats.completed;
+        (void)drainErrorQueue();
+        return static_cast<size_t>(_zcStats.completed - before);
+}
+
+size_t UdpSocket::drainErrorQueue() {
+#if defined(PROMEKI_PLATFORM_LINUX)
+        size_t messages = 0;
+        for (;;) {
+                alignas(struct cmsghdr) uint8_t control[CMSG_SPACE(sizeof(struct sock_extended_err) +
+                                                                   sizeof(struct sockaddr_storage))];
+                struct msghdr msg;
+                std::memset(&msg, 0, sizeof(msg));
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+                if (::recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                                promekiWarnThrottled(1000, "UdpSocket::recvmsg(MSG_ERRQUEUE) failed (errno=%d %s)",
+                                                     errno, strerror(errno));
+                        }
+                        break;
+                }
+                messages++;
+                for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+                        const bool v4 = cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR;
+                        const bool v6 = cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR;
+                        if (!v4 && !v6) continue;
+                        struct sock_extended_err ee;
+                        std::memcpy(&ee, CMSG_DATA(cm), sizeof(ee));
+                        if (ee.ee_errno != 0 || ee.ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+                        completeZeroCopy(ee.ee_info, ee.ee_data, (ee.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+                }
+        }
+        return messages;
+#else
+        return 0;
+#endif
+}
+
 Error UdpSocket::setPacingRate(uint64_t bytesPerSec) {
         if (_fd < 0) return Error::NotOpen;
 #if defined(PROMEKI_PLATFORM_LINUX)
@@ -325,6 +637,66 @@ int64_t UdpSocket::readDatagram(void *data, size_t maxSize, SocketAddress *sende
         return static_cast<int64_t>(ret);
 }
 
+int UdpSocket::readDatagrams(RecvDatagramList &datagrams, bool wantSender) {
+        if (_fd < 0) {
+                promekiWarnThrottled(5000, "UdpSocket::readDatagrams on closed socket (count=%zu)", datagrams.size());
+                return -1;
+        }
+        if (datagrams.isEmpty()) return 0;
+
+#if defined(PROMEKI_PLATFORM_LINUX)
+        // Fixed-size stack scratch keeps the hot receive path free of
+        // heap traffic; MaxReadBatch bounds it.
+        const size_t            count = datagrams.size() < MaxReadBatch ? datagrams.size() : MaxReadBatch;
+        struct mmsghdr          msgs[MaxReadBatch];
+        struct iovec            iovs[MaxReadBatch];
+        struct sockaddr_storage addrs[MaxReadBatch];
+        std::memset(msgs, 0, count * sizeof(struct mmsghdr));
+        for (size_t i = 0; i < count; i++) {
+                iovs[i].iov_base = datagrams[i].data;
+                iovs[i].iov_len = datagrams[i].maxSize;
+                struct msghdr &mh = msgs[i].msg_hdr;
+                mh.msg_iov = &iovs[i];
+                mh.msg_iovlen = 1;
+                if (wantSender) {
+                        mh.msg_name = &addrs[i];
+                        mh.msg_namelen = sizeof(struct sockaddr_storage);
+                }
+        }
+
+        int got = ::recvmmsg(_fd, msgs, static_cast<unsigned int>(count), MSG_WAITFORONE, nullptr);
+        if (got < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                        promekiWarnThrottled(1000, "UdpSocket::recvmmsg failed (count=%zu errno=%d %s)", count,
+                                             errno, strerror(errno));
+                        setError(Error::syserr());
+                }
+                return -1;
+        }
+        for (int i = 0; i < got; i++) {
+                RecvDatagram &d = datagrams[i];
+                d.size = msgs[i].msg_len;
+                if (!wantSender) continue;
+                auto [addr, err] = SocketAddress::fromSockAddr(reinterpret_cast<struct sockaddr *>(&addrs[i]),
+                                                               msgs[i].msg_hdr.msg_namelen);
+                if (err.isOk()) {
+                        d.sender = addr;
+                } else {
+                        promekiWarnThrottled(5000, "UdpSocket::readDatagrams failed to decode sender (err=%s)",
+                                             err.name().cstr());
+                }
+        }
+        return got;
+#else
+        // Portable fallback: one datagram per call.
+        RecvDatagram &d = datagrams[0];
+        int64_t       n = readDatagram(d.data, d.maxSize, wantSender ? &d.sender : nullptr);
+        if (n < 0) return -1;
+        d.size = static_cast<size_t>(n);
+        return 1;
+#endif
+}
+
 Error UdpSocket::setReceivePktInfo(bool enable) {
         if (_fd < 0) return Error::NotOpen;
 #if defined(PROMEKI_PLATFORM_WINDOWS)
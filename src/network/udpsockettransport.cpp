@@ -7,6 +7,7 @@
 
 #include <promeki/udpsockettransport.h>
 #include <promeki/udpsocket.h>
+#include <promeki/logger.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
@@ -114,6 +115,16 @@ Error UdpSocketTransport::open() {
                 }
         }
 
+        if (_zeroCopy) {
+                // Zero-copy is purely an optimization — a kernel that
+                // refuses it still sends correctly on the copy path.
+                Error zcErr = _socket->setZeroCopy(true);
+                if (zcErr.isError()) {
+                        promekiWarn("UdpSocketTransport: zero-copy transmit unavailable (%s), copying instead",
+                                    zcErr.name().cstr());
+                }
+        }
+
         return Error::Ok;
 }
 
@@ -147,6 +158,14 @@ int UdpSocketTransport::sendPackets(const DatagramList &datagrams) {
                 batch[i].size = datagrams[i].size;
                 batch[i].dest = datagrams[i].dest;
                 batch[i].txTimeNs = datagrams[i].txTimeNs;
+                batch[i].segmentCount = datagrams[i].segmentCount;
+                for (size_t s = 0; s < datagrams[i].segmentCount && s < UdpSocket::Datagram::MaxSegments; s++) {
+                        batch[i].segments[s].data = datagrams[i].segments[s].data;
+                        batch[i].segments[s].size = datagrams[i].segments[s].size;
+                        batch[i].segments[s].owner = datagrams[i].segments[s].owner;
+                }
+                batch[i].dataOwner = datagrams[i].dataOwner;
+                batch[i].segmentOwner = datagrams[i].segmentOwner;
         }
         return _socket->writeDatagrams(batch);
 }
@@ -156,6 +175,28 @@ ssize_t UdpSocketTransport::receivePacket(void *data, size_t maxSize, SocketAddr
         return _socket->readDatagram(data, maxSize, sender);
 }
 
+int UdpSocketTransport::receivePackets(RecvDatagramList &packets, bool wantSender) {
+        if (!isOpen()) return -1;
+        if (packets.isEmpty()) return 0;
+
+        // Same layout-translation story as sendPackets(), except the
+        // scratch list is a member: this runs once per recvmmsg() on
+        // the RTP receive thread and must not allocate.
+        const size_t count = packets.size() < UdpSocket::MaxReadBatch ? packets.size() : UdpSocket::MaxReadBatch;
+        if (_recvScratch.size() != count) _recvScratch.resize(count);
+        for (size_t i = 0; i < count; i++) {
+                _recvScratch[i].data = packets[i].data;
+                _recvScratch[i].maxSize = packets[i].maxSize;
+                _recvScratch[i].size = 0;
+        }
+        int got = _socket->readDatagrams(_recvScratch, wantSender);
+        for (int i = 0; i < got; i++) {
+                packets[i].size = _recvScratch[i].size;
+                if (wantSender) packets[i].sender = _recvScratch[i].sender;
+        }
+        return got;
+}
+
 Error UdpSocketTransport::setPacingRate(uint64_t bytesPerSec) {
         if (!isOpen()) return Error::NotOpen;
         return _socket->setPacingRate(bytesPerSec);
@@ -166,4 +207,14 @@ Error UdpSocketTransport::setTxTime(bool enable) {
         return _socket->setTxTime(enable);
 }
 
+Error UdpSocketTransport::setZeroCopy(bool enable) {
+        _zeroCopy = enable;
+        if (!isOpen()) return Error::Ok;
+        return _socket->setZeroCopy(enable);
+}
+
+bool UdpSocketTransport::isZeroCopy() const {
+        return isOpen() && _socket->isZeroCopy();
+}
+
 PROMEKI_NAMESPACE_END
@@ -18,9 +18,11 @@ PROMEKI_NAMESPACE_BEGIN
 // Lifecycle
 // ---------------------------------------------------------------------------
 
-AudioBuffer::AudioBuffer(const AudioDesc &format) : _format(format), _inputFormat(format) {}
+AudioBuffer::AudioBuffer(const AudioDesc &format)
+    : _format(format), _inputFormat(format), _frameBytes(format.isValid() ? format.bytesPerSampleStride() : 0),
+      _frameRate(format.sampleRate()) {}
 
-AudioBuffer::AudioBuffer(const AudioDesc &format, size_t capacity) : _format(format), _inputFormat(format) {
+AudioBuffer::AudioBuffer(const AudioDesc &format, size_t capacity) : AudioBuffer(format) {
         reserve(capacity);
 }
 
@@ -36,7 +38,11 @@ AudioBuffer::AudioBuffer(AudioBuffer &&other) noexcept
       _driftEnabled(other._driftEnabled), _driftTarget(other._driftTarget), _driftGain(other._driftGain),
       _driftRatio(other._driftRatio), _driftIntegral(other._driftIntegral)
 #endif
-{
+      ,
+      _mode(other._mode), _frameBytes(other._frameBytes), _frameRate(other._frameRate),
+      _spscAnchors(std::move(other._spscAnchors)), _spscWritePos(other._spscWritePos.value()),
+      _spscAnchorWrite(other._spscAnchorWrite.value()), _spscReadPos(other._spscReadPos.value()),
+      _spscAnchorRead(other._spscAnchorRead.value()) {
         other._capacity = 0;
         other._head = 0;
         other._tail = 0;
@@ -51,6 +57,11 @@ AudioBuffer::AudioBuffer(AudioBuffer &&other) noexcept
         other._driftRatio = 1.0;
         other._driftIntegral = 0.0;
 #endif
+        other._mode = Mode::Locked;
+        other._spscWritePos.setValue(0);
+        other._spscAnchorWrite.setValue(0);
+        other._spscReadPos.setValue(0);
+        other._spscAnchorRead.setValue(0);
 }
 
 AudioBuffer &AudioBuffer::operator=(AudioBuffer &&other) noexcept {
@@ -90,6 +101,19 @@ AudioBuffer &AudioBuffer::operator=(AudioBuffer &&other) noexcept {
         other._outputProducedTotal = 0;
         other._outputConsumedTotal = 0;
         other._resamplerSampleDelta = 0;
+        _mode = other._mode;
+        _frameBytes = other._frameBytes;
+        _frameRate = other._frameRate;
+        _spscAnchors = std::move(other._spscAnchors);
+        _spscWritePos.setValue(other._spscWritePos.value());
+        _spscAnchorWrite.setValue(other._spscAnchorWrite.value());
+        _spscReadPos.setValue(other._spscReadPos.value());
+        _spscAnchorRead.setValue(other._spscAnchorRead.value());
+        other._mode = Mode::Locked;
+        other._spscWritePos.setValue(0);
+        other._spscAnchorWrite.setValue(0);
+        other._spscReadPos.setValue(0);
+        other._spscAnchorRead.setValue(0);
         return *this;
 }
 
@@ -97,15 +121,22 @@ void AudioBuffer::setFormat(const AudioDesc &format) {
         Mutex::Locker lock(_mutex);
         _format = format;
         _inputFormat = format;
-        _head = 0;
-        _tail = 0;
-        _count = 0;
+        _frameBytes = format.isValid() ? format.bytesPerSampleStride() : 0;
+        _frameRate = format.sampleRate();
         _storage = Buffer();
         _capacity = 0;
-        _anchors = Deque<Anchor>();
-        _outputProducedTotal = 0;
-        _outputConsumedTotal = 0;
-        _resamplerSampleDelta = 0;
+        resetRingLocked();
+}
+
+Error AudioBuffer::setMode(Mode mode) {
+        if (mode != Mode::Locked && mode != Mode::Spsc) return Error::InvalidArgument;
+        Mutex::Locker lock(_mutex);
+        // The anchor ring is sized once here so the producer never
+        // reallocates storage the consumer may be reading.
+        if (mode == Mode::Spsc && _spscAnchors.size() != SpscAnchorSlots) _spscAnchors.resize(SpscAnchorSlots);
+        _mode = mode;
+        resetRingLocked();
+        return Error::Ok;
 }
 
 void AudioBuffer::setInputFormat(const AudioDesc &input) {
@@ -117,7 +148,18 @@ void AudioBuffer::setInputFormat(const AudioDesc &input) {
         // stay where they are so any already-buffered samples retain
         // their indices and any future anchor naturally lines up
         // with the next sample to be produced.
-        _anchors = Deque<Anchor>();
+        //
+        // The SPSC anchor ring belongs half to the consumer, so it
+        // can't be emptied from here; an anchor with an invalid PTS
+        // ends the previous timeline at the next produced sample
+        // instead.
+        if (_mode == Mode::Spsc) {
+                Anchor end;
+                end.outputIndex = _outputProducedTotal;
+                appendAnchorLocked(end);
+        } else {
+                _anchors = Deque<Anchor>();
+        }
         _resamplerSampleDelta = 0;
 #if PROMEKI_ENABLE_SRC
         if (_resampler.isValid()) _resampler.reset();
@@ -195,8 +237,8 @@ double AudioBuffer::computeRatio(const AudioDesc &srcFormat) {
         double nominal = static_cast<double>(_format.sampleRate()) / static_cast<double>(srcFormat.sampleRate());
         if (!_driftEnabled || _driftTarget == 0) return nominal;
 
-        double error =
-                (static_cast<double>(_count) - static_cast<double>(_driftTarget)) / static_cast<double>(_driftTarget);
+        double error = (static_cast<double>(fillLocked()) - static_cast<double>(_driftTarget)) /
+                       static_cast<double>(_driftTarget);
 
         // PI controller: integral accumulates error to eliminate
         // steady-state offset from constant clock drift.
@@ -222,6 +264,39 @@ size_t AudioBuffer::bytesPerSample() const {
         return _format.bytesPerSampleStride();
 }
 
+size_t AudioBuffer::fillLocked() const {
+        if (_mode == Mode::Locked) return _count;
+        // The acquire load of the read position orders the
+        // consumer's copy-out before any overwrite of those slots.
+        return static_cast<size_t>(_outputProducedTotal - _spscReadPos.value());
+}
+
+void AudioBuffer::advanceTail(size_t samples) {
+        _tail = (_tail + samples) % _capacity;
+        if (_mode == Mode::Locked) _count += samples;
+        return;
+}
+
+void AudioBuffer::publishLocked() {
+        if (_mode == Mode::Spsc) _spscWritePos.setValue(_outputProducedTotal);
+        return;
+}
+
+void AudioBuffer::resetRingLocked() {
+        _head = 0;
+        _tail = 0;
+        _count = 0;
+        _anchors = Deque<Anchor>();
+        _outputProducedTotal = 0;
+        _outputConsumedTotal = 0;
+        _resamplerSampleDelta = 0;
+        _spscWritePos.setValue(0);
+        _spscAnchorWrite.setValue(0);
+        _spscReadPos.setValue(0);
+        _spscAnchorRead.setValue(0);
+        return;
+}
+
 // ---------------------------------------------------------------------------
 // Remap / gain / meter configuration
 // ---------------------------------------------------------------------------
@@ -272,12 +347,35 @@ Error AudioBuffer::reserve(size_t samples) {
         Mutex::Locker lock(_mutex);
         if (!_format.isValid()) return Error::InvalidArgument;
         if (samples <= _capacity) return Error::Ok;
-        if (samples < _count) return Error::InvalidArgument;
+        if (samples < fillLocked()) return Error::InvalidArgument;
 
         size_t bps = bytesPerSample();
         Buffer newStorage(samples * bps);
         if (!newStorage.isValid()) return Error::NoMem;
 
+        if (_mode == Mode::Spsc) {
+                // SPSC slots are addressed by absolute position modulo
+                // capacity, so buffered samples move to their slots in
+                // the new ring rather than being linearized at 0.
+                uint8_t       *dst = static_cast<uint8_t *>(newStorage.data());
+                const uint8_t *src = static_cast<const uint8_t *>(_storage.data());
+                uint64_t       pos = _spscReadPos.value();
+                while (pos < _outputProducedTotal) {
+                        const size_t srcSlot = static_cast<size_t>(pos % _capacity);
+                        const size_t dstSlot = static_cast<size_t>(pos % samples);
+                        size_t       chunk = static_cast<size_t>(_outputProducedTotal - pos);
+                        if (chunk > _capacity - srcSlot) chunk = _capacity - srcSlot;
+                        if (chunk > samples - dstSlot) chunk = samples - dstSlot;
+                        std::memcpy(dst + dstSlot * bps, src + srcSlot * bps, chunk * bps);
+                        pos += chunk;
+                }
+                newStorage.setSize(samples * bps);
+                _storage = std::move(newStorage);
+                _capacity = samples;
+                _tail = static_cast<size_t>(_outputProducedTotal % samples);
+                return Error::Ok;
+        }
+
         // Linearize existing contents into the new storage at index 0.
         uint8_t *dst = static_cast<uint8_t *>(newStorage.data());
         if (_count > 0) {
@@ -294,13 +392,7 @@ Error AudioBuffer::reserve(size_t samples) {
 
 void AudioBuffer::clear() {
         Mutex::Locker lock(_mutex);
-        _head = 0;
-        _tail = 0;
-        _count = 0;
-        _anchors = Deque<Anchor>();
-        _outputProducedTotal = 0;
-        _outputConsumedTotal = 0;
-        _resamplerSampleDelta = 0;
+        resetRingLocked();
 }
 
 // ---------------------------------------------------------------------------
@@ -326,7 +418,21 @@ void AudioBuffer::layAnchorLocked(uint64_t outputIndex, const MediaTimeStamp &pt
                 }
         }
 #endif
-        _anchors.pushToBack(a);
+        appendAnchorLocked(a);
+}
+
+void AudioBuffer::appendAnchorLocked(const Anchor &anchor) {
+        if (_mode == Mode::Locked) {
+                _anchors.pushToBack(anchor);
+                return;
+        }
+        // The slot is published before the samples it covers, so a
+        // consumer that sees those samples always sees their anchor.
+        const uint64_t w = _spscAnchorWrite.load(MemoryOrder::Relaxed);
+        if (w - _spscAnchorRead.value() >= SpscAnchorSlots) return;
+        _spscAnchors[static_cast<size_t>(w % SpscAnchorSlots)] = anchor;
+        _spscAnchorWrite.setValue(w + 1);
+        return;
 }
 
 MediaTimeStamp AudioBuffer::ptsAtOutputIndexLocked(uint64_t outputIndex) const {
@@ -343,7 +449,7 @@ MediaTimeStamp AudioBuffer::ptsAtOutputIndexLocked(uint64_t outputIndex) const {
                         break;
                 }
         }
-        if (active == nullptr) return MediaTimeStamp();
+        if (active == nullptr || !active->pts.isValid()) return MediaTimeStamp();
         const uint64_t offset = outputIndex - active->outputIndex;
         if (offset == 0) return active->pts;
         Duration       step = Duration::fromSamples(static_cast<int64_t>(offset), _format.sampleRate());
@@ -379,8 +485,7 @@ void AudioBuffer::writeBytesAtTail(const uint8_t *data, size_t samples) {
         if (remainder > 0) {
                 std::memcpy(base, data + firstChunk * bps, remainder * bps);
         }
-        _tail = (_tail + samples) % _capacity;
-        _count += samples;
+        advanceTail(samples);
 }
 
 void AudioBuffer::readBytesFromHead(uint8_t *dst, size_t samples, size_t skip) const {
@@ -424,7 +529,7 @@ Error AudioBuffer::resampleAndPush(const float *nativeData, size_t samples,
         size_t estOutput = static_cast<size_t>(static_cast<double>(samples) * ratio + 32.0);
 
         // Check capacity before allocating.
-        if (_capacity - _count < estOutput) return Error::NoSpace;
+        if (freeLocked() < estOutput) return Error::NoSpace;
 
         // Allocate scratch for resampled native-float output.
         size_t       totalFloats = estOutput * _format.channels();
@@ -445,7 +550,7 @@ Error AudioBuffer::resampleAndPush(const float *nativeData, size_t samples,
 
         size_t outSamples = static_cast<size_t>(outputGen);
         if (outSamples > 0) {
-                if (_capacity - _count < outSamples) return Error::NoSpace;
+                if (freeLocked() < outSamples) return Error::NoSpace;
 
                 if (_format.isNative()) {
                         // Direct write: resampled float -> ring.
@@ -465,8 +570,7 @@ Error AudioBuffer::resampleAndPush(const float *nativeData, size_t samples,
                         if (remainder > 0) {
                                 _format.floatToSamples(base, scratch + firstChunk * _format.channels(), remainder);
                         }
-                        _tail = (_tail + outSamples) % _capacity;
-                        _count += outSamples;
+                        advanceTail(outSamples);
                 }
         }
 
@@ -575,7 +679,7 @@ Error AudioBuffer::pushLocked(const void *data, size_t samples, const AudioDesc
         }
 #endif
 
-        if (_capacity - _count < samples) return Error::NoSpace;
+        if (freeLocked() < samples) return Error::NoSpace;
 
         // Same-rate path: input frames map one-to-one onto output
         // frames, so lay the anchor at the next-produced index now —
@@ -668,8 +772,7 @@ Error AudioBuffer::pushLocked(const void *data, size_t samples, const AudioDesc
                                                                   channels, floatScratch);
                         if (err.isError()) return err;
                 }
-                _tail = (_tail + samples) % _capacity;
-                _count += samples;
+                advanceTail(samples);
                 _outputProducedTotal += samples;
                 outputSamples = samples;
                 return Error::Ok;
@@ -775,8 +878,7 @@ Error AudioBuffer::pushLocked(const void *data, size_t samples, const AudioDesc
                 _format.floatToSamples(base, outFloat + firstChunkSamples * outChannels, remainderSamples);
         }
 
-        _tail = (_tail + samples) % _capacity;
-        _count += samples;
+        advanceTail(samples);
         _outputProducedTotal += samples;
         outputSamples = samples;
 
@@ -794,6 +896,70 @@ size_t AudioBuffer::popLocked(void *dst, size_t samples) {
         return toRead;
 }
 
+// ---------------------------------------------------------------------------
+// SPSC consumer side — never locks, never allocates
+// ---------------------------------------------------------------------------
+
+size_t AudioBuffer::spscAvailable() const {
+        const uint64_t read = _spscReadPos.value();
+        return static_cast<size_t>(_spscWritePos.value() - read);
+}
+
+void AudioBuffer::spscCopyOut(uint8_t *dst, uint64_t position, size_t samples) const {
+        if (samples == 0) return;
+        const uint8_t *base = static_cast<const uint8_t *>(_storage.data());
+        const size_t   start = static_cast<size_t>(position % _capacity);
+        size_t         firstChunk = samples;
+        if (start + samples > _capacity) firstChunk = _capacity - start;
+        std::memcpy(dst, base + start * _frameBytes, firstChunk * _frameBytes);
+        const size_t remainder = samples - firstChunk;
+        if (remainder > 0) std::memcpy(dst + firstChunk * _frameBytes, base, remainder * _frameBytes);
+        return;
+}
+
+MediaTimeStamp AudioBuffer::spscPtsAt(uint64_t outputIndex) const {
+        const uint64_t read = _spscAnchorRead.load(MemoryOrder::Relaxed);
+        const uint64_t write = _spscAnchorWrite.value();
+        for (uint64_t i = write; i > read; --i) {
+                const Anchor &a = _spscAnchors[static_cast<size_t>((i - 1) % SpscAnchorSlots)];
+                if (a.outputIndex > outputIndex) continue;
+                if (!a.pts.isValid()) return MediaTimeStamp();
+                const uint64_t offset = outputIndex - a.outputIndex;
+                if (offset == 0) return a.pts;
+                MediaTimeStamp result = a.pts;
+                result.setTimeStamp(result.timeStamp() +
+                                    Duration::fromSamples(static_cast<int64_t>(offset), _frameRate));
+                return result;
+        }
+        return MediaTimeStamp();
+}
+
+void AudioBuffer::spscConsume(uint64_t position, size_t samples) {
+        const uint64_t consumed = position + samples;
+        // Release the slots back to the producer before pruning so
+        // it can refill while the anchors are walked.
+        _spscReadPos.setValue(consumed);
+        uint64_t       read = _spscAnchorRead.load(MemoryOrder::Relaxed);
+        const uint64_t write = _spscAnchorWrite.value();
+        while (write - read >= 2 &&
+               _spscAnchors[static_cast<size_t>((read + 1) % SpscAnchorSlots)].outputIndex <= consumed) {
+                ++read;
+        }
+        _spscAnchorRead.setValue(read);
+        return;
+}
+
+AudioBuffer::PopResult AudioBuffer::spscPop(void *dst, size_t samples, MediaTimeStamp *firstSamplePts) {
+        const uint64_t read = _spscReadPos.load(MemoryOrder::Relaxed);
+        const size_t   count = static_cast<size_t>(_spscWritePos.value() - read);
+        if (firstSamplePts != nullptr) *firstSamplePts = spscPtsAt(read);
+        if (count == 0 || samples == 0 || dst == nullptr) return makeResult<size_t>(0);
+        const size_t toRead = samples > count ? count : samples;
+        spscCopyOut(static_cast<uint8_t *>(dst), read, toRead);
+        spscConsume(read, toRead);
+        return makeResult(toRead);
+}
+
 // ---------------------------------------------------------------------------
 // Push (public, locked)
 // ---------------------------------------------------------------------------
@@ -803,7 +969,10 @@ Error AudioBuffer::push(const void *data, size_t samples, const AudioDesc &srcFo
         Mutex::Locker lock(_mutex);
         size_t        produced = 0;
         Error         err = pushLocked(data, samples, srcFormat, pts, produced);
-        if (err.isOk() && produced > 0) _cv.wakeOne();
+        if (err.isOk() && produced > 0) {
+                publishLocked();
+                _cv.wakeOne();
+        }
         return err;
 }
 
@@ -815,7 +984,10 @@ Error AudioBuffer::pushSilence(size_t samples, const MediaTimeStamp &pts) {
         Error err = pushSilenceLocked(samples);
         if (err.isOk()) {
                 _outputProducedTotal += samples;
-                if (samples > 0) _cv.wakeOne();
+                if (samples > 0) {
+                        publishLocked();
+                        _cv.wakeOne();
+                }
         }
         return err;
 }
@@ -823,7 +995,7 @@ Error AudioBuffer::pushSilence(size_t samples, const MediaTimeStamp &pts) {
 Error AudioBuffer::pushSilenceLocked(size_t samples) {
         if (!_format.isValid()) return Error::InvalidArgument;
         if (samples == 0) return Error::Ok;
-        if (_capacity - _count < samples) return Error::NoSpace;
+        if (freeLocked() < samples) return Error::NoSpace;
 
         // The format-correct silence value is whatever
         // floatToSamples(0.0f) produces — that's @c 0 for signed and
@@ -853,8 +1025,7 @@ Error AudioBuffer::pushSilenceLocked(size_t samples) {
 
                 _format.floatToSamples(base + _tail * bps, stackBuf, chunk);
 
-                _tail = (_tail + chunk) % _capacity;
-                _count += chunk;
+                advanceTail(chunk);
                 remaining -= chunk;
         }
         return Error::Ok;
@@ -865,6 +1036,7 @@ Error AudioBuffer::pushSilenceLocked(size_t samples) {
 // ---------------------------------------------------------------------------
 
 AudioBuffer::PopResult AudioBuffer::pop(void *dst, size_t samples, MediaTimeStamp *firstSamplePts) {
+        if (_mode == Mode::Spsc) return spscPop(dst, samples, firstSamplePts);
         Mutex::Locker lock(_mutex);
         if (firstSamplePts != nullptr) {
                 *firstSamplePts = ptsAtOutputIndexLocked(_outputConsumedTotal);
@@ -879,6 +1051,16 @@ AudioBuffer::PopResult AudioBuffer::pop(void *dst, size_t samples, MediaTimeStam
 
 AudioBuffer::PopResult AudioBuffer::popWait(void *dst, size_t samples, unsigned int timeoutMs,
                                             MediaTimeStamp *firstSamplePts) {
+        if (_mode == Mode::Spsc) {
+                // Only the wait touches the mutex; the producer
+                // publishes and signals under it, so no wake is lost.
+                if (spscAvailable() < samples) {
+                        Mutex::Locker lock(_mutex);
+                        Error waitErr = _cv.wait(_mutex, [&]() { return spscAvailable() >= samples; }, timeoutMs);
+                        if (waitErr != Error::Ok) return PopResult(0, waitErr);
+                }
+                return spscPop(dst, samples, firstSamplePts);
+        }
         Mutex::Locker lock(_mutex);
         if (_count < samples) {
                 Error waitErr = _cv.wait(_mutex, [&]() { return _count >= samples; }, timeoutMs);
@@ -897,6 +1079,15 @@ AudioBuffer::PopResult AudioBuffer::popWait(void *dst, size_t samples, unsigned
 
 AudioBuffer::PopResult AudioBuffer::peek(void *dst, size_t samples,
                                          MediaTimeStamp *firstSamplePts) const {
+        if (_mode == Mode::Spsc) {
+                const uint64_t read = _spscReadPos.load(MemoryOrder::Relaxed);
+                const size_t   count = static_cast<size_t>(_spscWritePos.value() - read);
+                if (firstSamplePts != nullptr) *firstSamplePts = (count > 0) ? spscPtsAt(read) : MediaTimeStamp();
+                if (count == 0 || samples == 0 || dst == nullptr) return makeResult<size_t>(0);
+                const size_t toRead = samples > count ? count : samples;
+                spscCopyOut(static_cast<uint8_t *>(dst), read, toRead);
+                return makeResult(toRead);
+        }
         Mutex::Locker lock(_mutex);
         if (firstSamplePts != nullptr) {
                 *firstSamplePts = (_count > 0) ? ptsAtOutputIndexLocked(_outputConsumedTotal)
@@ -909,6 +1100,14 @@ AudioBuffer::PopResult AudioBuffer::peek(void *dst, size_t samples,
 }
 
 AudioBuffer::PopResult AudioBuffer::drop(size_t samples) {
+        if (_mode == Mode::Spsc) {
+                const uint64_t read = _spscReadPos.load(MemoryOrder::Relaxed);
+                const size_t   count = static_cast<size_t>(_spscWritePos.value() - read);
+                if (count == 0 || samples == 0) return makeResult<size_t>(0);
+                const size_t toDrop = samples > count ? count : samples;
+                spscConsume(read, toDrop);
+                return makeResult(toDrop);
+        }
         Mutex::Locker lock(_mutex);
         if (_count == 0 || samples == 0) return makeResult<size_t>(0);
         size_t toDrop = samples > _count ? _count : samples;
@@ -947,10 +1146,34 @@ static PcmAudioPayload::Ptr buildPopPayload(const AudioDesc &format, Buffer &&bu
         return out;
 }
 
+Result<PcmAudioPayload::Ptr> AudioBuffer::spscPopPayload(size_t maxSamples) {
+        // Snapshot the descriptor first — the producer may be
+        // rewriting its channel map under the mutex.
+        const AudioDesc format = this->format();
+        if (!format.isValid()) return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::InvalidArgument);
+        const size_t count = spscAvailable();
+        const size_t want = (count < maxSamples) ? count : maxSamples;
+        const size_t stride = _frameBytes;
+        Buffer       payloadBuf(want * stride);
+        if (want > 0 && !payloadBuf.isValid()) {
+                return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::NoMem);
+        }
+        payloadBuf.setSize(want * stride);
+        MediaTimeStamp firstPts;
+        const size_t   got = (want > 0) ? value(spscPop(payloadBuf.data(), want, &firstPts)) : 0;
+        return makeResult(buildPopPayload(format, std::move(payloadBuf), got, firstPts));
+}
+
 Result<PcmAudioPayload::Ptr> AudioBuffer::popPayload(size_t minSamples, size_t maxSamples) {
         if (maxSamples == 0 || minSamples > maxSamples) {
                 return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::InvalidArgument);
         }
+        if (_mode == Mode::Spsc) {
+                if (spscAvailable() < minSamples) {
+                        return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::TryAgain);
+                }
+                return spscPopPayload(maxSamples);
+        }
         Mutex::Locker lock(_mutex);
         if (!_format.isValid()) {
                 return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::InvalidArgument);
@@ -979,6 +1202,17 @@ Result<PcmAudioPayload::Ptr> AudioBuffer::popWaitPayload(size_t minSamples, size
         if (maxSamples == 0 || minSamples > maxSamples) {
                 return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::InvalidArgument);
         }
+        if (_mode == Mode::Spsc) {
+                if (spscAvailable() < minSamples) {
+                        Mutex::Locker lock(_mutex);
+                        Error waitErr = _cv.wait(_mutex, [&]() { return spscAvailable() >= minSamples; },
+                                                 timeoutMs);
+                        if (waitErr != Error::Ok) {
+                                return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), waitErr);
+                        }
+                }
+                return spscPopPayload(maxSamples);
+        }
         Mutex::Locker lock(_mutex);
         if (!_format.isValid()) {
                 return Result<PcmAudioPayload::Ptr>(PcmAudioPayload::Ptr(), Error::InvalidArgument);
@@ -1010,6 +1244,11 @@ Result<PcmAudioPayload::Ptr> AudioBuffer::popWaitPayload(size_t minSamples, size
 // ---------------------------------------------------------------------------
 
 MediaTimeStamp AudioBuffer::nextSamplePts() const {
+        if (_mode == Mode::Spsc) {
+                const uint64_t read = _spscReadPos.load(MemoryOrder::Relaxed);
+                if (_spscWritePos.value() == read) return MediaTimeStamp();
+                return spscPtsAt(read);
+        }
         Mutex::Locker lock(_mutex);
         if (_count == 0) return MediaTimeStamp();
         return ptsAtOutputIndexLocked(_outputConsumedTotal);
@@ -13,6 +13,10 @@
 #include <promeki/map.h>
 #include <promeki/pair.h>
 
+#if PROMEKI_ENABLE_CSC
+#include "audiokernels.h"
+#endif
+
 PROMEKI_NAMESPACE_BEGIN
 
 // ---------------------------------------------------------------------------
@@ -171,6 +175,76 @@ static void floatToS24In32(uint8_t *out, const float *in, size_t samples) {
         }
 }
 
+// ---------------------------------------------------------------------------
+// SIMD kernels — fixed-signature adapters around the Highway-dispatched
+// kernels in audiokernels.cpp.  Each one is bit-identical to the scalar
+// function it shadows; the registry attaches them beside the scalar
+// pointers and AudioFormat picks one per call based on isSimdEnabled().
+// The byte-pattern kernels assume little-endian lanes, so they are only
+// attached on little-endian hosts, where "swap" means "big-endian data".
+// ---------------------------------------------------------------------------
+
+#if PROMEKI_ENABLE_CSC
+
+static constexpr bool SimdKernelsAvailable = System::isLittleEndian();
+
+// Sign-bit mask for a sample whose top byte sits at memory index @p HiByte.
+template <typename T, size_t HiByte> static constexpr T signMask() {
+        return static_cast<T>(T(0x80) << (8 * HiByte));
+}
+
+template <bool BigEndian> static void simdFloat32ToFloat(float *out, const uint8_t *in, size_t samples) {
+        audiokernels::float32ToFloat(out, in, samples, BigEndian);
+}
+
+template <bool BigEndian> static void simdFloatToFloat32(uint8_t *out, const float *in, size_t samples) {
+        audiokernels::floatToFloat32(out, in, samples, BigEndian);
+}
+
+template <typename IntType, bool BigEndian>
+static void simdIntToFloat(float *out, const uint8_t *in, size_t samples) {
+        constexpr bool isSigned = std::is_signed_v<IntType>;
+        if constexpr (sizeof(IntType) == 1) {
+                audiokernels::int8ToFloat(out, in, samples, isSigned);
+        } else if constexpr (sizeof(IntType) == 2) {
+                audiokernels::int16ToFloat(out, in, samples, isSigned, BigEndian);
+        } else {
+                audiokernels::int32ToFloat(out, in, samples, isSigned, BigEndian);
+        }
+}
+
+template <typename IntType, bool BigEndian>
+static void simdFloatToInt(uint8_t *out, const float *in, size_t samples) {
+        constexpr bool isSigned = std::is_signed_v<IntType>;
+        if constexpr (sizeof(IntType) == 1) {
+                audiokernels::floatToInt8(out, in, samples, isSigned);
+        } else if constexpr (sizeof(IntType) == 2) {
+                audiokernels::floatToInt16(out, in, samples, isSigned, BigEndian);
+        } else {
+                audiokernels::floatToInt32(out, in, samples, isSigned, BigEndian);
+        }
+}
+
+template <bool SignedRange, bool BigEndian> static void simdS24ToFloat(float *out, const uint8_t *in, size_t samples) {
+        audiokernels::int24ToFloat(out, in, samples, SignedRange, BigEndian);
+}
+
+template <bool SignedRange, bool BigEndian> static void simdFloatToS24(uint8_t *out, const float *in, size_t samples) {
+        audiokernels::floatToInt24(out, in, samples, SignedRange, BigEndian);
+}
+
+template <bool SignedRange, bool BigEndian, bool HighBytes>
+static void simdS24In32ToFloat(float *out, const uint8_t *in, size_t samples) {
+        audiokernels::int24In32ToFloat(out, in, samples, SignedRange, BigEndian, HighBytes);
+}
+
+template <bool SignedRange, bool BigEndian, bool HighBytes>
+static void simdFloatToS24In32(uint8_t *out, const float *in, size_t samples) {
+        audiokernels::floatToInt24In32(out, in, samples, SignedRange, BigEndian, HighBytes);
+}
+
+#endif // PROMEKI_ENABLE_CSC
+
 // ---------------------------------------------------------------------------
 // Factory functions for well-known formats
 // ---------------------------------------------------------------------------
@@ -198,6 +272,12 @@ static AudioFormat::Data makePCMI_Float32LE() {
         d.isBigEndian = false;
         d.samplesToFloat = float32LEToFloat;
         d.floatToSamples = floatToFloat32LE;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdFloat32ToFloat<false>;
+                d.floatToSamplesSimd = simdFloatToFloat32<false>;
+        }
+#endif
         return d;
 }
 
@@ -214,6 +294,12 @@ static AudioFormat::Data makePCMI_Float32BE() {
         d.isBigEndian = true;
         d.samplesToFloat = float32BEToFloat;
         d.floatToSamples = floatToFloat32BE;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdFloat32ToFloat<true>;
+                d.floatToSamplesSimd = simdFloatToFloat32<true>;
+        }
+#endif
         return d;
 }
 
@@ -227,6 +313,12 @@ static AudioFormat::Data makePCMI_S8() {
         d.isSigned = true;
         d.samplesToFloat = AudioFormat::samplesToFloatImpl<int8_t, false>;
         d.floatToSamples = AudioFormat::floatToSamplesImpl<int8_t, false>;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdIntToFloat<int8_t, false>;
+                d.floatToSamplesSimd = simdFloatToInt<int8_t, false>;
+        }
+#endif
         return d;
 }
 
@@ -239,6 +331,12 @@ static AudioFormat::Data makePCMI_U8() {
         d.bitsPerSample = 8;
         d.samplesToFloat = AudioFormat::samplesToFloatImpl<uint8_t, false>;
         d.floatToSamples = AudioFormat::floatToSamplesImpl<uint8_t, false>;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdIntToFloat<uint8_t, false>;
+                d.floatToSamplesSimd = simdFloatToInt<uint8_t, false>;
+        }
+#endif
         return d;
 }
 
@@ -254,6 +352,12 @@ static AudioFormat::Data makePCMI_Int(AudioFormat::ID id, const char *name, cons
         d.isBigEndian = BigEndian;
         d.samplesToFloat = AudioFormat::samplesToFloatImpl<IntType, BigEndian>;
         d.floatToSamples = AudioFormat::floatToSamplesImpl<IntType, BigEndian>;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdIntToFloat<IntType, BigEndian>;
+                d.floatToSamplesSimd = simdFloatToInt<IntType, BigEndian>;
+        }
+#endif
         return d;
 }
 
@@ -269,6 +373,12 @@ static AudioFormat::Data makePCMI_24(AudioFormat::ID id, const char *name, const
         d.isBigEndian = BigEndian;
         d.samplesToFloat = s24ToFloat<SignedRange, BigEndian>;
         d.floatToSamples = floatToS24<SignedRange, BigEndian>;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdS24ToFloat<SignedRange, BigEndian>;
+                d.floatToSamplesSimd = simdFloatToS24<SignedRange, BigEndian>;
+        }
+#endif
         return d;
 }
 
@@ -284,6 +394,12 @@ static AudioFormat::Data makePCMI_24In32(AudioFormat::ID id, const char *name, c
         d.isBigEndian = BigEndian;
         d.samplesToFloat = s24In32ToFloat<SignedRange, BigEndian, HighBytes>;
         d.floatToSamples = floatToS24In32<SignedRange, BigEndian, HighBytes>;
+#if PROMEKI_ENABLE_CSC
+        if constexpr (SimdKernelsAvailable) {
+                d.samplesToFloatSimd = simdS24In32ToFloat<SignedRange, BigEndian, HighBytes>;
+                d.floatToSamplesSimd = simdFloatToS24In32<SignedRange, BigEndian, HighBytes>;
+        }
+#endif
         return d;
 }
 
@@ -540,9 +656,90 @@ static void direct_BE_LB32_to_24BE(void *out, const void *in, size_t samples) {
         }
 }
 
+// SIMD variants of the direct kernels above (see the SIMD section near the
+// top of this file).  Only attached on little-endian hosts.
+
+#if PROMEKI_ENABLE_CSC
+
+template <uint8_t Mask> static void simdXor8(void *out, const void *in, size_t samples) {
+        audiokernels::xor8(out, in, samples, Mask);
+}
+
+template <bool Swap, uint16_t Mask> static void simdSwapXor16(void *out, const void *in, size_t samples) {
+        audiokernels::swapXor16(out, in, samples, Swap, Mask);
+}
+
+template <bool Swap, uint32_t Mask> static void simdSwapXor32(void *out, const void *in, size_t samples) {
+        audiokernels::swapXor32(out, in, samples, Swap, Mask);
+}
+
+template <bool Swap, int XorByte> static void simdSwapXor24(void *out, const void *in, size_t samples) {
+        audiokernels::swapXor24(out, in, samples, Swap, XorByte);
+}
+
+template <bool Left> static void simdShift32(void *out, const void *in, size_t samples) {
+        audiokernels::shift32(out, in, samples, Left);
+}
+
+template <bool PadFirst> static void simdExpand24To32(void *out, const void *in, size_t samples) {
+        audiokernels::expand24To32(out, in, samples, PadFirst);
+}
+
+template <bool DropFirst> static void simdCompact32To24(void *out, const void *in, size_t samples) {
+        audiokernels::compact32To24(out, in, samples, DropFirst);
+}
+
+// Scalar direct kernel → SIMD equivalent.  Identity copies stay on
+// memcpy, which is already as wide as the hardware allows.
+struct SimdDirectPair {
+                AudioFormat::DirectConvertFn scalar;
+                AudioFormat::DirectConvertFn simd;
+};
+
+static const SimdDirectPair simdDirectPairs[] = {
+        {directSignFlip<1, 0>, simdXor8<0x80>},
+        {directEndianSwap<2>, simdSwapXor16<true, 0>},
+        {directSignFlip<2, 0>, simdSwapXor16<false, signMask<uint16_t, 0>()>},
+        {directSignFlip<2, 1>, simdSwapXor16<false, signMask<uint16_t, 1>()>},
+        {directSignFlipAndSwap<2, 0>, simdSwapXor16<true, signMask<uint16_t, 1>()>},
+        {directSignFlipAndSwap<2, 1>, simdSwapXor16<true, signMask<uint16_t, 0>()>},
+        {directEndianSwap<3>, simdSwapXor24<true, -1>},
+        {directSignFlip<3, 0>, simdSwapXor24<false, 0>},
+        {directSignFlip<3, 2>, simdSwapXor24<false, 2>},
+        {directSignFlipAndSwap<3, 0>, simdSwapXor24<true, 2>},
+        {directSignFlipAndSwap<3, 2>, simdSwapXor24<true, 0>},
+        {directEndianSwap<4>, simdSwapXor32<true, 0>},
+        {directSignFlip<4, 0>, simdSwapXor32<false, signMask<uint32_t, 0>()>},
+        {directSignFlip<4, 1>, simdSwapXor32<false, signMask<uint32_t, 1>()>},
+        {directSignFlip<4, 2>, simdSwapXor32<false, signMask<uint32_t, 2>()>},
+        {directSignFlip<4, 3>, simdSwapXor32<false, signMask<uint32_t, 3>()>},
+        {directSignFlipAndSwap<4, 0>, simdSwapXor32<true, signMask<uint32_t, 3>()>},
+        {directSignFlipAndSwap<4, 1>, simdSwapXor32<true, signMask<uint32_t, 2>()>},
+        {directSignFlipAndSwap<4, 2>, simdSwapXor32<true, signMask<uint32_t, 1>()>},
+        {directSignFlipAndSwap<4, 3>, simdSwapXor32<true, signMask<uint32_t, 0>()>},
+        // Byte moves inside a little-endian word are plain shifts.
+        {direct_LE_HB32_to_LB32, simdShift32<false>},
+        {direct_LE_LB32_to_HB32, simdShift32<true>},
+        {direct_BE_HB32_to_LB32, simdShift32<true>},
+        {direct_BE_LB32_to_HB32, simdShift32<false>},
+        {direct_24LE_to_LE_HB32, simdExpand24To32<true>},
+        {direct_24LE_to_LE_LB32, simdExpand24To32<false>},
+        {direct_24BE_to_BE_HB32, simdExpand24To32<false>},
+        {direct_24BE_to_BE_LB32, simdExpand24To32<true>},
+        {direct_LE_HB32_to_24LE, simdCompact32To24<true>},
+        {direct_LE_LB32_to_24LE, simdCompact32To24<false>},
+        {direct_BE_HB32_to_24BE, simdCompact32To24<false>},
+        {direct_BE_LB32_to_24BE, simdCompact32To24<true>},
+};
+
+#endif // PROMEKI_ENABLE_CSC
+
+static Atomic<bool> _simdEnabled{true};
+
 struct DirectConverterEntry {
                 AudioFormat::DirectConvertFn fn = nullptr;
                 bool                         bitAccurate = false;
+                AudioFormat::DirectConvertFn simdFn = nullptr; ///< Bit-identical SIMD variant, if any.
 };
 
 using DirectKey = Pair<AudioFormat::ID, AudioFormat::ID>;
@@ -683,6 +880,7 @@ struct AudioFormatRegistry {
                                            {"ac-3", "AC-3"}));
 
                         registerDirectConverters();
+                        attachSimdConverters();
                 }
 
                 void add(AudioFormat::Data d) {
@@ -696,6 +894,22 @@ struct AudioFormatRegistry {
                         directConverters[DirectKey(src, dst)] = DirectConverterEntry{fn, bitAccurate};
                 }
 
+                // Pairs every built-in direct converter with its SIMD
+                // kernel, matched on the scalar function it shadows.
+                void attachSimdConverters() {
+#if PROMEKI_ENABLE_CSC
+                        if constexpr (!SimdKernelsAvailable) return;
+                        for (auto &[key, entry] : directConverters) {
+                                for (const SimdDirectPair &p : simdDirectPairs) {
+                                        if (entry.fn != p.scalar) continue;
+                                        entry.simdFn = p.simd;
+                                        break;
+                                }
+                        }
+#endif
+                        return;
+                }
+
                 // ---- Built-in direct converter table ------------------------
                 //
                 // Registers the trivial reversible transforms for every PCM
@@ -1036,6 +1250,7 @@ AudioFormat::DirectConvertFn AudioFormat::directConverter(ID src, ID dst) {
         auto &reg = registry();
         auto  it = reg.directConverters.find(DirectKey(src, dst));
         if (it == reg.directConverters.end()) return nullptr;
+        if (it->second.simdFn != nullptr && _simdEnabled.value()) return it->second.simdFn;
         return it->second.fn;
 }
 
@@ -1051,6 +1266,38 @@ void AudioFormat::registerDirectConverter(ID src, ID dst, DirectConvertFn fn, bo
         reg.directConverters[DirectKey(src, dst)] = DirectConverterEntry{fn, bitAccurate};
 }
 
+void AudioFormat::samplesToFloat(float *out, const uint8_t *in, size_t samples) const {
+        if (d->samplesToFloatSimd != nullptr && _simdEnabled.value()) {
+                d->samplesToFloatSimd(out, in, samples);
+        } else if (d->samplesToFloat != nullptr) {
+                d->samplesToFloat(out, in, samples);
+        }
+}
+
+void AudioFormat::floatToSamples(uint8_t *out, const float *in, size_t samples) const {
+        if (d->floatToSamplesSimd != nullptr && _simdEnabled.value()) {
+                d->floatToSamplesSimd(out, in, samples);
+        } else if (d->floatToSamples != nullptr) {
+                d->floatToSamples(out, in, samples);
+        }
+}
+
+void AudioFormat::setSimdEnabled(bool enabled) {
+        _simdEnabled.setValue(enabled);
+}
+
+bool AudioFormat::isSimdEnabled() {
+        return _simdEnabled.value();
+}
+
+bool AudioFormat::hasSimdKernels() {
+#if PROMEKI_ENABLE_CSC
+        return SimdKernelsAvailable;
+#else
+        return false;
+#endif
+}
+
 Error AudioFormat::convertTo(const AudioFormat &dst, void *out, const void *in, size_t samples, float *scratch) const {
         if (!isValid() || !dst.isValid()) return Error::InvalidArgument;
         if (samples == 0) return Error::Ok;
@@ -1089,6 +1336,11 @@ static bool layoutOnlyDiffer(const AudioFormat::Data *a, const AudioFormat::Data
 // @ref layoutOnlyDiffer is true.
 template <bool SrcPlanar>
 static void byteTransposeLayout(void *out, const void *in, size_t samplesPerChannel, size_t channels, size_t bps) {
+#if PROMEKI_ENABLE_CSC
+        if (_simdEnabled.value() && audiokernels::transpose(out, in, samplesPerChannel, channels, bps, SrcPlanar)) {
+                return;
+        }
+#endif
         const uint8_t *src = static_cast<const uint8_t *>(in);
         uint8_t       *dst = static_cast<uint8_t *>(out);
         if constexpr (SrcPlanar) {
@@ -1159,6 +1411,13 @@ Error AudioFormat::convertTo(const AudioFormat &dst, void *out, const void *in,
         Buffer transposed(totalFloats * sizeof(float));
         if (!transposed.isValid()) return Error::NoMem;
         float *t = static_cast<float *>(transposed.data());
+#if PROMEKI_ENABLE_CSC
+        if (_simdEnabled.value() &&
+            audiokernels::transpose(t, scratch, samplesPerChannel, channels, sizeof(float), isPlanar())) {
+                dst.floatToSamples(static_cast<uint8_t *>(out), t, totalFloats);
+                return Error::Ok;
+        }
+#endif
         if (isPlanar()) {
                 // Planar input  [ch0[0..N), ch1[0..N), ...]
                 //   →
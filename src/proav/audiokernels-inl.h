@@ -0,0 +1,875 @@
+/**
+ * @file      audiokernels-inl.h
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * Highway SIMD implementation of the AudioFormat sample converters.
+ * Re-included per target via foreach_target.h.
+ *
+ * Every kernel must stay bit-identical to the scalar reference in
+ * audioformat.cpp, so the float math mirrors the reference operation
+ * for operation (no fused multiply-add, same association order) and
+ * each kernel's scalar tail is the reference formula itself.
+ */
+
+#if defined(PROMEKI_AUDIOKERNELS_INL_H_) == defined(HWY_TARGET_TOGGLE)
+#ifdef PROMEKI_AUDIOKERNELS_INL_H_
+#undef PROMEKI_AUDIOKERNELS_INL_H_
+#else
+#define PROMEKI_AUDIOKERNELS_INL_H_
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace promeki {
+        namespace audiokernels {
+                namespace HWY_NAMESPACE {
+                        namespace hn = hwy::HWY_NAMESPACE;
+
+                        // ---- Sample ranges ----
+                        //
+                        // Signed samples scale by 2^(Bits-1) (max(|Min|, Max)
+                        // in AudioFormat::integerToFloat); unsigned samples
+                        // map [0, 2^Bits - 1] linearly onto [-1, 1].
+
+                        template <int Bits> constexpr int64_t SignedMin() { return -(int64_t(1) << (Bits - 1)); }
+                        template <int Bits> constexpr int64_t SignedMax() { return (int64_t(1) << (Bits - 1)) - 1; }
+                        template <int Bits> constexpr int64_t UnsignedMax() { return (int64_t(1) << Bits) - 1; }
+
+                        template <int Bits> constexpr float SignedScale() {
+                                return -static_cast<float>(SignedMin<Bits>()) > static_cast<float>(SignedMax<Bits>())
+                                               ? -static_cast<float>(SignedMin<Bits>())
+                                               : static_cast<float>(SignedMax<Bits>());
+                        }
+
+                        template <int Bits> constexpr float UnsignedRange() {
+                                return static_cast<float>(UnsignedMax<Bits>()) - 0.0f;
+                        }
+
+                        template <int Bits, bool Signed> HWY_INLINE float ScalarToFloat(int64_t value) {
+                                if constexpr (Signed) {
+                                        return static_cast<float>(value) / SignedScale<Bits>();
+                                } else {
+                                        return ((static_cast<float>(value) - 0.0f) * 2.0f / UnsignedRange<Bits>()) -
+                                               1.0f;
+                                }
+                        }
+
+                        template <int Bits, bool Signed> HWY_INLINE int64_t ScalarFromFloat(float value) {
+                                constexpr int64_t lo = Signed ? SignedMin<Bits>() : 0;
+                                constexpr int64_t hi = Signed ? SignedMax<Bits>() : UnsignedMax<Bits>();
+                                if (value <= -1.0f) return lo;
+                                if (value >= 1.0f) return hi;
+                                if constexpr (Signed) {
+                                        return static_cast<int64_t>(value * SignedScale<Bits>());
+                                } else {
+                                        return static_cast<int64_t>((value + 1.0f) * 0.5f * UnsignedRange<Bits>() +
+                                                                    0.0f);
+                                }
+                        }
+
+                        HWY_INLINE uint16_t ScalarSwap16(uint16_t v) {
+                                return static_cast<uint16_t>((v << 8) | (v >> 8));
+                        }
+
+                        HWY_INLINE uint32_t ScalarSwap32(uint32_t v) {
+                                return (v << 24) | ((v << 8) & 0x00FF0000u) | ((v >> 8) & 0x0000FF00u) | (v >> 24);
+                        }
+
+                        HWY_INLINE int32_t ScalarSignExtend24(uint32_t u24) {
+                                return (u24 & 0x800000u) ? static_cast<int32_t>(u24 | 0xFF000000u)
+                                                         : static_cast<int32_t>(u24);
+                        }
+
+                        // ---- Vector helpers ----
+
+                        template <class V> HWY_INLINE V Swap16(V v) {
+                                return hn::Or(hn::ShiftLeft<8>(v), hn::ShiftRight<8>(v));
+                        }
+
+                        template <class D, class V> HWY_INLINE V Swap32(D d, V v) {
+                                const auto outer = hn::Or(hn::ShiftLeft<24>(v), hn::ShiftRight<24>(v));
+                                const auto inner = hn::Or(hn::And(hn::ShiftLeft<8>(v), hn::Set(d, 0x00FF0000u)),
+                                                          hn::And(hn::ShiftRight<8>(v), hn::Set(d, 0x0000FF00u)));
+                                return hn::Or(outer, inner);
+                        }
+
+                        // Sample value (in i32 lanes) to normalized float.
+                        template <int Bits, bool Signed, class DF, class VI>
+                        HWY_INLINE hn::Vec<DF> ToFloat(DF df, VI vi) {
+                                const auto f = hn::ConvertTo(df, vi);
+                                if constexpr (Signed) {
+                                        return hn::Div(f, hn::Set(df, SignedScale<Bits>()));
+                                } else {
+                                        return hn::Sub(hn::Div(hn::Mul(f, hn::Set(df, 2.0f)),
+                                                               hn::Set(df, UnsignedRange<Bits>())),
+                                                       hn::Set(df, 1.0f));
+                                }
+                        }
+
+                        // Unsigned 32-bit lanes to normalized float.  The
+                        // value is split in 16-bit halves so the single
+                        // rounding of the final add matches a direct
+                        // uint32 -> float conversion.
+                        template <class DF, class VU> HWY_INLINE hn::Vec<DF> U32ToFloat(DF df, VU vu) {
+                                const hn::RebindToSigned<DF>   di;
+                                const hn::RebindToUnsigned<DF> du;
+                                const auto hi = hn::ConvertTo(df, hn::BitCast(di, hn::ShiftRight<16>(vu)));
+                                const auto lo = hn::ConvertTo(df, hn::BitCast(di, hn::And(vu, hn::Set(du, 0xFFFFu))));
+                                const auto f = hn::Add(hn::Mul(hi, hn::Set(df, 65536.0f)), lo);
+                                return hn::Sub(hn::Div(hn::Mul(f, hn::Set(df, 2.0f)), hn::Set(df, UnsignedRange<32>())),
+                                               hn::Set(df, 1.0f));
+                        }
+
+                        // (v + 1) * 0.5 * range, the unsigned mapping before truncation.
+                        template <int Bits, class DF> HWY_INLINE hn::Vec<DF> UnsignedScaled(DF df, hn::Vec<DF> v) {
+                                const auto half = hn::Mul(hn::Add(v, hn::Set(df, 1.0f)), hn::Set(df, 0.5f));
+                                return hn::Mul(half, hn::Set(df, UnsignedRange<Bits>()));
+                        }
+
+                        // Normalized float to sample value in i32 lanes
+                        // (unsigned 32-bit values come back as their bit
+                        // pattern), clamped like AudioFormat::floatToInteger.
+                        template <int Bits, bool Signed, class DF>
+                        HWY_INLINE hn::Vec<hn::RebindToSigned<DF>> FromFloat(DF df, hn::Vec<DF> v) {
+                                const hn::RebindToSigned<DF> di;
+                                constexpr int64_t            lo = Signed ? SignedMin<Bits>() : 0;
+                                constexpr int64_t            hi = Signed ? SignedMax<Bits>() : UnsignedMax<Bits>();
+                                const auto                   low = hn::RebindMask(di, hn::Le(v, hn::Set(df, -1.0f)));
+                                const auto                   high = hn::RebindMask(di, hn::Ge(v, hn::Set(df, 1.0f)));
+                                const auto                   vlo = hn::Set(di, static_cast<int32_t>(lo));
+                                const auto vhi = hn::Set(di, static_cast<int32_t>(static_cast<uint32_t>(hi)));
+                                if constexpr (Signed) {
+                                        const auto r = hn::ConvertTo(di, hn::Mul(v, hn::Set(df, SignedScale<Bits>())));
+                                        return hn::IfThenElse(high, vhi, hn::IfThenElse(low, vlo, r));
+                                } else if constexpr (Bits < 32) {
+                                        const auto r = hn::ConvertTo(di, UnsignedScaled<Bits>(df, v));
+                                        return hn::IfThenElse(high, vhi, hn::IfThenElse(low, vlo, r));
+                                } else {
+                                        // Past 2^31 the value no longer fits a
+                                        // signed lane: convert the excess and
+                                        // put the top bit back.  Both steps are
+                                        // exact for floats that large.
+                                        const auto x = UnsignedScaled<32>(df, v);
+                                        const auto big = hn::Ge(x, hn::Set(df, 2147483648.0f));
+                                        const auto xs = hn::IfThenElse(big, hn::Sub(x, hn::Set(df, 2147483648.0f)), x);
+                                        const auto topBit = hn::Set(di, static_cast<int32_t>(0x80000000u));
+                                        const auto top = hn::IfThenElseZero(hn::RebindMask(di, big), topBit);
+                                        const auto r = hn::Or(hn::ConvertTo(di, xs), top);
+                                        return hn::IfThenElse(high, vhi, hn::IfThenElse(low, vlo, r));
+                                }
+                        }
+
+                        // ---- Direct byte-pattern kernels ----
+
+                        void Xor8Impl(void *out, const void *in, size_t samples, uint8_t mask) {
+                                const hn::ScalableTag<uint8_t> d;
+                                const size_t                   N = hn::Lanes(d);
+                                const uint8_t                 *src = static_cast<const uint8_t *>(in);
+                                uint8_t                       *dst = static_cast<uint8_t *>(out);
+                                const auto                     vm = hn::Set(d, mask);
+                                size_t                         i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        hn::StoreU(hn::Xor(hn::LoadU(d, src + i), vm), d, dst + i);
+                                }
+                                for (; i < samples; i++) dst[i] = static_cast<uint8_t>(src[i] ^ mask);
+                                return;
+                        }
+
+                        template <bool Swap> void SwapXor16T(void *out, const void *in, size_t samples, uint16_t mask) {
+                                const hn::ScalableTag<uint16_t> d;
+                                const size_t                    N = hn::Lanes(d);
+                                const uint8_t                  *src = static_cast<const uint8_t *>(in);
+                                uint8_t                        *dst = static_cast<uint8_t *>(out);
+                                const auto                      vm = hn::Set(d, mask);
+                                size_t                          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto v = hn::LoadU(d, reinterpret_cast<const uint16_t *>(src + i * 2));
+                                        if constexpr (Swap) v = Swap16(v);
+                                        hn::StoreU(hn::Xor(v, vm), d, reinterpret_cast<uint16_t *>(dst + i * 2));
+                                }
+                                for (; i < samples; i++) {
+                                        uint16_t v;
+                                        std::memcpy(&v, src + i * 2, 2);
+                                        if constexpr (Swap) v = ScalarSwap16(v);
+                                        v ^= mask;
+                                        std::memcpy(dst + i * 2, &v, 2);
+                                }
+                                return;
+                        }
+
+                        void SwapXor16Impl(void *out, const void *in, size_t samples, bool swap, uint16_t mask) {
+                                if (swap) SwapXor16T<true>(out, in, samples, mask);
+                                else SwapXor16T<false>(out, in, samples, mask);
+                                return;
+                        }
+
+                        template <bool Swap> void SwapXor32T(void *out, const void *in, size_t samples, uint32_t mask) {
+                                const hn::ScalableTag<uint32_t> d;
+                                const size_t                    N = hn::Lanes(d);
+                                const uint8_t                  *src = static_cast<const uint8_t *>(in);
+                                uint8_t                        *dst = static_cast<uint8_t *>(out);
+                                const auto                      vm = hn::Set(d, mask);
+                                size_t                          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto v = hn::LoadU(d, reinterpret_cast<const uint32_t *>(src + i * 4));
+                                        if constexpr (Swap) v = Swap32(d, v);
+                                        hn::StoreU(hn::Xor(v, vm), d, reinterpret_cast<uint32_t *>(dst + i * 4));
+                                }
+                                for (; i < samples; i++) {
+                                        uint32_t v;
+                                        std::memcpy(&v, src + i * 4, 4);
+                                        if constexpr (Swap) v = ScalarSwap32(v);
+                                        v ^= mask;
+                                        std::memcpy(dst + i * 4, &v, 4);
+                                }
+                                return;
+                        }
+
+                        void SwapXor32Impl(void *out, const void *in, size_t samples, bool swap, uint32_t mask) {
+                                if (swap) SwapXor32T<true>(out, in, samples, mask);
+                                else SwapXor32T<false>(out, in, samples, mask);
+                                return;
+                        }
+
+                        void SwapXor24Impl(void *out, const void *in, size_t samples, bool swap, int xorByte) {
+                                const hn::ScalableTag<uint8_t> d;
+                                const size_t                   N = hn::Lanes(d);
+                                const uint8_t                 *src = static_cast<const uint8_t *>(in);
+                                uint8_t                       *dst = static_cast<uint8_t *>(out);
+                                const uint8_t m[3] = {static_cast<uint8_t>(xorByte == 0 ? 0x80 : 0),
+                                                      static_cast<uint8_t>(xorByte == 1 ? 0x80 : 0),
+                                                      static_cast<uint8_t>(xorByte == 2 ? 0x80 : 0)};
+                                const auto    m0 = hn::Set(d, m[0]);
+                                const auto    m1 = hn::Set(d, m[1]);
+                                const auto    m2 = hn::Set(d, m[2]);
+                                size_t        i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        hn::Vec<decltype(d)> b0, b1, b2;
+                                        hn::LoadInterleaved3(d, src + i * 3, b0, b1, b2);
+                                        const auto lo = swap ? b2 : b0;
+                                        const auto hi = swap ? b0 : b2;
+                                        hn::StoreInterleaved3(hn::Xor(lo, m0), hn::Xor(b1, m1), hn::Xor(hi, m2), d,
+                                                              dst + i * 3);
+                                }
+                                for (; i < samples; i++) {
+                                        const uint8_t *s = src + i * 3;
+                                        uint8_t       *o = dst + i * 3;
+                                        const uint8_t  b0 = swap ? s[2] : s[0];
+                                        const uint8_t  b2 = swap ? s[0] : s[2];
+                                        o[0] = static_cast<uint8_t>(b0 ^ m[0]);
+                                        o[1] = static_cast<uint8_t>(s[1] ^ m[1]);
+                                        o[2] = static_cast<uint8_t>(b2 ^ m[2]);
+                                }
+                                return;
+                        }
+
+                        void Shift32Impl(void *out, const void *in, size_t samples, bool left) {
+                                const hn::ScalableTag<uint32_t> d;
+                                const size_t                    N = hn::Lanes(d);
+                                const uint8_t                  *src = static_cast<const uint8_t *>(in);
+                                uint8_t                        *dst = static_cast<uint8_t *>(out);
+                                size_t                          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto v = hn::LoadU(d, reinterpret_cast<const uint32_t *>(src + i * 4));
+                                        const auto r = left ? hn::ShiftLeft<8>(v) : hn::ShiftRight<8>(v);
+                                        hn::StoreU(r, d, reinterpret_cast<uint32_t *>(dst + i * 4));
+                                }
+                                for (; i < samples; i++) {
+                                        uint32_t v;
+                                        std::memcpy(&v, src + i * 4, 4);
+                                        v = left ? v << 8 : v >> 8;
+                                        std::memcpy(dst + i * 4, &v, 4);
+                                }
+                                return;
+                        }
+
+                        void Expand24To32Impl(void *out, const void *in, size_t samples, bool padFirst) {
+                                const hn::ScalableTag<uint8_t> d;
+                                const size_t                   N = hn::Lanes(d);
+                                const uint8_t                 *src = static_cast<const uint8_t *>(in);
+                                uint8_t                       *dst = static_cast<uint8_t *>(out);
+                                const auto                     z = hn::Zero(d);
+                                size_t                         i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        hn::Vec<decltype(d)> b0, b1, b2;
+                                        hn::LoadInterleaved3(d, src + i * 3, b0, b1, b2);
+                                        if (padFirst) hn::StoreInterleaved4(z, b0, b1, b2, d, dst + i * 4);
+                                        else hn::StoreInterleaved4(b0, b1, b2, z, d, dst + i * 4);
+                                }
+                                for (; i < samples; i++) {
+                                        const uint8_t *s = src + i * 3;
+                                        uint8_t       *o = dst + i * 4;
+                                        if (padFirst) {
+                                                o[0] = 0;
+                                                o[1] = s[0];
+                                                o[2] = s[1];
+                                                o[3] = s[2];
+                                        } else {
+                                                o[0] = s[0];
+                                                o[1] = s[1];
+                                                o[2] = s[2];
+                                                o[3] = 0;
+                                        }
+                                }
+                                return;
+                        }
+
+                        void Compact32To24Impl(void *out, const void *in, size_t samples, bool dropFirst) {
+                                const hn::ScalableTag<uint8_t> d;
+                                const size_t                   N = hn::Lanes(d);
+                                const uint8_t                 *src = static_cast<const uint8_t *>(in);
+                                uint8_t                       *dst = static_cast<uint8_t *>(out);
+                                size_t                         i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        hn::Vec<decltype(d)> b0, b1, b2, b3;
+                                        hn::LoadInterleaved4(d, src + i * 4, b0, b1, b2, b3);
+                                        if (dropFirst) hn::StoreInterleaved3(b1, b2, b3, d, dst + i * 3);
+                                        else hn::StoreInterleaved3(b0, b1, b2, d, dst + i * 3);
+                                }
+                                const size_t skip = dropFirst ? 1 : 0;
+                                for (; i < samples; i++) {
+                                        std::memcpy(dst + i * 3, src + i * 4 + skip, 3);
+                                }
+                                return;
+                        }
+
+                        // ---- 8-bit ----
+
+                        template <bool Signed> void Int8ToFloatT(float *out, const uint8_t *in, size_t samples) {
+                                using T = std::conditional_t<Signed, int8_t, uint8_t>;
+                                const hn::ScalableTag<float>      df;
+                                const hn::Rebind<T, decltype(df)> d8;
+                                const hn::RebindToSigned<decltype(df)> di;
+                                const size_t                      N = hn::Lanes(df);
+                                const T                          *src = reinterpret_cast<const T *>(in);
+                                size_t                            i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto vi = hn::PromoteTo(di, hn::LoadU(d8, src + i));
+                                        hn::StoreU(ToFloat<8, Signed>(df, vi), df, out + i);
+                                }
+                                for (; i < samples; i++) out[i] = ScalarToFloat<8, Signed>(src[i]);
+                                return;
+                        }
+
+                        void Int8ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool isSigned) {
+                                if (isSigned) Int8ToFloatT<true>(out, in, samples);
+                                else Int8ToFloatT<false>(out, in, samples);
+                                return;
+                        }
+
+                        template <bool Signed> void FloatToInt8T(uint8_t *out, const float *in, size_t samples) {
+                                using T = std::conditional_t<Signed, int8_t, uint8_t>;
+                                const hn::ScalableTag<float>      df;
+                                const hn::Rebind<T, decltype(df)> d8;
+                                const size_t                      N = hn::Lanes(df);
+                                T                                *dst = reinterpret_cast<T *>(out);
+                                size_t                            i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto vi = FromFloat<8, Signed>(df, hn::LoadU(df, in + i));
+                                        hn::StoreU(hn::DemoteTo(d8, vi), d8, dst + i);
+                                }
+                                for (; i < samples; i++) dst[i] = static_cast<T>(ScalarFromFloat<8, Signed>(in[i]));
+                                return;
+                        }
+
+                        void FloatToInt8Impl(uint8_t *out, const float *in, size_t samples, bool isSigned) {
+                                if (isSigned) FloatToInt8T<true>(out, in, samples);
+                                else FloatToInt8T<false>(out, in, samples);
+                                return;
+                        }
+
+                        // ---- 16-bit ----
+
+                        template <bool Signed, bool Swap>
+                        void Int16ToFloatT(float *out, const uint8_t *in, size_t samples) {
+                                const hn::ScalableTag<float>                df;
+                                const hn::Rebind<uint16_t, decltype(df)>    du16;
+                                const hn::Rebind<int16_t, decltype(df)>     di16;
+                                const hn::RebindToSigned<decltype(df)>      di;
+                                const size_t                                N = hn::Lanes(df);
+                                const uint16_t *src = reinterpret_cast<const uint16_t *>(in);
+                                size_t          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto raw = hn::LoadU(du16, src + i);
+                                        if constexpr (Swap) raw = Swap16(raw);
+                                        if constexpr (Signed) {
+                                                const auto vi = hn::PromoteTo(di, hn::BitCast(di16, raw));
+                                                hn::StoreU(ToFloat<16, true>(df, vi), df, out + i);
+                                        } else {
+                                                const auto vi = hn::PromoteTo(di, raw);
+                                                hn::StoreU(ToFloat<16, false>(df, vi), df, out + i);
+                                        }
+                                }
+                                for (; i < samples; i++) {
+                                        uint16_t v;
+                                        std::memcpy(&v, in + i * 2, 2);
+                                        if constexpr (Swap) v = ScalarSwap16(v);
+                                        if constexpr (Signed) out[i] = ScalarToFloat<16, true>(static_cast<int16_t>(v));
+                                        else out[i] = ScalarToFloat<16, false>(v);
+                                }
+                                return;
+                        }
+
+                        void Int16ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap) {
+                                if (isSigned) {
+                                        if (swap) Int16ToFloatT<true, true>(out, in, samples);
+                                        else Int16ToFloatT<true, false>(out, in, samples);
+                                } else {
+                                        if (swap) Int16ToFloatT<false, true>(out, in, samples);
+                                        else Int16ToFloatT<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool Swap>
+                        void FloatToInt16T(uint8_t *out, const float *in, size_t samples) {
+                                using T = std::conditional_t<Signed, int16_t, uint16_t>;
+                                const hn::ScalableTag<float>             df;
+                                const hn::Rebind<T, decltype(df)>        d16;
+                                const hn::Rebind<uint16_t, decltype(df)> du16;
+                                const size_t                             N = hn::Lanes(df);
+                                uint16_t *dst = reinterpret_cast<uint16_t *>(out);
+                                size_t    i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto vi = FromFloat<16, Signed>(df, hn::LoadU(df, in + i));
+                                        auto       raw = hn::BitCast(du16, hn::DemoteTo(d16, vi));
+                                        if constexpr (Swap) raw = Swap16(raw);
+                                        hn::StoreU(raw, du16, dst + i);
+                                }
+                                for (; i < samples; i++) {
+                                        uint16_t v = static_cast<uint16_t>(ScalarFromFloat<16, Signed>(in[i]));
+                                        if constexpr (Swap) v = ScalarSwap16(v);
+                                        std::memcpy(out + i * 2, &v, 2);
+                                }
+                                return;
+                        }
+
+                        void FloatToInt16Impl(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap) {
+                                if (isSigned) {
+                                        if (swap) FloatToInt16T<true, true>(out, in, samples);
+                                        else FloatToInt16T<true, false>(out, in, samples);
+                                } else {
+                                        if (swap) FloatToInt16T<false, true>(out, in, samples);
+                                        else FloatToInt16T<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        // ---- 32-bit integer ----
+
+                        template <bool Signed, bool Swap>
+                        void Int32ToFloatT(float *out, const uint8_t *in, size_t samples) {
+                                const hn::ScalableTag<float>           df;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const hn::RebindToSigned<decltype(df)> di;
+                                const size_t                           N = hn::Lanes(df);
+                                const uint32_t *src = reinterpret_cast<const uint32_t *>(in);
+                                size_t          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto raw = hn::LoadU(du, src + i);
+                                        if constexpr (Swap) raw = Swap32(du, raw);
+                                        if constexpr (Signed) {
+                                                hn::StoreU(ToFloat<32, true>(df, hn::BitCast(di, raw)), df, out + i);
+                                        } else {
+                                                hn::StoreU(U32ToFloat(df, raw), df, out + i);
+                                        }
+                                }
+                                for (; i < samples; i++) {
+                                        uint32_t v;
+                                        std::memcpy(&v, in + i * 4, 4);
+                                        if constexpr (Swap) v = ScalarSwap32(v);
+                                        if constexpr (Signed) out[i] = ScalarToFloat<32, true>(static_cast<int32_t>(v));
+                                        else out[i] = ScalarToFloat<32, false>(v);
+                                }
+                                return;
+                        }
+
+                        void Int32ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap) {
+                                if (isSigned) {
+                                        if (swap) Int32ToFloatT<true, true>(out, in, samples);
+                                        else Int32ToFloatT<true, false>(out, in, samples);
+                                } else {
+                                        if (swap) Int32ToFloatT<false, true>(out, in, samples);
+                                        else Int32ToFloatT<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool Swap>
+                        void FloatToInt32T(uint8_t *out, const float *in, size_t samples) {
+                                const hn::ScalableTag<float>             df;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const size_t                             N = hn::Lanes(df);
+                                uint32_t *dst = reinterpret_cast<uint32_t *>(out);
+                                size_t    i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto raw = hn::BitCast(du, FromFloat<32, Signed>(df, hn::LoadU(df, in + i)));
+                                        if constexpr (Swap) raw = Swap32(du, raw);
+                                        hn::StoreU(raw, du, dst + i);
+                                }
+                                for (; i < samples; i++) {
+                                        uint32_t v = static_cast<uint32_t>(ScalarFromFloat<32, Signed>(in[i]));
+                                        if constexpr (Swap) v = ScalarSwap32(v);
+                                        std::memcpy(out + i * 4, &v, 4);
+                                }
+                                return;
+                        }
+
+                        void FloatToInt32Impl(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap) {
+                                if (isSigned) {
+                                        if (swap) FloatToInt32T<true, true>(out, in, samples);
+                                        else FloatToInt32T<true, false>(out, in, samples);
+                                } else {
+                                        if (swap) FloatToInt32T<false, true>(out, in, samples);
+                                        else FloatToInt32T<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        // ---- Packed 24-bit ----
+
+                        template <bool Signed, bool BigEndian>
+                        void Int24ToFloatT(float *out, const uint8_t *in, size_t samples) {
+                                const hn::ScalableTag<float>             df;
+                                const hn::Rebind<uint8_t, decltype(df)>  du8;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const hn::RebindToSigned<decltype(df)>   di;
+                                const size_t                             N = hn::Lanes(df);
+                                size_t                                   i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        hn::Vec<decltype(du8)> b0, b1, b2;
+                                        hn::LoadInterleaved3(du8, in + i * 3, b0, b1, b2);
+                                        const auto lo = hn::PromoteTo(du, BigEndian ? b2 : b0);
+                                        const auto mid = hn::PromoteTo(du, b1);
+                                        const auto hi = hn::PromoteTo(du, BigEndian ? b0 : b2);
+                                        const auto u = hn::Or(lo, hn::Or(hn::ShiftLeft<8>(mid), hn::ShiftLeft<16>(hi)));
+                                        if constexpr (Signed) {
+                                                const auto vi = hn::ShiftRight<8>(hn::ShiftLeft<8>(hn::BitCast(di, u)));
+                                                hn::StoreU(ToFloat<24, true>(df, vi), df, out + i);
+                                        } else {
+                                                hn::StoreU(ToFloat<24, false>(df, hn::BitCast(di, u)), df, out + i);
+                                        }
+                                }
+                                for (; i < samples; i++) {
+                                        const uint8_t *s = in + i * 3;
+                                        uint32_t       u24;
+                                        if constexpr (BigEndian) {
+                                                u24 = uint32_t(s[0]) << 16 | uint32_t(s[1]) << 8 | uint32_t(s[2]);
+                                        } else {
+                                                u24 = uint32_t(s[0]) | uint32_t(s[1]) << 8 | uint32_t(s[2]) << 16;
+                                        }
+                                        if constexpr (Signed) {
+                                                out[i] = ScalarToFloat<24, true>(ScalarSignExtend24(u24));
+                                        } else {
+                                                out[i] = ScalarToFloat<24, false>(u24);
+                                        }
+                                }
+                                return;
+                        }
+
+                        void Int24ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool isSigned,
+                                              bool bigEndian) {
+                                if (isSigned) {
+                                        if (bigEndian) Int24ToFloatT<true, true>(out, in, samples);
+                                        else Int24ToFloatT<true, false>(out, in, samples);
+                                } else {
+                                        if (bigEndian) Int24ToFloatT<false, true>(out, in, samples);
+                                        else Int24ToFloatT<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool BigEndian>
+                        void FloatToInt24T(uint8_t *out, const float *in, size_t samples) {
+                                const hn::ScalableTag<float>             df;
+                                const hn::Rebind<uint8_t, decltype(df)>  du8;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const hn::RebindToSigned<decltype(df)>   di;
+                                const size_t                             N = hn::Lanes(df);
+                                const auto                               byteMask = hn::Set(du, 0xFFu);
+                                size_t                                   i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto vi = FromFloat<24, Signed>(df, hn::LoadU(df, in + i));
+                                        const auto u = hn::BitCast(du, vi);
+                                        const auto u1 = hn::ShiftRight<8>(u);
+                                        const auto u2 = hn::ShiftRight<16>(u);
+                                        const auto b0 = hn::DemoteTo(du8, hn::BitCast(di, hn::And(u, byteMask)));
+                                        const auto b1 = hn::DemoteTo(du8, hn::BitCast(di, hn::And(u1, byteMask)));
+                                        const auto b2 = hn::DemoteTo(du8, hn::BitCast(di, hn::And(u2, byteMask)));
+                                        if constexpr (BigEndian) hn::StoreInterleaved3(b2, b1, b0, du8, out + i * 3);
+                                        else hn::StoreInterleaved3(b0, b1, b2, du8, out + i * 3);
+                                }
+                                for (; i < samples; i++) {
+                                        const int64_t val = ScalarFromFloat<24, Signed>(in[i]);
+                                        uint8_t      *o = out + i * 3;
+                                        if constexpr (BigEndian) {
+                                                o[0] = static_cast<uint8_t>((val >> 16) & 0xFF);
+                                                o[1] = static_cast<uint8_t>((val >> 8) & 0xFF);
+                                                o[2] = static_cast<uint8_t>(val & 0xFF);
+                                        } else {
+                                                o[0] = static_cast<uint8_t>(val & 0xFF);
+                                                o[1] = static_cast<uint8_t>((val >> 8) & 0xFF);
+                                                o[2] = static_cast<uint8_t>((val >> 16) & 0xFF);
+                                        }
+                                }
+                                return;
+                        }
+
+                        void FloatToInt24Impl(uint8_t *out, const float *in, size_t samples, bool isSigned,
+                                              bool bigEndian) {
+                                if (isSigned) {
+                                        if (bigEndian) FloatToInt24T<true, true>(out, in, samples);
+                                        else FloatToInt24T<true, false>(out, in, samples);
+                                } else {
+                                        if (bigEndian) FloatToInt24T<false, true>(out, in, samples);
+                                        else FloatToInt24T<false, false>(out, in, samples);
+                                }
+                                return;
+                        }
+
+                        // ---- 24-bit in a 32-bit container ----
+
+                        template <bool Signed, bool Swap, bool HighBytes>
+                        void Int24In32ToFloatT(float *out, const uint8_t *in, size_t samples) {
+                                const hn::ScalableTag<float>             df;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const hn::RebindToSigned<decltype(df)>   di;
+                                const size_t                             N = hn::Lanes(df);
+                                const uint32_t *src = reinterpret_cast<const uint32_t *>(in);
+                                size_t          i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        auto word = hn::LoadU(du, src + i);
+                                        if constexpr (Swap) word = Swap32(du, word);
+                                        if constexpr (Signed) {
+                                                auto vi = hn::BitCast(di, word);
+                                                if constexpr (!HighBytes) vi = hn::ShiftLeft<8>(vi);
+                                                vi = hn::ShiftRight<8>(vi);
+                                                hn::StoreU(ToFloat<24, true>(df, vi), df, out + i);
+                                        } else {
+                                                const auto u = HighBytes ? hn::ShiftRight<8>(word)
+                                                                         : hn::And(word, hn::Set(du, 0xFFFFFFu));
+                                                hn::StoreU(ToFloat<24, false>(df, hn::BitCast(di, u)), df, out + i);
+                                        }
+                                }
+                                for (; i < samples; i++) {
+                                        uint32_t word;
+                                        std::memcpy(&word, in + i * 4, 4);
+                                        if constexpr (Swap) word = ScalarSwap32(word);
+                                        const uint32_t u24 = HighBytes ? (word >> 8) & 0xFFFFFFu : word & 0xFFFFFFu;
+                                        if constexpr (Signed) {
+                                                out[i] = ScalarToFloat<24, true>(ScalarSignExtend24(u24));
+                                        } else {
+                                                out[i] = ScalarToFloat<24, false>(u24);
+                                        }
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool Swap>
+                        void Int24In32ToFloatS(float *out, const uint8_t *in, size_t samples, bool highBytes) {
+                                if (highBytes) Int24In32ToFloatT<Signed, Swap, true>(out, in, samples);
+                                else Int24In32ToFloatT<Signed, Swap, false>(out, in, samples);
+                                return;
+                        }
+
+                        void Int24In32ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool isSigned,
+                                                  bool swap, bool highBytes) {
+                                if (isSigned) {
+                                        if (swap) Int24In32ToFloatS<true, true>(out, in, samples, highBytes);
+                                        else Int24In32ToFloatS<true, false>(out, in, samples, highBytes);
+                                } else {
+                                        if (swap) Int24In32ToFloatS<false, true>(out, in, samples, highBytes);
+                                        else Int24In32ToFloatS<false, false>(out, in, samples, highBytes);
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool Swap, bool HighBytes>
+                        void FloatToInt24In32T(uint8_t *out, const float *in, size_t samples) {
+                                const hn::ScalableTag<float>             df;
+                                const hn::RebindToUnsigned<decltype(df)> du;
+                                const size_t                             N = hn::Lanes(df);
+                                uint32_t *dst = reinterpret_cast<uint32_t *>(out);
+                                size_t    i = 0;
+                                for (; i + N <= samples; i += N) {
+                                        const auto vi = FromFloat<24, Signed>(df, hn::LoadU(df, in + i));
+                                        const auto u = hn::And(hn::BitCast(du, vi), hn::Set(du, 0xFFFFFFu));
+                                        auto word = HighBytes ? hn::ShiftLeft<8>(u) : u;
+                                        if constexpr (Swap) word = Swap32(du, word);
+                                        hn::StoreU(word, du, dst + i);
+                                }
+                                for (; i < samples; i++) {
+                                        const int64_t  val = ScalarFromFloat<24, Signed>(in[i]);
+                                        const uint32_t u24 = static_cast<uint32_t>(val) & 0xFFFFFFu;
+                                        uint32_t       word = HighBytes ? (u24 << 8) : u24;
+                                        if constexpr (Swap) word = ScalarSwap32(word);
+                                        std::memcpy(out + i * 4, &word, 4);
+                                }
+                                return;
+                        }
+
+                        template <bool Signed, bool Swap>
+                        void FloatToInt24In32S(uint8_t *out, const float *in, size_t samples, bool highBytes) {
+                                if (highBytes) FloatToInt24In32T<Signed, Swap, true>(out, in, samples);
+                                else FloatToInt24In32T<Signed, Swap, false>(out, in, samples);
+                                return;
+                        }
+
+                        void FloatToInt24In32Impl(uint8_t *out, const float *in, size_t samples, bool isSigned,
+                                                  bool swap, bool highBytes) {
+                                if (isSigned) {
+                                        if (swap) FloatToInt24In32S<true, true>(out, in, samples, highBytes);
+                                        else FloatToInt24In32S<true, false>(out, in, samples, highBytes);
+                                } else {
+                                        if (swap) FloatToInt24In32S<false, true>(out, in, samples, highBytes);
+                                        else FloatToInt24In32S<false, false>(out, in, samples, highBytes);
+                                }
+                                return;
+                        }
+
+                        // ---- Float32 ----
+
+                        void Float32ToFloatImpl(float *out, const uint8_t *in, size_t samples, bool swap) {
+                                if (!swap) {
+                                        std::memcpy(out, in, samples * sizeof(float));
+                                        return;
+                                }
+                                SwapXor32T<true>(out, in, samples, 0);
+                                return;
+                        }
+
+                        void FloatToFloat32Impl(uint8_t *out, const float *in, size_t samples, bool swap) {
+                                if (!swap) {
+                                        std::memcpy(out, in, samples * sizeof(float));
+                                        return;
+                                }
+                                SwapXor32T<true>(out, in, samples, 0);
+                                return;
+                        }
+
+                        // ---- Planar <-> interleaved ----
+
+                        // Cache-blocked scalar transpose for channel counts the
+                        // interleaved load/store ops do not cover.  Works a
+                        // tile of samples at a time so every plane is written
+                        // (or read) sequentially within the tile.
+                        template <size_t Bytes>
+                        void TransposeBlocked(uint8_t *dst, const uint8_t *src, size_t spc, size_t channels,
+                                              bool srcPlanar) {
+                                constexpr size_t Tile = 64;
+                                for (size_t s0 = 0; s0 < spc; s0 += Tile) {
+                                        const size_t s1 = s0 + Tile < spc ? s0 + Tile : spc;
+                                        for (size_t c = 0; c < channels; c++) {
+                                                for (size_t s = s0; s < s1; s++) {
+                                                        const size_t planar = (c * spc + s) * Bytes;
+                                                        const size_t inter = (s * channels + c) * Bytes;
+                                                        if (srcPlanar) std::memcpy(dst + inter, src + planar, Bytes);
+                                                        else std::memcpy(dst + planar, src + inter, Bytes);
+                                                }
+                                        }
+                                }
+                                return;
+                        }
+
+                        template <typename T>
+                        void TransposeT(void *out, const void *in, size_t spc, size_t channels, bool srcPlanar) {
+                                const hn::ScalableTag<T> d;
+                                const size_t             N = hn::Lanes(d);
+                                const T                 *src = static_cast<const T *>(in);
+                                T                       *dst = static_cast<T *>(out);
+                                size_t                   s = 0;
+                                if (channels == 2) {
+                                        const T *p0 = src, *p1 = src + spc;
+                                        T       *q0 = dst, *q1 = dst + spc;
+                                        for (; s + N <= spc; s += N) {
+                                                if (srcPlanar) {
+                                                        const auto a = hn::LoadU(d, p0 + s);
+                                                        const auto b = hn::LoadU(d, p1 + s);
+                                                        hn::StoreInterleaved2(a, b, d, dst + s * 2);
+                                                } else {
+                                                        hn::Vec<decltype(d)> a, b;
+                                                        hn::LoadInterleaved2(d, src + s * 2, a, b);
+                                                        hn::StoreU(a, d, q0 + s);
+                                                        hn::StoreU(b, d, q1 + s);
+                                                }
+                                        }
+                                } else if (channels == 3) {
+                                        const T *p0 = src, *p1 = src + spc, *p2 = src + spc * 2;
+                                        T       *q0 = dst, *q1 = dst + spc, *q2 = dst + spc * 2;
+                                        for (; s + N <= spc; s += N) {
+                                                if (srcPlanar) {
+                                                        const auto a = hn::LoadU(d, p0 + s);
+                                                        const auto b = hn::LoadU(d, p1 + s);
+                                                        const auto c = hn::LoadU(d, p2 + s);
+                                                        hn::StoreInterleaved3(a, b, c, d, dst + s * 3);
+                                                } else {
+                                                        hn::Vec<decltype(d)> a, b, c;
+                                                        hn::LoadInterleaved3(d, src + s * 3, a, b, c);
+                                                        hn::StoreU(a, d, q0 + s);
+                                                        hn::StoreU(b, d, q1 + s);
+                                                        hn::StoreU(c, d, q2 + s);
+                                                }
+                                        }
+                                } else if (channels == 4) {
+                                        const T *p0 = src, *p1 = src + spc, *p2 = src + spc * 2, *p3 = src + spc * 3;
+                                        T       *q0 = dst, *q1 = dst + spc, *q2 = dst + spc * 2, *q3 = dst + spc * 3;
+                                        for (; s + N <= spc; s += N) {
+                                                if (srcPlanar) {
+                                                        const auto a = hn::LoadU(d, p0 + s);
+                                                        const auto b = hn::LoadU(d, p1 + s);
+                                                        const auto c = hn::LoadU(d, p2 + s);
+                                                        const auto e = hn::LoadU(d, p3 + s);
+                                                        hn::StoreInterleaved4(a, b, c, e, d, dst + s * 4);
+                                                } else {
+                                                        hn::Vec<decltype(d)> a, b, c, e;
+                                                        hn::LoadInterleaved4(d, src + s * 4, a, b, c, e);
+                                                        hn::StoreU(a, d, q0 + s);
+                                                        hn::StoreU(b, d, q1 + s);
+                                                        hn::StoreU(c, d, q2 + s);
+                                                        hn::StoreU(e, d, q3 + s);
+                                                }
+                                        }
+                                } else {
+                                        TransposeBlocked<sizeof(T)>(static_cast<uint8_t *>(out),
+                                                                    static_cast<const uint8_t *>(in), spc, channels,
+                                                                    srcPlanar);
+                                        return;
+                                }
+                                // Scalar tail for the samples past the last full vector.
+                                for (; s < spc; s++) {
+                                        for (size_t c = 0; c < channels; c++) {
+                                                if (srcPlanar) dst[s * channels + c] = src[c * spc + s];
+                                                else dst[c * spc + s] = src[s * channels + c];
+                                        }
+                                }
+                                return;
+                        }
+
+                        void TransposeImpl(void *out, const void *in, size_t spc, size_t channels, size_t bps,
+                                           bool srcPlanar) {
+                                switch (bps) {
+                                        case 1: TransposeT<uint8_t>(out, in, spc, channels, srcPlanar); break;
+                                        case 2: TransposeT<uint16_t>(out, in, spc, channels, srcPlanar); break;
+                                        case 3:
+                                                TransposeBlocked<3>(static_cast<uint8_t *>(out),
+                                                                    static_cast<const uint8_t *>(in), spc, channels,
+                                                                    srcPlanar);
+                                                break;
+                                        case 4: TransposeT<uint32_t>(out, in, spc, channels, srcPlanar); break;
+                                        default: break;
+                                }
+                                return;
+                        }
+
+                } // namespace HWY_NAMESPACE
+        } // namespace audiokernels
+} // namespace promeki
+HWY_AFTER_NAMESPACE();
+
+#endif
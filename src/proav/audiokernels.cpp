@@ -0,0 +1,149 @@
+/**
+ * @file      audiokernels.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/proav/audiokernels-inl.h"
+#include "hwy/foreach_target.h" // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "src/proav/audiokernels-inl.h"
+
+#if HWY_ONCE
+
+#include "audiokernels.h"
+
+namespace promeki {
+        namespace audiokernels {
+
+                HWY_EXPORT(Xor8Impl);
+                HWY_EXPORT(SwapXor16Impl);
+                HWY_EXPORT(SwapXor32Impl);
+                HWY_EXPORT(SwapXor24Impl);
+                HWY_EXPORT(Shift32Impl);
+                HWY_EXPORT(Expand24To32Impl);
+                HWY_EXPORT(Compact32To24Impl);
+                HWY_EXPORT(Int8ToFloatImpl);
+                HWY_EXPORT(FloatToInt8Impl);
+                HWY_EXPORT(Int16ToFloatImpl);
+                HWY_EXPORT(FloatToInt16Impl);
+                HWY_EXPORT(Int32ToFloatImpl);
+                HWY_EXPORT(FloatToInt32Impl);
+                HWY_EXPORT(Int24ToFloatImpl);
+                HWY_EXPORT(FloatToInt24Impl);
+                HWY_EXPORT(Int24In32ToFloatImpl);
+                HWY_EXPORT(FloatToInt24In32Impl);
+                HWY_EXPORT(Float32ToFloatImpl);
+                HWY_EXPORT(FloatToFloat32Impl);
+                HWY_EXPORT(TransposeImpl);
+
+                void xor8(void *out, const void *in, size_t samples, uint8_t mask) {
+                        HWY_DYNAMIC_DISPATCH(Xor8Impl)(out, in, samples, mask);
+                        return;
+                }
+
+                void swapXor16(void *out, const void *in, size_t samples, bool swap, uint16_t mask) {
+                        HWY_DYNAMIC_DISPATCH(SwapXor16Impl)(out, in, samples, swap, mask);
+                        return;
+                }
+
+                void swapXor32(void *out, const void *in, size_t samples, bool swap, uint32_t mask) {
+                        HWY_DYNAMIC_DISPATCH(SwapXor32Impl)(out, in, samples, swap, mask);
+                        return;
+                }
+
+                void swapXor24(void *out, const void *in, size_t samples, bool swap, int xorByte) {
+                        HWY_DYNAMIC_DISPATCH(SwapXor24Impl)(out, in, samples, swap, xorByte);
+                        return;
+                }
+
+                void shift32(void *out, const void *in, size_t samples, bool left) {
+                        HWY_DYNAMIC_DISPATCH(Shift32Impl)(out, in, samples, left);
+                        return;
+                }
+
+                void expand24To32(void *out, const void *in, size_t samples, bool padFirst) {
+                        HWY_DYNAMIC_DISPATCH(Expand24To32Impl)(out, in, samples, padFirst);
+                        return;
+                }
+
+                void compact32To24(void *out, const void *in, size_t samples, bool dropFirst) {
+                        HWY_DYNAMIC_DISPATCH(Compact32To24Impl)(out, in, samples, dropFirst);
+                        return;
+                }
+
+                void int8ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned) {
+                        HWY_DYNAMIC_DISPATCH(Int8ToFloatImpl)(out, in, samples, isSigned);
+                        return;
+                }
+
+                void floatToInt8(uint8_t *out, const float *in, size_t samples, bool isSigned) {
+                        HWY_DYNAMIC_DISPATCH(FloatToInt8Impl)(out, in, samples, isSigned);
+                        return;
+                }
+
+                void int16ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(Int16ToFloatImpl)(out, in, samples, isSigned, swap);
+                        return;
+                }
+
+                void floatToInt16(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(FloatToInt16Impl)(out, in, samples, isSigned, swap);
+                        return;
+                }
+
+                void int32ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(Int32ToFloatImpl)(out, in, samples, isSigned, swap);
+                        return;
+                }
+
+                void floatToInt32(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(FloatToInt32Impl)(out, in, samples, isSigned, swap);
+                        return;
+                }
+
+                void int24ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool bigEndian) {
+                        HWY_DYNAMIC_DISPATCH(Int24ToFloatImpl)(out, in, samples, isSigned, bigEndian);
+                        return;
+                }
+
+                void floatToInt24(uint8_t *out, const float *in, size_t samples, bool isSigned, bool bigEndian) {
+                        HWY_DYNAMIC_DISPATCH(FloatToInt24Impl)(out, in, samples, isSigned, bigEndian);
+                        return;
+                }
+
+                void int24In32ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap,
+                                      bool highBytes) {
+                        HWY_DYNAMIC_DISPATCH(Int24In32ToFloatImpl)(out, in, samples, isSigned, swap, highBytes);
+                        return;
+                }
+
+                void floatToInt24In32(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap,
+                                      bool highBytes) {
+                        HWY_DYNAMIC_DISPATCH(FloatToInt24In32Impl)(out, in, samples, isSigned, swap, highBytes);
+                        return;
+                }
+
+                void float32ToFloat(float *out, const uint8_t *in, size_t samples, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(Float32ToFloatImpl)(out, in, samples, swap);
+                        return;
+                }
+
+                void floatToFloat32(uint8_t *out, const float *in, size_t samples, bool swap) {
+                        HWY_DYNAMIC_DISPATCH(FloatToFloat32Impl)(out, in, samples, swap);
+                        return;
+                }
+
+                bool transpose(void *out, const void *in, size_t samplesPerChannel, size_t channels, size_t bps,
+                               bool srcPlanar) {
+                        if (bps < 1 || bps > 4) return false;
+                        HWY_DYNAMIC_DISPATCH(TransposeImpl)(out, in, samplesPerChannel, channels, bps, srcPlanar);
+                        return true;
+                }
+
+        } // namespace audiokernels
+} // namespace promeki
+
+#endif // HWY_ONCE
@@ -0,0 +1,86 @@
+/**
+ * @file      audiokernels.h
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * Internal header declaring the SIMD audio sample kernels behind
+ * @ref AudioFormat.  Each function dispatches to the best available
+ * SIMD implementation at runtime (via Highway dynamic dispatch) and
+ * produces output bit-identical to the scalar converters in
+ * audioformat.cpp, which stay registered as the reference path.
+ *
+ * Byte-pattern kernels work on the in-memory sample layout of a
+ * little-endian host; audioformat.cpp only wires them up there.  Lane
+ * masks are expressed in host lane order, so the sign bit of a sample
+ * whose top byte sits at memory index @c k is @c 0x80 << (8 * k).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace promeki {
+        namespace audiokernels {
+
+                // --- Direct (no-float) byte-pattern kernels ---
+
+                /** @brief XORs every 8-bit sample with @p mask. */
+                void xor8(void *out, const void *in, size_t samples, uint8_t mask);
+
+                /** @brief Optionally byte-swaps, then XORs every 16-bit sample with @p mask. */
+                void swapXor16(void *out, const void *in, size_t samples, bool swap, uint16_t mask);
+
+                /** @brief Optionally byte-swaps, then XORs every 32-bit sample with @p mask. */
+                void swapXor32(void *out, const void *in, size_t samples, bool swap, uint32_t mask);
+
+                /**
+                 * @brief Packed 24-bit swap / sign flip.
+                 *
+                 * Optionally reverses the three bytes of every sample,
+                 * then flips the top bit of destination byte
+                 * @p xorByte (-1 = none).
+                 */
+                void swapXor24(void *out, const void *in, size_t samples, bool swap, int xorByte);
+
+                /** @brief Shifts every 32-bit word left (@p left) or right by 8 bits. */
+                void shift32(void *out, const void *in, size_t samples, bool left);
+
+                /** @brief Widens packed 3-byte samples to 4-byte words, zero pad first or last. */
+                void expand24To32(void *out, const void *in, size_t samples, bool padFirst);
+
+                /** @brief Narrows 4-byte words to packed 3-byte samples, dropping the first or last byte. */
+                void compact32To24(void *out, const void *in, size_t samples, bool dropFirst);
+
+                // --- Sample <-> normalized float kernels ---
+
+                void int8ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned);
+                void floatToInt8(uint8_t *out, const float *in, size_t samples, bool isSigned);
+                void int16ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap);
+                void floatToInt16(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap);
+                void int32ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap);
+                void floatToInt32(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap);
+                void int24ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool bigEndian);
+                void floatToInt24(uint8_t *out, const float *in, size_t samples, bool isSigned, bool bigEndian);
+                void int24In32ToFloat(float *out, const uint8_t *in, size_t samples, bool isSigned, bool swap,
+                                      bool highBytes);
+                void floatToInt24In32(uint8_t *out, const float *in, size_t samples, bool isSigned, bool swap,
+                                      bool highBytes);
+                void float32ToFloat(float *out, const uint8_t *in, size_t samples, bool swap);
+                void floatToFloat32(uint8_t *out, const float *in, size_t samples, bool swap);
+
+                // --- Layout ---
+
+                /**
+                 * @brief Planar <-> interleaved transpose of @p bps-byte samples.
+                 *
+                 * @param srcPlanar True for planar in / interleaved out.
+                 * @return false when the sample size is not 1, 2, 3 or 4
+                 *         bytes; the caller falls back to its own loop.
+                 */
+                bool transpose(void *out, const void *in, size_t samplesPerChannel, size_t channels, size_t bps,
+                               bool srcPlanar);
+
+        } // namespace audiokernels
+} // namespace promeki
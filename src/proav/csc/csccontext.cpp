@@ -7,9 +7,37 @@
 
 #include <promeki/csccontext.h>
 #include <promeki/logger.h>
+#include <promeki/atomic.h>
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace {
+
+        // One cached context per thread.  @c busy guards against a nested
+        // acquire() on the same thread handing out the context that an
+        // outer lease is still writing into.
+        struct ThreadSlot {
+                        CSCContext ctx;
+                        bool       busy = false;
+        };
+
+        static ThreadSlot &threadSlot() {
+                static thread_local ThreadSlot slot;
+                return slot;
+        }
+
+        static Atomic<uint64_t> &hitCounter() {
+                static Atomic<uint64_t> c{0};
+                return c;
+        }
+
+        static Atomic<uint64_t> &missCounter() {
+                static Atomic<uint64_t> c{0};
+                return c;
+        }
+
+} // anonymous
+
 CSCContext::CSCContext(size_t maxWidth) : _maxWidth(maxWidth) {
         // Allocate aligned float buffers, each holding maxWidth floats
         size_t bytes = maxWidth * sizeof(float);
@@ -26,6 +54,67 @@ CSCContext::CSCContext(size_t maxWidth) : _maxWidth(maxWidth) {
         return;
 }
 
+CSCContext::Lease CSCContext::acquire(size_t maxWidth) {
+        Lease       lease;
+        ThreadSlot &slot = threadSlot();
+        if (slot.busy) {
+                missCounter().fetchAndAdd(1, MemoryOrder::Relaxed);
+                lease._fallback = UniquePtr<CSCContext>::create(maxWidth);
+                lease._ctx = lease._fallback.get();
+                return lease;
+        }
+        if (slot.ctx.maxWidth() < maxWidth) {
+                missCounter().fetchAndAdd(1, MemoryOrder::Relaxed);
+                slot.ctx = CSCContext(maxWidth);
+        } else {
+                hitCounter().fetchAndAdd(1, MemoryOrder::Relaxed);
+        }
+        slot.busy = true;
+        lease._ctx = &slot.ctx;
+        lease._busy = &slot.busy;
+        return lease;
+}
+
+CSCContext::CacheStats CSCContext::cacheStats() {
+        CacheStats s;
+        s.hits = hitCounter().load(MemoryOrder::Relaxed);
+        s.misses = missCounter().load(MemoryOrder::Relaxed);
+        return s;
+}
+
+void CSCContext::resetCacheStats() {
+        hitCounter().store(0, MemoryOrder::Relaxed);
+        missCounter().store(0, MemoryOrder::Relaxed);
+        return;
+}
+
+CSCContext::Lease::~Lease() {
+        release();
+}
+
+CSCContext::Lease::Lease(Lease &&other) noexcept {
+        *this = std::move(other);
+}
+
+CSCContext::Lease &CSCContext::Lease::operator=(Lease &&other) noexcept {
+        if (this == &other) return *this;
+        release();
+        _fallback = std::move(other._fallback);
+        _ctx = other._ctx;
+        _busy = other._busy;
+        other._ctx = nullptr;
+        other._busy = nullptr;
+        return *this;
+}
+
+void CSCContext::Lease::release() {
+        if (_busy != nullptr) *_busy = false;
+        _busy = nullptr;
+        _ctx = nullptr;
+        _fallback.clear();
+        return;
+}
+
 float *CSCContext::buffer(int index) {
         if (index < 0 || index >= BufferCount || !_buffers[index].isValid()) {
                 promekiWarnThrottled(5000, "CSCContext::buffer: invalid request index=%d valid=%d",
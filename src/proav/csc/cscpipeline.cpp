@@ -12,8 +12,11 @@
 #include <promeki/map.h>
 #include <promeki/mutex.h>
 #include <promeki/enums_color.h>
+#include <promeki/threadpool.h>
+#include <promeki/basicthread.h>
 #include <cstring>
 #include <cmath>
+#include <numeric>
 #include <tuple>
 #include "csc_kernels.h"
 
@@ -34,6 +37,16 @@ static bool resolveUseSimd(const MediaConfig &config) {
         return e != CscPath::Scalar;
 }
 
+// Resolves @ref MediaConfig::CscThreads to a concrete band count.
+// Zero means "one per CPU"; anything else is clamped to at least 1 so
+// a negative or malformed value degrades to the serial walk.
+static int resolveThreadCount(const MediaConfig &config) {
+        int n = config.getAs<int>(MediaConfig::CscThreads, 1);
+        if (n == 0) n = static_cast<int>(BasicThread::idealThreadCount());
+        if (n < 1) n = 1;
+        return n;
+}
+
 // --- Stage copy/move ---
 
 CSCPipeline::Stage::Stage(const Stage &other) {
@@ -94,13 +107,14 @@ CSCPipeline::Stage &CSCPipeline::Stage::operator=(Stage &&other) noexcept {
 CSCPipeline::CSCPipeline(const PixelFormat &src, const PixelFormat &dst, const MediaConfig &config)
     : _srcDesc(src), _dstDesc(dst), _config(config) {
         _useSimd = resolveUseSimd(_config);
+        _threadCount = resolveThreadCount(_config);
         compile();
 }
 
 // --- Global pipeline cache ---
 //
 // A compiled CSCPipeline is a pure function of (srcDesc, dstDesc,
-// useSimd): no image-specific state is ever stored, and execute() is
+// useSimd, threadCount): no image-specific state is ever stored, and execute() is
 // documented as thread-safe to call concurrently from multiple threads.
 // That makes it safe to share compiled pipelines process-wide via a
 // mutex-protected lookup table.  The alternative — constructing a
@@ -110,7 +124,7 @@ CSCPipeline::CSCPipeline(const PixelFormat &src, const PixelFormat &dst, const M
 
 namespace {
 
-        using CacheKey = std::tuple<const PixelFormat::Data *, const PixelFormat::Data *, bool>;
+        using CacheKey = std::tuple<const PixelFormat::Data *, const PixelFormat::Data *, bool, int>;
 
         struct CacheEntry {
                         CSCPipeline::Ptr pipeline;
@@ -134,10 +148,11 @@ namespace {
 } // anonymous
 
 CSCPipeline::Ptr CSCPipeline::cached(const PixelFormat &src, const PixelFormat &dst, const MediaConfig &config) {
-        // Mirror the useSimd derivation from the instance constructor
-        // so cache keys line up with actual pipeline behavior.
+        // Mirror the useSimd / threadCount derivation from the instance
+        // constructor so cache keys line up with actual pipeline behavior.
         const bool useSimd = resolveUseSimd(config);
-        CacheKey   key{src.data(), dst.data(), useSimd};
+        const int  threads = resolveThreadCount(config);
+        CacheKey   key{src.data(), dst.data(), useSimd, threads};
 
         {
                 Mutex::Locker lock(cacheMutex());
@@ -166,6 +181,20 @@ CSCPipeline::Ptr CSCPipeline::cached(const PixelFormat &src, const PixelFormat &
         return fresh;
 }
 
+ThreadPool &CSCPipeline::threadPool() {
+        // Local static so the destructor joins the workers at process
+        // exit (same reasoning as SharedThreadMediaIO::pool()).
+        struct PoolHolder {
+                        ThreadPool tp;
+                        PoolHolder() {
+                                tp.setNamePrefix("csc");
+                                tp.setName("csc");
+                        }
+        };
+        static PoolHolder h;
+        return h.tp;
+}
+
 // --- Stage kernel wrappers ---
 // These are the function pointers stored in Stage::func.  They adapt
 // between the uniform Stage callback signature and the specific kernel APIs.
@@ -969,11 +998,70 @@ Error CSCPipeline::execute(const UncompressedVideoPayload &src, UncompressedVide
                 return Error::Ok;
         }
 
-        const int srcPlaneCount = static_cast<int>(_srcDesc.planeCount());
-        const int dstPlaneCount = static_cast<int>(_dstDesc.planeCount());
+        if (_threadCount <= 1) return executeRows(src, dst, 0, height);
+
+        // Split the frame into bands of whole alignment units so no
+        // subsampled plane row or wire row is shared by two bands.
+        const size_t align = bandRowAlign();
+        const size_t units = (height + align - 1) / align;
+        size_t       bands = static_cast<size_t>(_threadCount);
+        const size_t maxBands = std::max<size_t>(1, height / MinRowsPerBand);
+        if (bands > maxBands) bands = maxBands;
+        if (bands > units) bands = units;
+        if (bands <= 1) return executeRows(src, dst, 0, height);
+
+        auto bandStart = [&](size_t b) { return std::min(height, (units * b / bands) * align); };
+
+        static const ThreadPool::WorkTag tag(String("CSCPipeline"));
+        ThreadPool                      &pool = threadPool();
+        List<Future<Error>>              pending;
+        pending.reserve(bands - 1);
+        for (size_t b = 1; b < bands; ++b) {
+                const size_t yBegin = bandStart(b);
+                const size_t yEnd = bandStart(b + 1);
+                pending.pushToBack(pool.submit(
+                        tag, [this, &src, &dst, yBegin, yEnd]() { return executeRows(src, dst, yBegin, yEnd); }));
+        }
+
+        // The caller converts the first band itself rather than idling
+        // while the pool does all the work.
+        Error err = executeRows(src, dst, 0, bandStart(1));
+        for (auto &f : pending) {
+                auto [bandErr, futErr] = f.result();
+                if (futErr.isError()) bandErr = futErr;
+                if (bandErr.isError() && err.isOk()) err = bandErr;
+        }
+        return err;
+}
+
+// Row alignment for band splits: the least common multiple of every
+// source and destination plane's vertical subsampling and of the
+// wire-row step (destination plane 0 vSubsampling, see executeRows).
+size_t CSCPipeline::bandRowAlign() const {
+        size_t align = 1;
+        for (const PixelFormat *pf : {&_srcDesc, &_dstDesc}) {
+                const PixelMemLayout &ml = pf->memLayout();
+                for (size_t p = 0; p < ml.planeCount(); ++p) {
+                        const size_t v = ml.planeDesc(p).vSubsampling;
+                        if (v > 1) align = std::lcm(align, v);
+                }
+        }
+        return align;
+}
+
+Error CSCPipeline::executeRows(const UncompressedVideoPayload &src, UncompressedVideoPayload &dst, size_t yBegin,
+                               size_t yEnd) const {
+        const ImageDesc &srcDesc = src.desc();
+        const ImageDesc &dstDesc = dst.desc();
+        const size_t     width = srcDesc.size().width();
+        const int        srcPlaneCount = static_cast<int>(_srcDesc.planeCount());
+        const int        dstPlaneCount = static_cast<int>(_dstDesc.planeCount());
 
-        CSCContext ctx(width);
-        if (!ctx.isValid()) return Error::NoMem;
+        // Reuse this thread's scratch context so steady-state conversion
+        // does no per-frame allocation (see CSCContext::acquire).
+        CSCContext::Lease lease = CSCContext::acquire(width);
+        if (!lease.isValid()) return Error::NoMem;
+        CSCContext &ctx = lease.context();
 
         // Destination plane 0 with @c vSubsampling > 1 signals a wire
         // layout whose byte rows each cover @c vSubsampling image
@@ -987,7 +1075,7 @@ Error CSCPipeline::execute(const UncompressedVideoPayload &src, UncompressedVide
                         ? _dstDesc.memLayout().planeDesc(0).vSubsampling
                         : 1;
 
-        for (size_t y = 0; y < height; y += dstYStep) {
+        for (size_t y = yBegin; y < yEnd; y += dstYStep) {
                 const void *srcLinePtrs[4] = {};
                 size_t      srcStrides[4] = {};
                 void       *dstLinePtrs[4] = {};
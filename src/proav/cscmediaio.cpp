@@ -159,6 +159,7 @@ MediaIOFactory::Config::SpecMap CscFactory::configSpecs() const {
         };
         s(MediaConfig::OutputPixelFormat, PixelFormat());
         s(MediaConfig::Capacity, int32_t(4));
+        s(MediaConfig::CscThreads, int32_t(1));
         return specs;
 }
 
@@ -187,6 +188,9 @@ Error CscMediaIO::executeCmd(MediaIOCommandOpen &cmd) {
         _capacity = cfg.getAs<int>(MediaConfig::Capacity, 4);
         if (_capacity < 1) _capacity = 1;
 
+        _cscThreads = cfg.getAs<int>(MediaConfig::CscThreads, 1);
+        if (_cscThreads < 0) _cscThreads = 1;
+
         MediaDesc outDesc;
         outDesc.setFrameRate(cmd.pendingMediaDesc.frameRate());
 
@@ -233,6 +237,7 @@ Error CscMediaIO::executeCmd(MediaIOCommandClose &cmd) {
         _outputQueue.clear();
         _outputPixelFormat = PixelFormat();
         _outputPixelFormatSet = false;
+        _cscThreads = 1;
         _frameCount = 0;
         _readCount = 0;
         _framesConverted = 0;
@@ -261,6 +266,7 @@ Error CscMediaIO::convertPayload(const UncompressedVideoPayload &input,
         }
 
         MediaConfig convertConfig;
+        convertConfig.set(MediaConfig::CscThreads, int32_t(_cscThreads));
         output = input.convert(_outputPixelFormat, input.desc().metadata(), convertConfig);
         if (!output.isValid()) {
                 promekiErr("CscMediaIO: convert %s -> %s failed", srcPd.name().cstr(),
@@ -20,6 +20,10 @@
 #include <promeki/atomic.h>
 #include <promeki/list.h>
 #include <promeki/mutex.h>
+#include <promeki/waitcondition.h>
+#include <promeki/sharedptr.h>
+#include <promeki/hostbufferimpl.h>
+#include <promeki/bufferview.h>
 #include <promeki/uncompressedvideopayload.h>
 #include <promeki/pcmaudiopayload.h>
 #include <promeki/metadata.h>
@@ -82,6 +86,216 @@ namespace {
                 return (n + (align - 1)) & ~(align - 1);
         }
 
+        // One image plane group's place in a slot.  Every plane starts
+        // on its own cache line; offsets are relative to the slot base.
+        struct ImageRegion {
+                        ImageDesc    desc;
+                        List<size_t> planeSizes;
+                        List<size_t> planeOffsets;
+                        size_t       offset = 0; // first plane
+                        size_t       bytes = 0;  // span of all planes, alignment included
+        };
+
+        // ========================================================================
+        // SlotArena — output-side slot ownership shared between the writer,
+        // the zero-copy allocator, and every slot-backed Buffer that
+        // allocator hands out.  Each slot carries two reference counts:
+        //
+        //   - leases: live producer Buffers carved out of the slot's image
+        //     region, dropped by a BufferImpl release callback on whichever
+        //     thread lets go of the last reference.  The writer also takes a
+        //     lease on the slot it is copying a frame into.
+        //   - consumerHolds: sync inputs that were sent the slot's TICK and
+        //     have not acknowledged it yet, dropped by the writer as ACKs
+        //     arrive or the input goes away.
+        //
+        // A slot is free only when both are zero.  As with V4l2RequeueGate,
+        // methods are const over mutable members so the allocator's const
+        // entry points and late release callbacks can drive the arena
+        // through a shared handle.  The arena outlives the bridge while
+        // leases are in flight: close() retires it, handing over the shm
+        // mapping, which is unmapped once the last lease is released.
+        // ========================================================================
+        struct SlotArena {
+                        struct Slot {
+                                        int leases = 0;
+                                        int consumerHolds = 0;
+                        };
+
+                        // Geometry — filled in by openOutput before the arena
+                        // is shared, read-only afterwards.
+                        uint8_t          *base = nullptr; // start of the shm mapping
+                        size_t            slotsOffset = 0;
+                        size_t            slotStride = 0;
+                        List<ImageRegion> images;
+
+                        mutable Mutex         mtx;
+                        mutable WaitCondition slotFreed;
+                        mutable List<Slot>    slots;
+                        mutable SharedMemory  orphan;       // mapping kept alive past close()
+                        mutable bool          retired = false;
+                        mutable uint64_t      cursor = 0;    // round-robin start for the next claim
+                        mutable uint64_t      fallbacks = 0; // allocator requests with no free slot
+
+                        uint8_t *slotBase(size_t index) const { return base + slotsOffset + index * slotStride; }
+
+                        // Returns the first image region @p desc fits, or -1.
+                        int regionFor(const ImageDesc &desc) const {
+                                for (size_t i = 0; i < images.size(); ++i) {
+                                        const ImageRegion &img = images[i];
+                                        if (desc.pixelFormat() != img.desc.pixelFormat()) continue;
+                                        if (static_cast<size_t>(desc.planeCount()) != img.planeSizes.size()) continue;
+                                        bool fits = true;
+                                        for (size_t p = 0; p < img.planeSizes.size() && fits; ++p) {
+                                                fits = desc.pixelFormat().planeSize(p, desc) == img.planeSizes[p];
+                                        }
+                                        if (fits) return static_cast<int>(i);
+                                }
+                                return -1;
+                        }
+
+                        // Takes a lease on a free slot and marks it mid-write
+                        // (odd seq) so async readers reject it while it is
+                        // being filled.  Returns -1 when no slot is free or
+                        // the arena has been retired.
+                        int lease(bool countFallback) const {
+                                Mutex::Locker lock(mtx);
+                                return leaseLocked(countFallback);
+                        }
+
+                        // Writer-side lease for a copy publish: like lease(),
+                        // but waits up to @p timeoutMs for a slot to free up.
+                        int claim(unsigned int timeoutMs) const {
+                                Mutex::Locker lock(mtx);
+                                int           idx = leaseLocked(false);
+                                if (idx < 0 && !retired) {
+                                        (void)slotFreed.wait(mtx, timeoutMs);
+                                        idx = leaseLocked(false);
+                                }
+                                return idx;
+                        }
+
+                        void releaseLease(size_t index) const {
+                                Mutex::Locker lock(mtx);
+                                if (slots[index].leases > 0) --slots[index].leases;
+                                if (retired) {
+                                        if (leaseCountLocked() == 0) orphan.close();
+                                        return;
+                                }
+                                slotFreed.wakeAll();
+                                return;
+                        }
+
+                        bool isLeased(size_t index) const {
+                                Mutex::Locker lock(mtx);
+                                return slots[index].leases > 0;
+                        }
+
+                        void hold(size_t index, int count) const {
+                                Mutex::Locker lock(mtx);
+                                slots[index].consumerHolds += count;
+                                return;
+                        }
+
+                        void releaseHold(size_t index) const {
+                                Mutex::Locker lock(mtx);
+                                if (slots[index].consumerHolds > 0) --slots[index].consumerHolds;
+                                if (slots[index].consumerHolds == 0) slotFreed.wakeAll();
+                                return;
+                        }
+
+                        uint64_t fallbackCount() const {
+                                Mutex::Locker lock(mtx);
+                                return fallbacks;
+                        }
+
+                        // Detaches the arena from a closing bridge.  When
+                        // slot-backed Buffers are still alive the mapping in
+                        // @p shm moves into the arena (name unlinked now, so
+                        // a reopen under the same name is unaffected) and is
+                        // unmapped when the last of them goes; otherwise
+                        // @p shm is left for the caller to close.
+                        void retire(SharedMemory &shm) const {
+                                Mutex::Locker lock(mtx);
+                                retired = true;
+                                for (auto &slot : slots) slot.consumerHolds = 0;
+                                if (leaseCountLocked() > 0) {
+                                        (void)shm.unlinkName();
+                                        orphan = std::move(shm);
+                                }
+                                slotFreed.wakeAll();
+                                return;
+                        }
+
+                private:
+                        int leaseLocked(bool countFallback) const {
+                                if (retired || slots.isEmpty()) return -1;
+                                const size_t n = slots.size();
+                                for (size_t i = 0; i < n; ++i) {
+                                        const size_t idx = static_cast<size_t>((cursor + i) % n);
+                                        Slot        &slot = slots[idx];
+                                        if (slot.leases != 0 || slot.consumerHolds != 0) continue;
+                                        ++slot.leases;
+                                        cursor = idx + 1;
+                                        AtomicRef<uint64_t> seq(*reinterpret_cast<uint64_t *>(slotBase(idx)));
+                                        seq.store(seq.load(MemoryOrder::Relaxed) | 1u, MemoryOrder::Release);
+                                        return static_cast<int>(idx);
+                                }
+                                if (countFallback) ++fallbacks;
+                                return -1;
+                        }
+
+                        int leaseCountLocked() const {
+                                int n = 0;
+                                for (const auto &slot : slots) n += slot.leases;
+                                return n;
+                        }
+        };
+
+        using SlotArenaPtr = SharedPtr<SlotArena, false>;
+
+        // Zero-copy allocator vended by FrameBridge::allocator().  A video
+        // payload in one of the bridge's image shapes is carved out of a
+        // leased slot as one Buffer spanning the first matching image
+        // region, sliced into planes at the offsets writeSlot would have
+        // copied them to.  The Buffer's release callback returns the
+        // lease.  Everything else (other shapes, audio, bytes, or no free
+        // slot) falls through to the default MediaIOAllocator behaviour.
+        class SlotAllocator : public MediaIOAllocator {
+                public:
+                        PROMEKI_SHARED_DERIVED(SlotAllocator)
+
+                        explicit SlotAllocator(const SlotArenaPtr &arena) : _arena(arena) {}
+
+                        String name() const override { return String("FrameBridgeSlotAllocator"); }
+
+                        UncompressedVideoPayload::Ptr allocateVideoPayload(const ImageDesc &desc) const override {
+                                const int r = _arena->regionFor(desc);
+                                if (r < 0) return MediaIOAllocator::allocateVideoPayload(desc);
+                                const int idx = _arena->lease(true);
+                                if (idx < 0) return MediaIOAllocator::allocateVideoPayload(desc);
+
+                                const ImageRegion &img = _arena->images[static_cast<size_t>(r)];
+                                const size_t       index = static_cast<size_t>(idx);
+                                uint8_t           *region = _arena->slotBase(index) + img.offset;
+                                auto *impl = new WrappedHostBufferImpl(MemSpace(MemSpace::System), region, img.bytes,
+                                                                       SlotAlign);
+                                SlotArenaPtr arena = _arena;
+                                impl->setReleaseCallback([arena, index]() { arena->releaseLease(index); });
+                                Buffer buf = Buffer::fromImpl(impl);
+                                buf.setSize(img.bytes);
+
+                                BufferView planes;
+                                for (size_t p = 0; p < img.planeSizes.size(); ++p) {
+                                        planes.pushToBack(buf, img.planeOffsets[p] - img.offset, img.planeSizes[p]);
+                                }
+                                return UncompressedVideoPayload::Ptr::create(desc, planes);
+                        }
+
+                private:
+                        SlotArenaPtr _arena;
+        };
+
 } // namespace
 
 // ============================================================================
@@ -111,7 +325,8 @@ struct FrameBridge::Impl {
                                 uint64_t slotsOffset;      // offset to slot 0
                                 uint64_t configBlobOffset; // DataStream blob (MediaDesc+AudioDesc)
                                 uint64_t configBlobSize;
-                                uint64_t reserved[16]; // padding / future extensions
+                                uint64_t ancReserveBytes; // per ANC stream
+                                uint64_t reserved[15];    // padding / future extensions
                 };
 
                 // Per-slot layout:
@@ -122,11 +337,15 @@ struct FrameBridge::Impl {
                 //   + 24   : int64_t  ptsDen
                 //   + 32   : uint32_t flags
                 //   + 36   : uint32_t metadataSize  (actual serialized bytes)
-                //   + 40   : uint64_t audioSampleCount
-                //   + 48   : reserved padding to metadata region
+                //   + 40   : reserved
+                //   + 48   : essence table — one uint64_t sample count per
+                //            audio track, then one uint64_t byte count per
+                //            ANC stream
                 //   + metadataOffset : metadata[metadataReserveBytes]
-                //   + imagesOffset   : packed image planes
-                //   + audioOffset    : audio samples (capacity = audioCapacitySamples)
+                //   then, each starting on its own cache line:
+                //     every image plane, image by image (see ImageRegion)
+                //     every audio track (capacity = audioCapacitySamples)
+                //     every ANC stream (capacity = ancReserveBytes)
                 struct SlotOffsets {
                                 size_t seqOff = 0;
                                 size_t frameNumberOff = 8;
@@ -134,10 +353,8 @@ struct FrameBridge::Impl {
                                 size_t ptsDenOff = 24;
                                 size_t flagsOff = 32;
                                 size_t metadataSizeOff = 36;
-                                size_t audioSampleCtOff = 40;
-                                size_t metadataOff = 64; // aligned
-                                size_t imagesOff = 0;    // filled in at init
-                                size_t audioOff = 0;
+                                size_t essenceTableOff = 48;
+                                size_t metadataOff = 64; // aligned, filled in at init
                 };
 
                 // ====================================================================
@@ -152,17 +369,20 @@ struct FrameBridge::Impl {
                 Role        role = RoleNone;
                 String      name;
                 UUID        uuid;
-                MediaDesc   mediaDesc;
-                AudioDesc   audioDesc;
+                MediaDesc   mediaDesc; // audio list holds every track
+                AudioDesc   audioDesc; // first audio track, if any
                 int         ringDepth = 0;
                 size_t      metadataReserveBytes = 0;
-                uint64_t    audioCapacitySamples = 0;
+                size_t      ancReserveBytes = 0;
+                uint64_t    audioCapacitySamples = 0; // per track
                 size_t      slotStride = 0;
                 SlotOffsets slotOff;
                 uint64_t    configHash = 0;
 
-                List<size_t> planeSizes; // per-plane size, cached from MediaDesc
-                size_t              imageBytesTotal = 0;
+                // Per-essence sub-regions of a slot, derived from mediaDesc.
+                List<ImageRegion> imageRegions;
+                List<size_t>      audioOffs;
+                List<size_t>      ancOffs;
 
                 SharedMemory shm;
                 String       shmName;
@@ -173,6 +393,7 @@ struct FrameBridge::Impl {
                 struct Client {
                                 LocalSocket::UPtr sock;
                                 bool              syncMode = true;
+                                bool              ackPending = false; // sent ackSeq's TICK, not yet ACKed
                 };
 
                 // Worker that owns the accept side of the output socket.
@@ -222,10 +443,22 @@ struct FrameBridge::Impl {
                 mutable Mutex   pendingMutex;
                 AcceptWorkerPtr acceptWorker;
                 uint64_t        nextFrameNumber = 0;
-                uint64_t        slotIndex = 0;           // which slot to write next
                 uint64_t        currentSeq = 0;          // seqlock: incremented by 2 per publish
                 TimeStamp       lastPublishTs;           // captured at publish time
                 bool            waitForConsumer = false; // output-side config flag
+                bool            zeroCopy = false;        // output-side config flag
+
+                // Slot ownership (see SlotArena) and the allocator vended
+                // to upstream stages in zero-copy mode.  ackSlot / ackSeq
+                // name the most recent publish whose sync ACKs are still
+                // outstanding; ackPending is false once they are in.
+                SlotArenaPtr          arena;
+                MediaIOAllocator::Ptr slotAllocator;
+                bool                  ackPending = false;
+                size_t                ackSlot = 0;
+                uint64_t              ackSeq = 0;
+                uint64_t              framesZeroCopy = 0;
+                uint64_t              framesCopied = 0;
 
                 // Thread-safe abort flag.  Set from any thread by
                 // FrameBridge::abort() (or as a side effect of close()); checked
@@ -255,33 +488,52 @@ struct FrameBridge::Impl {
 
                 // -------------- Geometry --------------
                 Error computeGeometry() {
-                        planeSizes.clear();
-                        imageBytesTotal = 0;
+                        imageRegions.clear();
                         if (!mediaDesc.isValid()) return Error::Invalid;
-                        const ImageDesc::List &imgs = mediaDesc.imageList();
-                        if (imgs.size() != 1) {
-                                // MVP restriction: exactly one image per frame.
-                                return Error::NotSupported;
-                        }
-                        const ImageDesc &id = imgs[0];
-                        int              nPlanes = id.planeCount();
-                        if (nPlanes <= 0) return Error::Invalid;
-                        for (int p = 0; p < nPlanes; ++p) {
-                                size_t sz = id.pixelFormat().planeSize(static_cast<size_t>(p), id);
-                                planeSizes.pushToBack(sz);
-                                imageBytesTotal += sz;
+                        for (const ImageDesc &id : mediaDesc.imageList()) {
+                                const int nPlanes = id.planeCount();
+                                if (nPlanes <= 0) return Error::Invalid;
+                                ImageRegion img;
+                                img.desc = id;
+                                for (int p = 0; p < nPlanes; ++p) {
+                                        img.planeSizes.pushToBack(
+                                                id.pixelFormat().planeSize(static_cast<size_t>(p), id));
+                                }
+                                imageRegions.pushToBack(std::move(img));
                         }
                         return Error::Ok;
                 }
 
-                size_t audioBytesTotal() const { return audioDesc.bufferSize(audioCapacitySamples); }
+                size_t audioTrackCount() const { return mediaDesc.audioList().size(); }
+                size_t ancStreamCount() const { return mediaDesc.ancList().size(); }
 
+                // Lays the essences out one after another, every plane,
+                // audio track and ANC stream on its own cache line so no
+                // two sub-regions share one between writer and readers.
                 void computeSlotLayout() {
-                        slotOff.metadataOff = roundUp(48, SlotAlign);
-                        slotOff.imagesOff = roundUp(slotOff.metadataOff + metadataReserveBytes, SlotAlign);
-                        slotOff.audioOff = roundUp(slotOff.imagesOff + imageBytesTotal, SlotAlign);
-                        size_t slotEnd = slotOff.audioOff + audioBytesTotal();
-                        slotStride = roundUp(slotEnd, SlotAlign);
+                        const size_t tableBytes = (audioTrackCount() + ancStreamCount()) * sizeof(uint64_t);
+                        slotOff.metadataOff = roundUp(slotOff.essenceTableOff + tableBytes, SlotAlign);
+                        size_t off = roundUp(slotOff.metadataOff + metadataReserveBytes, SlotAlign);
+                        for (ImageRegion &img : imageRegions) {
+                                img.offset = off;
+                                img.planeOffsets.clear();
+                                for (size_t sz : img.planeSizes) {
+                                        img.planeOffsets.pushToBack(off);
+                                        off = roundUp(off + sz, SlotAlign);
+                                }
+                                img.bytes = off - img.offset;
+                        }
+                        audioOffs.clear();
+                        for (const AudioDesc &ad : mediaDesc.audioList()) {
+                                audioOffs.pushToBack(off);
+                                off = roundUp(off + ad.bufferSize(audioCapacitySamples), SlotAlign);
+                        }
+                        ancOffs.clear();
+                        for (size_t i = 0; i < ancStreamCount(); ++i) {
+                                ancOffs.pushToBack(off);
+                                off = roundUp(off + ancReserveBytes, SlotAlign);
+                        }
+                        slotStride = off;
                 }
 
                 uint64_t computeConfigHash() const {
@@ -300,7 +552,7 @@ struct FrameBridge::Impl {
                         DataStream ws = DataStream::createWriter(&dev);
                         ws << mediaDesc << audioDesc << static_cast<uint32_t>(ringDepth)
                            << static_cast<uint32_t>(metadataReserveBytes)
-                           << static_cast<uint64_t>(audioCapacitySamples);
+                           << static_cast<uint64_t>(audioCapacitySamples) << static_cast<uint64_t>(ancReserveBytes);
                         size_t n = static_cast<size_t>(dev.pos());
                         return fnv1aData(blob.data(), n);
                 }
@@ -330,14 +582,21 @@ struct FrameBridge::Impl {
                         return Error::Ok;
                 }
 
+                // Per-track capacity, sized for the fastest track so one
+                // count covers them all.
                 uint64_t worstCaseAudioSamples(double headroom) const {
                         // nominal samples = sampleRate / frameRate
-                        double rate = static_cast<double>(audioDesc.sampleRate());
                         double fps = mediaDesc.frameRate().toDouble();
-                        if (fps <= 0.0 || rate <= 0.0) return 0;
-                        double nominal = std::ceil(rate / fps);
-                        double withHeadroom = std::ceil(nominal * (1.0 + headroom));
-                        return static_cast<uint64_t>(withHeadroom);
+                        if (fps <= 0.0) return 0;
+                        uint64_t worst = 0;
+                        for (const AudioDesc &ad : mediaDesc.audioList()) {
+                                double rate = static_cast<double>(ad.sampleRate());
+                                if (rate <= 0.0) continue;
+                                double nominal = std::ceil(rate / fps);
+                                double withHeadroom = std::ceil(nominal * (1.0 + headroom));
+                                worst = std::max(worst, static_cast<uint64_t>(withHeadroom));
+                        }
+                        return worst;
                 }
 
                 // -------------- Slot addressing --------------
@@ -588,6 +847,7 @@ struct FrameBridge::Impl {
                         }
                         metadataReserveBytes = hdr->metadataReserveBytes;
                         audioCapacitySamples = hdr->audioCapacitySamples;
+                        ancReserveBytes = static_cast<size_t>(hdr->ancReserveBytes);
                         computeGeometry();   // uses mediaDesc from handshake
                         computeSlotLayout(); // rebuilds slotOff for reads
 
@@ -603,13 +863,71 @@ struct FrameBridge::Impl {
                 }
 
                 // -------------- Slot write --------------
+                //
+                // Everything that can fail (metadata and ANC
+                // serialization, audio capacity) is checked before the
+                // slot goes odd, so an error leaves the slot exactly as it
+                // was.  Images whose planes already occupy their region
+                // of this slot (built with the zero-copy allocator, see
+                // inPlaceSlot) are not copied.
                 Error writeSlot(uint64_t index, const Frame &frame) {
                         uint8_t *base = slotBase(index);
                         if (base == nullptr) return Error::NotOpen;
-                        // Seqlock: advance to odd (writing).
-                        uint64_t seq = AtomicRef<uint64_t>(*reinterpret_cast<uint64_t *>(base + slotOff.seqOff))
-                                               .load(MemoryOrder::Relaxed);
-                        seq += 1; // odd
+
+                        // Metadata blob.
+                        Buffer metaTmp(metadataReserveBytes);
+                        size_t metaBytes = 0;
+                        {
+                                BufferIODevice dev(&metaTmp);
+                                dev.open(IODevice::ReadWrite);
+                                DataStream ws = DataStream::createWriter(&dev);
+                                ws << frame.metadata();
+                                if (ws.status() != DataStream::Ok) return Error::OutOfRange;
+                                metaBytes = static_cast<size_t>(dev.pos());
+                                if (metaBytes > metadataReserveBytes) return Error::OutOfRange;
+                        }
+
+                        // Audio: the N-th PCM payload fills the N-th track.
+                        List<const PcmAudioPayload *> pcm;
+                        auto                          auds = frame.audioPayloads();
+                        for (size_t t = 0; t < audioTrackCount(); ++t) {
+                                const PcmAudioPayload *uap = nullptr;
+                                if (t < auds.size() && auds[t].isValid()) {
+                                        uap = auds[t]->as<PcmAudioPayload>();
+                                        if (uap != nullptr && uap->planeCount() == 0) uap = nullptr;
+                                        if (uap != nullptr && uap->sampleCount() > audioCapacitySamples) {
+                                                return Error::OutOfRange;
+                                        }
+                                }
+                                pcm.pushToBack(uap);
+                        }
+
+                        // ANC: each payload is serialized whole, so the
+                        // reader gets back the same AncPayload.
+                        List<Buffer> ancBlobs;
+                        List<size_t> ancBytes;
+                        size_t       ancSeen = 0;
+                        for (const MediaPayload::Ptr &p : frame.payloadList()) {
+                                if (ancSeen >= ancStreamCount()) break;
+                                if (!p.isValid() || p->kind() != MediaPayloadKind::AncillaryData) continue;
+                                ++ancSeen;
+                                Buffer         blob(ancReserveBytes);
+                                BufferIODevice dev(&blob);
+                                dev.open(IODevice::ReadWrite);
+                                DataStream ws = DataStream::createWriter(&dev);
+                                ws << p;
+                                if (ws.status() != DataStream::Ok) return Error::OutOfRange;
+                                const size_t n = static_cast<size_t>(dev.pos());
+                                if (n > ancReserveBytes) return Error::OutOfRange;
+                                ancBlobs.pushToBack(blob);
+                                ancBytes.pushToBack(n);
+                        }
+
+                        // Seqlock: advance to odd (writing).  Seqs come from
+                        // the bridge-wide counter rather than the slot's own,
+                        // so a TICK / ACK seq names exactly one publish even
+                        // when slots are not reused in ring order.
+                        uint64_t seq = currentSeq + 1; // odd
                         storeSeq(base + slotOff.seqOff, seq);
 
                         // Write per-slot header fields.
@@ -632,69 +950,50 @@ struct FrameBridge::Impl {
                         put64s(slotOff.ptsDenOff, ptsDen);
                         put32(slotOff.flagsOff, 0u);
 
-                        // Metadata blob.
-                        size_t metaBytes = 0;
-                        {
-                                Buffer         tmp(metadataReserveBytes);
-                                BufferIODevice dev(&tmp);
-                                dev.open(IODevice::ReadWrite);
-                                DataStream ws = DataStream::createWriter(&dev);
-                                ws << frame.metadata();
-                                if (ws.status() != DataStream::Ok) {
-                                        // Restore even seq before returning so reader
-                                        // sees a consistent (stale) slot.
-                                        storeSeq(base + slotOff.seqOff, seq + 1);
-                                        return Error::OutOfRange;
-                                }
-                                metaBytes = static_cast<size_t>(dev.pos());
-                                if (metaBytes > metadataReserveBytes) {
-                                        storeSeq(base + slotOff.seqOff, seq + 1);
-                                        return Error::OutOfRange;
-                                }
-                                std::memcpy(base + slotOff.metadataOff, tmp.data(), metaBytes);
-                        }
+                        std::memcpy(base + slotOff.metadataOff, metaTmp.data(), metaBytes);
                         put32(slotOff.metadataSizeOff, static_cast<uint32_t>(metaBytes));
 
-                        // Images (single image for MVP).
+                        // Images: the N-th video payload fills the N-th region.
                         auto vids = frame.videoPayloads();
-                        if (!vids.isEmpty() && vids[0].isValid()) {
-                                const auto *uvp = vids[0]->as<UncompressedVideoPayload>();
-                                if (uvp != nullptr) {
-                                        size_t       off = slotOff.imagesOff;
-                                        const size_t n = uvp->planeCount();
-                                        for (size_t p = 0; p < n && p < planeSizes.size(); ++p) {
-                                                auto plane = uvp->plane(p);
-                                                if (plane.isValid()) {
-                                                        size_t copyBytes = planeSizes[p];
-                                                        if (plane.size() < copyBytes) {
-                                                                copyBytes = plane.size();
-                                                        }
-                                                        std::memcpy(base + off, plane.data(), copyBytes);
-                                                }
-                                                off += planeSizes[p];
-                                        }
+                        for (size_t i = 0; i < imageRegions.size() && i < vids.size(); ++i) {
+                                if (arena && slotHoldingImage(vids[i], imageRegions[i]) == static_cast<int>(index)) {
+                                        continue;
+                                }
+                                if (!vids[i].isValid()) continue;
+                                const auto *uvp = vids[i]->as<UncompressedVideoPayload>();
+                                if (uvp == nullptr) continue;
+                                const ImageRegion &img = imageRegions[i];
+                                const size_t       n = uvp->planeCount();
+                                for (size_t p = 0; p < n && p < img.planeSizes.size(); ++p) {
+                                        auto plane = uvp->plane(p);
+                                        if (!plane.isValid()) continue;
+                                        size_t copyBytes = img.planeSizes[p];
+                                        if (plane.size() < copyBytes) copyBytes = plane.size();
+                                        std::memcpy(base + img.planeOffsets[p], plane.data(), copyBytes);
                                 }
                         }
 
-                        // Audio (single track for MVP).
-                        uint64_t audioSamples = 0;
-                        auto     auds = frame.audioPayloads();
-                        if (!auds.isEmpty() && auds[0].isValid()) {
-                                const auto *uap = auds[0]->as<PcmAudioPayload>();
-                                if (uap != nullptr && uap->planeCount() > 0) {
-                                        const size_t samples = uap->sampleCount();
-                                        if (samples > audioCapacitySamples) {
-                                                storeSeq(base + slotOff.seqOff, seq + 1);
-                                                return Error::OutOfRange;
-                                        }
-                                        audioSamples = samples;
-                                        auto         pv = uap->plane(0);
-                                        const size_t bytes = audioDesc.bufferSize(samples);
+                        for (size_t t = 0; t < audioTrackCount(); ++t) {
+                                uint64_t audioSamples = 0;
+                                if (pcm[t] != nullptr) {
+                                        audioSamples = pcm[t]->sampleCount();
+                                        auto         pv = pcm[t]->plane(0);
+                                        const size_t bytes = mediaDesc.audioList()[t].bufferSize(
+                                                static_cast<size_t>(audioSamples));
                                         const size_t copyBytes = pv.size() < bytes ? pv.size() : bytes;
-                                        std::memcpy(base + slotOff.audioOff, pv.data(), copyBytes);
+                                        std::memcpy(base + audioOffs[t], pv.data(), copyBytes);
+                                }
+                                put64(slotOff.essenceTableOff + t * sizeof(uint64_t), audioSamples);
+                        }
+
+                        for (size_t a = 0; a < ancStreamCount(); ++a) {
+                                uint64_t n = 0;
+                                if (a < ancBlobs.size()) {
+                                        n = ancBytes[a];
+                                        std::memcpy(base + ancOffs[a], ancBlobs[a].data(), ancBytes[a]);
                                 }
+                                put64(slotOff.essenceTableOff + (audioTrackCount() + a) * sizeof(uint64_t), n);
                         }
-                        put64(slotOff.audioSampleCtOff, audioSamples);
 
                         // Advance seq to even (stable).
                         seq += 1;
@@ -704,6 +1003,67 @@ struct FrameBridge::Impl {
                         return Error::Ok;
                 }
 
+                // Returns the slot whose image region @p vid's planes
+                // already occupy (at region @p img), or -1.
+                int slotHoldingImage(const VideoPayload::Ptr &vid, const ImageRegion &img) const {
+                        if (!vid.isValid()) return -1;
+                        const auto *uvp = vid->as<UncompressedVideoPayload>();
+                        if (uvp == nullptr || uvp->planeCount() != img.planeSizes.size()) return -1;
+
+                        const uintptr_t first = reinterpret_cast<uintptr_t>(uvp->plane(0).data());
+                        const uintptr_t region0 = reinterpret_cast<uintptr_t>(slotBase(0) + img.offset);
+                        if (first < region0) return -1;
+                        const uintptr_t delta = first - region0;
+                        if (delta % slotStride != 0) return -1;
+                        const size_t index = static_cast<size_t>(delta / slotStride);
+                        if (index >= static_cast<size_t>(ringDepth)) return -1;
+
+                        for (size_t p = 0; p < img.planeSizes.size(); ++p) {
+                                auto            plane = uvp->plane(p);
+                                const uintptr_t want = first + (img.planeOffsets[p] - img.offset);
+                                if (reinterpret_cast<uintptr_t>(plane.data()) != want) return -1;
+                                if (plane.size() < img.planeSizes[p]) return -1;
+                        }
+                        return static_cast<int>(index);
+                }
+
+                // Returns the slot a frame built with the zero-copy
+                // allocator already occupies, or -1 if the frame has to
+                // be copied.  The first image sitting in its own region
+                // of some slot picks the slot; writeSlot copies in any
+                // image that lives elsewhere (for example in a second
+                // slot the allocator leased for a same-shaped image).
+                int inPlaceSlot(const Frame &frame) const {
+                        if (!arena) return -1;
+                        auto vids = frame.videoPayloads();
+                        for (size_t i = 0; i < imageRegions.size() && i < vids.size(); ++i) {
+                                const int slot = slotHoldingImage(vids[i], imageRegions[i]);
+                                if (slot < 0) continue;
+                                // The lease is what keeps the slot from being
+                                // handed out again while this frame is alive.
+                                return arena->isLeased(static_cast<size_t>(slot)) ? slot : -1;
+                        }
+                        return -1;
+                }
+
+                // Leases a free slot for a copy publish, waiting while
+                // every slot is leased upstream or held by inputs that
+                // have not ACKed it.  Bounded by the sync ACK budget and
+                // woken promptly by abort().
+                Error claimSlot(size_t &indexOut) {
+                        const unsigned int pollMs = 100;
+                        const int          maxAttempts = std::max(1, static_cast<int>(SyncAckTimeoutMs / pollMs));
+                        for (int tries = 0; tries < maxAttempts; ++tries) {
+                                if (abortFlag.value()) return Error::Cancelled;
+                                const int idx = arena->claim(pollMs);
+                                if (idx >= 0) {
+                                        indexOut = static_cast<size_t>(idx);
+                                        return Error::Ok;
+                                }
+                        }
+                        return Error::Timeout;
+                }
+
                 // -------------- Slot read --------------
                 Frame readSlot(uint64_t index, Error *errOut) {
                         const uint8_t *base = slotBase(index);
@@ -712,6 +1072,9 @@ struct FrameBridge::Impl {
                                 return Frame();
                         }
 
+                        const size_t nAudio = audioTrackCount();
+                        const size_t nAnc = ancStreamCount();
+
                         // Seqlock: read seq1, copy, read seq2; retry on torn read
                         // but cap retries to avoid infinite loop when writer laps us.
                         for (int attempt = 0; attempt < 4; ++attempt) {
@@ -720,7 +1083,7 @@ struct FrameBridge::Impl {
                                         // Writer mid-publish — brief spin.
                                         continue;
                                 }
-                                uint64_t frameNumber = 0, audioSamples = 0;
+                                uint64_t frameNumber = 0;
                                 int64_t  ptsNum = 0, ptsDen = 1;
                                 uint32_t flags = 0, metaSize = 0;
                                 std::memcpy(&frameNumber, base + slotOff.frameNumberOff, 8);
@@ -728,10 +1091,18 @@ struct FrameBridge::Impl {
                                 std::memcpy(&ptsDen, base + slotOff.ptsDenOff, 8);
                                 std::memcpy(&flags, base + slotOff.flagsOff, 4);
                                 std::memcpy(&metaSize, base + slotOff.metadataSizeOff, 4);
-                                std::memcpy(&audioSamples, base + slotOff.audioSampleCtOff, 8);
-                                if (metaSize > metadataReserveBytes || audioSamples > audioCapacitySamples) {
-                                        continue;
+                                if (metaSize > metadataReserveBytes) continue;
+
+                                List<uint64_t> counts;
+                                bool           sane = true;
+                                for (size_t e = 0; e < nAudio + nAnc; ++e) {
+                                        uint64_t v = 0;
+                                        std::memcpy(&v, base + slotOff.essenceTableOff + e * sizeof(uint64_t), 8);
+                                        const uint64_t cap = e < nAudio ? audioCapacitySamples : ancReserveBytes;
+                                        if (v > cap) sane = false;
+                                        counts.pushToBack(v);
                                 }
+                                if (!sane) continue;
 
                                 // Build the Frame.  We copy everything into fresh
                                 // buffers so the reader doesn't hold stale slot
@@ -751,37 +1122,49 @@ struct FrameBridge::Impl {
                                         rs >> meta;
                                 }
 
-                                // Video payload (single video, multi-plane)
-                                UncompressedVideoPayload::Ptr videoPayload;
-                                if (!mediaDesc.imageList().isEmpty()) {
-                                        const ImageDesc &id = mediaDesc.imageList()[0];
-                                        BufferView       planes;
-                                        size_t           off = slotOff.imagesOff;
-                                        int              n = id.planeCount();
-                                        for (int p = 0; p < n && p < static_cast<int>(planeSizes.size()); ++p) {
-                                                size_t sz = planeSizes[p];
+                                // Video payloads, one per image region.
+                                List<UncompressedVideoPayload::Ptr> videoPayloads;
+                                for (const ImageRegion &img : imageRegions) {
+                                        BufferView planes;
+                                        for (size_t p = 0; p < img.planeSizes.size(); ++p) {
+                                                size_t sz = img.planeSizes[p];
                                                 auto   buf = Buffer(sz);
                                                 buf.setSize(sz);
                                                 if (sz > 0) {
-                                                        std::memcpy(buf.data(), base + off, sz);
+                                                        std::memcpy(buf.data(), base + img.planeOffsets[p], sz);
                                                 }
                                                 planes.pushToBack(buf, 0, sz);
-                                                off += sz;
                                         }
-                                        videoPayload = UncompressedVideoPayload::Ptr::create(id, planes);
+                                        videoPayloads.pushToBack(
+                                                UncompressedVideoPayload::Ptr::create(img.desc, planes));
                                 }
 
-                                // Audio payload (single track)
-                                PcmAudioPayload::Ptr audioPayload;
-                                if (audioSamples > 0) {
-                                        size_t bytes = audioDesc.bufferSize(static_cast<size_t>(audioSamples));
-                                        auto   buf = Buffer(bytes);
+                                // Audio payloads, one per non-empty track.
+                                List<PcmAudioPayload::Ptr> audioPayloads;
+                                for (size_t t = 0; t < nAudio; ++t) {
+                                        const uint64_t samples = counts[t];
+                                        if (samples == 0) continue;
+                                        const AudioDesc &ad = mediaDesc.audioList()[t];
+                                        size_t           bytes = ad.bufferSize(static_cast<size_t>(samples));
+                                        auto             buf = Buffer(bytes);
                                         buf.setSize(bytes);
-                                        std::memcpy(buf.data(), base + slotOff.audioOff, bytes);
+                                        std::memcpy(buf.data(), base + audioOffs[t], bytes);
                                         BufferView planes;
                                         planes.pushToBack(buf, 0, bytes);
-                                        audioPayload = PcmAudioPayload::Ptr::create(
-                                                audioDesc, static_cast<size_t>(audioSamples), planes);
+                                        audioPayloads.pushToBack(
+                                                PcmAudioPayload::Ptr::create(ad, static_cast<size_t>(samples), planes));
+                                }
+
+                                // ANC blobs are only copied inside the window;
+                                // they are decoded once the read is known good.
+                                List<Buffer> ancBlobs;
+                                for (size_t a = 0; a < nAnc; ++a) {
+                                        const size_t bytes = static_cast<size_t>(counts[nAudio + a]);
+                                        if (bytes == 0) continue;
+                                        Buffer buf(bytes);
+                                        buf.setSize(bytes);
+                                        std::memcpy(buf.data(), base + ancOffs[a], bytes);
+                                        ancBlobs.pushToBack(buf);
                                 }
 
                                 // Check seq2 after we've copied everything.
@@ -789,8 +1172,16 @@ struct FrameBridge::Impl {
                                 uint64_t seq2 = loadSeq(base + slotOff.seqOff);
                                 if (seq1 != seq2) continue; // torn — retry
 
-                                if (videoPayload) frame.addPayload(videoPayload);
-                                if (audioPayload) frame.addPayload(audioPayload);
+                                for (auto &vp : videoPayloads) frame.addPayload(vp);
+                                for (auto &ap : audioPayloads) frame.addPayload(ap);
+                                for (Buffer &blob : ancBlobs) {
+                                        BufferIODevice dev(&blob);
+                                        dev.open(IODevice::ReadOnly);
+                                        DataStream        rs = DataStream::createReader(&dev);
+                                        MediaPayload::Ptr p;
+                                        rs >> p;
+                                        if (rs.status() == DataStream::Ok && p.isValid()) frame.addPayload(p);
+                                }
                                 frame.metadata() = meta;
                                 frame.metadata().set(Metadata::FrameNumber, FrameNumber(int64_t(frameNumber)));
                                 if (errOut) *errOut = Error::Ok;
@@ -855,19 +1246,23 @@ struct FrameBridge::Impl {
 
                 // -------------- Wait for ACKs (output-side, sync clients) --------------
                 //
-                // Called after TICK emission.  Blocks until every still-connected
-                // sync client either acknowledges @p seq or is determined to be
-                // dead (dropped).  No-op when no sync clients are attached.
-                void waitForAcks(uint64_t seq) {
+                // Blocks until every sync client that was sent the TICK for
+                // ackSeq either acknowledges it or is determined to be dead
+                // (dropped); either way that client's hold on ackSlot is
+                // released.  Copy mode calls this right after TICK emission;
+                // zero-copy mode defers it to just before the next TICK.
+                // No-op when no ACKs are outstanding.
+                void waitForAcks() {
+                        if (!ackPending) return;
+                        const uint64_t seq = ackSeq;
                         for (auto it = clients.begin(); it != clients.end();) {
                                 if (abortFlag.value()) return;
                                 Client &cl = *it;
                                 if (!cl.sock || !cl.sock->isConnected()) {
-                                        if (owner) owner->peerDisconnectedSignal.emit();
-                                        it = clients.remove(it);
+                                        it = dropClient(it);
                                         continue;
                                 }
-                                if (!cl.syncMode) {
+                                if (!cl.ackPending) {
                                         ++it;
                                         continue;
                                 }
@@ -910,19 +1305,29 @@ struct FrameBridge::Impl {
                                                 continue;
                                         }
                                         if (f.value.size() < AckPayloadBytes) continue;
-                                        uint64_t ackSeq = rd64(static_cast<const uint8_t *>(f.value.data()));
+                                        uint64_t gotSeq = rd64(static_cast<const uint8_t *>(f.value.data()));
                                         // The publisher may still be catching up on
                                         // an old sync client's ACK after a burst.
                                         // Accept any ack >= seq as "we're caught up".
-                                        if (ackSeq >= seq) acked = true;
+                                        if (gotSeq >= seq) acked = true;
                                 }
                                 if (!acked || dead) {
-                                        if (owner) owner->peerDisconnectedSignal.emit();
-                                        it = clients.remove(it);
+                                        it = dropClient(it);
                                 } else {
+                                        cl.ackPending = false;
+                                        arena->releaseHold(ackSlot);
                                         ++it;
                                 }
                         }
+                        ackPending = false;
+                }
+
+                // Removes a client, releasing its hold on ackSlot if it
+                // still owed an ACK.  Returns the next iterator.
+                List<Client>::Iterator dropClient(List<Client>::Iterator it) {
+                        if (it->ackPending && arena) arena->releaseHold(ackSlot);
+                        if (owner) owner->peerDisconnectedSignal.emit();
+                        return clients.remove(it);
                 }
 
                 // -------------- Connection servicing --------------
@@ -946,8 +1351,7 @@ struct FrameBridge::Impl {
                                 if (it->sock && it->sock->isConnected()) {
                                         ++it;
                                 } else {
-                                        if (owner) owner->peerDisconnectedSignal.emit();
-                                        it = clients.remove(it);
+                                        it = dropClient(it);
                                 }
                         }
                 }
@@ -1021,12 +1425,22 @@ Error FrameBridge::openOutput(const String &name, const Config &config) {
         }
         _d->role = Impl::RoleOutput;
         _d->name = name;
+        // Every audio track lives in the MediaDesc's audio list; the
+        // single-track Config::audioDesc is folded in when the list is
+        // empty, and audioDesc() keeps reporting the first track.
         _d->mediaDesc = config.mediaDesc;
-        _d->audioDesc = config.audioDesc;
+        if (_d->mediaDesc.audioList().isEmpty() && config.audioDesc.isValid()) {
+                _d->mediaDesc.audioList().pushToBack(config.audioDesc);
+        }
+        _d->audioDesc = _d->mediaDesc.audioList().isEmpty() ? AudioDesc() : _d->mediaDesc.audioList()[0];
         _d->ringDepth = config.ringDepth > 0 ? config.ringDepth : DefaultRingDepth;
         _d->metadataReserveBytes = config.metadataReserveBytes;
+        _d->ancReserveBytes = config.ancReserveBytes;
         _d->uuid = UUID::generateV4();
         _d->waitForConsumer = config.waitForConsumer;
+        _d->zeroCopy = config.zeroCopy;
+        _d->framesZeroCopy = 0;
+        _d->framesCopied = 0;
         _d->abortFlag.setValue(false);
         _d->audioCapacitySamples = _d->worstCaseAudioSamples(config.audioHeadroomFraction);
 
@@ -1099,6 +1513,7 @@ Error FrameBridge::openOutput(const String &name, const Config &config) {
         hdr->ringDepth = static_cast<uint32_t>(_d->ringDepth);
         hdr->metadataReserveBytes = static_cast<uint32_t>(_d->metadataReserveBytes);
         hdr->audioCapacitySamples = _d->audioCapacitySamples;
+        hdr->ancReserveBytes = _d->ancReserveBytes;
         hdr->slotStride = _d->slotStride;
         hdr->configBlobOffset = roundUp(sizeof(Impl::BridgeHeader), SlotAlign);
         size_t used = 0;
@@ -1111,6 +1526,20 @@ Error FrameBridge::openOutput(const String &name, const Config &config) {
         hdr->configBlobSize = used;
         hdr->slotsOffset = roundUp(hdr->configBlobOffset + used, SlotAlign);
 
+        // Slot ownership, used by copy and zero-copy publishing alike.
+        _d->arena = SlotArenaPtr::create();
+        {
+                SlotArena *arena = _d->arena.modify();
+                arena->base = static_cast<uint8_t *>(_d->shm.data());
+                arena->slotsOffset = hdr->slotsOffset;
+                arena->slotStride = _d->slotStride;
+                arena->images = _d->imageRegions;
+                for (int i = 0; i < _d->ringDepth; ++i) arena->slots.pushToBack(SlotArena::Slot());
+        }
+        if (_d->zeroCopy) {
+                _d->slotAllocator = MediaIOAllocator::Ptr::takeOwnership(new SlotAllocator(_d->arena));
+        }
+
         // Listen on the control socket.
         // Make sure Dir::ipc() exists so the socket file can be created.
         Dir::ipc().mkpath();
@@ -1199,6 +1628,12 @@ void FrameBridge::close() {
                 }
                 _d->clients.clear();
                 _d->server.close();
+                // Slot-backed Buffers handed out by the allocator may
+                // still be alive; retiring the arena keeps their memory
+                // mapped until the last one is released.
+                if (_d->arena) _d->arena->retire(_d->shm);
+                _d->arena.clear();
+                _d->slotAllocator = MediaIOAllocator::Ptr();
         } else if (_d->role == Impl::RoleInput) {
                 if (_d->client.isConnected()) {
                         KlvWriter w(&_d->client);
@@ -1212,11 +1647,14 @@ void FrameBridge::close() {
         _d->audioDesc = AudioDesc();
         _d->ringDepth = 0;
         _d->slotStride = 0;
-        _d->slotIndex = 0;
         _d->nextFrameNumber = 0;
         _d->currentSeq = 0;
         _d->lastPublishTs = TimeStamp();
         _d->waitForConsumer = false;
+        _d->zeroCopy = false;
+        _d->ackPending = false;
+        _d->ackSlot = 0;
+        _d->ackSeq = 0;
         // Leave abortFlag latched here; openOutput / openInput clear
         // it when the bridge is reopened.  This keeps writeFrame
         // returning Cancelled rather than resuming silently if some
@@ -1229,8 +1667,12 @@ void FrameBridge::close() {
         _d->lastTickFrame = 0;
         _d->lastTickTs = TimeStamp();
         _d->pendingAckSeq = 0;
-        _d->planeSizes.clear();
-        _d->imageBytesTotal = 0;
+        _d->imageRegions.clear();
+        _d->audioOffs.clear();
+        _d->ancOffs.clear();
+        _d->metadataReserveBytes = 0;
+        _d->ancReserveBytes = 0;
+        _d->audioCapacitySamples = 0;
         _d->uuid = UUID();
         _d->name = String();
         _d->shmName = String();
@@ -1287,6 +1729,20 @@ void FrameBridge::service() {
         _d->pruneDeadClients();
 }
 
+MediaIOAllocator::Ptr FrameBridge::allocator() const {
+        if (_d->role != Impl::RoleOutput || !_d->slotAllocator) return MediaIOAllocator::defaultAllocator();
+        return _d->slotAllocator;
+}
+
+FrameBridge::Stats FrameBridge::stats() const {
+        Stats st;
+        if (_d->role != Impl::RoleOutput) return st;
+        st.framesZeroCopy = _d->framesZeroCopy;
+        st.framesCopied = _d->framesCopied;
+        if (_d->arena) st.allocatorFallbacks = _d->arena->fallbackCount();
+        return st;
+}
+
 size_t FrameBridge::connectionCount() const {
         if (_d->role != Impl::RoleOutput) return 0;
         size_t n = 0;
@@ -1343,30 +1799,74 @@ Error FrameBridge::writeFrame(const Frame &frame) {
                 }
         }
 
-        uint64_t idx = _d->slotIndex;
+        // Zero-copy mode collects the previous frame's sync ACKs here,
+        // just before the next TICK, rather than at the end of the
+        // previous writeFrame — the producer gets to build this frame
+        // while the consumers were still reading the last one.
+        _d->waitForAcks();
+        if (_d->abortFlag.value()) return Error::Cancelled;
+
+        // A frame built with allocator() already sits in its slot;
+        // anything else is copied into a free one.
+        size_t    idx = 0;
+        const int inPlace = _d->inPlaceSlot(frame);
+        if (inPlace >= 0) {
+                idx = static_cast<size_t>(inPlace);
+        } else {
+                Error err = _d->claimSlot(idx);
+                if (err.isError()) {
+                        if (err == Error::Timeout) {
+                                promekiWarn("FrameBridge::writeFrame('%s'): no free slot within %u ms",
+                                            _d->name.cstr(), SyncAckTimeoutMs);
+                        }
+                        return err;
+                }
+        }
+
         // Stamp the publish time just before the slot goes live.  Read
         // back from _d->lastPublishTs (set inside writeSlot) for the
         // on-wire value to keep the public accessor and the TICK in
         // lockstep.
         Error err = _d->writeSlot(idx, frame);
-        if (err.isError()) return err;
+        if (err.isError()) {
+                if (inPlace < 0) _d->arena->releaseLease(idx);
+                return err;
+        }
+        if (inPlace >= 0) {
+                ++_d->framesZeroCopy;
+        } else {
+                ++_d->framesCopied;
+        }
         int64_t tsNs = _d->lastPublishTs.nanoseconds();
 
-        // Broadcast TICK to each client.
+        // Broadcast TICK to each client.  Every sync client that gets
+        // the TICK holds the slot until it ACKs.
+        int holds = 0;
         for (auto it = _d->clients.begin(); it != _d->clients.end();) {
                 if (it->sock && it->sock->isConnected()) {
                         _d->emitTick(*it->sock, static_cast<uint32_t>(idx), _d->currentSeq, _d->nextFrameNumber, tsNs);
+                        if (it->syncMode) {
+                                it->ackPending = true;
+                                ++holds;
+                        }
                         ++it;
                 } else {
-                        if (_d->owner) _d->owner->peerDisconnectedSignal.emit();
-                        it = _d->clients.remove(it);
+                        it = _d->dropClient(it);
                 }
         }
+        if (holds > 0) {
+                _d->arena->hold(idx, holds);
+                _d->ackPending = true;
+                _d->ackSlot = idx;
+                _d->ackSeq = _d->currentSeq;
+        }
+        // Only drop the copy's lease once the holds are registered, so
+        // the allocator can't hand the slot out in between.
+        if (inPlace < 0) _d->arena->releaseLease(idx);
 
-        // Block on any sync clients' ACKs before returning.
-        _d->waitForAcks(_d->currentSeq);
+        // Copy mode blocks on the sync clients' ACKs before returning.
+        if (!_d->zeroCopy) _d->waitForAcks();
 
-        _d->slotIndex = (idx + 1) % static_cast<uint64_t>(_d->ringDepth);
         ++_d->nextFrameNumber;
         return Error::Ok;
 }
@@ -73,11 +73,13 @@ MediaIOFactory::Config::SpecMap FrameBridgeFactory::configSpecs() const {
         s(MediaConfig::FrameBridgeName, String());
         s(MediaConfig::FrameBridgeRingDepth, int32_t(2));
         s(MediaConfig::FrameBridgeMetadataReserveBytes, int32_t(64 * 1024));
+        s(MediaConfig::FrameBridgeAncReserveBytes, int32_t(16 * 1024));
         s(MediaConfig::FrameBridgeAudioHeadroomFraction, 0.20);
         s(MediaConfig::FrameBridgeAccessMode, int32_t(0600));
         s(MediaConfig::FrameBridgeGroupName, String());
         s(MediaConfig::FrameBridgeSyncMode, true);
         s(MediaConfig::FrameBridgeWaitForConsumer, true);
+        s(MediaConfig::FrameBridgeZeroCopy, false);
         return specs;
 }
 
@@ -125,15 +127,23 @@ Error FrameBridgeMediaIO::executeCmd(MediaIOCommandOpen &cmd) {
                 bcfg.ringDepth = cfg.getAs<int32_t>(MediaConfig::FrameBridgeRingDepth, int32_t(2));
                 bcfg.metadataReserveBytes = static_cast<size_t>(
                         cfg.getAs<int32_t>(MediaConfig::FrameBridgeMetadataReserveBytes, int32_t(64 * 1024)));
+                bcfg.ancReserveBytes = static_cast<size_t>(
+                        cfg.getAs<int32_t>(MediaConfig::FrameBridgeAncReserveBytes, int32_t(16 * 1024)));
                 bcfg.audioHeadroomFraction = cfg.getAs<double>(MediaConfig::FrameBridgeAudioHeadroomFraction, 0.20);
                 bcfg.accessMode =
                         static_cast<uint32_t>(cfg.getAs<int32_t>(MediaConfig::FrameBridgeAccessMode, int32_t(0600)));
                 bcfg.groupName = cfg.getAs<String>(MediaConfig::FrameBridgeGroupName, String());
                 bcfg.waitForConsumer = cfg.getAs<bool>(MediaConfig::FrameBridgeWaitForConsumer, true);
+                bcfg.zeroCopy = cfg.getAs<bool>(MediaConfig::FrameBridgeZeroCopy, false);
 
                 Error err = _bridge->openOutput(name, bcfg);
                 if (err.isError()) return err;
 
+                // Upstream producers reach the bridge's slot allocator
+                // via port->allocator() and render straight into the
+                // ring, so writeFrame publishes without an image copy.
+                if (bcfg.zeroCopy) setAllocator(_bridge->allocator());
+
                 resolved = bcfg.mediaDesc;
                 frameRate = bcfg.mediaDesc.frameRate();
         } else {
@@ -173,6 +183,9 @@ Error FrameBridgeMediaIO::executeCmd(MediaIOCommandOpen &cmd) {
 Error FrameBridgeMediaIO::executeCmd(MediaIOCommandClose &cmd) {
         (void)cmd;
         if (_bridge) _bridge->close();
+        // A closed bridge's slot allocator only hands out heap planes;
+        // revert to the default so it doesn't linger on this MediaIO.
+        if (_isOutput) setAllocator(MediaIOAllocator::Ptr());
         return Error::Ok;
 }
 
@@ -27,6 +27,7 @@
 #include <promeki/metadata.h>
 #include <promeki/pcmaudiopayload.h>
 #include <promeki/stringlist.h>
+#include <promeki/threadpool.h>
 #include <promeki/timecode.h>
 #include <promeki/uncompressedvideopayload.h>
 #include <promeki/videopayload.h>
@@ -160,6 +161,27 @@ static bool probeImageDevice(IODevice *device) {
         return false;
 }
 
+// ============================================================================
+// Sequence read-ahead / write-behind pool
+// ============================================================================
+//
+// Shared by every ImageFileMediaIO.  Kept apart from
+// SharedThreadMediaIO::pool() because these tasks spend most of their
+// time blocked in file I/O, and a deep read-ahead must not starve
+// other backends' strands of workers.
+
+static ThreadPool &imageSeqThreadPool() {
+        struct PoolHolder {
+                        ThreadPool tp;
+                        PoolHolder() {
+                                tp.setNamePrefix("imgseq");
+                                tp.setName("imgseq");
+                        }
+        };
+        static PoolHolder h;
+        return h.tp;
+}
+
 // ============================================================================
 // Shared config / metadata schemas
 // ============================================================================
@@ -179,6 +201,8 @@ static MediaIOFactory::Config::SpecMap imageFileConfigSpecs() {
         s(MediaConfig::VideoPixelFormat, PixelFormat());
         s(MediaConfig::FrameRate, ImageFileMediaIO::DefaultFrameRate);
         s(MediaConfig::SequenceHead, int32_t(ImageFileMediaIO::DefaultSequenceHead));
+        s(MediaConfig::ImageSeqReadAhead, int32_t(4));
+        s(MediaConfig::ImageSeqWriteBehind, int32_t(4));
         s(MediaConfig::SaveImgSeqEnabled, true);
         s(MediaConfig::SaveImgSeqPath, String());
         s(MediaConfig::SaveImgSeqPathMode, ImgSeqPathMode::Relative);
@@ -554,6 +578,8 @@ Error ImageFileMediaIO::openSequence(MediaIOCommandOpen &cmd, MediaDesc &mediaDe
         _seqMetadata = sidecarMeta;
         _seqSize = hintSize;
         _seqPixelFormat = hintPixel;
+        _seqReadAhead = cfg.getAs<int>(MediaConfig::ImageSeqReadAhead, 4);
+        _seqWriteBehind = cfg.getAs<int>(MediaConfig::ImageSeqWriteBehind, 4);
 
         _imageFileID = cfg.getAs<int>(MediaConfig::ImageFileID, ImageFile::Invalid);
         if (_imageFileID == ImageFile::Invalid) {
@@ -619,16 +645,18 @@ Error ImageFileMediaIO::openSequence(MediaIOCommandOpen &cmd, MediaDesc &mediaDe
                 _seqIndex = 0;
                 _seqAtEnd = false;
 
+                // The geometry hint (only headerless formats use it) is
+                // built once and shared by every load of the sequence.
+                if (_seqSize.width() > 0 && _seqSize.height() > 0 && _seqPixelFormat.isValid()) {
+                        _seqHint = Frame();
+                        _seqHint.addPayload(
+                                UncompressedVideoPayload::Ptr::create(ImageDesc(_seqSize, _seqPixelFormat)));
+                }
+
                 String    firstPath = (dir / pattern.name(static_cast<int>(head))).toString();
                 ImageFile imgFile(_imageFileID);
                 imgFile.setFilename(firstPath);
-                if (_seqSize.width() > 0 && _seqSize.height() > 0 && _seqPixelFormat.isValid()) {
-                        ImageDesc idesc(_seqSize, _seqPixelFormat);
-                        auto      hint = UncompressedVideoPayload::Ptr::create(idesc);
-                        Frame     hintFrame;
-                        hintFrame.addPayload(hint);
-                        imgFile.setFrame(hintFrame);
-                }
+                if (_seqHint.isValid()) imgFile.setFrame(_seqHint);
                 Error err = imgFile.load(_ioConfig);
                 if (err.isError()) {
                         promekiErr("ImageFileMediaIO: failed to load head frame '%s': %s", firstPath.cstr(),
@@ -655,6 +683,15 @@ Error ImageFileMediaIO::openSequence(MediaIOCommandOpen &cmd, MediaDesc &mediaDe
                 mediaDesc.metadata() = meta;
                 frameCount = FrameCount(_seqTail.value() - _seqHead.value() + 1);
 
+                // The head frame is what the first read asks for; keep it
+                // instead of loading it twice, and start the read-ahead.
+                _seqHeld = f;
+                _seqHeld.metadata().merge(_seqMetadata);
+                _seqHeld.metadata().set(Metadata::FrameNumber, FrameNumber(head));
+                _seqHeldIndex = 0;
+                _seqLastStep = 1;
+                if (_seqReadAhead > 0) primeReadAhead(_seqLastStep, frameCount.value());
+
                 // --- Audio source selection (reader) ---
                 bool hasEmbeddedAudio = !mediaDesc.audioList().isEmpty();
                 bool hasSidecarAudio = false;
@@ -880,6 +917,10 @@ Error ImageFileMediaIO::writeImgSeqSidecar() {
 
 Error ImageFileMediaIO::executeCmd(MediaIOCommandClose &cmd) {
         (void)cmd;
+        // Every frame the writer accepted must be on disk before the
+        // sidecar describes it.
+        Error result = drainWrites(0);
+        cancelReadAhead();
         if (_isWrite && _sequenceMode) {
                 writeImgSeqSidecar();
         }
@@ -914,6 +955,12 @@ Error ImageFileMediaIO::executeCmd(MediaIOCommandClose &cmd) {
         _seqMetadata = Metadata();
         _seqSize = Size2Du32();
         _seqPixelFormat = PixelFormat();
+        _seqHint = Frame();
+        _seqReadAhead = 0;
+        _seqWriteBehind = 0;
+        _seqHeldIndex = -1;
+        _seqHeld = Frame();
+        _seqLastStep = 1;
 
         _sidecarAudio = AudioFile();
         _sidecarAudioDesc = AudioDesc();
@@ -922,7 +969,7 @@ Error ImageFileMediaIO::executeCmd(MediaIOCommandClose &cmd) {
         _sidecarSampleRate = 0;
         _sidecarAudioEnabled = true;
         _sidecarAudioName = String();
-        return Error::Ok;
+        return result;
 }
 
 // ============================================================================
@@ -960,28 +1007,9 @@ Error ImageFileMediaIO::readSequence(MediaIOCommandRead &cmd) {
                 return Error::EndOfFile;
         }
 
-        int64_t frameNum = _seqHead.value() + _seqIndex.value();
-        String  fn = (_seqDir / _seqName.name(static_cast<int>(frameNum))).toString();
-
-        ImageFile imgFile(_imageFileID);
-        imgFile.setFilename(fn);
-        if (_seqSize.width() > 0 && _seqSize.height() > 0 && _seqPixelFormat.isValid()) {
-                ImageDesc idesc(_seqSize, _seqPixelFormat);
-                auto      hint = UncompressedVideoPayload::Ptr::create(idesc);
-                Frame     hintFrame;
-                hintFrame.addPayload(hint);
-                imgFile.setFrame(hintFrame);
-        }
-        Error err = imgFile.load(_ioConfig);
-        if (err.isError()) {
-                promekiErr("ImageFileMediaIO: failed to load sequence frame '%s': %s", fn.cstr(), err.name().cstr());
-                return err;
-        }
-
-        Frame frame = imgFile.frame();
-        Metadata  &fm = frame.metadata();
-        fm.merge(_seqMetadata);
-        fm.set(Metadata::FrameNumber, FrameNumber(frameNum));
+        Frame frame;
+        Error err = takeSeqFrame(_seqIndex.value(), frame);
+        if (err.isError()) return err;
 
         if (_sidecarAudioOpen) {
                 size_t               spf = _sidecarFrameRate.samplesPerFrame(_sidecarSampleRate, _seqIndex.value());
@@ -1012,13 +1040,147 @@ Error ImageFileMediaIO::readSequence(MediaIOCommandRead &cmd) {
                 // Hold on the same frame — no state change.
         } else {
                 _seqIndex += int64_t(step);
+                _seqLastStep = step;
                 if (!_seqIndex.isValid() || _seqIndex.value() >= length) {
                         _seqAtEnd = true;
                 }
         }
+        if (_seqReadAhead > 0 && !_seqAtEnd) primeReadAhead(_seqLastStep, length);
+        return Error::Ok;
+}
+
+String ImageFileMediaIO::seqFilename(int64_t index) const {
+        return (_seqDir / _seqName.name(static_cast<int>(_seqHead.value() + index))).toString();
+}
+
+ImageFileMediaIO::SeqLoad ImageFileMediaIO::loadSeqFile(int imageFileID, const String &filename, const Frame &hint,
+                                                        const MediaConfig &config) {
+        ImageFile imgFile(imageFileID);
+        imgFile.setFilename(filename);
+        if (hint.isValid()) imgFile.setFrame(hint);
+        SeqLoad load;
+        load.err = imgFile.load(config);
+        if (load.err.isError()) {
+                promekiErr("ImageFileMediaIO: failed to load sequence frame '%s': %s", filename.cstr(),
+                           load.err.name().cstr());
+                return load;
+        }
+        load.frame = imgFile.frame();
+        return load;
+}
+
+Error ImageFileMediaIO::saveSeqFile(int imageFileID, const String &filename, const Frame &frame,
+                                    const MediaConfig &config) {
+        ImageFile imgFile(imageFileID);
+        imgFile.setFilename(filename);
+        imgFile.setFrame(frame);
+        Error err = imgFile.save(config);
+        if (err.isError()) {
+                promekiErr("ImageFileMediaIO: save sequence frame '%s' failed: %s", filename.cstr(),
+                           err.name().cstr());
+        }
+        return err;
+}
+
+Error ImageFileMediaIO::takeSeqFrame(int64_t index, Frame &frame) {
+        if (index == _seqHeldIndex) {
+                frame = _seqHeld;
+                return Error::Ok;
+        }
+
+        SeqLoad load;
+        bool    found = false;
+        for (size_t i = 0; i < _seqPrefetch.size(); i++) {
+                if (_seqPrefetch[i].index != index) continue;
+                auto [done, futureErr] = _seqPrefetch[i].result.result();
+                load = std::move(done);
+                if (futureErr.isError()) load.err = futureErr;
+                _seqPrefetch.remove(i);
+                found = true;
+                break;
+        }
+        // A miss (seek, rate change, direction flip) loads the frame
+        // here; primeReadAhead() re-aims the window afterwards and
+        // drops whatever no longer fits it.
+        if (!found) load = loadSeqFile(_imageFileID, seqFilename(index), _seqHint, _ioConfig);
+        if (load.err.isError()) return load.err;
+
+        frame = std::move(load.frame);
+        Metadata &fm = frame.metadata();
+        fm.merge(_seqMetadata);
+        fm.set(Metadata::FrameNumber, FrameNumber(_seqHead.value() + index));
+        _seqHeld = frame;
+        _seqHeldIndex = index;
         return Error::Ok;
 }
 
+void ImageFileMediaIO::primeReadAhead(int step, int64_t length) {
+        // The indices the next reads will ask for if the step holds.
+        // Fractional rates alternate between two step sizes, so some
+        // of these miss; those loads are simply dropped next time.
+        List<int64_t> want;
+        int64_t       next = _seqIndex.value();
+        for (int k = 0; k < _seqReadAhead && next >= 0 && next < length; k++, next += step) {
+                want.pushToBack(next);
+        }
+
+        for (size_t i = 0; i < _seqPrefetch.size();) {
+                if (want.contains(_seqPrefetch[i].index)) {
+                        i++;
+                        continue;
+                }
+                _seqPrefetch[i].cancel.modify()->setValue(true);
+                _seqPrefetch.remove(i);
+        }
+
+        for (int64_t index : want) {
+                if (index == _seqHeldIndex) continue;
+                bool queued = false;
+                for (const SeqPrefetch &p : _seqPrefetch) {
+                        if (p.index == index) {
+                                queued = true;
+                                break;
+                        }
+                }
+                if (queued) continue;
+
+                SeqPrefetch slot;
+                slot.index = index;
+                slot.cancel = SeqCancel::create(false);
+                const int         id = _imageFileID;
+                const String      filename = seqFilename(index);
+                const Frame       hint = _seqHint;
+                const MediaConfig config = _ioConfig;
+                const SeqCancel   cancel = slot.cancel;
+                slot.result = imageSeqThreadPool().submit([id, filename, hint, config, cancel]() -> SeqLoad {
+                        if (cancel->value()) return SeqLoad{Frame(), Error::Cancelled};
+                        return loadSeqFile(id, filename, hint, config);
+                });
+                _seqPrefetch.pushToBack(std::move(slot));
+        }
+        return;
+}
+
+void ImageFileMediaIO::cancelReadAhead() {
+        // Loads already running finish on the pool and are discarded
+        // with their futures; the ones still queued return at once.
+        for (SeqPrefetch &p : _seqPrefetch) p.cancel.modify()->setValue(true);
+        _seqPrefetch.clear();
+        return;
+}
+
+Error ImageFileMediaIO::drainWrites(size_t keep) {
+        while (!_seqSaves.isEmpty() && (_seqSaves.size() > keep || _seqSaves[0].isReady())) {
+                auto [saveErr, futureErr] = _seqSaves[0].result();
+                _seqSaves.remove(static_cast<size_t>(0));
+                if (futureErr.isError()) saveErr = futureErr;
+                if (saveErr.isError() && _seqSaveError.isOk()) _seqSaveError = saveErr;
+        }
+        Error err = _seqSaveError;
+        _seqSaveError = Error::Ok;
+        return err;
+}
+
 Error ImageFileMediaIO::executeCmd(MediaIOCommandWrite &cmd) {
         return _sequenceMode ? writeSequence(cmd) : writeSingle(cmd);
 }
@@ -1052,13 +1214,18 @@ Error ImageFileMediaIO::writeSequence(MediaIOCommandWrite &cmd) {
         merged.merge(frame.metadata());
         frame.metadata() = std::move(merged);
 
-        ImageFile imgFile(_imageFileID);
-        imgFile.setFilename(fn);
-        imgFile.setFrame(frame);
-        Error err = imgFile.save(_ioConfig);
-        if (err.isError()) {
-                promekiErr("ImageFileMediaIO: save sequence frame '%s' failed: %s", fn.cstr(), err.name().cstr());
-                return err;
+        if (_seqWriteBehind > 0) {
+                // Make room in the window, surfacing any save that
+                // failed since the last write.
+                Error err = drainWrites(static_cast<size_t>(_seqWriteBehind - 1));
+                if (err.isError()) return err;
+                const int         id = _imageFileID;
+                const MediaConfig config = _ioConfig;
+                _seqSaves.pushToBack(imageSeqThreadPool().submit(
+                        [id, fn, frame, config]() -> Error { return saveSeqFile(id, fn, frame, config); }));
+        } else {
+                Error err = saveSeqFile(_imageFileID, fn, frame, _ioConfig);
+                if (err.isError()) return err;
         }
 
         if (_sidecarAudioOpen) {
@@ -1112,6 +1279,8 @@ Error ImageFileMediaIO::executeCmd(MediaIOCommandSeek &cmd) {
         if (target >= length) target = length - 1;
         _seqIndex = FrameNumber(target);
         _seqAtEnd = false;
+        // The next read re-aims the window from the new position.
+        cancelReadAhead();
 
         if (_sidecarAudioOpen) {
                 size_t targetSample =
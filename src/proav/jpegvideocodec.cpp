@@ -13,6 +13,9 @@
 #include <algorithm>
 
 #include <promeki/list.h>
+#include <promeki/basicthread.h>
+#include <promeki/threadpool.h>
+#include <promeki/future.h>
 #include <promeki/jpegvideocodec.h>
 #include <promeki/mediaconfig.h>
 #include <promeki/buffer.h>
@@ -66,6 +69,225 @@ namespace {
                 promekiWarn("jpeg: %s", buf);
         }
 
+        // One libjpeg-turbo compressor / decompressor with its error
+        // manager wired up.  The session pImpls own one each; stripe
+        // workers keep a thread-local one (see workerCompressState).
+        struct CompressState {
+                        jpeg_compress_struct cinfo{};
+                        JpegErrorMgr         jerr{};
+                        bool                 created = false;
+
+                        CompressState() {
+                                cinfo.err = jpeg_std_error(&jerr.pub);
+                                jerr.pub.error_exit = jpegErrorExit;
+                                jerr.pub.output_message = jpegOutputMessage;
+                                // libjpeg's create can longjmp on OOM during state
+                                // allocation; guard with a setjmp so the partially-
+                                // initialized struct doesn't leak.
+                                if (setjmp(jerr.jmpBuf)) {
+                                        created = false;
+                                        return;
+                                }
+                                jpeg_create_compress(&cinfo);
+                                created = true;
+                        }
+
+                        ~CompressState() {
+                                if (created) jpeg_destroy_compress(&cinfo);
+                        }
+
+                        CompressState(const CompressState &) = delete;
+                        CompressState &operator=(const CompressState &) = delete;
+        };
+
+        struct DecompressState {
+                        jpeg_decompress_struct dinfo{};
+                        JpegErrorMgr           jerr{};
+                        bool                   created = false;
+                        List<uint8_t>          stripe; // scratch bitstream for slice-parallel decode
+
+                        DecompressState() {
+                                dinfo.err = jpeg_std_error(&jerr.pub);
+                                jerr.pub.error_exit = jpegErrorExit;
+                                jerr.pub.output_message = jpegOutputMessage;
+                                if (setjmp(jerr.jmpBuf)) {
+                                        created = false;
+                                        return;
+                                }
+                                jpeg_create_decompress(&dinfo);
+                                created = true;
+                        }
+
+                        ~DecompressState() {
+                                if (created) jpeg_destroy_decompress(&dinfo);
+                        }
+
+                        DecompressState(const DecompressState &) = delete;
+                        DecompressState &operator=(const DecompressState &) = delete;
+        };
+
+        static CompressState &workerCompressState() {
+                static thread_local CompressState state;
+                return state;
+        }
+
+        static DecompressState &workerDecompressState() {
+                static thread_local DecompressState state;
+                return state;
+        }
+
+        // Process-wide pool the stripe workers run on.  Kept apart from
+        // SharedThreadMediaIO::pool() for the same reason as
+        // CSCPipeline::threadPool(): a codec strand blocks on its
+        // stripes, and running them on the strand's own pool could
+        // starve it of workers.
+        static ThreadPool &jpegThreadPool() {
+                struct PoolHolder {
+                                ThreadPool tp;
+                                PoolHolder() {
+                                        tp.setNamePrefix("jpeg");
+                                        tp.setName("jpeg");
+                                }
+                };
+                static PoolHolder h;
+                return h.tp;
+        }
+
+        // Resolves @ref MediaConfig::JpegThreads to a stripe count.
+        static int resolveThreadCount(const MediaConfig &config) {
+                int n = config.getAs<int>(MediaConfig::JpegThreads, 1);
+                if (n == 0) n = static_cast<int>(BasicThread::idealThreadCount());
+                return n < 1 ? 1 : n;
+        }
+
+        // ---------------------------------------------------------------------------
+        // Bitstream layout — the marker offsets the stripe split and stitch
+        // paths need, found by walking the segments from SOI.
+        // ---------------------------------------------------------------------------
+
+        static constexpr uint8_t MarkerSOI = 0xD8;
+        static constexpr uint8_t MarkerEOI = 0xD9;
+        static constexpr uint8_t MarkerRST0 = 0xD0;
+        static constexpr uint8_t MarkerDRI = 0xDD;
+        static constexpr uint8_t MarkerSOS = 0xDA;
+
+        // Largest MCU count a DRI segment can name.
+        static constexpr int MaxRestartInterval = 0xFFFF;
+
+        struct JpegLayout {
+                        size_t   sofPos = 0;  // FF Cn marker
+                        size_t   sosPos = 0;  // FF DA marker
+                        size_t   ecsPos = 0;  // first entropy-coded byte
+                        size_t   ecsEnd = 0;  // marker that ends the scan
+                        uint16_t restartInterval = 0;
+                        int      width = 0;
+                        int      height = 0;
+                        int      mcuWidth = 0;
+                        int      mcuHeight = 0;
+
+                        int mcusPerRow() const { return (width + mcuWidth - 1) / mcuWidth; }
+                        int mcuRows() const { return (height + mcuHeight - 1) / mcuHeight; }
+        };
+
+        // Parses a single-scan baseline / extended-sequential Huffman JPEG.
+        // When @p restarts is non-null the entropy-coded segment is scanned
+        // and every RSTn offset recorded; otherwise the scan is assumed to
+        // run up to the trailing EOI, which holds for libjpeg's own output.
+        // Returns false for anything the stripe paths cannot handle
+        // (progressive, arithmetic, lossless, truncated).
+        static bool parseJpegLayout(const uint8_t *data, size_t size, JpegLayout &layout,
+                                    List<size_t> *restarts = nullptr) {
+                if (size < 4 || data[0] != 0xFF || data[1] != MarkerSOI) return false;
+                size_t pos = 2;
+                while (pos + 3 < size) {
+                        if (data[pos] != 0xFF) return false;
+                        const uint8_t marker = data[pos + 1];
+                        if (marker == 0xFF) {
+                                pos++;
+                                continue;
+                        }
+                        const size_t segLen = (size_t(data[pos + 2]) << 8) | data[pos + 3];
+                        if (segLen < 2 || pos + 2 + segLen > size) return false;
+                        if (marker == 0xC0 || marker == 0xC1) {
+                                if (segLen < 8) return false;
+                                layout.sofPos = pos;
+                                layout.height = (int(data[pos + 5]) << 8) | data[pos + 6];
+                                layout.width = (int(data[pos + 7]) << 8) | data[pos + 8];
+                                const int comps = data[pos + 9];
+                                if (comps < 1 || segLen < size_t(8 + 3 * comps)) return false;
+                                int maxH = 1, maxV = 1;
+                                for (int c = 0; c < comps; c++) {
+                                        const uint8_t hv = data[pos + 11 + 3 * c];
+                                        maxH = std::max(maxH, int(hv >> 4));
+                                        maxV = std::max(maxV, int(hv & 0x0F));
+                                }
+                                // A single-component scan is non-interleaved: its
+                                // MCU is one block whatever the sampling factors.
+                                if (comps == 1) maxH = maxV = 1;
+                                layout.mcuWidth = DCTSIZE * maxH;
+                                layout.mcuHeight = DCTSIZE * maxV;
+                        } else if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+                                   marker != 0xCC) {
+                                return false;
+                        } else if (marker == MarkerDRI) {
+                                if (segLen < 4) return false;
+                                layout.restartInterval = (uint16_t(data[pos + 4]) << 8) | data[pos + 5];
+                        } else if (marker == MarkerSOS) {
+                                layout.sosPos = pos;
+                                layout.ecsPos = pos + 2 + segLen;
+                                break;
+                        }
+                        pos += 2 + segLen;
+                }
+                if (layout.sofPos == 0 || layout.sosPos == 0 || layout.width <= 0 || layout.height <= 0) return false;
+
+                if (restarts == nullptr) {
+                        layout.ecsEnd = size;
+                        if (size >= 2 && data[size - 2] == 0xFF && data[size - 1] == MarkerEOI) layout.ecsEnd -= 2;
+                        return true;
+                }
+                size_t i = layout.ecsPos;
+                layout.ecsEnd = size;
+                while (i + 1 < size) {
+                        if (data[i] != 0xFF) {
+                                i++;
+                                continue;
+                        }
+                        const uint8_t m = data[i + 1];
+                        if (m == 0x00) {
+                                i += 2;
+                        } else if (m >= MarkerRST0 && m <= MarkerRST0 + 7) {
+                                restarts->pushToBack(i);
+                                i += 2;
+                        } else if (m == 0xFF) {
+                                i++;
+                        } else {
+                                layout.ecsEnd = i;
+                                break;
+                        }
+                }
+                return true;
+        }
+
+        static void putBigEndian16(uint8_t *p, int v) {
+                p[0] = static_cast<uint8_t>((v >> 8) & 0xFF);
+                p[1] = static_cast<uint8_t>(v & 0xFF);
+                return;
+        }
+
+        // One finished libjpeg-turbo bitstream (malloc'd by jpeg_mem_dest).
+        struct JpegBitstream {
+                        unsigned char *data = nullptr;
+                        unsigned long  size = 0;
+
+                        void release() {
+                                free(data);
+                                data = nullptr;
+                                size = 0;
+                                return;
+                        }
+        };
+
         // ---------------------------------------------------------------------------
         // Input format classification
         // ---------------------------------------------------------------------------
@@ -222,12 +444,12 @@ namespace {
         // branch calls jpeg_abort_compress to return cinfo to the
         // "ready for next image" state without destroying it.
 
-        static CompressedVideoPayload::Ptr encodeRGB(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr,
-                                                     const UncompressedVideoPayload &input, int quality,
-                                                     JpegVideoEncoder::Subsampling subsampling) {
+        static bool encodeRGB(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr, const UncompressedVideoPayload &input,
+                              int rowBegin, int rowCount, int quality, JpegVideoEncoder::Subsampling subsampling,
+                              JpegBitstream &out) {
                 const ImageDesc      &idesc = input.desc();
                 int                   width = (int)idesc.size().width();
-                int                   height = (int)idesc.size().height();
+                int                   height = rowCount;
                 const PixelFormat    &pd = idesc.pixelFormat();
                 const PixelMemLayout &ml = pd.memLayout();
 
@@ -235,7 +457,7 @@ namespace {
                         promekiWarnThrottled(1000, "JpegVideoEncoder::encodeRGB: libjpeg longjmp from %dx%d %s",
                                              width, height, pd.name().cstr());
                         jpeg_abort_compress(&cinfo);
-                        return CompressedVideoPayload::Ptr();
+                        return false;
                 }
 
                 // Pixel-format-derived state is set up *after* the setjmp so
@@ -282,47 +504,36 @@ namespace {
 
                 jpeg_start_compress(&cinfo, TRUE);
                 size_t         stride = ml.lineStride(0, width);
-                const uint8_t *pixels = input.plane(0).data();
+                const uint8_t *pixels = input.plane(0).data() + rowBegin * stride;
                 while (cinfo.next_scanline < cinfo.image_height) {
                         const uint8_t *row = pixels + cinfo.next_scanline * stride;
                         JSAMPROW       rowPtr = const_cast<JSAMPROW>(row);
                         jpeg_write_scanlines(&cinfo, &rowPtr, 1);
                 }
                 jpeg_finish_compress(&cinfo);
-
-                // Build the CompressedVideoPayload directly — copy the JPEG
-                // bitstream into an owned Buffer (libjpeg malloc'd outBuffer).
-                PixelFormat::ID jpegPd = jpegPixelFormatFor(pd.id());
-                ImageDesc       cdesc(Size2Du32(width, height), PixelFormat(jpegPd));
-                cdesc.metadata() = idesc.metadata();
-                Buffer buf = Buffer(outSize);
-                std::memcpy(buf.data(), outBuffer, outSize);
-                buf.setSize(outSize);
-                free(outBuffer);
-                BufferView view(buf, 0, outSize);
-                auto       cvp = CompressedVideoPayload::Ptr::create(cdesc, view);
-                cvp.modify()->metadata() = idesc.metadata();
-                return cvp;
+                out.data = outBuffer;
+                out.size = outSize;
+                return true;
         }
 
         // ---------------------------------------------------------------------------
         // Encode — YCbCr raw data path (all layouts)
         // ---------------------------------------------------------------------------
 
-        static CompressedVideoPayload::Ptr encodeYCbCr(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr,
-                                                       const UncompressedVideoPayload &input, int quality,
-                                                       YCbCrInfo info) {
+        static bool encodeYCbCr(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr,
+                                const UncompressedVideoPayload &input, int rowBegin, int rowCount, int quality,
+                                YCbCrInfo info, JpegBitstream &out) {
                 const ImageDesc      &idesc = input.desc();
                 const PixelMemLayout &ml = idesc.pixelFormat().memLayout();
                 int                   width = (int)idesc.size().width();
-                int                   height = (int)idesc.size().height();
+                int                   height = rowCount;
                 int                   chromaWidth = width / 2;
 
                 if (setjmp(jerr.jmpBuf)) {
                         promekiWarnThrottled(1000, "JpegVideoEncoder::encodeYCbCr: libjpeg longjmp from %dx%d %s",
                                              width, height, idesc.pixelFormat().name().cstr());
                         jpeg_abort_compress(&cinfo);
-                        return CompressedVideoPayload::Ptr();
+                        return false;
                 }
 
                 unsigned char *outBuffer = nullptr;
@@ -372,26 +583,29 @@ namespace {
                 const uint8_t *srcY = nullptr, *srcCb = nullptr, *srcCr = nullptr, *srcCbCr = nullptr;
                 size_t         strideY = 0, strideCb = 0, strideCr = 0, strideCbCr = 0, strideInterleaved = 0;
 
+                // A stripe starts on an MCU row, so for 4:2:0 rowBegin is
+                // even and the chroma planes start at rowBegin / 2.
+                const size_t chromaBegin = info.is420 ? rowBegin / 2 : rowBegin;
                 switch (info.layout) {
                         case LayoutPlanar422:
                         case LayoutPlanar420:
-                                srcY = input.plane(0).data();
-                                srcCb = input.plane(1).data();
-                                srcCr = input.plane(2).data();
                                 strideY = ml.lineStride(0, width);
                                 strideCb = ml.lineStride(1, width);
                                 strideCr = ml.lineStride(2, width);
+                                srcY = input.plane(0).data() + rowBegin * strideY;
+                                srcCb = input.plane(1).data() + chromaBegin * strideCb;
+                                srcCr = input.plane(2).data() + chromaBegin * strideCr;
                                 break;
                         case LayoutSemiPlanar420:
-                                srcY = input.plane(0).data();
-                                srcCbCr = input.plane(1).data();
                                 strideY = ml.lineStride(0, width);
                                 strideCbCr = ml.lineStride(1, width);
+                                srcY = input.plane(0).data() + rowBegin * strideY;
+                                srcCbCr = input.plane(1).data() + chromaBegin * strideCbCr;
                                 break;
                         case LayoutInterleavedUYVY:
                         case LayoutInterleavedYUYV:
-                                srcY = input.plane(0).data();
                                 strideInterleaved = ml.lineStride(0, width);
+                                srcY = input.plane(0).data() + rowBegin * strideInterleaved;
                                 break;
                         default: break;
                 }
@@ -458,86 +672,106 @@ namespace {
                 }
 
                 jpeg_finish_compress(&cinfo);
+                out.data = outBuffer;
+                out.size = outSize;
+                return true;
+        }
 
-                PixelFormat::ID jpegPd = jpegPixelFormatFor(idesc.pixelFormat().id());
-                ImageDesc       cdesc(Size2Du32(width, height), PixelFormat(jpegPd));
-                cdesc.metadata() = idesc.metadata();
-                Buffer buf = Buffer(outSize);
-                std::memcpy(buf.data(), outBuffer, outSize);
-                buf.setSize(outSize);
-                free(outBuffer);
-                BufferView view(buf, 0, outSize);
-                auto       cvp = CompressedVideoPayload::Ptr::create(cdesc, view);
-                cvp.modify()->metadata() = idesc.metadata();
-                return cvp;
+        // ---------------------------------------------------------------------------
+        // Decode target — either a payload the decode helper allocates from
+        // the header's dimensions (serial decode), or a band of rows at
+        // @c rowBegin inside a payload the caller already allocated (one
+        // stripe of a slice-parallel decode).
+        // ---------------------------------------------------------------------------
+
+        struct DecodeTarget {
+                        UncompressedVideoPayload::Ptr owned;
+                        UncompressedVideoPayload     *into = nullptr;
+                        int                           rowBegin = 0;
+        };
+
+        // Called after jpeg_start_decompress.  Returns false (after
+        // logging) when the payload cannot be allocated or the stripe
+        // does not fit the caller's payload.
+        static bool bindDecodeTarget(DecodeTarget &target, const jpeg_decompress_struct &dinfo,
+                                     PixelFormat::ID outputPd, const char *who) {
+                if (target.into == nullptr) {
+                        ImageDesc outDesc(dinfo.output_width, dinfo.output_height, PixelFormat(outputPd));
+                        target.owned = UncompressedVideoPayload::allocate(outDesc);
+                        if (!target.owned.isValid()) {
+                                promekiWarnThrottled(1000, "JpegVideoDecoder::%s: failed to allocate %ux%u %s payload",
+                                                     who, (unsigned)dinfo.output_width,
+                                                     (unsigned)dinfo.output_height,
+                                                     PixelFormat(outputPd).name().cstr());
+                                return false;
+                        }
+                        target.into = target.owned.modify();
+                        target.rowBegin = 0;
+                        return true;
+                }
+                const ImageDesc &desc = target.into->desc();
+                if (dinfo.output_width != desc.size().width() ||
+                    target.rowBegin + dinfo.output_height > desc.size().height()) {
+                        promekiWarnThrottled(1000, "JpegVideoDecoder::%s: %ux%u stripe at row %d does not fit %ux%u",
+                                             who, (unsigned)dinfo.output_width, (unsigned)dinfo.output_height,
+                                             target.rowBegin, (unsigned)desc.size().width(),
+                                             (unsigned)desc.size().height());
+                        return false;
+                }
+                return true;
         }
 
         // ---------------------------------------------------------------------------
         // Decode — RGB output path
         // ---------------------------------------------------------------------------
 
-        static UncompressedVideoPayload::Ptr decodeToRGB(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr,
-                                                         const CompressedVideoPayload &input,
-                                                         PixelFormat::ID               outputPd) {
+        static bool decodeToRGB(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr, const uint8_t *jpegData,
+                                size_t jpegSize, PixelFormat::ID outputPd, DecodeTarget &target) {
                 if (setjmp(jerr.jmpBuf)) {
                         promekiWarnThrottled(1000, "JpegVideoDecoder::decodeToRGB: libjpeg longjmp (bytes=%zu out=%s): %s",
-                                             input.plane(0).size(), PixelFormat(outputPd).name().cstr(),
-                                             jerr.lastMessage);
+                                             jpegSize, PixelFormat(outputPd).name().cstr(), jerr.lastMessage);
                         jpeg_abort_decompress(&dinfo);
-                        return UncompressedVideoPayload::Ptr();
+                        return false;
                 }
 
-                auto           jpegView = input.plane(0);
-                const uint8_t *jpegData = jpegView.data();
-                jpeg_mem_src(&dinfo, jpegData, jpegView.size());
+                jpeg_mem_src(&dinfo, jpegData, jpegSize);
                 jpeg_read_header(&dinfo, TRUE);
 
                 dinfo.out_color_space = (outputPd == PixelFormat::RGBA8_sRGB) ? JCS_EXT_RGBA : JCS_RGB;
                 jpeg_start_decompress(&dinfo);
 
-                ImageDesc outDesc(dinfo.output_width, dinfo.output_height, PixelFormat(outputPd));
-                auto      output = UncompressedVideoPayload::allocate(outDesc);
-                if (!output.isValid()) {
-                        promekiWarnThrottled(1000, "JpegVideoDecoder::decodeToRGB: failed to allocate %ux%u %s payload",
-                                             (unsigned)dinfo.output_width, (unsigned)dinfo.output_height,
-                                             PixelFormat(outputPd).name().cstr());
+                if (!bindDecodeTarget(target, dinfo, outputPd, "decodeToRGB")) {
                         jpeg_abort_decompress(&dinfo);
-                        return UncompressedVideoPayload::Ptr();
+                        return false;
                 }
 
-                const PixelMemLayout &outMl = outDesc.pixelFormat().memLayout();
+                const PixelMemLayout &outMl = target.into->desc().pixelFormat().memLayout();
                 size_t                stride = outMl.lineStride(0, dinfo.output_width);
-                uint8_t              *pixels = output.modify()->data()[0].data();
+                uint8_t              *pixels = target.into->data()[0].data() + target.rowBegin * stride;
                 while (dinfo.output_scanline < dinfo.output_height) {
                         uint8_t *row = pixels + dinfo.output_scanline * stride;
                         JSAMPROW rowPtr = row;
                         jpeg_read_scanlines(&dinfo, &rowPtr, 1);
                 }
                 jpeg_finish_decompress(&dinfo);
-
-                output.modify()->desc().metadata() = input.metadata();
-                return output;
+                return true;
         }
 
         // ---------------------------------------------------------------------------
         // Decode — YCbCr raw data output path (all layouts)
         // ---------------------------------------------------------------------------
 
-        static UncompressedVideoPayload::Ptr decodeToYCbCr(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr,
-                                                           const CompressedVideoPayload &input,
-                                                           PixelFormat::ID outputPd, YCbCrInfo info) {
+        static bool decodeToYCbCr(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr, const uint8_t *jpegData,
+                                  size_t jpegSize, PixelFormat::ID outputPd, YCbCrInfo info, DecodeTarget &target) {
                 if (setjmp(jerr.jmpBuf)) {
                         promekiWarnThrottled(1000,
                                              "JpegVideoDecoder::decodeToYCbCr: libjpeg longjmp (bytes=%zu out=%s): %s",
-                                             input.plane(0).size(), PixelFormat(outputPd).name().cstr(),
-                                             jerr.lastMessage);
+                                             jpegSize, PixelFormat(outputPd).name().cstr(), jerr.lastMessage);
                         jpeg_abort_decompress(&dinfo);
-                        return UncompressedVideoPayload::Ptr();
+                        return false;
                 }
 
-                auto           jpegView = input.plane(0);
-                const uint8_t *jpegData = jpegView.data();
-                jpeg_mem_src(&dinfo, jpegData, jpegView.size());
+                jpeg_mem_src(&dinfo, jpegData, jpegSize);
                 jpeg_read_header(&dinfo, TRUE);
 
                 dinfo.raw_data_out = TRUE;
@@ -548,15 +782,11 @@ namespace {
                 int height = dinfo.output_height;
                 int chromaWidth = width / 2;
 
-                ImageDesc outDesc(width, height, PixelFormat(outputPd));
-                auto      output = UncompressedVideoPayload::allocate(outDesc);
-                if (!output.isValid()) {
-                        promekiWarnThrottled(1000, "JpegVideoDecoder::decodeToYCbCr: failed to allocate %dx%d %s payload",
-                                             width, height, PixelFormat(outputPd).name().cstr());
+                if (!bindDecodeTarget(target, dinfo, outputPd, "decodeToYCbCr")) {
                         jpeg_abort_decompress(&dinfo);
-                        return UncompressedVideoPayload::Ptr();
+                        return false;
                 }
-                const PixelMemLayout &outMl = outDesc.pixelFormat().memLayout();
+                const PixelMemLayout &outMl = target.into->desc().pixelFormat().memLayout();
 
                 int mcuRows = DCTSIZE * dinfo.max_v_samp_factor;
                 int chromaMcuRows = DCTSIZE;
@@ -577,27 +807,31 @@ namespace {
                 uint8_t *dstY = nullptr, *dstCb = nullptr, *dstCr = nullptr, *dstCbCr = nullptr;
                 size_t   strideY = 0, strideCb = 0, strideCr = 0, strideCbCr = 0, strideOut = 0;
 
-                UncompressedVideoPayload *outRaw = output.modify();
+                // Stripes start on an MCU row, so for 4:2:0 output rowBegin
+                // is even and the chroma planes start at rowBegin / 2.
+                UncompressedVideoPayload *outRaw = target.into;
+                const size_t              rowBegin = target.rowBegin;
+                const size_t              chromaBegin = info.is420 ? rowBegin / 2 : rowBegin;
                 switch (info.layout) {
                         case LayoutPlanar422:
                         case LayoutPlanar420:
-                                dstY = outRaw->data()[0].data();
-                                dstCb = outRaw->data()[1].data();
-                                dstCr = outRaw->data()[2].data();
                                 strideY = outMl.lineStride(0, width);
                                 strideCb = outMl.lineStride(1, width);
                                 strideCr = outMl.lineStride(2, width);
+                                dstY = outRaw->data()[0].data() + rowBegin * strideY;
+                                dstCb = outRaw->data()[1].data() + chromaBegin * strideCb;
+                                dstCr = outRaw->data()[2].data() + chromaBegin * strideCr;
                                 break;
                         case LayoutSemiPlanar420:
-                                dstY = outRaw->data()[0].data();
-                                dstCbCr = outRaw->data()[1].data();
                                 strideY = outMl.lineStride(0, width);
                                 strideCbCr = outMl.lineStride(1, width);
+                                dstY = outRaw->data()[0].data() + rowBegin * strideY;
+                                dstCbCr = outRaw->data()[1].data() + chromaBegin * strideCbCr;
                                 break;
                         case LayoutInterleavedUYVY:
                         case LayoutInterleavedYUYV:
-                                dstY = outRaw->data()[0].data();
                                 strideOut = outMl.lineStride(0, width);
+                                dstY = outRaw->data()[0].data() + rowBegin * strideOut;
                                 break;
                         default: break;
                 }
@@ -678,26 +912,308 @@ namespace {
                 }
 
                 jpeg_finish_decompress(&dinfo);
+                return true;
+        }
 
-                output.modify()->desc().metadata() = input.metadata();
-                return output;
+        // Encodes rows [rowBegin, rowBegin + rowCount) of @p input as a
+        // standalone JPEG; the whole frame is the rowBegin = 0 case.
+        static bool encodeRows(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr, const UncompressedVideoPayload &input,
+                               int rowBegin, int rowCount, int quality, JpegVideoEncoder::Subsampling subsampling,
+                               JpegBitstream &out) {
+                YCbCrInfo info = classifyYCbCr(input.desc().pixelFormat().id());
+                if (info.layout != LayoutNone) {
+                        return encodeYCbCr(cinfo, jerr, input, rowBegin, rowCount, quality, info, out);
+                }
+                return encodeRGB(cinfo, jerr, input, rowBegin, rowCount, quality, subsampling, out);
         }
 
-        // Encodes one uncompressed payload to JPEG using libjpeg-turbo.
-        // Returns a null Ptr on error; the caller sets the session's error state.
-        static CompressedVideoPayload::Ptr encodeOneJpegFrame(jpeg_compress_struct &cinfo, JpegErrorMgr &jerr,
-                                                              const UncompressedVideoPayload &input, int quality,
-                                                              JpegVideoEncoder::Subsampling subsampling) {
+        // Wraps a finished JFIF bitstream as the encoder's output payload.
+        static CompressedVideoPayload::Ptr makeJpegPayload(const ImageDesc &idesc, const Buffer &buf) {
+                PixelFormat::ID jpegPd = jpegPixelFormatFor(idesc.pixelFormat().id());
+                ImageDesc       cdesc(idesc.size(), PixelFormat(jpegPd));
+                cdesc.metadata() = idesc.metadata();
+                BufferView view(buf, 0, buf.size());
+                auto       cvp = CompressedVideoPayload::Ptr::create(cdesc, view);
+                cvp.modify()->metadata() = idesc.metadata();
+                return cvp;
+        }
+
+        // MCU size the encode paths above configure for @p input.
+        static void encodeMcuSize(const UncompressedVideoPayload &input, JpegVideoEncoder::Subsampling subsampling,
+                                  int &mcuWidth, int &mcuHeight) {
                 YCbCrInfo info = classifyYCbCr(input.desc().pixelFormat().id());
-                if (info.layout != LayoutNone) return encodeYCbCr(cinfo, jerr, input, quality, info);
-                return encodeRGB(cinfo, jerr, input, quality, subsampling);
+                if (info.layout != LayoutNone) {
+                        mcuWidth = 2 * DCTSIZE;
+                        mcuHeight = info.is420 ? 2 * DCTSIZE : DCTSIZE;
+                        return;
+                }
+                mcuWidth = subsampling == JpegVideoEncoder::Subsampling444 ? DCTSIZE : 2 * DCTSIZE;
+                mcuHeight = subsampling == JpegVideoEncoder::Subsampling420 ? 2 * DCTSIZE : DCTSIZE;
+                return;
+        }
+
+        // MCU rows per stripe for a slice-parallel encode, or 0 when the
+        // frame should be encoded serially.  Each stripe is exactly one
+        // restart interval, so a stripe's MCU count must fit in DRI; very
+        // wide frames therefore get more (shorter) stripes than threads.
+        static int encodeStripeMcuRows(int mcuRows, int mcusPerRow, int threads) {
+                if (threads <= 1 || mcuRows < 2 || mcusPerRow < 1) return 0;
+                const int stripes = std::min(threads, mcuRows);
+                const int maxRows = MaxRestartInterval / mcusPerRow;
+                int       rows = (mcuRows + stripes - 1) / stripes;
+                if (rows > maxRows) rows = maxRows;
+                if (rows < 1 || rows >= mcuRows) return 0;
+                return rows;
+        }
+
+        // Joins per-stripe JPEGs into one JFIF: stripe 0's headers with the
+        // frame height patched into SOF and a DRI ahead of SOS, then every
+        // stripe's entropy-coded segment, separated by RST0..RST7.  The
+        // stripes share identical tables and each starts with zeroed DC
+        // predictors, exactly as a decoder resets them at a restart
+        // marker, so the result decodes to the same pixels as a serial
+        // encode.
+        static CompressedVideoPayload::Ptr stitchStripes(const ImageDesc &idesc, const List<JpegBitstream> &parts,
+                                                         int restartInterval) {
+                List<JpegLayout> layouts(parts.size());
+                size_t           total = 0;
+                for (size_t s = 0; s < parts.size(); s++) {
+                        if (!parseJpegLayout(parts[s].data, parts[s].size, layouts[s])) {
+                                promekiWarnThrottled(1000, "JpegVideoEncoder: stripe %zu bitstream did not parse", s);
+                                return CompressedVideoPayload::Ptr();
+                        }
+                        // Entropy-coded data plus the RSTn (or EOI) after it.
+                        total += layouts[s].ecsEnd - layouts[s].ecsPos + 2;
+                }
+                const JpegLayout &head = layouts[0];
+                const size_t      driSize = 6;
+                total += head.ecsPos + driSize;
+
+                Buffer   buf(total);
+                uint8_t *out = static_cast<uint8_t *>(buf.data());
+                std::memcpy(out, parts[0].data, head.sosPos);
+                putBigEndian16(out + head.sofPos + 5, (int)idesc.size().height());
+                size_t pos = head.sosPos;
+                out[pos++] = 0xFF;
+                out[pos++] = MarkerDRI;
+                putBigEndian16(out + pos, 4);
+                putBigEndian16(out + pos + 2, restartInterval);
+                pos += 4;
+                std::memcpy(out + pos, parts[0].data + head.sosPos, head.ecsPos - head.sosPos);
+                pos += head.ecsPos - head.sosPos;
+                for (size_t s = 0; s < parts.size(); s++) {
+                        if (s > 0) {
+                                out[pos++] = 0xFF;
+                                out[pos++] = static_cast<uint8_t>(MarkerRST0 + ((s - 1) & 7));
+                        }
+                        const size_t len = layouts[s].ecsEnd - layouts[s].ecsPos;
+                        std::memcpy(out + pos, parts[s].data + layouts[s].ecsPos, len);
+                        pos += len;
+                }
+                out[pos++] = 0xFF;
+                out[pos++] = MarkerEOI;
+                buf.setSize(pos);
+                return makeJpegPayload(idesc, buf);
+        }
+
+        // Encodes @p input as horizontal stripes of @p stripeMcuRows MCU
+        // rows.  The calling thread encodes the first stripe with the
+        // session's compressor; the rest run on jpegThreadPool() with a
+        // per-worker compressor.
+        static CompressedVideoPayload::Ptr encodeStriped(CompressState &state, const UncompressedVideoPayload &input,
+                                                         int quality, JpegVideoEncoder::Subsampling subsampling,
+                                                         int mcuHeight, int mcusPerRow, int stripeMcuRows) {
+                const int height = (int)input.desc().size().height();
+                const int stripeRows = stripeMcuRows * mcuHeight;
+                const int stripes = (height + stripeRows - 1) / stripeRows;
+
+                static const ThreadPool::WorkTag tag(String("JpegVideoEncoder"));
+                ThreadPool                      &pool = jpegThreadPool();
+                List<JpegBitstream>              parts(stripes);
+                List<Future<bool>>               pending;
+                pending.reserve(stripes - 1);
+                for (int s = 1; s < stripes; s++) {
+                        const int      rowBegin = s * stripeRows;
+                        const int      rowCount = std::min(stripeRows, height - rowBegin);
+                        JpegBitstream *part = &parts[s];
+                        pending.pushToBack(pool.submit(tag, [&input, part, rowBegin, rowCount, quality, subsampling]() {
+                                CompressState &ws = workerCompressState();
+                                if (!ws.created) return false;
+                                return encodeRows(ws.cinfo, ws.jerr, input, rowBegin, rowCount, quality, subsampling,
+                                                  *part);
+                        }));
+                }
+                bool ok = encodeRows(state.cinfo, state.jerr, input, 0, stripeRows, quality, subsampling, parts[0]);
+                for (auto &f : pending) {
+                        auto [partOk, futErr] = f.result();
+                        if (futErr.isError() || !partOk) ok = false;
+                }
+
+                CompressedVideoPayload::Ptr cvp;
+                if (ok) cvp = stitchStripes(input.desc(), parts, stripeMcuRows * mcusPerRow);
+                for (auto &part : parts) part.release();
+                return cvp;
+        }
+
+        // Encodes one uncompressed payload to JPEG using libjpeg-turbo,
+        // slice-parallel when @p threads > 1 and the frame has enough MCU
+        // rows to split.  Returns a null Ptr on error; the caller sets the
+        // session's error state.
+        static CompressedVideoPayload::Ptr encodeOneJpegFrame(CompressState                   &state,
+                                                              const UncompressedVideoPayload &input, int quality,
+                                                              JpegVideoEncoder::Subsampling subsampling, int threads) {
+                const int width = (int)input.desc().size().width();
+                const int height = (int)input.desc().size().height();
+                int       mcuWidth = 0, mcuHeight = 0;
+                encodeMcuSize(input, subsampling, mcuWidth, mcuHeight);
+                const int mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+                const int mcuRows = (height + mcuHeight - 1) / mcuHeight;
+                const int stripeMcuRows = encodeStripeMcuRows(mcuRows, mcusPerRow, threads);
+                if (stripeMcuRows > 0) {
+                        return encodeStriped(state, input, quality, subsampling, mcuHeight, mcusPerRow, stripeMcuRows);
+                }
+
+                JpegBitstream bs;
+                if (!encodeRows(state.cinfo, state.jerr, input, 0, height, quality, subsampling, bs)) {
+                        return CompressedVideoPayload::Ptr();
+                }
+                // Copy the JPEG bitstream into an owned Buffer (libjpeg
+                // malloc'd the output).
+                Buffer buf = Buffer(bs.size);
+                std::memcpy(buf.data(), bs.data, bs.size);
+                buf.setSize(bs.size);
+                bs.release();
+                return makeJpegPayload(input.desc(), buf);
+        }
+
+        // Decodes @p jpegData into @p target with the requested output
+        // PixelFormat.  Returns false on error or an unsupported target.
+        static bool decodeInto(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr, const uint8_t *jpegData,
+                               size_t jpegSize, PixelFormat::ID outPd, DecodeTarget &target) {
+                if (outPd == PixelFormat::RGB8_sRGB || outPd == PixelFormat::RGBA8_sRGB) {
+                        return decodeToRGB(dinfo, jerr, jpegData, jpegSize, outPd, target);
+                }
+                YCbCrInfo info = classifyYCbCr(outPd);
+                if (info.layout != LayoutNone) {
+                        return decodeToYCbCr(dinfo, jerr, jpegData, jpegSize, outPd, info, target);
+                }
+                promekiWarnOnce("JpegVideoDecoder: no decoder path for output PixelFormat %s",
+                                PixelFormat(outPd).name().cstr());
+                return false;
+        }
+
+        // A slice-parallel decode plan: which restart intervals each
+        // stripe covers and how many pixel rows that is.
+        struct DecodePlan {
+                        JpegLayout   layout;
+                        List<size_t> restarts;         // offset of every RSTn in the scan
+                        int          intervals = 0;    // restart intervals in the scan
+                        int          intervalRows = 0; // pixel rows per restart interval
+                        int          perStripe = 0;    // restart intervals per stripe
+                        int          stripes = 0;
+        };
+
+        // Decides whether @p data can be decoded slice-parallel.  That
+        // needs a single-scan JPEG whose restart interval covers whole MCU
+        // rows and whose RSTn count matches what the geometry predicts —
+        // MJPEG from this encoder with JpegThreads > 1, or from any
+        // hardware encoder that restarts per row.  Anything else decodes
+        // serially.  So does vertically subsampled chroma headed for RGB:
+        // libjpeg's fancy upsampling interpolates across MCU rows, and a
+        // stripe boundary would show as a seam.
+        static bool planDecodeStripes(const uint8_t *data, size_t size, PixelFormat::ID outPd, int threads,
+                                      DecodePlan &plan) {
+                if (threads <= 1) return false;
+                JpegLayout &l = plan.layout;
+                if (!parseJpegLayout(data, size, l, &plan.restarts) || l.restartInterval == 0) return false;
+                if (classifyYCbCr(outPd).layout == LayoutNone && l.mcuHeight > DCTSIZE) return false;
+                const int mcusPerRow = l.mcusPerRow();
+                if (l.restartInterval % mcusPerRow != 0) return false;
+                const int rowsPerInterval = l.restartInterval / mcusPerRow;
+                plan.intervals = (l.mcuRows() + rowsPerInterval - 1) / rowsPerInterval;
+                if (plan.intervals < 2 || (int)plan.restarts.size() != plan.intervals - 1) return false;
+                if (l.ecsEnd + 1 >= size || data[l.ecsEnd + 1] != MarkerEOI) return false;
+                plan.intervalRows = rowsPerInterval * l.mcuHeight;
+                const int stripes = std::min(threads, plan.intervals);
+                plan.perStripe = (plan.intervals + stripes - 1) / stripes;
+                plan.stripes = (plan.intervals + plan.perStripe - 1) / plan.perStripe;
+                return plan.stripes > 1;
+        }
+
+        // Decodes one stripe of @p plan as a standalone JPEG into its rows
+        // of @p into: the source headers with the stripe height patched
+        // into SOF, then the stripe's entropy-coded data with its RSTn
+        // markers renumbered from RST0.
+        static bool decodeStripe(DecompressState &state, const uint8_t *data, const DecodePlan &plan, int stripe,
+                                 PixelFormat::ID outPd, UncompressedVideoPayload *into) {
+                const JpegLayout &l = plan.layout;
+                const int         first = stripe * plan.perStripe;
+                const int         last = std::min(plan.intervals, first + plan.perStripe);
+                const int         rowBegin = first * plan.intervalRows;
+                const int         rowCount = std::min(l.height - rowBegin, (last - first) * plan.intervalRows);
+                const size_t      ecsBegin = first == 0 ? l.ecsPos : plan.restarts[first - 1] + 2;
+                const size_t      ecsEnd = last == plan.intervals ? l.ecsEnd : plan.restarts[last - 1];
+
+                List<uint8_t> &buf = state.stripe;
+                buf.resize(l.ecsPos + (ecsEnd - ecsBegin) + 2);
+                uint8_t *out = buf.data();
+                std::memcpy(out, data, l.ecsPos);
+                putBigEndian16(out + l.sofPos + 5, rowCount);
+                std::memcpy(out + l.ecsPos, data + ecsBegin, ecsEnd - ecsBegin);
+                for (int i = first; i < last - 1; i++) {
+                        out[l.ecsPos + (plan.restarts[i] - ecsBegin) + 1] =
+                                static_cast<uint8_t>(MarkerRST0 + ((i - first) & 7));
+                }
+                out[buf.size() - 2] = 0xFF;
+                out[buf.size() - 1] = MarkerEOI;
+
+                DecodeTarget target;
+                target.into = into;
+                target.rowBegin = rowBegin;
+                return decodeInto(state.dinfo, state.jerr, buf.data(), buf.size(), outPd, target);
+        }
+
+        // Runs @p plan: the calling thread decodes the first stripe with
+        // the session's decompressor, the rest run on jpegThreadPool(),
+        // all writing disjoint row bands of one output payload.
+        static UncompressedVideoPayload::Ptr decodeStriped(DecompressState &state, const uint8_t *data,
+                                                           const DecodePlan &plan, PixelFormat::ID outPd) {
+                ImageDesc outDesc(plan.layout.width, plan.layout.height, PixelFormat(outPd));
+                auto      output = UncompressedVideoPayload::allocate(outDesc);
+                if (!output.isValid()) {
+                        promekiWarnThrottled(1000, "JpegVideoDecoder: failed to allocate %dx%d %s payload",
+                                             plan.layout.width, plan.layout.height, PixelFormat(outPd).name().cstr());
+                        return UncompressedVideoPayload::Ptr();
+                }
+                UncompressedVideoPayload *into = output.modify();
+
+                static const ThreadPool::WorkTag tag(String("JpegVideoDecoder"));
+                ThreadPool                      &pool = jpegThreadPool();
+                List<Future<bool>>               pending;
+                pending.reserve(plan.stripes - 1);
+                for (int s = 1; s < plan.stripes; s++) {
+                        pending.pushToBack(pool.submit(tag, [data, &plan, s, outPd, into]() {
+                                DecompressState &ws = workerDecompressState();
+                                if (!ws.created) return false;
+                                return decodeStripe(ws, data, plan, s, outPd, into);
+                        }));
+                }
+                bool ok = decodeStripe(state, data, plan, 0, outPd, into);
+                for (auto &f : pending) {
+                        auto [stripeOk, futErr] = f.result();
+                        if (futErr.isError() || !stripeOk) ok = false;
+                }
+                if (!ok) return UncompressedVideoPayload::Ptr();
+                return output;
         }
 
         // Decodes one compressed JPEG payload into uncompressed form with the
-        // requested target PixelFormat.  Returns a null Ptr on error.
-        static UncompressedVideoPayload::Ptr decodeOneJpegFrame(jpeg_decompress_struct &dinfo, JpegErrorMgr &jerr,
-                                                                const CompressedVideoPayload &input,
-                                                                PixelFormat::ID               outPd) {
+        // requested target PixelFormat, slice-parallel when @p threads > 1
+        // and the bitstream carries suitable restart markers.  Returns a
+        // null Ptr on error.
+        static UncompressedVideoPayload::Ptr decodeOneJpegFrame(DecompressState               &state,
+                                                                const CompressedVideoPayload &input, PixelFormat::ID outPd,
+                                                                int threads) {
                 if (outPd == PixelFormat::Invalid) {
                         const auto &targets = input.desc().pixelFormat().decodeTargets();
                         if (targets.isEmpty()) {
@@ -708,17 +1224,23 @@ namespace {
                         outPd = targets[0];
                 }
 
-                if (outPd == PixelFormat::RGB8_sRGB || outPd == PixelFormat::RGBA8_sRGB) {
-                        return decodeToRGB(dinfo, jerr, input, outPd);
-                }
-
-                YCbCrInfo info = classifyYCbCr(outPd);
-                if (info.layout != LayoutNone) {
-                        return decodeToYCbCr(dinfo, jerr, input, outPd, info);
+                auto           jpegView = input.plane(0);
+                const uint8_t *jpegData = jpegView.data();
+                const size_t   jpegSize = jpegView.size();
+
+                UncompressedVideoPayload::Ptr output;
+                DecodePlan                    plan;
+                if (planDecodeStripes(jpegData, jpegSize, outPd, threads, plan)) {
+                        output = decodeStriped(state, jpegData, plan, outPd);
+                } else {
+                        DecodeTarget target;
+                        if (decodeInto(state.dinfo, state.jerr, jpegData, jpegSize, outPd, target)) {
+                                output = target.owned;
+                        }
                 }
-                promekiWarnOnce("JpegVideoDecoder: no decoder path for output PixelFormat %s",
-                                PixelFormat(outPd).name().cstr());
-                return UncompressedVideoPayload::Ptr();
+                if (!output.isValid()) return output;
+                output.modify()->desc().metadata() = input.metadata();
+                return output;
         }
 
 } // namespace
@@ -727,30 +1249,7 @@ namespace {
 // JpegVideoEncoder — pImpl owning the persistent libjpeg-turbo state.
 // ---------------------------------------------------------------------------
 
-struct JpegVideoEncoder::Impl {
-                jpeg_compress_struct cinfo{};
-                JpegErrorMgr         jerr{};
-                bool                 created = false;
-
-                Impl() {
-                        cinfo.err = jpeg_std_error(&jerr.pub);
-                        jerr.pub.error_exit = jpegErrorExit;
-                        jerr.pub.output_message = jpegOutputMessage;
-                        // libjpeg's create can longjmp on OOM during state
-                        // allocation; guard with a setjmp so the partially-
-                        // initialized struct doesn't leak.
-                        if (setjmp(jerr.jmpBuf)) {
-                                created = false;
-                                return;
-                        }
-                        jpeg_create_compress(&cinfo);
-                        created = true;
-                }
-
-                ~Impl() {
-                        if (created) jpeg_destroy_compress(&cinfo);
-                }
-};
+struct JpegVideoEncoder::Impl : CompressState {};
 
 JpegVideoEncoder::JpegVideoEncoder() : _impl(ImplPtr::create()) {}
 
@@ -804,6 +1303,7 @@ void JpegVideoEncoder::onConfigure(const MediaConfig &config) {
         _outputPd = config.getAs<PixelFormat>(MediaConfig::OutputPixelFormat, PixelFormat());
         _capacity = config.getAs<int>(MediaConfig::Capacity, 8);
         if (_capacity < 1) _capacity = 1;
+        _threads = resolveThreadCount(config);
 }
 
 Error JpegVideoEncoder::submitFrame(const Frame &frame) {
@@ -824,7 +1324,7 @@ Error JpegVideoEncoder::submitFrame(const Frame &frame) {
                 setError(Error::LibraryFailure, "JpegVideoEncoder: libjpeg-turbo state not initialized");
                 return _lastError;
         }
-        auto cvp = encodeOneJpegFrame(_impl->cinfo, _impl->jerr, *payload, _quality, _subsampling);
+        auto cvp = encodeOneJpegFrame(*_impl, *payload, _quality, _subsampling, _threads);
         if (!cvp.isValid()) {
                 promekiWarnThrottled(1000, "JpegVideoEncoder::submitFrame: encode failed (size=%ux%u fmt=%s quality=%d)",
                                      (unsigned)payload->desc().size().width(),
@@ -867,27 +1367,7 @@ Error JpegVideoEncoder::reset() {
 // JpegVideoDecoder — pImpl owning the persistent libjpeg-turbo state.
 // ---------------------------------------------------------------------------
 
-struct JpegVideoDecoder::Impl {
-                jpeg_decompress_struct dinfo{};
-                JpegErrorMgr           jerr{};
-                bool                   created = false;
-
-                Impl() {
-                        dinfo.err = jpeg_std_error(&jerr.pub);
-                        jerr.pub.error_exit = jpegErrorExit;
-                        jerr.pub.output_message = jpegOutputMessage;
-                        if (setjmp(jerr.jmpBuf)) {
-                                created = false;
-                                return;
-                        }
-                        jpeg_create_decompress(&dinfo);
-                        created = true;
-                }
-
-                ~Impl() {
-                        if (created) jpeg_destroy_decompress(&dinfo);
-                }
-};
+struct JpegVideoDecoder::Impl : DecompressState {};
 
 JpegVideoDecoder::JpegVideoDecoder() : _impl(ImplPtr::create()) {}
 
@@ -909,6 +1389,7 @@ void JpegVideoDecoder::onConfigure(const MediaConfig &config) {
         _outputPd = config.getAs<PixelFormat>(MediaConfig::OutputPixelFormat, PixelFormat());
         _capacity = config.getAs<int>(MediaConfig::Capacity, 8);
         if (_capacity < 1) _capacity = 1;
+        _threads = resolveThreadCount(config);
 }
 
 Error JpegVideoDecoder::submitFrame(const Frame &frame) {
@@ -933,7 +1414,7 @@ Error JpegVideoDecoder::submitFrame(const Frame &frame) {
                 setError(Error::LibraryFailure, "JpegVideoDecoder: libjpeg-turbo state not initialized");
                 return _lastError;
         }
-        auto uvp = decodeOneJpegFrame(_impl->dinfo, _impl->jerr, *payload, outPd);
+        auto uvp = decodeOneJpegFrame(*_impl, *payload, outPd, _threads);
         if (!uvp.isValid()) {
                 promekiWarnThrottled(1000, "JpegVideoDecoder::submitFrame: decode failed (bytes=%zu out=%s)",
                                      payload->size(), PixelFormat(outPd).name().cstr());
@@ -13,6 +13,46 @@
 
 PROMEKI_NAMESPACE_BEGIN
 
+namespace {
+
+        // MediaIOAllocator that draws frame planes and audio chunks from a
+        // BufferPool.  Sized exactly like DefaultBufferAllocator; only the
+        // source of the memory differs.
+        class PooledMediaIOAllocator : public MediaIOAllocator {
+                public:
+                        PROMEKI_SHARED_DERIVED(PooledMediaIOAllocator)
+
+                        explicit PooledMediaIOAllocator(const BufferPool &pool) : _pool(pool) {}
+
+                        String name() const override { return String("PooledMediaIOAllocator"); }
+
+                        Buffer allocateVideoPlane(const ImageDesc &desc, int planeIndex) const override {
+                                const PixelFormat &pf = desc.pixelFormat();
+                                if (!pf.isValid() || !desc.size().isValid()) return Buffer();
+                                if (planeIndex < 0 || planeIndex >= static_cast<int>(pf.planeCount())) return Buffer();
+                                const size_t bytes = pf.planeSize(static_cast<size_t>(planeIndex), desc);
+                                return acquire(bytes);
+                        }
+
+                        Buffer allocateAudioChunk(const AudioDesc &desc, size_t samples) const override {
+                                return acquire(desc.bufferSize(samples));
+                        }
+
+                private:
+                        Buffer acquire(size_t bytes) const {
+                                if (bytes == 0) return Buffer();
+                                Buffer buf = _pool.acquire(bytes);
+                                if (buf.isValid()) buf.setSize(bytes);
+                                return buf;
+                        }
+
+                        // BufferPool is internally synchronized; acquire is
+                        // only non-const because it's a handle API.
+                        mutable BufferPool _pool;
+        };
+
+} // namespace
+
 String MediaIOAllocator::name() const { return String("DefaultMediaIOAllocator"); }
 
 Buffer MediaIOAllocator::allocateVideoPlane(const ImageDesc &desc, int planeIndex) const {
@@ -55,4 +95,8 @@ MediaIOAllocator::Ptr MediaIOAllocator::defaultAllocator() {
         return instance;
 }
 
+MediaIOAllocator::Ptr MediaIOAllocator::pooledAllocator(const BufferPool &pool) {
+        return Ptr::takeOwnership(new PooledMediaIOAllocator(pool));
+}
+
 PROMEKI_NAMESPACE_END
@@ -82,6 +82,18 @@ Error QuickTime::Impl::readSampleRange(size_t trackIndex, uint64_t startSampleIn
         return Error::Ok;
 }
 
+Error QuickTime::Impl::setReadahead(uint32_t /*frames*/, uint64_t /*maxBytes*/) {
+        return Error::NotSupported;
+}
+
+void QuickTime::Impl::invalidateReadahead() {
+        return;
+}
+
+QuickTime::ReadaheadStats QuickTime::Impl::readaheadStats() const {
+        return ReadaheadStats();
+}
+
 Error QuickTime::Impl::addVideoTrack(const PixelFormat & /*codec*/, const Size2Du32 & /*size*/,
                                      const FrameRate & /*frameRate*/, uint32_t * /*outTrackId*/) {
         return Error::NotImplemented;
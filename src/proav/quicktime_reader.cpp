@@ -8,9 +8,13 @@
 #include "quicktime_reader.h"
 #include "quicktime_atom.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <promeki/asyncfileio.h>
 #include <promeki/colormodel.h>
 #include <promeki/file.h>
+#include <promeki/future.h>
 #include <promeki/iodevice.h>
 #include <promeki/logger.h>
 #include <promeki/rational.h>
@@ -165,6 +169,52 @@ namespace {
 
 } // namespace
 
+// Read-ahead tuning and cache state, used by the Read-ahead section below.
+namespace {
+
+        // Extents closer together than this are read as one, gap included.
+        constexpr int64_t ReadaheadMergeGap = 64 * 1024;
+        // Merging stops once a read reaches this size.
+        constexpr int64_t ReadaheadMaxRead = 16 * 1024 * 1024;
+        // Prefetch reads in flight at once.
+        constexpr unsigned int ReadaheadQueueDepth = 16;
+
+        struct ReadaheadExtent {
+                        int64_t offset = 0;
+                        int64_t size = 0;
+        };
+
+} // namespace
+
+struct QuickTimeReader::Readahead {
+                /** @brief One prefetched byte range of the file. */
+                struct Block {
+                                int64_t         offset = 0;
+                                int64_t         size = 0;  ///< Bytes requested.
+                                int64_t         valid = 0; ///< Bytes actually read, once ready.
+                                bool            ready = false;
+                                uint64_t        windowFrom = 0; ///< Anchor samples this block was read for.
+                                uint64_t        windowTo = 0;
+                                uint64_t        lastUse = 0;
+                                Buffer          data;
+                                Future<int64_t> pending;
+                };
+
+                uint32_t                  frames = 0;
+                uint64_t                  maxBytes = 0;
+                size_t                    anchorTrack = 0;
+                bool                      hasPlayhead = false;
+                uint64_t                  playhead = 0;
+                int                       direction = 1;
+                uint64_t                  coveredFrom = 0; ///< Anchor samples [coveredFrom, coveredTo) fetched.
+                uint64_t                  coveredTo = 0;
+                uint64_t                  clock = 0;
+                File                      file; ///< Prefetch handle, separate from the sample-read one.
+                UniquePtr<AsyncFileIO>    aio;  ///< Null when reading a user IODevice.
+                List<Block>               blocks;
+                QuickTime::ReadaheadStats stats;
+};
+
 // ---------------------------------------------------------------------------
 // QuickTimeReader
 // ---------------------------------------------------------------------------
@@ -173,6 +223,8 @@ QuickTimeReader::QuickTimeReader() : QuickTime::Impl(QuickTime::Reader) {}
 
 QuickTimeReader::~QuickTimeReader() {
         if (_isOpen) close();
+        delete _readahead;
+        _readahead = nullptr;
         delete _metaFile;
         _metaFile = nullptr;
 }
@@ -228,6 +280,10 @@ Error QuickTimeReader::open() {
 void QuickTimeReader::close() {
         if (!_isOpen) return;
         _isOpen = false;
+        // Destroying the cache waits for in-flight prefetches, which
+        // must finish before their file handle goes away.
+        delete _readahead;
+        _readahead = nullptr;
         if (_metaFile != nullptr) {
                 _metaFile->close();
         }
@@ -712,21 +768,31 @@ uint64_t QuickTimeReader::sampleCount(const QuickTimeSampleIndex &idx) const {
         return idx.offset.size();
 }
 
+namespace {
+
+        // Compact audio: binary search the chunk whose first-sample index
+        // is <= sampleIndex and whose first-sample + samples-per-chunk >
+        // sampleIndex.
+        size_t compactChunkFor(const QuickTimeSampleIndex &idx, uint64_t sampleIndex) {
+                const List<uint64_t> &starts = idx.audioChunkFirstSample;
+                size_t                lo = 0, hi = starts.size();
+                while (lo + 1 < hi) {
+                        size_t mid = lo + (hi - lo) / 2;
+                        if (starts[mid] <= sampleIndex)
+                                lo = mid;
+                        else
+                                hi = mid;
+                }
+                return lo;
+        }
+
+} // namespace
+
 int64_t QuickTimeReader::sampleOffset(const QuickTimeSampleIndex &idx, uint64_t sampleIndex) const {
         if (!idx.audioCompact) return idx.offset[sampleIndex];
-        // Binary search the chunk whose first-sample index is <= sampleIndex
-        // and whose first-sample + samples-per-chunk > sampleIndex.
-        const List<uint64_t> &starts = idx.audioChunkFirstSample;
-        size_t                lo = 0, hi = starts.size();
-        while (lo + 1 < hi) {
-                size_t mid = lo + (hi - lo) / 2;
-                if (starts[mid] <= sampleIndex)
-                        lo = mid;
-                else
-                        hi = mid;
-        }
-        uint64_t offsetInChunk = sampleIndex - starts[lo];
-        return idx.audioChunkOffsets[lo] +
+        const size_t chunk = compactChunkFor(idx, sampleIndex);
+        uint64_t     offsetInChunk = sampleIndex - idx.audioChunkFirstSample[chunk];
+        return idx.audioChunkOffsets[chunk] +
                static_cast<int64_t>(offsetInChunk) * static_cast<int64_t>(idx.audioSampleSize);
 }
 
@@ -741,6 +807,15 @@ int64_t QuickTimeReader::sampleDts(const QuickTimeSampleIndex &idx, uint64_t sam
         return static_cast<int64_t>(sampleIndex) * static_cast<int64_t>(idx.audioSampleDelta);
 }
 
+uint64_t QuickTimeReader::sampleAtOrAfterDts(const QuickTimeSampleIndex &idx, int64_t dts) const {
+        if (!idx.audioCompact) {
+                return static_cast<uint64_t>(std::lower_bound(idx.dts.begin(), idx.dts.end(), dts) - idx.dts.begin());
+        }
+        if (dts <= 0 || idx.audioSampleDelta == 0) return 0;
+        const uint64_t delta = idx.audioSampleDelta;
+        return std::min<uint64_t>((static_cast<uint64_t>(dts) + delta - 1) / delta, idx.audioTotalSamples);
+}
+
 Error QuickTimeReader::parseSampleTable(int64_t stblPayloadOffset, int64_t stblPayloadEnd, QuickTimeSampleIndex &out,
                                         bool isAudio) {
         IODevice  *dev = activeDevice();
@@ -1279,6 +1354,268 @@ Error QuickTimeReader::ensureImageFile() {
         return _metaFile != nullptr ? Error::Ok : Error::NotOpen;
 }
 
+// ---------------------------------------------------------------------------
+// Read-ahead
+//
+// Playback asks for one video sample per frame plus that frame's audio,
+// timecode and ancillary samples, each a separate small seek + read.
+// With read-ahead on, reads of the anchor (first video) track move a
+// playhead.  Once fewer than half a window of frames is fetched ahead
+// of it, the next window of every track's samples is located through
+// the sample tables, merged into a few large offset-ordered reads
+// (whole chunks for compact audio) and handed to AsyncFileIO, so the
+// device sees large reads well before the samples are wanted and the
+// per-sample reads become copies out of memory.
+// ---------------------------------------------------------------------------
+
+Error QuickTimeReader::setReadahead(uint32_t frames, uint64_t maxBytes) {
+        if (!_isOpen) return Error::NotOpen;
+        delete _readahead;
+        _readahead = nullptr;
+        if (frames == 0 || maxBytes == 0) return Error::Ok;
+
+        size_t anchor = _tracks.size();
+        for (size_t i = 0; i < _tracks.size(); ++i) {
+                if (_tracks[i].type() == QuickTime::Video && sampleCount(_sampleIndices[i]) > 0) {
+                        anchor = i;
+                        break;
+                }
+        }
+        if (anchor == _tracks.size() || _tracks[anchor].timescale() == 0) return Error::NotSupported;
+
+        _readahead = new Readahead();
+        _readahead->frames = frames;
+        _readahead->maxBytes = maxBytes;
+        _readahead->anchorTrack = anchor;
+        // A user IODevice has no handle to read positionally, so it is
+        // prefetched synchronously; the coalescing still applies.
+        //
+        // Prefetches get their own handle: readBulk() flips O_DIRECT on
+        // _metaFile's descriptor for cache misses, and that flag would
+        // make a concurrent unaligned prefetch on the same descriptor
+        // fail with EINVAL.
+        if (_device == nullptr && _metaFile != nullptr) {
+                _readahead->file.setFilename(_filename);
+                if (_readahead->file.open(IODevice::ReadOnly).isOk()) {
+                        _readahead->aio = UniquePtr<AsyncFileIO>::create(ReadaheadQueueDepth);
+                        if (!_readahead->aio->isValid()) _readahead->aio = UniquePtr<AsyncFileIO>();
+                }
+        }
+        return Error::Ok;
+}
+
+void QuickTimeReader::invalidateReadahead() {
+        if (_readahead == nullptr) return;
+        if (!_readahead->blocks.isEmpty()) _readahead->stats.invalidations++;
+        readaheadDrop();
+        return;
+}
+
+QuickTime::ReadaheadStats QuickTimeReader::readaheadStats() const {
+        return _readahead != nullptr ? _readahead->stats : QuickTime::ReadaheadStats();
+}
+
+void QuickTimeReader::readaheadDrop() {
+        Readahead &ra = *_readahead;
+        // Pending reads keep their buffers alive until they land, so
+        // dropping the blocks here is safe.
+        ra.blocks.clear();
+        ra.stats.cachedBytes = 0;
+        ra.hasPlayhead = false;
+        ra.coveredFrom = 0;
+        ra.coveredTo = 0;
+        return;
+}
+
+void QuickTimeReader::readaheadAdvance(uint64_t frame) {
+        Readahead     &ra = *_readahead;
+        const uint64_t count = sampleCount(_sampleIndices[ra.anchorTrack]);
+        const uint64_t window = ra.frames;
+
+        if (ra.hasPlayhead && frame != ra.playhead) {
+                const uint64_t jump = frame > ra.playhead ? frame - ra.playhead : ra.playhead - frame;
+                const int      dir = frame > ra.playhead ? 1 : -1;
+                if (jump > window) {
+                        // A seek nobody announced: whatever is pending
+                        // was read for somewhere else.
+                        if (!ra.blocks.isEmpty()) ra.stats.invalidations++;
+                        readaheadDrop();
+                } else if (dir != ra.direction) {
+                        // Keep what is cached, but the window now has to
+                        // grow the other way.
+                        ra.coveredFrom = 0;
+                        ra.coveredTo = 0;
+                }
+                ra.direction = dir;
+        }
+        ra.hasPlayhead = true;
+        ra.playhead = frame;
+
+        const bool inside = ra.coveredFrom <= frame && frame < ra.coveredTo;
+        uint64_t   from = 0;
+        uint64_t   to = 0;
+        if (ra.direction > 0) {
+                if (inside && frame + window / 2 < ra.coveredTo) return;
+                from = inside ? ra.coveredTo : frame;
+                to = std::min<uint64_t>(frame + window, count);
+                if (from >= to) return;
+                if (!inside) ra.coveredFrom = from;
+                ra.coveredTo = to;
+        } else {
+                if (inside && ra.coveredFrom + window / 2 <= frame) return;
+                to = inside ? ra.coveredFrom : frame + 1;
+                from = frame + 1 > window ? frame + 1 - window : 0;
+                if (from >= to) return;
+                if (!inside) ra.coveredTo = to;
+                ra.coveredFrom = from;
+        }
+        readaheadPrefetch(from, to, ra.direction);
+        return;
+}
+
+void QuickTimeReader::readaheadPrefetch(uint64_t from, uint64_t to, int direction) {
+        Readahead                  &ra = *_readahead;
+        const QuickTime::Track     &anchorTrack = _tracks[ra.anchorTrack];
+        const QuickTimeSampleIndex &anchor = _sampleIndices[ra.anchorTrack];
+
+        // The window as a span of anchor media time, mapped onto each
+        // track's own timescale through the presentation timeline.
+        const int64_t startDts = sampleDts(anchor, from);
+        int64_t endDts = 0;
+        if (to < sampleCount(anchor)) {
+                endDts = sampleDts(anchor, to);
+        } else {
+                endDts = sampleDts(anchor, to - 1) +
+                         (anchor.audioCompact ? anchor.audioSampleDelta : anchor.duration[to - 1]);
+        }
+        const double startSec = static_cast<double>(startDts - anchorTrack.editStartOffset()) / anchorTrack.timescale();
+        const double endSec = static_cast<double>(endDts - anchorTrack.editStartOffset()) / anchorTrack.timescale();
+
+        List<ReadaheadExtent> extents;
+        for (size_t t = 0; t < _tracks.size(); ++t) {
+                const QuickTime::Track     &track = _tracks[t];
+                const QuickTimeSampleIndex &idx = _sampleIndices[t];
+                const uint64_t              count = sampleCount(idx);
+                if (count == 0 || track.timescale() == 0) continue;
+                const int64_t lo = static_cast<int64_t>(std::floor(startSec * track.timescale())) +
+                                   track.editStartOffset();
+                const int64_t hi = static_cast<int64_t>(std::ceil(endSec * track.timescale())) +
+                                   track.editStartOffset();
+                uint64_t first = sampleAtOrAfterDts(idx, lo);
+                // Include the sample that straddles the window start.
+                if (first > 0 && (first == count || sampleDts(idx, first) > lo)) first--;
+                const uint64_t end = sampleAtOrAfterDts(idx, hi);
+                if (first >= end) continue;
+
+                if (idx.audioCompact) {
+                        // Whole chunks: the writer lays audio out in
+                        // chunks, so this is what is contiguous on disk.
+                        const size_t lastChunk = compactChunkFor(idx, end - 1);
+                        for (size_t c = compactChunkFor(idx, first); c <= lastChunk; ++c) {
+                                extents.pushToBack({idx.audioChunkOffsets[c],
+                                                    static_cast<int64_t>(idx.audioChunkSamplesPerChunk[c]) *
+                                                            idx.audioSampleSize});
+                        }
+                        continue;
+                }
+                for (uint64_t i = first; i < end; ++i) {
+                        const int64_t off = idx.offset[i];
+                        const int64_t sz = idx.size[i];
+                        if (!extents.isEmpty() && extents.back().offset + extents.back().size == off) {
+                                extents.back().size += sz;
+                        } else {
+                                extents.pushToBack({off, sz});
+                        }
+                }
+        }
+
+        // Drop what is already cached, then merge in file order.
+        extents.removeIf([&ra](const ReadaheadExtent &e) {
+                if (e.size <= 0) return true;
+                for (const Readahead::Block &b : ra.blocks) {
+                        if (e.offset >= b.offset && e.offset + e.size <= b.offset + b.size) return true;
+                }
+                return false;
+        });
+        if (extents.isEmpty()) return;
+        std::sort(extents.begin(), extents.end(),
+                  [](const ReadaheadExtent &a, const ReadaheadExtent &b) { return a.offset < b.offset; });
+        List<ReadaheadExtent> runs;
+        for (const ReadaheadExtent &e : extents) {
+                if (!runs.isEmpty()) {
+                        ReadaheadExtent &r = runs.back();
+                        const int64_t    end = std::max(r.offset + r.size, e.offset + e.size);
+                        if (e.offset <= r.offset + r.size + ReadaheadMergeGap && end - r.offset <= ReadaheadMaxRead) {
+                                r.size = end - r.offset;
+                                continue;
+                        }
+                }
+                runs.pushToBack(e);
+        }
+        int64_t want = 0;
+        for (const ReadaheadExtent &r : runs) want += r.size;
+
+        // Make room: blocks the playhead has already passed go first,
+        // least recently used first, then anything else.
+        auto behind = [&ra](const Readahead::Block &b) {
+                return ra.direction > 0 ? b.windowTo <= ra.playhead : b.windowFrom > ra.playhead;
+        };
+        while (!ra.blocks.isEmpty() && ra.stats.cachedBytes + static_cast<uint64_t>(want) > ra.maxBytes) {
+                size_t victim = 0;
+                for (size_t i = 1; i < ra.blocks.size(); ++i) {
+                        const Readahead::Block &b = ra.blocks[i];
+                        const Readahead::Block &v = ra.blocks[victim];
+                        if (behind(b) != behind(v) ? behind(b) : b.lastUse < v.lastUse) victim = i;
+                }
+                ra.stats.cachedBytes -= static_cast<uint64_t>(ra.blocks[victim].size);
+                ra.blocks.remove(victim);
+        }
+
+        // Issue in play order; whatever still does not fit is left
+        // for the ordinary read path.
+        for (size_t n = 0; n < runs.size(); ++n) {
+                const ReadaheadExtent &r = runs[direction > 0 ? n : runs.size() - 1 - n];
+                if (ra.stats.cachedBytes + static_cast<uint64_t>(r.size) > ra.maxBytes) break;
+                Readahead::Block b;
+                b.offset = r.offset;
+                b.size = r.size;
+                b.windowFrom = from;
+                b.windowTo = to;
+                b.lastUse = ++ra.clock;
+                b.data = Buffer(static_cast<size_t>(r.size));
+                if (ra.aio.isValid()) {
+                        b.pending = ra.aio->read(ra.file, r.offset, b.data, static_cast<size_t>(r.size));
+                } else {
+                        IODevice *dev = activeDevice();
+                        int64_t   got = 0;
+                        if (dev->seek(r.offset).isOk()) got = dev->read(b.data.data(), r.size);
+                        b.valid = got > 0 ? got : 0;
+                        b.ready = true;
+                }
+                ra.stats.reads++;
+                ra.stats.bytesRead += static_cast<uint64_t>(r.size);
+                ra.stats.cachedBytes += static_cast<uint64_t>(r.size);
+                ra.blocks.pushToBack(std::move(b));
+        }
+        return;
+}
+
+const uint8_t *QuickTimeReader::readaheadFind(int64_t offset, size_t size) {
+        const int64_t end = offset + static_cast<int64_t>(size);
+        for (Readahead::Block &b : _readahead->blocks) {
+                if (offset < b.offset || end > b.offset + b.size) continue;
+                if (!b.ready) {
+                        auto [got, err] = b.pending.result();
+                        b.valid = err.isOk() ? got : 0;
+                        b.ready = true;
+                }
+                if (end > b.offset + b.valid) return nullptr;
+                b.lastUse = ++_readahead->clock;
+                return static_cast<const uint8_t *>(b.data.data()) + (offset - b.offset);
+        }
+        return nullptr;
+}
+
 // ---------------------------------------------------------------------------
 // readSample
 // ---------------------------------------------------------------------------
@@ -1301,6 +1638,19 @@ Error QuickTimeReader::readSample(size_t trackIndex, uint64_t sampleIndex, Quick
         out.duration = idx.audioCompact ? idx.audioSampleDelta : idx.duration[sampleIndex];
         out.keyframe = idx.audioCompact ? true : (idx.keyframe[sampleIndex] != 0);
 
+        if (_readahead != nullptr) {
+                if (trackIndex == _readahead->anchorTrack) readaheadAdvance(sampleIndex);
+                if (const uint8_t *cached = readaheadFind(off, sz)) {
+                        _readahead->stats.hits++;
+                        Buffer buf(static_cast<size_t>(sz));
+                        std::memcpy(buf.data(), cached, sz);
+                        buf.setSize(sz);
+                        out.data = Buffer(std::move(buf));
+                        return Error::Ok;
+                }
+                _readahead->stats.misses++;
+        }
+
         if (track.type() == QuickTime::Video && _metaFile != nullptr) {
                 File  *f = _metaFile;
                 size_t align = Buffer::DefaultAlign;
@@ -1372,6 +1722,7 @@ Error QuickTimeReader::readSampleRange(size_t trackIndex, uint64_t startSampleIn
         size_t   dstPos = 0;
 
         IODevice *dev = activeDevice();
+        bool      allCached = true;
 
         // Walk the range, coalescing samples that are adjacent on disk
         // (sample[i+1].offset == sample[i].offset + sample[i].size) into
@@ -1388,6 +1739,14 @@ Error QuickTimeReader::readSampleRange(size_t trackIndex, uint64_t startSampleIn
                         runBytes += sampleSize(idx, startSampleIndex + j);
                         j++;
                 }
+                const uint8_t *cached = _readahead != nullptr ? readaheadFind(startOff, runBytes) : nullptr;
+                if (cached != nullptr) {
+                        std::memcpy(dst + dstPos, cached, runBytes);
+                        dstPos += runBytes;
+                        i = j;
+                        continue;
+                }
+                allCached = false;
                 Error e = dev->seek(startOff);
                 if (e.isError()) return e;
                 int64_t got = dev->read(dst + dstPos, static_cast<int64_t>(runBytes));
@@ -1400,6 +1759,12 @@ Error QuickTimeReader::readSampleRange(size_t trackIndex, uint64_t startSampleIn
                 i = j;
         }
         out_buf.setSize(dstPos);
+        if (_readahead != nullptr) {
+                if (allCached)
+                        _readahead->stats.hits++;
+                else
+                        _readahead->stats.misses++;
+        }
 
         // Populate the Sample with the first sample's metadata.
         int64_t firstDts = sampleDts(idx, startSampleIndex);
@@ -71,7 +71,10 @@ struct QuickTimeSampleIndex {
  * The file handle is held via raw pointer so the containing class
  * stays (shallow-)copyable for the PROMEKI_SHARED_BASE clone machinery,
  * matching the established AudioFile::Impl pattern. Ownership is
- * managed manually in open()/close()/~QuickTimeReader().
+ * managed manually in open()/close()/~QuickTimeReader().  The optional
+ * read-ahead cache (@c _readahead) follows the same pattern and is
+ * released before the file is closed, so no prefetch is left reading
+ * from a closed handle.
  */
 class QuickTimeReader : public QuickTime::Impl {
                 PROMEKI_SHARED_DERIVED(QuickTimeReader)
@@ -88,7 +91,13 @@ class QuickTimeReader : public QuickTime::Impl {
                 Error readSampleRange(size_t trackIndex, uint64_t startSampleIndex, uint64_t count,
                                       QuickTime::Sample &out) override;
 
+                Error                     setReadahead(uint32_t frames, uint64_t maxBytes) override;
+                void                      invalidateReadahead() override;
+                QuickTime::ReadaheadStats readaheadStats() const override;
+
         private:
+                /** @brief Read-ahead cache state; defined in quicktime_reader.cpp. */
+                struct Readahead;
                 /** @brief Holds per-track timecode entry parameters until the
                  *         single tmcd sample is read and turned into a Timecode. */
                 struct TimecodeTrackInfo {
@@ -208,7 +217,29 @@ class QuickTimeReader : public QuickTime::Impl {
                  *         this just verifies _metaFile is non-null. */
                 Error ensureImageFile();
 
+                /** @brief Returns the index of the first sample of @p idx whose
+                 *         dts is at or after @p dts (sampleCount() if none). */
+                uint64_t sampleAtOrAfterDts(const QuickTimeSampleIndex &idx, int64_t dts) const;
+
+                /** @brief Moves the read-ahead playhead to anchor sample
+                 *         @p frame and prefetches ahead of it when the
+                 *         window runs low. */
+                void readaheadAdvance(uint64_t frame);
+
+                /** @brief Reads every track's samples that fall within anchor
+                 *         samples [@p from, @p to) into the cache. */
+                void readaheadPrefetch(uint64_t from, uint64_t to, int direction);
+
+                /** @brief Returns the cached copy of @p size bytes at file
+                 *         offset @p offset, waiting for a pending prefetch if
+                 *         one covers them, or nullptr on a miss. */
+                const uint8_t *readaheadFind(int64_t offset, size_t size);
+
+                /** @brief Drops every cached and pending block. */
+                void readaheadDrop();
+
                 File                      *_metaFile = nullptr;
+                Readahead                 *_readahead = nullptr; ///< Owned; see setReadahead().
                 bool                       _isOpen = false;
                 uint32_t                   _movieTimescale = 0;
                 uint64_t                   _movieDuration = 0;
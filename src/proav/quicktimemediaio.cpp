@@ -249,6 +249,8 @@ QuickTimeFactory::Config::SpecMap QuickTimeFactory::configSpecs() const {
         s(MediaConfig::QuickTimeFragmentFrames, int32_t(QuickTimeMediaIO::DefaultFragmentFrames));
         s(MediaConfig::QuickTimeFlushSync, false);
         s(MediaConfig::QuickTimeCaptionReadPolicy, QuickTimeCaptionReadPolicy::Auto);
+        s(MediaConfig::QuickTimeReadaheadFrames, int32_t(QuickTimeMediaIO::DefaultReadaheadFrames));
+        s(MediaConfig::QuickTimeReadaheadMiB, int32_t(QuickTimeMediaIO::DefaultReadaheadMiB));
         // PCM = uncompressed lpcm track (historical default).  Set to a
         // compressed codec to have the planner splice an AudioEncoder.
         s(MediaConfig::QuickTimeAudioCodec, AudioCodec(AudioCodec::PCM));
@@ -429,6 +431,20 @@ Error QuickTimeMediaIO::executeCmd(MediaIOCommandOpen &cmd) {
                 _audioSampleCursor = 0;
                 _currentFrame = 0;
 
+                // Prefetch every track's samples ahead of the playhead.
+                // The reader anchors on the video track, so audio-only
+                // files keep reading on demand.
+                const int raFrames = cfg.getAs<int>(MediaConfig::QuickTimeReadaheadFrames, DefaultReadaheadFrames);
+                const int raMiB = cfg.getAs<int>(MediaConfig::QuickTimeReadaheadMiB, DefaultReadaheadMiB);
+                if (raFrames > 0 && raMiB > 0 && _videoTrackIndex >= 0) {
+                        Error raErr = _qt.setReadahead(static_cast<uint32_t>(raFrames),
+                                                       static_cast<uint64_t>(raMiB) << 20);
+                        if (raErr.isError()) {
+                                promekiWarn("QuickTimeMediaIO: read-ahead unavailable for '%s': %s",
+                                            _filename.cstr(), raErr.name().cstr());
+                        }
+                }
+
                 outMediaDesc = mediaDesc;
                 outFrameCount = _frameCount;
                 outCanSeek = true;
@@ -1210,6 +1226,7 @@ Error QuickTimeMediaIO::executeCmd(MediaIOCommandSeek &cmd) {
                 target = _frameCount.value() - 1;
         }
         _currentFrame = FrameNumber(target);
+        _qt.invalidateReadahead();
 
         // Reposition the audio read cursor to match the seek target so audio
         // stays in sync after a seek.  The cursor counts PCM samples for PCM
@@ -1230,6 +1247,22 @@ Error QuickTimeMediaIO::executeCmd(MediaIOCommandSeek &cmd) {
         return Error::Ok;
 }
 
+// ============================================================================
+// Stats
+// ============================================================================
+
+Error QuickTimeMediaIO::executeCmd(MediaIOCommandStats &cmd) {
+        if (!_isOpen || _isWrite) return Error::Ok;
+        const QuickTime::ReadaheadStats ra = _qt.readaheadStats();
+        cmd.stats.set(StatsReadaheadHits, static_cast<int64_t>(ra.hits));
+        cmd.stats.set(StatsReadaheadMisses, static_cast<int64_t>(ra.misses));
+        cmd.stats.set(StatsReadaheadReads, static_cast<int64_t>(ra.reads));
+        cmd.stats.set(StatsReadaheadBytes, static_cast<int64_t>(ra.bytesRead));
+        cmd.stats.set(StatsReadaheadCachedBytes, static_cast<int64_t>(ra.cachedBytes));
+        cmd.stats.set(StatsReadaheadInvalidations, static_cast<int64_t>(ra.invalidations));
+        return Error::Ok;
+}
+
 // ============================================================================
 // Negotiation overrides
 // ============================================================================
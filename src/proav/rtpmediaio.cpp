@@ -355,7 +355,14 @@ class RtpMediaIO::VideoPacketizerThread : public RtpPacketizerThread {
                                 }
                         }
 
-                        auto packets = vs.payload->pack(bsData, bsSize);
+                        // Uncompressed frames are packed straight out of
+                        // the plane Buffer: packets reference the
+                        // sample data in place and the transport
+                        // gathers it, so no per-frame payload copy is
+                        // made here.
+                        auto packets = payload.isCompressed()
+                                               ? vs.payload->pack(bsData, bsSize)
+                                               : vs.payload->packBuffer(plane0.buffer(), plane0.offset(), bsSize);
                         if (packets.isEmpty()) return;
 
                         RtpPacketBatch batch;
@@ -619,6 +626,7 @@ RtpFactory::Config::SpecMap RtpFactory::configSpecs() const {
         s(MediaConfig::RtpMaxReadQueueDepth, int32_t(8));
         s(MediaConfig::RtpRecvBufferBytes, int32_t(8 * 1024 * 1024));
         s(MediaConfig::RtpSendBufferBytes, int32_t(8 * 1024 * 1024));
+        s(MediaConfig::RtpZeroCopy, false);
         // Per-stream defaults.
         s(MediaConfig::VideoRtpDestination, SocketAddress());
         s(MediaConfig::VideoRtpPayloadType, int32_t(96));
@@ -931,6 +939,8 @@ void RtpMediaIO::resetReaderStream(ReaderStream &s) {
         s.framesDroppedValidate.setValue(0);
         s.framesWaitingParamSets.setValue(0);
         s.framesDroppedSsrcReset.setValue(0);
+        s.framesIncomplete.setValue(0);
+        s.linesMissing.setValue(0);
         s.packetsReceived.setValue(0);
         s.bytesReceived.setValue(0);
         s.framesReceived = 0;
@@ -1320,6 +1330,7 @@ Error RtpMediaIO::openStream(WriterStream &s, bool enableMulticastLoopback) {
         // datagrams.  Default true; configurable via @ref
         // MediaConfig::RtpDontFragment.
         s.transport->setDontFragment(_rtpDontFragment);
+        if (_rtpZeroCopy) s.transport->setZeroCopy(true);
 
         Error err = s.transport->open();
         if (err.isError()) {
@@ -1354,6 +1365,7 @@ Error RtpMediaIO::openStream(WriterStream &s, bool enableMulticastLoopback) {
                 s.transportSecondary->setSendBufferSize(_sendBufferBytes);
                 s.transportSecondary->setReceiveBufferSize(_recvBufferBytes);
                 s.transportSecondary->setDontFragment(_rtpDontFragment);
+                if (_rtpZeroCopy) s.transportSecondary->setZeroCopy(true);
                 Error err2 = s.transportSecondary->open();
                 if (err2.isError()) {
                         promekiErr("RtpMediaIO: failed to open %s secondary transport: %s",
@@ -1729,10 +1741,16 @@ Error RtpMediaIO::openReaderStream(ReaderStream &s, bool /*enableMulticastLoopba
                 ctx.framesDroppedValidate = &vrs->framesDroppedValidate;
                 ctx.framesWaitingParamSets = &vrs->framesWaitingParamSets;
                 ctx.framesDroppedSsrcReset = &vrs->framesDroppedSsrcReset;
+                ctx.framesIncomplete = &vrs->framesIncomplete;
+                ctx.linesMissing = &vrs->linesMissing;
                 ctx.rxPacketInterval = &vrs->rxPacketInterval;
                 ctx.rxFrameInterval = &vrs->rxFrameInterval;
                 ctx.rxFrameAssembleTime = &vrs->rxFrameAssembleTime;
                 ctx.noteFrameReceived = [vrs]() { vrs->framesReceived++; };
+                // Raw video lands straight in the plane the reader
+                // hands downstream, so it comes from this MediaIO's
+                // allocator like any other reader-produced plane.
+                ctx.allocatePlane = [alloc = allocator()](size_t bytes) { return alloc->allocateBytes(bytes); };
                 ctx.refreshStreamClock = [this, vrs]() { refreshStreamClock(*vrs); };
                 ctx.ntpToSteady = [this](const NtpTime &ntp) { return ntpToSteady(ntp); };
                 depkt = UniquePtr<RtpVideoDepacketizerThread>::create(
@@ -1825,6 +1843,13 @@ Error RtpMediaIO::openReaderStream(ReaderStream &s, bool /*enableMulticastLoopba
 
         s.depacketizer->start();
 
+        // Received packets are views of the recv thread's slabs, so
+        // its pool has to cover everything held downstream at once:
+        // a full reorder window, a full depacketizer queue and the
+        // frame being reassembled — five frames at the budget's two
+        // per frame.
+        s.session->setReceivePacketBudget(pktBudget * 2 + pktBudget / 2);
+
         Error recvErr = s.session->startReceiving(std::move(receivers), threadName);
         if (recvErr.isError()) {
                 promekiErr("RtpMediaIO: startReceiving on %s failed: %s", s.mediaType.cstr(),
@@ -2691,6 +2716,7 @@ void RtpMediaIO::applyClockReferenceConfig(const MediaIO::Config &cfg) {
         // Config view at emit time.
         _rtpSourceAddress = cfg.getAs<String>(MediaConfig::RtpSourceAddress, String());
         _rtpDontFragment = cfg.getAs<bool>(MediaConfig::RtpDontFragment, true);
+        _rtpZeroCopy = cfg.getAs<bool>(MediaConfig::RtpZeroCopy, false);
 
         const auto resolveTsMode = [&](MediaConfig::ID id) -> RtpTsMode {
                 Error e;
@@ -5060,6 +5086,8 @@ Error RtpMediaIO::executeCmd(MediaIOCommandStats &cmd) {
                 int64_t  framesDroppedValidate = 0;
                 int64_t  framesWaitingParamSets = 0;
                 int64_t  framesDroppedSsrcReset = 0;
+                int64_t  framesIncomplete = 0;
+                int64_t  linesMissing = 0;
                 uint32_t firstExtHighestSeq = 0;
                 uint32_t firstPacketsExpected = 0;
                 uint8_t  firstFractionLost = 0;
@@ -5071,6 +5099,8 @@ Error RtpMediaIO::executeCmd(MediaIOCommandStats &cmd) {
                         framesDroppedValidate += s.framesDroppedValidate.value();
                         framesWaitingParamSets += s.framesWaitingParamSets.value();
                         framesDroppedSsrcReset += s.framesDroppedSsrcReset.value();
+                        framesIncomplete += s.framesIncomplete.value();
+                        linesMissing += s.linesMissing.value();
                         if (s.seqTracker.isValid()) {
                                 RtpSeqTracker::Stats ts = s.seqTracker->snapshot();
                                 duplicatePackets += static_cast<int64_t>(ts.duplicatePackets);
@@ -5117,6 +5147,8 @@ Error RtpMediaIO::executeCmd(MediaIOCommandStats &cmd) {
                 cmd.stats.set(StatsRxFramesDroppedValidate, framesDroppedValidate);
                 cmd.stats.set(StatsRxFramesWaitingParamSets, framesWaitingParamSets);
                 cmd.stats.set(StatsRxFramesDroppedSsrcReset, framesDroppedSsrcReset);
+                cmd.stats.set(StatsRxFramesIncomplete, framesIncomplete);
+                cmd.stats.set(StatsRxLinesMissing, linesMissing);
 
                 // RTCP-side sender-report observability.  srObserved
                 // is summed across every active reader-side
@@ -21,8 +21,12 @@ ThreadPool &SharedThreadMediaIO::pool() {
         // the worker threads; otherwise each std::thread's shared state
         // is "definitely lost" under valgrind because the threads stay
         // alive past main().
+        //
+        // Work-stealing so strands re-arming themselves from a worker
+        // stay on that worker's own queue instead of all contending
+        // on one pool mutex.
         struct PoolHolder {
-                        ThreadPool tp;
+                        ThreadPool tp{-1, true, ThreadPool::Scheduler::WorkStealing};
                         PoolHolder() {
                                 tp.setNamePrefix("media");
                                 tp.setName("media");
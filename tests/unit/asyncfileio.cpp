@@ -0,0 +1,233 @@
+/**
+ * @file      asyncfileio.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <doctest/doctest.h>
+#include <promeki/asyncfileio.h>
+#include <promeki/atomic.h>
+#include <promeki/bufferpool.h>
+#include <promeki/file.h>
+#include <promeki/list.h>
+
+using namespace promeki;
+
+namespace {
+
+        const char *testPath(const char *name) {
+                static char buf[256];
+                std::snprintf(buf, sizeof(buf), "/tmp/promeki_test_aio_%s.tmp", name);
+                return buf;
+        }
+
+        // Engines to exercise: the pool always, io_uring where the
+        // kernel provides it.
+        List<AsyncFileIO::Engine> engines() {
+                List<AsyncFileIO::Engine> ret;
+                ret.pushToBack(AsyncFileIO::Engine::ThreadPool);
+                if (AsyncFileIO::ioUringAvailable()) ret.pushToBack(AsyncFileIO::Engine::IoUring);
+                return ret;
+        }
+
+        uint8_t pattern(size_t i) { return static_cast<uint8_t>((i * 31u) ^ (i >> 8)); }
+
+} // namespace
+
+TEST_CASE("AsyncFileIO: engine selection") {
+        AsyncFileIO pool(8, AsyncFileIO::Engine::ThreadPool);
+        CHECK(pool.isValid());
+        CHECK(pool.engine() == AsyncFileIO::Engine::ThreadPool);
+        CHECK(pool.queueDepth() == 8);
+        CHECK(pool.inFlight() == 0);
+
+        AsyncFileIO aut;
+        CHECK(aut.isValid());
+        CHECK(aut.engine() != AsyncFileIO::Engine::Auto);
+        CHECK(aut.engine() == (AsyncFileIO::ioUringAvailable() ? AsyncFileIO::Engine::IoUring
+                                                                : AsyncFileIO::Engine::ThreadPool));
+
+        AsyncFileIO clamped(0, AsyncFileIO::Engine::ThreadPool);
+        CHECK(clamped.queueDepth() == 1);
+}
+
+TEST_CASE("AsyncFileIO: write then read back at offsets") {
+        constexpr size_t Chunk = 4096;
+        constexpr int    Chunks = 16;
+        for (AsyncFileIO::Engine engine : engines()) {
+                CAPTURE(static_cast<int>(engine));
+                const char *path = testPath("rw");
+                std::remove(path);
+                File f(path);
+                REQUIRE(f.open(IODevice::ReadWrite, File::Create | File::Truncate).isOk());
+
+                AsyncFileIO aio(4, engine);
+                REQUIRE(aio.isValid());
+
+                uint8_t src[Chunk * Chunks];
+                for (size_t i = 0; i < sizeof(src); i++) src[i] = pattern(i);
+
+                // Written back to front so completion order cannot
+                // paper over an offset mistake.
+                List<Future<int64_t>> writes;
+                for (int c = Chunks - 1; c >= 0; c--) {
+                        writes.pushToBack(aio.write(f, c * static_cast<int64_t>(Chunk), src + c * Chunk, Chunk));
+                }
+                for (Future<int64_t> &w : writes) {
+                        auto [n, err] = w.result();
+                        CHECK(err.isOk());
+                        CHECK(n == static_cast<int64_t>(Chunk));
+                }
+
+                uint8_t dst[Chunk * Chunks];
+                std::memset(dst, 0, sizeof(dst));
+                List<Future<int64_t>> reads;
+                for (int c = 0; c < Chunks; c++) {
+                        reads.pushToBack(aio.read(f, c * static_cast<int64_t>(Chunk), dst + c * Chunk, Chunk));
+                }
+                for (Future<int64_t> &r : reads) {
+                        auto [n, err] = r.result();
+                        CHECK(err.isOk());
+                        CHECK(n == static_cast<int64_t>(Chunk));
+                }
+                CHECK(std::memcmp(src, dst, sizeof(src)) == 0);
+
+                // A read past end of file comes back short, like pread.
+                auto [tail, tailErr] = aio.read(f, sizeof(src) - 100, dst, Chunk).result();
+                CHECK(tailErr.isOk());
+                CHECK(tail == 100);
+                // A future resolves from inside the completion, just
+                // before the request leaves the in-flight count.
+                aio.waitForIdle();
+                CHECK(aio.inFlight() == 0);
+
+                f.close();
+                std::remove(path);
+        }
+}
+
+TEST_CASE("AsyncFileIO: batch submit runs every callback once") {
+        constexpr size_t Block = 512;
+        constexpr int    Count = 40;
+        for (AsyncFileIO::Engine engine : engines()) {
+                CAPTURE(static_cast<int>(engine));
+                const char *path = testPath("batch");
+                std::remove(path);
+                File f(path);
+                REQUIRE(f.open(IODevice::ReadWrite, File::Create | File::Truncate).isOk());
+
+                // Queue depth well under the batch size exercises the
+                // back-pressure path.
+                AsyncFileIO aio(3, engine);
+                BufferPool  pool(Block);
+                Atomic<int> done(0);
+                Atomic<int> bytes(0);
+
+                List<AsyncFileIO::Request> batch;
+                for (int i = 0; i < Count; i++) {
+                        Buffer buf = pool.acquire();
+                        std::memset(buf.data(), i, Block);
+                        AsyncFileIO::Request req;
+                        req.op = AsyncFileIO::Op::Write;
+                        req.handle = f.handle();
+                        req.offset = i * static_cast<int64_t>(Block);
+                        req.data = buf.data();
+                        req.size = Block;
+                        req.keep = buf;
+                        req.callback = [&done, &bytes](int64_t n, Error err) {
+                                if (err.isOk()) bytes.fetchAndAdd(static_cast<int>(n));
+                                done.fetchAndAdd(1);
+                        };
+                        batch.pushToBack(std::move(req));
+                }
+                CHECK(aio.submit(std::move(batch)).isOk());
+                aio.waitForIdle();
+                CHECK(done.value() == Count);
+                CHECK(bytes.value() == Count * static_cast<int>(Block));
+
+                // Spot-check the bytes actually landed in order.
+                uint8_t probe = 0xff;
+                for (int i = 0; i < Count; i += 7) {
+                        auto [n, err] = aio.read(f, i * static_cast<int64_t>(Block) + 5, &probe, 1).result();
+                        CHECK(n == 1);
+                        CHECK(probe == static_cast<uint8_t>(i));
+                }
+
+                f.close();
+                std::remove(path);
+        }
+}
+
+TEST_CASE("AsyncFileIO: rejected requests fail through their callback") {
+        AsyncFileIO aio(4, AsyncFileIO::Engine::ThreadPool);
+        File        closed;
+        uint8_t     byte = 0;
+
+        auto [n, err] = aio.read(closed, 0, &byte, 1).result();
+        CHECK(n == 0);
+        CHECK(err == Error::NotOpen);
+
+        List<AsyncFileIO::Request> batch;
+        Error                      seen;
+        AsyncFileIO::Request       req;
+        req.handle = closed.handle();
+        req.data = &byte;
+        req.size = 1;
+        req.callback = [&seen](int64_t, Error e) { seen = e; };
+        batch.pushToBack(std::move(req));
+        CHECK(aio.submit(std::move(batch)) == Error::NotOpen);
+        CHECK(seen == Error::NotOpen);
+}
+
+TEST_CASE("AsyncFileIO: registered files and buffers") {
+        constexpr size_t Block = 4096;
+        for (AsyncFileIO::Engine engine : engines()) {
+                CAPTURE(static_cast<int>(engine));
+                const char *path = testPath("fixed");
+                std::remove(path);
+                File f(path);
+                REQUIRE(f.open(IODevice::ReadWrite, File::Create | File::Truncate).isOk());
+
+                AsyncFileIO aio(8, engine);
+                REQUIRE(aio.registerFile(f).isOk());
+                // Registering twice is harmless.
+                CHECK(aio.registerFile(f).isOk());
+
+                BufferPool   pool(Block * 4, 4096);
+                Buffer       arena = pool.acquire();
+                List<Buffer> regs;
+                regs.pushToBack(arena);
+                Error regErr = aio.registerBuffers(regs);
+                // Pinning can be refused by RLIMIT_MEMLOCK; the requests
+                // below must work either way.
+                INFO("registerBuffers: ", regErr.name().cstr());
+
+                uint8_t *base = static_cast<uint8_t *>(arena.data());
+                for (size_t i = 0; i < Block * 2; i++) base[i] = pattern(i);
+                auto [w, wErr] = aio.write(f, 0, base, Block * 2).result();
+                CHECK(wErr.isOk());
+                CHECK(w == static_cast<int64_t>(Block * 2));
+
+                std::memset(base + Block * 2, 0, Block * 2);
+                auto [r, rErr] = aio.read(f, 0, base + Block * 2, Block * 2).result();
+                CHECK(rErr.isOk());
+                CHECK(r == static_cast<int64_t>(Block * 2));
+                CHECK(std::memcmp(base, base + Block * 2, Block * 2) == 0);
+
+                aio.unregisterBuffers();
+                aio.unregisterFile(f);
+
+                // Still works through the plain path afterwards.
+                uint8_t probe = 0;
+                auto [p, pErr] = aio.read(f, 10, &probe, 1).result();
+                CHECK(pErr.isOk());
+                CHECK(p == 1);
+                CHECK(probe == pattern(10));
+
+                f.close();
+                std::remove(path);
+        }
+}
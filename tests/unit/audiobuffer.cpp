@@ -6,7 +6,9 @@
  */
 
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <thread>
 #include <doctest/doctest.h>
 #include <promeki/audiobuffer.h>
 #include <promeki/audiochannelmap.h>
@@ -1301,3 +1303,194 @@ TEST_CASE("AudioBuffer: push(planar payload) returns NotSupported") {
         Error           err = ab.push(planar);
         CHECK(err == Error::NotSupported);
 }
+
+// ============================================================================
+// Lock-free SPSC mode
+// ============================================================================
+
+TEST_CASE("AudioBuffer: Spsc mode round-trips across the wraparound boundary") {
+        AudioBuffer ab(s16LE48k2ch(), 8);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        CHECK(ab.mode() == AudioBuffer::Mode::Spsc);
+
+        int16_t first[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        REQUIRE(ab.push(first, 6, s16LE48k2ch()).isOk());
+        CHECK(ab.available() == 6);
+        CHECK(ab.free() == 2);
+        CHECK(ab.push(first, 3, s16LE48k2ch()) == Error::NoSpace);
+
+        int16_t out[16] = {};
+        auto [n1, e1] = ab.pop(out, 4);
+        CHECK(n1 == 4);
+        CHECK(out[0] == 1);
+        CHECK(out[7] == 8);
+
+        // Tail is at slot 6; this push wraps.
+        int16_t second[12] = {21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+        REQUIRE(ab.push(second, 6, s16LE48k2ch()).isOk());
+        CHECK(ab.isFull());
+
+        auto [n2, e2] = ab.pop(out, 8);
+        CHECK(n2 == 8);
+        CHECK(out[0] == 9);
+        CHECK(out[3] == 12);
+        CHECK(out[4] == 21);
+        CHECK(out[15] == 32);
+        CHECK(ab.isEmpty());
+}
+
+TEST_CASE("AudioBuffer: Spsc mode carries PTS anchors through pop and drop") {
+        AudioBuffer ab(s16LE48k2ch(), 1024);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        int16_t       buf[400] = {};
+        const int64_t firstNs = 5'000'000'000;
+        const int64_t secondNs = 6'000'000'000;
+        REQUIRE(ab.push(buf, 100, s16LE48k2ch(), mtsNs(firstNs)).isOk());
+        REQUIRE(ab.push(buf, 100, s16LE48k2ch()).isOk());
+        REQUIRE(ab.push(buf, 100, s16LE48k2ch(), mtsNs(secondNs)).isOk());
+
+        CHECK(ab.nextSamplePts().timeStamp().nanoseconds() == firstNs);
+
+        MediaTimeStamp pts;
+        auto [n1, e1] = ab.pop(buf, 150, &pts);
+        CHECK(n1 == 150);
+        CHECK(pts.timeStamp().nanoseconds() == firstNs);
+
+        // Sample 150 still extends the first anchor.
+        const int64_t expected = firstNs + Duration::fromSamples(150, 48000.0f).nanoseconds();
+        CHECK(ab.nextSamplePts().timeStamp().nanoseconds() == expected);
+
+        auto [d, de] = ab.drop(50);
+        CHECK(d == 50);
+        CHECK(ab.nextSamplePts().timeStamp().nanoseconds() == secondNs);
+
+        ab.pop(buf, 100);
+        CHECK_FALSE(ab.nextSamplePts().isValid());
+}
+
+TEST_CASE("AudioBuffer: Spsc setInputFormat ends the timeline at the next sample") {
+        AudioBuffer ab(s16LE48k2ch(), 64);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        int16_t buf[16] = {};
+        REQUIRE(ab.push(buf, 4, s16LE48k2ch(), mtsNs(1'000)).isOk());
+        ab.setInputFormat(s16LE48k2ch());
+        REQUIRE(ab.push(buf, 4, s16LE48k2ch()).isOk());
+
+        // Already-buffered samples keep their PTS; the ones pushed
+        // after the reset have none until a new anchor arrives.
+        MediaTimeStamp pts;
+        ab.pop(buf, 4, &pts);
+        CHECK(pts.timeStamp().nanoseconds() == 1'000);
+        ab.pop(buf, 4, &pts);
+        CHECK_FALSE(pts.isValid());
+}
+
+TEST_CASE("AudioBuffer: Spsc reserve preserves wrapped contents") {
+        AudioBuffer ab(s16LE48k2ch(), 4);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        int16_t in[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        REQUIRE(ab.push(in, 3, s16LE48k2ch()).isOk());
+        int16_t out[16] = {};
+        ab.pop(out, 2);
+        REQUIRE(ab.push(in, 3, s16LE48k2ch()).isOk());
+
+        REQUIRE(ab.reserve(16).isOk());
+        CHECK(ab.capacity() == 16);
+        CHECK(ab.available() == 4);
+        REQUIRE(ab.push(in, 4, s16LE48k2ch()).isOk());
+
+        auto [n, err] = ab.pop(out, 8);
+        CHECK(n == 8);
+        const int16_t expected[16] = {5, 6, 1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6, 7, 8};
+        CHECK(std::memcmp(out, expected, sizeof(expected)) == 0);
+}
+
+TEST_CASE("AudioBuffer: Spsc producer and consumer threads stay in order") {
+        const AudioDesc desc(AudioFormat::PCMI_S32LE, 48000.0f, 1);
+        AudioBuffer     ab(desc, 512);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        const int32_t total = 200000;
+        bool          producerOk = true;
+
+        // Each push lays an anchor whose PTS is the sample index in
+        // nanoseconds-per-sample units, so the consumer can check
+        // both the data and the PTS of every pop.
+        std::thread producer([&]() {
+                int32_t chunk[97];
+                int32_t next = 0;
+                size_t  len = 1;
+                while (next < total) {
+                        size_t n = len;
+                        if (n > static_cast<size_t>(total - next)) n = static_cast<size_t>(total - next);
+                        for (size_t i = 0; i < n; ++i) chunk[i] = next + static_cast<int32_t>(i);
+                        const MediaTimeStamp pts =
+                                mtsNs(Duration::fromSamples(next, 48000.0f).nanoseconds());
+                        Error err = ab.push(chunk, n, desc, pts);
+                        if (err == Error::NoSpace) {
+                                std::this_thread::yield();
+                                continue;
+                        }
+                        if (err.isError()) {
+                                producerOk = false;
+                                break;
+                        }
+                        next += static_cast<int32_t>(n);
+                        len = len % 97 + 1;
+                }
+        });
+
+        int32_t expected = 0;
+        int32_t sink[61];
+        size_t  want = 1;
+        bool    inOrder = true;
+        bool    ptsOk = true;
+        while (expected < total && producerOk) {
+                MediaTimeStamp pts;
+                auto [n, err] = ab.pop(sink, want, &pts);
+                if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                }
+                for (size_t i = 0; i < n; ++i) inOrder &= sink[i] == expected + static_cast<int32_t>(i);
+                const int64_t ns = Duration::fromSamples(expected, 48000.0f).nanoseconds();
+                ptsOk &= pts.isValid() && std::llabs(pts.timeStamp().nanoseconds() - ns) <= 1;
+                expected += static_cast<int32_t>(n);
+                want = want % 61 + 1;
+        }
+        producer.join();
+        CHECK(producerOk);
+        CHECK(inOrder);
+        CHECK(ptsOk);
+        CHECK(ab.isEmpty());
+}
+
+TEST_CASE("AudioBuffer: Spsc popWaitPayload wakes on push") {
+        AudioBuffer ab(s16LE48k2ch(), 64);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        std::thread producer([&]() {
+                int16_t buf[16] = {};
+                ab.push(buf, 8, s16LE48k2ch(), mtsNs(42));
+        });
+        auto [out, err] = ab.popWaitPayload(8, 8, 2000);
+        producer.join();
+        REQUIRE(err.isOk());
+        CHECK(out->sampleCount() == 8);
+        CHECK(out->pts().timeStamp().nanoseconds() == 42);
+}
+
+#if PROMEKI_ENABLE_SRC
+TEST_CASE("AudioBuffer: Spsc drift correction steers the fill level") {
+        AudioBuffer ab(s16LE48k2ch(), 16384);
+        REQUIRE(ab.setMode(AudioBuffer::Mode::Spsc).isOk());
+        REQUIRE(ab.enableDriftCorrection(2048, 0.01).isOk());
+        AudioDesc srcDesc(AudioFormat::PCMI_Float32LE, 48000.0f, 2);
+        ab.setInputFormat(srcDesc);
+        List<float> silence(1024 * srcDesc.channels(), 0.0f);
+
+        // Let the buffer overfill: the controller must pull the
+        // ratio below unity using the consumer-published fill level.
+        for (int i = 0; i < 6; ++i) REQUIRE(ab.push(silence.data(), 1024, srcDesc).isOk());
+        REQUIRE(ab.push(silence.data(), 1024, srcDesc).isOk());
+        CHECK(ab.driftRatio() < 1.0);
+}
+#endif
@@ -13,6 +13,7 @@
 #include <promeki/variant.h>
 #include <promeki/datastream.h>
 #include <promeki/bufferiodevice.h>
+#include <promeki/list.h>
 
 using namespace promeki;
 
@@ -759,6 +760,185 @@ TEST_CASE("AudioFormat: registerDirectConverter installs a custom path") {
         (void)called;
 }
 
+// ============================================================================
+// SIMD kernels — every SIMD path must match the scalar reference bit for bit
+// ============================================================================
+
+namespace {
+
+        struct SimdTestRng {
+                        uint32_t state = 0x12345678u;
+                        uint32_t next() {
+                                state = state * 1664525u + 1013904223u;
+                                return state;
+                        }
+        };
+
+        // Forces the scalar (false) or SIMD (true) kernels for one scope.
+        struct SimdScope {
+                        explicit SimdScope(bool enabled) { AudioFormat::setSimdEnabled(enabled); }
+                        ~SimdScope() { AudioFormat::setSimdEnabled(true); }
+        };
+
+        // Odd count so every kernel runs both its vector body and its scalar tail.
+        constexpr size_t SimdTestSamples = 1037;
+
+        List<AudioFormat> pcmFormats() {
+                List<AudioFormat> ret;
+                for (AudioFormat::ID id : AudioFormat::registeredIDs()) {
+                        AudioFormat f(id);
+                        if (f.isValid() && !f.isCompressed() && f.bytesPerSample() > 0) ret.pushToBack(f);
+                }
+                return ret;
+        }
+
+        // Normalized test floats: a spread across [-1.2, 1.2] (so both
+        // clamps fire) plus the exact endpoints and zero.
+        List<float> simdTestFloats(size_t count) {
+                SimdTestRng rng;
+                List<float> ret;
+                const float edges[] = {-1.0f, 1.0f, 0.0f, -0.0f, 0.5f, -0.5f, 1e-9f, -1e-9f, 2.0f, -2.0f};
+                for (float e : edges) ret.pushToBack(e);
+                while (ret.size() < count) {
+                        const int k = static_cast<int>(rng.next() % 2400001u) - 1200000;
+                        ret.pushToBack(static_cast<float>(k) / 1000000.0f);
+                }
+                return ret;
+        }
+
+} // namespace
+
+TEST_CASE("AudioFormat: setSimdEnabled toggles the kernel selection") {
+        CHECK(AudioFormat::isSimdEnabled());
+        {
+                SimdScope scalar(false);
+                CHECK_FALSE(AudioFormat::isSimdEnabled());
+        }
+        CHECK(AudioFormat::isSimdEnabled());
+}
+
+TEST_CASE("AudioFormat: SIMD direct converters match the scalar reference") {
+        SimdTestRng rng;
+        List<uint8_t> in;
+        // +1 so the source can be read from a misaligned offset.
+        for (size_t i = 0; i < SimdTestSamples * 4 + 1; ++i) in.pushToBack(static_cast<uint8_t>(rng.next() >> 24));
+
+        const List<AudioFormat> formats = pcmFormats();
+        size_t                  pairs = 0;
+        for (const AudioFormat &src : formats) {
+                for (const AudioFormat &dst : formats) {
+                        AudioFormat::DirectConvertFn scalarFn, simdFn;
+                        {
+                                SimdScope scope(false);
+                                scalarFn = AudioFormat::directConverter(src.id(), dst.id());
+                        }
+                        simdFn = AudioFormat::directConverter(src.id(), dst.id());
+                        if (scalarFn == nullptr) {
+                                CHECK(simdFn == nullptr);
+                                continue;
+                        }
+                        CAPTURE(src.name());
+                        CAPTURE(dst.name());
+                        List<uint8_t> want(SimdTestSamples * dst.bytesPerSample() + 1, 0);
+                        List<uint8_t> got(SimdTestSamples * dst.bytesPerSample() + 1, 0);
+                        scalarFn(want.data(), in.data() + 1, SimdTestSamples);
+                        simdFn(got.data() + 1, in.data() + 1, SimdTestSamples);
+                        CHECK(std::memcmp(want.data(), got.data() + 1, SimdTestSamples * dst.bytesPerSample()) == 0);
+                        pairs++;
+                }
+        }
+        CHECK(pairs > 0);
+}
+
+TEST_CASE("AudioFormat: SIMD samplesToFloat matches the scalar reference") {
+        SimdTestRng   rng;
+        List<uint8_t> in;
+        for (size_t i = 0; i < SimdTestSamples * 4; ++i) in.pushToBack(static_cast<uint8_t>(rng.next() >> 24));
+        // Float formats get real sample values rather than random bit
+        // patterns so the comparison exercises ordinary data.
+        for (const AudioFormat &f : pcmFormats()) {
+                CAPTURE(f.name());
+                List<float> want(SimdTestSamples, 0.0f);
+                List<float> got(SimdTestSamples, 0.0f);
+                List<uint8_t> bytes = in;
+                if (f.isFloat()) {
+                        const List<float> vals = simdTestFloats(SimdTestSamples);
+                        std::memcpy(bytes.data(), vals.data(), SimdTestSamples * sizeof(float));
+                }
+                {
+                        SimdScope scope(false);
+                        f.samplesToFloat(want.data(), bytes.data(), SimdTestSamples);
+                }
+                f.samplesToFloat(got.data(), bytes.data(), SimdTestSamples);
+                CHECK(std::memcmp(want.data(), got.data(), SimdTestSamples * sizeof(float)) == 0);
+        }
+}
+
+TEST_CASE("AudioFormat: SIMD floatToSamples matches the scalar reference") {
+        const List<float> in = simdTestFloats(SimdTestSamples);
+        for (const AudioFormat &f : pcmFormats()) {
+                CAPTURE(f.name());
+                List<uint8_t> want(SimdTestSamples * f.bytesPerSample(), 0);
+                List<uint8_t> got(SimdTestSamples * f.bytesPerSample(), 0);
+                {
+                        SimdScope scope(false);
+                        f.floatToSamples(want.data(), in.data(), SimdTestSamples);
+                }
+                f.floatToSamples(got.data(), in.data(), SimdTestSamples);
+                CHECK(std::memcmp(want.data(), got.data(), want.size()) == 0);
+        }
+}
+
+TEST_CASE("AudioFormat: SIMD layout transposes match the scalar reference") {
+        struct Case {
+                        AudioFormat::ID src, dst;
+        };
+        // Byte transposes at every sample width, plus a via-float
+        // cross-layout conversion that transposes the float scratch.
+        const Case cases[] = {
+                {AudioFormat::PCMP_S8, AudioFormat::PCMI_S8},
+                {AudioFormat::PCMI_U8, AudioFormat::PCMP_U8},
+                {AudioFormat::PCMP_S16LE, AudioFormat::PCMI_S16LE},
+                {AudioFormat::PCMI_S16BE, AudioFormat::PCMP_S16BE},
+                {AudioFormat::PCMP_S24LE, AudioFormat::PCMI_S24LE},
+                {AudioFormat::PCMI_S24LE, AudioFormat::PCMP_S24LE},
+                {AudioFormat::PCMP_S32LE, AudioFormat::PCMI_S32LE},
+                {AudioFormat::PCMI_Float32LE, AudioFormat::PCMP_Float32LE},
+                {AudioFormat::PCMP_S16LE, AudioFormat::PCMI_S24LE_HB32},
+                {AudioFormat::PCMI_U8, AudioFormat::PCMP_Float32LE},
+        };
+        SimdTestRng rng;
+        for (const Case &c : cases) {
+                const AudioFormat src(c.src);
+                const AudioFormat dst(c.dst);
+                for (size_t channels = 1; channels <= 9; ++channels) {
+                        CAPTURE(src.name());
+                        CAPTURE(dst.name());
+                        CAPTURE(channels);
+                        const size_t  spc = 67;
+                        const size_t  total = spc * channels;
+                        List<uint8_t> in;
+                        for (size_t i = 0; i < total * src.bytesPerSample(); ++i) {
+                                in.pushToBack(static_cast<uint8_t>(rng.next() >> 24));
+                        }
+                        if (src.isFloat()) {
+                                const List<float> vals = simdTestFloats(total);
+                                std::memcpy(in.data(), vals.data(), total * sizeof(float));
+                        }
+                        List<float>   scratch(total, 0.0f);
+                        List<uint8_t> want(total * dst.bytesPerSample(), 0);
+                        List<uint8_t> got(total * dst.bytesPerSample(), 0);
+                        {
+                                SimdScope scope(false);
+                                CHECK(src.convertTo(dst, want.data(), in.data(), spc, channels, scratch.data())
+                                              .isOk());
+                        }
+                        CHECK(src.convertTo(dst, got.data(), in.data(), spc, channels, scratch.data()).isOk());
+                        CHECK(std::memcmp(want.data(), got.data(), want.size()) == 0);
+                }
+        }
+}
+
 // ============================================================================
 // User-registered formats
 // ============================================================================
@@ -6,6 +6,8 @@
  */
 
 #include <cstring>
+#include <thread>
+#include <vector>
 #include <doctest/doctest.h>
 #include <promeki/bufferpool.h>
 #include <promeki/buffer.h>
@@ -109,3 +111,169 @@ TEST_CASE("BufferPool: released buffer view is reset to base") {
         CHECK(b2.size() == 0);
         CHECK(b2.availSize() == 4096);
 }
+
+TEST_CASE("BufferPool: buffer recycles itself when the last handle drops") {
+        BufferPool pool(4096, 4096);
+        void      *p = nullptr;
+        {
+                Buffer b = pool.acquire();
+                REQUIRE(b.isValid());
+                p = b.data();
+                Buffer alias = b;
+                b = Buffer();
+                // A copy is still alive, so the block stays out.
+                CHECK(pool.available() == 0);
+        }
+        CHECK(pool.available() == 1);
+        Buffer again = pool.acquire();
+        CHECK(again.data() == p);
+        CHECK(pool.available() == 0);
+}
+
+TEST_CASE("BufferPool: buffers outlive the pool handle") {
+        Buffer b;
+        {
+                BufferPool pool(1024, 4096);
+                b = pool.acquire();
+        }
+        REQUIRE(b.isValid());
+        std::memset(b.data(), 0x5A, 1024);
+        CHECK(static_cast<uint8_t *>(b.data())[1023] == 0x5A);
+}
+
+TEST_CASE("BufferPool: copies share one pool") {
+        BufferPool a(2048, 4096);
+        BufferPool b = a;
+        a.reserve(3);
+        CHECK(b.available() == 3);
+        Buffer buf = b.acquire();
+        CHECK(a.available() == 2);
+}
+
+TEST_CASE("BufferPool: variable-size acquire uses per-size classes") {
+        BufferPool pool;
+        CHECK(pool.sizeClassCount() == 0);
+
+        Buffer small = pool.acquire(1000);
+        Buffer large = pool.acquire(3 * 4096 + 1);
+        REQUIRE(small.isValid());
+        REQUIRE(large.isValid());
+        // allocSize reports the request, not the rounded class.
+        CHECK(small.allocSize() == 1000);
+        CHECK(large.allocSize() == 3 * 4096 + 1);
+        CHECK(small.size() == 0);
+        CHECK(pool.sizeClassCount() == 2);
+
+        // Same page-rounded class as 1000 bytes.
+        Buffer other = pool.acquire(4000);
+        CHECK(pool.sizeClassCount() == 2);
+
+        small = Buffer();
+        other = Buffer();
+        large = Buffer();
+        CHECK(pool.available(1) == 2);
+        CHECK(pool.available(4 * 4096) == 1);
+        CHECK(pool.available() == 3);
+        CHECK(pool.available(64 * 4096) == 0);
+}
+
+TEST_CASE("BufferPool: high watermark frees surplus returns") {
+        BufferPool::Config cfg;
+        cfg.bufferSize = 512;
+        cfg.highWatermark = 2;
+        cfg.lowWatermark = 1;
+        BufferPool pool(cfg);
+
+        MemSpace::Stats::Snapshot before = pool.memSpace().statsSnapshot();
+        {
+                Buffer b[4];
+                for (Buffer &x : b) x = pool.acquire();
+        }
+        CHECK(pool.available() == 2);
+        MemSpace::Stats::Snapshot after = pool.memSpace().statsSnapshot();
+        CHECK(after.releaseCount - before.releaseCount >= 2);
+
+        pool.trim();
+        CHECK(pool.available() == 1);
+        pool.reserve(8);
+        CHECK(pool.available() == 2);
+}
+
+TEST_CASE("BufferPool: maxBuffersPerClass caps the tracked blocks") {
+        BufferPool::Config cfg;
+        cfg.bufferSize = 256;
+        cfg.maxBuffersPerClass = 1;
+        BufferPool pool(cfg);
+        {
+                Buffer a = pool.acquire();
+                Buffer b = pool.acquire();
+                REQUIRE(a.isValid());
+                REQUIRE(b.isValid());
+                CHECK(a.data() != b.data());
+        }
+        // Only the tracked block comes home; the overflow was freed.
+        CHECK(pool.available() == 1);
+}
+
+TEST_CASE("BufferPool: hit and miss counters land in MemSpace::Stats") {
+        BufferPool                pool(8192, 4096);
+        MemSpace::Stats::Snapshot s0 = pool.memSpace().statsSnapshot();
+        { Buffer b = pool.acquire(); }
+        MemSpace::Stats::Snapshot s1 = pool.memSpace().statsSnapshot();
+        { Buffer b = pool.acquire(); }
+        MemSpace::Stats::Snapshot s2 = pool.memSpace().statsSnapshot();
+        CHECK(s1.poolMissCount - s0.poolMissCount >= 1);
+        CHECK(s2.poolHitCount - s1.poolHitCount >= 1);
+}
+
+TEST_CASE("BufferPool: ensureExclusive detaches a pooled buffer to the heap") {
+        BufferPool pool(4096, 4096);
+        Buffer     a = pool.acquire();
+        std::memset(a.data(), 0x11, 4096);
+        a.setSize(100);
+        Buffer b = a;
+        CHECK(b.ensureExclusiveError().isOk());
+        CHECK(b.data() != a.data());
+        CHECK(b.size() == 100);
+        CHECK(static_cast<uint8_t *>(b.data())[4095] == 0x11);
+        a = Buffer();
+        // The original block went home; the detached copy did not.
+        CHECK(pool.available() == 1);
+        b = Buffer();
+        CHECK(pool.available() == 1);
+}
+
+TEST_CASE("BufferPool: concurrent acquire and recycle") {
+        BufferPool::Config cfg;
+        cfg.highWatermark = 8;
+        BufferPool               pool(cfg);
+        const int                threads = 4;
+        const int                iterations = 2000;
+        std::vector<std::thread> workers;
+        std::vector<int>         failures(threads, 0);
+        for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&pool, &failures, t, iterations]() {
+                        for (int i = 0; i < iterations; i++) {
+                                const size_t bytes = (i & 1) ? 4096 : 3 * 4096;
+                                Buffer       b = pool.acquire(bytes);
+                                if (!b.isValid()) {
+                                        failures[t]++;
+                                        continue;
+                                }
+                                auto *p = static_cast<uint8_t *>(b.data());
+                                std::memset(p, t + 1, bytes);
+                                if (p[0] != t + 1 || p[bytes - 1] != t + 1) failures[t]++;
+                                // Every seventh buffer is handed to another
+                                // thread so its last drop happens there.
+                                if (i % 7 == 0) {
+                                        std::thread([held = std::move(b)]() mutable { held = Buffer(); }).join();
+                                }
+                        }
+                });
+        }
+        for (auto &w : workers) w.join();
+        for (int f : failures) CHECK(f == 0);
+        CHECK(pool.sizeClassCount() == 2);
+        CHECK(pool.available() <= 2 * cfg.highWatermark);
+        CHECK(pool.available() >= 1);
+}
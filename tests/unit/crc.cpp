@@ -8,6 +8,7 @@
 #include <doctest/doctest.h>
 #include <promeki/crc.h>
 #include <cstring>
+#include <vector>
 
 using namespace promeki;
 
@@ -93,6 +94,30 @@ TEST_CASE("CRC32 BZIP2 check value") {
         CHECK(crc.value() == 0xFC891918u);
 }
 
+TEST_CASE("CRC32C check value") {
+        // Catalogue check value for CRC-32/ISCSI is 0xE3069283.
+        Crc32 crc(CrcParams::Crc32c);
+        crc.update(kCheckString, kCheckLen);
+        CHECK(crc.value() == 0xE3069283u);
+}
+
+// ============================================================================
+// 64-bit
+// ============================================================================
+
+TEST_CASE("CRC64 XZ check value") {
+        // Catalogue check value is 0x995DC9BBDF1939FA.
+        Crc64 crc(CrcParams::Crc64Xz);
+        crc.update(kCheckString, kCheckLen);
+        CHECK(crc.value() == 0x995DC9BBDF1939FAull);
+}
+
+TEST_CASE("CRC64 ECMA-182 check value") {
+        // Unreflected 64-bit; catalogue check value is 0x6C40DF5F0B497347.
+        constexpr Crc64::Params ecma{0x42F0E1EBA9EA3693ull, 0, 0, false, "CRC-64/ECMA-182"};
+        CHECK(Crc64::compute(ecma, kCheckString, kCheckLen) == 0x6C40DF5F0B497347ull);
+}
+
 // ============================================================================
 // State management
 // ============================================================================
@@ -151,3 +176,82 @@ TEST_CASE("CRC8 reflected and unreflected differ for the same poly") {
         b.update(kCheckString, kCheckLen);
         CHECK(a.value() != b.value());
 }
+
+// ============================================================================
+// Engines
+// ============================================================================
+
+namespace {
+
+        // Runs @p params over @p data with every engine, feeding the
+        // input in uneven pieces, and checks each against Bytewise.
+        template <typename T>
+        void checkEnginesAgree(const typename CRC<T>::Params &params, const std::vector<uint8_t> &data) {
+                static const CrcEngine engines[] = {CrcEngine::Slice8, CrcEngine::Slice16, CrcEngine::Clmul,
+                                                    CrcEngine::Auto};
+                static const size_t    offsets[] = {0, 1, 3, 7};
+                for (size_t off : offsets) {
+                        for (size_t len = 0; off + len <= data.size(); len += (len < 80 ? 1 : 37)) {
+                                CRC<T> ref(params);
+                                REQUIRE(ref.setEngine(CrcEngine::Bytewise).isOk());
+                                ref.update(data.data() + off, len);
+                                for (CrcEngine e : engines) {
+                                        if (!CRC<T>::isEngineSupported(params, e)) continue;
+                                        CRC<T> c(params);
+                                        REQUIRE(c.setEngine(e).isOk());
+                                        const size_t head = len / 3;
+                                        c.update(data.data() + off, head);
+                                        c.update(data.data() + off + head, len - head);
+                                        CAPTURE(params.name);
+                                        CAPTURE(static_cast<int>(e));
+                                        CAPTURE(off);
+                                        CAPTURE(len);
+                                        CHECK(c.value() == ref.value());
+                                }
+                        }
+                }
+        }
+
+} // namespace
+
+TEST_CASE("CRC engines produce identical results") {
+        std::vector<uint8_t> data(1200);
+        uint32_t             seed = 0x12345678u;
+        for (uint8_t &b : data) {
+                seed = seed * 1664525u + 1013904223u;
+                b = static_cast<uint8_t>(seed >> 24);
+        }
+        constexpr Crc32::Params mpeg2{0x04C11DB7u, 0xFFFFFFFFu, 0x00000000u, false, "CRC-32/MPEG-2"};
+        constexpr Crc64::Params ecma{0x42F0E1EBA9EA3693ull, 0, 0, false, "CRC-64/ECMA-182"};
+        checkEnginesAgree<uint8_t>(CrcParams::Crc8Autosar, data);
+        checkEnginesAgree<uint8_t>(CrcParams::Crc8Bluetooth, data);
+        checkEnginesAgree<uint16_t>(CrcParams::Crc16CcittFalse, data);
+        checkEnginesAgree<uint16_t>(CrcParams::Crc16Kermit, data);
+        checkEnginesAgree<uint32_t>(CrcParams::Crc32IsoHdlc, data);
+        checkEnginesAgree<uint32_t>(CrcParams::Crc32c, data);
+        checkEnginesAgree<uint32_t>(mpeg2, data);
+        checkEnginesAgree<uint64_t>(CrcParams::Crc64Xz, data);
+        checkEnginesAgree<uint64_t>(ecma, data);
+}
+
+TEST_CASE("CRC engine selection") {
+        Crc32 c(CrcParams::Crc32IsoHdlc);
+        CHECK(c.engine() != CrcEngine::Auto);
+        CHECK(c.setEngine(CrcEngine::Slice8).isOk());
+        CHECK(c.engine() == CrcEngine::Slice8);
+
+        // Carry-less folding only covers reflected 32-bit CRCs.
+        Crc16 k(CrcParams::Crc16Kermit);
+        CHECK_FALSE(Crc16::isEngineSupported(CrcParams::Crc16Kermit, CrcEngine::Clmul));
+        CHECK(k.setEngine(CrcEngine::Clmul) == Error::NotSupported);
+        CHECK(k.engine() != CrcEngine::Clmul);
+        CHECK_FALSE(Crc32::isEngineSupported(CrcParams::Crc32Bzip2, CrcEngine::Clmul));
+
+        // Switching engines mid-message keeps the running register.
+        Crc32 mixed(CrcParams::Crc32IsoHdlc);
+        mixed.setEngine(CrcEngine::Bytewise);
+        mixed.update(kCheckString, 4);
+        mixed.setEngine(CrcEngine::Slice16);
+        mixed.update(kCheckString + 4, kCheckLen - 4);
+        CHECK(mixed.value() == 0xCBF43926u);
+}
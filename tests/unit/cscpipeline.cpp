@@ -1778,3 +1778,147 @@ TEST_CASE("CSC HDR: scalar vs SIMD agree to within LUT tolerance for PQ conversi
                 CHECK(std::abs(diff) <= 16);
         }
 }
+
+// =========================================================================
+// Slice-parallel execute (MediaConfig::CscThreads)
+// =========================================================================
+
+namespace {
+
+        // Runs @p src -> @p dst once serially and once with @p threads
+        // bands, returning true when every destination plane matches.
+        bool parallelMatchesSerial(PixelFormat::ID srcId, PixelFormat::ID dstId, size_t w, size_t h, int threads,
+                                   const MediaConfig &base = MediaConfig()) {
+                auto src = UncompressedVideoPayload::allocate(ImageDesc(w, h, srcId));
+                if (!src.isValid()) return false;
+                for (size_t p = 0; p < src->planeCount(); ++p) {
+                        uint8_t     *d = src.modify()->data()[p].data();
+                        const size_t n = src->plane(p).size();
+                        for (size_t i = 0; i < n; ++i) d[i] = static_cast<uint8_t>((i * 131 + p * 17 + 7) & 0xFF);
+                }
+
+                MediaConfig parCfg = base;
+                parCfg.set(MediaConfig::CscThreads, threads);
+                CSCPipeline serial(srcId, dstId, base);
+                CSCPipeline parallel(srcId, dstId, parCfg);
+                if (!serial.isValid() || !parallel.isValid()) return false;
+
+                auto a = UncompressedVideoPayload::allocate(ImageDesc(w, h, dstId));
+                auto b = UncompressedVideoPayload::allocate(ImageDesc(w, h, dstId));
+                if (!a.isValid() || !b.isValid()) return false;
+                if (serial.execute(*src, *a.modify()).isError()) return false;
+                if (parallel.execute(*src, *b.modify()).isError()) return false;
+                for (size_t p = 0; p < a->planeCount(); ++p) {
+                        if (a->plane(p).size() != b->plane(p).size()) return false;
+                        if (std::memcmp(a->plane(p).data(), b->plane(p).data(), a->plane(p).size()) != 0) return false;
+                }
+                return true;
+        }
+
+} // namespace
+
+TEST_CASE("CSCPipeline: CscThreads resolves to a band count") {
+        CSCPipeline serial(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709);
+        CHECK(serial.threadCount() == 1);
+
+        MediaConfig cfg;
+        cfg.set(MediaConfig::CscThreads, 4);
+        CSCPipeline four(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, cfg);
+        CHECK(four.threadCount() == 4);
+
+        cfg.set(MediaConfig::CscThreads, 0);
+        CSCPipeline autoCount(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, cfg);
+        CHECK(autoCount.threadCount() >= 1);
+
+        // The thread count is part of the cache key.
+        cfg.set(MediaConfig::CscThreads, 4);
+        auto c1 = CSCPipeline::cached(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709);
+        auto c4 = CSCPipeline::cached(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, cfg);
+        REQUIRE(c1.isValid());
+        REQUIRE(c4.isValid());
+        CHECK(c1 != c4);
+        CHECK(c4->threadCount() == 4);
+}
+
+TEST_CASE("CSCPipeline: slice-parallel execute matches serial output") {
+        SUBCASE("fast path 4:2:2") {
+                CHECK(parallelMatchesSerial(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, 64, 270, 4));
+        }
+        SUBCASE("generic pipeline to 4:2:0 planar") {
+                CHECK(parallelMatchesSerial(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_420_Planar_Rec709, 64, 270, 3,
+                                            scalarConfig()));
+        }
+        SUBCASE("4:2:0 planar source") {
+                CHECK(parallelMatchesSerial(PixelFormat::YUV8_420_Planar_Rec709, PixelFormat::RGBA8_sRGB, 64, 270, 5));
+        }
+        SUBCASE("ST 2110-20 4:2:0 two-line wire rows") {
+                CHECK(parallelMatchesSerial(PixelFormat::YUV10_420_SemiPlanar_LE_Rec709,
+                                            PixelFormat::YUV10_420_2110_Rec709, 64, 270, 7));
+        }
+        SUBCASE("more threads than rows") {
+                CHECK(parallelMatchesSerial(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, 16, 4, 8));
+        }
+        SUBCASE("one band per CPU") {
+                CHECK(parallelMatchesSerial(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, 128, 360, 0));
+        }
+}
+
+TEST_CASE("CSCContext: per-thread cache") {
+        SUBCASE("reuses and grows the cached context") {
+                CSCContext *first = nullptr;
+                {
+                        CSCContext::Lease lease = CSCContext::acquire(64);
+                        REQUIRE(lease.isValid());
+                        CHECK(lease.context().maxWidth() >= 64);
+                        first = &lease.context();
+                }
+                CSCContext::resetCacheStats();
+                {
+                        CSCContext::Lease lease = CSCContext::acquire(32);
+                        REQUIRE(lease.isValid());
+                        CHECK(&lease.context() == first);
+                }
+                CHECK(CSCContext::cacheStats().hits == 1);
+                CHECK(CSCContext::cacheStats().misses == 0);
+                {
+                        CSCContext::Lease lease = CSCContext::acquire(8192);
+                        REQUIRE(lease.isValid());
+                        CHECK(lease.context().maxWidth() >= 8192);
+                }
+                CHECK(CSCContext::cacheStats().misses == 1);
+        }
+
+        SUBCASE("nested acquire gets a private context") {
+                CSCContext::Lease outer = CSCContext::acquire(64);
+                REQUIRE(outer.isValid());
+                CSCContext::resetCacheStats();
+                {
+                        CSCContext::Lease inner = CSCContext::acquire(64);
+                        REQUIRE(inner.isValid());
+                        CHECK(&inner.context() != &outer.context());
+                }
+                CHECK(CSCContext::cacheStats().misses == 1);
+
+                // Moving the outer lease keeps the cached slot claimed.
+                CSCContext::Lease moved = std::move(outer);
+                CHECK_FALSE(outer.isValid());
+                REQUIRE(moved.isValid());
+                CSCContext::Lease inner = CSCContext::acquire(64);
+                CHECK(&inner.context() != &moved.context());
+        }
+
+        SUBCASE("steady-state execute allocates no scratch") {
+                CSCPipeline pipeline(PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709, scalarConfig());
+                REQUIRE(pipeline.isValid());
+                auto src = UncompressedVideoPayload::allocate(ImageDesc(320, 16, PixelFormat::RGBA8_sRGB));
+                auto dst = UncompressedVideoPayload::allocate(ImageDesc(320, 16, PixelFormat::YUV8_422_Rec709));
+                REQUIRE(src.isValid());
+                REQUIRE(dst.isValid());
+                REQUIRE(pipeline.execute(*src, *dst.modify()).isOk());
+
+                CSCContext::resetCacheStats();
+                for (int i = 0; i < 3; ++i) CHECK(pipeline.execute(*src, *dst.modify()).isOk());
+                CHECK(CSCContext::cacheStats().hits == 3);
+                CHECK(CSCContext::cacheStats().misses == 0);
+        }
+}
@@ -141,6 +141,33 @@ TEST_CASE("EventLoop: stopTimer prevents firing") {
         CHECK(fireCount == 0);
 }
 
+TEST_CASE("EventLoop: timers fire in deadline order regardless of start order") {
+        EventLoop loop;
+        List<int> order;
+        // Started latest-deadline first so insertion order and
+        // deadline order disagree.
+        for (int i = 8; i >= 1; i--) {
+                loop.startTimer(i * 4, [&order, i] { order += i; }, true);
+        }
+        loop.startTimer(60, [&loop] { loop.quit(); }, true);
+        loop.exec();
+        REQUIRE(order.size() == 8);
+        for (int i = 0; i < 8; i++) CHECK(order[i] == i + 1);
+        CHECK(loop.nextTimerTimeout() == 0);
+}
+
+TEST_CASE("EventLoop: stopped timers do not hold the next deadline") {
+        EventLoop loop;
+        int       early = loop.startTimer(5, [] {}, true);
+        loop.startTimer(10000, [] {}, true);
+        loop.stopTimer(early);
+        // The cancelled 5 ms timer must not be the one reported.
+        CHECK(loop.nextTimerTimeout() > 1000);
+        // Heavy start / stop churn leaves no live timers behind.
+        for (int i = 0; i < 5000; i++) loop.stopTimer(loop.startTimer(100000, [] {}));
+        CHECK(loop.nextTimerTimeout() > 1000);
+}
+
 TEST_CASE("EventLoop: isRunning") {
         EventLoop loop;
         CHECK_FALSE(loop.isRunning());
@@ -530,6 +557,81 @@ TEST_CASE("EventLoop: addIoSource rejects bad arguments") {
         CHECK(loop.addIoSource(pipe.read_fd, 0, [](int, uint32_t) {}) == -1);
 }
 
+TEST_CASE("EventLoop: IoError-only source fires on hangup, not on data") {
+        EventLoop        loop;
+        TestPipe         pipe;
+        std::atomic<int> fireCount{0};
+        uint32_t         seen = 0;
+        int              h = loop.addIoSource(pipe.read_fd, EventLoop::IoError, [&](int, uint32_t events) {
+                seen |= events;
+                fireCount.fetch_add(1);
+                loop.quit();
+        });
+        REQUIRE(h >= 0);
+
+        // Readable data alone must not wake an error-only source.
+        pipe.writeByte();
+        loop.startTimer(50, [&] { loop.quit(); }, true);
+        loop.exec();
+        CHECK(fireCount.load() == 0);
+
+        // Closing the write end hangs up the read end.
+        ::close(pipe.write_fd);
+        pipe.write_fd = -1;
+        loop.startTimer(1000, [&] { loop.quit(); }, true);
+        loop.exec();
+        loop.removeIoSource(h);
+        CHECK(fireCount.load() >= 1);
+        CHECK((seen & EventLoop::IoError) != 0);
+        CHECK((seen & EventLoop::IoRead) == 0);
+}
+
+TEST_CASE("EventLoop: always-ready fds fire like poll() reports them") {
+        // epoll refuses regular files and /dev/null; a redirected
+        // stdin is one of those and must still be readable.
+        char tmpl[] = "/tmp/promeki-eventloop-XXXXXX";
+        int  fileFd = ::mkstemp(tmpl);
+        REQUIRE(fileFd >= 0);
+        ::unlink(tmpl);
+        int nullFd = ::open("/dev/null", O_RDONLY);
+        REQUIRE(nullFd >= 0);
+
+        for (int fd : {fileFd, nullFd}) {
+                EventLoop        loop;
+                std::atomic<int> fireCount{0};
+                uint32_t         seen = 0;
+                int              h = loop.addIoSource(fd, EventLoop::IoRead, [&](int, uint32_t events) {
+                        seen |= events;
+                        fireCount.fetch_add(1);
+                        loop.quit();
+                });
+                REQUIRE(h >= 0);
+                loop.startTimer(1000, [&] { loop.quit(); }, true);
+                loop.exec();
+                loop.removeIoSource(h);
+                CHECK(fireCount.load() >= 1);
+                CHECK((seen & EventLoop::IoRead) != 0);
+                CHECK((seen & EventLoop::IoWrite) == 0);
+        }
+        ::close(fileFd);
+        ::close(nullFd);
+}
+
+#if defined(PROMEKI_PLATFORM_LINUX)
+TEST_CASE("EventLoop: addIoSource returns -1 when epoll refuses the fd") {
+        EventLoop loop;
+        TestPipe  pipe;
+        const int fd = pipe.read_fd;
+        ::close(pipe.read_fd);
+        pipe.read_fd = -1;
+        // A closed descriptor fails epoll_ctl with EBADF; poll() would
+        // accept it, so only check on the epoll backend.
+        if (loop.peekStats().ioBackend == "epoll") {
+                CHECK(loop.addIoSource(fd, EventLoop::IoRead, [](int, uint32_t) {}) == -1);
+        }
+}
+#endif
+
 TEST_CASE("EventLoop: removeIoSource stops further firing") {
         EventLoop        loop;
         TestPipe         pipe;
@@ -667,6 +769,34 @@ TEST_CASE("EventLoop: multiple IoSources fire independently") {
         CHECK(fires2.load() >= 1);
 }
 
+TEST_CASE("EventLoop: two IoSources on the same fd both fire") {
+        EventLoop        loop;
+        TestPipe         pipe;
+        std::atomic<int> firstFires{0};
+        std::atomic<int> secondFires{0};
+
+        int first = loop.addIoSource(pipe.read_fd, EventLoop::IoRead, [&](int, uint32_t) { firstFires.fetch_add(1); });
+        int second = loop.addIoSource(pipe.read_fd, EventLoop::IoRead, [&](int fd, uint32_t) {
+                char buf[16];
+                while (::read(fd, buf, sizeof(buf)) > 0) {}
+                secondFires.fetch_add(1);
+        });
+        REQUIRE(first >= 0);
+        REQUIRE(second >= 0);
+        pipe.writeByte();
+        loop.processEvents(EventLoop::WaitForMore, 100);
+        CHECK(firstFires.load() == 1);
+        CHECK(secondFires.load() == 1);
+
+        // Dropping one registration leaves the other armed.
+        loop.removeIoSource(second);
+        pipe.writeByte();
+        loop.processEvents(EventLoop::WaitForMore, 100);
+        CHECK(firstFires.load() == 2);
+        CHECK(secondFires.load() == 1);
+        loop.removeIoSource(first);
+}
+
 TEST_CASE("EventLoop: IoSource callback can remove itself") {
         EventLoop        loop;
         TestPipe         pipe;
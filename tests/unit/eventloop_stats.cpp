@@ -14,9 +14,14 @@
 #include <promeki/eventloop.h>
 #include <promeki/objectbase.h>
 #include <promeki/objectbase.tpp>
+#include <promeki/platform.h>
 #include <promeki/thread.h>
 #include <promeki/timestamp.h>
 
+#if defined(PROMEKI_PLATFORM_POSIX)
+#include <unistd.h>
+#endif
+
 using namespace promeki;
 
 // Local Event subclass with a stable type ID so we can verify
@@ -500,3 +505,36 @@ TEST_CASE("EventLoopStats: sleep bucket dominates an idle loop") {
         CHECK((r.sleep.nanoseconds() > 0 || r.queueWait.nanoseconds() > 0));
         loop.removeMonitor();
 }
+
+TEST_CASE("EventLoopStats: gauges report backend, sources and armed timers") {
+        EventLoop loop;
+        EventLoop::Report r = loop.peekStats();
+        CHECK_FALSE(r.ioBackend.isEmpty());
+        CHECK(r.ioSources == 0);
+        CHECK(r.timersArmed == 0);
+
+        int a = loop.startTimer(10000, [] {}, true);
+        int b = loop.startTimer(20000, [] {}, false);
+#if defined(PROMEKI_PLATFORM_POSIX)
+        int fds[2] = {-1, -1};
+        REQUIRE(::pipe(fds) == 0);
+        int h = loop.addIoSource(fds[0], EventLoop::IoRead, [](int, uint32_t) {});
+        REQUIRE(h >= 0);
+        r = loop.peekStats();
+        CHECK(r.ioSources == 1);
+#if defined(PROMEKI_PLATFORM_LINUX)
+        CHECK(r.ioBackend == "epoll");
+#endif
+        loop.removeIoSource(h);
+        ::close(fds[0]);
+        ::close(fds[1]);
+#endif
+        r = loop.peekStats();
+        CHECK(r.ioSources == 0);
+        CHECK(r.timersArmed == 2);
+        CHECK(r.timerHeapSize >= 2);
+
+        loop.stopTimer(a);
+        loop.stopTimer(b);
+        CHECK(loop.peekStats().timersArmed == 0);
+}
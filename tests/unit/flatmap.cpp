@@ -0,0 +1,136 @@
+/**
+ * @file      flatmap.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#include <doctest/doctest.h>
+#include <promeki/flatmap.h>
+#include <promeki/string.h>
+
+using namespace promeki;
+
+TEST_CASE("FlatMap: default construction") {
+        FlatMap<int, String, 4> m;
+        CHECK(m.isEmpty());
+        CHECK(m.size() == 0);
+        CHECK(m.isInline());
+        CHECK(m.capacity() == 4);
+}
+
+TEST_CASE("FlatMap: initializer list construction") {
+        FlatMap<int, String> m = {{3, "c"}, {1, "a"}, {2, "b"}, {1, "z"}};
+        CHECK(m.size() == 3);
+        CHECK(m.value(1) == "z");
+        CHECK(m.value(2) == "b");
+        CHECK(m.value(3) == "c");
+}
+
+TEST_CASE("FlatMap: insert keeps keys sorted and overwrites") {
+        FlatMap<int, String, 4> m;
+        m.insert(5, "five");
+        m.insert(1, "one");
+        m.insert(3, "three");
+        m.insert(3, "THREE");
+        REQUIRE(m.size() == 3);
+        List<int> keys = m.keys();
+        CHECK(keys[0] == 1);
+        CHECK(keys[1] == 3);
+        CHECK(keys[2] == 5);
+        CHECK(m.value(3) == "THREE");
+        CHECK(m.value(4, "none") == "none");
+        CHECK_FALSE(m.insertNew(5, "again"));
+        CHECK(m.insertNew(4, "four"));
+        CHECK(m.value(5) == "five");
+        CHECK(m.value(4) == "four");
+}
+
+TEST_CASE("FlatMap: find and contains") {
+        FlatMap<int, int> m = {{10, 100}, {20, 200}};
+        CHECK(m.contains(10));
+        CHECK_FALSE(m.contains(15));
+        auto it = m.find(20);
+        REQUIRE(it != m.end());
+        CHECK(it->second == 200);
+        it->second = 201;
+        CHECK(m.value(20) == 201);
+        CHECK(m.find(30) == m.end());
+}
+
+TEST_CASE("FlatMap: remove") {
+        FlatMap<int, String, 4> m = {{1, "a"}, {2, "b"}, {3, "c"}};
+        CHECK(m.remove(2));
+        CHECK_FALSE(m.remove(2));
+        CHECK(m.size() == 2);
+        CHECK(m.value(1) == "a");
+        CHECK(m.value(3) == "c");
+        auto next = m.remove(m.find(1));
+        REQUIRE(next != m.end());
+        CHECK(next->first == 3);
+        m.clear();
+        CHECK(m.isEmpty());
+}
+
+TEST_CASE("FlatMap: spills past the inline capacity") {
+        FlatMap<int, String, 4> m;
+        for (int i = 19; i >= 0; --i) m.insert(i, String::number(i));
+        CHECK(m.size() == 20);
+        CHECK_FALSE(m.isInline());
+        CHECK(m.capacity() >= 20);
+        int expect = 0;
+        for (const auto &[k, v] : m) {
+                CHECK(k == expect);
+                CHECK(v == String::number(expect));
+                ++expect;
+        }
+}
+
+TEST_CASE("FlatMap: copy is deep") {
+        FlatMap<int, String, 2> a = {{1, "a"}, {2, "b"}, {3, "c"}};
+        FlatMap<int, String, 2> b = a;
+        CHECK(a == b);
+        b.insert(2, "B");
+        CHECK(a != b);
+        CHECK(a.value(2) == "b");
+
+        FlatMap<int, String, 2> small = {{9, "nine"}};
+        small = a;
+        CHECK(small == a);
+        a = small;
+        CHECK(a.size() == 3);
+}
+
+TEST_CASE("FlatMap: move leaves source empty") {
+        FlatMap<int, String, 2> inl = {{1, "a"}};
+        FlatMap<int, String, 2> movedInl = std::move(inl);
+        CHECK(movedInl.value(1) == "a");
+        CHECK(inl.isEmpty());
+        CHECK(inl.isInline());
+
+        FlatMap<int, String, 2> heap = {{1, "a"}, {2, "b"}, {3, "c"}};
+        REQUIRE_FALSE(heap.isInline());
+        FlatMap<int, String, 2> movedHeap;
+        movedHeap = std::move(heap);
+        CHECK(movedHeap.size() == 3);
+        CHECK(movedHeap.value(3) == "c");
+        CHECK(heap.isEmpty());
+        CHECK(heap.isInline());
+}
+
+TEST_CASE("FlatMap: forEach visits entries in key order") {
+        FlatMap<int, int> m = {{3, 30}, {1, 10}, {2, 20}};
+        int                sum = 0;
+        int                last = 0;
+        bool               ordered = true;
+        m.forEach([&](int k, int v) {
+                if (k <= last) ordered = false;
+                last = k;
+                sum += v;
+        });
+        CHECK(ordered);
+        CHECK(sum == 60);
+        List<int> values = m.values();
+        CHECK(values[0] == 10);
+        CHECK(values[2] == 30);
+}
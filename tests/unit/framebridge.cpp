@@ -15,9 +15,81 @@
 #include <promeki/mediaconfig.h>
 #include <promeki/mediaiofactory.h>
 #include <promeki/url.h>
+#include <promeki/uuid.h>
+#include <promeki/frame.h>
+#include <promeki/mediadesc.h>
+#include <promeki/imagedesc.h>
+#include <promeki/pixelformat.h>
+#include <promeki/uncompressedvideopayload.h>
+#include <promeki/pcmaudiopayload.h>
+#include <promeki/ancpayload.h>
+#include <promeki/st291packet.h>
 
 using namespace promeki;
 
+namespace {
+
+        String uniqueBridgeName(const char *tag) {
+                return String("unittest-") + String(tag) + String("-") + UUID::generateV4().toString();
+        }
+
+        FrameBridge::Config zeroCopyConfig() {
+                FrameBridge::Config cfg;
+                cfg.mediaDesc.setFrameRate(FrameRate(FrameRate::FPS_30));
+                cfg.mediaDesc.imageList().pushToBack(ImageDesc(64, 32, PixelFormat::RGBA8_sRGB));
+                cfg.waitForConsumer = false;
+                cfg.zeroCopy = true;
+                return cfg;
+        }
+
+        void fillPattern(const UncompressedVideoPayload::Ptr &img, uint8_t seed) {
+                auto plane = img->plane(0);
+                for (size_t i = 0; i < plane.size(); ++i) plane.data()[i] = static_cast<uint8_t>(seed + i * 7);
+        }
+
+        bool matchesPattern(const Frame &frame, uint8_t seed) {
+                auto vids = frame.videoPayloads();
+                if (vids.isEmpty() || !vids[0].isValid()) return false;
+                const auto *uvp = vids[0]->as<UncompressedVideoPayload>();
+                if (uvp == nullptr) return false;
+                auto plane = uvp->plane(0);
+                for (size_t i = 0; i < plane.size(); ++i) {
+                        if (plane.data()[i] != static_cast<uint8_t>(seed + i * 7)) return false;
+                }
+                return true;
+        }
+
+        PcmAudioPayload::Ptr makeAudio(const AudioDesc &desc, size_t samples, uint8_t seed) {
+                Buffer buf(desc.bufferSize(samples));
+                buf.setSize(desc.bufferSize(samples));
+                uint8_t *p = static_cast<uint8_t *>(buf.data());
+                for (size_t i = 0; i < buf.size(); ++i) p[i] = static_cast<uint8_t>(seed + i * 3);
+                return PcmAudioPayload::Ptr::create(desc, samples, BufferView(buf, 0, buf.size()));
+        }
+
+        bool audioMatches(const AudioPayload::Ptr &ap, size_t samples, uint8_t seed) {
+                if (!ap.isValid()) return false;
+                const auto *pcm = ap->as<PcmAudioPayload>();
+                if (pcm == nullptr || pcm->sampleCount() != samples) return false;
+                auto plane = pcm->plane(0);
+                for (size_t i = 0; i < plane.size(); ++i) {
+                        if (plane.data()[i] != static_cast<uint8_t>(seed + i * 3)) return false;
+                }
+                return true;
+        }
+
+        Frame readWithin(FrameBridge &in, int timeoutMs) {
+                for (int waited = 0; waited < timeoutMs; waited += 5) {
+                        Error err;
+                        Frame f = in.readFrame(&err);
+                        if (f.isValid() || err.isError()) return f;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+                return Frame();
+        }
+
+} // namespace
+
 // ============================================================================
 // FrameBridge::isAborted reflects the cancel flag exposed to the
 // FrameBridgeMediaIO read loop.
@@ -111,3 +183,184 @@ TEST_CASE("FrameBridgeFactory::urlToConfig accepts both authority forms") {
                 CHECK(err == Error::InvalidArgument);
         }
 }
+
+// ============================================================================
+// Zero-copy publishing.
+//
+// A frame whose image planes come from FrameBridge::allocator() already
+// lives in a ring slot, so writeFrame publishes it in place; any other
+// frame is copied.  Both must arrive intact at an input.
+// ============================================================================
+
+TEST_CASE("FrameBridge: zero-copy frames publish in place, others are copied") {
+        const String        name = uniqueBridgeName("zc");
+        FrameBridge::Config cfg = zeroCopyConfig();
+        const ImageDesc    &id = cfg.mediaDesc.imageList()[0];
+
+        FrameBridge out;
+        REQUIRE(out.openOutput(name, cfg).isOk());
+        FrameBridge in;
+        REQUIRE(in.openInput(name, false).isOk());
+        for (int i = 0; i < 400 && out.connectionCount() == 0; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        REQUIRE(out.connectionCount() == 1);
+
+        MediaIOAllocator::Ptr alloc = out.allocator();
+        CHECK(alloc->name() == String("FrameBridgeSlotAllocator"));
+        UncompressedVideoPayload::Ptr img = alloc->allocateVideoPayload(id);
+        REQUIRE(img);
+        fillPattern(img, 3);
+        Frame zc;
+        zc.addPayload(img);
+        REQUIRE(out.writeFrame(zc).isOk());
+        CHECK(out.stats().framesZeroCopy == 1);
+        CHECK(out.stats().framesCopied == 0);
+        Frame got = readWithin(in, 2000);
+        REQUIRE(got.isValid());
+        CHECK(matchesPattern(got, 3));
+
+        UncompressedVideoPayload::Ptr heap = UncompressedVideoPayload::allocate(id);
+        REQUIRE(heap);
+        fillPattern(heap, 91);
+        Frame copied;
+        copied.addPayload(heap);
+        REQUIRE(out.writeFrame(copied).isOk());
+        CHECK(out.stats().framesZeroCopy == 1);
+        CHECK(out.stats().framesCopied == 1);
+        got = readWithin(in, 2000);
+        REQUIRE(got.isValid());
+        CHECK(matchesPattern(got, 91));
+
+        in.close();
+        out.close();
+}
+
+TEST_CASE("FrameBridge: zero-copy slots are leased, recycled, and survive close") {
+        FrameBridge::Config cfg = zeroCopyConfig();
+        cfg.ringDepth = 2;
+        const ImageDesc &id = cfg.mediaDesc.imageList()[0];
+
+        FrameBridge out;
+        REQUIRE(out.openOutput(uniqueBridgeName("lease"), cfg).isOk());
+        MediaIOAllocator::Ptr alloc = out.allocator();
+
+        UncompressedVideoPayload::Ptr a = alloc->allocateVideoPayload(id);
+        UncompressedVideoPayload::Ptr b = alloc->allocateVideoPayload(id);
+        REQUIRE(a);
+        REQUIRE(b);
+        CHECK(a->plane(0).data() != b->plane(0).data());
+        CHECK(out.stats().allocatorFallbacks == 0);
+
+        // Both slots are leased: the next request falls back to the heap.
+        UncompressedVideoPayload::Ptr c = alloc->allocateVideoPayload(id);
+        REQUIRE(c);
+        CHECK(out.stats().allocatorFallbacks == 1);
+
+        // Dropping a lease frees its slot for the next request.
+        const uint8_t *slotA = a->plane(0).data();
+        a = UncompressedVideoPayload::Ptr();
+        UncompressedVideoPayload::Ptr d = alloc->allocateVideoPayload(id);
+        REQUIRE(d);
+        CHECK(d->plane(0).data() == slotA);
+        CHECK(out.stats().allocatorFallbacks == 1);
+
+        // Closing with leases outstanding keeps their memory mapped.
+        fillPattern(b, 17);
+        out.close();
+        fillPattern(d, 29);
+        Frame held;
+        held.addPayload(b);
+        CHECK(matchesPattern(held, 17));
+
+        // A closed bridge's allocator only hands out heap planes.
+        UncompressedVideoPayload::Ptr e = alloc->allocateVideoPayload(id);
+        REQUIRE(e);
+        CHECK(out.allocator()->name() != String("FrameBridgeSlotAllocator"));
+}
+
+// ============================================================================
+// Multi-essence frames.
+//
+// One bridge carries several image plane groups, audio tracks and ANC
+// streams; each lands in its own slot sub-region and a single TICK
+// publishes them together.
+// ============================================================================
+
+TEST_CASE("FrameBridge: publishes several images, audio tracks and ANC streams in one slot") {
+        const String        name = uniqueBridgeName("multi");
+        FrameBridge::Config cfg;
+        cfg.mediaDesc.setFrameRate(FrameRate(FrameRate::FPS_30));
+        cfg.mediaDesc.imageList().pushToBack(ImageDesc(64, 32, PixelFormat::RGBA8_sRGB));
+        cfg.mediaDesc.imageList().pushToBack(ImageDesc(16, 8, PixelFormat::RGBA8_sRGB));
+        const AudioDesc stereo(AudioFormat::PCMI_Float32LE, 48000.0f, 2);
+        const AudioDesc mono(AudioFormat::PCMI_S16LE, 48000.0f, 1);
+        cfg.mediaDesc.audioList().pushToBack(stereo);
+        cfg.mediaDesc.audioList().pushToBack(mono);
+        const AncDesc anc(Size2Du32(64, 32), VideoScanMode::Progressive, FrameRate::FPS_30);
+        cfg.mediaDesc.ancList().pushToBack(anc);
+        cfg.waitForConsumer = false;
+
+        FrameBridge out;
+        REQUIRE(out.openOutput(name, cfg).isOk());
+        CHECK(out.mediaDesc().audioList().size() == 2);
+        CHECK(out.audioDesc() == stereo);
+        FrameBridge in;
+        REQUIRE(in.openInput(name, false).isOk());
+        CHECK(in.mediaDesc().imageList().size() == 2);
+        CHECK(in.mediaDesc().audioList().size() == 2);
+        CHECK(in.mediaDesc().ancList().size() == 1);
+        for (int i = 0; i < 400 && out.connectionCount() == 0; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        REQUIRE(out.connectionCount() == 1);
+
+        UncompressedVideoPayload::Ptr big = UncompressedVideoPayload::allocate(cfg.mediaDesc.imageList()[0]);
+        UncompressedVideoPayload::Ptr small = UncompressedVideoPayload::allocate(cfg.mediaDesc.imageList()[1]);
+        REQUIRE(big);
+        REQUIRE(small);
+        fillPattern(big, 5);
+        fillPattern(small, 77);
+        AncPayload::Ptr ancPayload = AncPayload::Ptr::create(anc);
+        List<uint16_t>  udw;
+        udw.pushToBack(uint16_t(0x10));
+        udw.pushToBack(uint16_t(0x20));
+        ancPayload.modify()->addPacket(St291Packet::build(AncFormat(AncFormat::Cea708), udw, 9));
+
+        Frame frame;
+        frame.addPayload(big);
+        frame.addPayload(makeAudio(stereo, 1600, 11));
+        frame.addPayload(small);
+        frame.addPayload(makeAudio(mono, 1600, 42));
+        frame.addPayload(ancPayload);
+        REQUIRE(out.writeFrame(frame).isOk());
+
+        Frame got = readWithin(in, 2000);
+        REQUIRE(got.isValid());
+        auto vids = got.videoPayloads();
+        REQUIRE(vids.size() == 2);
+        Frame first;
+        first.addPayload(vids[0]);
+        CHECK(matchesPattern(first, 5));
+        Frame second;
+        second.addPayload(vids[1]);
+        CHECK(matchesPattern(second, 77));
+        auto auds = got.audioPayloads();
+        REQUIRE(auds.size() == 2);
+        CHECK(audioMatches(auds[0], 1600, 11));
+        CHECK(audioMatches(auds[1], 1600, 42));
+        auto ancs = got.ancPayloads();
+        REQUIRE(ancs.size() == 1);
+        CHECK(ancs[0]->packets().size() == 1);
+        CHECK(ancs[0]->hasFormat(AncFormat(AncFormat::Cea708)));
+
+        // Audio past the per-track capacity is refused before the slot
+        // is touched.
+        Frame tooMuch;
+        tooMuch.addPayload(big);
+        tooMuch.addPayload(makeAudio(stereo, 48000, 1));
+        CHECK(out.writeFrame(tooMuch) == Error::OutOfRange);
+
+        in.close();
+        out.close();
+}
@@ -173,10 +173,11 @@ static CompressedVideoPayload::Ptr encodeOneFrame(const UncompressedVideoPayload
 }
 
 static UncompressedVideoPayload::Ptr decodeOneFrame(const CompressedVideoPayload::Ptr &pkt, PixelFormat target,
-                                                    int width, int height) {
+                                                    int width, int height, int threads = 1) {
         MediaConfig cfg;
         cfg.set(MediaConfig::OutputPixelFormat, target);
         cfg.set(MediaConfig::VideoSize, Size2Du32(width, height));
+        cfg.set(MediaConfig::JpegThreads, threads);
         auto decResult = VideoCodec(VideoCodec::JPEG).createDecoder(&cfg);
         if (error(decResult).isError()) return UncompressedVideoPayload::Ptr();
         VideoDecoder *dec = value(decResult);
@@ -675,3 +676,107 @@ TEST_CASE("JpegVideoCodec_EncodeRGBDecodePlanar420") {
         REQUIRE(decoded.isValid());
         CHECK(decoded->desc().pixelFormat().id() == PixelFormat::YUV8_420_Planar_Rec709);
 }
+
+// ---------------------------------------------------------------------------
+// Slice-parallel encode / decode (MediaConfig::JpegThreads)
+// ---------------------------------------------------------------------------
+
+// Counts RSTn markers and reports the DRI restart interval (0 if absent).
+static int countRestartMarkers(const CompressedVideoPayload::Ptr &pkt, int *restartInterval) {
+        const uint8_t *d = static_cast<const uint8_t *>(pkt->plane(0).data());
+        const size_t   n = pkt->plane(0).size();
+        int            count = 0;
+        *restartInterval = 0;
+        for (size_t i = 0; i + 5 < n; i++) {
+                if (d[i] != 0xFF) continue;
+                if (d[i + 1] >= 0xD0 && d[i + 1] <= 0xD7) count++;
+                if (d[i + 1] == 0xDD && *restartInterval == 0) *restartInterval = (d[i + 4] << 8) | d[i + 5];
+        }
+        return count;
+}
+
+static bool samePixels(const UncompressedVideoPayload::Ptr &a, const UncompressedVideoPayload::Ptr &b) {
+        if (!a.isValid() || !b.isValid()) return false;
+        const size_t planes = a->desc().pixelFormat().planeCount();
+        if (planes != b->desc().pixelFormat().planeCount()) return false;
+        for (size_t p = 0; p < planes; p++) {
+                if (a->plane(p).size() != b->plane(p).size()) return false;
+                if (std::memcmp(a->plane(p).data(), b->plane(p).data(), a->plane(p).size()) != 0) return false;
+        }
+        return true;
+}
+
+TEST_CASE("JpegVideoCodec_SliceParallelEncodeDecodesLikeSerial") {
+        auto        src = createTestImage(640, 480);
+        MediaConfig serialCfg;
+        MediaConfig stripedCfg;
+        stripedCfg.set(MediaConfig::JpegThreads, 4);
+        CompressedVideoPayload::Ptr serial = encodeOneFrame(src, serialCfg);
+        CompressedVideoPayload::Ptr striped = encodeOneFrame(src, stripedCfg);
+        REQUIRE(serial);
+        REQUIRE(striped);
+
+        int restartInterval = 0;
+        CHECK(countRestartMarkers(serial, &restartInterval) == 0);
+        CHECK(restartInterval == 0);
+        // 4:2:2 → 16x8 MCUs: 40 per row, 60 rows, four stripes of 15 rows.
+        CHECK(countRestartMarkers(striped, &restartInterval) == 3);
+        CHECK(restartInterval == 40 * 15);
+
+        auto a = decodeOneFrame(serial, PixelFormat(PixelFormat::RGB8_sRGB), 640, 480);
+        auto b = decodeOneFrame(striped, PixelFormat(PixelFormat::RGB8_sRGB), 640, 480);
+        CHECK(samePixels(a, b));
+}
+
+TEST_CASE("JpegVideoCodec_SliceParallelEncodeManyStripes") {
+        // More than eight stripes wraps RST7 back to RST0, and a height
+        // that is not an MCU multiple leaves a short last stripe.
+        auto        src = createPlanarImage(320, 250, PixelFormat::YUV8_420_Planar_Rec709);
+        MediaConfig stripedCfg;
+        stripedCfg.set(MediaConfig::JpegThreads, 16);
+        CompressedVideoPayload::Ptr serial = encodeOneFrame(src, MediaConfig());
+        CompressedVideoPayload::Ptr striped = encodeOneFrame(src, stripedCfg);
+        REQUIRE(serial);
+        REQUIRE(striped);
+        int restartInterval = 0;
+        CHECK(countRestartMarkers(striped, &restartInterval) == 15);
+        CHECK(restartInterval == 20);
+
+        PixelFormat out(PixelFormat::YUV8_420_Planar_Rec709);
+        CHECK(samePixels(decodeOneFrame(serial, out, 320, 250), decodeOneFrame(striped, out, 320, 250)));
+}
+
+TEST_CASE("JpegVideoCodec_SliceParallelDecodeMatchesSerial") {
+        MediaConfig stripedCfg;
+        stripedCfg.set(MediaConfig::JpegThreads, 8);
+
+        SUBCASE("UYVY") {
+                auto src = createTestYCbCrImage(640, 480, PixelFormat::YUV8_422_UYVY_Rec709);
+                auto pkt = encodeOneFrame(src, stripedCfg);
+                REQUIRE(pkt);
+                PixelFormat out(PixelFormat::YUV8_422_UYVY_Rec709);
+                CHECK(samePixels(decodeOneFrame(pkt, out, 640, 480, 1), decodeOneFrame(pkt, out, 640, 480, 3)));
+        }
+
+        SUBCASE("planar 4:2:0") {
+                auto src = createPlanarImage(640, 480, PixelFormat::YUV8_420_Planar_Rec709);
+                auto pkt = encodeOneFrame(src, stripedCfg);
+                REQUIRE(pkt);
+                PixelFormat out(PixelFormat::YUV8_420_Planar_Rec709);
+                CHECK(samePixels(decodeOneFrame(pkt, out, 640, 480, 1), decodeOneFrame(pkt, out, 640, 480, 4)));
+        }
+
+        SUBCASE("RGB from 4:2:2") {
+                auto pkt = encodeOneFrame(createTestImage(640, 480), stripedCfg);
+                REQUIRE(pkt);
+                PixelFormat out(PixelFormat::RGB8_sRGB);
+                CHECK(samePixels(decodeOneFrame(pkt, out, 640, 480, 1), decodeOneFrame(pkt, out, 640, 480, 0)));
+        }
+
+        SUBCASE("no restart markers falls back to serial") {
+                auto pkt = encodeOneFrame(createTestImage(320, 240), MediaConfig());
+                REQUIRE(pkt);
+                PixelFormat out(PixelFormat::RGB8_sRGB);
+                CHECK(samePixels(decodeOneFrame(pkt, out, 320, 240, 1), decodeOneFrame(pkt, out, 320, 240, 4)));
+        }
+}
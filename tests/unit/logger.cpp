@@ -5,7 +5,10 @@
  * See LICENSE file in the project root folder for license information.
  */
 
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <thread>
 #include <atomic>
 #include <doctest/doctest.h>
 #include <promeki/logger.h>
@@ -557,3 +560,180 @@ TEST_CASE("Logger_DebugRegistration") {
                 CHECK(nullRet == false);
         }
 }
+
+// ============================================================================
+// Deferred formatting
+// ============================================================================
+
+TEST_CASE("Logger_FormatInfo") {
+        constexpr Logger::FormatInfo plain = Logger::formatInfo("no conversions");
+        CHECK(plain.deferrable);
+        CHECK(plain.stringArgs == 0);
+
+        constexpr Logger::FormatInfo mixed = Logger::formatInfo("%d %s %*d %-10s %%s %p");
+        CHECK(mixed.deferrable);
+        // Arguments: 0=%d 1=%s 2,3=%*d 4=%-10s 5=%p
+        CHECK(mixed.stringArgs == ((uint64_t(1) << 1) | (uint64_t(1) << 4)));
+
+        CHECK_FALSE(Logger::formatInfo("%n").deferrable);
+        CHECK_FALSE(Logger::formatInfo("%.4s").deferrable);
+        CHECK_FALSE(Logger::formatInfo("%.*s").deferrable);
+        CHECK_FALSE(Logger::formatInfo("%ls").deferrable);
+        CHECK_FALSE(Logger::formatInfo("%1$d").deferrable);
+        CHECK_FALSE(Logger::formatInfo("%m").deferrable);
+        CHECK_FALSE(Logger::formatInfo("trailing %").deferrable);
+}
+
+TEST_CASE("Logger_DeferredMatchesEagerFormatting") {
+        Logger      &logger = Logger::defaultLogger();
+        ListenerSink sink;
+        logger.sync();
+        Logger::ListenerHandle handle = logger.installListener(
+                [&sink](const Logger::LogEntry &entry, const String &threadName) { sink.capture(entry, threadName); });
+        REQUIRE(handle != 0);
+
+        const char *name = "stream-7";
+        const char *nullName = nullptr;
+        int         x = 0;
+        promekiInfo("int %d neg %i hex %08x %x %hhu", 42, -17, 0xbeefu, 255u, 257);
+        promekiInfo("sizes %zu %lld %llu %hhd", size_t(12345), -9000000000LL, 18000000000ULL, 300);
+        promekiInfo("float %.3f %e %g", 3.14159, 1.5e-9, 2.0f);
+        promekiInfo("str [%s] [%-10s] [%10s] [%s]", name, "left", "right", nullName);
+        promekiInfo("star [%*d] [%-*d] [%.*f]", 6, 42, 5, 7, 2, 1.23456);
+        promekiInfo("char %c pct %% ptr %p", 'Z', static_cast<void *>(&x));
+        promekiWarn("bool %d enum %d", true, Logger::Warn);
+        logger.sync();
+
+        auto entries = sink.snapshot();
+        REQUIRE(entries.size() == 7);
+        CHECK(entries[0].msg == String::sprintf("int %d neg %i hex %08x %x %hhu", 42, -17, 0xbeefu, 255u, 257));
+        CHECK(entries[1].msg == String::sprintf("sizes %zu %lld %llu %hhd", size_t(12345), -9000000000LL,
+                                                18000000000ULL, 300));
+        CHECK(entries[2].msg == String::sprintf("float %.3f %e %g", 3.14159, 1.5e-9, 2.0f));
+        CHECK(entries[3].msg == String::sprintf("str [%s] [%-10s] [%10s] [%s]", name, "left", "right", "(null)"));
+        CHECK(entries[4].msg == String::sprintf("star [%*d] [%-*d] [%.*f]", 6, 42, 5, 7, 2, 1.23456));
+        CHECK(entries[5].msg == String::sprintf("char %c pct %% ptr %p", 'Z', static_cast<void *>(&x)));
+        CHECK(entries[6].level == Logger::Warn);
+        CHECK(entries[6].msg == "bool 1 enum 3");
+
+        logger.removeListener(handle);
+}
+
+TEST_CASE("Logger_DeferredCopiesStringArguments") {
+        Logger      &logger = Logger::defaultLogger();
+        ListenerSink sink;
+        logger.sync();
+        Logger::ListenerHandle handle = logger.installListener(
+                [&sink](const Logger::LogEntry &entry, const String &threadName) { sink.capture(entry, threadName); });
+        REQUIRE(handle != 0);
+
+        char buf[16] = "before";
+        promekiInfo("buffer %s", buf);
+        std::memcpy(buf, "after!", 7);
+        logger.sync();
+
+        auto entries = sink.snapshot();
+        REQUIRE(entries.size() == 1);
+        CHECK(entries[0].msg == "buffer before");
+
+        logger.removeListener(handle);
+}
+
+TEST_CASE("Logger_DeferredKeepsOrderWithQueuedEntries") {
+        Logger      &logger = Logger::defaultLogger();
+        ListenerSink sink;
+        logger.sync();
+        Logger::ListenerHandle handle = logger.installListener(
+                [&sink](const Logger::LogEntry &entry, const String &threadName) { sink.capture(entry, threadName); });
+        REQUIRE(handle != 0);
+
+        // Alternate the staged path with direct log() calls, which go
+        // through the command queue.
+        for (int i = 0; i < 50; i++) {
+                if (i % 3 == 0) {
+                        logger.log(Logger::Info, "order_test.cpp", i, String::sprintf("msg %d", i));
+                } else {
+                        promekiInfo("msg %d", i);
+                }
+        }
+        logger.sync();
+
+        auto entries = sink.snapshot();
+        REQUIRE(entries.size() == 50);
+        for (int i = 0; i < 50; i++) CHECK(entries[i].msg == String::sprintf("msg %d", i));
+
+        logger.removeListener(handle);
+}
+
+TEST_CASE("Logger_DeferredManyThreads") {
+        Logger &logger = Logger::defaultLogger();
+        bool    savedConsole = logger.consoleLoggingEnabled();
+        logger.setConsoleLoggingEnabled(false);
+        logger.sync();
+
+        constexpr int threads = 8;
+        constexpr int perThread = 5000;
+        Mutex         mutex;
+        List<int>     lastSeq;
+        int           total = 0;
+        bool          ordered = true;
+        for (int t = 0; t < threads; t++) lastSeq.pushToBack(-1);
+
+        Logger::ListenerHandle handle =
+                logger.installListener([&](const Logger::LogEntry &entry, const String &) {
+                        int t = -1;
+                        int seq = -1;
+                        if (std::sscanf(entry.msg.cstr(), "storm t=%d seq=%d", &t, &seq) != 2) return;
+                        Mutex::Locker lock(mutex);
+                        if (t < 0 || t >= threads) return;
+                        if (seq != lastSeq[t] + 1) ordered = false;
+                        lastSeq[t] = seq;
+                        total++;
+                });
+        REQUIRE(handle != 0);
+
+        // Enough traffic to fill each 64 KiB ring several times over,
+        // so the eager fallback is exercised alongside staging.
+        List<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+                workers.pushToBack(std::thread([t]() {
+                        for (int i = 0; i < perThread; i++) {
+                                promekiWarn("storm t=%d seq=%d tag=%s", t, i, "packet-loss-warning");
+                        }
+                }));
+        }
+        for (auto &w : workers) w.join();
+        logger.sync();
+
+        {
+                Mutex::Locker lock(mutex);
+                CHECK(total == threads * perThread);
+                CHECK(ordered);
+        }
+
+        logger.removeListener(handle);
+        logger.setConsoleLoggingEnabled(savedConsole);
+}
+
+TEST_CASE("Logger_DeferredFormattingDisabled") {
+        Logger      &logger = Logger::defaultLogger();
+        ListenerSink sink;
+        logger.sync();
+        Logger::ListenerHandle handle = logger.installListener(
+                [&sink](const Logger::LogEntry &entry, const String &threadName) { sink.capture(entry, threadName); });
+        REQUIRE(handle != 0);
+
+        CHECK(logger.deferredFormatting());
+        logger.setDeferredFormatting(false);
+        promekiInfo("eager %d %s", 1, "one");
+        logger.setDeferredFormatting(true);
+        promekiInfo("deferred %d %s", 2, "two");
+        logger.sync();
+
+        auto entries = sink.snapshot();
+        REQUIRE(entries.size() == 2);
+        CHECK(entries[0].msg == "eager 1 one");
+        CHECK(entries[1].msg == "deferred 2 two");
+
+        logger.removeListener(handle);
+}
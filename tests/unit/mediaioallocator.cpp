@@ -133,6 +133,47 @@ TEST_CASE("MediaIOAllocator: full-payload override skips per-plane path") {
         CHECK(typed->planeCalls.load() == 0); // base per-plane path NOT used
 }
 
+// ============================================================================
+// Pool-backed allocator
+// ============================================================================
+
+TEST_CASE("MediaIOAllocator: pooledAllocator recycles frame planes") {
+        BufferPool            pool;
+        MediaIOAllocator::Ptr alloc = MediaIOAllocator::pooledAllocator(pool);
+        REQUIRE(alloc.isValid());
+        CHECK(alloc->name() == "PooledMediaIOAllocator");
+
+        ImageDesc   desc(640, 480, PixelFormat(PixelFormat::RGBA8_sRGB));
+        const void *first = nullptr;
+        {
+                UncompressedVideoPayload::Ptr payload = alloc->allocateVideoPayload(desc);
+                REQUIRE(payload.isValid());
+                CHECK(payload->data()[0].size() == desc.pixelFormat().planeSize(0, desc));
+                first = payload->data()[0].data();
+                CHECK(pool.available() == 0);
+        }
+        CHECK(pool.available() == 1);
+        UncompressedVideoPayload::Ptr again = alloc->allocateVideoPayload(desc);
+        REQUIRE(again.isValid());
+        CHECK(again->data()[0].data() == first);
+}
+
+TEST_CASE("MediaIOAllocator: pooledAllocator sizes audio chunks like the default") {
+        BufferPool            pool;
+        MediaIOAllocator::Ptr alloc = MediaIOAllocator::pooledAllocator(pool);
+        AudioDesc             desc(AudioFormat(AudioFormat::PCMI_Float32LE), 48000, 2);
+        {
+                PcmAudioPayload::Ptr payload = alloc->allocateAudioPayload(desc, 1601);
+                REQUIRE(payload.isValid());
+                CHECK(payload->data()[0].size() == desc.bufferSize(1601));
+        }
+        // 1602 samples round into the same size class as 1601.
+        CHECK(pool.available(desc.bufferSize(1602)) == 1);
+        PcmAudioPayload::Ptr next = alloc->allocateAudioPayload(desc, 1602);
+        REQUIRE(next.isValid());
+        CHECK(pool.available() == 0);
+}
+
 // ============================================================================
 // MediaIO::allocator + setAllocator
 // ============================================================================
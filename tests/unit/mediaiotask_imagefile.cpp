@@ -0,0 +1,172 @@
+/**
+ * @file      mediaiotask_imagefile.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder.
+ *
+ * Tests for ImageFileMediaIO's parallel sequence I/O: write-behind
+ * saves and read-ahead loads must produce exactly what the serial
+ * paths do, in sequence order, across seeks and direction changes.
+ * Each frame is a small PPM whose first byte is its sequence index,
+ * so a delivered frame identifies itself.
+ */
+
+#include <cstdio>
+#include <doctest/doctest.h>
+
+#include <promeki/dir.h>
+#include <promeki/enums_mediaio.h>
+#include <promeki/filepath.h>
+#include <promeki/frame.h>
+#include <promeki/framenumber.h>
+#include <promeki/imagedesc.h>
+#include <promeki/list.h>
+#include <promeki/mediaconfig.h>
+#include <promeki/mediaio.h>
+#include <promeki/mediaiocommand.h>
+#include <promeki/mediaiofactory.h>
+#include <promeki/mediaioportgroup.h>
+#include <promeki/mediaiorequest.h>
+#include <promeki/mediaiosink.h>
+#include <promeki/mediaiosource.h>
+#include <promeki/pixelformat.h>
+#include <promeki/uncompressedvideopayload.h>
+
+using namespace promeki;
+
+namespace {
+
+        constexpr int SeqLength = 24;
+
+        FilePath seqDir() { return Dir::temp().path() / "promeki-imagefile-seq-test"; }
+
+        String seqMask() { return (seqDir() / "shot_####.ppm").toString(); }
+
+        void removeSequence() {
+                Dir d(seqDir());
+                if (!d.exists()) return;
+                for (const FilePath &entry : d.entryList()) {
+                        std::remove((seqDir() / entry.fileName()).toString().cstr());
+                }
+                return;
+        }
+
+        MediaIO *openSequence(bool write, int window) {
+                MediaIO::Config cfg = MediaIOFactory::defaultConfig("ImageFile");
+                cfg.set(MediaConfig::Type, "ImageFile");
+                cfg.set(MediaConfig::Filename, seqMask());
+                cfg.set(MediaConfig::SaveImgSeqEnabled, false);
+                if (write) {
+                        cfg.set(MediaConfig::OpenMode, MediaIOOpenMode(MediaIOOpenMode::Write));
+                        cfg.set(MediaConfig::ImageSeqWriteBehind, int32_t(window));
+                } else {
+                        cfg.set(MediaConfig::ImageSeqReadAhead, int32_t(window));
+                }
+                MediaIO *io = MediaIO::create(cfg);
+                REQUIRE(io != nullptr);
+                REQUIRE(io->open().wait().isOk());
+                return io;
+        }
+
+        void closeSequence(MediaIO *io) {
+                CHECK(io->close().wait().isOk());
+                delete io;
+                return;
+        }
+
+        // Writes SeqLength frames through a sequence writer keeping
+        // @p window saves in flight.
+        void writeSequence(int window) {
+                removeSequence();
+                MediaIO *w = openSequence(true, window);
+                REQUIRE(w->sink(0) != nullptr);
+                for (int i = 0; i < SeqLength; ++i) {
+                        auto vp = UncompressedVideoPayload::allocate(
+                                ImageDesc(16, 8, PixelFormat(PixelFormat::RGB8_sRGB)));
+                        REQUIRE(vp.isValid());
+                        uint8_t     *data = vp.modify()->data()[0].data();
+                        const size_t bytes = vp->plane(0).size();
+                        for (size_t b = 0; b < bytes; ++b) data[b] = static_cast<uint8_t>(i + b);
+                        Frame frame;
+                        frame.addPayload(vp);
+                        REQUIRE(w->sink(0)->writeFrame(frame).wait().isOk());
+                }
+                closeSequence(w);
+                return;
+        }
+
+        // Reads one frame and returns its sequence index (the first
+        // pixel byte), or -1 at end of sequence.
+        int readIndex(MediaIO *io) {
+                MediaIORequest req = io->source(0)->readFrame();
+                if (req.wait().isError()) return -1;
+                const auto *cr = req.commandAs<MediaIOCommandRead>();
+                REQUIRE(cr != nullptr);
+                auto vids = cr->frame.videoPayloads();
+                REQUIRE_FALSE(vids.isEmpty());
+                const auto *uvp = vids[0]->as<UncompressedVideoPayload>();
+                REQUIRE(uvp != nullptr);
+                return uvp->plane(0).data()[0];
+        }
+
+        List<int> readAll(int window) {
+                MediaIO  *r = openSequence(false, window);
+                List<int> got;
+                for (int idx = readIndex(r); idx >= 0; idx = readIndex(r)) got.pushToBack(idx);
+                closeSequence(r);
+                return got;
+        }
+
+} // namespace
+
+TEST_CASE("ImageFileMediaIO: write-behind and read-ahead keep sequence order") {
+        for (int writeWindow : {0, 4}) {
+                CAPTURE(writeWindow);
+                writeSequence(writeWindow);
+                for (int readWindow : {0, 1, 4, 16}) {
+                        CAPTURE(readWindow);
+                        const List<int> got = readAll(readWindow);
+                        REQUIRE(got.size() == SeqLength);
+                        for (int i = 0; i < SeqLength; ++i) CHECK(got[i] == i);
+                }
+        }
+        removeSequence();
+}
+
+TEST_CASE("ImageFileMediaIO: read-ahead follows seeks and direction changes") {
+        writeSequence(4);
+        MediaIO          *r = openSequence(false, 4);
+        MediaIOPortGroup *g = r->portGroup(0);
+        REQUIRE(g != nullptr);
+
+        CHECK(readIndex(r) == 0);
+        CHECK(readIndex(r) == 1);
+
+        REQUIRE(g->seekToFrame(FrameNumber(10)).wait().isOk());
+        CHECK(readIndex(r) == 10);
+        CHECK(readIndex(r) == 11);
+
+        // Reverse: the window re-aims behind the play position.
+        g->setRate(-1.0);
+        const int first = readIndex(r);
+        CHECK(first >= 10);
+        for (int expect = first - 1; expect >= first - 5; --expect) CHECK(readIndex(r) == expect);
+
+        // Hold re-vends the same frame.
+        g->setRate(0.0);
+        const int held = readIndex(r);
+        CHECK(readIndex(r) == held);
+        CHECK(readIndex(r) == held);
+
+        // Forward again, then run off the end.
+        g->setRate(1.0);
+        int last = readIndex(r);
+        for (int idx = readIndex(r); idx >= 0; idx = readIndex(r)) {
+                CHECK(idx == last + 1);
+                last = idx;
+        }
+        CHECK(last == SeqLength - 1);
+
+        closeSequence(r);
+        removeSequence();
+}
@@ -9,6 +9,8 @@
 #include <promeki/mempool.h>
 #include <promeki/string.h>
 #include <promeki/logger.h>
+#include <promeki/list.h>
+#include <thread>
 
 using namespace promeki;
 
@@ -372,3 +374,227 @@ TEST_CASE("MemPool_ReuseAfterFree") {
 
         pool.free(b2);
 }
+
+// ============================================================================
+// TLSF mode
+// ============================================================================
+
+TEST_CASE("MemPool_Tlsf_Construction") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        CHECK(pool.mode() == MemPool::Mode::Tlsf);
+        pool.addRegion(0x10000, 4096);
+        auto stats = pool.stats();
+        CHECK(stats.totalFree == 4096);
+        CHECK(stats.numFreeBlocks == 1);
+        CHECK(stats.largestFreeBlock == 4096);
+        CHECK(stats.numAllocatedBlocks == 0);
+}
+
+TEST_CASE("MemPool_Tlsf_AllocateAndCoalesce") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        pool.addRegion(0x10000, 1024);
+
+        void *a = pool.allocate(128);
+        void *b = pool.allocate(128);
+        void *c = pool.allocate(128);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(c != nullptr);
+        CHECK(a != b);
+        CHECK(b != c);
+        auto stats = pool.stats();
+        CHECK(stats.totalUsed == 384);
+        CHECK(stats.totalFree == 640);
+        CHECK(stats.numAllocatedBlocks == 3);
+
+        // Free the middle one first so both merge directions get exercised.
+        pool.free(b);
+        pool.free(a);
+        pool.free(c);
+        stats = pool.stats();
+        CHECK(stats.totalUsed == 0);
+        CHECK(stats.totalFree == 1024);
+        CHECK(stats.numFreeBlocks == 1);
+        CHECK(stats.largestFreeBlock == 1024);
+        CHECK(pool.memoryMap().size() == 1);
+}
+
+TEST_CASE("MemPool_Tlsf_SizeRounding") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        pool.addRegion(0x10000, 1024);
+        void *p = pool.allocate(1);
+        REQUIRE(p != nullptr);
+        CHECK(pool.stats().totalUsed == MemPool::TlsfGranule);
+        pool.free(p);
+        CHECK(pool.stats().totalFree == 1024);
+}
+
+TEST_CASE("MemPool_Tlsf_Aligned") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        // Deliberately misaligned region start.
+        pool.addRegion(0x10010, 8192);
+        void *p = pool.allocate(100, 256);
+        REQUIRE(p != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(p) % 256 == 0);
+        void *q = pool.allocate(64, 4096);
+        REQUIRE(q != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(q) % 4096 == 0);
+        pool.free(p);
+        pool.free(q);
+        auto stats = pool.stats();
+        CHECK(stats.totalFree == 8192);
+        CHECK(stats.numFreeBlocks == 1);
+}
+
+TEST_CASE("MemPool_Tlsf_ExactFitAndExhaustion") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        pool.addRegion(0x10000, 1040);
+        // 1040 rounds past its own list in the TLSF search; the exact-size
+        // fallback must still find the block.
+        void *p = pool.allocate(1040);
+        REQUIRE(p != nullptr);
+        CHECK(pool.stats().numFreeBlocks == 0);
+        CHECK(pool.allocate(16) == nullptr);
+        pool.free(p);
+        CHECK(pool.stats().totalFree == 1040);
+        CHECK(pool.allocate(2048) == nullptr);
+}
+
+TEST_CASE("MemPool_Tlsf_DescriptorExhaustion") {
+        MemPool::Config cfg;
+        cfg.mode = MemPool::Mode::Tlsf;
+        cfg.maxBlocks = 4;
+        MemPool pool(cfg);
+        pool.addRegion(0x10000, 4096);
+
+        // Out of descriptors the remainder stays inside the last
+        // allocation rather than failing it.
+        List<void *> ptrs;
+        for (int i = 0; i < 4; i++) {
+                void *p = pool.allocate(64);
+                if (p != nullptr) ptrs.pushToBack(p);
+        }
+        CHECK(ptrs.size() == 4);
+        CHECK(pool.stats().totalUsed + pool.stats().totalFree == 4096);
+        for (void *p : ptrs) pool.free(p);
+        auto stats = pool.stats();
+        CHECK(stats.totalFree == 4096);
+        CHECK(stats.numFreeBlocks == 1);
+}
+
+TEST_CASE("MemPool_Tlsf_RandomChurn") {
+        MemPool pool(MemPool::Mode::Tlsf);
+        pool.addRegion(0x100000, 1 << 20);
+        List<void *> live;
+        uint32_t     seed = 12345;
+        for (int i = 0; i < 5000; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                if (live.size() < 64 && (seed >> 31) == 0) {
+                        size_t size = 1 + ((seed >> 8) % 8000);
+                        size_t align = size_t(1) << ((seed >> 4) % 8);
+                        void  *p = pool.allocate(size, align);
+                        if (p != nullptr) {
+                                CHECK(reinterpret_cast<uintptr_t>(p) % align == 0);
+                                live.pushToBack(p);
+                        }
+                } else if (!live.isEmpty()) {
+                        size_t idx = (seed >> 8) % live.size();
+                        pool.free(live[idx]);
+                        live.remove(idx);
+                }
+        }
+        for (void *p : live) pool.free(p);
+        auto stats = pool.stats();
+        CHECK(stats.totalUsed == 0);
+        CHECK(stats.totalFree == (1 << 20));
+        CHECK(stats.numFreeBlocks == 1);
+}
+
+TEST_CASE("MemPool_Tlsf_FrontCache") {
+        MemPool::Config cfg;
+        cfg.mode = MemPool::Mode::Tlsf;
+        cfg.frontCacheMaxSize = 256;
+        cfg.frontCacheDepth = 4;
+        MemPool pool(cfg);
+        pool.addRegion(0x10000, 65536);
+
+        void *a = pool.allocate(100);
+        REQUIRE(a != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(a) % MemPool::TlsfGranule == 0);
+        pool.free(a);
+        auto stats = pool.stats();
+        CHECK(stats.cachedBlocks == 1);
+        CHECK(stats.cachedBytes >= 112);
+        CHECK(stats.numAllocatedBlocks == 0);
+        CHECK(stats.totalUsed == 0);
+
+        // Same size class comes straight back out of the cache.
+        void *b = pool.allocate(112);
+        CHECK(b == a);
+        CHECK(pool.stats().cachedBlocks == 0);
+        pool.free(b);
+
+        // Larger requests bypass the cache.
+        void *big = pool.allocate(4096);
+        REQUIRE(big != nullptr);
+        pool.free(big);
+        CHECK(pool.stats().cachedBlocks == 1);
+
+        pool.flushThreadCache();
+        stats = pool.stats();
+        CHECK(stats.cachedBlocks == 0);
+        CHECK(stats.totalFree == 65536);
+        CHECK(stats.numFreeBlocks == 1);
+}
+
+TEST_CASE("MemPool_Tlsf_FrontCacheDepth") {
+        MemPool::Config cfg;
+        cfg.mode = MemPool::Mode::Tlsf;
+        cfg.frontCacheMaxSize = 64;
+        cfg.frontCacheDepth = 2;
+        MemPool pool(cfg);
+        pool.addRegion(0x10000, 4096);
+        void *p[4];
+        for (auto &v : p) v = pool.allocate(32);
+        for (auto &v : p) pool.free(v);
+        auto stats = pool.stats();
+        CHECK(stats.cachedBlocks == 2);
+        CHECK(stats.numAllocatedBlocks == 0);
+        pool.flushThreadCache();
+        CHECK(pool.stats().totalFree == 4096);
+}
+
+TEST_CASE("MemPool_Tlsf_FrontCacheThreads") {
+        MemPool::Config cfg;
+        cfg.mode = MemPool::Mode::Tlsf;
+        cfg.frontCacheMaxSize = 512;
+        MemPool pool(cfg);
+        pool.addRegion(0x1000000, 1 << 22);
+
+        List<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+                threads.pushToBack(std::thread([&pool, t]() {
+                        List<void *> live;
+                        uint32_t     seed = 777u + t;
+                        for (int i = 0; i < 4000; i++) {
+                                seed = seed * 1664525u + 1013904223u;
+                                if (live.size() < 32 && (seed >> 31) == 0) {
+                                        void *p = pool.allocate(1 + (seed >> 8) % 1024);
+                                        if (p != nullptr) live.pushToBack(p);
+                                } else if (!live.isEmpty()) {
+                                        pool.free(live.back());
+                                        live.popFromBack();
+                                }
+                        }
+                        for (void *p : live) pool.free(p);
+                }));
+        }
+        for (auto &th : threads) th.join();
+
+        // Thread exit drains every cache back into the pool.
+        auto stats = pool.stats();
+        CHECK(stats.cachedBlocks == 0);
+        CHECK(stats.totalUsed == 0);
+        CHECK(stats.totalFree == (1 << 22));
+        CHECK(stats.numFreeBlocks == 1);
+}
@@ -88,6 +88,62 @@ TEST_CASE("LoopbackTransport") {
                 }
         }
 
+        SUBCASE("batch send gathers scatter segments") {
+                LoopbackTransport a, b;
+                LoopbackTransport::pair(&a, &b);
+                a.open();
+                b.open();
+
+                const char                header[] = "RTP";
+                const char                body[] = "-sample-data";
+                PacketTransport::Datagram d;
+                d.data = header;
+                d.size = std::strlen(header);
+                d.segments[0] = {body, std::strlen(body)};
+                d.segmentCount = 1;
+                d.dest = SocketAddress(Ipv4Address::loopback(), 1111);
+                PacketTransport::DatagramList batch;
+                batch.pushToBack(d);
+                CHECK(a.sendPackets(batch) == 1);
+
+                char    buf[32];
+                ssize_t n = b.receivePacket(buf, sizeof(buf));
+                REQUIRE(n == 15);
+                CHECK(std::memcmp(buf, "RTP-sample-data", 15) == 0);
+        }
+
+        SUBCASE("paired batch receive") {
+                LoopbackTransport a, b;
+                LoopbackTransport::pair(&a, &b);
+                a.open();
+                b.open();
+
+                SocketAddress src(Ipv4Address::loopback(), 2222);
+                for (int i = 0; i < 3; i++) {
+                        char msg[16];
+                        int  len = std::snprintf(msg, sizeof(msg), "rx%d", i);
+                        a.sendPacket(msg, len, src);
+                }
+
+                char                             bufs[2][16];
+                PacketTransport::RecvDatagramList slots;
+                for (int i = 0; i < 2; i++) {
+                        PacketTransport::RecvDatagram d;
+                        d.data = bufs[i];
+                        d.maxSize = sizeof(bufs[i]);
+                        slots.pushToBack(d);
+                }
+
+                // First call fills both slots, second picks up the rest.
+                CHECK(b.receivePackets(slots) == 2);
+                CHECK(slots[0].size == 3);
+                CHECK(std::memcmp(bufs[0], "rx0", 3) == 0);
+                CHECK(std::memcmp(bufs[1], "rx1", 3) == 0);
+                CHECK(b.receivePackets(slots) == 1);
+                CHECK(std::memcmp(bufs[0], "rx2", 3) == 0);
+                CHECK(b.receivePackets(slots) == -1);
+        }
+
         SUBCASE("bidirectional") {
                 LoopbackTransport a, b;
                 LoopbackTransport::pair(&a, &b);
@@ -134,6 +190,13 @@ TEST_CASE("LoopbackTransport") {
                 CHECK(t.setTxTime(false).isOk());
         }
 
+        SUBCASE("zero-copy is not supported") {
+                LoopbackTransport t;
+                t.open();
+                CHECK(t.setZeroCopy(true) == Error::NotSupported);
+                CHECK_FALSE(t.isZeroCopy());
+        }
+
         SUBCASE("destructor unhooks peer") {
                 LoopbackTransport a;
                 {
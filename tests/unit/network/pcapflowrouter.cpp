@@ -485,3 +485,114 @@ TEST_CASE("PcapFlowRouter: a zero jitter threshold disables jitter warnings") {
         // are off.
         CHECK(router.flowStats()[0].maxJitter.nanoseconds() > 0);
 }
+
+// ---- Parallel (sharded) analysis ---------------------------------------
+
+namespace {
+
+// A multi-flow capture exercising every kind of per-flow event: six
+// ANC destinations interleaved packet by packet, one of which drops a
+// packet, one of which changes SSRC, and each of which ends on a frame
+// with no marker (flushed at end of capture), plus an unlabelled flow.
+Buffer multiFlowCapture(uint32_t framesPerFlow) {
+        std::vector<std::vector<uint8_t>> frames;
+        for(uint32_t f = 0; f < framesPerFlow; ++f) {
+                for(uint8_t flow = 1; flow <= 6; ++flow) {
+                        if(flow == 2 && f == 3) continue; // packet loss on flow 2
+                        const uint8_t  dst[4] = {239, 10, 10, flow};
+                        const uint32_t ssrc = (flow == 3 && f >= framesPerFlow / 2) ? 0xB000u : 0xA000u + flow;
+                        RtpPacket p = oneAncPkt(100, ssrc, 1000 + f * 1501, static_cast<uint16_t>(f));
+                        if(f + 1 == framesPerFlow) p.setMarker(false);
+                        frames.push_back(ethIpv4Udp(dst, 5004, rtpBytes(p)));
+                }
+                const uint8_t other[4] = {239, 20, 20, 1};
+                frames.push_back(ethIpv4Udp(other, 6000, rtpBytes(oneAncPkt(96, 0xC0FFEE, f * 3003,
+                                                                            static_cast<uint16_t>(f)))));
+        }
+        return classicPcap(frames);
+}
+
+// Runs @p cap through @p router and returns every callback as a line of
+// text, in delivery order.
+List<String> eventLog(PcapFlowRouter &router, const Buffer &cap) {
+        List<String> log;
+        router.onAncFrame([&](const PcapFlowRouter::RoutedAncFrame &f) {
+                log.pushToBack(String("anc ") + f.dst.toString() + " " + String::number(f.ssrc) + " " +
+                               String::number(f.anc.rtpTimestamp) + " " + String::number(f.anc.packetCount));
+        });
+        router.onRtpAnomaly([&](const Anomaly &a) {
+                log.pushToBack(String("rtp ") + String::number(static_cast<int>(a.kind)) + " " + a.dst.toString() +
+                               " " + String::number(a.ssrc) + " " + String::number(a.count));
+        });
+        REQUIRE(router.processBuffer(cap).isOk());
+        return log;
+}
+
+void configureSix(PcapFlowRouter &router) {
+        for(uint8_t flow = 1; flow <= 6; ++flow) {
+                router.addAncFlow(SocketAddress(Ipv4Address(239, 10, 10, flow), 5004));
+        }
+        return;
+}
+
+void checkSameStats(const PcapFlowRouter &a, const PcapFlowRouter &b) {
+        REQUIRE(a.flowStats().size() == b.flowStats().size());
+        for(size_t i = 0; i < a.flowStats().size(); ++i) {
+                const PcapFlowRouter::FlowStat &x = a.flowStats()[i];
+                const PcapFlowRouter::FlowStat &y = b.flowStats()[i];
+                CHECK(x.dst.toString() == y.dst.toString());
+                CHECK(x.ssrc == y.ssrc);
+                CHECK(x.kind == y.kind);
+                CHECK(x.packets == y.packets);
+                CHECK(x.bytes == y.bytes);
+                CHECK(x.lostPackets == y.lostPackets);
+                CHECK(x.maxJitter.nanoseconds() == y.maxJitter.nanoseconds());
+        }
+        return;
+}
+
+} // namespace
+
+TEST_CASE("PcapFlowRouter: sharded analysis matches the single-threaded run exactly") {
+        const Buffer cap = multiFlowCapture(40);
+
+        PcapFlowRouter serial;
+        configureSix(serial);
+        const List<String> expected = eventLog(serial, cap);
+        // Sanity: the capture really does produce every kind of event.
+        REQUIRE(expected.size() > 6 * 40);
+        REQUIRE(serial.flowStats().size() == 8); // 6 ANC + the SSRC-changed row + the unlabelled flow
+
+        for(unsigned int threads : {2u, 3u, 4u, 8u}) {
+                CAPTURE(threads);
+                PcapFlowRouter sharded;
+                sharded.setThreads(threads);
+                CHECK(sharded.threads() == threads);
+                configureSix(sharded);
+                const List<String> got = eventLog(sharded, cap);
+                REQUIRE(got.size() == expected.size());
+                for(size_t i = 0; i < got.size(); ++i) CHECK(got[i] == expected[i]);
+                checkSameStats(sharded, serial);
+        }
+}
+
+TEST_CASE("PcapFlowRouter: per-flow state carries across a thread-count change") {
+        const Buffer first = multiFlowCapture(10);
+        const Buffer second = multiFlowCapture(12);
+
+        PcapFlowRouter serial;
+        configureSix(serial);
+        List<String> expected = eventLog(serial, first);
+        for(const String &line : eventLog(serial, second)) expected.pushToBack(line);
+
+        PcapFlowRouter mixed;
+        mixed.setThreads(4);
+        configureSix(mixed);
+        List<String> got = eventLog(mixed, first);
+        mixed.setThreads(1);
+        for(const String &line : eventLog(mixed, second)) got.pushToBack(line);
+
+        REQUIRE(got.size() == expected.size());
+        for(size_t i = 0; i < got.size(); ++i) CHECK(got[i] == expected[i]);
+        checkSameStats(mixed, serial);
+}
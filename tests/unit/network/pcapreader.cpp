@@ -6,10 +6,13 @@
  */
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <vector>
 #include <doctest/doctest.h>
 #include <promeki/buffer.h>
+#include <promeki/dir.h>
+#include <promeki/file.h>
 #include <promeki/pcapreader.h>
 
 using namespace promeki;
@@ -322,6 +325,162 @@ TEST_CASE("PcapReader: next() on an unopened reader reports NotOpen") {
         CHECK(err == Error::NotOpen);
 }
 
+// --- mapped files and seeking ----------------------------------------
+
+namespace {
+
+// Write @p c to a scratch file and return its path.
+String writeCapture(const Cap &c, const char *name) {
+        const String path = Dir::temp().path().toString() + "/" + name;
+        File f(path);
+        f.open(IODevice::WriteOnly, File::Create | File::Truncate);
+        f.write(c.d.data(), static_cast<int64_t>(c.d.size()));
+        f.close();
+        return path;
+}
+
+// Classic capture whose record i carries ts_sec == i and a payload
+// whose first byte is (i & 0xff).
+Cap numberedClassic(uint32_t count) {
+        Cap c(false);
+        classicGlobalHeader(c, PcapReader::MagicMicros, 65535, PcapLinkType::Ethernet.value());
+        for(uint32_t i = 0; i < count; i++) {
+                const uint8_t b = static_cast<uint8_t>(i);
+                classicRecord(c, i, 0, 4, {b, 0x01, 0x02, 0x03});
+        }
+        return c;
+}
+
+} // namespace
+
+TEST_CASE("PcapReader: openFile maps the capture and yields the same records") {
+        const Cap c = numberedClassic(10);
+        const String path = writeCapture(c, "promeki_pcapreader_mapped.pcap");
+
+        PcapReader r;
+        REQUIRE(r.openFile(path).isOk());
+        CHECK(r.isMapped());
+        CHECK(r.format() == PcapFileFormat::ClassicPcap);
+        BufferView kept;
+        for(uint32_t i = 0; i < 10; i++) {
+                auto [rec, err] = r.next();
+                REQUIRE(err.isOk());
+                CHECK(rec.captureTime.nanoseconds() == static_cast<int64_t>(i) * 1000000000LL);
+                CHECK(rec.frame.data()[0] == static_cast<uint8_t>(i));
+                if(i == 7) kept = rec.frame;
+        }
+        auto [end, endErr] = r.next();
+        CHECK(endErr == Error::EndOfFile);
+
+        // A frame keeps the mapping alive after the reader lets go.
+        r.close();
+        CHECK_FALSE(r.isMapped());
+        REQUIRE(kept.size() == 4);
+        CHECK(kept.data()[0] == 7);
+        std::remove(path.cstr());
+}
+
+TEST_CASE("PcapReader: openMapped reports OpenFailed for a missing file") {
+        PcapReader r;
+        CHECK(r.openMapped(Dir::temp().path().toString() + "/promeki_pcapreader_missing.pcap") == Error::OpenFailed);
+        CHECK_FALSE(r.isOpen());
+}
+
+TEST_CASE("PcapReader: seekRecord revisits and skips ahead in a classic capture") {
+        const uint32_t count = static_cast<uint32_t>(PcapReader::IndexStride * 3 + 5);
+        PcapReader r;
+        REQUIRE(r.openBuffer(numberedClassic(count).buffer()).isOk());
+        CHECK(r.recordIndex() == 0);
+
+        auto expectAt = [&r](uint64_t index) {
+                REQUIRE(r.seekRecord(index).isOk());
+                CHECK(r.recordIndex() == index);
+                auto [rec, err] = r.next();
+                REQUIRE(err.isOk());
+                CHECK(rec.captureTime.nanoseconds() == static_cast<int64_t>(index) * 1000000000LL);
+                CHECK(r.recordIndex() == index + 1);
+        };
+
+        expectAt(PcapReader::IndexStride * 2 + 3); // past the frontier: parses forward
+        expectAt(1);                               // backward: restarts at checkpoint 0
+        expectAt(PcapReader::IndexStride + 1);     // forward over indexed records
+        expectAt(count - 1);
+        expectAt(0);
+
+        // Seeking to the end is valid; beyond it is not.
+        REQUIRE(r.seekRecord(count).isOk());
+        auto [end, endErr] = r.next();
+        CHECK(endErr == Error::EndOfFile);
+        CHECK(r.seekRecord(count + 1) == Error::EndOfFile);
+        CHECK(r.recordIndex() == count);
+        expectAt(PcapReader::IndexStride);
+}
+
+TEST_CASE("PcapReader: seekRecord restores pcapng section and interface state") {
+        // Section 0 (little-endian): one Ethernet interface, then a second
+        // (Linux SLL2) interface added part-way through.  Section 1
+        // (big-endian) defines only an SLL2 interface.
+        const size_t stride = PcapReader::IndexStride;
+        Cap c(false);
+        pcapngShb(c);
+        pcapngIdb(c, PcapLinkType::Ethernet.value(), 65535, 6);
+        for(size_t i = 0; i < stride + 2; i++) pcapngEpb(c, 0, i, 4, {0x00, 0, 0, 0});
+        pcapngIdb(c, PcapLinkType::LinuxSll2.value(), 65535, 6);
+        for(size_t i = 0; i < stride; i++) pcapngEpb(c, 1, i, 4, {0x01, 0, 0, 0});
+        Cap be(true);
+        pcapngShb(be);
+        pcapngIdb(be, PcapLinkType::LinuxSll2.value(), 65535, 9);
+        for(size_t i = 0; i < stride; i++) pcapngEpb(be, 0, i, 4, {0x02, 0, 0, 0});
+        c.d.insert(c.d.end(), be.d.begin(), be.d.end());
+        const uint64_t total = stride * 3 + 2;
+
+        PcapReader r;
+        REQUIRE(r.openBuffer(c.buffer()).isOk());
+
+        // Walk to the end so every checkpoint exists, then jump around.
+        REQUIRE(r.seekRecord(total - 1).isOk());
+        auto [last, lastErr] = r.next();
+        REQUIRE(lastErr.isOk());
+        CHECK(last.frame.data()[0] == 0x02);
+        CHECK(r.byteOrder() == PcapByteOrder::BigEndian);
+
+        // Record stride+1 is in section 0 before the second IDB.
+        REQUIRE(r.seekRecord(stride + 1).isOk());
+        CHECK(r.byteOrder() == PcapByteOrder::LittleEndian);
+        auto [a, aErr] = r.next();
+        REQUIRE(aErr.isOk());
+        CHECK(a.linkType == PcapLinkType::Ethernet);
+        CHECK(a.frame.data()[0] == 0x00);
+        // Parsing on through the second IDB must not duplicate it.
+        auto [b, bErr] = r.next();
+        REQUIRE(bErr.isOk());
+        CHECK(b.linkType == PcapLinkType::LinuxSll2);
+        CHECK(b.frame.data()[0] == 0x01);
+        CHECK(r.interfaceCount() == 2);
+
+        // Record 2*stride+2 is the first of section 1 (a checkpoint-free
+        // boundary), reached from the checkpoint in section 0.
+        REQUIRE(r.seekRecord(stride * 2 + 2).isOk());
+        auto [d, dErr] = r.next();
+        REQUIRE(dErr.isOk());
+        CHECK(d.frame.data()[0] == 0x02);
+        CHECK(d.captureTime.nanoseconds() == 0);
+        CHECK(r.interfaceCount() == 1);
+
+        // A checkpoint inside section 1 restores big-endian state.
+        REQUIRE(r.seekRecord(stride * 3).isOk());
+        CHECK(r.byteOrder() == PcapByteOrder::BigEndian);
+        auto [e, eErr] = r.next();
+        REQUIRE(eErr.isOk());
+        CHECK(e.linkType == PcapLinkType::LinuxSll2);
+        CHECK(e.captureTime.nanoseconds() == static_cast<int64_t>(stride - 2));
+}
+
+TEST_CASE("PcapReader: seekRecord on an unopened reader reports NotOpen") {
+        PcapReader r;
+        CHECK(r.seekRecord(0) == Error::NotOpen);
+}
+
 TEST_CASE("PcapLinkType: unknown wire value round-trips as a valid Enum") {
         PcapLinkType lt(12345);
         CHECK(lt.value() == 12345);
@@ -0,0 +1,150 @@
+/**
+ * @file      rtppacketslabpool.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ */
+
+#include <doctest/doctest.h>
+#include <promeki/rtppacketslabpool.h>
+#include <promeki/rtppacket.h>
+#include <promeki/list.h>
+
+using namespace promeki;
+
+namespace {
+
+        // Drives a pool the way the RTP receive thread does: short
+        // batches fill the free slots of the fill slab, and the most
+        // recent @p retained packets stay referenced downstream, as a
+        // reorder window / depacketizer queue would hold them.
+        RtpPacketSlabPool::Stats simulateReceive(RtpPacketSlabPool &pool, size_t retained, size_t total) {
+                List<RtpPacket> held;
+                held.resize(retained);
+                size_t received = 0;
+                size_t round = 0;
+                while (received < total) {
+                        size_t first = 0;
+                        Buffer slab = pool.fillSlab(first);
+                        REQUIRE(slab.isValid());
+                        // recvmmsg() hands back anywhere from 1 to the
+                        // whole batch depending on how far behind we are.
+                        const size_t free = pool.packetsPerSlab() - first;
+                        size_t       got = 1 + (round++ * 7) % pool.packetsPerSlab();
+                        if (got > free) got = free;
+                        pool.commitSlots(got);
+                        for (size_t i = 0; i < got; ++i) {
+                                const size_t offset = (first + i) * pool.packetStride();
+                                held[received % retained] = RtpPacket(slab, offset, RtpPacket::HeaderSize);
+                                received++;
+                        }
+                }
+                return pool.stats();
+        }
+
+} // namespace
+
+TEST_CASE("RtpPacketSlabPool") {
+
+        SUBCASE("geometry") {
+                RtpPacketSlabPool pool(32, 2048);
+                CHECK(pool.packetsPerSlab() == 32);
+                CHECK(pool.packetStride() == 2048);
+                CHECK(pool.slabBytes() == 32 * 2048);
+                CHECK(pool.maxSlabs() == RtpPacketSlabPool::DefaultMaxSlabs);
+                CHECK(pool.slabCount() == 0);
+
+                Buffer slab = pool.acquire();
+                REQUIRE(slab.isValid());
+                CHECK(slab.size() == pool.slabBytes());
+                CHECK(pool.slabCount() == 1);
+        }
+
+        SUBCASE("slab is recycled once every packet view is dropped") {
+                RtpPacketSlabPool pool(4, 256);
+                const void       *firstData = nullptr;
+                {
+                        Buffer slab = pool.acquire();
+                        REQUIRE(slab.isValid());
+                        firstData = slab.data();
+                        RtpPacket::List views;
+                        for (size_t i = 0; i < pool.packetsPerSlab(); ++i) {
+                                views.pushToBack(RtpPacket(slab, i * pool.packetStride(), RtpPacket::HeaderSize));
+                        }
+                        // Receive loop drops its handle; the views keep
+                        // the slab pinned.
+                        slab = Buffer();
+                        Buffer second = pool.acquire();
+                        CHECK(second.data() != firstData);
+                        CHECK(pool.slabCount() == 2);
+                }
+                // Views (and the second handle) are gone — both slabs
+                // are free again and the next acquire reuses one.
+                Buffer again = pool.acquire();
+                CHECK(pool.slabCount() == 2);
+                CHECK(pool.stats().allocated == 2);
+                CHECK(pool.stats().reused == 1);
+        }
+
+        SUBCASE("overflow past maxSlabs is unpooled") {
+                RtpPacketSlabPool pool(2, 128, 2);
+                Buffer            a = pool.acquire();
+                Buffer            b = pool.acquire();
+                Buffer            c = pool.acquire();
+                REQUIRE(c.isValid());
+                CHECK(pool.slabCount() == 2);
+                CHECK(pool.stats().overflow == 1);
+        }
+
+        SUBCASE("fillSlab keeps filling one slab across short batches") {
+                RtpPacketSlabPool pool(4, 256);
+                size_t            first = 99;
+                Buffer            a = pool.fillSlab(first);
+                CHECK(first == 0);
+                pool.commitSlots(3);
+                Buffer b = pool.fillSlab(first);
+                CHECK(b.data() == a.data());
+                CHECK(first == 3);
+                pool.commitSlots(1);
+                Buffer c = pool.fillSlab(first);
+                CHECK(c.data() != a.data());
+                CHECK(first == 0);
+                CHECK(pool.slabCount() == 2);
+        }
+
+        SUBCASE("slabsForPackets covers whole slabs plus both ends") {
+                CHECK(RtpPacketSlabPool::slabsForPackets(0, 32) == 2);
+                CHECK(RtpPacketSlabPool::slabsForPackets(32, 32) == 3);
+                CHECK(RtpPacketSlabPool::slabsForPackets(33, 32) == 4);
+        }
+
+        SUBCASE("UHD frames in flight stay pooled when the cap follows the budget") {
+                // 3840x2160 4:2:2 10-bit is ~20.7 MB a frame, ~16K
+                // packets at 1300 payload bytes.  Hold five frames
+                // downstream (reorder window + depacketizer queue +
+                // reassembly, as RtpMediaIO budgets it) and push eight
+                // frames through.  The stride only affects memory, so
+                // keep it small.
+                const size_t packetsPerFrame = (3840u * 2160u * 20u / 8u + 1299u) / 1300u;
+                const size_t retained = packetsPerFrame * 5;
+                const size_t total = packetsPerFrame * 8;
+
+                RtpPacketSlabPool sized(32, 16, RtpPacketSlabPool::slabsForPackets(retained, 32));
+                const RtpPacketSlabPool::Stats st = simulateReceive(sized, retained, total);
+                CHECK(st.overflow == 0);
+                CHECK(sized.slabCount() <= sized.maxSlabs());
+                CHECK(st.reused > 0);
+
+                // The fixed default cap cannot hold a single UHD frame.
+                RtpPacketSlabPool fixed(32, 16);
+                CHECK(simulateReceive(fixed, retained, total).overflow > 0);
+        }
+
+        SUBCASE("clear drops pooled slabs") {
+                RtpPacketSlabPool pool(2, 128);
+                Buffer            held = pool.acquire();
+                pool.clear();
+                CHECK(pool.slabCount() == 0);
+                CHECK(held.isValid());
+        }
+}
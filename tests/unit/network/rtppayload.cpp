@@ -372,6 +372,52 @@ TEST_CASE("RtpPayloadJpeg") {
                 // Type byte is at offset 16 in the packet (byte 4 of JPEG header).
                 CHECK(packets[0].data()[16] == 1);
         }
+
+        SUBCASE("DRI sends type 64 with a restart header and unpack rebuilds it") {
+                // Minimal JPEG with a DRI segment ahead of SOS and RSTn
+                // markers inside the entropy-coded data.
+                auto                 base = buildMinimalJpeg(0);
+                std::vector<uint8_t> jpeg(base.begin(), base.begin() + 2 + 69); // SOI + DQT
+                const uint8_t        dri[] = {0xFF, 0xDD, 0x00, 0x04, 0x01, 0x2C}; // interval 300
+                jpeg.insert(jpeg.end(), dri, dri + sizeof(dri));
+                jpeg.insert(jpeg.end(), base.begin() + 2 + 69, base.end()); // SOS header
+                for (int i = 0; i < 3000; i++) {
+                        if (i % 1000 == 499) {
+                                jpeg.push_back(0xFF);
+                                jpeg.push_back(static_cast<uint8_t>(0xD0 + i / 1000));
+                        } else {
+                                jpeg.push_back(static_cast<uint8_t>((i & 0x7F) + 1));
+                        }
+                }
+
+                RtpPayloadJpeg payload(640, 480);
+                auto           packets = payload.pack(jpeg.data(), jpeg.size());
+                REQUIRE(packets.size() > 1);
+                for (size_t i = 0; i < packets.size(); i++) {
+                        const uint8_t *pkt = packets[i].data();
+                        CHECK(pkt[16] == 64);
+                        // Restart Marker Header at offset 20: interval, F=L=1, count 0x3FFF.
+                        CHECK(pkt[20] == 0x01);
+                        CHECK(pkt[21] == 0x2C);
+                        CHECK(pkt[22] == 0xFF);
+                        CHECK(pkt[23] == 0xFF);
+                }
+                // The Quantization Table Header follows the restart header.
+                uint16_t qtLen = (static_cast<uint16_t>(packets[0].data()[26]) << 8) | packets[0].data()[27];
+                CHECK(qtLen == 64);
+
+                Buffer         result = payload.unpack(packets);
+                const uint8_t *r = static_cast<const uint8_t *>(result.data());
+                bool           foundDri = false;
+                int            restarts = 0;
+                for (size_t i = 0; i + 5 < result.size(); i++) {
+                        if (r[i] != 0xFF) continue;
+                        if (r[i + 1] == 0xDD && r[i + 4] == 0x01 && r[i + 5] == 0x2C) foundDri = true;
+                        if (r[i + 1] >= 0xD0 && r[i + 1] <= 0xD7) restarts++;
+                }
+                CHECK(foundDri);
+                CHECK(restarts == 3);
+        }
 }
 
 // ============================================================================
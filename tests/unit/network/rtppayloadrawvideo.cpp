@@ -923,3 +923,162 @@ TEST_CASE("RtpPayloadRawVideo: 3-SRD-per-packet cap holds across pgroups (§6.2.
                 }
         }
 }
+
+TEST_CASE("RtpPayloadRawVideo: packBuffer scatters sample data") {
+        // Concatenates every slice of a (possibly scattered) packet.
+        auto flatten = [](const RtpPacket &pkt) {
+                std::vector<uint8_t> out;
+                for (size_t i = 0; i < pkt.count(); i++) {
+                        const uint8_t *p = pkt[i].data();
+                        out.insert(out.end(), p, p + pkt[i].size());
+                }
+                return out;
+        };
+        auto makeFrame = [](size_t bytes) {
+                Buffer buf(bytes);
+                buf.setSize(bytes);
+                uint8_t *p = static_cast<uint8_t *>(buf.data());
+                for (size_t i = 0; i < bytes; i++) p[i] = static_cast<uint8_t>((i * 13) & 0xFF);
+                return buf;
+        };
+        auto checkMatches = [&](RtpPayloadRawVideo &a, RtpPayloadRawVideo &b, const Buffer &frame, size_t offset,
+                                size_t size) {
+                const uint8_t *base = static_cast<const uint8_t *>(frame.data()) + offset;
+                auto           flat = a.pack(base, size);
+                auto           scattered = b.packBuffer(frame, offset, size);
+                REQUIRE(flat.size() == scattered.size());
+                for (size_t i = 0; i < flat.size(); i++) {
+                        CHECK(scattered[i].size() == flat[i].size());
+                        CHECK(scattered[i].marker() == flat[i].marker());
+                        CHECK(scattered[i].count() <= 1 + RtpPayloadRawVideo::MaxSrdsPerPacket + 1);
+                        const std::vector<uint8_t> bytes = flatten(scattered[i]);
+                        REQUIRE(bytes.size() == flat[i].size());
+                        CHECK(std::memcmp(bytes.data(), flat[i].data(), bytes.size()) == 0);
+                }
+                CHECK(a.packetCounter() == b.packetCounter());
+                return scattered;
+        };
+
+        SUBCASE("GPM long lines match pack() and reference the frame") {
+                RtpPayloadRawVideo a(320, 240, 24), b(320, 240, 24);
+                Buffer             frame = makeFrame(320 * 240 * 3);
+                auto               packets = checkMatches(a, b, frame, 0, frame.size());
+                for (size_t i = 0; i < packets.size(); i++) {
+                        REQUIRE(packets[i].count() == 2);
+                        CHECK(packets[i][1].buffer().impl() == frame.impl());
+                        const size_t hdrBytes = RtpPacket::HeaderSize + RtpPayloadRawVideo::ExtSeqSize +
+                                                RtpPayloadRawVideo::SrdHeaderSize;
+                        CHECK(packets[i][0].size() == hdrBytes);
+                }
+        }
+
+        SUBCASE("short lines coalesce into one contiguous data slice") {
+                RtpPayloadRawVideo a(16, 64, 24), b(16, 64, 24);
+                Buffer             frame = makeFrame(16 * 64 * 3);
+                auto               packets = checkMatches(a, b, frame, 0, frame.size());
+                // Consecutive rows sit back to back in the frame, so a
+                // 3-SRD packet still needs only one data slice.
+                CHECK(packets[0].count() == 2);
+        }
+
+        SUBCASE("non-zero source offset") {
+                RtpPayloadRawVideo a(64, 32, 24), b(64, 32, 24);
+                Buffer             frame = makeFrame(64 * 32 * 3 + 100);
+                checkMatches(a, b, frame, 100, 64 * 32 * 3);
+        }
+
+        SUBCASE("BPM padding comes from a zero slice") {
+                RtpPayloadRawVideo a(320, 24, 24), b(320, 24, 24);
+                a.setPackingMode(St2110PackingMode::Bpm);
+                b.setPackingMode(St2110PackingMode::Bpm);
+                Buffer frame = makeFrame(320 * 24 * 3);
+                checkMatches(a, b, frame, 0, frame.size());
+        }
+
+        SUBCASE("truncated source emits zeros") {
+                RtpPayloadRawVideo a(64, 32, 24), b(64, 32, 24);
+                Buffer             frame = makeFrame(64 * 32 * 3);
+                checkMatches(a, b, frame, 0, 64 * 20 * 3 + 7);
+        }
+}
+
+TEST_CASE("RtpPayloadRawVideo: FrameAssembly writes packets straight into the plane") {
+        RtpPayloadRawVideo tx(64, 32, 24), rx(64, 32, 24);
+        const size_t       bytes = 64 * 32 * 3;
+        Buffer             frame(bytes);
+        frame.setSize(bytes);
+        uint8_t *src = static_cast<uint8_t *>(frame.data());
+        for (size_t i = 0; i < bytes; i++) src[i] = static_cast<uint8_t>((i * 7 + 1) & 0xFF);
+        RtpPacket::List packets = tx.pack(src, bytes);
+        REQUIRE(packets.size() > 2);
+        CHECK(rx.frameSize() == bytes);
+        CHECK(rx.wireLineCount() == 32);
+        CHECK(rx.wireBytesPerLine() == 64 * 3);
+
+        Buffer plane(bytes);
+        plane.setSize(bytes);
+        std::memset(plane.data(), 0x5A, bytes);
+
+        SUBCASE("complete frame matches unpack() in place") {
+                RtpPayloadRawVideo::FrameAssembly asmb;
+                asmb.begin(plane, rx.wireLineCount(), rx.wireBytesPerLine());
+                CHECK(asmb.isActive());
+                for (const auto &pkt : packets) rx.unpackInto(pkt, asmb);
+                Buffer out = asmb.finish();
+                CHECK_FALSE(asmb.isActive());
+                CHECK(out.impl() == plane.impl());
+                CHECK(asmb.isComplete());
+                CHECK(asmb.missingLines() == 0);
+                Buffer ref = rx.unpack(packets);
+                REQUIRE(ref.size() == bytes);
+                CHECK(std::memcmp(out.data(), ref.data(), bytes) == 0);
+                CHECK(std::memcmp(out.data(), src, bytes) == 0);
+        }
+
+        SUBCASE("lost packet leaves zero-filled lines and is reported") {
+                RtpPayloadRawVideo::FrameAssembly asmb;
+                asmb.begin(plane, rx.wireLineCount(), rx.wireBytesPerLine());
+                for (size_t i = 0; i < packets.size(); i++) {
+                        if (i != 1) rx.unpackInto(packets[i], asmb);
+                }
+                Buffer out = asmb.finish();
+                CHECK_FALSE(asmb.isComplete());
+                CHECK(asmb.missingLines() > 0);
+                CHECK(asmb.completeLines() + asmb.missingLines() == 32);
+
+                RtpPacket::List partial;
+                for (size_t i = 0; i < packets.size(); i++) {
+                        if (i != 1) partial.pushToBack(packets[i]);
+                }
+                Buffer ref = rx.unpack(partial);
+                CHECK(std::memcmp(out.data(), ref.data(), bytes) == 0);
+
+                // None of the 0x5A fill survives — every unreceived
+                // byte was zeroed, every received byte came from src.
+                const uint8_t *o = static_cast<const uint8_t *>(out.data());
+                for (size_t line = 0; line < 32; line++) {
+                        const uint8_t *row = o + line * rx.wireBytesPerLine();
+                        if (asmb.isLineComplete(line)) {
+                                CHECK(std::memcmp(row, src + line * rx.wireBytesPerLine(),
+                                                  rx.wireBytesPerLine()) == 0);
+                        }
+                        for (size_t b = 0; b < rx.wireBytesPerLine(); b++) REQUIRE(row[b] != 0x5A);
+                }
+        }
+
+        SUBCASE("gap inside a line is zeroed before later fragments land") {
+                RtpPayloadRawVideo::FrameAssembly asmb;
+                asmb.begin(plane, 4, 16);
+                const uint8_t a[4] = {1, 2, 3, 4};
+                asmb.write(2, 0, a, 4);
+                asmb.write(2, 8, a, 4);
+                CHECK_FALSE(asmb.isLineComplete(2));
+                Buffer         out = asmb.finish();
+                const uint8_t *row = static_cast<const uint8_t *>(out.data()) + 2 * 16;
+                const uint8_t  expect[16] = {1, 2, 3, 4, 0, 0, 0, 0, 1, 2, 3, 4, 0, 0, 0, 0};
+                CHECK(std::memcmp(row, expect, 16) == 0);
+                CHECK(asmb.missingLines() == 4);
+                CHECK(asmb.coverage().size() == 1);
+                CHECK(asmb.coverage()[0] == 0);
+        }
+}
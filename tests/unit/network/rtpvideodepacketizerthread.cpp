@@ -14,6 +14,7 @@
 #include <promeki/clockdomain.h>
 #include <promeki/duration.h>
 #include <promeki/imagedesc.h>
+#include <promeki/list.h>
 #include <promeki/pixelformat.h>
 #include <promeki/queue.h>
 #include <promeki/rtppacket.h>
@@ -21,6 +22,7 @@
 #include <promeki/rtppayloadrawvideo.h>
 #include <promeki/rtpvideodepacketizerthread.h>
 #include <promeki/timestamp.h>
+#include <promeki/uncompressedvideopayload.h>
 
 using namespace promeki;
 
@@ -70,6 +72,8 @@ struct Harness {
         Atomic<int64_t>     framesDroppedValidate;
         Atomic<int64_t>     framesWaitingParamSets;
         Atomic<int64_t>     framesDroppedSsrcReset;
+        Atomic<int64_t>     framesIncomplete;
+        Atomic<int64_t>     linesMissing;
         int                 noteFrameCalls = 0;
 
         RtpVideoDepacketizerContext makeCtx(RtpPayload *payload,
@@ -89,6 +93,8 @@ struct Harness {
                 ctx.framesDroppedValidate = &framesDroppedValidate;
                 ctx.framesWaitingParamSets = &framesWaitingParamSets;
                 ctx.framesDroppedSsrcReset = &framesDroppedSsrcReset;
+                ctx.framesIncomplete = &framesIncomplete;
+                ctx.linesMissing = &linesMissing;
                 ctx.noteFrameReceived = [this]() { ++noteFrameCalls; };
                 return ctx;
         }
@@ -264,3 +270,47 @@ TEST_CASE("RtpVideoDepacketizerThread: inactive stream drops packets without emi
         CHECK(h.payloadQ.size() == 0u);
         CHECK(h.packetsReceived.value() == 0);
 }
+
+TEST_CASE("RtpVideoDepacketizerThread: raw video lands in the allocated plane") {
+        Harness            h;
+        RtpPayloadRawVideo payload(64, 36, 24);
+        ImageDesc          idesc;
+        idesc.setSize(Size2Du32(64, 36));
+        idesc.setPixelFormat(PixelFormat::RGB8_sRGB);
+
+        List<Buffer>                allocated;
+        RtpVideoDepacketizerContext ctx = h.makeCtx(&payload, &idesc);
+        ctx.allocatePlane = [&allocated](size_t bytes) {
+                Buffer b(bytes);
+                allocated.pushToBack(b);
+                return b;
+        };
+        RtpVideoDepacketizerThread depkt(std::move(ctx), String("RtpVidDepkt"), kVideoClockHz);
+
+        RtpPacket::List pkts = buildRawVideoPackets(64, 36, 24, 1000u, 0u);
+        REQUIRE(pkts.size() > 2);
+        for (size_t i = 0; i < pkts.size(); i++) depkt.handlePacketForTest(pkts[i]);
+
+        // Second frame loses a packet.
+        RtpPacket::List lossy = buildRawVideoPackets(64, 36, 24, 4000u, 100u);
+        for (size_t i = 0; i < lossy.size(); i++) {
+                if (i != 1) depkt.handlePacketForTest(lossy[i]);
+        }
+
+        REQUIRE(allocated.size() == 2u);
+        REQUIRE(h.payloadQ.size() == 2u);
+        for (size_t f = 0; f < 2; f++) {
+                Result<RxVideoFrame> r = h.payloadQ.tryPop();
+                REQUIRE(r.second().isOk());
+                UncompressedVideoPayload::Ptr uvp =
+                        sharedPointerCast<UncompressedVideoPayload>(r.first().payload);
+                REQUIRE(uvp.isValid());
+                // No reassembly copy: the emitted plane is the
+                // allocator's buffer.
+                CHECK(uvp->plane(0).buffer().impl() == allocated[f].impl());
+                CHECK(uvp->plane(0).size() == payload.frameSize());
+        }
+        CHECK(h.framesReassembled.value() == 2);
+        CHECK(h.framesIncomplete.value() == 1);
+        CHECK(h.linesMissing.value() > 0);
+}
@@ -8,7 +8,11 @@
 #include <doctest/doctest.h>
 #include <promeki/udpsocket.h>
 #include <promeki/buffer.h>
+#include <promeki/eventloop.h>
+#include <promeki/promise.h>
+#include <promeki/thread.h>
 #include <cstring>
+#include <memory>
 #include <unistd.h>
 
 using namespace promeki;
@@ -441,6 +445,261 @@ TEST_CASE("UdpSocket") {
                 }
         }
 
+        SUBCASE("writeDatagrams gathers segments") {
+                UdpSocket sender;
+                UdpSocket receiver;
+
+                sender.open(IODevice::ReadWrite);
+                receiver.open(IODevice::ReadWrite);
+                receiver.setReceiveTimeout(2000);
+                receiver.bind(SocketAddress::any(0));
+                uint16_t port = receiver.localAddress().port();
+
+                SocketAddress dest(Ipv4Address::loopback(), port);
+
+                const char header[] = "hdr:";
+                const char body[] = "payload-";
+                const char tail[] = "tail";
+                UdpSocket::Datagram d;
+                d.data = header;
+                d.size = std::strlen(header);
+                d.segments[0] = {body, std::strlen(body)};
+                d.segments[1] = {tail, std::strlen(tail)};
+                d.segmentCount = 2;
+                d.dest = dest;
+                CHECK(d.totalSize() == 16);
+                UdpSocket::DatagramList batch;
+                batch.pushToBack(d);
+
+                CHECK(sender.writeDatagrams(batch) == 1);
+                char    buf[64];
+                int64_t n = receiver.readDatagram(buf, sizeof(buf));
+                REQUIRE(n == 16);
+                CHECK(std::memcmp(buf, "hdr:payload-tail", 16) == 0);
+        }
+
+        SUBCASE("writeDatagrams rejects too many segments") {
+                UdpSocket sender;
+                sender.open(IODevice::ReadWrite);
+                const char          byte = 'x';
+                UdpSocket::Datagram d;
+                d.data = &byte;
+                d.size = 1;
+                d.segmentCount = UdpSocket::Datagram::MaxSegments + 1;
+                d.dest = SocketAddress(Ipv4Address::loopback(), 9);
+                UdpSocket::DatagramList batch;
+                batch.pushToBack(d);
+                CHECK(sender.writeDatagrams(batch) == -1);
+        }
+
+        SUBCASE("zero-copy send releases owners on completion") {
+                UdpSocket sender;
+                UdpSocket receiver;
+
+                sender.open(IODevice::ReadWrite);
+                receiver.open(IODevice::ReadWrite);
+                receiver.setReceiveTimeout(2000);
+                receiver.bind(SocketAddress::any(0));
+                uint16_t port = receiver.localAddress().port();
+
+                CHECK_FALSE(sender.isZeroCopy());
+                Error err = sender.setZeroCopy(true);
+                // Kernels before 5.0 (and non-Linux hosts) do not do
+                // UDP zero-copy; nothing else to check there.
+                if (err.isOk()) {
+                        CHECK(sender.isZeroCopy());
+                        Buffer owner(256);
+                        owner.setSize(256);
+                        std::memset(owner.data(), 0x5A, owner.size());
+
+                        UdpSocket::Datagram d;
+                        d.data = owner.data();
+                        d.size = owner.size();
+                        d.dataOwner = owner;
+                        d.dest = SocketAddress(Ipv4Address::loopback(), port);
+                        UdpSocket::DatagramList batch;
+                        batch.pushToBack(d);
+                        d.dataOwner = Buffer();
+
+                        CHECK(sender.writeDatagrams(batch) == 1);
+                        batch.clear();
+
+                        char    buf[512];
+                        int64_t n = receiver.readDatagram(buf, sizeof(buf));
+                        CHECK(n == 256);
+
+                        // The completion is posted asynchronously;
+                        // poll for it rather than assuming it is
+                        // already queued.
+                        for (int i = 0; i < 200 && sender.pendingZeroCopy() > 0; i++) {
+                                sender.reapZeroCopyCompletions();
+                                if (sender.pendingZeroCopy() > 0) usleep(5000);
+                        }
+                        CHECK(sender.pendingZeroCopy() == 0);
+                        CHECK(sender.zeroCopyStats().sent + sender.zeroCopyStats().fallbacks >= 1);
+                        CHECK(owner.isExclusive());
+                }
+        }
+
+        SUBCASE("zero-copy needs an owner for every segment") {
+                UdpSocket sender;
+                UdpSocket receiver;
+
+                sender.open(IODevice::ReadWrite);
+                receiver.open(IODevice::ReadWrite);
+                receiver.setReceiveTimeout(2000);
+                receiver.bind(SocketAddress::any(0));
+                uint16_t port = receiver.localAddress().port();
+
+                if (sender.setZeroCopy(true).isOk()) {
+                        Buffer header(16);
+                        header.setSize(16);
+                        std::memset(header.data(), 0x11, header.size());
+                        Buffer payload(256);
+                        payload.setSize(256);
+                        std::memset(payload.data(), 0x22, payload.size());
+
+                        UdpSocket::Datagram d;
+                        d.data = header.data();
+                        d.size = header.size();
+                        d.segments[0].data = payload.data();
+                        d.segments[0].size = payload.size();
+                        d.segmentCount = 1;
+                        d.dataOwner = header;
+                        d.dest = SocketAddress(Ipv4Address::loopback(), port);
+                        UdpSocket::DatagramList batch;
+                        batch.pushToBack(d);
+
+                        // The payload iov has no owner, so the batch is
+                        // copied and nothing stays pinned.
+                        CHECK(sender.writeDatagrams(batch) == 1);
+                        CHECK(sender.zeroCopyStats().sent == 0);
+                        CHECK(sender.pendingZeroCopy() == 0);
+                        char buf[512];
+                        CHECK(receiver.readDatagram(buf, sizeof(buf)) == 272);
+
+                        // With the segment owned, the payload is pinned
+                        // alongside the header until completion.
+                        batch[0].segments[0].owner = payload;
+                        CHECK(sender.writeDatagrams(batch) == 1);
+                        batch.clear();
+                        d = UdpSocket::Datagram();
+                        CHECK(receiver.readDatagram(buf, sizeof(buf)) == 272);
+                        for (int i = 0; i < 200 && sender.pendingZeroCopy() > 0; i++) {
+                                sender.reapZeroCopyCompletions();
+                                if (sender.pendingZeroCopy() > 0) usleep(5000);
+                        }
+                        CHECK(sender.pendingZeroCopy() == 0);
+                        CHECK(header.isExclusive());
+                        CHECK(payload.isExclusive());
+                }
+        }
+
+        SUBCASE("zero-copy completions are reaped by the event loop") {
+                UdpSocket receiver;
+                receiver.open(IODevice::ReadWrite);
+                receiver.setReceiveTimeout(2000);
+                receiver.bind(SocketAddress::any(0));
+                const uint16_t port = receiver.localAddress().port();
+
+                // The sender lives on a thread running its event loop,
+                // and nothing sends or reaps after the one datagram.
+                Thread thread;
+                thread.start();
+                auto runOnThread = [&thread](Function<Error()> func) {
+                        auto          promise = std::make_shared<Promise<Error>>();
+                        Future<Error> future = promise->future();
+                        thread.threadEventLoop()->postCallable([promise, func]() { promise->setValue(func()); });
+                        return future.result().first();
+                };
+
+                Buffer owner(256);
+                owner.setSize(256);
+                std::memset(owner.data(), 0x3C, owner.size());
+                UdpSocket *sender = nullptr;
+                Error      err = runOnThread([&]() {
+                        sender = new UdpSocket();
+                        sender->open(IODevice::ReadWrite);
+                        Error e = sender->setZeroCopy(true);
+                        if (e.isError()) return e;
+                        UdpSocket::DatagramList batch;
+                        UdpSocket::Datagram     d;
+                        d.data = owner.data();
+                        d.size = owner.size();
+                        d.dataOwner = owner;
+                        d.dest = SocketAddress(Ipv4Address::loopback(), port);
+                        batch.pushToBack(d);
+                        return sender->writeDatagrams(batch) == 1 ? Error(Error::Ok) : Error(Error::IOError);
+                });
+                if (err.isOk()) {
+                        char buf[512];
+                        CHECK(receiver.readDatagram(buf, sizeof(buf)) == 256);
+                        for (int i = 0; i < 200 && sender->pendingZeroCopy() > 0; i++) usleep(5000);
+                        CHECK(sender->pendingZeroCopy() == 0);
+                        CHECK(owner.isExclusive());
+                }
+                runOnThread([&]() {
+                        delete sender;
+                        return Error(Error::Ok);
+                });
+                thread.quit();
+                thread.wait();
+        }
+
+        SUBCASE("readDatagrams batch loopback") {
+                UdpSocket sender;
+                UdpSocket receiver;
+
+                sender.open(IODevice::ReadWrite);
+                receiver.open(IODevice::ReadWrite);
+                receiver.setReceiveTimeout(2000);
+                receiver.bind(SocketAddress::any(0));
+                uint16_t port = receiver.localAddress().port();
+
+                SocketAddress dest(Ipv4Address::loopback(), port);
+                for (int i = 0; i < 5; i++) {
+                        char msg[32];
+                        int  len = std::snprintf(msg, sizeof(msg), "rxbatch %d", i);
+                        REQUIRE(sender.writeDatagram(msg, len, dest) == len);
+                }
+
+                // Slots are larger than the batch; loopback delivery is
+                // synchronous so all five are queued before the read.
+                char                        bufs[8][64];
+                UdpSocket::RecvDatagramList slots;
+                for (int i = 0; i < 8; i++) {
+                        UdpSocket::RecvDatagram d;
+                        d.data = bufs[i];
+                        d.maxSize = sizeof(bufs[i]);
+                        slots.pushToBack(d);
+                }
+                int got = receiver.readDatagrams(slots, true);
+                REQUIRE(got >= 1);
+                int total = got;
+                for (int i = 0; i < got; i++) {
+                        char expected[32];
+                        int  elen = std::snprintf(expected, sizeof(expected), "rxbatch %d", i);
+                        CHECK(slots[i].size == static_cast<size_t>(elen));
+                        CHECK(std::memcmp(bufs[i], expected, elen) == 0);
+                        CHECK(slots[i].sender.isLoopback());
+                }
+                // Drain anything a platform without recvmmsg() left behind.
+                while (total < 5) {
+                        int more = receiver.readDatagram(bufs[0], sizeof(bufs[0]));
+                        REQUIRE(more > 0);
+                        total++;
+                }
+                CHECK(total == 5);
+        }
+
+        SUBCASE("readDatagrams empty list and closed socket") {
+                UdpSocket                   sock;
+                UdpSocket::RecvDatagramList slots;
+                CHECK(sock.readDatagrams(slots) == -1);
+                sock.open(IODevice::ReadWrite);
+                CHECK(sock.readDatagrams(slots) == 0);
+        }
+
         SUBCASE("writeDatagrams empty list") {
                 UdpSocket sock;
                 sock.open(IODevice::ReadWrite);
@@ -136,6 +136,51 @@ TEST_CASE("UdpSocketTransport") {
                 CHECK(sender.isLoopback());
         }
 
+        SUBCASE("receivePackets loopback") {
+                UdpSocketTransport a;
+                UdpSocketTransport b;
+                a.open();
+                b.setLocalAddress(SocketAddress::any(0));
+                b.open();
+                uint16_t      port = b.socket()->localAddress().port();
+                SocketAddress dest(Ipv4Address::loopback(), port);
+
+                const char *msgs[3] = {"one", "two", "three"};
+                for (const char *m : msgs) {
+                        REQUIRE(a.sendPacket(m, std::strlen(m), dest) == static_cast<ssize_t>(std::strlen(m)));
+                }
+
+                b.socket()->setReceiveTimeout(2000);
+                char                              bufs[4][64];
+                PacketTransport::RecvDatagramList slots;
+                for (int i = 0; i < 4; i++) {
+                        PacketTransport::RecvDatagram d;
+                        d.data = bufs[i];
+                        d.maxSize = sizeof(bufs[i]);
+                        slots.pushToBack(d);
+                }
+                int received = 0;
+                while (received < 3) {
+                        int got = b.receivePackets(slots, true);
+                        REQUIRE(got > 0);
+                        for (int i = 0; i < got; i++) {
+                                const char *expected = msgs[received + i];
+                                CHECK(slots[i].size == std::strlen(expected));
+                                CHECK(std::memcmp(bufs[i], expected, slots[i].size) == 0);
+                                CHECK(slots[i].sender.isLoopback());
+                        }
+                        received += got;
+                }
+                CHECK(received == 3);
+        }
+
+        SUBCASE("receivePackets on closed transport fails") {
+                UdpSocketTransport                t;
+                PacketTransport::RecvDatagramList slots;
+                slots.resize(1);
+                CHECK(t.receivePackets(slots) == -1);
+        }
+
         SUBCASE("setDscp applied at open") {
                 UdpSocketTransport t;
                 t.setDscp(46); // EF
@@ -1252,6 +1252,101 @@ TEST_CASE("QuickTimeWriter: fragmented layout round-trip (video + audio)") {
         std::remove(tmp.cstr());
 }
 
+TEST_CASE("QuickTime: read-ahead serves forward, reverse and seeking reads") {
+        const String tmp = "/tmp/qt_reader_readahead.mov";
+        std::remove(tmp.cstr());
+
+        const AudioDesc adesc(AudioFormat::PCMI_S16LE, 48000.0f, 2);
+        const size_t    samplesPerFrame = 2000;
+        const size_t    audioBytesPerFrame = samplesPerFrame * 4;
+        const int       frames = 24;
+
+        {
+                QuickTime qt = QuickTime::createWriter(tmp);
+                REQUIRE(qt.setLayout(QuickTime::LayoutClassic) == Error::Ok);
+                REQUIRE(qt.open() == Error::Ok);
+                uint32_t vid = 0, aid = 0;
+                REQUIRE(qt.addVideoTrack(PixelFormat(PixelFormat::YUV8_422_UYVY_Rec709), Size2Du32(16, 16),
+                                         FrameRate(FrameRate::RationalType(24, 1)), &vid) == Error::Ok);
+                REQUIRE(qt.addAudioTrack(adesc, &aid) == Error::Ok);
+                for (int f = 0; f < frames; ++f) {
+                        QuickTime::Sample vs;
+                        vs.data = makeFilledBuffer(512, static_cast<uint8_t>(0x20 + f));
+                        vs.duration = 1;
+                        vs.keyframe = true;
+                        REQUIRE(qt.writeSample(vid, vs) == Error::Ok);
+                        QuickTime::Sample as;
+                        as.data = makeFilledBuffer(audioBytesPerFrame, static_cast<uint8_t>(0x80 + f));
+                        as.keyframe = true;
+                        REQUIRE(qt.writeSample(aid, as) == Error::Ok);
+                }
+                REQUIRE(qt.finalize() == Error::Ok);
+        }
+
+        QuickTime qt = QuickTime::createReader(tmp);
+        REQUIRE(qt.open() == Error::Ok);
+        size_t videoIdx = SIZE_MAX, audioIdx = SIZE_MAX;
+        for (size_t i = 0; i < qt.tracks().size(); ++i) {
+                if (qt.tracks()[i].type() == QuickTime::Video) videoIdx = i;
+                if (qt.tracks()[i].type() == QuickTime::Audio) audioIdx = i;
+        }
+        REQUIRE(videoIdx != SIZE_MAX);
+        REQUIRE(audioIdx != SIZE_MAX);
+        REQUIRE(qt.setReadahead(8, 64 * 1024 * 1024) == Error::Ok);
+
+        // Reads one frame the way QuickTimeMediaIO does and checks
+        // both payloads carry that frame's fill byte.
+        auto readFrame = [&](int f) {
+                CAPTURE(f);
+                QuickTime::Sample vs;
+                REQUIRE(qt.readSample(videoIdx, static_cast<uint64_t>(f), vs) == Error::Ok);
+                REQUIRE(vs.data.size() == 512);
+                const uint8_t *v = static_cast<const uint8_t *>(vs.data.data());
+                CHECK(v[0] == 0x20 + f);
+                CHECK(v[511] == 0x20 + f);
+                QuickTime::Sample as;
+                REQUIRE(qt.readSampleRange(audioIdx, static_cast<uint64_t>(f) * samplesPerFrame, samplesPerFrame,
+                                           as) == Error::Ok);
+                REQUIRE(as.data.size() == audioBytesPerFrame);
+                const uint8_t *a = static_cast<const uint8_t *>(as.data.data());
+                CHECK(a[0] == 0x80 + f);
+                CHECK(a[audioBytesPerFrame - 1] == 0x80 + f);
+        };
+
+        for (int f = 0; f < frames; ++f) readFrame(f);
+        QuickTime::ReadaheadStats st = qt.readaheadStats();
+        CHECK(st.hits > st.misses);
+        // A window of frames per read, not one read per sample.
+        CHECK(st.reads > 0);
+        CHECK(st.reads < static_cast<uint64_t>(frames));
+        CHECK(st.cachedBytes > 0);
+        CHECK(st.cachedBytes <= 64u * 1024 * 1024);
+
+        // Reverse play is served the same way.
+        for (int f = frames - 1; f >= 0; --f) readFrame(f);
+        const uint64_t hitsBefore = st.hits;
+        st = qt.readaheadStats();
+        CHECK(st.hits > hitsBefore);
+
+        // Jumping out of the window, or an explicit invalidation,
+        // drops what was pending and still reads correctly.
+        const uint64_t invalidationsBefore = st.invalidations;
+        readFrame(20);
+        CHECK(qt.readaheadStats().invalidations == invalidationsBefore + 1);
+        qt.invalidateReadahead();
+        CHECK(qt.readaheadStats().cachedBytes == 0);
+        readFrame(3);
+
+        // Zero frames turns read-ahead off.
+        REQUIRE(qt.setReadahead(0, 0) == Error::Ok);
+        readFrame(4);
+        CHECK(qt.readaheadStats().hits == 0);
+        CHECK(qt.readaheadStats().misses == 0);
+
+        qt.close();
+        std::remove(tmp.cstr());
+}
+
 TEST_CASE("QuickTimeWriter: fragmented file is playable after simulated crash") {
         // Write a fragmented file with multiple complete fragments, then
         // truncate it mid-way through what would have been the next
@@ -174,6 +174,27 @@ TEST_CASE("SharedMemory: non-owner close leaves the name intact") {
         CHECK(static_cast<const uint8_t *>(reader2.data())[0] == 0x42);
 }
 
+TEST_CASE("SharedMemory: unlinkName keeps the mapping but frees the name") {
+        if (!SharedMemory::isSupported()) return;
+        String name = uniqueShmName("unlinkname");
+
+        SharedMemory owner;
+        REQUIRE(owner.create(name, 64).isOk());
+        static_cast<uint8_t *>(owner.data())[0] = 0x5A;
+        CHECK(owner.unlinkName().isOk());
+        CHECK_FALSE(owner.isOwner());
+        CHECK(owner.isValid());
+        CHECK(static_cast<const uint8_t *>(owner.data())[0] == 0x5A);
+
+        // The name is free again: a newcomer can create it, and the
+        // old instance's close must not unlink the newcomer's name.
+        SharedMemory newcomer;
+        REQUIRE(newcomer.create(name, 64).isOk());
+        owner.close();
+        SharedMemory probe;
+        CHECK(probe.open(name).isOk());
+}
+
 TEST_CASE("SharedMemory: destructor cleans up without explicit close") {
         if (!SharedMemory::isSupported()) return;
         String name = uniqueShmName("dtor");
@@ -6,6 +6,9 @@
  */
 
 #include <doctest/doctest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include <promeki/signal.h>
 #include <promeki/signal.tpp>
 #include <promeki/slot.h>
@@ -110,6 +113,15 @@ TEST_CASE("Signal_DisconnectByID") {
         CHECK(count == 1); // Should not have changed
 }
 
+TEST_CASE("Signal_IsConnected") {
+        Signal<int> sig;
+        CHECK_FALSE(sig.isConnected());
+        size_t id = sig.connect([](int) {});
+        CHECK(sig.isConnected());
+        sig.disconnect(id);
+        CHECK_FALSE(sig.isConnected());
+}
+
 TEST_CASE("Signal_DisconnectByID_StableAcrossOtherDisconnects") {
         Signal<int> sig;
         int         countA = 0, countB = 0, countC = 0;
@@ -227,6 +239,59 @@ TEST_CASE("Signal_EmitNoConnections") {
         CHECK(true);
 }
 
+// ============================================================================
+// Reentrancy and concurrent emit
+// ============================================================================
+
+TEST_CASE("Signal_SlotDisconnectsItselfDuringEmit") {
+        Signal<int> sig;
+        int         selfCount = 0;
+        int         otherCount = 0;
+        size_t      selfId = 0;
+        selfId = sig.connect([&](int) {
+                selfCount++;
+                sig.disconnect(selfId);
+                // Connected mid-emit: must not fire in this emit.
+                sig.connect([&](int) { otherCount++; });
+        });
+        sig.emit(0);
+        CHECK(selfCount == 1);
+        CHECK(otherCount == 0);
+        sig.emit(0);
+        CHECK(selfCount == 1);
+        CHECK(otherCount == 1);
+}
+
+TEST_CASE("Signal_ConcurrentEmitWithConnectDisconnect") {
+        // Emitters run against a signal whose slot list is being
+        // replaced underneath them.  The anchor slot is connected for
+        // the whole run, so every emit must reach it exactly once.
+        Signal<int>      sig;
+        std::atomic<int> anchorFires{0};
+        sig.connect([&anchorFires](int) { anchorFires.fetch_add(1, std::memory_order_relaxed); });
+
+        constexpr int            Emitters = 4;
+        constexpr int            EmitsPerThread = 20000;
+        std::atomic<bool>        stop{false};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Emitters; t++) {
+                threads.emplace_back([&sig] {
+                        for (int i = 0; i < EmitsPerThread; i++) sig.emit(i);
+                });
+        }
+        std::thread churn([&sig, &stop] {
+                while (!stop.load()) {
+                        size_t id = sig.connect([](int) {});
+                        sig.disconnect(id);
+                }
+        });
+        for (auto &t : threads) t.join();
+        stop.store(true);
+        churn.join();
+        CHECK(anchorFires.load() == Emitters * EmitsPerThread);
+        CHECK(sig.isConnected());
+}
+
 // ============================================================================
 // Slot construction
 // ============================================================================
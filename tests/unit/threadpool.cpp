@@ -319,3 +319,118 @@ TEST_CASE("ThreadPool: tagged inline-mode pool still records stats") {
         }
         CHECK(saw);
 }
+
+TEST_CASE("ThreadPool: post runs fire-and-forget tasks") {
+        ThreadPool       pool(2);
+        std::atomic<int> counter{0};
+        for (int i = 0; i < 50; i++) pool.post([&counter] { counter++; });
+        pool.waitForDone();
+        CHECK(counter == 50);
+}
+
+TEST_CASE("ThreadPool: post on an inline pool runs immediately") {
+        ThreadPool pool(0);
+        int        value = 0;
+        pool.post([&value] { value = 7; });
+        CHECK(value == 7);
+}
+
+TEST_CASE("ThreadPool: work-stealing scheduler") {
+        using Scheduler = ThreadPool::Scheduler;
+
+        SUBCASE("submit and post from outside the pool") {
+                ThreadPool pool(4, true, Scheduler::WorkStealing);
+                CHECK(pool.scheduler() == Scheduler::WorkStealing);
+                List<Future<int>> futures;
+                for (int i = 0; i < 100; i++) futures.pushToBack(pool.submit([i] { return i * 3; }));
+                std::atomic<int> posted{0};
+                for (int i = 0; i < 100; i++) pool.post([&posted] { posted++; });
+                for (int i = 0; i < 100; i++) {
+                        auto [val, err] = futures[i].result();
+                        CHECK(err == Error::Ok);
+                        CHECK(val == i * 3);
+                }
+                pool.waitForDone();
+                CHECK(posted == 100);
+                CHECK(pool.threadCount() <= 4);
+        }
+
+        SUBCASE("tasks fanned out from a worker are stolen by idle workers") {
+                ThreadPool       pool(4, false, Scheduler::WorkStealing);
+                std::atomic<int> done{0};
+                Mutex            idsMutex;
+                List<uint64_t>   ids;
+                pool.post([&] {
+                        // Queued on this worker's own deque; the other
+                        // three have to steal to help.
+                        for (int i = 0; i < 64; i++) {
+                                pool.post([&] {
+                                        BasicThread::sleepMs(1);
+                                        const uint64_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+                                        {
+                                                Mutex::Locker l(idsMutex);
+                                                if (!ids.contains(id)) ids.pushToBack(id);
+                                        }
+                                        done++;
+                                });
+                        }
+                });
+                pool.waitForDone();
+                CHECK(done == 64);
+                CHECK(ids.size() > 1);
+        }
+
+        SUBCASE("more tasks than a worker queue holds spill over") {
+                ThreadPool       pool(2, true, Scheduler::WorkStealing);
+                std::atomic<int> done{0};
+                pool.post([&] {
+                        for (int i = 0; i < 5000; i++) pool.post([&done] { done++; });
+                });
+                pool.waitForDone();
+                CHECK(done == 5000);
+        }
+
+        SUBCASE("per-tag stats still accumulate") {
+                ThreadPool          pool(2, true, Scheduler::WorkStealing);
+                ThreadPool::WorkTag tag("StealTag");
+                for (int i = 0; i < 10; i++) pool.post(tag, [] {});
+                pool.submit(tag, [] { return 0; }).result();
+                pool.waitForDone();
+                bool saw = false;
+                for (const auto &s : pool.snapshotWorkStats()) {
+                        if (s.name == "StealTag") {
+                                CHECK(s.count == 11);
+                                saw = true;
+                        }
+                }
+                CHECK(saw);
+        }
+
+        SUBCASE("clear drops queued tasks") {
+                ThreadPool       pool(1, true, Scheduler::WorkStealing);
+                std::atomic<int> ran{0};
+                Mutex            gate;
+                gate.lock();
+                pool.post([&] {
+                        Mutex::Locker l(gate);
+                        ran++;
+                });
+                BasicThread::sleepMs(20);
+                for (int i = 0; i < 10; i++) pool.post([&ran] { ran++; });
+                pool.clear();
+                gate.unlock();
+                pool.waitForDone();
+                CHECK(ran == 1);
+        }
+
+        SUBCASE("setThreadCount keeps queued work") {
+                ThreadPool       pool(2, true, Scheduler::WorkStealing);
+                std::atomic<int> done{0};
+                for (int i = 0; i < 20; i++) pool.post([&done] { done++; });
+                pool.setThreadCount(3);
+                for (int i = 0; i < 20; i++) pool.post([&done] { done++; });
+                pool.waitForDone();
+                CHECK(done == 40);
+                CHECK(pool.maxThreadCount() == 3);
+        }
+}
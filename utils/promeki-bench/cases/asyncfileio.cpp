@@ -0,0 +1,239 @@
+/**
+ * @file      asyncfileio.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref AsyncFileIO file-throughput benchmark cases for promeki-bench.
+ * A scratch file of @c aio.fileMiB MiB is created in the system temp
+ * directory and each iteration moves the whole file in
+ * @c aio.blockKiB KiB requests, submitted as one batch so the engine's
+ * queue depth is the only limit on requests in flight.
+ *
+ * - @c read_<engine>_qd<N> / @c write_<engine>_qd<N> — @c uring
+ *   (registered only where @ref AsyncFileIO::ioUringAvailable) and
+ *   @c pool, at queue depths 1, 2, 4, 8, 16, 32 and 64.
+ * - @c read_sync / @c write_sync — the blocking @ref File::read /
+ *   @ref File::write loop every reader uses today, as the baseline.
+ *
+ * With @c aio.direct the file is opened with @ref File::setDirectIO
+ * so the numbers reflect the device rather than the page cache; the
+ * label says @c buffered when the filesystem refused it (tmpfs, for
+ * one).  bytes/sec is file throughput; items/sec is requests/sec.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key            | Type | Default | Description                         |
+ * |----------------|------|---------|-------------------------------------|
+ * | `aio.fileMiB`  | int  | 64      | Scratch file size in MiB            |
+ * | `aio.blockKiB` | int  | 64      | Bytes per request in KiB            |
+ * | `aio.direct`   | bool | true    | Open the scratch file with O_DIRECT |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <promeki/asyncfileio.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/bufferpool.h>
+#include <promeki/dir.h>
+#include <promeki/file.h>
+#include <promeki/list.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? n : 1;
+                }
+
+                String scratchPath() { return (Dir::temp().path() / "promeki-bench-aio.dat").toString(); }
+
+                // The scratch file and the request geometry shared by
+                // every case.  Opened per case so each starts from the
+                // same state.
+                struct Scratch {
+                                File       file;
+                                BufferPool pool;
+                                size_t     block = 0;
+                                int64_t    blocks = 0;
+                                bool       direct = false;
+
+                                Scratch() : file(scratchPath()) {}
+                };
+
+                bool openScratch(Scratch &s) {
+                        const int64_t fileBytes = static_cast<int64_t>(paramInt("aio.fileMiB", 64)) << 20;
+                        s.block = static_cast<size_t>(paramInt("aio.blockKiB", 64)) << 10;
+                        s.blocks = fileBytes / static_cast<int64_t>(s.block);
+                        if (s.blocks < 1) s.blocks = 1;
+                        if (s.file.open(IODevice::ReadWrite, File::Create).isError()) return false;
+
+                        size_t align = 4096;
+                        if (benchParams().getBool(String("aio.direct"), true) && s.file.setDirectIO(true).isOk()) {
+                                s.direct = true;
+                                auto [a, err] = s.file.directIOAlignment();
+                                if (err.isOk() && a > align) align = a;
+                        }
+                        s.pool = BufferPool(s.block, align);
+
+                        // Fill the file once, synchronously, so reads hit
+                        // real extents rather than holes.
+                        const int64_t want = s.blocks * static_cast<int64_t>(s.block);
+                        auto [have, sizeErr] = s.file.size();
+                        if (sizeErr.isError() || have < want) {
+                                Buffer fill = s.pool.acquire();
+                                std::memset(fill.data(), 0xA5, s.block);
+                                s.file.seek(0);
+                                for (int64_t b = 0; b < s.blocks; b++) s.file.write(fill.data(), s.block);
+                        }
+                        return true;
+                }
+
+                void closeScratch(Scratch &s) {
+                        s.file.close();
+                        std::remove(scratchPath().cstr());
+                        return;
+                }
+
+                void finishState(BenchmarkState &state, const Scratch &s, const String &what) {
+                        state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(s.blocks));
+                        state.setBytesProcessed(state.iterations() * static_cast<uint64_t>(s.blocks) * s.block);
+                        state.setLabel(what + ", " + String::number(s.block >> 10) + " KiB blocks, " +
+                                       (s.direct ? String("direct") : String("buffered")));
+                        return;
+                }
+
+                void benchAsync(BenchmarkState &state, AsyncFileIO::Engine engine, AsyncFileIO::Op op,
+                                unsigned int depth) {
+                        Scratch s;
+                        if (!openScratch(s)) return;
+                        AsyncFileIO aio(depth, engine);
+                        aio.registerFile(s.file);
+
+                        // One buffer per block, acquired up front so the
+                        // timed loop measures I/O rather than allocation.
+                        List<Buffer> bufs;
+                        for (int64_t b = 0; b < s.blocks; b++) {
+                                bufs.pushToBack(s.pool.acquire());
+                                std::memset(bufs.back().data(), 0x5A, s.block);
+                        }
+
+                        for (auto _ : state) {
+                                (void)_;
+                                List<AsyncFileIO::Request> batch;
+                                batch.reserve(static_cast<size_t>(s.blocks));
+                                for (int64_t b = 0; b < s.blocks; b++) {
+                                        AsyncFileIO::Request req;
+                                        req.op = op;
+                                        req.handle = s.file.handle();
+                                        req.offset = b * static_cast<int64_t>(s.block);
+                                        req.keep = bufs[static_cast<size_t>(b)];
+                                        req.data = req.keep.data();
+                                        req.size = s.block;
+                                        batch.pushToBack(std::move(req));
+                                }
+                                aio.submit(std::move(batch));
+                                aio.waitForIdle();
+                        }
+
+                        aio.unregisterFile(s.file);
+                        state.setCounter(String("queue_depth"), static_cast<double>(depth));
+                        finishState(state, s, String("qd ") + String::number(depth));
+                        closeScratch(s);
+                }
+
+                void benchSync(BenchmarkState &state, AsyncFileIO::Op op) {
+                        Scratch s;
+                        if (!openScratch(s)) return;
+                        Buffer buf = s.pool.acquire();
+                        std::memset(buf.data(), 0x5A, s.block);
+
+                        for (auto _ : state) {
+                                (void)_;
+                                s.file.seek(0);
+                                for (int64_t b = 0; b < s.blocks; b++) {
+                                        if (op == AsyncFileIO::Op::Read) s.file.read(buf.data(), s.block);
+                                        else s.file.write(buf.data(), s.block);
+                                }
+                        }
+
+                        finishState(state, s, String("blocking File"));
+                        closeScratch(s);
+                }
+
+        } // namespace
+
+        void registerAsyncFileIOCases() {
+                struct EngineName {
+                                AsyncFileIO::Engine engine;
+                                const char         *name;
+                };
+                List<EngineName> engines;
+                if (AsyncFileIO::ioUringAvailable()) engines.pushToBack({AsyncFileIO::Engine::IoUring, "uring"});
+                engines.pushToBack({AsyncFileIO::Engine::ThreadPool, "pool"});
+
+                for (AsyncFileIO::Op op : {AsyncFileIO::Op::Read, AsyncFileIO::Op::Write}) {
+                        const String dir = op == AsyncFileIO::Op::Read ? String("read") : String("write");
+                        for (const EngineName &e : engines) {
+                                for (unsigned int depth : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+                                        const AsyncFileIO::Engine engine = e.engine;
+                                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                                String("aio"),
+                                                dir + "_" + e.name + "_qd" + String::number(depth),
+                                                String("AsyncFileIO whole-file ") + dir + " at a fixed queue depth",
+                                                [engine, op, depth](BenchmarkState &state) {
+                                                        benchAsync(state, engine, op, depth);
+                                                }));
+                                }
+                        }
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("aio"), dir + "_sync", String("Blocking File whole-file ") + dir + " baseline",
+                                [op](BenchmarkState &state) { benchSync(state, op); }));
+                }
+        }
+
+        String asyncFileIOParamHelp() {
+                return String("aio suite parameters:\n"
+                              "  aio.fileMiB=<int>    Scratch file size in MiB (default: 64)\n"
+                              "  aio.blockKiB=<int>   Bytes per request in KiB (default: 64)\n"
+                              "  aio.direct=<bool>    Open the scratch file with direct I/O (default: true)\n"
+                              "\n"
+                              "  Cases are named <read|write>_<uring|pool>_qd<n> for queue depths 1-64,\n"
+                              "  plus <read|write>_sync for the blocking File baseline.  uring cases are\n"
+                              "  only registered when the kernel provides io_uring.  The scratch file\n"
+                              "  lives in Dir::temp(); set PROMEKI_OPT_TempDir to test another device.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerAsyncFileIOCases() {
+                // core disabled — nothing to register.
+        }
+
+        String asyncFileIOParamHelp() {
+                return String("aio suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -0,0 +1,295 @@
+/**
+ * @file      audioformat.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref AudioFormat sample conversion benchmark cases for promeki-bench.
+ * Every case runs once with the SIMD kernels and once with the scalar
+ * reference (@ref AudioFormat::setSimdEnabled), named
+ * @c <case>_simd / @c <case>_scalar, so the speedup can be read off
+ * side by side.  items/sec is samples per second (total samples, not
+ * frames); bytes/sec counts the source bytes.
+ *
+ * - @c decode_<fmt> — @ref AudioFormat::samplesToFloat for every
+ *   interleaved PCM format.
+ * - @c encode_<fmt> — @ref AudioFormat::floatToSamples for every
+ *   interleaved PCM format.
+ * - @c direct_<src>_<dst> — a registered direct converter.  A
+ *   representative set of pairs by default; every registered
+ *   interleaved pair with @c audioformat.all.
+ * - @c convert_<src>_<dst> — @ref AudioFormat::convertTo through the
+ *   via-float scratch path, including planar ↔ interleaved transposes
+ *   over @c audioformat.channels channels.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key                    | Type | Default | Description                               |
+ * |------------------------|------|---------|-------------------------------------------|
+ * | `audioformat.samples`  | int  | 16384   | Samples converted per iteration           |
+ * | `audioformat.channels` | int  | 2       | Channels for the layout-changing cases    |
+ * | `audioformat.all`      | flag | off     | Register every interleaved direct pair    |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_PROAV
+
+#include <cstdint>
+
+#include <promeki/audioformat.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                size_t paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? static_cast<size_t>(n) : 1;
+                }
+
+                List<float> makeFloats(size_t samples) {
+                        List<float> f(samples, 0.0f);
+                        uint32_t    state = 0x2545F491u;
+                        for (size_t i = 0; i < samples; ++i) {
+                                state = state * 1664525u + 1013904223u;
+                                f[i] = static_cast<float>(static_cast<int32_t>(state)) / 2147483648.0f;
+                        }
+                        return f;
+                }
+
+                // Deterministic source data: random bytes for integer
+                // formats, normalized floats for float formats so the
+                // conversions see ordinary sample values.
+                List<uint8_t> makeSource(const AudioFormat &fmt, size_t samples) {
+                        List<uint8_t> buf(samples * fmt.bytesPerSample(), 0);
+                        uint32_t      state = 0x9E3779B9u;
+                        for (size_t i = 0; i < buf.size(); ++i) {
+                                state = state * 1664525u + 1013904223u;
+                                buf[i] = static_cast<uint8_t>(state >> 24);
+                        }
+                        if (fmt.isFloat()) {
+                                List<float> f = makeFloats(samples);
+                                fmt.floatToSamples(buf.data(), f.data(), samples);
+                        }
+                        return buf;
+                }
+
+                // Runs @p body under the requested kernel selection and
+                // restores the default afterwards.
+                template <typename Body> void withSimd(bool simd, Body &&body) {
+                        AudioFormat::setSimdEnabled(simd);
+                        body();
+                        AudioFormat::setSimdEnabled(true);
+                        return;
+                }
+
+                void benchDecode(BenchmarkState &state, AudioFormat fmt, bool simd) {
+                        const size_t        samples = paramInt("audioformat.samples", 16384);
+                        const List<uint8_t> src = makeSource(fmt, samples);
+                        List<float>         dst(samples, 0.0f);
+                        withSimd(simd, [&] {
+                                for (auto _ : state) {
+                                        (void)_;
+                                        fmt.samplesToFloat(dst.data(), src.data(), samples);
+                                }
+                        });
+                        state.setItemsProcessed(state.iterations() * samples);
+                        state.setBytesProcessed(state.iterations() * samples * fmt.bytesPerSample());
+                        return;
+                }
+
+                void benchEncode(BenchmarkState &state, AudioFormat fmt, bool simd) {
+                        const size_t      samples = paramInt("audioformat.samples", 16384);
+                        const List<float> src = makeFloats(samples);
+                        List<uint8_t>     dst(samples * fmt.bytesPerSample(), 0);
+                        withSimd(simd, [&] {
+                                for (auto _ : state) {
+                                        (void)_;
+                                        fmt.floatToSamples(dst.data(), src.data(), samples);
+                                }
+                        });
+                        state.setItemsProcessed(state.iterations() * samples);
+                        state.setBytesProcessed(state.iterations() * samples * sizeof(float));
+                        return;
+                }
+
+                void benchDirect(BenchmarkState &state, AudioFormat src, AudioFormat dst, bool simd) {
+                        const size_t        samples = paramInt("audioformat.samples", 16384);
+                        const List<uint8_t> in = makeSource(src, samples);
+                        List<uint8_t>       out(samples * dst.bytesPerSample(), 0);
+                        withSimd(simd, [&] {
+                                AudioFormat::DirectConvertFn fn = AudioFormat::directConverter(src.id(), dst.id());
+                                for (auto _ : state) {
+                                        (void)_;
+                                        fn(out.data(), in.data(), samples);
+                                }
+                        });
+                        state.setItemsProcessed(state.iterations() * samples);
+                        state.setBytesProcessed(state.iterations() * samples * src.bytesPerSample());
+                        return;
+                }
+
+                void benchConvert(BenchmarkState &state, AudioFormat src, AudioFormat dst, bool simd) {
+                        const size_t        channels = paramInt("audioformat.channels", 2);
+                        size_t              spc = paramInt("audioformat.samples", 16384) / channels;
+                        if (spc == 0) spc = 1;
+                        const size_t        samples = spc * channels;
+                        const List<uint8_t> in = makeSource(src, samples);
+                        List<uint8_t>       out(samples * dst.bytesPerSample(), 0);
+                        List<float>         scratch(samples, 0.0f);
+                        Error               err;
+                        withSimd(simd, [&] {
+                                for (auto _ : state) {
+                                        (void)_;
+                                        err = src.convertTo(dst, out.data(), in.data(), spc, channels, scratch.data());
+                                }
+                        });
+                        if (err.isError()) state.setLabel(String("error: ") + err.name());
+                        state.setItemsProcessed(state.iterations() * samples);
+                        state.setBytesProcessed(state.iterations() * samples * src.bytesPerSample());
+                        return;
+                }
+
+                String caseName(const char *kind, const AudioFormat &a, const AudioFormat *b, bool simd) {
+                        String name = String(kind) + "_" + a.name();
+                        if (b != nullptr) name += String("_") + b->name();
+                        name += simd ? "_simd" : "_scalar";
+                        return name;
+                }
+
+                void registerBoth(const char *kind, const AudioFormat &a, const AudioFormat *b, const String &desc,
+                                  void (*fn)(BenchmarkState &, AudioFormat, AudioFormat, bool)) {
+                        const AudioFormat second = b != nullptr ? *b : AudioFormat();
+                        for (bool simd : {true, false}) {
+                                BenchmarkCase c(String("audioformat"), caseName(kind, a, b, simd),
+                                                desc + (simd ? ", SIMD" : ", scalar"),
+                                                [a, second, simd, fn](BenchmarkState &state) {
+                                                        fn(state, a, second, simd);
+                                                });
+                                BenchmarkRunner::registerCase(c);
+                        }
+                        return;
+                }
+
+                void decodeThunk(BenchmarkState &state, AudioFormat a, AudioFormat, bool simd) {
+                        benchDecode(state, a, simd);
+                        return;
+                }
+
+                void encodeThunk(BenchmarkState &state, AudioFormat a, AudioFormat, bool simd) {
+                        benchEncode(state, a, simd);
+                        return;
+                }
+
+                List<AudioFormat> interleavedPcmFormats() {
+                        List<AudioFormat> ret;
+                        for (AudioFormat::ID id : AudioFormat::registeredIDs()) {
+                                AudioFormat f(id);
+                                if (!f.isValid() || f.isCompressed() || f.isPlanar()) continue;
+                                if (f.bytesPerSample() == 0 || id >= AudioFormat::UserDefined) continue;
+                                ret.pushToBack(f);
+                        }
+                        return ret;
+                }
+
+        } // namespace
+
+        void registerAudioFormatCases() {
+                const List<AudioFormat> formats = interleavedPcmFormats();
+                for (const AudioFormat &f : formats) {
+                        registerBoth("decode", f, nullptr, String("samplesToFloat ") + f.name(), decodeThunk);
+                        registerBoth("encode", f, nullptr, String("floatToSamples ") + f.name(), encodeThunk);
+                }
+
+                if (benchParams().contains(String("audioformat.all"))) {
+                        for (const AudioFormat &src : formats) {
+                                for (const AudioFormat &dst : formats) {
+                                        if (src.id() == dst.id()) continue;
+                                        if (AudioFormat::directConverter(src.id(), dst.id()) == nullptr) continue;
+                                        registerBoth("direct", src, &dst,
+                                                     String("Direct ") + src.name() + " -> " + dst.name(),
+                                                     benchDirect);
+                                }
+                        }
+                } else {
+                        const AudioFormat::ID direct[][2] = {
+                                {AudioFormat::PCMI_S8, AudioFormat::PCMI_U8},
+                                {AudioFormat::PCMI_S16LE, AudioFormat::PCMI_S16BE},
+                                {AudioFormat::PCMI_S16LE, AudioFormat::PCMI_U16LE},
+                                {AudioFormat::PCMI_S16LE, AudioFormat::PCMI_U16BE},
+                                {AudioFormat::PCMI_S24LE, AudioFormat::PCMI_S24BE},
+                                {AudioFormat::PCMI_S24LE, AudioFormat::PCMI_U24LE},
+                                {AudioFormat::PCMI_S24LE, AudioFormat::PCMI_S24LE_HB32},
+                                {AudioFormat::PCMI_S24LE_HB32, AudioFormat::PCMI_S24LE},
+                                {AudioFormat::PCMI_S24LE_HB32, AudioFormat::PCMI_S24LE_LB32},
+                                {AudioFormat::PCMI_S32LE, AudioFormat::PCMI_S32BE},
+                                {AudioFormat::PCMI_S32LE, AudioFormat::PCMI_U32BE},
+                                {AudioFormat::PCMI_Float32LE, AudioFormat::PCMI_Float32BE},
+                        };
+                        for (const auto &p : direct) {
+                                const AudioFormat src(p[0]);
+                                const AudioFormat dst(p[1]);
+                                registerBoth("direct", src, &dst, String("Direct ") + src.name() + " -> " + dst.name(),
+                                             benchDirect);
+                        }
+                }
+
+                const AudioFormat::ID convert[][2] = {
+                        {AudioFormat::PCMI_S16LE, AudioFormat::PCMI_S24LE},
+                        {AudioFormat::PCMI_S24LE, AudioFormat::PCMI_S16LE},
+                        {AudioFormat::PCMI_S32LE, AudioFormat::PCMI_S16BE},
+                        {AudioFormat::PCMI_S24LE_HB32, AudioFormat::PCMI_Float32LE},
+                        {AudioFormat::PCMP_Float32LE, AudioFormat::PCMI_Float32LE},
+                        {AudioFormat::PCMI_S16LE, AudioFormat::PCMP_S16LE},
+                        {AudioFormat::PCMP_S16LE, AudioFormat::PCMI_S24LE},
+                        {AudioFormat::PCMI_S24LE, AudioFormat::PCMP_Float32LE},
+                };
+                for (const auto &p : convert) {
+                        const AudioFormat src(p[0]);
+                        const AudioFormat dst(p[1]);
+                        registerBoth("convert", src, &dst, String("convertTo ") + src.name() + " -> " + dst.name(),
+                                     benchConvert);
+                }
+        }
+
+        String audioFormatParamHelp() {
+                String help("audioformat suite parameters:\n"
+                            "  audioformat.samples=<int>   Samples converted per iteration (default: 16384)\n"
+                            "  audioformat.channels=<int>  Channels for layout-changing cases (default: 2)\n"
+                            "  audioformat.all             Register every interleaved direct pair\n"
+                            "\n"
+                            "  Cases are named <case>_simd / <case>_scalar; items/sec is samples/sec.\n");
+                if (!AudioFormat::hasSimdKernels()) {
+                        help += "  (no SIMD kernels in this build — both variants run the scalar path)\n";
+                }
+                return help;
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_PROAV
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerAudioFormatCases() {
+                // proav disabled — nothing to register.
+        }
+
+        String audioFormatParamHelp() {
+                return String("audioformat suite parameters: (disabled — built without PROMEKI_ENABLE_PROAV)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_PROAV
@@ -75,5 +75,128 @@ namespace benchutil {
         /** @brief Returns per-suite help text for the ancrtp suite. */
         String ancRtpParamHelp();
 
+        /**
+ * @brief Registers ThreadPool submission latency / throughput cases.
+ *
+ * Reads `concurrency.threads`, `concurrency.producers` and
+ * `concurrency.tasks` from BenchParams.  Every case is registered once
+ * per ThreadPool::Scheduler.
+ */
+        void registerConcurrencyCases();
+
+        /** @brief Returns per-suite help text for the concurrency suite. */
+        String concurrencyParamHelp();
+
+        /**
+ * @brief Registers Signal emit throughput cases.
+ *
+ * Reads `signal.emitters` and `signal.emits` from BenchParams.  Emit
+ * cases are registered for 1, 2, 4 and 8 connected slots.
+ */
+        void registerSignalCases();
+
+        /** @brief Returns per-suite help text for the signal suite. */
+        String signalParamHelp();
+
+        /**
+ * @brief Registers VariantDatabase set / get / copy-on-write cases.
+ *
+ * Cases are registered for databases of 8, 16, 32 and 64 keys.
+ */
+        void registerVariantDatabaseCases();
+
+        /** @brief Returns per-suite help text for the variantdatabase suite. */
+        String variantDatabaseParamHelp();
+
+        /**
+ * @brief Registers CRC throughput cases, one per (CRC, engine) pair.
+ *
+ * Reads `crc.size` from BenchParams.  Engines the running CPU cannot
+ * use for a given CRC are not registered.
+ */
+        void registerCrcCases();
+
+        /** @brief Returns per-suite help text for the crc suite. */
+        String crcParamHelp();
+
+        /**
+ * @brief Registers FrameBridge latency / throughput cases.
+ *
+ * Reads `framebridge.width`, `framebridge.height`,
+ * `framebridge.images`, `framebridge.audio` and `framebridge.anc` from
+ * BenchParams.  Each case runs once over a single multi-essence bridge
+ * and once over one bridge per essence.
+ */
+        void registerFrameBridgeCases();
+
+        /** @brief Returns per-suite help text for the framebridge suite. */
+        String frameBridgeParamHelp();
+
+        /**
+ * @brief Registers MemPool allocator cases, one per (case, mode) pair.
+ *
+ * Reads `mempool.region`, `mempool.live` and `mempool.maxsize` from
+ * BenchParams.  The churn cases also report a fragmentation counter.
+ */
+        void registerMemPoolCases();
+
+        /** @brief Returns per-suite help text for the mempool suite. */
+        String memPoolParamHelp();
+
+        /**
+ * @brief Registers AudioFormat conversion cases, SIMD and scalar side by side.
+ *
+ * Reads `audioformat.samples`, `audioformat.channels` and
+ * `audioformat.all` from BenchParams.  items/sec is samples/sec.
+ */
+        void registerAudioFormatCases();
+
+        /** @brief Returns per-suite help text for the audioformat suite. */
+        String audioFormatParamHelp();
+
+        /**
+ * @brief Registers Logger call-site cases, deferred and eager side by side.
+ *
+ * Reads `logger.threads` and `logger.calls` from BenchParams.  The
+ * storm cases log from several threads at once; items/sec is calls/sec.
+ */
+        void registerLoggerCases();
+
+        /** @brief Returns per-suite help text for the logger suite. */
+        String loggerParamHelp();
+
+        /**
+ * @brief Registers PcapFlowRouter analysis cases at several thread counts.
+ *
+ * Reads `pcapflow.flows`, `pcapflow.frames` and `pcapflow.anc` from
+ * BenchParams.  items/sec is captured packets/sec.
+ */
+        void registerPcapFlowCases();
+
+        /** @brief Returns per-suite help text for the pcapflow suite. */
+        String pcapFlowParamHelp();
+
+        /**
+ * @brief Registers AsyncFileIO file-throughput cases at queue depths 1-64.
+ *
+ * Reads `aio.fileMiB`, `aio.blockKiB` and `aio.direct` from
+ * BenchParams.  bytes/sec is file throughput.
+ */
+        void registerAsyncFileIOCases();
+
+        /** @brief Returns per-suite help text for the aio suite. */
+        String asyncFileIOParamHelp();
+
+        /**
+ * @brief Registers HttpServer loopback load-test cases, single loop and reactors.
+ *
+ * Reads `http.clients`, `http.requests` and `http.slowMs` from
+ * BenchParams.  items/sec is requests/sec; p99 latency is a counter.
+ */
+        void registerHttpServerCases();
+
+        /** @brief Returns per-suite help text for the http suite. */
+        String httpServerParamHelp();
+
 } // namespace benchutil
 PROMEKI_NAMESPACE_END
@@ -0,0 +1,242 @@
+/**
+ * @file      concurrency.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref ThreadPool submission benchmark cases for promeki-bench.  Every
+ * case runs once per @ref ThreadPool::Scheduler so the shared-queue
+ * and work-stealing dispatchers can be compared side by side:
+ *
+ * - @c submit_latency — one producer submits a trivial task and waits
+ *   on its Future, one task per iteration.  Measures the full
+ *   submit → dispatch → complete round trip on an otherwise idle pool.
+ * - @c submit_contended / @c post_contended — several producer threads
+ *   hammer the pool at once (the many-strands-on-one-pool shape of a
+ *   long @c SharedThreadMediaIO pipeline).  Each iteration is one
+ *   burst of @c concurrency.tasks tasks split across the producers;
+ *   items/sec is task throughput.
+ * - @c post_fanout — a single task running on a worker posts the
+ *   whole burst from inside the pool, the path a @ref Strand takes
+ *   when it re-arms itself.  On a work-stealing pool those tasks stay
+ *   on the worker's own queue and are spread by stealing.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key                      | Type | Default            | Description                            |
+ * |--------------------------|------|--------------------|----------------------------------------|
+ * | `concurrency.threads`    | int  | ideal thread count | Worker threads per pool                |
+ * | `concurrency.producers`  | int  | 4                  | Submitting threads in contended cases  |
+ * | `concurrency.tasks`      | int  | 20000              | Tasks per measured burst               |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/string.h>
+#include <promeki/threadpool.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                using Scheduler = ThreadPool::Scheduler;
+
+                int paramThreads() {
+                        int ideal = static_cast<int>(BasicThread::idealThreadCount());
+                        if (ideal <= 0) ideal = 1;
+                        const int n = benchParams().getInt(String("concurrency.threads"), ideal);
+                        return n > 0 ? n : 1;
+                }
+
+                int paramProducers() {
+                        const int n = benchParams().getInt(String("concurrency.producers"), 4);
+                        return n > 0 ? n : 1;
+                }
+
+                int paramTasks() {
+                        const int n = benchParams().getInt(String("concurrency.tasks"), 20000);
+                        return n > 0 ? n : 1;
+                }
+
+                const char *schedulerName(Scheduler s) {
+                        return s == Scheduler::WorkStealing ? "work-stealing" : "shared queue";
+                }
+
+                // The task body every case queues.  Deliberately tiny so
+                // the numbers are dominated by queueing, not by work.
+                void touch(Atomic<int64_t> &counter) {
+                        counter.fetchAndAdd(1, MemoryOrder::Relaxed);
+                        return;
+                }
+
+                void setCommonCounters(BenchmarkState &state, int threads, Scheduler sched) {
+                        state.setCounter(String("threads"), static_cast<double>(threads));
+                        state.setCounter(String("work_stealing"), sched == Scheduler::WorkStealing ? 1.0 : 0.0);
+                        return;
+                }
+
+                // ------------------------------------------------------------------
+                // Round-trip latency on an idle pool
+                // ------------------------------------------------------------------
+                void benchSubmitLatency(BenchmarkState &state, Scheduler sched) {
+                        const int  threads = paramThreads();
+                        ThreadPool pool(threads, false, sched);
+                        // Warm the path: first submit registers the
+                        // untagged stats bucket.
+                        pool.submit([] { return 0; }).result();
+
+                        for (auto _ : state) {
+                                (void)_;
+                                auto [v, err] = pool.submit([] { return 1; }).result();
+                                if (err.isError() || v != 1) state.setCounter(String("invalid"), 1.0);
+                        }
+                        state.setItemsProcessed(state.iterations());
+                        setCommonCounters(state, threads, sched);
+                        state.setLabel(String("submit+wait, ") + schedulerName(sched));
+                }
+
+                // ------------------------------------------------------------------
+                // Many producers, one pool
+                // ------------------------------------------------------------------
+                void benchContended(BenchmarkState &state, Scheduler sched, bool usePost) {
+                        const int       threads = paramThreads();
+                        const int       producers = paramProducers();
+                        const int       tasks = paramTasks();
+                        const int       perProducer = (tasks + producers - 1) / producers;
+                        ThreadPool      pool(threads, false, sched);
+                        Atomic<int64_t> executed{0};
+
+                        for (auto _ : state) {
+                                (void)_;
+                                // Thread start-up is not what we're
+                                // measuring; park every producer on a
+                                // start flag first.
+                                state.pauseTiming();
+                                Atomic<int>       go{0};
+                                List<BasicThread> workers;
+                                for (int p = 0; p < producers; p++) {
+                                        BasicThread bt;
+                                        bt.start([&pool, &executed, &go, perProducer, usePost]() {
+                                                while (go.load(MemoryOrder::Acquire) == 0) {}
+                                                for (int i = 0; i < perProducer; i++) {
+                                                        if (usePost) {
+                                                                pool.post([&executed] { touch(executed); });
+                                                        } else {
+                                                                pool.submit([&executed] { touch(executed); });
+                                                        }
+                                                }
+                                        });
+                                        workers.pushToBack(std::move(bt));
+                                }
+                                state.resumeTiming();
+                                go.store(1, MemoryOrder::Release);
+                                for (auto &w : workers) w.join();
+                                pool.waitForDone();
+                        }
+
+                        const int64_t expected = static_cast<int64_t>(state.iterations()) * perProducer * producers;
+                        if (executed.value() != expected) state.setCounter(String("invalid"), 1.0);
+                        state.setItemsProcessed(static_cast<uint64_t>(expected));
+                        setCommonCounters(state, threads, sched);
+                        state.setCounter(String("producers"), static_cast<double>(producers));
+                        state.setLabel(String(usePost ? "post" : "submit") + " x" + String::number(producers) +
+                                       " producers, " + schedulerName(sched));
+                }
+
+                // ------------------------------------------------------------------
+                // Fan-out from inside the pool (Strand re-arm shape)
+                // ------------------------------------------------------------------
+                void benchFanout(BenchmarkState &state, Scheduler sched) {
+                        const int       threads = paramThreads();
+                        const int       tasks = paramTasks();
+                        ThreadPool      pool(threads, false, sched);
+                        Atomic<int64_t> executed{0};
+
+                        for (auto _ : state) {
+                                (void)_;
+                                pool.post([&pool, &executed, tasks] {
+                                        for (int i = 0; i < tasks; i++) {
+                                                pool.post([&executed] { touch(executed); });
+                                        }
+                                });
+                                pool.waitForDone();
+                        }
+
+                        const int64_t expected = static_cast<int64_t>(state.iterations()) * tasks;
+                        if (executed.value() != expected) state.setCounter(String("invalid"), 1.0);
+                        state.setItemsProcessed(static_cast<uint64_t>(expected));
+                        setCommonCounters(state, threads, sched);
+                        state.setLabel(String("post from worker, ") + schedulerName(sched));
+                }
+
+                void registerFor(Scheduler sched, const char *suffix) {
+                        const String s(suffix);
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("concurrency"), String("submit_latency_") + s,
+                                String("Single producer submit + Future wait round trip"),
+                                [sched](BenchmarkState &state) { benchSubmitLatency(state, sched); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("concurrency"), String("submit_contended_") + s,
+                                String("Several producers submit() bursts of trivial tasks concurrently"),
+                                [sched](BenchmarkState &state) { benchContended(state, sched, false); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("concurrency"), String("post_contended_") + s,
+                                String("Several producers post() bursts of trivial tasks concurrently"),
+                                [sched](BenchmarkState &state) { benchContended(state, sched, true); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("concurrency"), String("post_fanout_") + s,
+                                String("One worker task posts a burst of trivial tasks from inside the pool"),
+                                [sched](BenchmarkState &state) { benchFanout(state, sched); }));
+                }
+
+        } // namespace
+
+        void registerConcurrencyCases() {
+                registerFor(Scheduler::SharedQueue, "shared");
+                registerFor(Scheduler::WorkStealing, "stealing");
+        }
+
+        String concurrencyParamHelp() {
+                return String("concurrency suite parameters:\n"
+                              "  concurrency.threads=<int>    Worker threads per pool (default: ideal count)\n"
+                              "  concurrency.producers=<int>  Submitting threads in *_contended cases (default: 4)\n"
+                              "  concurrency.tasks=<int>      Tasks per measured burst (default: 20000)\n"
+                              "\n"
+                              "  Every case runs once against a SharedQueue pool (*_shared) and once\n"
+                              "  against a WorkStealing pool (*_stealing).  items_per_sec is task\n"
+                              "  throughput; submit_latency's ns/iter is the submit -> complete\n"
+                              "  round trip on an idle pool.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerConcurrencyCases() {
+                // core disabled — nothing to register.
+        }
+
+        String concurrencyParamHelp() {
+                return String("concurrency suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
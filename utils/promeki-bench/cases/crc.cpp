@@ -0,0 +1,145 @@
+/**
+ * @file      crc.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref CRC throughput benchmark cases for promeki-bench.  Each
+ * catalogued CRC is registered once per @ref CrcEngine the running CPU
+ * supports for it, named @c <crc>_<engine>, so the engines can be read
+ * off side by side.  Every iteration feeds one @c crc.size byte buffer
+ * through @ref CRC::update; bytes/sec is the engine's throughput.
+ *
+ * - @c crc8_autosar — the ImageData / AudioData band checksum.
+ * - @c crc16_ccitt — 16-bit unreflected.
+ * - @c crc32_mpeg2 — the MPEG-TS PSI section CRC (unreflected, so
+ *   no carry-less folding).
+ * - @c crc32_iso_hdlc / @c crc32c — reflected CRC-32s, which also get
+ *   a @c clmul case when PCLMULQDQ / PMULL is available.
+ * - @c crc64_xz — 64-bit reflected.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key        | Type | Default | Description                      |
+ * |------------|------|---------|----------------------------------|
+ * | `crc.size` | int  | 65536   | Bytes hashed per iteration       |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/benchmarkrunner.h>
+#include <promeki/buffer.h>
+#include <promeki/crc.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramSize() {
+                        const int n = benchParams().getInt(String("crc.size"), 65536);
+                        return n > 0 ? n : 1;
+                }
+
+                const char *engineName(CrcEngine e) {
+                        switch (e) {
+                                case CrcEngine::Auto: return "auto";
+                                case CrcEngine::Bytewise: return "bytewise";
+                                case CrcEngine::Slice8: return "slice8";
+                                case CrcEngine::Slice16: return "slice16";
+                                case CrcEngine::Clmul: return "clmul";
+                        }
+                        return "unknown";
+                }
+
+                template <typename T>
+                void benchCrc(BenchmarkState &state, const typename CRC<T>::Params &params, CrcEngine engine) {
+                        const size_t size = static_cast<size_t>(paramSize());
+                        Buffer       buf(size);
+                        buf.setSize(size);
+                        uint8_t *p = static_cast<uint8_t *>(buf.data());
+                        uint32_t seed = 0x9E3779B9u;
+                        for (size_t i = 0; i < size; i++) {
+                                seed = seed * 1664525u + 1013904223u;
+                                p[i] = static_cast<uint8_t>(seed >> 24);
+                        }
+
+                        CRC<T> crc(params);
+                        if (crc.setEngine(engine).isError()) {
+                                state.setCounter(String("invalid"), 1.0);
+                                return;
+                        }
+                        T sink = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                crc.reset();
+                                crc.update(p, size);
+                                sink ^= crc.value();
+                        }
+                        state.setBytesProcessed(state.iterations() * size);
+                        state.setCounter(String("sink"), static_cast<double>(sink & 1));
+                        state.setLabel(String(params.name) + ", " + engineName(crc.engine()) + ", " +
+                                       String::number(static_cast<uint64_t>(size)) + " B");
+                }
+
+                template <typename T> void registerFor(const char *name, const typename CRC<T>::Params &params) {
+                        static const CrcEngine engines[] = {CrcEngine::Bytewise, CrcEngine::Slice8, CrcEngine::Slice16,
+                                                            CrcEngine::Clmul};
+                        for (CrcEngine e : engines) {
+                                if (!CRC<T>::isEngineSupported(params, e)) continue;
+                                BenchmarkRunner::registerCase(BenchmarkCase(
+                                        String("crc"), String(name) + "_" + engineName(e),
+                                        String(params.name) + " via the " + engineName(e) + " engine",
+                                        [params, e](BenchmarkState &state) { benchCrc<T>(state, params, e); }));
+                        }
+                }
+
+        } // namespace
+
+        void registerCrcCases() {
+                constexpr Crc32::Params mpeg2{0x04C11DB7u, 0xFFFFFFFFu, 0x00000000u, false, "CRC-32/MPEG-2"};
+                registerFor<uint8_t>("crc8_autosar", CrcParams::Crc8Autosar);
+                registerFor<uint16_t>("crc16_ccitt", CrcParams::Crc16CcittFalse);
+                registerFor<uint32_t>("crc32_mpeg2", mpeg2);
+                registerFor<uint32_t>("crc32_iso_hdlc", CrcParams::Crc32IsoHdlc);
+                registerFor<uint32_t>("crc32c", CrcParams::Crc32c);
+                registerFor<uint64_t>("crc64_xz", CrcParams::Crc64Xz);
+        }
+
+        String crcParamHelp() {
+                return String("crc suite parameters:\n"
+                              "  crc.size=<int>  Bytes hashed per iteration (default: 65536)\n"
+                              "\n"
+                              "  Cases are named <crc>_<engine>; only engines the CPU supports for\n"
+                              "  that CRC are registered (clmul: reflected CRC-32 on PCLMULQDQ/PMULL).\n"
+                              "  bytes_per_sec is the engine's throughput.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerCrcCases() {
+                // core disabled — nothing to register.
+        }
+
+        String crcParamHelp() {
+                return String("crc suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
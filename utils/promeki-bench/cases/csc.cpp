@@ -21,11 +21,20 @@
  * | `csc.src`            | StringList  | (none)   | PixelFormat names used as conversion sources |
  * | `csc.dst`            | StringList  | (none)   | PixelFormat names used as conversion sinks   |
  * | `csc.config.<KEY>`   | Scalar      | (none)   | MediaConfig override passed to CSCPipeline |
+ * | `csc.threads`        | StringList  | 1,2,4,…  | Thread counts swept by the `cscmt` scaling cases |
+ * | `csc.mt.width`       | int         | 3840     | Image width for the `cscmt` scaling cases  |
+ * | `csc.mt.height`      | int         | 2160     | Image height for the `cscmt` scaling cases |
  *
  * When `csc.src` and `csc.dst` are both empty the standard conversion
  * matrix is registered; otherwise the cross product of the two lists
  * is registered (a single-sided list uses itself for the missing side,
  * matching the legacy cscbench semantics).
+ *
+ * The `cscmt` suite measures slice-parallel scaling
+ * (@ref MediaConfig::CscThreads): a handful of representative UHD
+ * pairs, each registered once per thread count so the per-case
+ * throughput lines up as a scaling curve.  The default sweep is every
+ * power of two up to `BasicThread::idealThreadCount()`.
  */
 
 #include "cases.h"
@@ -37,10 +46,12 @@
 
 #include <promeki/benchmarkrunner.h>
 #include <promeki/cscpipeline.h>
+#include <promeki/csccontext.h>
 #include <promeki/mediaconfig.h>
 #include <promeki/enums_color.h>
 #include <promeki/uncompressedvideopayload.h>
 #include <promeki/pixelformat.h>
+#include <promeki/basicthread.h>
 #include <promeki/list.h>
 #include <promeki/string.h>
 #include <promeki/stringlist.h>
@@ -228,14 +239,22 @@ namespace benchutil {
  * as `csc.config.CscPath` are honored), preallocates source and
  * destination images, warms the source buffer with a non-trivial
  * pattern, and executes the pipeline in the hot loop.
+ *
+ * A non-negative @p threads marks a `cscmt` scaling case: the image
+ * size comes from `csc.mt.*` and @ref MediaConfig::CscThreads is
+ * forced to @p threads on top of any `csc.config.*` overrides.
  */
-                BenchmarkCase::Function buildCase(ConvPair pair) {
-                        return [pair](BenchmarkState &state) {
+                BenchmarkCase::Function buildCase(ConvPair pair, int threads = -1) {
+                        return [pair, threads](BenchmarkState &state) {
                                 BenchParams &params = benchParams();
-                                int          width = params.getInt(String("csc.width"), 1920);
-                                int          height = params.getInt(String("csc.height"), 1080);
+                                const bool   scaling = threads >= 0;
+                                int          width = scaling ? params.getInt(String("csc.mt.width"), 3840)
+                                                             : params.getInt(String("csc.width"), 1920);
+                                int          height = scaling ? params.getInt(String("csc.mt.height"), 2160)
+                                                              : params.getInt(String("csc.height"), 1080);
 
                                 MediaConfig cfg = readCscMediaConfig();
+                                if (scaling) cfg.set(MediaConfig::CscThreads, threads);
                                 CSCPipeline pipeline(pair.src, pair.dst, cfg);
                                 bool        identity = pipeline.isIdentity();
                                 bool        fastPath = pipeline.isFastPath();
@@ -272,10 +291,12 @@ namespace benchutil {
                                 double mpix = static_cast<double>(width) * static_cast<double>(height);
                                 size_t bytesPerIter = static_cast<size_t>(planeSize);
 
+                                CSCContext::resetCacheStats();
                                 for (auto _ : state) {
                                         (void)_;
                                         pipeline.execute(*src, *dst.modify());
                                 }
+                                const CSCContext::CacheStats ctxStats = CSCContext::cacheStats();
 
                                 state.setItemsProcessed(state.iterations());
                                 state.setBytesProcessed(state.iterations() * bytesPerIter);
@@ -284,6 +305,8 @@ namespace benchutil {
                                 state.setCounter(String("stages"), static_cast<double>(stages));
                                 state.setCounter(String("identity"), identity ? 1.0 : 0.0);
                                 state.setCounter(String("fast_path"), fastPath ? 1.0 : 0.0);
+                                state.setCounter(String("threads"), static_cast<double>(pipeline.threadCount()));
+                                state.setCounter(String("ctx_misses"), static_cast<double>(ctxStats.misses));
 
                                 String label = String::number(width) + "x" + String::number(height) + " " +
                                                PixelFormat(pair.src).name() + " -> " + PixelFormat(pair.dst).name();
@@ -300,6 +323,49 @@ namespace benchutil {
                                PixelFormat(pair.dst).name();
                 }
 
+                /**
+ * @brief Resolves the thread-count sweep for the `cscmt` scaling cases.
+ *
+ * Reads `csc.threads` (a StringList of positive ints) and falls back
+ * to every power of two up to the machine's ideal thread count, plus
+ * the ideal count itself when it is not a power of two.
+ */
+                List<int> resolveThreadSweep() {
+                        List<int>  out;
+                        StringList names = benchParams().getStringList(String("csc.threads"));
+                        for (const auto &n : names) {
+                                Error err;
+                                int   v = n.toInt(&err);
+                                if (err.isError() || v < 1) {
+                                        std::fprintf(stderr, "promeki-bench: ignoring csc.threads '%s'\n", n.cstr());
+                                        continue;
+                                }
+                                out.pushToBack(v);
+                        }
+                        if (!out.isEmpty()) return out;
+
+                        const int ideal = std::max(1, static_cast<int>(BasicThread::idealThreadCount()));
+                        for (int t = 1; t <= ideal; t *= 2) out.pushToBack(t);
+                        if (out.back() != ideal) out.pushToBack(ideal);
+                        return out;
+                }
+
+                /**
+ * @brief Representative pairs for the `cscmt` scaling cases.
+ *
+ * One generic-pipeline 4:2:2 hop, one fast-path 4:2:2 hop, and the
+ * two ST 2110-20 wire paths (4:2:2 and the two-line 4:2:0 pgroup
+ * layout) that the ingest boxes spend most of their time in.
+ */
+                List<ConvPair> scalingPairs() {
+                        List<ConvPair> pairs;
+                        pairs.pushToBack({PixelFormat::RGBA8_sRGB, PixelFormat::YUV8_422_Rec709});
+                        pairs.pushToBack({PixelFormat::RGBA10_LE_sRGB, PixelFormat::YUV10_422_2110_Rec709});
+                        pairs.pushToBack({PixelFormat::YUV10_422_2110_Rec709, PixelFormat::RGBA10_LE_sRGB});
+                        pairs.pushToBack({PixelFormat::YUV10_420_SemiPlanar_LE_Rec709, PixelFormat::YUV10_420_2110_Rec709});
+                        return pairs;
+                }
+
         } // namespace
 
         void registerCscCases() {
@@ -348,6 +414,21 @@ namespace benchutil {
                         BenchmarkRunner::registerCase(
                                 BenchmarkCase(String("csc"), caseName(p), caseDescription(p), buildCase(p)));
                 }
+
+                // Slice-parallel scaling sweep.  Honors csc.src / csc.dst
+                // when given so a single pair can be profiled in depth.
+                List<ConvPair> mtPairs = (!customSrc.isEmpty() || !customDst.isEmpty()) ? pairs : scalingPairs();
+                List<int>      sweep = resolveThreadSweep();
+                MediaConfig    validityConfig;
+                for (const auto &p : mtPairs) {
+                        if (!CSCPipeline(p.src, p.dst, validityConfig).isValid()) continue;
+                        for (int t : sweep) {
+                                String name = caseName(p) + "_t" + String::number(t);
+                                String desc = caseDescription(p) + " on " + String::number(t) + " thread(s)";
+                                BenchmarkRunner::registerCase(
+                                        BenchmarkCase(String("cscmt"), name, desc, buildCase(p, t)));
+                        }
+                }
                 return;
         }
 
@@ -364,6 +445,10 @@ namespace benchutil {
                               "  csc.dst+=<name>          Explicit destination PixelFormat\n"
                               "  csc.config.<KEY>=<val>   MediaConfig override passed into the CSCPipeline\n"
                               "                             e.g. csc.config.CscPath=Scalar\n"
+                              "  csc.threads+=<int>       Thread count for the cscmt scaling sweep (default:\n"
+                              "                             powers of two up to the CPU count)\n"
+                              "  csc.mt.width=<int>       cscmt image width (default: 3840)\n"
+                              "  csc.mt.height=<int>      cscmt image height (default: 2160)\n"
                               "\n"
                               "  The CSC case set is generated by walking PixelFormat::registeredIDs(),\n"
                               "  filtering out compressed formats, and validating each candidate\n"
@@ -372,7 +457,11 @@ namespace benchutil {
                               "  registers only pairs where at least one endpoint is a canonical\n"
                               "  anchor (configurable via csc.anchors), keeping run time reasonable\n"
                               "  at roughly 500 pairs.  Use csc.full=1 for exhaustive coverage, or\n"
-                              "  csc.src / csc.dst for a targeted cross product.\n");
+                              "  csc.src / csc.dst for a targeted cross product.\n"
+                              "\n"
+                              "  The cscmt suite runs a few UHD pairs once per csc.threads entry\n"
+                              "  (MediaConfig::CscThreads) so items/s across the _t<N> cases reads\n"
+                              "  as a scaling curve; filter with -f 'cscmt\\..*'.\n");
         }
 
 } // namespace benchutil
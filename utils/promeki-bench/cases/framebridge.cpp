@@ -0,0 +1,350 @@
+/**
+ * @file      framebridge.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref FrameBridge benchmark cases for promeki-bench.  Every case moves
+ * the same multi-essence frame — @c framebridge.images image plane
+ * groups, @c framebridge.audio audio tracks and @c framebridge.anc ANC
+ * streams — from a publisher to consumer threads, either through one
+ * bridge carrying every essence (@c single) or through one bridge per
+ * essence (@c separate), the layout a pipeline had to use before a
+ * bridge could carry more than one image and one audio track.
+ *
+ * - @c latency_single / @c latency_separate — async inputs, one frame
+ *   in flight: publish, then wait until every consumer has read its
+ *   part.  The mean iteration time is the publish-to-fully-received
+ *   latency; @c separate pays a TICK and a consumer wake-up per
+ *   bridge, and its consumers still have to be re-synced downstream.
+ * - @c throughput_single / @c throughput_separate — sync inputs,
+ *   back-to-back frames paced by the bridges' own ACKs.  bytes/sec is
+ *   the image + audio payload rate.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key                  | Type | Default | Description                       |
+ * |----------------------|------|---------|-----------------------------------|
+ * | `framebridge.width`  | int  | 1920    | Image width (RGBA8)               |
+ * | `framebridge.height` | int  | 1080    | Image height                      |
+ * | `framebridge.images` | int  | 2       | Image plane groups per frame      |
+ * | `framebridge.audio`  | int  | 4       | Stereo 48 kHz float audio tracks  |
+ * | `framebridge.anc`    | int  | 1       | ANC streams per frame             |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
+
+#include <cstdint>
+#include <cstring>
+
+#include <promeki/ancpayload.h>
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/framebridge.h>
+#include <promeki/list.h>
+#include <promeki/pcmaudiopayload.h>
+#include <promeki/st291packet.h>
+#include <promeki/string.h>
+#include <promeki/uncompressedvideopayload.h>
+#include <promeki/uniqueptr.h>
+#include <promeki/uuid.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramInt(const char *key, int def, int min) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n >= min ? n : min;
+                }
+
+                // The frame every case publishes, plus the per-bridge
+                // split the separate cases use.
+                struct Workload {
+                                MediaDesc       desc;        // every essence
+                                List<MediaDesc> splitDescs;  // one essence each
+                                Frame           frame;       // every essence
+                                List<Frame>     splitFrames; // one essence each
+                                uint64_t        bytes = 0;   // image + audio payload bytes per frame
+                };
+
+                Workload makeWorkload() {
+                        const int       width = paramInt("framebridge.width", 1920, 16);
+                        const int       height = paramInt("framebridge.height", 1080, 16);
+                        const int       images = paramInt("framebridge.images", 2, 0);
+                        const int       audio = paramInt("framebridge.audio", 4, 0);
+                        const int       anc = paramInt("framebridge.anc", 1, 0);
+                        const FrameRate rate(FrameRate::FPS_30);
+
+                        Workload w;
+                        w.desc.setFrameRate(rate);
+                        auto addSplit = [&w, &rate](MediaDesc single, MediaPayload::Ptr payload) {
+                                single.setFrameRate(rate);
+                                Frame f;
+                                f.addPayload(payload);
+                                w.frame.addPayload(payload);
+                                w.splitDescs.pushToBack(single);
+                                w.splitFrames.pushToBack(f);
+                        };
+
+                        for (int i = 0; i < images; ++i) {
+                                const ImageDesc id(width, height, PixelFormat::RGBA8_sRGB);
+                                UncompressedVideoPayload::Ptr img = UncompressedVideoPayload::allocate(id);
+                                auto                          plane = img->plane(0);
+                                for (size_t b = 0; b < plane.size(); ++b) plane.data()[b] = static_cast<uint8_t>(b + i);
+                                w.desc.imageList().pushToBack(id);
+                                w.bytes += plane.size();
+                                MediaDesc single;
+                                single.imageList().pushToBack(id);
+                                addSplit(single, img);
+                        }
+
+                        const AudioDesc ad(AudioFormat::PCMI_Float32LE, 48000.0f, 2);
+                        const size_t    samples = 1600; // one 30 fps frame at 48 kHz
+                        for (int i = 0; i < audio; ++i) {
+                                const size_t bytes = ad.bufferSize(samples);
+                                Buffer       buf(bytes);
+                                buf.setSize(bytes);
+                                std::memset(buf.data(), i, bytes);
+                                w.desc.audioList().pushToBack(ad);
+                                w.bytes += bytes;
+                                MediaDesc single;
+                                single.audioList().pushToBack(ad);
+                                addSplit(single, PcmAudioPayload::Ptr::create(ad, samples, BufferView(buf, 0, bytes)));
+                        }
+
+                        const AncDesc  ancDesc(Size2Du32(width, height), VideoScanMode::Progressive, rate);
+                        List<uint16_t> udw;
+                        for (int b = 0; b < 30; ++b) udw.pushToBack(static_cast<uint16_t>(b));
+                        for (int i = 0; i < anc; ++i) {
+                                AncPayload::Ptr ap = AncPayload::Ptr::create(ancDesc);
+                                ap.modify()->addPacket(St291Packet::build(AncFormat(AncFormat::Cea708), udw,
+                                                                          static_cast<uint16_t>(9 + i))
+                                                               .packet());
+                                w.desc.ancList().pushToBack(ancDesc);
+                                MediaDesc single;
+                                single.ancList().pushToBack(ancDesc);
+                                addSplit(single, ap);
+                        }
+                        return w;
+                }
+
+                // One input bridge read on its own thread, standing in
+                // for a consumer process.  The bridge is opened and
+                // closed on that thread, as FrameBridge is thread-affine.
+                struct Consumer {
+                                Atomic<int64_t> frames{0};
+                                Atomic<int>     ready{0};
+                                Atomic<int>     failed{0};
+                                Atomic<int>     stop{0};
+                                Atomic<int>     done{0};
+                                BasicThread     thread;
+
+                                void start(const String &name, bool sync) {
+                                        thread.start([this, name, sync]() {
+                                                FrameBridge in;
+                                                if (in.openInput(name, sync).isError()) {
+                                                        failed.store(1, MemoryOrder::Release);
+                                                        done.store(1, MemoryOrder::Release);
+                                                        ready.store(1, MemoryOrder::Release);
+                                                        return;
+                                                }
+                                                ready.store(1, MemoryOrder::Release);
+                                                while (stop.load(MemoryOrder::Acquire) == 0) {
+                                                        Error err;
+                                                        Frame f = in.readFrame(&err);
+                                                        if (err.isError()) break;
+                                                        if (f.isValid()) {
+                                                                frames.fetchAndAdd(1, MemoryOrder::Release);
+                                                        } else {
+                                                                BasicThread::yield();
+                                                        }
+                                                }
+                                                in.close();
+                                                done.store(1, MemoryOrder::Release);
+                                        });
+                                        return;
+                                }
+                };
+
+                using ConsumerPtr = UniquePtr<Consumer>;
+
+                // Publishers plus one consumer per bridge.  Tears
+                // everything down in the destructor.
+                struct Rig {
+                                List<FrameBridge::UPtr> outputs;
+                                List<ConsumerPtr>       consumers;
+                                bool                    ok = true;
+
+                                Rig(const List<MediaDesc> &descs, bool sync) {
+                                        const String base = String("bench-fb-") + UUID::generateV4().toString();
+                                        for (size_t i = 0; i < descs.size() && ok; ++i) {
+                                                const String        name = base + "-" + String::number(i);
+                                                FrameBridge::Config cfg;
+                                                cfg.mediaDesc = descs[i];
+                                                cfg.waitForConsumer = false;
+                                                FrameBridge::UPtr out = FrameBridge::UPtr::create();
+                                                if (out->openOutput(name, cfg).isError()) {
+                                                        ok = false;
+                                                        break;
+                                                }
+                                                outputs.pushToBack(std::move(out));
+                                                ConsumerPtr c = ConsumerPtr::create();
+                                                c->start(name, sync);
+                                                while (c->ready.load(MemoryOrder::Acquire) == 0) {
+                                                        BasicThread::sleepMs(1);
+                                                }
+                                                if (c->failed.load(MemoryOrder::Acquire) != 0) ok = false;
+                                                consumers.pushToBack(std::move(c));
+                                        }
+                                        // The accept worker hands new inputs over
+                                        // asynchronously; wait until each is attached.
+                                        for (auto &out : outputs) {
+                                                for (int t = 0; t < 2000 && out->connectionCount() == 0; ++t) {
+                                                        BasicThread::sleepMs(1);
+                                                }
+                                                if (out->connectionCount() == 0) ok = false;
+                                        }
+                                }
+
+                                ~Rig() {
+                                        for (auto &c : consumers) c->stop.store(1, MemoryOrder::Release);
+                                        for (auto &out : outputs) out->close();
+                                        for (auto &c : consumers) c->thread.join();
+                                }
+
+                                bool publish(const List<Frame> &frames) {
+                                        for (size_t i = 0; i < outputs.size(); ++i) {
+                                                if (outputs[i]->writeFrame(frames[i]).isError()) return false;
+                                        }
+                                        return true;
+                                }
+
+                                // Spins until every consumer has read
+                                // @p target frames; false if one gave up.
+                                bool waitForAll(int64_t target) {
+                                        for (auto &c : consumers) {
+                                                while (c->frames.load(MemoryOrder::Acquire) < target) {
+                                                        if (c->done.load(MemoryOrder::Acquire) != 0) return false;
+                                                }
+                                        }
+                                        return true;
+                                }
+                };
+
+                void setCommonCounters(BenchmarkState &state, const Workload &w, size_t bridges) {
+                        state.setCounter(String("bridges"), static_cast<double>(bridges));
+                        state.setCounter(String("essences"), static_cast<double>(w.splitFrames.size()));
+                        state.setBytesProcessed(state.iterations() * w.bytes);
+                        return;
+                }
+
+                // ------------------------------------------------------------------
+                // One frame in flight: publish → every consumer has it
+                // ------------------------------------------------------------------
+                void benchLatency(BenchmarkState &state, bool separate) {
+                        const Workload    w = makeWorkload();
+                        const List<Frame> single = {w.frame};
+                        Rig               rig(separate ? w.splitDescs : List<MediaDesc>{w.desc}, false);
+                        if (!rig.ok) {
+                                state.setCounter(String("invalid"), 1.0);
+                                return;
+                        }
+                        int64_t published = 0;
+                        bool    failed = false;
+                        for (auto _ : state) {
+                                (void)_;
+                                if (!rig.publish(separate ? w.splitFrames : single)) failed = true;
+                                if (!rig.waitForAll(++published)) failed = true;
+                        }
+                        if (failed) state.setCounter(String("invalid"), 1.0);
+                        setCommonCounters(state, w, rig.outputs.size());
+                        state.setLabel(String(separate ? "one bridge per essence" : "one multi-essence bridge") +
+                                       ", async inputs, one frame in flight");
+                }
+
+                // ------------------------------------------------------------------
+                // Back-to-back frames paced by sync-input ACKs
+                // ------------------------------------------------------------------
+                void benchThroughput(BenchmarkState &state, bool separate) {
+                        const Workload    w = makeWorkload();
+                        const List<Frame> single = {w.frame};
+                        Rig               rig(separate ? w.splitDescs : List<MediaDesc>{w.desc}, true);
+                        if (!rig.ok) {
+                                state.setCounter(String("invalid"), 1.0);
+                                return;
+                        }
+                        bool failed = false;
+                        for (auto _ : state) {
+                                (void)_;
+                                if (!rig.publish(separate ? w.splitFrames : single)) failed = true;
+                        }
+                        if (failed) state.setCounter(String("invalid"), 1.0);
+                        setCommonCounters(state, w, rig.outputs.size());
+                        state.setLabel(String(separate ? "one bridge per essence" : "one multi-essence bridge") +
+                                       ", sync inputs");
+                }
+
+        } // namespace
+
+        void registerFrameBridgeCases() {
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("framebridge"), String("latency_single"),
+                        String("Publish-to-received latency, every essence on one bridge"),
+                        [](BenchmarkState &state) { benchLatency(state, false); }));
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("framebridge"), String("latency_separate"),
+                        String("Publish-to-received latency, one bridge per essence"),
+                        [](BenchmarkState &state) { benchLatency(state, true); }));
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("framebridge"), String("throughput_single"),
+                        String("Sync-paced frame throughput, every essence on one bridge"),
+                        [](BenchmarkState &state) { benchThroughput(state, false); }));
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("framebridge"), String("throughput_separate"),
+                        String("Sync-paced frame throughput, one bridge per essence"),
+                        [](BenchmarkState &state) { benchThroughput(state, true); }));
+        }
+
+        String frameBridgeParamHelp() {
+                return String("framebridge suite parameters:\n"
+                              "  framebridge.width=<int>   Image width, RGBA8 (default: 1920)\n"
+                              "  framebridge.height=<int>  Image height (default: 1080)\n"
+                              "  framebridge.images=<int>  Image plane groups per frame (default: 2)\n"
+                              "  framebridge.audio=<int>   Stereo 48 kHz float tracks per frame (default: 4)\n"
+                              "  framebridge.anc=<int>     ANC streams per frame (default: 1)\n"
+                              "\n"
+                              "  *_single carries every essence on one bridge; *_separate opens one\n"
+                              "  bridge (and one consumer thread) per essence.  latency_* time is\n"
+                              "  publish until every consumer has read the frame; throughput_*\n"
+                              "  bytes_per_sec is the image + audio rate under sync-input ACKs.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerFrameBridgeCases() {
+                // proav or network disabled — nothing to register.
+        }
+
+        String frameBridgeParamHelp() {
+                return String("framebridge suite parameters: (disabled — built without PROMEKI_ENABLE_PROAV "
+                              "and PROMEKI_ENABLE_NETWORK)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
@@ -0,0 +1,310 @@
+/**
+ * @file      httpserver.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref HttpServer loopback load-test cases for promeki-bench.  The
+ * server runs on its own thread; @c http.clients client threads each
+ * hold one keep-alive connection and send @c http.requests requests
+ * back to back, waiting for every response before the next request.
+ * Connecting is kept out of the timing.  items/sec is requests/sec
+ * across all clients; the @c p50_us and @c p99_us counters are
+ * per-request latency percentiles over every iteration.
+ *
+ * - @c stats_loop — single-loop mode (reactor count 0), the baseline.
+ * - @c stats_r<N> — N reactor threads sharing the port through
+ *   @c SO_REUSEPORT, for N = 1, 2 and 4.
+ * - @c stall_loop / @c stall_r4_pool — one client instead hits a route
+ *   whose handler blocks for @c http.slowMs ms per request, first on
+ *   the single loop, then with four reactors and the blocking part
+ *   offloaded to a worker pool.  The latency counters cover only the
+ *   other clients, so they show what one slow handler costs everyone
+ *   else.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key             | Type | Default | Description                         |
+ * |-----------------|------|---------|-------------------------------------|
+ * | `http.clients`  | int  | 8       | Concurrent keep-alive connections   |
+ * | `http.requests` | int  | 2000    | Requests per client per iteration   |
+ * | `http.slowMs`   | int  | 5       | Blocking time of the stall route    |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_HTTP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/elapsedtimer.h>
+#include <promeki/eventloop.h>
+#include <promeki/httpserver.h>
+#include <promeki/json.h>
+#include <promeki/list.h>
+#include <promeki/promise.h>
+#include <promeki/socketaddress.h>
+#include <promeki/string.h>
+#include <promeki/tcpsocket.h>
+#include <promeki/thread.h>
+#include <promeki/threadpool.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? n : 1;
+                }
+
+                // An HttpServer living on a dedicated thread, built and
+                // torn down on that thread as ObjectBase requires.
+                class ServerHost {
+                        public:
+                                ServerHost(unsigned int reactors, ThreadPool *pool, int slowMs) {
+                                        _thread.setName("http-bench");
+                                        _thread.start();
+                                        run([this, reactors, pool, slowMs]() {
+                                                _server = new HttpServer();
+                                                _server->setReactorCount(reactors);
+                                                _server->setWorkerPool(pool);
+                                                _server->route("/stats", HttpMethod::Get,
+                                                               [this](const HttpRequest &, HttpResponse &res) {
+                                                                       JsonObject obj;
+                                                                       obj.set("requests", _hits.fetchAndAdd(1));
+                                                                       obj.set("status", String("ok"));
+                                                                       res.setJson(obj);
+                                                               });
+                                                _server->route("/slow", HttpMethod::Get,
+                                                               [slowMs](const HttpRequest &, HttpResponse &res) {
+                                                                       res.setOffloadTask([slowMs](HttpResponse &r) {
+                                                                               BasicThread::sleepMs(slowMs);
+                                                                               r.setText("slow");
+                                                                       });
+                                                               });
+                                                Error err = _server->listen(SocketAddress::localhost(0));
+                                                if (err.isOk()) _port = _server->serverAddress().port();
+                                                return err;
+                                        });
+                                }
+
+                                ~ServerHost() {
+                                        run([this]() {
+                                                delete _server;
+                                                _server = nullptr;
+                                                return Error::Ok;
+                                        });
+                                        _thread.quit();
+                                        _thread.wait();
+                                }
+
+                                uint16_t port() const { return _port; }
+
+                        private:
+                                Thread      _thread;
+                                HttpServer *_server = nullptr;
+                                Atomic<int> _hits{0};
+                                uint16_t    _port = 0;
+
+                                void run(Function<Error()> func) {
+                                        auto          promise = std::make_shared<Promise<Error>>();
+                                        Future<Error> future = promise->future();
+                                        _thread.threadEventLoop()->postCallable(
+                                                [promise, func]() { promise->setValue(func()); });
+                                        future.result();
+                                        return;
+                                }
+                };
+
+                // Sends one request and reads its response off a
+                // keep-alive connection.  Responses here are small, so
+                // one buffer holds the whole thing.
+                bool exchange(TcpSocket &sock, const String &req) {
+                        const int64_t len = static_cast<int64_t>(req.byteCount());
+                        if (sock.write(req.cstr(), len) != len) return false;
+
+                        char   buf[4096];
+                        size_t have = 0;
+                        size_t total = 0;
+                        while (total == 0 || have < total) {
+                                if (have == sizeof(buf)) return false;
+                                const int64_t got = sock.read(buf + have, sizeof(buf) - have);
+                                if (got <= 0) return false;
+                                have += static_cast<size_t>(got);
+                                if (total != 0) continue;
+
+                                const char *end = static_cast<const char *>(memmem(buf, have, "\r\n\r\n", 4));
+                                if (end == nullptr) continue;
+                                const size_t headLen = static_cast<size_t>(end - buf) + 4;
+                                const char  *cl =
+                                        static_cast<const char *>(memmem(buf, headLen, "Content-Length:", 15));
+                                total = headLen + (cl != nullptr ? std::strtoul(cl + 15, nullptr, 10) : 0);
+                        }
+                        return true;
+                }
+
+                double percentileUs(List<int64_t> &ns, double pct) {
+                        if (ns.isEmpty()) return 0.0;
+                        ns = ns.sort();
+                        const size_t idx = static_cast<size_t>(pct * static_cast<double>(ns.size() - 1));
+                        return static_cast<double>(ns[idx]) / 1000.0;
+                }
+
+                void benchLoad(BenchmarkState &state, unsigned int reactors, bool stall) {
+                        const int clients = paramInt("http.clients", 8);
+                        const int requests = paramInt("http.requests", 2000);
+                        const int slowMs = paramInt("http.slowMs", 5);
+
+                        // The pool only matters for the offloaded stall
+                        // case; without one the slow route blocks its
+                        // reactor inline.
+                        ThreadPool pool(4);
+                        ServerHost host(reactors, stall && reactors > 0 ? &pool : nullptr, slowMs);
+                        if (host.port() == 0) return;
+
+                        const String   statsReq("GET /stats HTTP/1.1\r\nHost: bench\r\n\r\n");
+                        const String   slowReq("GET /slow HTTP/1.1\r\nHost: bench\r\n\r\n");
+                        List<int64_t>  latencies;
+                        Atomic<int>    failures{0};
+                        const uint16_t port = host.port();
+
+                        for (auto _ : state) {
+                                (void)_;
+                                // Connect every client and park it on the
+                                // start flag so setup stays out of the timing.
+                                state.pauseTiming();
+                                List<List<int64_t>> perClient;
+                                perClient.resize(static_cast<size_t>(clients));
+                                Atomic<int>       go{0};
+                                Atomic<int>       ready{0};
+                                Atomic<int>       fastDone{0};
+                                List<BasicThread> workers;
+                                for (int c = 0; c < clients; c++) {
+                                        const bool     slow = stall && c == 0;
+                                        List<int64_t> *out = &perClient[static_cast<size_t>(c)];
+                                        BasicThread    bt;
+                                        bt.start([&, slow, out]() {
+                                                TcpSocket sock;
+                                                sock.open(IODevice::ReadWrite);
+                                                const SocketAddress addr = SocketAddress::localhost(port);
+                                                const bool          ok = sock.connectToHost(addr).isOk();
+                                                if (ok) sock.setNoDelay(true);
+                                                ready.fetchAndAdd(1);
+                                                while (go.load(MemoryOrder::Acquire) == 0) {}
+                                                if (!ok) {
+                                                        failures.fetchAndAdd(1);
+                                                        if (!slow) fastDone.fetchAndAdd(1);
+                                                        return;
+                                                }
+                                                if (slow) {
+                                                        // Keep the slow route busy for as
+                                                        // long as the others are running.
+                                                        while (fastDone.value() < clients - 1) {
+                                                                if (!exchange(sock, slowReq)) break;
+                                                        }
+                                                } else {
+                                                        out->reserve(static_cast<size_t>(requests));
+                                                        for (int i = 0; i < requests; i++) {
+                                                                ElapsedTimer t;
+                                                                if (!exchange(sock, statsReq)) {
+                                                                        failures.fetchAndAdd(1);
+                                                                        break;
+                                                                }
+                                                                out->pushToBack(t.elapsedNs());
+                                                        }
+                                                        fastDone.fetchAndAdd(1);
+                                                }
+                                                sock.close();
+                                        });
+                                        workers.pushToBack(std::move(bt));
+                                }
+                                while (ready.value() < clients) BasicThread::yield();
+                                state.resumeTiming();
+                                go.store(1, MemoryOrder::Release);
+                                for (auto &w : workers) w.join();
+                                state.pauseTiming();
+                                for (const List<int64_t> &l : perClient) {
+                                        for (int64_t ns : l) latencies.pushToBack(ns);
+                                }
+                                state.resumeTiming();
+                        }
+
+                        const int measured = stall ? clients - 1 : clients;
+                        state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(measured) *
+                                                static_cast<uint64_t>(requests));
+                        state.setCounter(String("p50_us"), percentileUs(latencies, 0.50));
+                        state.setCounter(String("p99_us"), percentileUs(latencies, 0.99));
+                        state.setCounter(String("clients"), static_cast<double>(clients));
+                        state.setCounter(String("failures"), static_cast<double>(failures.value()));
+                        String label = reactors == 0 ? String("single loop")
+                                                     : String::number(reactors) + " reactors";
+                        if (stall) label += String(", 1 client on a ") + String::number(slowMs) + " ms route";
+                        state.setLabel(label);
+                }
+
+                void registerLoad(const String &name, const String &desc, unsigned int reactors, bool stall) {
+                        BenchmarkRunner::registerCase(
+                                BenchmarkCase(String("http"), name, desc, [reactors, stall](BenchmarkState &state) {
+                                        benchLoad(state, reactors, stall);
+                                }));
+                        return;
+                }
+
+        } // namespace
+
+        void registerHttpServerCases() {
+                registerLoad(String("stats_loop"), String("Keep-alive GET /stats against a single-loop server"), 0,
+                             false);
+                for (unsigned int reactors : {1u, 2u, 4u}) {
+                        registerLoad(String("stats_r") + String::number(reactors),
+                                     String("Keep-alive GET /stats against SO_REUSEPORT reactor threads"), reactors,
+                                     false);
+                }
+                registerLoad(String("stall_loop"), String("GET /stats latency beside a blocking handler, single loop"),
+                             0, true);
+                registerLoad(String("stall_r4_pool"),
+                             String("GET /stats latency beside an offloaded blocking handler, 4 reactors"), 4, true);
+        }
+
+        String httpServerParamHelp() {
+                return String("http suite parameters:\n"
+                              "  http.clients=<int>   Concurrent keep-alive connections (default: 8)\n"
+                              "  http.requests=<int>  Requests per client per iteration (default: 2000)\n"
+                              "  http.slowMs=<int>    Blocking time of the stall route in ms (default: 5)\n"
+                              "\n"
+                              "  Cases: stats_loop, stats_r<1|2|4>, stall_loop, stall_r4_pool.  items/sec\n"
+                              "  is requests/sec; p50_us / p99_us are per-request latency.  In the stall\n"
+                              "  cases one client drives the slow route and is left out of the numbers.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_HTTP
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerHttpServerCases() {
+                // http disabled — nothing to register.
+        }
+
+        String httpServerParamHelp() {
+                return String("http suite parameters: (disabled — built without PROMEKI_ENABLE_HTTP)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_HTTP
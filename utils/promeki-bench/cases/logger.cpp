@@ -0,0 +1,205 @@
+/**
+ * @file      logger.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref Logger call-site benchmark cases for promeki-bench.  Every case
+ * goes through the @c promekiWarn macro exactly as library code does
+ * and runs once with deferred formatting (per-thread staging, the
+ * default) and once with it disabled (format on the caller, enqueue a
+ * String), named @c <case>_deferred and @c <case>_eager.  Console
+ * output is switched off for the run so the worker is not bound by
+ * the terminal; timing covers the calling threads only.
+ *
+ * - @c call — one thread, one log call per iteration.  The message
+ *   mixes integers and a string, the shape of a packet-loss warning.
+ * - @c storm — @c logger.threads threads log concurrently; each
+ *   iteration is a burst of @c logger.calls calls split across them.
+ *   items/sec is log calls per second.
+ * - @c filtered — the call is below the runtime level and is
+ *   discarded by the macro (registered once; it has no mode).
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key              | Type | Default | Description                       |
+ * |------------------|------|---------|-----------------------------------|
+ * | `logger.threads` | int  | 8       | Logging threads in the storm case |
+ * | `logger.calls`   | int  | 20000   | Log calls per storm burst         |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/logger.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? n : 1;
+                }
+
+                // Puts the default logger into benchmark shape for the
+                // lifetime of a case and restores it afterwards.
+                class LoggerSetup {
+                        public:
+                                explicit LoggerSetup(bool deferred)
+                                    : _logger(Logger::defaultLogger()), _console(_logger.consoleLoggingEnabled()),
+                                      _deferred(_logger.deferredFormatting()) {
+                                        _logger.sync();
+                                        _logger.setConsoleLoggingEnabled(false);
+                                        _logger.setDeferredFormatting(deferred);
+                                }
+
+                                ~LoggerSetup() {
+                                        _logger.sync();
+                                        _logger.setDeferredFormatting(_deferred);
+                                        _logger.setConsoleLoggingEnabled(_console);
+                                }
+
+                                Logger &logger() { return _logger; }
+
+                        private:
+                                Logger &_logger;
+                                bool    _console;
+                                bool    _deferred;
+                };
+
+                void logOne(int stream, uint64_t seq) {
+                        promekiWarn("stream %d: lost %u packets before seq %llu (%s)", stream, 3u,
+                                    static_cast<unsigned long long>(seq), "rtp-video");
+                        return;
+                }
+
+                void benchCall(BenchmarkState &state, bool deferred) {
+                        LoggerSetup setup(deferred);
+                        uint64_t    seq = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                logOne(0, seq++);
+                        }
+                        state.setItemsProcessed(state.iterations());
+                        state.setLabel(String(deferred ? "deferred" : "eager"));
+                }
+
+                void benchStorm(BenchmarkState &state, bool deferred) {
+                        const int   threads = paramInt("logger.threads", 8);
+                        const int   calls = paramInt("logger.calls", 20000);
+                        const int   perThread = (calls + threads - 1) / threads;
+                        LoggerSetup setup(deferred);
+
+                        for (auto _ : state) {
+                                (void)_;
+                                // Park every thread on a start flag so
+                                // thread start-up stays out of the timing.
+                                state.pauseTiming();
+                                Atomic<int>       go{0};
+                                List<BasicThread> workers;
+                                for (int t = 0; t < threads; t++) {
+                                        BasicThread bt;
+                                        bt.start([&go, t, perThread]() {
+                                                while (go.load(MemoryOrder::Acquire) == 0) {}
+                                                for (int i = 0; i < perThread; i++) {
+                                                        logOne(t, static_cast<uint64_t>(i));
+                                                }
+                                        });
+                                        workers.pushToBack(std::move(bt));
+                                }
+                                state.resumeTiming();
+                                go.store(1, MemoryOrder::Release);
+                                for (auto &w : workers) w.join();
+                                // Draining is the worker's cost, not the
+                                // callers'; keep it out of the numbers.
+                                state.pauseTiming();
+                                setup.logger().sync();
+                                state.resumeTiming();
+                        }
+
+                        state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(perThread) *
+                                                static_cast<uint64_t>(threads));
+                        state.setCounter(String("threads"), static_cast<double>(threads));
+                        state.setLabel(String(deferred ? "deferred" : "eager") + " x" + String::number(threads) +
+                                       " threads");
+                }
+
+                void benchFiltered(BenchmarkState &state) {
+                        Logger   &logger = Logger::defaultLogger();
+                        const int saved = logger.level();
+                        logger.setLogLevel(Logger::Err);
+                        uint64_t seq = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                logOne(0, seq++);
+                        }
+                        state.setItemsProcessed(state.iterations());
+                        logger.setLogLevel(static_cast<Logger::LogLevel>(saved));
+                        logger.sync();
+                }
+
+                void registerMode(bool deferred) {
+                        const String mode(deferred ? "deferred" : "eager");
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("logger"), String("call_") + mode,
+                                String("Single-thread promekiWarn call cost, ") + mode,
+                                [deferred](BenchmarkState &state) { benchCall(state, deferred); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("logger"), String("storm_") + mode,
+                                String("Many threads logging at once, ") + mode,
+                                [deferred](BenchmarkState &state) { benchStorm(state, deferred); }));
+                        return;
+                }
+
+        } // namespace
+
+        void registerLoggerCases() {
+                registerMode(true);
+                registerMode(false);
+                BenchmarkRunner::registerCase(BenchmarkCase(String("logger"), String("filtered"),
+                                                            String("promekiWarn below the runtime log level"),
+                                                            [](BenchmarkState &state) { benchFiltered(state); }));
+        }
+
+        String loggerParamHelp() {
+                return String("logger suite parameters:\n"
+                              "  logger.threads=<int>  Logging threads in the storm case (default: 8)\n"
+                              "  logger.calls=<int>    Log calls per storm burst (default: 20000)\n"
+                              "\n"
+                              "  Cases are named <case>_<mode> (deferred, eager); filtered has no mode.\n"
+                              "  Console output is disabled while the suite runs.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerLoggerCases() {
+                // core disabled — nothing to register.
+        }
+
+        String loggerParamHelp() {
+                return String("logger suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -0,0 +1,200 @@
+/**
+ * @file      mempool.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref MemPool allocator benchmark cases for promeki-bench.  Every case
+ * runs once per allocator mode, named @c <case>_<mode>, so first-fit and
+ * TLSF can be read off side by side.  The pool manages a synthetic
+ * address range — MemPool never touches the memory it hands out, so no
+ * backing storage is needed.
+ *
+ * - @c churn — random allocate / free of mixed sizes and alignments
+ *   around a steady live set of @c mempool.live blocks, the shape of a
+ *   device heap under a running pipeline.  items/sec is operations per
+ *   second.  The @c fragmentation counter is
+ *   <tt>1 - largestFreeBlock / totalFree</tt> at the end of the run (0
+ *   = one contiguous free block) and @c failures counts allocations
+ *   the pool could not satisfy.
+ * - @c small — allocate / free pairs of 16–256 byte blocks behind the
+ *   same churned pool.  Also registered as @c small_tlsf_cached with
+ *   per-thread front caches enabled.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key               | Type | Default  | Description                       |
+ * |-------------------|------|----------|-----------------------------------|
+ * | `mempool.region`  | int  | 67108864 | Bytes managed by the pool         |
+ * | `mempool.live`    | int  | 512      | Live blocks held during churn     |
+ * | `mempool.maxsize` | int  | 65536    | Largest churn allocation in bytes |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/mempool.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                constexpr uintptr_t RegionBase = 0x100000000ull;
+
+                size_t paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? static_cast<size_t>(n) : 1;
+                }
+
+                struct Rng {
+                                uint32_t state = 0x9E3779B9u;
+                                uint32_t next() {
+                                        state = state * 1664525u + 1013904223u;
+                                        return state >> 8;
+                                }
+                };
+
+                MemPool::Config makeConfig(MemPool::Mode mode, bool cached, size_t live) {
+                        MemPool::Config cfg;
+                        cfg.mode = mode;
+                        cfg.maxBlocks = live * 4 + 64;
+                        if (cached) cfg.frontCacheMaxSize = 256;
+                        return cfg;
+                }
+
+                // One random op against the live set: allocate while under
+                // the target, otherwise free a random victim.
+                bool churnStep(MemPool &pool, List<void *> &live, size_t target, size_t maxSize, Rng &rng) {
+                        const uint32_t r = rng.next();
+                        if (live.size() < target && (live.isEmpty() || (r & 1) || live.size() < target / 2)) {
+                                const size_t size = 16 + (rng.next() % maxSize);
+                                const size_t align = size_t(1) << (rng.next() % 9);
+                                void        *p = pool.allocate(size, align);
+                                if (p == nullptr) return false;
+                                live.pushToBack(p);
+                        } else {
+                                const size_t idx = rng.next() % live.size();
+                                pool.free(live[idx]);
+                                live[idx] = live.back();
+                                live.popFromBack();
+                        }
+                        return true;
+                }
+
+                void benchChurn(BenchmarkState &state, MemPool::Mode mode) {
+                        const size_t region = paramInt("mempool.region", 64 * 1024 * 1024);
+                        const size_t target = paramInt("mempool.live", 512);
+                        const size_t maxSize = paramInt("mempool.maxsize", 65536);
+
+                        MemPool pool(makeConfig(mode, false, target));
+                        pool.addRegion(RegionBase, region);
+                        List<void *> live;
+                        live.reserve(target);
+                        Rng      rng;
+                        uint64_t failures = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                if (!churnStep(pool, live, target, maxSize, rng)) failures++;
+                        }
+                        state.setItemsProcessed(state.iterations());
+
+                        const MemPool::Stats stats = pool.stats();
+                        double               frag = 0.0;
+                        if (stats.totalFree > 0) {
+                                frag = 1.0 - static_cast<double>(stats.largestFreeBlock) /
+                                                     static_cast<double>(stats.totalFree);
+                        }
+                        state.setCounter(String("fragmentation"), frag);
+                        state.setCounter(String("free_blocks"), static_cast<double>(stats.numFreeBlocks));
+                        state.setCounter(String("failures"), static_cast<double>(failures));
+                        for (void *p : live) pool.free(p);
+                }
+
+                void benchSmall(BenchmarkState &state, MemPool::Mode mode, bool cached) {
+                        const size_t region = paramInt("mempool.region", 64 * 1024 * 1024);
+                        const size_t target = paramInt("mempool.live", 512);
+                        const size_t maxSize = paramInt("mempool.maxsize", 65536);
+
+                        // Churn first so small requests see a realistic
+                        // free-list population rather than one big block.
+                        MemPool pool(makeConfig(mode, cached, target));
+                        pool.addRegion(RegionBase, region);
+                        List<void *> live;
+                        live.reserve(target);
+                        Rng rng;
+                        for (size_t i = 0; i < target * 8; i++) churnStep(pool, live, target, maxSize, rng);
+
+                        for (auto _ : state) {
+                                (void)_;
+                                void *p = pool.allocate(16 + (rng.next() % 240));
+                                pool.free(p);
+                        }
+                        state.setItemsProcessed(state.iterations());
+                        for (void *p : live) pool.free(p);
+                        pool.flushThreadCache();
+                }
+
+                void registerMode(MemPool::Mode mode, const char *modeName) {
+                        const String suffix = String("_") + modeName;
+                        BenchmarkCase churn(String("mempool"), String("churn") + suffix,
+                                            String("Mixed-size allocate/free churn, ") + modeName,
+                                            [mode](BenchmarkState &state) { benchChurn(state, mode); });
+                        BenchmarkRunner::registerCase(churn);
+                        BenchmarkCase small(String("mempool"), String("small") + suffix,
+                                            String("Small allocate/free pairs on a churned pool, ") + modeName,
+                                            [mode](BenchmarkState &state) { benchSmall(state, mode, false); });
+                        BenchmarkRunner::registerCase(small);
+                        return;
+                }
+
+        } // namespace
+
+        void registerMemPoolCases() {
+                registerMode(MemPool::Mode::FirstFit, "firstfit");
+                registerMode(MemPool::Mode::Tlsf, "tlsf");
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("mempool"), String("small_tlsf_cached"),
+                        String("Small allocate/free pairs on a churned pool, tlsf with front caches"),
+                        [](BenchmarkState &state) { benchSmall(state, MemPool::Mode::Tlsf, true); }));
+        }
+
+        String memPoolParamHelp() {
+                return String("mempool suite parameters:\n"
+                              "  mempool.region=<int>   Bytes managed by the pool (default: 67108864)\n"
+                              "  mempool.live=<int>     Live blocks held during churn (default: 512)\n"
+                              "  mempool.maxsize=<int>  Largest churn allocation in bytes (default: 65536)\n"
+                              "\n"
+                              "  Cases are named <case>_<mode> (firstfit, tlsf).  churn reports a\n"
+                              "  fragmentation counter (1 - largest free / total free) and failures.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerMemPoolCases() {
+                // core disabled — nothing to register.
+        }
+
+        String memPoolParamHelp() {
+                return String("mempool suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -0,0 +1,238 @@
+/**
+ * @file      pcapflow.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref PcapFlowRouter analysis benchmark cases for promeki-bench.  A
+ * synthetic classic pcap is built once in memory: @c pcapflow.flows
+ * ST 2110-40 ANC destinations, each carrying @c pcapflow.frames
+ * single-packet RTP frames, interleaved packet by packet the way a
+ * real multi-stream capture is.  Each iteration runs the whole capture
+ * through @ref PcapFlowRouter::processBuffer with every flow
+ * designated as ANC, so the timed work is the pcap walk, the UDP
+ * demux, RTP health tracking and RFC 8331 reassembly.
+ *
+ * Cases are registered for 1, 2 and 4 analysis threads plus @c auto
+ * (@ref BasicThread::idealThreadCount); @c route_1t is the serial
+ * path.  items/sec is captured packets per second.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key               | Type | Default | Description                          |
+ * |-------------------|------|---------|--------------------------------------|
+ * | `pcapflow.flows`  | int  | 16      | ANC destinations in the capture      |
+ * | `pcapflow.frames` | int  | 2000    | RTP frames (packets) per destination |
+ * | `pcapflow.anc`    | int  | 4       | ST 291 packets per RTP frame         |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
+
+#include <cstdint>
+#include <cstring>
+
+#include <promeki/ancpacket.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/buffer.h>
+#include <promeki/ipv4address.h>
+#include <promeki/list.h>
+#include <promeki/pcapflowrouter.h>
+#include <promeki/rtppacket.h>
+#include <promeki/rtppayloadanc.h>
+#include <promeki/socketaddress.h>
+#include <promeki/st291packet.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                constexpr uint16_t AncPort = 5004;
+                constexpr uint8_t  AncPayloadType = 100;
+
+                int paramInt(const char *key, int def) {
+                        const int n = benchParams().getInt(String(key), def);
+                        return n > 0 ? n : 1;
+                }
+
+                // Little-endian / big-endian appenders for hand-built
+                // capture bytes.
+                void putLe32(List<uint8_t> &b, uint32_t v) {
+                        for (int i = 0; i < 4; i++) b.pushToBack(static_cast<uint8_t>(v >> (i * 8)));
+                }
+
+                void putBe16(List<uint8_t> &b, uint16_t v) {
+                        b.pushToBack(static_cast<uint8_t>(v >> 8));
+                        b.pushToBack(static_cast<uint8_t>(v));
+                }
+
+                // Flow @p flow's destination: 239.10.<hi>.<lo>, port 5004.
+                Ipv4Address flowAddress(int flow) {
+                        return Ipv4Address(239, 10, static_cast<uint8_t>(1 + flow / 250),
+                                           static_cast<uint8_t>(1 + flow % 250));
+                }
+
+                // Appends one pcap record holding an Ethernet / IPv4 /
+                // UDP frame (checksums zero; the demux does not check
+                // them) around @p pkt.
+                void appendRecord(List<uint8_t> &cap, uint32_t index, int flow, const RtpPacket &pkt) {
+                        const uint32_t udpLen = static_cast<uint32_t>(8 + pkt.size());
+                        const uint32_t frameLen = 14 + 20 + udpLen;
+                        putLe32(cap, 1000 + index / 10000u);       // ts_sec
+                        putLe32(cap, (index % 10000u) * 100u);     // ts_usec
+                        putLe32(cap, frameLen);                    // incl_len
+                        putLe32(cap, frameLen);                    // orig_len
+                        for (int i = 0; i < 12; i++) cap.pushToBack(0);
+                        putBe16(cap, 0x0800);
+                        putBe16(cap, 0x4500);                      // IPv4, IHL 5
+                        putBe16(cap, static_cast<uint16_t>(20 + udpLen));
+                        putBe16(cap, 1);                           // id
+                        putBe16(cap, 0);                           // no fragmentation
+                        putBe16(cap, 0x4011);                      // TTL 64, UDP
+                        putBe16(cap, 0);                           // checksum
+                        putBe16(cap, 0x0a00);                      // src 10.0.0.1
+                        putBe16(cap, 0x0001);
+                        const Ipv4Address dst = flowAddress(flow);
+                        for (int i = 0; i < 4; i++) cap.pushToBack(dst.octet(i));
+                        putBe16(cap, 5000);
+                        putBe16(cap, AncPort);
+                        putBe16(cap, static_cast<uint16_t>(udpLen));
+                        putBe16(cap, 0);
+                        const uint8_t *p = pkt.data();
+                        for (size_t i = 0; i < pkt.size(); i++) cap.pushToBack(p[i]);
+                }
+
+                // Builds the interleaved multi-flow capture described in
+                // the file comment.
+                Buffer buildCapture(int flows, int frames, int ancPerFrame) {
+                        AncPacket::List anc;
+                        for (int i = 0; i < ancPerFrame; i++) {
+                                List<uint16_t> udw;
+                                for (int u = 0; u < 16; u++) udw.pushToBack(static_cast<uint16_t>((i * 7 + u) & 0xFF));
+                                anc.pushToBack(St291Packet::buildRaw(0x41, 0x05, udw, static_cast<uint16_t>(9 + i)));
+                        }
+                        RtpPayloadAnc packer(AncPayloadType);
+
+                        List<uint8_t> cap;
+                        putLe32(cap, 0xa1b2c3d4); // magic (LE, microseconds)
+                        putLe32(cap, 0x00040002); // version 2.4
+                        putLe32(cap, 0);          // thiszone
+                        putLe32(cap, 0);          // sigfigs
+                        putLe32(cap, 65535);      // snaplen
+                        putLe32(cap, 1);          // network = Ethernet
+
+                        uint32_t index = 0;
+                        for (int f = 0; f < frames; f++) {
+                                const uint32_t  rtpTs = static_cast<uint32_t>(f) * 1501u;
+                                RtpPacket::List rtps = packer.packAncFrame(anc, rtpTs);
+                                for (int flow = 0; flow < flows; flow++) {
+                                        uint16_t seq = static_cast<uint16_t>(f * rtps.size());
+                                        for (size_t r = 0; r < rtps.size(); r++) {
+                                                RtpPacket pkt = rtps[r];
+                                                pkt.setVersion(2);
+                                                pkt.setPayloadType(AncPayloadType);
+                                                pkt.setSsrc(0xA000u + static_cast<uint32_t>(flow));
+                                                pkt.setSequenceNumber(seq++);
+                                                pkt.setMarker(r + 1 == rtps.size());
+                                                appendRecord(cap, index++, flow, pkt);
+                                        }
+                                }
+                        }
+
+                        Buffer b(cap.size());
+                        std::memcpy(b.data(), cap.data(), cap.size());
+                        b.setSize(cap.size());
+                        return b;
+                }
+
+                void benchRoute(BenchmarkState &state, unsigned int threads) {
+                        const int    flows = paramInt("pcapflow.flows", 16);
+                        const int    frames = paramInt("pcapflow.frames", 2000);
+                        const int    ancPerFrame = paramInt("pcapflow.anc", 4);
+                        const Buffer cap = buildCapture(flows, frames, ancPerFrame);
+
+                        PcapFlowRouter router;
+                        router.setThreads(threads);
+                        for (int flow = 0; flow < flows; flow++) {
+                                router.addAncFlow(SocketAddress(flowAddress(flow), AncPort), AncPayloadType);
+                        }
+                        uint64_t ancFrames = 0;
+                        router.onAncFrame([&ancFrames](const PcapFlowRouter::RoutedAncFrame &) { ancFrames++; });
+
+                        // One pass up front, untimed, to learn the packet
+                        // count and warm the allocator.
+                        router.processBuffer(cap);
+                        uint64_t packets = 0;
+                        for (const PcapFlowRouter::FlowStat &s : router.flowStats()) packets += s.packets;
+                        const uint64_t framesPerPass = ancFrames;
+
+                        for (auto _ : state) {
+                                (void)_;
+                                state.pauseTiming();
+                                router.reset();
+                                state.resumeTiming();
+                                router.processBuffer(cap);
+                        }
+
+                        state.setItemsProcessed(state.iterations() * packets);
+                        state.setBytesProcessed(state.iterations() * cap.size());
+                        state.setCounter(String("flows"), static_cast<double>(flows));
+                        state.setCounter(String("threads"),
+                                         static_cast<double>(threads ? threads : BasicThread::idealThreadCount()));
+                        state.setCounter(String("anc_frames"), static_cast<double>(framesPerPass));
+                        state.setLabel(String::number(flows) + " flows x " + String::number(frames) + " frames, " +
+                                       (threads ? String::number(threads) + " threads" : String("auto threads")));
+                }
+
+        } // namespace
+
+        void registerPcapFlowCases() {
+                for (unsigned int threads : {1u, 2u, 4u, 0u}) {
+                        const String name = threads ? String("route_") + String::number(threads) + "t"
+                                                    : String("route_auto");
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("pcapflow"), name,
+                                String("PcapFlowRouter analysis of a synthetic multi-flow ANC capture"),
+                                [threads](BenchmarkState &state) { benchRoute(state, threads); }));
+                }
+        }
+
+        String pcapFlowParamHelp() {
+                return String("pcapflow suite parameters:\n"
+                              "  pcapflow.flows=<int>   ANC destinations in the capture (default: 16)\n"
+                              "  pcapflow.frames=<int>  RTP frames per destination (default: 2000)\n"
+                              "  pcapflow.anc=<int>     ST 291 packets per RTP frame (default: 4)\n"
+                              "\n"
+                              "  Cases are named route_<n>t for 1, 2 and 4 analysis threads, plus\n"
+                              "  route_auto.  Flows are sharded by destination, so speed-up is bounded\n"
+                              "  by pcapflow.flows.  items/sec is captured packets per second.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerPcapFlowCases() {
+                // proav or network disabled — nothing to register.
+        }
+
+        String pcapFlowParamHelp() {
+                return String("pcapflow suite parameters: (disabled — built without PROMEKI_ENABLE_PROAV "
+                              "or PROMEKI_ENABLE_NETWORK)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_PROAV && PROMEKI_ENABLE_NETWORK
@@ -0,0 +1,190 @@
+/**
+ * @file      signal.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref Signal emit benchmark cases for promeki-bench.
+ *
+ * - @c emit_<N>slots — @c signal.emitters threads emit the same
+ *   signal concurrently, @c signal.emits times each per iteration,
+ *   into @c N trivial direct slots.  The shape of a per-packet or
+ *   per-frame signal fired from several I/O threads.  items/sec is
+ *   emits per second across all emitters.
+ * - @c emit_<N>slots_single — the same with a single emitter, for
+ *   the uncontended per-emit cost.
+ * - @c connect_disconnect — one connect + disconnect pair against a
+ *   signal that already carries @c N=8 slots, the write-side cost
+ *   of the copy-on-write slot list.
+ *
+ * ### BenchParams keys read by this suite
+ *
+ * | Key               | Type | Default | Description                            |
+ * |-------------------|------|---------|----------------------------------------|
+ * | `signal.emitters` | int  | 4       | Emitting threads in @c emit_* cases    |
+ * | `signal.emits`    | int  | 10000   | Emits per thread per measured burst    |
+ */
+
+#include "cases.h"
+#include "../benchparams.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/atomic.h>
+#include <promeki/basicthread.h>
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/signal.h>
+#include <promeki/string.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                int paramEmitters() {
+                        const int n = benchParams().getInt(String("signal.emitters"), 4);
+                        return n > 0 ? n : 1;
+                }
+
+                int paramEmits() {
+                        const int n = benchParams().getInt(String("signal.emits"), 10000);
+                        return n > 0 ? n : 1;
+                }
+
+                // Each slot bumps its own relaxed counter so the slot
+                // body stays trivial and emitters don't serialize on
+                // a shared cache line inside the slots themselves.
+                struct SlotCounters {
+                                struct alignas(64) Counter {
+                                                Atomic<int64_t> value;
+                                };
+                                Counter counters[8];
+                };
+
+                void connectSlots(Signal<int> &sig, SlotCounters &c, int slots) {
+                        for (int i = 0; i < slots; i++) {
+                                Atomic<int64_t> *v = &c.counters[i].value;
+                                sig.connect([v](int n) { v->fetchAndAdd(n, MemoryOrder::Relaxed); });
+                        }
+                        return;
+                }
+
+                int64_t totalFired(const SlotCounters &c, int slots) {
+                        int64_t sum = 0;
+                        for (int i = 0; i < slots; i++) sum += c.counters[i].value.value();
+                        return sum;
+                }
+
+                // ------------------------------------------------------------------
+                // Concurrent emitters into N direct slots
+                // ------------------------------------------------------------------
+                void benchEmit(BenchmarkState &state, int slots, int emitters) {
+                        const int    emits = paramEmits();
+                        Signal<int>  sig;
+                        SlotCounters counters;
+                        connectSlots(sig, counters, slots);
+
+                        for (auto _ : state) {
+                                (void)_;
+                                if (emitters == 1) {
+                                        for (int i = 0; i < emits; i++) sig.emit(1);
+                                        continue;
+                                }
+                                // Thread start-up is not what we're
+                                // measuring; park every emitter on a
+                                // start flag first.
+                                state.pauseTiming();
+                                Atomic<int>       go{0};
+                                List<BasicThread> workers;
+                                for (int t = 0; t < emitters; t++) {
+                                        BasicThread bt;
+                                        bt.start([&sig, &go, emits]() {
+                                                while (go.load(MemoryOrder::Acquire) == 0) {}
+                                                for (int i = 0; i < emits; i++) sig.emit(1);
+                                        });
+                                        workers.pushToBack(std::move(bt));
+                                }
+                                state.resumeTiming();
+                                go.store(1, MemoryOrder::Release);
+                                for (auto &w : workers) w.join();
+                        }
+
+                        const int64_t expected = static_cast<int64_t>(state.iterations()) * emits * emitters;
+                        if (totalFired(counters, slots) != expected * slots) state.setCounter(String("invalid"), 1.0);
+                        state.setItemsProcessed(static_cast<uint64_t>(expected));
+                        state.setCounter(String("slots"), static_cast<double>(slots));
+                        state.setCounter(String("emitters"), static_cast<double>(emitters));
+                        state.setLabel(String::number(slots) + " slot(s) x" + String::number(emitters) + " emitter(s)");
+                }
+
+                // ------------------------------------------------------------------
+                // Write side: connect + disconnect on a populated signal
+                // ------------------------------------------------------------------
+                void benchConnectDisconnect(BenchmarkState &state) {
+                        Signal<int>  sig;
+                        SlotCounters counters;
+                        connectSlots(sig, counters, 8);
+                        for (auto _ : state) {
+                                (void)_;
+                                size_t id = sig.connect([](int) {});
+                                sig.disconnect(id);
+                        }
+                        state.setItemsProcessed(state.iterations());
+                        state.setLabel(String("connect+disconnect, 8 slots connected"));
+                }
+
+        } // namespace
+
+        void registerSignalCases() {
+                static const int slotCounts[] = {1, 2, 4, 8};
+                for (int slots : slotCounts) {
+                        const String name = String("emit_") + String::number(slots) + "slots";
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("signal"), name,
+                                String("Concurrent emitters into ") + String::number(slots) + " direct slot(s)",
+                                [slots](BenchmarkState &state) { benchEmit(state, slots, paramEmitters()); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("signal"), name + "_single",
+                                String("Single emitter into ") + String::number(slots) + " direct slot(s)",
+                                [slots](BenchmarkState &state) { benchEmit(state, slots, 1); }));
+                }
+                BenchmarkRunner::registerCase(BenchmarkCase(
+                        String("signal"), String("connect_disconnect"),
+                        String("connect + disconnect with 8 slots connected"),
+                        [](BenchmarkState &state) { benchConnectDisconnect(state); }));
+        }
+
+        String signalParamHelp() {
+                return String("signal suite parameters:\n"
+                              "  signal.emitters=<int>  Emitting threads in emit_<N>slots cases (default: 4)\n"
+                              "  signal.emits=<int>     Emits per thread per measured burst (default: 10000)\n"
+                              "\n"
+                              "  items_per_sec is emits per second summed over all emitters; each emit\n"
+                              "  fires every connected slot.  *_single cases use one emitter.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerSignalCases() {
+                // core disabled — nothing to register.
+        }
+
+        String signalParamHelp() {
+                return String("signal suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -0,0 +1,178 @@
+/**
+ * @file      variantdatabase.cpp
+ * @copyright Jason Howard. All rights reserved.
+ *
+ * See LICENSE file in the project root folder for license information.
+ *
+ * @ref VariantDatabase benchmark cases for promeki-bench.  Every case
+ * runs against a database of @c N keys (half integers, half strings,
+ * the rough mix of a frame's @ref Metadata) for N in 8, 16, 32 and
+ * 64; 64 is past the inline entry capacity, so it also shows the cost
+ * once the entry table lives on the heap.
+ *
+ * - @c set_<N>keys — fill an empty database with N keys, the shape of
+ *   a source stamping fresh metadata onto every frame.
+ * - @c get_<N>keys — one @c getAs<> per key on a populated database.
+ *   items/sec is lookups per second.
+ * - @c cow_<N>keys — copy a populated database (as a @ref Frame copy
+ *   does) and write one key into the copy, forcing the copy-on-write
+ *   detach.  One item is one frame.
+ *
+ * The suite reads no BenchParams keys.
+ */
+
+#include "cases.h"
+
+#include <promeki/config.h>
+
+#if PROMEKI_ENABLE_CORE
+
+#include <cstdint>
+
+#include <promeki/benchmarkrunner.h>
+#include <promeki/list.h>
+#include <promeki/string.h>
+#include <promeki/variantdatabase.h>
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        namespace {
+
+                using BenchDb = VariantDatabase<"BenchVariantDatabase">;
+
+                List<BenchDb::ID> makeKeys(int count) {
+                        List<BenchDb::ID> keys;
+                        for (int i = 0; i < count; i++) {
+                                keys.pushToBack(BenchDb::ID(String("bench.key") + String::number(i)));
+                        }
+                        return keys;
+                }
+
+                void fill(BenchDb &db, const List<BenchDb::ID> &keys) {
+                        for (size_t i = 0; i < keys.size(); i++) {
+                                if (i & 1) {
+                                        db.set(keys[i], String("value"));
+                                } else {
+                                        db.set(keys[i], static_cast<int64_t>(i));
+                                }
+                        }
+                        return;
+                }
+
+                void setCommonCounters(BenchmarkState &state, int count) {
+                        state.setCounter(String("keys"), static_cast<double>(count));
+                        const bool fitsInline = count <= static_cast<int>(BenchDb::InlineEntries);
+                        state.setCounter(String("inline"), fitsInline ? 1.0 : 0.0);
+                        return;
+                }
+
+                // ------------------------------------------------------------------
+                // Fill an empty database
+                // ------------------------------------------------------------------
+                void benchSet(BenchmarkState &state, int count) {
+                        const List<BenchDb::ID> keys = makeKeys(count);
+                        size_t                  total = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                BenchDb db;
+                                fill(db, keys);
+                                total += db.size();
+                        }
+                        if (total != state.iterations() * static_cast<size_t>(count)) {
+                                state.setCounter(String("invalid"), 1.0);
+                        }
+                        state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(count));
+                        setCommonCounters(state, count);
+                        state.setLabel(String("set ") + String::number(count) + " keys into an empty database");
+                }
+
+                // ------------------------------------------------------------------
+                // Typed lookup of every key
+                // ------------------------------------------------------------------
+                void benchGet(BenchmarkState &state, int count) {
+                        const List<BenchDb::ID> keys = makeKeys(count);
+                        BenchDb                 db;
+                        fill(db, keys);
+                        int64_t sum = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                for (size_t i = 0; i < keys.size(); i += 2) sum += db.getAs<int64_t>(keys[i]);
+                                for (size_t i = 1; i < keys.size(); i += 2) sum += db.getAs<String>(keys[i]).size();
+                        }
+                        if (sum == 0 && count > 1) state.setCounter(String("invalid"), 1.0);
+                        state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(count));
+                        setCommonCounters(state, count);
+                        state.setLabel(String("getAs<> over ") + String::number(count) + " keys");
+                }
+
+                // ------------------------------------------------------------------
+                // Copy + first write (per-frame copy-on-write detach)
+                // ------------------------------------------------------------------
+                void benchCow(BenchmarkState &state, int count) {
+                        const List<BenchDb::ID> keys = makeKeys(count);
+                        BenchDb                 upstream;
+                        fill(upstream, keys);
+                        int64_t frame = 0;
+                        for (auto _ : state) {
+                                (void)_;
+                                BenchDb copy = upstream;
+                                copy.set(keys[0], frame++);
+                                if (copy.size() != upstream.size()) state.setCounter(String("invalid"), 1.0);
+                        }
+                        if (upstream.getAs<int64_t>(keys[0]) != 0) state.setCounter(String("invalid"), 1.0);
+                        state.setItemsProcessed(state.iterations());
+                        setCommonCounters(state, count);
+                        state.setLabel(String("copy + detach, ") + String::number(count) + " keys");
+                }
+
+        } // namespace
+
+        void registerVariantDatabaseCases() {
+                static const int keyCounts[] = {8, 16, 32, 64};
+                for (int count : keyCounts) {
+                        const String suffix = String("_") + String::number(count) + "keys";
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("variantdatabase"), String("set") + suffix,
+                                String("Fill an empty database with ") + String::number(count) + " keys",
+                                [count](BenchmarkState &state) { benchSet(state, count); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("variantdatabase"), String("get") + suffix,
+                                String("getAs<> every key of a ") + String::number(count) + "-key database",
+                                [count](BenchmarkState &state) { benchGet(state, count); }));
+                        BenchmarkRunner::registerCase(BenchmarkCase(
+                                String("variantdatabase"), String("cow") + suffix,
+                                String("Copy a ") + String::number(count) + "-key database and write one key",
+                                [count](BenchmarkState &state) { benchCow(state, count); }));
+                }
+        }
+
+        String variantDatabaseParamHelp() {
+                return String("variantdatabase suite parameters: (none)\n"
+                              "\n"
+                              "  set_/get_/cow_<N>keys run against a database of N keys for\n"
+                              "  N = 8, 16, 32, 64.  cow_* items are frames (copy + first write);\n"
+                              "  set_* and get_* items are individual keys.  The 'inline' counter\n"
+                              "  is 1 when N fits the database's inline entry storage.\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#else // PROMEKI_ENABLE_CORE
+
+PROMEKI_NAMESPACE_BEGIN
+namespace benchutil {
+
+        void registerVariantDatabaseCases() {
+                // core disabled — nothing to register.
+        }
+
+        String variantDatabaseParamHelp() {
+                return String("variantdatabase suite parameters: (disabled — built without PROMEKI_ENABLE_CORE)\n");
+        }
+
+} // namespace benchutil
+PROMEKI_NAMESPACE_END
+
+#endif // PROMEKI_ENABLE_CORE
@@ -126,6 +126,17 @@ namespace {
                 benchutil::registerImageDataCases();
                 benchutil::registerInspectorCases();
                 benchutil::registerAncRtpCases();
+                benchutil::registerConcurrencyCases();
+                benchutil::registerSignalCases();
+                benchutil::registerVariantDatabaseCases();
+                benchutil::registerCrcCases();
+                benchutil::registerFrameBridgeCases();
+                benchutil::registerMemPoolCases();
+                benchutil::registerAudioFormatCases();
+                benchutil::registerLoggerCases();
+                benchutil::registerPcapFlowCases();
+                benchutil::registerAsyncFileIOCases();
+                benchutil::registerHttpServerCases();
         }
 
         /**
@@ -161,6 +172,28 @@ namespace {
                 std::fputs(benchutil::inspectorParamHelp().cstr(), stdout);
                 std::putchar('\n');
                 std::fputs(benchutil::ancRtpParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::concurrencyParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::signalParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::variantDatabaseParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::crcParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::frameBridgeParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::memPoolParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::audioFormatParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::loggerParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::pcapFlowParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::asyncFileIOParamHelp().cstr(), stdout);
+                std::putchar('\n');
+                std::fputs(benchutil::httpServerParamHelp().cstr(), stdout);
                 std::printf("\n"
                             "Examples:\n"
                             "  promeki-bench                          # run every registered case\n"
@@ -77,8 +77,10 @@ void printUsage(const CmdLineParser &parser) {
         std::printf("Usage:\n");
         std::printf("  promeki-pcap info  <file>\n");
         std::printf("  promeki-pcap flows <file> [--sdp <file>] [--anc <host:port>]... [--cfg <Key:Value>]...\n");
+        std::printf("                            [--threads <n>]\n");
         std::printf("  promeki-pcap anc   <file> (--sdp <file> | --anc <host:port[/pt]>...)\n");
-        std::printf("                            [--type <name>]... [--cfg <Key:Value>]... [--hexdump] [--json]\n\n");
+        std::printf("                            [--type <name>]... [--cfg <Key:Value>]... [--hexdump] [--json]\n");
+        std::printf("                            [--threads <n>]\n\n");
         std::printf("Subcommands:\n");
         std::printf("  info   Container summary: format, byte order, link types, record + byte counts.\n");
         std::printf("  flows  Auto-discovered (or SDP-labelled) RTP flow table, with per-flow RTP health\n");
@@ -90,6 +92,9 @@ void printUsage(const CmdLineParser &parser) {
         std::printf("         Feed parser context with --cfg <Key:Value> (e.g. --cfg AtcParseRateHint:30 to\n");
         std::printf("         supply the frame rate the ATC timecode parser needs, or --cfg RtpJitterWarnThreshold:10ms to\n");
         std::printf("         warn on RTP jitter); --cfg list shows all keys.\n\n");
+        std::printf("flows and anc analyse on one thread by default.  --threads <n> spreads the flows across\n");
+        std::printf("n worker threads (0 = one per CPU); output is identical, but is printed once the whole\n");
+        std::printf("capture has been read.\n\n");
         std::printf("Options:\n");
         const StringList usage = parser.generateUsage();
         for(size_t i = 0; i < usage.size(); ++i) std::printf("  %s\n", usage[i].cstr());
@@ -344,12 +349,14 @@ JsonObject rtpAnomalyJson(const PcapFlowRouter::RtpAnomaly &a) {
 
 // ---- flows -----------------------------------------------------------
 
-int cmdFlows(const String &path, const String &sdpPath, const StringList &ancSpecs, const StringList &cfgSpecs) {
+int cmdFlows(const String &path, const String &sdpPath, const StringList &ancSpecs, const StringList &cfgSpecs,
+             unsigned int threads) {
         AncTranslateConfig cfg;
         if(!buildTranslateConfig(cfgSpecs, cfg)) return 2;
         const Duration jitterWarn = cfg.getAs<Duration>(AncTranslateConfig::RtpJitterWarnThreshold, Duration::zero());
 
         PcapFlowRouter router;
+        router.setThreads(threads);
         router.setJitterWarnThreshold(jitterWarn);
         if(!sdpPath.isEmpty()) {
                 auto [sdp, serr] = SdpSession::fromFile(sdpPath);
@@ -642,7 +649,7 @@ void printAncFrameText(const AncTranslator &tr, const StringList &filters, AncFl
 }
 
 int cmdAnc(const String &path, const String &sdpPath, const StringList &ancSpecs, const StringList &typeFilters,
-           const StringList &cfgSpecs, bool asJson, bool hexdump) {
+           const StringList &cfgSpecs, bool asJson, bool hexdump, unsigned int threads) {
         if(sdpPath.isEmpty() && ancSpecs.isEmpty()) {
                 std::fprintf(stderr, "error: 'anc' needs --sdp or at least one --anc <host:port> to label the ANC flow\n");
                 return 2;
@@ -652,6 +659,7 @@ int cmdAnc(const String &path, const String &sdpPath, const StringList &ancSpecs
         if(!buildTranslateConfig(cfgSpecs, cfg)) return 2;
 
         PcapFlowRouter router;
+        router.setThreads(threads);
         router.setJitterWarnThreshold(
                 cfg.getAs<Duration>(AncTranslateConfig::RtpJitterWarnThreshold, Duration::zero()));
         if(!sdpPath.isEmpty()) {
@@ -738,6 +746,7 @@ int main(int argc, char *argv[]) {
         bool hexdump = false;
         bool showHelp = false;
         bool noColor = false;
+        int threads = 1;
 
         CmdLineParser parser;
         parser.registerOptions({
@@ -757,6 +766,15 @@ int main(int argc, char *argv[]) {
                  CmdLineParser::OptionCallback([&]() { hexdump = true; return 0; })},
                 {0, "nocolor", "Disable ANSI color output (color is otherwise auto-enabled on a color-capable TTY)",
                  CmdLineParser::OptionCallback([&]() { noColor = true; return 0; })},
+                {0, "threads", "Analysis worker threads for flows / anc (default 1; 0 = one per CPU)",
+                 CmdLineParser::OptionIntCallback([&](int n) {
+                         if(n < 0) {
+                                 std::fprintf(stderr, "error: --threads must be >= 0\n");
+                                 return 1;
+                         }
+                         threads = n;
+                         return 0;
+                 })},
         });
 
         if(parser.parseMain(argc, argv) != 0) {
@@ -783,8 +801,11 @@ int main(int argc, char *argv[]) {
         const String path = parser.arg(1);
 
         if(subcommand == String("info")) return cmdInfo(path);
-        if(subcommand == String("flows")) return cmdFlows(path, sdpPath, ancSpecs, cfgSpecs);
-        if(subcommand == String("anc")) return cmdAnc(path, sdpPath, ancSpecs, typeFilters, cfgSpecs, asJson, hexdump);
+        const unsigned int workers = static_cast<unsigned int>(threads);
+        if(subcommand == String("flows")) return cmdFlows(path, sdpPath, ancSpecs, cfgSpecs, workers);
+        if(subcommand == String("anc")) {
+                return cmdAnc(path, sdpPath, ancSpecs, typeFilters, cfgSpecs, asJson, hexdump, workers);
+        }
 
         std::fprintf(stderr, "error: unknown subcommand '%s'\n\n", subcommand.cstr());
         printUsage(parser);